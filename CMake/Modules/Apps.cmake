@@ -55,3 +55,59 @@ endif ()
 
 message(STATUS "Created app: vulkan-engine-editor")
 message(STATUS "  Sources: ${EDITOR_APP_SOURCES}")
+
+# Benchmark 应用程序（无窗口，按脚本相机路径渲染并输出 JSON 报告）
+if (nlohmann_json_FOUND)
+    set(BENCHMARK_APP_SOURCES
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/main.cpp
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/BenchmarkApplication.cpp
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/BenchmarkReport.cpp
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/BenchmarkScene.cpp
+    )
+
+    set(BENCHMARK_APP_HEADERS
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/BenchmarkApplication.hpp
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/BenchmarkReport.hpp
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark/BenchmarkScene.hpp
+    )
+
+    add_executable(vulkan-engine-benchmark
+            ${BENCHMARK_APP_SOURCES}
+            ${BENCHMARK_APP_HEADERS}
+    )
+
+    add_executable(VulkanEngine::BenchmarkApp ALIAS vulkan-engine-benchmark)
+
+    # apps/editor 提供默认立方体数据（demo/CubeData.hpp）
+    target_include_directories(vulkan-engine-benchmark PRIVATE
+            ${CMAKE_CURRENT_SOURCE_DIR}/include
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/benchmark
+            ${CMAKE_CURRENT_SOURCE_DIR}/apps/editor
+    )
+
+    target_link_libraries(vulkan-engine-benchmark PRIVATE
+            VulkanEngineApplication
+            VulkanEngine::nlohmann_json
+    )
+
+    fix_msvc_runtime_conflicts(vulkan-engine-benchmark)
+
+    set_target_properties(vulkan-engine-benchmark PROPERTIES
+            RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/bin
+            OUTPUT_NAME "VulkanEngineBenchmark"
+            CXX_STANDARD 20
+            CXX_STANDARD_REQUIRED ON
+            FOLDER "Apps"
+    )
+
+    if (MSVC)
+        target_compile_options(vulkan-engine-benchmark PRIVATE
+                /W4
+                /MP
+        )
+    endif ()
+
+    message(STATUS "Created app: vulkan-engine-benchmark")
+else ()
+    message(STATUS "nlohmann_json not found, skipping vulkan-engine-benchmark")
+endif ()
@@ -25,3 +25,9 @@ if (VULKAN_ENGINE_ENABLE_PROFILING)
             VULKAN_ENGINE_ENABLE_PROFILING=1
     )
 endif ()
+
+if (VULKAN_ENGINE_ENABLE_COMMAND_STATS)
+    target_compile_definitions(VulkanEngineCore INTERFACE
+            VULKAN_ENGINE_ENABLE_COMMAND_STATS=1
+    )
+endif ()
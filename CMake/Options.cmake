@@ -26,6 +26,7 @@ option(VULKAN_ENGINE_BUILD_EXAMPLES "Build examples" ON)
 option(VULKAN_ENGINE_ENABLE_VALIDATION "Enable Vulkan validation layers" ON)
 option(VULKAN_ENGINE_ENABLE_DEBUG_MARKERS "Enable debug markers" ON)
 option(VULKAN_ENGINE_ENABLE_PROFILING "Enable profiling" OFF)
+option(VULKAN_ENGINE_ENABLE_COMMAND_STATS "Count draws, binds and barriers per render pass" ON)
 
 #-------------------------------------------------------------------------------
 # Performance Options
@@ -19,6 +19,7 @@ function(print_configuration_summary)
     message(STATUS "  Hot Reload:        ${VULKAN_ENGINE_USE_HOT_RELOAD}")
     message(STATUS "  Validation Layers: ${VULKAN_ENGINE_ENABLE_VALIDATION}")
     message(STATUS "  Debug Markers:     ${VULKAN_ENGINE_ENABLE_DEBUG_MARKERS}")
+    message(STATUS "  Command Stats:     ${VULKAN_ENGINE_ENABLE_COMMAND_STATS}")
     message(STATUS "")
     message(STATUS "Dependencies:")
     message(STATUS "  Vulkan:            ${Vulkan_FOUND}")
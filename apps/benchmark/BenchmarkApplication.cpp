@@ -0,0 +1,405 @@
+#include "BenchmarkApplication.hpp"
+
+#include "engine/core/utils/Logger.hpp"
+#include "engine/core/math/Camera.hpp"
+#include "engine/platform/filesystem/PathUtils.hpp"
+#include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/resources/Buffer.hpp"
+#include "engine/rhi/vulkan/command/GpuProfiler.hpp"
+#include "engine/rhi/vulkan/utils/CoordinateTransform.hpp"
+
+#include "engine/rendering/HeadlessRenderer.hpp"
+#include "engine/rendering/Viewport.hpp"
+#include "engine/rendering/resources/RenderTarget.hpp"
+#include "engine/rendering/render_graph/RenderGraph.hpp"
+#include "engine/rendering/render_graph/CubeRenderPass.hpp"
+#include "engine/rendering/material/Material.hpp"
+#include "engine/rendering/material/MaterialLoader.hpp"
+#include "engine/rendering/resources/Mesh.hpp"
+#include "engine/rendering/resources/ObjLoader.hpp"
+
+#include "demo/CubeData.hpp"
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace benchmark
+{
+    namespace
+    {
+        constexpr uint32_t NO_FRAME = UINT32_MAX;
+
+        constexpr const char* FRAME_METRIC = "frame";
+    } // namespace
+
+    class BenchmarkApplication::Impl
+    {
+        public:
+            rendering::HeadlessRenderer renderer_;
+
+            std::shared_ptr<core::OrbitCamera> camera_;
+
+            std::unique_ptr<rendering::Mesh> mesh_;
+            std::unique_ptr<vulkan::Buffer>  vertex_buffer_;
+            std::unique_ptr<vulkan::Buffer>  index_buffer_;
+
+            rendering::CubeRenderPass*                 cube_pass_ = nullptr;
+            std::unique_ptr<rendering::MaterialLoader> material_loader_;
+            std::shared_ptr<rendering::Material>       material_;
+
+            BenchmarkReport report_;
+            uint32_t        frame_         = 0; // Frames rendered, warm-up included
+            uint64_t        gpu_resolved_  = 0; // GpuProfiler::resolved_frames() last read
+            bool            gpu_supported_ = false;
+
+            // Frame recorded into each frame slot, which is whose timestamps resolve next there
+            std::vector<uint32_t> slot_frames_;
+
+            bool load_mesh(const std::shared_ptr<vulkan::DeviceManager>& device, const std::string& path);
+            void create_default_cube(const std::shared_ptr<vulkan::DeviceManager>& device);
+            void record_scene(vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx);
+            void update_camera(const BenchmarkScene& scene, uint32_t path_frame);
+            void collect_gpu_timings(uint32_t source_frame, bool measured);
+    };
+
+    BenchmarkApplication::BenchmarkApplication(const application::ApplicationConfig& config, BenchmarkOptions options)
+        : ApplicationBase(config)
+        , impl_(std::make_unique<Impl>())
+        , options_(std::move(options))
+    {
+    }
+
+    BenchmarkApplication::~BenchmarkApplication() = default;
+
+    // ============================================================================
+    // Lifecycle
+    // ============================================================================
+
+    bool BenchmarkApplication::on_initialize()
+    {
+        const BenchmarkScene& scene  = options_.scene;
+        auto                  device = device_manager();
+        if (!device)
+        {
+            logger::error("Benchmark: device not initialized");
+            return false;
+        }
+
+        // Fixed resolution: a dynamic render scale would make runs incomparable
+        rendering::HeadlessRenderer::Config renderer_config;
+        renderer_config.width                = scene.width;
+        renderer_config.height               = scene.height;
+        renderer_config.enable_gpu_timing    = true;
+        renderer_config.max_frames_in_flight = config().frames_in_flight;
+
+        if (!impl_->renderer_.initialize(device, renderer_config))
+        {
+            logger::error("Benchmark: failed to initialize HeadlessRenderer");
+            return false;
+        }
+
+        if (scene.mesh.empty() || !impl_->load_mesh(device, (core::PathUtils::project_root() / scene.mesh).string()))
+        {
+            impl_->create_default_cube(device);
+        }
+
+        auto& scene_renderer    = impl_->renderer_.scene_renderer();
+        auto  render_target     = scene_renderer.render_target();
+        impl_->material_loader_ = std::make_unique<rendering::MaterialLoader>(device, scene_renderer.config().max_frames_in_flight);
+        impl_->material_loader_->set_budget_governor(budget_governor());
+        impl_->material_loader_->set_base_directory(core::PathUtils::materials_dir().string() + "/");
+        impl_->material_loader_->set_texture_directory(core::PathUtils::project_root().string() + "/");
+        impl_->material_ = impl_->material_loader_->load(scene.material, render_target->color_format(), render_target->depth_format());
+        if (!impl_->material_)
+        {
+            logger::error("Benchmark: failed to load material " + scene.material);
+            return false;
+        }
+
+        rendering::CubeRenderPass::Config cube_config;
+        cube_config.name = "CubeRenderPass";
+        if (impl_->mesh_ && impl_->mesh_->is_uploaded())
+        {
+            cube_config.vertex_buffer = impl_->mesh_->vertex_buffer();
+            cube_config.index_buffer  = impl_->mesh_->index_buffer();
+            cube_config.index_count   = impl_->mesh_->index_count();
+            cube_config.index_type    = VK_INDEX_TYPE_UINT32;
+            cube_config.first_index   = impl_->mesh_->first_index();
+            cube_config.vertex_offset = impl_->mesh_->vertex_offset();
+        }
+        else
+        {
+            cube_config.vertex_buffer = impl_->vertex_buffer_.get();
+            cube_config.index_buffer  = impl_->index_buffer_.get();
+            cube_config.index_count   = static_cast<uint32_t>(editor::demo::cube_indices.size());
+            cube_config.index_type    = VK_INDEX_TYPE_UINT16;
+        }
+        cube_config.material_ref = impl_->material_;
+        cube_config.width        = scene.width;
+        cube_config.height       = scene.height;
+
+        auto cube_pass    = std::make_unique<rendering::CubeRenderPass>(cube_config);
+        impl_->cube_pass_ = cube_pass.get();
+        impl_->renderer_.scene_render_graph_builder().add_node(std::move(cube_pass));
+        impl_->renderer_.compile_scene_render_graph();
+
+        impl_->camera_ = std::make_shared<core::OrbitCamera>();
+        impl_->camera_->set_distance_limits(0.01f, 1000.0f); // The path decides, not the editor's limits
+        impl_->camera_->set_target(scene.camera_target);
+
+        const auto* profiler  = scene_renderer.gpu_profiler();
+        impl_->gpu_supported_ = profiler && profiler->is_supported();
+        if (!impl_->gpu_supported_)
+        {
+            logger::warn("Benchmark: GPU timestamps unsupported, reporting CPU times only");
+        }
+
+        impl_->slot_frames_.assign(config().frames_in_flight, NO_FRAME);
+
+        impl_->report_.scene  = scene.name;
+        impl_->report_.device = device->properties().deviceName;
+        impl_->report_.width  = scene.width;
+        impl_->report_.height = scene.height;
+        impl_->report_.frames = scene.frames;
+        impl_->report_.metric(FRAME_METRIC).cpu_ms.reserve(scene.frames);
+
+        logger::info("Benchmark '", scene.name, "' on ", impl_->report_.device, ": ", scene.warmup_frames, " warm-up + ", scene.frames, " frames at ", scene.width, "x", scene.height);
+        return true;
+    }
+
+    void BenchmarkApplication::on_shutdown()
+    {
+        impl_->renderer_.shutdown();
+
+        impl_->cube_pass_ = nullptr;
+        impl_->material_.reset();
+        impl_->material_loader_.reset();
+        impl_->vertex_buffer_.reset();
+        impl_->index_buffer_.reset();
+        impl_->mesh_.reset();
+        impl_->camera_.reset();
+    }
+
+    void BenchmarkApplication::on_update(float delta_time)
+    {
+        // Everything follows the frame index; wall time must not leak into the run
+        (void)delta_time;
+    }
+
+    // ============================================================================
+    // Frame
+    // ============================================================================
+
+    void BenchmarkApplication::on_render()
+    {
+        const BenchmarkScene& scene    = options_.scene;
+        auto&                 renderer = impl_->renderer_;
+
+        if (!renderer.begin_frame())
+        {
+            logger::error("Benchmark: frame ", impl_->frame_, " could not be started");
+            exit_code_ = EXIT_ERROR;
+            request_exit();
+            return;
+        }
+
+        // The slot wait is pacing, not work: timing starts after it
+        const auto     cpu_start    = std::chrono::steady_clock::now();
+        const uint32_t frame        = impl_->frame_;
+        const uint32_t slot         = renderer.current_frame();
+        const uint32_t source_frame = impl_->slot_frames_[slot];
+        const bool     measured     = frame >= scene.warmup_frames && frame < scene.warmup_frames + scene.frames;
+
+        // Warm-up holds the first pose; the tail holds the last
+        impl_->update_camera(scene, frame < scene.warmup_frames ? 0 : frame - scene.warmup_frames);
+
+        renderer.render_scene([this](vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx)
+        {
+            impl_->record_scene(cmd, ctx);
+        });
+        renderer.end_frame();
+
+        const float cpu_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - cpu_start).count();
+        if (measured)
+        {
+            impl_->report_.metric(FRAME_METRIC).cpu_ms.add(cpu_ms);
+            for (const auto& pass : renderer.scene_render_graph().pass_stats())
+            {
+                impl_->report_.metric(pass.name).cpu_ms.add(pass.cpu_ms);
+            }
+        }
+
+        // Recording this frame resolved the slot's previous one
+        const bool source_measured = source_frame >= scene.warmup_frames && source_frame < scene.warmup_frames + scene.frames;
+        impl_->collect_gpu_timings(source_frame, source_measured);
+        impl_->slot_frames_[slot] = frame;
+
+        if (++impl_->frame_ >= scene.warmup_frames + scene.frames + config().frames_in_flight)
+        {
+            finish();
+            request_exit();
+        }
+    }
+
+    void BenchmarkApplication::finish()
+    {
+        BenchmarkReport& report = impl_->report_;
+
+        const auto& frame = report.metric(FRAME_METRIC);
+        const auto  cpu   = frame.cpu_ms.summarize();
+        const auto  gpu   = frame.gpu_ms.summarize();
+        logger::info("Benchmark frame CPU ms: p50 ", cpu.p50, ", p95 ", cpu.p95, ", p99 ", cpu.p99);
+        if (gpu.count > 0)
+        {
+            logger::info("Benchmark frame GPU ms: p50 ", gpu.p50, ", p95 ", gpu.p95, ", p99 ", gpu.p99);
+        }
+
+        if (!report.write(options_.output))
+        {
+            exit_code_ = EXIT_ERROR;
+            return;
+        }
+        logger::info("Benchmark report written to " + options_.output.string());
+
+        if (options_.baseline.empty())
+        {
+            exit_code_ = EXIT_OK;
+            return;
+        }
+
+        const auto regressions = report.compare(options_.baseline, options_.tolerance);
+        if (!regressions)
+        {
+            exit_code_ = EXIT_ERROR;
+            return;
+        }
+
+        for (const auto& regression : *regressions)
+        {
+            logger::error("Benchmark regression: ", regression.metric, " ", regression.current, " ms, baseline ", regression.baseline, " ms");
+        }
+
+        exit_code_ = regressions->empty() ? EXIT_OK : EXIT_REGRESSION;
+        if (exit_code_ == EXIT_OK)
+        {
+            logger::info("Benchmark within tolerance of " + options_.baseline.string());
+        }
+    }
+
+    // ============================================================================
+    // Impl
+    // ============================================================================
+
+    bool BenchmarkApplication::Impl::load_mesh(const std::shared_ptr<vulkan::DeviceManager>& device, const std::string& path)
+    {
+        rendering::ObjLoader obj_loader;
+        if (!obj_loader.can_load(path))
+        {
+            logger::warn("Benchmark: mesh not found, using default cube: " + path);
+            return false;
+        }
+
+        rendering::MeshData mesh_data = obj_loader.load(path);
+        if (mesh_data.is_empty())
+        {
+            logger::warn("Benchmark: failed to load mesh, using default cube: " + path);
+            return false;
+        }
+
+        mesh_ = std::make_unique<rendering::Mesh>();
+        mesh_->upload(renderer_.scene_renderer().geometry_buffer(), device, mesh_data);
+        return true;
+    }
+
+    void BenchmarkApplication::Impl::create_default_cube(const std::shared_ptr<vulkan::DeviceManager>& device)
+    {
+        using namespace editor::demo;
+
+        VkDeviceSize vertex_size = sizeof(cube_vertices[0]) * cube_vertices.size();
+        vertex_buffer_           = std::make_unique<vulkan::Buffer>(
+                                                                    device,
+                                                                    vertex_size,
+                                                                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        std::memcpy(vertex_buffer_->map(), cube_vertices.data(), static_cast<size_t>(vertex_size));
+        vertex_buffer_->unmap();
+
+        VkDeviceSize index_size = sizeof(cube_indices[0]) * cube_indices.size();
+        index_buffer_           = std::make_unique<vulkan::Buffer>(
+                                                                   device,
+                                                                   index_size,
+                                                                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        std::memcpy(index_buffer_->map(), cube_indices.data(), static_cast<size_t>(index_size));
+        index_buffer_->unmap();
+    }
+
+    void BenchmarkApplication::Impl::record_scene(vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx)
+    {
+        auto& scene = renderer_.scene_renderer();
+
+        rendering::RenderContext render_ctx;
+        render_ctx.frame_index = ctx.frame_index;
+        render_ctx.image_index = 0;
+        render_ctx.width       = ctx.width;
+        render_ctx.height      = ctx.height;
+
+        auto render_target          = scene.render_target();
+        render_ctx.color_image_view = render_target->color_image_view();
+        render_ctx.depth_image_view = render_target->depth_image_view();
+        render_ctx.device           = scene.device();
+        render_ctx.gpu_profiler     = ctx.gpu_profiler;
+
+        material_loader_->parameter_buffer()->flush(ctx.frame_index, ctx.frame_arena);
+
+        scene.render_graph().execute(cmd, render_ctx);
+    }
+
+    void BenchmarkApplication::Impl::update_camera(const BenchmarkScene& scene, uint32_t path_frame)
+    {
+        const CameraPose pose = scene.pose_at(path_frame);
+        camera_->set_rotation(pose.yaw, pose.pitch);
+        camera_->set_distance(pose.distance);
+
+        float aspect_ratio = static_cast<float>(scene.width) / static_cast<float>(scene.height);
+        if (auto viewport = renderer_.scene_viewport())
+        {
+            aspect_ratio = viewport->aspect_ratio();
+        }
+
+        glm::mat4 proj = vulkan::CoordinateTransform::opengl_to_vulkan_projection(camera_->get_projection_matrix(45.0f, aspect_ratio, 0.1f, 100.0f));
+        cube_pass_->set_mvp_matrix(proj * camera_->get_view_matrix());
+    }
+
+    void BenchmarkApplication::Impl::collect_gpu_timings(uint32_t source_frame, bool measured)
+    {
+        const auto* profiler = renderer_.scene_renderer().gpu_profiler();
+        if (!gpu_supported_ || source_frame == NO_FRAME || profiler->resolved_frames() == gpu_resolved_)
+        {
+            return;
+        }
+        gpu_resolved_ = profiler->resolved_frames();
+
+        if (!measured)
+        {
+            return;
+        }
+
+        // The root scope is the whole scene; scopes below it are render graph passes
+        const auto& results = profiler->results();
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& scope = results[i];
+            if (i == 0)
+            {
+                report_.metric(FRAME_METRIC).gpu_ms.add(scope.gpu_ms);
+            }
+            else if (scope.depth == 1)
+            {
+                report_.metric(scope.name).gpu_ms.add(scope.gpu_ms);
+            }
+        }
+    }
+} // namespace benchmark
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "BenchmarkReport.hpp"
+#include "BenchmarkScene.hpp"
+
+#include "engine/application/app/Application.hpp"
+#include <filesystem>
+#include <memory>
+
+namespace benchmark
+{
+    using namespace vulkan_engine;
+
+    // Process exit codes, so CI can tell a slow build from a broken one
+    enum ExitCode : int
+    {
+        EXIT_OK         = 0,
+        EXIT_REGRESSION = 1, // Slower than the baseline beyond the tolerance
+        EXIT_ERROR      = 2  // Could not render, write the report or read the baseline
+    };
+
+    struct BenchmarkOptions
+    {
+        BenchmarkScene             scene;
+        std::filesystem::path      output;   // Report JSON
+        std::filesystem::path      baseline; // Empty = no comparison
+        BenchmarkReport::Tolerance tolerance;
+    };
+
+    // ============================================================================
+    // BenchmarkApplication - Renders a BenchmarkScene headless and times it
+    // ============================================================================
+    // Runs scene.warmup_frames unmeasured frames, then scene.frames measured ones,
+    // then frames_in_flight more so the last measured frames' GPU timestamps
+    // resolve. Every frame records:
+    //   - "frame"    CPU from after the frame slot wait to submit, GPU of the scene root scope
+    //   - each pass  CPU of RenderGraph recording, GPU of its profiler scope
+    // Exits by itself after the last frame; exit_code() tells how it went.
+    class BenchmarkApplication : public application::ApplicationBase
+    {
+        public:
+            BenchmarkApplication(const application::ApplicationConfig& config, BenchmarkOptions options);
+            ~BenchmarkApplication() override;
+
+            BenchmarkApplication(const BenchmarkApplication&)            = delete;
+            BenchmarkApplication& operator=(const BenchmarkApplication&) = delete;
+
+            int exit_code() const { return exit_code_; }
+
+        protected:
+            bool on_initialize() override;
+            void on_shutdown() override;
+            void on_update(float delta_time) override;
+            void on_render() override;
+
+        private:
+            void finish();
+
+            class Impl;
+            std::unique_ptr<Impl> impl_;
+            BenchmarkOptions      options_;
+            int                   exit_code_ = EXIT_ERROR; // Until a run completes
+    };
+} // namespace benchmark
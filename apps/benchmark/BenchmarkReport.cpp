@@ -0,0 +1,194 @@
+#include "BenchmarkReport.hpp"
+
+#include "engine/core/utils/Logger.hpp"
+#include "engine/platform/filesystem/PathUtils.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <system_error>
+
+namespace benchmark
+{
+    using namespace vulkan_engine;
+    using json = nlohmann::json;
+
+    namespace
+    {
+        // Percentiles checked against the baseline; p99 of a few hundred frames is too noisy
+        constexpr const char* COMPARED_PERCENTILES[] = {"p50", "p95"};
+
+        float percentile(const std::vector<float>& sorted, float p)
+        {
+            const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<float>(sorted.size())));
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+
+        json summary_to_json(const SampleSeries::Summary& summary)
+        {
+            return {
+                {"count", summary.count},
+                {"mean", summary.mean},
+                {"min", summary.min},
+                {"p50", summary.p50},
+                {"p90", summary.p90},
+                {"p95", summary.p95},
+                {"p99", summary.p99},
+                {"max", summary.max}
+            };
+        }
+    } // namespace
+
+    // ============================================================================
+    // SampleSeries
+    // ============================================================================
+
+    SampleSeries::Summary SampleSeries::summarize() const
+    {
+        Summary summary;
+        if (samples_.empty())
+        {
+            return summary;
+        }
+
+        std::vector<float> sorted = samples_;
+        std::sort(sorted.begin(), sorted.end());
+
+        summary.count = static_cast<uint32_t>(sorted.size());
+        summary.mean  = static_cast<float>(std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size()));
+        summary.min   = sorted.front();
+        summary.p50   = percentile(sorted, 0.50f);
+        summary.p90   = percentile(sorted, 0.90f);
+        summary.p95   = percentile(sorted, 0.95f);
+        summary.p99   = percentile(sorted, 0.99f);
+        summary.max   = sorted.back();
+        return summary;
+    }
+
+    // ============================================================================
+    // BenchmarkReport
+    // ============================================================================
+
+    BenchmarkReport::Metric& BenchmarkReport::metric(std::string_view name)
+    {
+        auto it = metrics_.find(name);
+        if (it == metrics_.end())
+        {
+            it = metrics_.emplace(std::string(name), Metric{}).first;
+        }
+        return it->second;
+    }
+
+    std::string BenchmarkReport::to_json() const
+    {
+        json metrics = json::object();
+        for (const auto& [name, metric] : metrics_)
+        {
+            json entry = json::object();
+            if (!metric.cpu_ms.empty())
+            {
+                entry["cpu_ms"] = summary_to_json(metric.cpu_ms.summarize());
+            }
+            if (!metric.gpu_ms.empty())
+            {
+                entry["gpu_ms"] = summary_to_json(metric.gpu_ms.summarize());
+            }
+            metrics[name] = std::move(entry);
+        }
+
+        json j;
+        j["scene"]   = scene;
+        j["device"]  = device;
+        j["width"]   = width;
+        j["height"]  = height;
+        j["frames"]  = frames;
+        j["metrics"] = std::move(metrics);
+        return j.dump(4);
+    }
+
+    bool BenchmarkReport::write(const std::filesystem::path& path) const
+    {
+        if (path.has_parent_path())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        auto file = core::PathUtils::open_output_file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            logger::error("Failed to write benchmark report: " + path.string());
+            return false;
+        }
+
+        file << to_json() << '\n';
+        return static_cast<bool>(file);
+    }
+
+    std::optional<std::vector<BenchmarkReport::Regression>> BenchmarkReport::compare(const std::filesystem::path& baseline, const Tolerance& tolerance) const
+    {
+        auto file = core::PathUtils::open_input_file(baseline, std::ios::binary);
+        if (!file.is_open())
+        {
+            logger::error("Failed to open benchmark baseline: " + baseline.string());
+            return std::nullopt;
+        }
+
+        json j;
+        try
+        {
+            file >> j;
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Failed to parse benchmark baseline " + baseline.string() + ": " + e.what());
+            return std::nullopt;
+        }
+
+        if (j.value("width", 0u) != width || j.value("height", 0u) != height)
+        {
+            logger::warn("Benchmark baseline was recorded at a different resolution");
+        }
+        if (j.value("device", std::string()) != device)
+        {
+            logger::warn("Benchmark baseline was recorded on " + j.value("device", std::string("an unknown device")));
+        }
+
+        const json&             baseline_metrics = j.contains("metrics") ? j["metrics"] : json::object();
+        std::vector<Regression> regressions;
+
+        auto check = [&](const std::string& name, const char* series_name, const SampleSeries& series)
+        {
+            if (series.empty() || !baseline_metrics.contains(name) || !baseline_metrics[name].contains(series_name))
+            {
+                return;
+            }
+
+            const json&                 reference = baseline_metrics[name][series_name];
+            const SampleSeries::Summary summary   = series.summarize();
+            for (const char* key : COMPARED_PERCENTILES)
+            {
+                if (!reference.contains(key))
+                {
+                    continue;
+                }
+
+                const float expected = reference[key].get<float>();
+                const float current  = std::string_view(key) == "p50" ? summary.p50 : summary.p95;
+                if (current > expected * (1.0f + tolerance.relative) + tolerance.absolute)
+                {
+                    regressions.push_back({name + "." + series_name + "." + key, expected, current});
+                }
+            }
+        };
+
+        for (const auto& [name, metric] : metrics_)
+        {
+            check(name, "cpu_ms", metric.cpu_ms);
+            check(name, "gpu_ms", metric.gpu_ms);
+        }
+
+        return regressions;
+    }
+} // namespace benchmark
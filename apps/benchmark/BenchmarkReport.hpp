@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace benchmark
+{
+    // Raw samples of one metric, in milliseconds
+    class SampleSeries
+    {
+        public:
+            struct Summary
+            {
+                uint32_t count = 0;
+                float    mean  = 0.0f;
+                float    min   = 0.0f;
+                float    p50   = 0.0f;
+                float    p90   = 0.0f;
+                float    p95   = 0.0f;
+                float    p99   = 0.0f;
+                float    max   = 0.0f;
+            };
+
+            void reserve(size_t count) { samples_.reserve(count); }
+            void add(float ms) { samples_.push_back(ms); }
+            bool empty() const { return samples_.empty(); }
+
+            // Nearest-rank percentiles, so every reported value is a measured sample
+            Summary summarize() const;
+
+        private:
+            std::vector<float> samples_;
+    };
+
+    // ============================================================================
+    // BenchmarkReport - Percentiles of a run, and the check against a baseline
+    // ============================================================================
+    // Metrics are keyed "frame" for the whole frame and by render graph pass name
+    // otherwise; each has CPU (recording) and GPU (timestamp) series. The JSON
+    // written by write() is also the baseline format read by compare().
+    class BenchmarkReport
+    {
+        public:
+            struct Metric
+            {
+                SampleSeries cpu_ms;
+                SampleSeries gpu_ms;
+            };
+
+            struct Tolerance
+            {
+                float relative = 0.10f; // Allowed growth over the baseline, 0.10 = 10%
+                float absolute = 0.05f; // ms on top, so sub-millisecond noise never fails a run
+            };
+
+            struct Regression
+            {
+                std::string metric; // e.g. "CubeRenderPass.gpu_ms.p95"
+                float       baseline = 0.0f;
+                float       current  = 0.0f;
+            };
+
+            // Run description written alongside the numbers
+            std::string scene;
+            std::string device;
+            uint32_t    width  = 0;
+            uint32_t    height = 0;
+            uint32_t    frames = 0;
+
+            Metric& metric(std::string_view name);
+
+            bool write(const std::filesystem::path& path) const;
+            std::string to_json() const;
+
+            // p50 and p95 of every metric present in both; nullopt when the baseline
+            // cannot be read
+            std::optional<std::vector<Regression>> compare(const std::filesystem::path& baseline, const Tolerance& tolerance) const;
+
+        private:
+            std::map<std::string, Metric, std::less<>> metrics_;
+    };
+} // namespace benchmark
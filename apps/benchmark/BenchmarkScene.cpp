@@ -0,0 +1,104 @@
+#include "BenchmarkScene.hpp"
+
+#include "engine/core/utils/Logger.hpp"
+#include "engine/platform/filesystem/PathUtils.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+
+namespace benchmark
+{
+    using namespace vulkan_engine;
+    using json = nlohmann::json;
+
+    std::optional<BenchmarkScene> BenchmarkScene::load(const std::filesystem::path& path)
+    {
+        auto file = core::PathUtils::open_input_file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            logger::error("Failed to open benchmark scene: " + path.string());
+            return std::nullopt;
+        }
+
+        try
+        {
+            json j;
+            file >> j;
+
+            BenchmarkScene scene;
+            scene.name          = j.value("name", path.stem().string());
+            scene.width         = j.value("width", scene.width);
+            scene.height        = j.value("height", scene.height);
+            scene.warmup_frames = j.value("warmup_frames", scene.warmup_frames);
+            scene.frames        = std::max(j.value("frames", scene.frames), 1u);
+            scene.mesh          = j.value("mesh", scene.mesh);
+            scene.material      = j.value("material", scene.material);
+
+            if (j.contains("camera"))
+            {
+                const json& camera = j["camera"];
+                if (camera.contains("target") && camera["target"].size() == 3)
+                {
+                    scene.camera_target = glm::vec3(camera["target"][0].get<float>(), camera["target"][1].get<float>(), camera["target"][2].get<float>());
+                }
+
+                for (const json& entry : camera.value("keyframes", json::array()))
+                {
+                    // Unset fields carry over from the previous keyframe
+                    CameraKeyframe key = scene.keyframes.empty() ? CameraKeyframe{} : scene.keyframes.back();
+                    key.frame          = entry.value("frame", 0u);
+                    key.yaw            = entry.value("yaw", key.yaw);
+                    key.pitch          = entry.value("pitch", key.pitch);
+                    key.distance       = entry.value("distance", key.distance);
+                    scene.keyframes.push_back(key);
+                }
+            }
+
+            std::stable_sort(scene.keyframes.begin(), scene.keyframes.end(), [](const CameraKeyframe& a, const CameraKeyframe& b)
+            {
+                return a.frame < b.frame;
+            });
+            if (scene.keyframes.empty())
+            {
+                scene.keyframes.push_back({});
+            }
+
+            return scene;
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Failed to parse benchmark scene " + path.string() + ": " + e.what());
+            return std::nullopt;
+        }
+    }
+
+    CameraPose BenchmarkScene::pose_at(uint32_t frame) const
+    {
+        if (keyframes.empty())
+        {
+            return {};
+        }
+
+        auto next = std::upper_bound(keyframes.begin(), keyframes.end(), frame, [](uint32_t value, const CameraKeyframe& key)
+        {
+            return value < key.frame;
+        });
+        if (next == keyframes.begin())
+        {
+            return {next->yaw, next->pitch, next->distance};
+        }
+        if (next == keyframes.end())
+        {
+            const CameraKeyframe& last = keyframes.back();
+            return {last.yaw, last.pitch, last.distance};
+        }
+
+        const CameraKeyframe& prev = *(next - 1);
+        const float           t    = static_cast<float>(frame - prev.frame) / static_cast<float>(next->frame - prev.frame);
+        return {
+            prev.yaw + (next->yaw - prev.yaw) * t,
+            prev.pitch + (next->pitch - prev.pitch) * t,
+            prev.distance + (next->distance - prev.distance) * t
+        };
+    }
+} // namespace benchmark
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+    // One point of the scripted camera path
+    struct CameraKeyframe
+    {
+        uint32_t frame    = 0;
+        float    yaw      = 45.0f;
+        float    pitch    = -30.0f;
+        float    distance = 3.0f;
+    };
+
+    struct CameraPose
+    {
+        float yaw      = 45.0f;
+        float pitch    = -30.0f;
+        float distance = 3.0f;
+    };
+
+    // ============================================================================
+    // BenchmarkScene - What a benchmark run renders, loaded from JSON
+    // ============================================================================
+    //     {
+    //         "name": "cube_orbit",
+    //         "width": 1280, "height": 720,
+    //         "warmup_frames": 60, "frames": 600,
+    //         "mesh": "",                  // OBJ relative to the project root; empty = demo cube
+    //         "material": "metal.json",
+    //         "camera": {
+    //             "target": [0, 0, 0],
+    //             "keyframes": [{"frame": 0, "yaw": 0}, {"frame": 600, "yaw": 360}]
+    //         }
+    //     }
+    //
+    // The camera follows the keyframes by frame index, never by wall time, so
+    // every run renders the same images whatever the device's speed.
+    struct BenchmarkScene
+    {
+        std::string name          = "default";
+        uint32_t    width         = 1280;
+        uint32_t    height        = 720;
+        uint32_t    warmup_frames = 60; // Rendered but not measured: pipeline and cache warm-up
+        uint32_t    frames        = 600;
+        std::string mesh;
+        std::string material = "metal.json";
+
+        glm::vec3                   camera_target{0.0f};
+        std::vector<CameraKeyframe> keyframes; // Sorted by frame
+
+        // Nullopt (and an error logged) when the file is missing or malformed
+        static std::optional<BenchmarkScene> load(const std::filesystem::path& path);
+
+        // Linear between keyframes, clamped to the first and last one
+        CameraPose pose_at(uint32_t frame) const;
+    };
+} // namespace benchmark
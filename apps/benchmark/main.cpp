@@ -0,0 +1,139 @@
+#include "BenchmarkApplication.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include "engine/platform/filesystem/PathUtils.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+
+using namespace vulkan_engine;
+
+namespace
+{
+    constexpr const char* DEFAULT_SCENE = "apps/benchmark/scenes/cube_orbit.json";
+
+    void print_usage(const char* program)
+    {
+        std::cout << "Usage: " << program << " [options]\n"
+                << "Options:\n"
+                << "  --scene <file.json>     Benchmark scene (default: " << DEFAULT_SCENE << ")\n"
+                << "  --output <file.json>    Report path (default: benchmark_results/<scene>.json)\n"
+                << "  --baseline <file.json>  Earlier report to compare against; exit 1 on regression\n"
+                << "  --tolerance <f>         Allowed relative slowdown (default: 0.10)\n"
+                << "  --min-delta-ms <f>      Allowed absolute slowdown on top (default: 0.05)\n"
+                << "  --frames <n>            Measured frames, overrides the scene\n"
+                << "  --warmup <n>            Warm-up frames, overrides the scene\n"
+                << "  --frames-in-flight <n>  Frames the CPU may run ahead (default: 2)\n"
+                << "  --no-validation         Disable validation layers\n"
+                << "  --help                  Show this help\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::filesystem::path       scene_path = DEFAULT_SCENE;
+        benchmark::BenchmarkOptions options;
+        std::optional<uint32_t>     frames;
+        std::optional<uint32_t>     warmup;
+        uint32_t                    frames_in_flight  = 2;
+        bool                        enable_validation = true;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--scene" && i + 1 < argc)
+            {
+                scene_path = argv[++i];
+            }
+            else if (arg == "--output" && i + 1 < argc)
+            {
+                options.output = argv[++i];
+            }
+            else if (arg == "--baseline" && i + 1 < argc)
+            {
+                options.baseline = argv[++i];
+            }
+            else if (arg == "--tolerance" && i + 1 < argc)
+            {
+                options.tolerance.relative = std::stof(argv[++i]);
+            }
+            else if (arg == "--min-delta-ms" && i + 1 < argc)
+            {
+                options.tolerance.absolute = std::stof(argv[++i]);
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+            {
+                frames = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1u);
+            }
+            else if (arg == "--warmup" && i + 1 < argc)
+            {
+                warmup = static_cast<uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--frames-in-flight" && i + 1 < argc)
+            {
+                frames_in_flight = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1u);
+            }
+            else if (arg == "--no-validation")
+            {
+                enable_validation = false;
+            }
+            else if (arg == "--help")
+            {
+                print_usage(argv[0]);
+                return benchmark::EXIT_OK;
+            }
+        }
+
+        // Relative to the working directory first, then to the project root
+        if (!std::filesystem::exists(scene_path))
+        {
+            scene_path = core::PathUtils::resolve(scene_path);
+        }
+
+        auto scene = benchmark::BenchmarkScene::load(scene_path);
+        if (!scene)
+        {
+            return benchmark::EXIT_ERROR;
+        }
+        scene->frames        = frames.value_or(scene->frames);
+        scene->warmup_frames = warmup.value_or(scene->warmup_frames);
+
+        if (options.output.empty())
+        {
+            options.output = std::filesystem::path("benchmark_results") / (scene->name + ".json");
+        }
+
+        // Headless with no frame limit: the benchmark decides when it is done
+        application::ApplicationConfig config;
+        config.title             = "Vulkan Engine - Benchmark";
+        config.width             = scene->width;
+        config.height            = scene->height;
+        config.vsync             = false;
+        config.enable_validation = enable_validation;
+        config.use_hot_reload    = false;
+        config.frames_in_flight  = frames_in_flight;
+        config.headless          = true;
+        config.headless_frames   = 0;
+
+        options.scene = std::move(*scene);
+        benchmark::BenchmarkApplication app(config, std::move(options));
+
+        if (app.initialize())
+        {
+            app.run();
+        }
+
+        app.shutdown();
+
+        return app.exit_code();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return benchmark::EXIT_ERROR;
+    }
+}
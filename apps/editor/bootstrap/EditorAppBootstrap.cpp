@@ -14,12 +14,14 @@ using namespace vulkan_engine;
 #include "engine/rhi/vulkan/utils/CoordinateTransform.hpp"
 
 #include "engine/rendering/ComposedRenderer.hpp"
+#include "engine/rendering/HeadlessRenderer.hpp"
 #include "engine/rendering/Viewport.hpp"
 #include "engine/rendering/resources/RenderTarget.hpp"
 #include "engine/rendering/render_graph/RenderGraph.hpp"
 #include "engine/rendering/render_graph/CubeRenderPass.hpp"
 #include "engine/rendering/material/Material.hpp"
 #include "engine/rendering/material/MaterialLoader.hpp"
+#include "engine/rendering/shaders/ShaderHotReloader.hpp"
 #include "engine/rendering/resources/Mesh.hpp"
 #include "engine/rendering/resources/ObjLoader.hpp"
 #include "engine/rendering/camera/CameraController.hpp"
@@ -34,6 +36,7 @@ using namespace vulkan_engine;
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include <algorithm>
 
 namespace editor::bootstrap
 {
@@ -61,6 +64,52 @@ namespace editor::bootstrap
             {
                 config.enable_validation = false;
             }
+            else if (arg == "--max-fps" && i + 1 < argc)
+            {
+                config.max_fps = static_cast<uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--low-latency")
+            {
+                config.low_latency = true;
+            }
+            else if (arg == "--frames-in-flight" && i + 1 < argc)
+            {
+                config.frames_in_flight = std::max(static_cast<uint32_t>(std::stoul(argv[++i])), 1u);
+            }
+            else if (arg == "--render-scale" && i + 1 < argc)
+            {
+                config.render_scale = std::stof(argv[++i]);
+            }
+            else if (arg == "--dynamic-resolution")
+            {
+                config.dynamic_resolution = true;
+            }
+            else if (arg == "--min-render-scale" && i + 1 < argc)
+            {
+                config.min_render_scale = std::stof(argv[++i]);
+            }
+            else if (arg == "--target-gpu-ms" && i + 1 < argc)
+            {
+                config.target_gpu_ms      = std::stof(argv[++i]);
+                config.dynamic_resolution = true;
+            }
+            else if (arg == "--pipeline-stats")
+            {
+                config.pipeline_statistics = true;
+            }
+            else if (arg == "--headless")
+            {
+                config.headless = true;
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+            {
+                config.headless_frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--capture" && i + 1 < argc)
+            {
+                config.capture_path = argv[++i];
+                config.headless     = true;
+            }
             else if (arg == "--help")
             {
                 std::cout << "Usage: " << argv[0] << " [options]\n"
@@ -69,6 +118,17 @@ namespace editor::bootstrap
                         << "  --height <n>      Set window height (default: 900)\n"
                         << "  --no-vsync        Disable VSync\n"
                         << "  --no-validation   Disable validation layers\n"
+                        << "  --max-fps <n>     Cap the frame rate (default: uncapped)\n"
+                        << "  --low-latency     Sample input just before the GPU frees a frame\n"
+                        << "  --frames-in-flight <n>  Frames the CPU may run ahead (default: 2)\n"
+                        << "  --render-scale <f>      Scene resolution scale, or its maximum (default: 1.0)\n"
+                        << "  --dynamic-resolution    Scale the scene to hold a GPU frame time\n"
+                        << "  --min-render-scale <f>  Lowest dynamic scale (default: 0.5)\n"
+                        << "  --target-gpu-ms <f>     GPU time to hold, implies --dynamic-resolution (default: 16)\n"
+                        << "  --pipeline-stats        Count shader invocations per pass (stats panel)\n"
+                        << "  --headless              Render offscreen without a window or swap chain\n"
+                        << "  --frames <n>            Headless frames before exiting, 0 = forever (default: 1)\n"
+                        << "  --capture <file.png>    Write the last headless frame, implies --headless\n"
                         << "  --help            Show this help\n";
             }
         }
@@ -86,6 +146,10 @@ namespace editor::bootstrap
             // ComposedRenderer (separate scene and UI pipelines)
             std::unique_ptr<rendering::ComposedRenderer> renderer_;
 
+            // Scene only, in place of renderer_ and editor_ when running headless
+            std::unique_ptr<rendering::HeadlessRenderer> headless_renderer_;
+            uint32_t                                     headless_frame_ = 0;
+
             // Editor
             std::unique_ptr<::vulkan_engine::editor::Editor> editor_;
 
@@ -107,15 +171,25 @@ namespace editor::bootstrap
             std::vector<std::shared_ptr<rendering::Material>> materials_;
             size_t                                            current_material_index_ = 0;
 
+            // Shader hot reload (null when disabled)
+            std::unique_ptr<rendering::ShaderHotReloader> shader_reloader_;
+
             // FPS tracking
             std::chrono::high_resolution_clock::time_point last_time_;
             uint32_t                                       frame_count_ = 0;
             float                                          current_fps_ = 0.0f;
 
+            // Scene pipeline of whichever renderer is active
+            rendering::SceneRenderer& scene();
+
             void load_mesh(std::shared_ptr<vulkan::DeviceManager> device);
             void create_default_cube(std::shared_ptr<vulkan::DeviceManager> device);
-            void initialize_materials(std::shared_ptr<vulkan::DeviceManager> device, rendering::ComposedRenderer* renderer);
+            void initialize_materials(std::shared_ptr<vulkan::DeviceManager>          device,
+                                      rendering::SceneRenderer&                       scene,
+                                      std::shared_ptr<vulkan::memory::BudgetGovernor> governor);
             void initialize_render_graph(std::shared_ptr<vulkan::DeviceManager> device);
+            void record_scene(vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx);
+            void collect_pass_stats(::vulkan_engine::editor::ImGuiManager::StatsData& stats);
             void update_mvp_matrix();
             void update_fps();
             void cleanup_resources();
@@ -135,7 +209,7 @@ namespace editor::bootstrap
         auto device     = device_manager();
         auto swap_chain = this->swap_chain();
 
-        if (!device || !swap_chain)
+        if (!device || (!swap_chain && !config().headless))
         {
             logger::error("Device or swap chain not initialized");
             return false;
@@ -146,40 +220,83 @@ namespace editor::bootstrap
 
         // Initialize ComposedRenderer (separate scene and UI pipelines)
         rendering::ComposedRenderer::Config renderer_config;
-        renderer_config.scene_width          = impl_->width_;
-        renderer_config.scene_height         = impl_->height_;
-        renderer_config.enable_gpu_timing    = true;
-        renderer_config.enable_vsync         = config().vsync;
-        renderer_config.max_frames_in_flight = 2;
-
-        impl_->renderer_ = std::make_unique<rendering::ComposedRenderer>();
-        if (!impl_->renderer_->initialize(window(), device, swap_chain, renderer_config))
+        renderer_config.scene_width                = impl_->width_;
+        renderer_config.scene_height               = impl_->height_;
+        renderer_config.enable_gpu_timing          = true;
+        renderer_config.enable_pipeline_statistics = config().pipeline_statistics;
+        renderer_config.enable_vsync               = config().vsync;
+        renderer_config.max_frames_in_flight       = config().frames_in_flight;
+
+        renderer_config.dynamic_resolution.enabled       = config().dynamic_resolution;
+        renderer_config.dynamic_resolution.max_scale     = config().render_scale;
+        renderer_config.dynamic_resolution.min_scale     = config().min_render_scale;
+        renderer_config.dynamic_resolution.target_gpu_ms = config().target_gpu_ms;
+        renderer_config.dynamic_resolution.settle_frames = config().frames_in_flight + 1;
+
+        if (config().headless)
         {
-            logger::error("Failed to initialize ComposedRenderer");
-            return false;
+            // Scene straight into its RenderTarget; no editor UI to composite it into
+            rendering::HeadlessRenderer::Config headless_config;
+            headless_config.width                      = impl_->width_;
+            headless_config.height                     = impl_->height_;
+            headless_config.enable_gpu_timing          = renderer_config.enable_gpu_timing;
+            headless_config.enable_pipeline_statistics = renderer_config.enable_pipeline_statistics;
+            headless_config.max_frames_in_flight       = renderer_config.max_frames_in_flight;
+            headless_config.dynamic_resolution         = renderer_config.dynamic_resolution;
+
+            impl_->headless_renderer_ = std::make_unique<rendering::HeadlessRenderer>();
+            if (!impl_->headless_renderer_->initialize(device, headless_config))
+            {
+                logger::error("Failed to initialize HeadlessRenderer");
+                return false;
+            }
         }
-
-        // Initialize Editor
-        impl_->editor_ = std::make_unique<::vulkan_engine::editor::Editor>();
-        impl_->editor_->initialize(
-                                   window(),
-                                   device,
-                                   swap_chain,
-                                   impl_->renderer_->scene_render_target(),
-                                   impl_->renderer_->scene_viewport());
-        impl_->editor_->set_deferred_resize_enabled(true);
-
-        // Set viewport resize callback
-        impl_->editor_->set_viewport_resize_callback([this](uint32_t width, uint32_t height)
+        else
         {
-            impl_->renderer_->resize_scene(width, height);
-        });
+            impl_->renderer_ = std::make_unique<rendering::ComposedRenderer>();
+            if (!impl_->renderer_->initialize(window(), device, swap_chain, renderer_config))
+            {
+                logger::error("Failed to initialize ComposedRenderer");
+                return false;
+            }
+
+            // Initialize Editor
+            impl_->editor_ = std::make_unique<::vulkan_engine::editor::Editor>();
+            impl_->editor_->initialize(
+                                       window(),
+                                       device,
+                                       swap_chain,
+                                       impl_->renderer_->scene_render_target(),
+                                       impl_->renderer_->scene_viewport());
+            impl_->editor_->set_deferred_resize_enabled(true);
+
+            // Set viewport resize callback
+            impl_->editor_->set_viewport_resize_callback([this](uint32_t width, uint32_t height)
+            {
+                impl_->renderer_->resize_scene(width, height);
+            });
+        }
 
         // Load mesh
         impl_->load_mesh(device);
 
         // Initialize Material System
-        impl_->initialize_materials(device, impl_->renderer_.get());
+        impl_->initialize_materials(device, impl_->scene(), budget_governor());
+
+        // Rebuild material pipelines in the background when their shaders change on disk
+        if (config().use_hot_reload && !config().headless)
+        {
+            auto shader_manager = std::make_shared<rendering::ShaderManager>();
+            shader_manager->initialize(core::PathUtils::shaders_dir());
+
+            rendering::ShaderHotReloader::Config reload_config;
+            reload_config.frames_in_flight = renderer_config.max_frames_in_flight;
+            impl_->shader_reloader_        = std::make_unique<rendering::ShaderHotReloader>(shader_manager, reload_config);
+            for (const auto& material : impl_->materials_)
+            {
+                impl_->shader_reloader_->track_material(material);
+            }
+        }
 
         // Initialize Render Graph
         impl_->initialize_render_graph(device);
@@ -191,6 +308,17 @@ namespace editor::bootstrap
         impl_->camera_->set_rotation(45.0f, -30.0f);
         impl_->camera_->set_distance_limits(1.0f, 10.0f);
 
+        // Initialize FPS timer
+        impl_->last_time_   = std::chrono::high_resolution_clock::now();
+        impl_->frame_count_ = 0;
+
+        // Headless frames use the fixed starting view
+        if (config().headless)
+        {
+            logger::info("Editor Application initialized headless");
+            return true;
+        }
+
         // Initialize CameraController
         rendering::OrbitCameraController::Config controller_config;
         controller_config.use_imgui_input      = false;
@@ -203,16 +331,18 @@ namespace editor::bootstrap
         impl_->camera_controller_->attach_camera(impl_->camera_);
         impl_->camera_controller_->attach_input_manager(input_manager());
 
-        // Initialize FPS timer
-        impl_->last_time_   = std::chrono::high_resolution_clock::now();
-        impl_->frame_count_ = 0;
-
         logger::info("Editor Application initialized successfully");
         return true;
     }
 
     void EditorApplication::on_shutdown()
     {
+        if (impl_->headless_renderer_)
+        {
+            impl_->headless_renderer_->shutdown();
+            impl_->headless_renderer_.reset();
+        }
+
         if (impl_->renderer_)
         {
             impl_->renderer_->shutdown();
@@ -234,6 +364,12 @@ namespace editor::bootstrap
 
         impl_->update_fps();
 
+        // No camera input or editor panels to feed
+        if (impl_->headless_renderer_)
+        {
+            return;
+        }
+
         if (impl_->camera_controller_)
         {
             impl_->camera_controller_->set_enabled(impl_->editor_->is_viewport_content_hovered());
@@ -261,39 +397,50 @@ namespace editor::bootstrap
         stats.fps                = impl_->current_fps_;
         stats.frame_time         = 1000.0f / impl_->current_fps_;
         stats.gpu_render_time_ms = impl_->renderer_->get_scene_gpu_time_ms();
-        stats.triangle_count     = (impl_->mesh_ && impl_->mesh_->is_uploaded()) ? impl_->mesh_->index_count() / 3 : 12;
-        stats.draw_calls         = 1;
+        stats.render_scale       = impl_->renderer_->scene_render_scale();
         stats.current_material   = impl_->current_material_ ? impl_->current_material_->name() : "None";
+        impl_->collect_pass_stats(stats);
+
+        const auto& pacing         = frame_pacer().stats();
+        stats.input_to_submit_ms   = pacing.input_to_submit_ms;
+        stats.submit_to_present_ms = pacing.submit_to_present_ms;
+        stats.render_wait_ms       = pacing.render_wait_ms;
+
         impl_->editor_->update_stats(stats);
     }
 
     void EditorApplication::on_render()
     {
+        if (impl_->headless_renderer_)
+        {
+            render_headless();
+            return;
+        }
+
         if (!impl_->renderer_ || !impl_->editor_)
             return;
 
-        if (!impl_->renderer_->begin_frame())
+        // Fence waits and image acquire; LowLatency mode sleeps this long before input instead
+        const auto wait_start  = std::chrono::steady_clock::now();
+        const bool frame_ready = impl_->renderer_->begin_frame();
+        frame_pacer().record_render_wait(std::chrono::steady_clock::now() - wait_start);
+        if (!frame_ready)
         {
             return;
         }
 
+        // Swap in pipelines rebuilt since the last frame, before any draw is recorded
+        if (impl_->shader_reloader_)
+        {
+            impl_->shader_reloader_->apply_pending();
+        }
+
         impl_->update_mvp_matrix();
 
         // 1. 棣栧厛娓叉煋鍦烘櫙鍒?RenderTarget
         impl_->renderer_->render_scene([this](vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx)
         {
-            rendering::RenderContext render_ctx;
-            render_ctx.frame_index = ctx.frame_index;
-            render_ctx.image_index = 0; // Scene doesn't have swap chain images
-            render_ctx.width       = ctx.width;
-            render_ctx.height      = ctx.height;
-
-            auto render_target          = impl_->renderer_->scene_render_target();
-            render_ctx.color_image_view = render_target->color_image_view();
-            render_ctx.depth_image_view = render_target->depth_image_view();
-            render_ctx.device           = impl_->renderer_->scene_renderer().device();
-
-            impl_->renderer_->scene_render_graph().execute(cmd, render_ctx);
+            impl_->record_scene(cmd, ctx);
         });
 
         // 2. 鐒跺悗鍒涘缓 ImGui UI锛堝彲浠ラ噰鏍峰凡娓叉煋鐨勫満鏅汗鐞嗭級
@@ -302,7 +449,55 @@ namespace editor::bootstrap
 
         // 3. 娓叉煋UI鍒?SwapChain
         impl_->renderer_->render_ui(*impl_->editor_);
+        frame_pacer().mark_submit();
         impl_->renderer_->end_frame();
+        frame_pacer().mark_present();
+    }
+
+    void EditorApplication::render_headless()
+    {
+        auto& renderer = *impl_->headless_renderer_;
+
+        // Waits for the frame slot's timeline value, which paces the loop in place of present
+        const auto wait_start  = std::chrono::steady_clock::now();
+        const bool frame_ready = renderer.begin_frame();
+        frame_pacer().record_render_wait(std::chrono::steady_clock::now() - wait_start);
+        if (!frame_ready)
+        {
+            logger::error("Headless frame could not be started");
+            request_exit(1);
+            return;
+        }
+
+        impl_->update_mvp_matrix();
+
+        const uint32_t frame_limit = config().headless_frames;
+        const bool     last_frame  = frame_limit > 0 && ++impl_->headless_frame_ >= frame_limit;
+        if (last_frame && !config().capture_path.empty())
+        {
+            renderer.capture(config().capture_path);
+        }
+
+        renderer.render_scene([this](vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx)
+        {
+            impl_->record_scene(cmd, ctx);
+        });
+        frame_pacer().mark_submit();
+        renderer.end_frame();
+        frame_pacer().mark_present();
+
+        if (last_frame)
+        {
+            // Cycles the frame slots until the capture is on disk; a failure fails
+            // the process so CI image checks notice
+            if (!renderer.flush() || renderer.failed_captures() > 0)
+            {
+                logger::error("Headless capture failed: " + config().capture_path);
+                request_exit(1);
+            }
+            logger::info("Headless run finished after ", impl_->headless_frame_, " frames");
+            request_exit();
+        }
     }
 
     void EditorApplication::on_window_resize(const vulkan_engine::application::WindowResizeEvent& event)
@@ -326,10 +521,78 @@ namespace editor::bootstrap
             impl_->editor_->recreate_render_pass(VK_NULL_HANDLE, swap_chain()->image_count());
         }
 
-        logger::info("Window resized to " + std::to_string(width) + "x" + std::to_string(height));
+        logger::info("Window resized to ", width, "x", height);
     }
 
     // Impl 鏂规硶瀹炵幇
+    rendering::SceneRenderer& EditorApplication::Impl::scene()
+    {
+        return headless_renderer_ ? headless_renderer_->scene_renderer() : renderer_->scene_renderer();
+    }
+
+    void EditorApplication::Impl::record_scene(vulkan::RenderCommandBuffer& cmd, const rendering::SceneRenderer::FrameContext& ctx)
+    {
+        rendering::RenderContext render_ctx;
+        render_ctx.frame_index = ctx.frame_index;
+        render_ctx.image_index = 0; // Scene doesn't have swap chain images
+        render_ctx.width       = ctx.width;
+        render_ctx.height      = ctx.height;
+
+        auto render_target          = scene().render_target();
+        render_ctx.color_image_view = render_target->color_image_view();
+        render_ctx.depth_image_view = render_target->depth_image_view();
+        render_ctx.device           = scene().device();
+        render_ctx.gpu_profiler     = ctx.gpu_profiler;
+
+        // Upload material parameters changed since this frame slot was last used
+        if (material_loader_)
+        {
+            material_loader_->parameter_buffer()->flush(ctx.frame_index, ctx.frame_arena);
+        }
+
+        scene().render_graph().execute(cmd, render_ctx);
+    }
+
+    void EditorApplication::Impl::collect_pass_stats(::vulkan_engine::editor::ImGuiManager::StatsData& stats)
+    {
+        const auto*          profiler = scene().gpu_profiler();
+        vulkan::CommandStats totals;
+
+        // Commands are from the last recording; GPU scopes from the last resolved
+        // frame, max_frames_in_flight older
+        for (const auto& pass : scene().render_graph().pass_stats())
+        {
+            ::vulkan_engine::editor::ImGuiManager::PassStats row;
+            row.name     = std::string(pass.name);
+            row.cpu_ms   = pass.cpu_ms;
+            row.commands = pass.commands;
+
+            if (profiler)
+            {
+                for (const auto& scope : profiler->results())
+                {
+                    if (scope.depth == 1 && scope.name == pass.name)
+                    {
+                        row.gpu_ms         = scope.gpu_ms;
+                        row.has_statistics = scope.has_statistics;
+                        row.statistics     = scope.statistics;
+                        break;
+                    }
+                }
+            }
+
+            totals += pass.commands;
+            stats.passes.push_back(std::move(row));
+        }
+
+        stats.triangle_count   = static_cast<uint32_t>(totals.primitives);
+        stats.draw_calls       = totals.draws;
+        stats.pipeline_binds   = totals.pipeline_binds;
+        stats.descriptor_binds = totals.descriptor_binds;
+        stats.push_constants   = totals.push_constants;
+        stats.barriers         = totals.barriers;
+    }
+
     void EditorApplication::Impl::load_mesh(std::shared_ptr<vulkan::DeviceManager> device)
     {
         rendering::ObjLoader obj_loader;
@@ -343,8 +606,8 @@ namespace editor::bootstrap
             if (!mesh_data.is_empty())
             {
                 mesh_ = std::make_unique<rendering::Mesh>();
-                mesh_->upload(device, mesh_data);
-                logger::info("OBJ model loaded: " + std::to_string(mesh_data.vertices.size()) + " vertices");
+                mesh_->upload(scene().geometry_buffer(), device, mesh_data);
+                logger::info("OBJ model loaded: ", mesh_data.vertices.size(), " vertices");
             }
             else
             {
@@ -384,36 +647,44 @@ namespace editor::bootstrap
         index_buffer_->unmap();
     }
 
-    void EditorApplication::Impl::initialize_materials(std::shared_ptr<vulkan::DeviceManager> device, rendering::ComposedRenderer* renderer)
+    void EditorApplication::Impl::initialize_materials(std::shared_ptr<vulkan::DeviceManager>          device,
+                                                       rendering::SceneRenderer&                       scene,
+                                                       std::shared_ptr<vulkan::memory::BudgetGovernor> governor)
     {
         logger::info("Initializing Material System...");
 
-        material_loader_ = std::make_unique<rendering::MaterialLoader>(device);
+        material_loader_ = std::make_unique<rendering::MaterialLoader>(device, scene.config().max_frames_in_flight);
+        material_loader_->set_budget_governor(std::move(governor));
         material_loader_->set_base_directory(core::PathUtils::materials_dir().string() + "/");
         material_loader_->set_texture_directory(core::PathUtils::project_root().string() + "/");
 
-        auto render_target = renderer->scene_render_target();
+        auto render_target = scene.render_target();
 
         if (render_target)
         {
             logger::info("Material system using RenderTarget formats:");
-            logger::info("  color_format: " + std::to_string(render_target->color_format()));
-            logger::info("  depth_format: " + std::to_string(render_target->depth_format()));
+            logger::info("  color_format: ", render_target->color_format());
+            logger::info("  depth_format: ", render_target->depth_format());
         }
 
         VkFormat color_format = render_target->color_format();
         VkFormat depth_format = render_target->depth_format();
 
-        materials_.push_back(material_loader_->load("metal.json", color_format, depth_format));
-        materials_.push_back(material_loader_->load("plastic.json", color_format, depth_format));
-        materials_.push_back(material_loader_->load("emissive.json", color_format, depth_format));
-        materials_.push_back(material_loader_->load("textured.json", color_format, depth_format));
-        materials_.push_back(material_loader_->load("normal_vis.json", color_format, depth_format));
+        auto loaded = material_loader_->load_batch({"metal.json", "plastic.json", "emissive.json", "textured.json", "normal_vis.json"},
+                                                   color_format,
+                                                   depth_format);
+        for (auto& material : loaded)
+        {
+            if (material)
+            {
+                materials_.push_back(std::move(material));
+            }
+        }
 
         if (!materials_.empty())
         {
             current_material_ = materials_[0];
-            logger::info("Loaded " + std::to_string(materials_.size()) + " materials");
+            logger::info("Loaded ", materials_.size(), " materials");
         }
     }
 
@@ -434,6 +705,8 @@ namespace editor::bootstrap
             cube_config.index_buffer  = mesh_->index_buffer();
             cube_config.index_count   = mesh_->index_count();
             cube_config.index_type    = VK_INDEX_TYPE_UINT32;
+            cube_config.first_index   = mesh_->first_index();
+            cube_config.vertex_offset = mesh_->vertex_offset();
         }
         else
         {
@@ -450,8 +723,8 @@ namespace editor::bootstrap
         auto cube_pass = std::make_unique<rendering::CubeRenderPass>(cube_config);
         cube_pass_     = cube_pass.get();
 
-        renderer_->scene_render_graph_builder().add_node(std::move(cube_pass));
-        renderer_->compile_scene_render_graph();
+        scene().render_graph_builder().add_node(std::move(cube_pass));
+        scene().compile_render_graph();
 
         logger::info("Render Graph initialized");
     }
@@ -462,12 +735,9 @@ namespace editor::bootstrap
         glm::mat4 view  = camera_->get_view_matrix();
 
         float aspect_ratio = static_cast<float>(width_) / static_cast<float>(height_);
-        if (renderer_&& renderer_
-        ->
-        scene_viewport()
-        )
+        if (scene().viewport())
         {
-            aspect_ratio = renderer_->scene_viewport()->aspect_ratio();
+            aspect_ratio = scene().viewport()->aspect_ratio();
         }
 
         glm::mat4 proj        = camera_->get_projection_matrix(45.0f, aspect_ratio, 0.1f, 100.0f);
@@ -495,6 +765,7 @@ namespace editor::bootstrap
 
     void EditorApplication::Impl::cleanup_resources()
     {
+        shader_reloader_.reset();
         current_material_.reset();
         materials_.clear();
         material_loader_.reset();
@@ -518,7 +789,18 @@ namespace editor::bootstrap
             .height = config.height,
             .vsync = config.vsync,
             .enable_validation = config.enable_validation,
-            .enable_profiling = config.enable_profiling
+            .enable_profiling = config.enable_profiling,
+            .pipeline_statistics = config.pipeline_statistics,
+            .max_fps = config.max_fps,
+            .low_latency = config.low_latency,
+            .frames_in_flight = config.frames_in_flight,
+            .render_scale = config.render_scale,
+            .dynamic_resolution = config.dynamic_resolution,
+            .min_render_scale = config.min_render_scale,
+            .target_gpu_ms = config.target_gpu_ms,
+            .headless = config.headless,
+            .headless_frames = config.headless_frames,
+            .capture_path = config.capture_path
         };
 
         return std::make_unique < EditorApplication > (app_config);
@@ -29,6 +29,23 @@ namespace editor::bootstrap
         bool        vsync             = true;
         bool        enable_validation = true;
         bool        enable_profiling  = true;
+        uint32_t    max_fps           = 0; // 0 = uncapped
+        bool        low_latency       = false;
+        uint32_t    frames_in_flight  = 2;
+
+        // Per-pass shader invocation counts in the stats panel
+        bool pipeline_statistics = false;
+
+        // Scene resolution
+        float render_scale       = 1.0f;
+        bool  dynamic_resolution = false;
+        float min_render_scale   = 0.5f;
+        float target_gpu_ms      = 16.0f;
+
+        // Offscreen batch run: no window, render frames then write the last one
+        bool        headless        = false;
+        uint32_t    headless_frames = 1;
+        std::string capture_path;
 
         // 浠庡懡浠よ鍙傛暟瑙ｆ瀽閰嶇疆
         static EditorAppConfig parse(int argc, char* argv[]);
@@ -60,6 +77,8 @@ namespace editor::bootstrap
             void on_window_resize(const vulkan_engine::application::WindowResizeEvent& event) override;
 
         private:
+            void render_headless();
+
             class Impl;
             std::unique_ptr<Impl> impl_;
     };
@@ -18,14 +18,16 @@ int main(int argc, char* argv[])
         auto app = editor::bootstrap::create_editor_app(config);
 
         // 鍒濆鍖栧苟杩愯
+        int exit_code = 1;
         if (app->initialize())
         {
             app->run();
+            exit_code = app->exit_code();
         }
 
         app->shutdown();
 
-        return 0;
+        return exit_code;
     }
     catch (const std::exception& e)
     {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "engine/application/app/FramePacer.hpp"
+
 #include <memory>
 #include <string>
 #include <concepts>
@@ -15,6 +17,12 @@ namespace vulkan_engine::vulkan
 {
     class DeviceManager;
     class SwapChain;
+
+    namespace memory
+    {
+        class ResourceManager;
+        class BudgetGovernor;
+    }
 }
 
 namespace vulkan_engine::application
@@ -34,11 +42,32 @@ namespace vulkan_engine::application
         bool        enable_validation = true;
         bool        enable_profiling  = true;
 
+        // Per-pass GPU invocation counts (see vulkan::GpuProfiler); needs the
+        // pipelineStatisticsQuery device feature, ignored without it
+        bool pipeline_statistics = false;
+
         // Renderer settings
         bool use_render_graph  = true;
         bool use_async_loading = true;
         bool use_hot_reload    = true;
 
+        // Frame pacing (see FramePacer)
+        uint32_t max_fps          = 0;     // 0 = uncapped
+        bool     low_latency      = false; // Sample input just before the renderer's frame slot frees up
+        uint32_t frames_in_flight = 2;
+
+        // Scene resolution (see rendering::DynamicResolution)
+        float render_scale       = 1.0f;  // Upper bound; the fixed scale without dynamic resolution
+        bool  dynamic_resolution = false; // Lower the scale to hold target_gpu_ms
+        float min_render_scale   = 0.5f;
+        float target_gpu_ms      = 16.0f;
+
+        // Offscreen mode (see rendering::HeadlessRenderer): no window, input or swap
+        // chain, and a device without surface extensions
+        bool        headless        = false;
+        uint32_t    headless_frames = 1; // Frames rendered before exiting; 0 = until request_exit()
+        std::string capture_path;        // PNG of the last frame; empty = none
+
         // Platform-specific settings
         struct
         {
@@ -127,11 +156,27 @@ namespace vulkan_engine::application
             std::shared_ptr<vulkan::DeviceManager>  device_manager() const { return device_manager_; }
             std::shared_ptr<vulkan::SwapChain>      swap_chain() const { return swap_chain_; }
 
+            std::shared_ptr<vulkan::memory::ResourceManager> resource_manager() const { return resource_manager_; }
+            std::shared_ptr<vulkan::memory::BudgetGovernor>  budget_governor() const { return budget_governor_; }
+
             const ApplicationConfig& config() const { return config_; }
             bool                     running() const { return running_; }
+            int                      exit_code() const { return exit_code_; } // Process exit status once run() returns
+
+            // Derived applications report render waits and submit/present marks
+            FramePacer&       frame_pacer() { return frame_pacer_; }
+            const FramePacer& frame_pacer() const { return frame_pacer_; }
 
         protected:
-            void request_exit() { running_ = false; }
+            // A non-zero code is kept, so a failure is not masked by a later clean exit
+            void request_exit(int exit_code = 0)
+            {
+                running_ = false;
+                if (exit_code != 0)
+                {
+                    exit_code_ = exit_code;
+                }
+            }
 
         private:
             ApplicationConfig                       config_;
@@ -140,7 +185,17 @@ namespace vulkan_engine::application
             std::shared_ptr<platform::InputManager> input_manager_;
             std::shared_ptr<vulkan::DeviceManager>  device_manager_;
             std::shared_ptr<vulkan::SwapChain>      swap_chain_;
-            bool                                    running_ = false;
+
+            std::shared_ptr<vulkan::memory::ResourceManager> resource_manager_;
+            std::shared_ptr<vulkan::memory::BudgetGovernor>  budget_governor_;
+            FramePacer                                       frame_pacer_;
+            bool                                    running_      = false;
+            int                                     exit_code_    = 0;
+            uint64_t                                frame_number_ = 0; // Drives the budget governor
+
+            // Latest window size, dispatched to on_window_resize() once per frame
+            WindowResizeEvent pending_resize_{};
+            bool              resize_pending_ = false;
 
             // Timing
             std::chrono::steady_clock::time_point last_frame_time_;
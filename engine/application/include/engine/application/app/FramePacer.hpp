@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace vulkan_engine::application
+{
+    // ============================================================================
+    // FramePacer - Frame rate cap and input-latency reduction for the main loop
+    // ============================================================================
+    // ApplicationBase::run() calls wait_for_frame() before it polls input, so all
+    // pacing happens while no input is being held:
+    //
+    //  - max_fps caps the loop. The wait sleeps for most of the remaining time and
+    //    spins the rest, since OS sleeps overshoot by up to a scheduler tick.
+    //  - LowLatency also sleeps for the time the renderer is predicted to block on
+    //    its frame fence / swapchain acquire. The renderer reports that blocking
+    //    time through record_render_wait(); once the prediction settles, input is
+    //    sampled just before the GPU frees the frame slot rather than up to
+    //    frames_in_flight frames before it.
+    //
+    // Latency marks (input, submit, present) are set by the loop and the derived
+    // application; stats() reports smoothed intervals between them. Not thread-safe.
+    class FramePacer
+    {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            enum class Mode
+            {
+                Throughput, // Only the fps cap
+                LowLatency  // fps cap + sleep ahead of the predicted render wait
+            };
+
+            struct Config
+            {
+                uint32_t max_fps           = 0; // 0 = uncapped
+                Mode     mode              = Mode::Throughput;
+                float    spin_ms           = 1.0f; // Minimum busy-wait at the end of a sleep
+                float    latency_margin_ms = 0.5f; // LowLatency: left unslept so a slow frame is not missed
+                float    smoothing         = 0.1f; // Weight of the newest sample in the averages
+            };
+
+            // Smoothed milliseconds
+            struct Stats
+            {
+                float frame_ms             = 0.0f; // Loop period
+                float pacing_sleep_ms      = 0.0f; // Spent in wait_for_frame()
+                float render_wait_ms       = 0.0f; // Renderer blocked on fence / acquire
+                float input_to_submit_ms   = 0.0f;
+                float submit_to_present_ms = 0.0f;
+                float input_to_present_ms  = 0.0f;
+            };
+
+            FramePacer();
+            explicit FramePacer(const Config& config);
+
+            void          set_config(const Config& config);
+            const Config& config() const { return config_; }
+
+            // Top of the loop: blocks for the fps cap and, in LowLatency mode, the
+            // predicted render wait. Returns the time actually waited.
+            Clock::duration wait_for_frame();
+
+            // Time the renderer spent blocked before it could record this frame
+            void record_render_wait(Clock::duration wait);
+
+            void mark_input();   // Input polled for this frame
+            void mark_submit();  // Last queue submission of this frame
+            void mark_present(); // Present queued (returns before the image is displayed)
+
+            const Stats& stats() const { return stats_; }
+
+        private:
+            void sleep_until(Clock::time_point deadline);
+            void smooth(float& average, float sample) const;
+
+            Config config_;
+            Stats  stats_;
+
+            Clock::time_point frame_start_{}; // Previous wait_for_frame() exit
+            Clock::time_point input_time_{};
+            Clock::time_point submit_time_{};
+            float             predicted_wait_ms_ = 0.0f; // Pacing sleep + render wait, averaged
+            float             last_sleep_ms_     = 0.0f;
+            float             oversleep_ms_      = 0.0f; // Average sleep_for() overshoot
+            bool              has_input_         = false;
+            bool              has_submit_        = false;
+    };
+} // namespace vulkan_engine::application
@@ -21,10 +21,15 @@ namespace vulkan_engine::application
 
         struct RenderingConfig
         {
-            bool  enable_validation = true;
-            bool  vsync             = true;
-            float render_scale      = 1.0f;
-            bool  use_render_graph  = true;
+            bool     enable_validation  = true;
+            bool     vsync              = true;
+            float    render_scale       = 1.0f; // Maximum scale when dynamic_resolution is on
+            bool     dynamic_resolution = false;
+            float    min_render_scale   = 0.5f;
+            float    target_gpu_ms      = 16.0f;
+            bool     use_render_graph   = true;
+            uint32_t frames_in_flight   = 2;
+            bool     headless           = false; // Offscreen only, no window or swap chain
         } rendering;
 
         struct GraphicsConfig
@@ -32,6 +37,7 @@ namespace vulkan_engine::application
             int  texture_quality = 2; // 0=low, 1=medium, 2=high, 3=ultra
             int  shadow_quality  = 2;
             int  max_fps         = 0; // 0=unlimited
+            bool low_latency     = false;
             bool enable_hdr      = false;
             bool enable_aa       = true;
         } graphics;
@@ -46,9 +52,10 @@ namespace vulkan_engine::application
 
         struct DebugConfig
         {
-            bool enable_profiling = false;
-            bool enable_logging   = true;
-            int  log_level        = 2; // 0=error, 1=warn, 2=info, 3=debug
+            bool enable_profiling    = false;
+            bool pipeline_statistics = false; // Per-pass GPU invocation counts
+            bool enable_logging      = true;
+            int  log_level           = 2; // 0=error, 1=warn, 2=info, 3=debug
         } debug;
 
         // Loading and saving
@@ -4,6 +4,9 @@
 #include "engine/platform/filesystem/PathUtils.hpp"
 #include "engine/rhi/vulkan/device/Device.hpp"
 #include "engine/rhi/vulkan/device/SwapChain.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/memory/BudgetGovernor.hpp"
+#include "engine/core/utils/Profiler.hpp"
 #include <iostream>
 
 #ifdef _WIN32
@@ -22,6 +25,16 @@ namespace vulkan_engine::application
 
     bool ApplicationBase::initialize()
     {
+        // Zones are only recorded when the build also defines VULKAN_ENGINE_ENABLE_PROFILING
+        profiler::Profiler::instance().set_enabled(config_.enable_profiling);
+        PROFILE_THREAD_NAME("Main");
+        PROFILE_SCOPE("ApplicationBase::initialize");
+
+        FramePacer::Config pacer_config;
+        pacer_config.max_fps = config_.max_fps;
+        pacer_config.mode    = config_.low_latency ? FramePacer::Mode::LowLatency : FramePacer::Mode::Throughput;
+        frame_pacer_.set_config(pacer_config);
+
         // Initialize PathUtils with executable path to find correct project root
         // This ensures assets are found regardless of working directory
         {
@@ -42,11 +55,15 @@ namespace vulkan_engine::application
             core::PathUtils::initialize(exe_path);
         }
 
-        // Initialize platform
-        initialize_platform();
+        // Headless runs have no window to create or read input from
+        if (!config_.headless)
+        {
+            // Initialize platform
+            initialize_platform();
 
-        // Initialize input
-        initialize_input();
+            // Initialize input
+            initialize_input();
+        }
 
         // Initialize rendering
         initialize_rendering();
@@ -67,10 +84,18 @@ namespace vulkan_engine::application
         // Call derived class shutdown
         on_shutdown();
 
+        // Per-pool allocation counts for the session
+        if (resource_manager_)
+        {
+            resource_manager_->printStats();
+        }
+
         // Cleanup (reverse order of initialization)
         swap_chain_.reset();
         renderer_.reset();
         input_manager_.reset();
+        budget_governor_.reset();
+        resource_manager_.reset();
         device_manager_.reset();
         window_.reset();
     }
@@ -81,6 +106,15 @@ namespace vulkan_engine::application
 
         while (running_)
         {
+            // Cap and just-in-time wait happen before anything samples input
+            {
+                PROFILE_SCOPE("FramePacer::wait_for_frame");
+                frame_pacer_.wait_for_frame();
+            }
+
+            PROFILE_FRAME_MARK();
+            PROFILE_SCOPE("ApplicationBase::run");
+
             // Calculate delta time
             auto  current_time = std::chrono::steady_clock::now();
             float delta_time   = std::chrono::duration<float>(current_time - last_frame_time_).count();
@@ -89,6 +123,7 @@ namespace vulkan_engine::application
             // Poll window events FIRST (processes GLFW events and triggers callbacks)
             if (window_)
             {
+                PROFILE_SCOPE("ApplicationBase::poll_events");
                 window_->poll_events();
                 if (window_->should_close())
                 {
@@ -96,6 +131,14 @@ namespace vulkan_engine::application
                 }
             }
 
+            // A drag delivers many resize events per frame; only the last one is
+            // dispatched, once, before anything records
+            if (resize_pending_)
+            {
+                resize_pending_ = false;
+                on_window_resize(pending_resize_);
+            }
+
             // Update input state SECOND (updates just_pressed/just_released states)
             if (input_manager_)
             {
@@ -107,12 +150,17 @@ namespace vulkan_engine::application
                     request_exit();
                 }
             }
+            frame_pacer_.mark_input();
 
             // Update application THIRD (uses current input values)
             // Note: scroll_delta is accumulated and reset after reading
-            on_update(delta_time);
+            {
+                PROFILE_SCOPE("ApplicationBase::on_update");
+                on_update(delta_time);
+            }
 
-            // Check if swap chain needs recreation (e.g., window minimized)
+            // Check if swap chain needs recreation (e.g., window minimized). This is
+            // an oldSwapchain handoff; frames in flight keep presenting the old one.
             if (swap_chain_ && swap_chain_->needs_recreation())
             {
                 auto [width, height] = window_->size();
@@ -127,8 +175,23 @@ namespace vulkan_engine::application
                 }
             }
 
+            // Keep every heap inside its budget before recording
+            if (budget_governor_)
+            {
+                PROFILE_SCOPE("BudgetGovernor::update");
+                budget_governor_->update(frame_number_);
+            }
+            if (auto* tracker = resource_manager_ ? resource_manager_->tracker() : nullptr)
+            {
+                tracker->setFrame(frame_number_);
+            }
+            ++frame_number_;
+
             // Render LAST
-            on_render();
+            {
+                PROFILE_SCOPE("ApplicationBase::on_render");
+                on_render();
+            }
         }
     }
 
@@ -137,10 +200,11 @@ namespace vulkan_engine::application
         config_.width  = event.width;
         config_.height = event.height;
 
-        // Recreate swap chain
-        if (swap_chain_)
+        // The loop recreates the swap chain before the next frame. Recreation also
+        // lands here through on_recreate(), with the size it already has.
+        if (swap_chain_ && (event.width != swap_chain_->width() || event.height != swap_chain_->height()))
         {
-            swap_chain_->recreate();
+            swap_chain_->request_recreation();
         }
 
         // Notify renderer of resize
@@ -188,8 +252,8 @@ namespace vulkan_engine::application
 
         window_->on_resize([this](uint32_t width, uint32_t height)
         {
-            WindowResizeEvent event{width, height};
-            on_window_resize(event);
+            pending_resize_ = WindowResizeEvent{width, height};
+            resize_pending_ = true;
         });
     }
 
@@ -200,6 +264,7 @@ namespace vulkan_engine::application
         device_info.application_name   = config_.title;
         device_info.enable_validation  = config_.enable_validation;
         device_info.enable_debug_utils = config_.enable_validation;
+        device_info.headless           = config_.headless;
 
         device_manager_ = std::make_shared<vulkan::DeviceManager>(device_info);
         if (!device_manager_->initialize())
@@ -207,6 +272,22 @@ namespace vulkan_engine::application
             throw std::runtime_error("Failed to initialize Vulkan device");
         }
 
+        // Pooled GPU memory for every Buffer/Image created on this device
+        resource_manager_ = std::make_shared<vulkan::memory::ResourceManager>(device_manager_);
+        device_manager_->set_resource_manager(resource_manager_);
+
+        // Demotes and evicts cold textures/meshes registered with it when a heap nears its budget.
+        // Anything a queued frame drew stays put, however many frames are in flight.
+        vulkan::memory::BudgetGovernor::Config governor_config;
+        governor_config.minIdleFrames = config_.frames_in_flight + 1;
+        budget_governor_              = std::make_shared<vulkan::memory::BudgetGovernor>(resource_manager_, governor_config);
+
+        // Offscreen targets only; frames are paced by the graphics timeline instead of present
+        if (config_.headless)
+        {
+            return;
+        }
+
         // Create swap chain
         vulkan::SwapChainConfig swap_chain_config;
         swap_chain_config.preferred_present_mode = config_.vsync
@@ -0,0 +1,141 @@
+#include "engine/application/app/FramePacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace vulkan_engine::application
+{
+    namespace
+    {
+        float to_ms(FramePacer::Clock::duration duration)
+        {
+            return std::chrono::duration<float, std::milli>(duration).count();
+        }
+
+        FramePacer::Clock::duration from_ms(float ms)
+        {
+            return std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<float, std::milli>(ms));
+        }
+    } // namespace
+
+    FramePacer::FramePacer()
+        : FramePacer(Config{})
+    {
+    }
+
+    FramePacer::FramePacer(const Config& config)
+    {
+        set_config(config);
+    }
+
+    void FramePacer::set_config(const Config& config)
+    {
+        config_                   = config;
+        config_.spin_ms           = std::max(config_.spin_ms, 0.0f);
+        config_.latency_margin_ms = std::max(config_.latency_margin_ms, 0.0f);
+        config_.smoothing         = std::clamp(config_.smoothing, 0.01f, 1.0f);
+    }
+
+    FramePacer::Clock::duration FramePacer::wait_for_frame()
+    {
+        const Clock::time_point now      = Clock::now();
+        Clock::time_point       deadline = now;
+
+        if (config_.max_fps > 0 && frame_start_ != Clock::time_point{})
+        {
+            const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.max_fps));
+            deadline          = frame_start_ + period;
+        }
+
+        // The prediction already includes whatever the cap slept last frame, so
+        // the two waits overlap rather than add up
+        if (config_.mode == Mode::LowLatency)
+        {
+            const float jit_ms = predicted_wait_ms_ - config_.latency_margin_ms;
+            if (jit_ms > 0.0f)
+            {
+                deadline = std::max(deadline, now + from_ms(jit_ms));
+            }
+        }
+
+        if (deadline > now)
+        {
+            sleep_until(deadline);
+        }
+
+        const Clock::time_point start = Clock::now();
+        if (frame_start_ != Clock::time_point{})
+        {
+            smooth(stats_.frame_ms, to_ms(start - frame_start_));
+        }
+        frame_start_   = start;
+        last_sleep_ms_ = to_ms(start - now);
+        smooth(stats_.pacing_sleep_ms, last_sleep_ms_);
+        return start - now;
+    }
+
+    void FramePacer::record_render_wait(Clock::duration wait)
+    {
+        const float wait_ms = to_ms(wait);
+        smooth(stats_.render_wait_ms, wait_ms);
+
+        // Slack this frame could have spent sleeping before input. Oversleeping
+        // leaves no render wait, so the sample shrinks by the margin and the
+        // prediction walks back down when the GPU speeds up.
+        smooth(predicted_wait_ms_, last_sleep_ms_ + wait_ms);
+    }
+
+    void FramePacer::mark_input()
+    {
+        input_time_ = Clock::now();
+        has_input_  = true;
+    }
+
+    void FramePacer::mark_submit()
+    {
+        submit_time_ = Clock::now();
+        if (has_input_)
+        {
+            smooth(stats_.input_to_submit_ms, to_ms(submit_time_ - input_time_));
+        }
+        has_submit_ = true;
+    }
+
+    void FramePacer::mark_present()
+    {
+        const Clock::time_point now = Clock::now();
+        if (has_submit_)
+        {
+            smooth(stats_.submit_to_present_ms, to_ms(now - submit_time_));
+        }
+        if (has_input_)
+        {
+            smooth(stats_.input_to_present_ms, to_ms(now - input_time_));
+        }
+        has_input_  = false;
+        has_submit_ = false;
+    }
+
+    void FramePacer::sleep_until(Clock::time_point deadline)
+    {
+        // Sleep through all but the spin window plus the usual overshoot, then spin
+        const Clock::duration   guard  = from_ms(config_.spin_ms + oversleep_ms_);
+        const Clock::time_point before = Clock::now();
+        if (deadline - before > guard)
+        {
+            const Clock::duration requested = deadline - before - guard;
+            std::this_thread::sleep_for(requested);
+            smooth(oversleep_ms_, std::max(to_ms(Clock::now() - before - requested), 0.0f));
+        }
+
+        while (Clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void FramePacer::smooth(float& average, float sample) const
+    {
+        average = average == 0.0f ? sample : average + (sample - average) * config_.smoothing;
+    }
+} // namespace vulkan_engine::application
@@ -1,4 +1,5 @@
 #include "engine/application/config/Config.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -87,6 +88,26 @@ namespace vulkan_engine::application
             {
                 config.rendering.render_scale = std::stof(value);
             }
+            else if (key == "rendering.dynamic_resolution")
+            {
+                config.rendering.dynamic_resolution = (value == "true" || value == "1");
+            }
+            else if (key == "rendering.min_render_scale")
+            {
+                config.rendering.min_render_scale = std::stof(value);
+            }
+            else if (key == "rendering.target_gpu_ms")
+            {
+                config.rendering.target_gpu_ms = std::stof(value);
+            }
+            else if (key == "rendering.frames_in_flight")
+            {
+                config.rendering.frames_in_flight = static_cast<uint32_t>(std::stoul(value));
+            }
+            else if (key == "rendering.headless")
+            {
+                config.rendering.headless = (value == "true" || value == "1");
+            }
             else if (key == "graphics.texture_quality")
             {
                 config.graphics.texture_quality = std::stoi(value);
@@ -99,6 +120,18 @@ namespace vulkan_engine::application
             {
                 config.graphics.max_fps = std::stoi(value);
             }
+            else if (key == "graphics.low_latency")
+            {
+                config.graphics.low_latency = (value == "true" || value == "1");
+            }
+            else if (key == "debug.profiling")
+            {
+                config.debug.enable_profiling = (value == "true" || value == "1");
+            }
+            else if (key == "debug.pipeline_statistics")
+            {
+                config.debug.pipeline_statistics = (value == "true" || value == "1");
+            }
         }
 
         return config;
@@ -128,41 +161,70 @@ namespace vulkan_engine::application
         file << "rendering.validation=" << (rendering.enable_validation ? "true" : "false") << "\n";
         file << "rendering.vsync=" << (rendering.vsync ? "true" : "false") << "\n";
         file << "rendering.render_scale=" << rendering.render_scale << "\n";
-        file << "rendering.use_render_graph=" << (rendering.use_render_graph ? "true" : "false") << "\n\n";
+        file << "rendering.dynamic_resolution=" << (rendering.dynamic_resolution ? "true" : "false") << "\n";
+        file << "rendering.min_render_scale=" << rendering.min_render_scale << "\n";
+        file << "rendering.target_gpu_ms=" << rendering.target_gpu_ms << "\n";
+        file << "rendering.use_render_graph=" << (rendering.use_render_graph ? "true" : "false") << "\n";
+        file << "rendering.frames_in_flight=" << rendering.frames_in_flight << "\n";
+        file << "rendering.headless=" << (rendering.headless ? "true" : "false") << "\n\n";
 
         file << "[Graphics]\n";
         file << "graphics.texture_quality=" << graphics.texture_quality << "\n";
         file << "graphics.shadow_quality=" << graphics.shadow_quality << "\n";
         file << "graphics.max_fps=" << graphics.max_fps << "\n";
+        file << "graphics.low_latency=" << (graphics.low_latency ? "true" : "false") << "\n";
         file << "graphics.enable_hdr=" << (graphics.enable_hdr ? "true" : "false") << "\n";
-        file << "graphics.enable_aa=" << (graphics.enable_aa ? "true" : "false") << "\n";
+        file << "graphics.enable_aa=" << (graphics.enable_aa ? "true" : "false") << "\n\n";
+
+        file << "[Debug]\n";
+        file << "debug.profiling=" << (debug.enable_profiling ? "true" : "false") << "\n";
+        file << "debug.pipeline_statistics=" << (debug.pipeline_statistics ? "true" : "false") << "\n";
     }
 
     ApplicationConfig Config::to_application_config() const
     {
         ApplicationConfig app_config;
-        app_config.title             = window.title;
-        app_config.width             = window.width;
-        app_config.height            = window.height;
-        app_config.fullscreen        = window.fullscreen;
-        app_config.vsync             = window.vsync;
-        app_config.resizable         = window.resizable;
-        app_config.enable_validation = rendering.enable_validation;
-        app_config.enable_profiling  = false;
-        app_config.use_render_graph  = rendering.use_render_graph;
+        app_config.title               = window.title;
+        app_config.width               = window.width;
+        app_config.height              = window.height;
+        app_config.fullscreen          = window.fullscreen;
+        app_config.vsync               = window.vsync;
+        app_config.resizable           = window.resizable;
+        app_config.enable_validation   = rendering.enable_validation;
+        app_config.enable_profiling    = debug.enable_profiling;
+        app_config.pipeline_statistics = debug.pipeline_statistics;
+        app_config.use_render_graph    = rendering.use_render_graph;
+        app_config.max_fps             = static_cast<uint32_t>(std::max(graphics.max_fps, 0));
+        app_config.low_latency         = graphics.low_latency;
+        app_config.frames_in_flight    = std::max(rendering.frames_in_flight, 1u);
+        app_config.render_scale        = rendering.render_scale;
+        app_config.dynamic_resolution  = rendering.dynamic_resolution;
+        app_config.min_render_scale    = rendering.min_render_scale;
+        app_config.target_gpu_ms       = rendering.target_gpu_ms;
+        app_config.headless            = rendering.headless;
         return app_config;
     }
 
     void Config::from_application_config(const ApplicationConfig& app_config)
     {
-        window.title                = app_config.title;
-        window.width                = app_config.width;
-        window.height               = app_config.height;
-        window.fullscreen           = app_config.fullscreen;
-        window.vsync                = app_config.vsync;
-        window.resizable            = app_config.resizable;
-        rendering.enable_validation = app_config.enable_validation;
-        rendering.use_render_graph  = app_config.use_render_graph;
+        window.title                 = app_config.title;
+        window.width                 = app_config.width;
+        window.height                = app_config.height;
+        window.fullscreen            = app_config.fullscreen;
+        window.vsync                 = app_config.vsync;
+        window.resizable             = app_config.resizable;
+        rendering.enable_validation  = app_config.enable_validation;
+        rendering.use_render_graph   = app_config.use_render_graph;
+        rendering.frames_in_flight   = app_config.frames_in_flight;
+        graphics.max_fps             = static_cast<int>(app_config.max_fps);
+        graphics.low_latency         = app_config.low_latency;
+        debug.enable_profiling       = app_config.enable_profiling;
+        debug.pipeline_statistics    = app_config.pipeline_statistics;
+        rendering.render_scale       = app_config.render_scale;
+        rendering.dynamic_resolution = app_config.dynamic_resolution;
+        rendering.min_render_scale   = app_config.min_render_scale;
+        rendering.target_gpu_ms      = app_config.target_gpu_ms;
+        rendering.headless           = app_config.headless;
     }
 
     void Config::merge_from_args(const std::vector<std::string>& args)
@@ -191,6 +253,35 @@ namespace vulkan_engine::application
             {
                 window.vsync = false;
             }
+            else if (arg == "--max-fps" && i + 1 < args.size())
+            {
+                graphics.max_fps = std::stoi(args[++i]);
+            }
+            else if (arg == "--low-latency")
+            {
+                graphics.low_latency = true;
+            }
+            else if (arg == "--frames-in-flight" && i + 1 < args.size())
+            {
+                rendering.frames_in_flight = static_cast<uint32_t>(std::stoul(args[++i]));
+            }
+            else if (arg == "--render-scale" && i + 1 < args.size())
+            {
+                rendering.render_scale = std::stof(args[++i]);
+            }
+            else if (arg == "--dynamic-resolution")
+            {
+                rendering.dynamic_resolution = true;
+            }
+            else if (arg == "--target-gpu-ms" && i + 1 < args.size())
+            {
+                rendering.target_gpu_ms      = std::stof(args[++i]);
+                rendering.dynamic_resolution = true;
+            }
+            else if (arg == "--headless")
+            {
+                rendering.headless = true;
+            }
             else if (arg == "--validation")
             {
                 rendering.enable_validation = true;
@@ -199,6 +290,18 @@ namespace vulkan_engine::application
             {
                 rendering.enable_validation = false;
             }
+            else if (arg == "--profile")
+            {
+                debug.enable_profiling = true;
+            }
+            else if (arg == "--no-profile")
+            {
+                debug.enable_profiling = false;
+            }
+            else if (arg == "--pipeline-stats")
+            {
+                debug.pipeline_statistics = true;
+            }
         }
     }
 
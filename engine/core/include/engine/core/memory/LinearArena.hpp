@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vulkan_engine::core
+{
+    // ============================================================================
+    // LinearArena - Bump allocator for data that lives for a single frame
+    // ============================================================================
+    // A std::pmr::memory_resource, so per-frame scratch containers are simply
+    // std::pmr::vector<T>{&arena}. Deallocation is a no-op; reset() rewinds the
+    // whole arena. Blocks are kept across resets, and if a frame needed more than
+    // one block they are merged on the next reset, so steady-state frames never
+    // touch the upstream allocator. Not thread-safe: one arena per recording thread.
+    class LinearArena : public std::pmr::memory_resource
+    {
+        public:
+            explicit LinearArena(size_t block_size = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+                : block_size_(std::max<size_t>(block_size, 256))
+                , upstream_(upstream)
+            {
+            }
+
+            ~LinearArena() override { release(); }
+
+            // Non-copyable, non-movable (containers hold a pointer to the arena)
+            LinearArena(const LinearArena&)            = delete;
+            LinearArena& operator=(const LinearArena&) = delete;
+
+            // Invalidates everything allocated since the last reset
+            void reset()
+            {
+                if (blocks_.size() > 1)
+                {
+                    size_t total = 0;
+                    for (const auto& block : blocks_)
+                    {
+                        total += block.size;
+                    }
+                    release();
+                    block_size_ = std::max(block_size_, total);
+                }
+
+                current_ = 0;
+                offset_  = 0;
+                used_    = 0;
+            }
+
+            // Return all blocks to the upstream resource
+            void release()
+            {
+                for (const auto& block : blocks_)
+                {
+                    upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+                }
+                blocks_.clear();
+                current_ = 0;
+                offset_  = 0;
+                used_    = 0;
+            }
+
+            // Construct a trivially destructible object in the arena
+            template <typename T, typename... Args> T* create(Args&&... args)
+            {
+                static_assert(std::is_trivially_destructible_v<T>, "LinearArena never runs destructors");
+                return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            }
+
+            template <typename T> T* allocate_array(size_t count)
+            {
+                static_assert(std::is_trivially_destructible_v<T>, "LinearArena never runs destructors");
+                return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+            }
+
+            size_t bytes_used() const { return used_; }
+            size_t block_count() const { return blocks_.size(); }
+
+            size_t capacity() const
+            {
+                size_t total = 0;
+                for (const auto& block : blocks_)
+                {
+                    total += block.size;
+                }
+                return total;
+            }
+
+        protected:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                while (current_ < blocks_.size())
+                {
+                    Block&    block   = blocks_[current_];
+                    uintptr_t base    = reinterpret_cast<uintptr_t>(block.data);
+                    uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+                    size_t    end     = static_cast<size_t>(aligned - base) + bytes;
+                    if (end <= block.size)
+                    {
+                        used_ += end - offset_;
+                        offset_ = end;
+                        return reinterpret_cast<void*>(aligned);
+                    }
+
+                    // Move on to the next retained block (if any)
+                    ++current_;
+                    offset_ = 0;
+                }
+
+                size_t size = std::max(block_size_, bytes + alignment);
+                blocks_.push_back({static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t))), size});
+                current_ = blocks_.size() - 1;
+                offset_  = 0;
+                return do_allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void*, size_t, size_t) override {}
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        private:
+            struct Block
+            {
+                std::byte* data;
+                size_t     size;
+            };
+
+            size_t                     block_size_;
+            std::pmr::memory_resource* upstream_;
+            std::vector<Block>         blocks_;
+            size_t                     current_ = 0;
+            size_t                     offset_  = 0;
+            size_t                     used_    = 0;
+    };
+} // namespace vulkan_engine::core
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace vulkan_engine::core
+{
+    // ============================================================================
+    // ObjectPool - Fixed-size slots for objects that are created and destroyed often
+    // ============================================================================
+    // Slots are carved out of chunks of objects_per_chunk objects and recycled
+    // through an intrusive free list, so once the pool has grown to its working set
+    // create()/destroy() never reach the upstream allocator. Unlike LinearArena,
+    // objects are destroyed individually and may have non-trivial destructors.
+    // Every object must be destroyed before the pool. Not thread-safe.
+    template <typename T> class ObjectPool
+    {
+        public:
+            // unique_ptr deleter returning the object to its pool
+            struct Deleter
+            {
+                ObjectPool* pool = nullptr;
+
+                void operator()(T* object) const
+                {
+                    if (pool)
+                    {
+                        pool->destroy(object);
+                    }
+                }
+            };
+
+            using Ptr = std::unique_ptr<T, Deleter>;
+
+            explicit ObjectPool(size_t objects_per_chunk = 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+                : objects_per_chunk_(std::max<size_t>(objects_per_chunk, 1))
+                , upstream_(upstream)
+            {
+            }
+
+            ~ObjectPool() { release(); }
+
+            // Non-copyable, non-movable (objects point back at the pool through Ptr)
+            ObjectPool(const ObjectPool&)            = delete;
+            ObjectPool& operator=(const ObjectPool&) = delete;
+
+            template <typename... Args> T* create(Args&&... args)
+            {
+                if (!free_list_)
+                {
+                    grow();
+                }
+
+                Slot* slot = free_list_;
+                free_list_ = slot->next;
+
+                T* object;
+                try
+                {
+                    object = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    slot->next = free_list_;
+                    free_list_ = slot;
+                    throw;
+                }
+                ++live_;
+                return object;
+            }
+
+            template <typename... Args> Ptr make(Args&&... args)
+            {
+                return Ptr(create(std::forward<Args>(args)...), Deleter{this});
+            }
+
+            void destroy(T* object)
+            {
+                if (!object)
+                {
+                    return;
+                }
+
+                object->~T();
+                Slot* slot = reinterpret_cast<Slot*>(object);
+                slot->next = free_list_;
+                free_list_ = slot;
+                --live_;
+            }
+
+            // Return all chunks to the upstream resource; no object may be alive
+            void release()
+            {
+                for (Slot* chunk : chunks_)
+                {
+                    upstream_->deallocate(chunk, sizeof(Slot) * objects_per_chunk_, alignof(Slot));
+                }
+                chunks_.clear();
+                free_list_ = nullptr;
+                live_      = 0;
+            }
+
+            size_t live_count() const { return live_; }
+            size_t capacity() const { return chunks_.size() * objects_per_chunk_; }
+
+        private:
+            union Slot
+            {
+                Slot* next;
+                alignas(T) std::byte storage[sizeof(T)];
+            };
+
+            void grow()
+            {
+                Slot* chunk = static_cast<Slot*>(upstream_->allocate(sizeof(Slot) * objects_per_chunk_, alignof(Slot)));
+                chunks_.push_back(chunk);
+
+                // Thread the new slots onto the free list in address order
+                for (size_t i = objects_per_chunk_; i-- > 0;)
+                {
+                    chunk[i].next = free_list_;
+                    free_list_    = &chunk[i];
+                }
+            }
+
+            size_t                     objects_per_chunk_;
+            std::pmr::memory_resource* upstream_;
+            std::vector<Slot*>         chunks_;
+            Slot*                      free_list_ = nullptr;
+            size_t                     live_      = 0;
+    };
+} // namespace vulkan_engine::core
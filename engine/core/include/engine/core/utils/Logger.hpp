@@ -80,6 +80,9 @@ namespace vulkan_engine::logger
             // 鑾峰彇褰撳墠鏃ュ織绾у埆
             Level get_level() const;
 
+            // Lock-free level check, so callers can skip building filtered messages
+            bool is_enabled(Level level) const;
+
             // 鍚敤/绂佺敤鏂囦欢鏃ュ織
             void set_file_logging(bool enable, const std::string& file_path = "");
 
@@ -123,6 +126,40 @@ namespace vulkan_engine::logger
     inline void error(const std::string& message) { Logger::instance().error(message); }
     inline void fatal(const std::string& message) { Logger::instance().fatal(message); }
 
+    // Lazy overloads: the pieces are streamed into one message only when the level
+    // is enabled, so filtered calls cost a level check instead of string building.
+    //     logger::debug("Created VkFramebuffer ", handle, " (", width, "x", height, ")");
+    template <typename... Args> void log_parts(Level level, const Args&... args)
+    {
+        Logger& logger = Logger::instance();
+        if (logger.is_enabled(level))
+        {
+            std::ostringstream oss;
+            (oss << ... << args);
+            logger.log(level, oss.str());
+        }
+    }
+
+    template <typename First, typename Second, typename... Rest> void debug(const First& first, const Second& second, const Rest&... rest)
+    {
+        log_parts(Level::Debug, first, second, rest...);
+    }
+
+    template <typename First, typename Second, typename... Rest> void info(const First& first, const Second& second, const Rest&... rest)
+    {
+        log_parts(Level::Info, first, second, rest...);
+    }
+
+    template <typename First, typename Second, typename... Rest> void warn(const First& first, const Second& second, const Rest&... rest)
+    {
+        log_parts(Level::Warn, first, second, rest...);
+    }
+
+    template <typename First, typename Second, typename... Rest> void error(const First& first, const Second& second, const Rest&... rest)
+    {
+        log_parts(Level::Error, first, second, rest...);
+    }
+
     // 閰嶇疆鍑芥暟
     inline void initialize(const Config& config) { Logger::instance().initialize(config); }
     inline void shutdown() { Logger::instance().shutdown(); }
@@ -132,36 +169,51 @@ namespace vulkan_engine::logger
     // 瀹忓畾涔夛紙鏀寔鏂囦欢鍚嶅拰琛屽彿锛?
     #define LOG_DEBUG(msg) \
         do { \
-            std::ostringstream _oss; \
-            _oss << msg; \
-            ::vulkan_engine::logger::Logger::instance().debug(_oss.str()); \
+            if (::vulkan_engine::logger::Logger::instance().is_enabled(::vulkan_engine::logger::Level::Debug)) \
+            { \
+                std::ostringstream _oss; \
+                _oss << msg; \
+                ::vulkan_engine::logger::Logger::instance().debug(_oss.str()); \
+            } \
         } while(0)
 
     #define LOG_INFO(msg) \
         do { \
-            std::ostringstream _oss; \
-            _oss << msg; \
-            ::vulkan_engine::logger::Logger::instance().info(_oss.str()); \
+            if (::vulkan_engine::logger::Logger::instance().is_enabled(::vulkan_engine::logger::Level::Info)) \
+            { \
+                std::ostringstream _oss; \
+                _oss << msg; \
+                ::vulkan_engine::logger::Logger::instance().info(_oss.str()); \
+            } \
         } while(0)
 
     #define LOG_WARN(msg) \
         do { \
-            std::ostringstream _oss; \
-            _oss << msg; \
-            ::vulkan_engine::logger::Logger::instance().warn(_oss.str()); \
+            if (::vulkan_engine::logger::Logger::instance().is_enabled(::vulkan_engine::logger::Level::Warn)) \
+            { \
+                std::ostringstream _oss; \
+                _oss << msg; \
+                ::vulkan_engine::logger::Logger::instance().warn(_oss.str()); \
+            } \
         } while(0)
 
     #define LOG_ERROR(msg) \
         do { \
-            std::ostringstream _oss; \
-            _oss << msg; \
-            ::vulkan_engine::logger::Logger::instance().error(_oss.str()); \
+            if (::vulkan_engine::logger::Logger::instance().is_enabled(::vulkan_engine::logger::Level::Error)) \
+            { \
+                std::ostringstream _oss; \
+                _oss << msg; \
+                ::vulkan_engine::logger::Logger::instance().error(_oss.str()); \
+            } \
         } while(0)
 
     #define LOG_FATAL(msg) \
         do { \
-            std::ostringstream _oss; \
-            _oss << msg; \
-            ::vulkan_engine::logger::Logger::instance().fatal(_oss.str()); \
+            if (::vulkan_engine::logger::Logger::instance().is_enabled(::vulkan_engine::logger::Level::Fatal)) \
+            { \
+                std::ostringstream _oss; \
+                _oss << msg; \
+                ::vulkan_engine::logger::Logger::instance().fatal(_oss.str()); \
+            } \
         } while(0)
 } // namespace vulkan_engine::logger
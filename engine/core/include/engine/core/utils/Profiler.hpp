@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vulkan_engine::profiler
+{
+    // Zones are recorded only when the build defines VULKAN_ENGINE_ENABLE_PROFILING
+    // (CMake option of the same name); otherwise the PROFILE_* macros expand to nothing.
+    #if defined(VULKAN_ENGINE_ENABLE_PROFILING) && VULKAN_ENGINE_ENABLE_PROFILING
+    inline constexpr bool COMPILED_IN = true;
+    #else
+    inline constexpr bool COMPILED_IN = false;
+    #endif
+
+    // One finished zone. name is not copied: it must be a string literal, __func__
+    // or a name returned by Profiler::intern().
+    struct ZoneEvent
+    {
+        const char* name     = nullptr;
+        uint64_t    start_ns = 0; // Profiler::now_ns()
+        uint64_t    end_ns   = 0;
+        uint32_t    depth    = 0; // Nesting level on its thread
+    };
+
+    // Zones of one frame across all threads, for the editor flame view
+    struct FrameCapture
+    {
+        struct Zone
+        {
+            const char* name     = nullptr;
+            uint32_t    thread   = 0; // Index into threads
+            uint32_t    depth    = 0;
+            uint64_t    start_ns = 0;
+            uint64_t    end_ns   = 0;
+        };
+
+        uint64_t                 frame_number = 0;
+        uint64_t                 start_ns     = 0;
+        uint64_t                 end_ns       = 0;
+        std::vector<std::string> threads;
+        std::vector<Zone>        zones; // Grouped by thread, ordered by start time
+    };
+
+    class ThreadBuffer;
+
+    /**
+     * @brief Low-overhead CPU zone profiler
+     *
+     * Every thread writes finished zones into its own ring buffer; the owning
+     * thread is the only writer, so recording takes no lock. Readers (flame view,
+     * trace export) copy a ring and drop entries the writer overwrote meanwhile.
+     * frame_mark() splits the timeline into frames. Threads register their buffer
+     * on their first zone; buffers outlive their threads so exports stay complete.
+     */
+    class Profiler
+    {
+        public:
+            static constexpr size_t EVENTS_PER_THREAD = 16384; // Ring size, power of two
+            static constexpr size_t FRAME_HISTORY     = 256;   // Frame markers kept
+
+            static Profiler& instance();
+
+            // Runtime switch on top of the compile-time one (DebugConfig::enable_profiling)
+            void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+            bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+            // Label for the calling thread in exports and the flame view
+            void set_thread_name(const std::string& name);
+
+            // Start of a new frame; call once per frame from the main loop
+            void     frame_mark();
+            uint64_t frame_count() const { return frame_count_.load(std::memory_order_acquire); }
+
+            // Stable copy of a runtime name (e.g. a render graph pass) for zones. Kept for
+            // the process lifetime and takes a lock, so intern once rather than per zone.
+            const char* intern(std::string_view name);
+
+            // Called by ScopedZone on the recording thread
+            void record(const char* name, uint64_t start_ns, uint64_t end_ns, uint32_t depth);
+
+            // Zones of the frame frames_ago frames before the current one (1 = last
+            // complete frame). False if that frame is no longer in the history.
+            bool capture_frame(FrameCapture& capture, uint32_t frames_ago = 1) const;
+
+            // Chrome Trace Event JSON, loadable in chrome://tracing and ui.perfetto.dev
+            bool write_chrome_trace(const std::string& path) const;
+
+            // Monotonic nanoseconds since the profiler was created
+            static uint64_t now_ns();
+
+        private:
+            Profiler();
+            ~Profiler();
+
+            Profiler(const Profiler&)            = delete;
+            Profiler& operator=(const Profiler&) = delete;
+
+            ThreadBuffer& thread_buffer();
+
+            std::atomic<bool> enabled_{false};
+
+            mutable std::mutex                         threads_mutex_; // Registration and reads only
+            std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+
+            std::array<std::atomic<uint64_t>, FRAME_HISTORY> frame_marks_{}; // Start time per frame
+            std::atomic<uint64_t>                            frame_count_{0};
+
+            std::mutex                         names_mutex_;
+            std::set<std::string, std::less<>> names_; // Nodes never move, so c_str() stays valid
+    };
+
+    // RAII zone, normally created through PROFILE_SCOPE / PROFILE_FUNCTION
+    class ScopedZone
+    {
+        public:
+            explicit ScopedZone(const char* name) noexcept;
+            ~ScopedZone();
+
+            ScopedZone(const ScopedZone&)            = delete;
+            ScopedZone& operator=(const ScopedZone&) = delete;
+
+        private:
+            const char* name_     = nullptr; // Null when the profiler was disabled at entry
+            uint64_t    start_ns_ = 0;
+            uint32_t    depth_    = 0;
+    };
+
+    #define VULKAN_ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+    #define VULKAN_ENGINE_PROFILE_CONCAT(a, b) VULKAN_ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+    #if defined(VULKAN_ENGINE_ENABLE_PROFILING) && VULKAN_ENGINE_ENABLE_PROFILING
+    #define PROFILE_SCOPE(name) \
+        ::vulkan_engine::profiler::ScopedZone VULKAN_ENGINE_PROFILE_CONCAT(_profile_zone_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+    #define PROFILE_FRAME_MARK() ::vulkan_engine::profiler::Profiler::instance().frame_mark()
+    #define PROFILE_THREAD_NAME(name) ::vulkan_engine::profiler::Profiler::instance().set_thread_name(name)
+    #else
+    #define PROFILE_SCOPE(name) ((void)0)
+    #define PROFILE_FUNCTION() ((void)0)
+    #define PROFILE_FRAME_MARK() ((void)0)
+    #define PROFILE_THREAD_NAME(name) ((void)0)
+    #endif
+} // namespace vulkan_engine::profiler
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/rhi/vulkan/command/GpuProfiler.hpp"
 #include "engine/platform/windowing/Window.hpp"
 #include "engine/rendering/Viewport.hpp"
+#include "engine/core/utils/Profiler.hpp"
 
 #include <imgui.h>
 #include <memory>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace vulkan_engine::editor
 {
@@ -15,14 +19,37 @@ namespace vulkan_engine::editor
     class ImGuiManager
     {
         public:
+            // One render graph pass of the last resolved frame
+            struct PassStats
+            {
+                std::string          name;
+                float                cpu_ms = 0.0f; // Recording
+                float                gpu_ms = 0.0f;
+                vulkan::CommandStats commands;
+
+                // Only with pipeline statistics enabled and supported
+                bool                                    has_statistics = false;
+                vulkan::GpuProfiler::PipelineStatistics statistics;
+            };
+
             struct StatsData
             {
-                float       fps                = 0.0f;
-                float       frame_time         = 0.0f;
-                float       gpu_render_time_ms = 0.0f; // GPU 瀹為檯娓叉煋鏃堕棿锛堜笉鍚瓑寰咃級
-                uint32_t    triangle_count     = 0;
-                uint32_t    draw_calls         = 0;
-                std::string current_material   = "None";
+                float       fps                  = 0.0f;
+                float       frame_time           = 0.0f;
+                float       gpu_render_time_ms   = 0.0f; // GPU 瀹為檯娓叉煋鏃堕棿锛堜笉鍚瓑寰咃級
+                float       input_to_submit_ms   = 0.0f; // FramePacer latency marks
+                float       submit_to_present_ms = 0.0f;
+                float       render_wait_ms       = 0.0f; // Blocked on the frame fence / acquire
+                float       render_scale         = 1.0f; // Scene resolution relative to the viewport
+                uint32_t    triangle_count       = 0;
+                uint32_t    draw_calls           = 0;
+                uint32_t    pipeline_binds       = 0; // Scene commands, see vulkan::CommandStats
+                uint32_t    descriptor_binds     = 0;
+                uint32_t    push_constants       = 0;
+                uint32_t    barriers             = 0;
+                std::string current_material     = "None";
+
+                std::vector<PassStats> passes;
             };
 
             ImGuiManager();
@@ -77,14 +104,30 @@ namespace vulkan_engine::editor
             void setup_platform_bindings();
             void draw_menu_bar();
             void draw_stats_panel();
+            void draw_pass_stats_table();
             void draw_material_panel();
             void draw_scene_hierarchy();
+            void draw_profiler_panel();
+            void release_retired_viewport_textures();
 
             std::shared_ptr<vulkan::DeviceManager> device_;
             std::shared_ptr<platform::Window>      window_;
 
             VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
 
+            // Scene viewport image: one sampler for the manager's lifetime and the
+            // ImGui descriptor set of the current render target view
+            struct RetiredTexture
+            {
+                VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+                uint64_t        timeline_value = 0; // Last submit that could have drawn it
+            };
+
+            VkSampler                   viewport_sampler_      = VK_NULL_HANDLE;
+            VkDescriptorSet             viewport_texture_      = VK_NULL_HANDLE;
+            VkImageView                 viewport_texture_view_ = VK_NULL_HANDLE;
+            std::vector<RetiredTexture> retired_viewport_textures_;
+
             // State
             bool      initialized_              = false;
             bool      viewport_focused_         = false;
@@ -97,5 +140,10 @@ namespace vulkan_engine::editor
             bool show_material_panel_  = true;
             bool show_scene_hierarchy_ = true;
             bool show_demo_window_     = false;
+            bool show_profiler_panel_  = false;
+
+            // CPU flame view of the last complete frame
+            profiler::FrameCapture profiler_capture_;
+            bool                   profiler_paused_ = false;
     };
 } // namespace vulkan_engine::rendering
\ No newline at end of file
@@ -168,6 +168,6 @@ namespace vulkan_engine::editor
         // For now, we just update the min image count and let ImGui handle the rest
         (void)render_pass; // Render pass changes are handled by the main application
 
-        logger::info("Editor render pass recreated with MinImageCount=" + std::to_string(image_count));
+        logger::info("Editor render pass recreated with MinImageCount=", image_count);
     }
 } // namespace vulkan_engine::editor
\ No newline at end of file
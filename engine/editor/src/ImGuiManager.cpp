@@ -1,24 +1,17 @@
 #include "engine/editor/ImGuiManager.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_vulkan.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <functional>
+#include <string_view>
 
 namespace vulkan_engine::editor
 {
-    // Helper structure to manage viewport texture resources
-    struct ViewportTextureResources
-    {
-        VkSampler       sampler         = VK_NULL_HANDLE;
-        VkDescriptorSet descriptor_set  = VK_NULL_HANDLE;
-        VkImageView     last_image_view = VK_NULL_HANDLE; // Track to detect changes
-    };
-
-    // File-scope storage for viewport texture resources
-    static ViewportTextureResources s_viewport_texture;
-
     ImGuiManager::ImGuiManager() = default;
 
     ImGuiManager::~ImGuiManager()
@@ -78,7 +71,7 @@ namespace vulkan_engine::editor
         {
             if (result != VK_SUCCESS)
             {
-                logger::error("ImGui Vulkan error: " + std::to_string(result));
+                logger::error("ImGui Vulkan error: ", result);
             }
         };
 
@@ -114,8 +107,8 @@ namespace vulkan_engine::editor
             submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
             submit_info.commandBufferCount = 1;
             submit_info.pCommandBuffers    = &command_buffer;
-            VK_CHECK(vkQueueSubmit(device->graphics_queue(), 1, &submit_info, VK_NULL_HANDLE));
-            VK_CHECK(vkQueueWaitIdle(device->graphics_queue()));
+            vulkan::QueueTimeline* timeline = device->graphics_timeline();
+            timeline->wait(timeline->submit(&submit_info, 1));
 
             vkFreeCommandBuffers(device->device(), command_pool, 1, &command_buffer);
             vkDestroyCommandPool(device->device(), command_pool, nullptr);
@@ -134,14 +127,15 @@ namespace vulkan_engine::editor
 
         vkDeviceWaitIdle(device_->device());
 
-        // Clean up viewport texture resources
-        if (s_viewport_texture.sampler != VK_NULL_HANDLE)
+        // Viewport descriptor sets go with the pool below
+        retired_viewport_textures_.clear();
+        viewport_texture_      = VK_NULL_HANDLE;
+        viewport_texture_view_ = VK_NULL_HANDLE;
+        if (viewport_sampler_ != VK_NULL_HANDLE)
         {
-            vkDestroySampler(device_->device(), s_viewport_texture.sampler, nullptr);
-            s_viewport_texture.sampler = VK_NULL_HANDLE;
+            vkDestroySampler(device_->device(), viewport_sampler_, nullptr);
+            viewport_sampler_ = VK_NULL_HANDLE;
         }
-        s_viewport_texture.descriptor_set  = VK_NULL_HANDLE;
-        s_viewport_texture.last_image_view = VK_NULL_HANDLE;
 
         ImGui_ImplVulkan_Shutdown();
         ImGui_ImplGlfw_Shutdown();
@@ -164,6 +158,8 @@ namespace vulkan_engine::editor
             return;
         }
 
+        release_retired_viewport_textures();
+
         ImGui_ImplVulkan_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
@@ -245,6 +241,30 @@ namespace vulkan_engine::editor
                 }
                 // 鍚﹀垯姣斾緥鐩稿悓锛屼娇鐢ㄥ叏绾圭悊
 
+                // Dynamic resolution renders only the top-left render_extent() of the
+                // target; the linear sampler scales that region up to the panel. The
+                // far edges stay half a texel inside it so filtering never reaches
+                // texels this frame did not render.
+                if (auto render_target = viewport->render_target())
+                {
+                    const VkExtent2D full     = render_target->extent();
+                    const VkExtent2D rendered = render_target->render_extent();
+                    if (rendered.width < full.width && full.width > 0)
+                    {
+                        const float max_u = (static_cast<float>(rendered.width) - 0.5f) / static_cast<float>(full.width);
+                        const float scale = static_cast<float>(rendered.width) / static_cast<float>(full.width);
+                        u0                = std::min(u0 * scale, max_u);
+                        u1                = std::min(u1 * scale, max_u);
+                    }
+                    if (rendered.height < full.height && full.height > 0)
+                    {
+                        const float max_v = (static_cast<float>(rendered.height) - 0.5f) / static_cast<float>(full.height);
+                        const float scale = static_cast<float>(rendered.height) / static_cast<float>(full.height);
+                        v0                = std::min(v0 * scale, max_v);
+                        v1                = std::min(v1 * scale, max_v);
+                    }
+                }
+
                 // 鑾峰彇褰撳墠鍏夋爣浣嶇疆锛堝浘鍍忓尯鍩熺殑宸︿笂瑙掞級
                 ImVec2 cursor_pos = ImGui::GetCursorScreenPos();
 
@@ -296,6 +316,13 @@ namespace vulkan_engine::editor
             ImGui::End();
         }
 
+        if (show_profiler_panel_)
+        {
+            ImGui::Begin("Profiler", &show_profiler_panel_);
+            draw_profiler_panel();
+            ImGui::End();
+        }
+
         // === Demo Window (optional) ===
         if (show_demo_window_)
         {
@@ -338,25 +365,14 @@ namespace vulkan_engine::editor
         if (current_image_view == VK_NULL_HANDLE)
             return nullptr;
 
-        // Check if we need to recreate the texture resources
-        // This happens on first call or when viewport's image view changes (resize)
-        if (s_viewport_texture.descriptor_set == VK_NULL_HANDLE ||
-            s_viewport_texture.sampler == VK_NULL_HANDLE ||
-            s_viewport_texture.last_image_view != current_image_view)
+        // The render target view changes on resize; the sampler stays
+        if (viewport_texture_ != VK_NULL_HANDLE && viewport_texture_view_ == current_image_view)
         {
-            // Clean up old resources if they exist
-            if (s_viewport_texture.descriptor_set != VK_NULL_HANDLE)
-            {
-                // Note: ImGui manages descriptor set lifetime, we just create new ones
-                s_viewport_texture.descriptor_set = VK_NULL_HANDLE;
-            }
-            if (s_viewport_texture.sampler != VK_NULL_HANDLE)
-            {
-                vkDestroySampler(device_->device(), s_viewport_texture.sampler, nullptr);
-                s_viewport_texture.sampler = VK_NULL_HANDLE;
-            }
+            return reinterpret_cast<ImTextureID>(viewport_texture_);
+        }
 
-            // Create sampler
+        if (viewport_sampler_ == VK_NULL_HANDLE)
+        {
             VkSamplerCreateInfo sampler_info{};
             sampler_info.sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
             sampler_info.magFilter               = VK_FILTER_LINEAR;
@@ -374,21 +390,37 @@ namespace vulkan_engine::editor
             sampler_info.minLod                  = 0.0f;
             sampler_info.maxLod                  = 1.0f;
 
-            VK_CHECK(vkCreateSampler(device_->device(), &sampler_info, nullptr, &s_viewport_texture.sampler));
+            VK_CHECK(vkCreateSampler(device_->device(), &sampler_info, nullptr, &viewport_sampler_));
+        }
 
-            // Create ImGui texture descriptor set
-            s_viewport_texture.descriptor_set =
-                    ImGui_ImplVulkan_AddTexture(
-                                                s_viewport_texture.sampler,
-                                                current_image_view,
-                                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        // Submitted UI frames may still sample through the old set; it is removed
+        // once the graphics timeline passes the last of them
+        if (viewport_texture_ != VK_NULL_HANDLE)
+        {
+            vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+            retired_viewport_textures_.push_back({viewport_texture_, timeline ? timeline->last_submitted() : 0});
+        }
 
-            s_viewport_texture.last_image_view = current_image_view;
+        viewport_texture_      = ImGui_ImplVulkan_AddTexture(viewport_sampler_, current_image_view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        viewport_texture_view_ = current_image_view;
 
-            logger::info("Viewport texture recreated for new image view");
-        }
+        logger::info("Viewport texture recreated for new image view");
+        return reinterpret_cast<ImTextureID>(viewport_texture_);
+    }
 
-        return reinterpret_cast<ImTextureID>(s_viewport_texture.descriptor_set);
+    void ImGuiManager::release_retired_viewport_textures()
+    {
+        vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+        auto                   retired  = std::remove_if(retired_viewport_textures_.begin(), retired_viewport_textures_.end(), [timeline](const RetiredTexture& texture)
+        {
+            if (timeline && !timeline->is_complete(texture.timeline_value))
+            {
+                return false;
+            }
+            ImGui_ImplVulkan_RemoveTexture(texture.descriptor_set);
+            return true;
+        });
+        retired_viewport_textures_.erase(retired, retired_viewport_textures_.end());
     }
 
     void ImGuiManager::create_descriptor_pool(uint32_t image_count)
@@ -449,6 +481,7 @@ namespace vulkan_engine::editor
                 ImGui::MenuItem("Scene Hierarchy", nullptr, &show_scene_hierarchy_);
                 ImGui::MenuItem("Stats", nullptr, &show_stats_panel_);
                 ImGui::MenuItem("Material", nullptr, &show_material_panel_);
+                ImGui::MenuItem("Profiler", nullptr, &show_profiler_panel_);
                 ImGui::Separator();
                 ImGui::MenuItem("Demo Window", nullptr, &show_demo_window_);
                 ImGui::EndMenu();
@@ -476,14 +509,211 @@ namespace vulkan_engine::editor
         ImGui::Text("FPS: %.1f", stats_data_.fps);
         ImGui::Text("Frame Time: %.2f ms", stats_data_.frame_time);
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "GPU Render: %.2f ms", stats_data_.gpu_render_time_ms);
+        ImGui::Text("Render Scale: %.0f%%", stats_data_.render_scale * 100.0f);
+        ImGui::Spacing();
+        ImGui::Text("Latency");
+        ImGui::Separator();
+        ImGui::Text("Input to Submit: %.2f ms", stats_data_.input_to_submit_ms);
+        ImGui::Text("Submit to Present: %.2f ms", stats_data_.submit_to_present_ms);
+        ImGui::Text("Render Wait: %.2f ms", stats_data_.render_wait_ms);
         ImGui::Spacing();
         ImGui::Text("Scene");
         ImGui::Separator();
         ImGui::Text("Triangles: %u", stats_data_.triangle_count);
         ImGui::Text("Draw Calls: %u", stats_data_.draw_calls);
+        if (!vulkan::COMMAND_STATS_COMPILED_IN)
+        {
+            ImGui::TextDisabled("Built without VULKAN_ENGINE_ENABLE_COMMAND_STATS");
+        }
+        ImGui::Text("Pipeline Binds: %u", stats_data_.pipeline_binds);
+        ImGui::Text("Descriptor Binds: %u", stats_data_.descriptor_binds);
+        ImGui::Text("Push Constants: %u", stats_data_.push_constants);
+        ImGui::Text("Barriers: %u", stats_data_.barriers);
+
+        // Binds per draw is what climbs first when batching breaks down
+        if (stats_data_.draw_calls > 0)
+        {
+            const float binds_per_draw = static_cast<float>(stats_data_.pipeline_binds + stats_data_.descriptor_binds) / static_cast<float>(stats_data_.draw_calls);
+            ImGui::Text("Binds / Draw: %.2f", binds_per_draw);
+        }
 
         ImGui::Spacing();
         ImGui::Text("Current Material: %s", stats_data_.current_material.c_str());
+
+        if (!stats_data_.passes.empty())
+        {
+            ImGui::Spacing();
+            draw_pass_stats_table();
+        }
+    }
+
+    void ImGuiManager::draw_pass_stats_table()
+    {
+        const bool has_statistics = std::any_of(stats_data_.passes.begin(), stats_data_.passes.end(), [](const PassStats& pass)
+        {
+            return pass.has_statistics;
+        });
+
+        ImGui::Text("Passes");
+        ImGui::Separator();
+
+        const int      columns = has_statistics ? 11 : 9;
+        constexpr auto flags   = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+        if (!ImGui::BeginTable("PassStats", columns, flags))
+        {
+            return;
+        }
+
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("CPU ms");
+        ImGui::TableSetupColumn("GPU ms");
+        ImGui::TableSetupColumn("Draws");
+        ImGui::TableSetupColumn("Tris");
+        ImGui::TableSetupColumn("Pipe");
+        ImGui::TableSetupColumn("Desc");
+        ImGui::TableSetupColumn("Push");
+        ImGui::TableSetupColumn("Barr");
+        if (has_statistics)
+        {
+            ImGui::TableSetupColumn("VS Inv");
+            ImGui::TableSetupColumn("FS Inv");
+        }
+        ImGui::TableHeadersRow();
+
+        for (const auto& pass : stats_data_.passes)
+        {
+            const auto& commands = pass.commands;
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(pass.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.cpu_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.gpu_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", commands.draws);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(commands.primitives));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", commands.pipeline_binds);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", commands.descriptor_binds);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", commands.push_constants);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", commands.barriers);
+            if (has_statistics)
+            {
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(pass.statistics.vertex_invocations));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(pass.statistics.fragment_invocations));
+            }
+        }
+
+        ImGui::EndTable();
+    }
+
+    void ImGuiManager::draw_profiler_panel()
+    {
+        if (!profiler::COMPILED_IN)
+        {
+            ImGui::TextDisabled("Built without VULKAN_ENGINE_ENABLE_PROFILING");
+            return;
+        }
+
+        auto& profiler = profiler::Profiler::instance();
+
+        bool recording = profiler.is_enabled();
+        if (ImGui::Checkbox("Record", &recording))
+        {
+            profiler.set_enabled(recording);
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &profiler_paused_);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Trace"))
+        {
+            const std::string path = "profile_trace.json";
+            if (profiler.write_chrome_trace(path))
+            {
+                logger::info("Profiler trace written to " + path + " (open in ui.perfetto.dev or chrome://tracing)");
+            }
+            else
+            {
+                logger::error("Failed to write profiler trace to " + path);
+            }
+        }
+
+        if (!profiler_paused_)
+        {
+            profiler.capture_frame(profiler_capture_);
+        }
+
+        const auto& capture = profiler_capture_;
+        if (capture.end_ns <= capture.start_ns)
+        {
+            ImGui::TextDisabled("No complete frame recorded yet");
+            return;
+        }
+
+        const double frame_ns = static_cast<double>(capture.end_ns - capture.start_ns);
+        ImGui::Text("Frame %llu: %.2f ms", static_cast<unsigned long long>(capture.frame_number), frame_ns / 1000000.0);
+        ImGui::Separator();
+
+        // One band per thread, one row per nesting level, x = time within the frame
+        ImDrawList*  draw_list  = ImGui::GetWindowDrawList();
+        const ImVec2 origin     = ImGui::GetCursorScreenPos();
+        const float  width      = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+        const float  row_height = ImGui::GetTextLineHeightWithSpacing();
+        const double px_per_ns  = width / frame_ns;
+
+        float  y = origin.y;
+        size_t i = 0;
+        for (uint32_t thread = 0; thread < capture.threads.size(); ++thread)
+        {
+            const size_t first     = i;
+            uint32_t     max_depth = 0;
+            while (i < capture.zones.size() && capture.zones[i].thread == thread)
+            {
+                max_depth = std::max(max_depth, capture.zones[i].depth);
+                ++i;
+            }
+            if (first == i)
+            {
+                continue;
+            }
+
+            draw_list->AddText(ImVec2(origin.x, y), IM_COL32(200, 200, 200, 255), capture.threads[thread].c_str());
+            y += row_height;
+
+            for (size_t z = first; z < i; ++z)
+            {
+                const auto&  zone  = capture.zones[z];
+                const double start = static_cast<double>(std::max(zone.start_ns, capture.start_ns) - capture.start_ns);
+                const double end   = static_cast<double>(std::min(zone.end_ns, capture.end_ns) - capture.start_ns);
+
+                const ImVec2 min(origin.x + static_cast<float>(start * px_per_ns), y + zone.depth * row_height);
+                const ImVec2 max(std::max(origin.x + static_cast<float>(end * px_per_ns), min.x + 1.0f), min.y + row_height - 1.0f);
+
+                // Stable colour per zone name
+                const float hue = static_cast<float>(std::hash<std::string_view>{}(zone.name ? zone.name : "") % 360) / 360.0f;
+                draw_list->AddRectFilled(min, max, ImColor::HSV(hue, 0.45f, 0.75f));
+
+                if (zone.name && ImGui::CalcTextSize(zone.name).x + 4.0f < max.x - min.x)
+                {
+                    draw_list->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32(0, 0, 0, 255), zone.name);
+                }
+                if (ImGui::IsMouseHoveringRect(min, max))
+                {
+                    ImGui::SetTooltip("%s\n%.3f ms", zone.name ? zone.name : "?", static_cast<double>(zone.end_ns - zone.start_ns) / 1000000.0);
+                }
+            }
+            y += (max_depth + 1) * row_height + ImGui::GetStyle().ItemSpacing.y;
+        }
+
+        ImGui::Dummy(ImVec2(width, y - origin.y));
     }
 
     void ImGuiManager::draw_material_panel()
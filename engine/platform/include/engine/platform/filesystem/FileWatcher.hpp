@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vulkan_engine::filesystem
+{
+    // ============================================================================
+    // FileWatcher - Background notification of file changes under directories
+    // ============================================================================
+    // Uses inotify on Linux and falls back to periodic directory scans elsewhere
+    // (or when inotify is unavailable). Either way the scanning happens on the
+    // watcher thread, never on the frame loop. Bursts of events (editors writing
+    // through temp files, build tools touching many outputs) are coalesced and
+    // reported once the directory has been quiet for the debounce interval.
+    class FileWatcher
+    {
+        public:
+            enum class Backend
+            {
+                Inotify,
+                Polling
+            };
+
+            struct Config
+            {
+                std::chrono::milliseconds poll_interval{500}; // Polling backend scan period
+                std::chrono::milliseconds debounce{100};      // Quiet time before a batch is reported
+                bool                      force_polling = false;
+            };
+
+            // Invoked on the watcher thread with the deduplicated, normalized paths of
+            // files that were written, created, renamed into place or deleted
+            using Callback = std::function<void(const std::vector<std::filesystem::path>& changed_files)>;
+
+            explicit FileWatcher(Callback callback);
+            FileWatcher(Callback callback, const Config& config);
+            ~FileWatcher();
+
+            // Non-copyable
+            FileWatcher(const FileWatcher&)            = delete;
+            FileWatcher& operator=(const FileWatcher&) = delete;
+
+            // May be called before or after start()
+            void add_directory(const std::filesystem::path& directory, bool recursive = true);
+
+            void    start();
+            void    stop();
+            bool    is_running() const;
+            Backend backend() const;
+
+            // Canonical form used for reported paths (absolute, lexically normal)
+            static std::filesystem::path normalize(const std::filesystem::path& path);
+
+        private:
+            struct Impl;
+            std::unique_ptr<Impl> impl_;
+    };
+} // namespace vulkan_engine::filesystem
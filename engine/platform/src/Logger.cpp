@@ -130,6 +130,12 @@ namespace vulkan_engine::logger
                 return config_.min_level;
             }
 
+            bool is_enabled(Level level) const
+            {
+                // Same unlocked read as the fast path in log()
+                return static_cast<int>(level) >= static_cast<int>(config_.min_level);
+            }
+
             void flush()
             {
                 std::lock_guard<std::mutex> lock(mutex_);
@@ -430,6 +436,11 @@ namespace vulkan_engine::logger
         return impl_->get_level();
     }
 
+    bool Logger::is_enabled(Level level) const
+    {
+        return impl_->is_enabled(level);
+    }
+
     void Logger::set_file_logging(bool enable, const std::string& file_path)
     {
         impl_->set_file_logging(enable, file_path);
@@ -0,0 +1,306 @@
+#include "engine/core/utils/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace vulkan_engine::profiler
+{
+    namespace
+    {
+        const std::chrono::steady_clock::time_point PROFILER_EPOCH = std::chrono::steady_clock::now();
+
+        constexpr size_t EVENT_MASK = Profiler::EVENTS_PER_THREAD - 1;
+        static_assert((Profiler::EVENTS_PER_THREAD & EVENT_MASK) == 0, "EVENTS_PER_THREAD must be a power of two");
+
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        thread_local uint32_t      t_depth  = 0;
+
+        void write_json_string(std::ostream& out, const char* text)
+        {
+            out << '"';
+            for (const char* c = text ? text : ""; *c; ++c)
+            {
+                switch (*c)
+                {
+                    case '"':
+                        out << "\\\"";
+                        break;
+                    case '\\':
+                        out << "\\\\";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(*c) >= 0x20)
+                        {
+                            out << *c;
+                        }
+                        break;
+                }
+            }
+            out << '"';
+        }
+
+        double to_us(uint64_t ns)
+        {
+            return static_cast<double>(ns) / 1000.0;
+        }
+    } // namespace
+
+    // Single-writer ring of finished zones. head counts every event ever written;
+    // the writer fills a slot and then publishes it by bumping head (release).
+    class ThreadBuffer
+    {
+        public:
+            ThreadBuffer(uint32_t index, std::string name)
+                : index(index)
+                , name(std::move(name))
+                , slots(std::make_unique<Slot[]>(Profiler::EVENTS_PER_THREAD))
+            {
+            }
+
+            void push(const ZoneEvent& event)
+            {
+                const uint64_t position = head.load(std::memory_order_relaxed);
+                Slot&          slot     = slots[position & EVENT_MASK];
+                slot.name.store(event.name, std::memory_order_relaxed);
+                slot.start_ns.store(event.start_ns, std::memory_order_relaxed);
+                slot.end_ns.store(event.end_ns, std::memory_order_relaxed);
+                slot.depth.store(event.depth, std::memory_order_relaxed);
+                head.store(position + 1, std::memory_order_release);
+            }
+
+            // Copy the events still in the ring. The slot at head may be mid-write
+            // and aliases the oldest one, so at most EVENTS_PER_THREAD - 1 events are
+            // readable; slots the writer reused while we copied are dropped by
+            // re-reading head afterwards.
+            void snapshot(std::vector<ZoneEvent>& out) const
+            {
+                const uint64_t end   = head.load(std::memory_order_acquire);
+                const uint64_t begin = oldest_readable(end);
+
+                const size_t first = out.size();
+                for (uint64_t i = begin; i < end; ++i)
+                {
+                    const Slot& slot = slots[i & EVENT_MASK];
+                    out.push_back({slot.name.load(std::memory_order_relaxed),
+                                   slot.start_ns.load(std::memory_order_relaxed),
+                                   slot.end_ns.load(std::memory_order_relaxed),
+                                   slot.depth.load(std::memory_order_relaxed)});
+                }
+
+                const uint64_t valid_from = oldest_readable(head.load(std::memory_order_acquire));
+                if (valid_from > begin)
+                {
+                    const size_t overwritten = static_cast<size_t>(std::min(valid_from, end) - begin);
+                    out.erase(out.begin() + first, out.begin() + first + overwritten);
+                }
+            }
+
+            const uint32_t index;
+            std::string    name; // Guarded by Profiler::threads_mutex_
+
+        private:
+            // Relaxed atomics (plain moves on common targets) so a reader racing
+            // the writer sees stale values instead of undefined behaviour
+            struct Slot
+            {
+                std::atomic<const char*> name{nullptr};
+                std::atomic<uint64_t>    start_ns{0};
+                std::atomic<uint64_t>    end_ns{0};
+                std::atomic<uint32_t>    depth{0};
+            };
+
+            static uint64_t oldest_readable(uint64_t position)
+            {
+                return position >= Profiler::EVENTS_PER_THREAD ? position - (Profiler::EVENTS_PER_THREAD - 1) : 0;
+            }
+
+            std::unique_ptr<Slot[]> slots;
+            std::atomic<uint64_t>   head{0};
+    };
+
+    // ============================================================================
+    // Profiler
+    // ============================================================================
+
+    Profiler& Profiler::instance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler::Profiler() = default;
+
+    Profiler::~Profiler() = default;
+
+    uint64_t Profiler::now_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - PROFILER_EPOCH).count());
+    }
+
+    ThreadBuffer& Profiler::thread_buffer()
+    {
+        if (!t_buffer)
+        {
+            std::lock_guard<std::mutex> lock(threads_mutex_);
+            const auto                  index = static_cast<uint32_t>(threads_.size());
+            threads_.push_back(std::make_unique<ThreadBuffer>(index, index == 0 ? "Main" : "Thread " + std::to_string(index)));
+            t_buffer = threads_.back().get();
+        }
+        return *t_buffer;
+    }
+
+    void Profiler::set_thread_name(const std::string& name)
+    {
+        ThreadBuffer&               buffer = thread_buffer();
+        std::lock_guard<std::mutex> lock(threads_mutex_);
+        buffer.name = name;
+    }
+
+    void Profiler::frame_mark()
+    {
+        const uint64_t frame               = frame_count_.load(std::memory_order_relaxed);
+        frame_marks_[frame % FRAME_HISTORY].store(now_ns(), std::memory_order_relaxed);
+        frame_count_.store(frame + 1, std::memory_order_release);
+    }
+
+    const char* Profiler::intern(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(names_mutex_);
+        auto                        it = names_.find(name);
+        if (it == names_.end())
+        {
+            it = names_.emplace(name).first;
+        }
+        return it->c_str();
+    }
+
+    void Profiler::record(const char* name, uint64_t start_ns, uint64_t end_ns, uint32_t depth)
+    {
+        thread_buffer().push({name, start_ns, end_ns, depth});
+    }
+
+    bool Profiler::capture_frame(FrameCapture& capture, uint32_t frames_ago) const
+    {
+        const uint64_t count = frame_count();
+        if (frames_ago == 0 || frames_ago >= FRAME_HISTORY || count < frames_ago + 1)
+        {
+            return false;
+        }
+
+        const uint64_t frame = count - 1 - frames_ago;
+        capture.frame_number = frame;
+        capture.start_ns     = frame_marks_[frame % FRAME_HISTORY].load(std::memory_order_relaxed);
+        capture.end_ns       = frame_marks_[(frame + 1) % FRAME_HISTORY].load(std::memory_order_relaxed);
+        capture.threads.clear();
+        capture.zones.clear();
+
+        std::vector<ZoneEvent>      events;
+        std::lock_guard<std::mutex> lock(threads_mutex_);
+        for (const auto& buffer : threads_)
+        {
+            events.clear();
+            buffer->snapshot(events);
+
+            const size_t first = capture.zones.size();
+            for (const ZoneEvent& event : events)
+            {
+                if (event.end_ns > capture.start_ns && event.start_ns < capture.end_ns)
+                {
+                    capture.zones.push_back({event.name, buffer->index, event.depth, event.start_ns, event.end_ns});
+                }
+            }
+
+            // Events are written when a zone ends, so children come before parents
+            std::sort(capture.zones.begin() + first, capture.zones.end(), [](const FrameCapture::Zone& a, const FrameCapture::Zone& b) { return a.start_ns < b.start_ns || (a.start_ns == b.start_ns && a.depth < b.depth); });
+            capture.threads.push_back(buffer->name);
+        }
+        return true;
+    }
+
+    bool Profiler::write_chrome_trace(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            return false;
+        }
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        bool first = true;
+        auto separator = [&]()
+        {
+            if (!first)
+            {
+                out << ",\n";
+            }
+            first = false;
+        };
+
+        {
+            std::vector<ZoneEvent>      events;
+            std::lock_guard<std::mutex> lock(threads_mutex_);
+            for (const auto& buffer : threads_)
+            {
+                separator();
+                out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->index << ",\"args\":{\"name\":";
+                write_json_string(out, buffer->name.c_str());
+                out << "}}";
+
+                events.clear();
+                buffer->snapshot(events);
+                for (const ZoneEvent& event : events)
+                {
+                    separator();
+                    out << "{\"ph\":\"X\",\"cat\":\"cpu\",\"name\":";
+                    write_json_string(out, event.name);
+                    out << ",\"pid\":1,\"tid\":" << buffer->index << ",\"ts\":" << to_us(event.start_ns)
+                        << ",\"dur\":" << to_us(event.end_ns - event.start_ns) << "}";
+                }
+            }
+        }
+
+        const uint64_t count  = frame_count();
+        const uint64_t oldest = count > FRAME_HISTORY ? count - FRAME_HISTORY : 0;
+        for (uint64_t frame = oldest; frame < count; ++frame)
+        {
+            separator();
+            out << "{\"ph\":\"i\",\"s\":\"g\",\"name\":\"Frame " << frame << "\",\"pid\":1,\"tid\":0,\"ts\":"
+                << to_us(frame_marks_[frame % FRAME_HISTORY].load(std::memory_order_relaxed)) << "}";
+        }
+
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+    // ============================================================================
+    // ScopedZone
+    // ============================================================================
+
+    ScopedZone::ScopedZone(const char* name) noexcept
+    {
+        if (!Profiler::instance().is_enabled())
+        {
+            return;
+        }
+
+        name_     = name;
+        depth_    = t_depth++;
+        start_ns_ = Profiler::now_ns();
+    }
+
+    ScopedZone::~ScopedZone()
+    {
+        if (!name_)
+        {
+            return;
+        }
+
+        const uint64_t end_ns = Profiler::now_ns();
+        --t_depth;
+        Profiler::instance().record(name_, start_ns_, end_ns, depth_);
+    }
+} // namespace vulkan_engine::profiler
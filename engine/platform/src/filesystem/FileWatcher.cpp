@@ -0,0 +1,401 @@
+#include "engine/platform/filesystem/FileWatcher.hpp"
+#include "engine/core/utils/Logger.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace vulkan_engine::filesystem
+{
+    struct FileWatcher::Impl
+    {
+        struct WatchedDirectory
+        {
+            std::filesystem::path path;
+            bool                  recursive;
+        };
+
+        struct FileStamp
+        {
+            std::filesystem::file_time_type time;
+            uintmax_t                       size;
+
+            bool operator!=(const FileStamp& other) const { return time != other.time || size != other.size; }
+        };
+
+        Callback callback;
+        Config   config;
+        Backend  backend = Backend::Polling;
+
+        std::vector<WatchedDirectory> directories;
+        std::thread                   thread;
+        std::atomic<bool>             running{false};
+        mutable std::mutex            mutex;
+        std::condition_variable       wake;
+
+        // Changes waiting for the debounce interval to elapse
+        std::set<std::filesystem::path>       pending;
+        std::chrono::steady_clock::time_point last_event;
+
+        // Polling backend: last observed state of every file. Guarded by mutex;
+        // directories_version changes whenever add_directory() adds a baseline
+        std::unordered_map<std::string, FileStamp> snapshot;
+        uint64_t                                   directories_version = 0;
+
+        // Inotify backend
+        int                                            inotify_fd = -1;
+        std::unordered_map<int, std::filesystem::path> watch_paths;
+        std::unordered_map<int, bool>                  watch_recursive;
+
+        void scan(const WatchedDirectory& dir, std::unordered_map<std::string, FileStamp>& out) const
+        {
+            std::error_code ec;
+            auto            record = [&](const std::filesystem::directory_entry& entry)
+            {
+                if (entry.is_regular_file(ec))
+                {
+                    out[normalize(entry.path()).string()] = {entry.last_write_time(ec), entry.file_size(ec)};
+                }
+            };
+
+            if (dir.recursive)
+            {
+                for (std::filesystem::recursive_directory_iterator it(dir.path, ec), end; !ec && it != end; it.increment(ec))
+                {
+                    record(*it);
+                }
+            }
+            else
+            {
+                for (std::filesystem::directory_iterator it(dir.path, ec), end; !ec && it != end; it.increment(ec))
+                {
+                    record(*it);
+                }
+            }
+        }
+
+        void poll_once()
+        {
+            std::vector<WatchedDirectory> dirs;
+            uint64_t                      version;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                dirs    = directories;
+                version = directories_version;
+            }
+
+            // Scan without the lock; the filesystem walk is the slow part
+            std::unordered_map<std::string, FileStamp> current;
+            for (const auto& dir : dirs)
+            {
+                scan(dir, current);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // A directory was added mid-scan: replacing the snapshot would drop its
+            // baseline and report every file in it, so compare on the next poll instead
+            if (version != directories_version)
+            {
+                return;
+            }
+
+            for (const auto& [path, stamp] : current)
+            {
+                auto it = snapshot.find(path);
+                if (it == snapshot.end() || it->second != stamp)
+                {
+                    pending.insert(path);
+                }
+            }
+            for (const auto& [path, stamp] : snapshot)
+            {
+                if (current.find(path) == current.end())
+                {
+                    pending.insert(path); // Deleted
+                }
+            }
+            snapshot = std::move(current);
+        }
+
+        void dispatch()
+        {
+            if (pending.empty())
+            {
+                return;
+            }
+
+            std::vector<std::filesystem::path> changed(pending.begin(), pending.end());
+            pending.clear();
+
+            try
+            {
+                callback(changed);
+            }
+            catch (const std::exception& e)
+            {
+                logger::error(std::string("FileWatcher callback failed: ") + e.what());
+            }
+        }
+
+        void run_polling()
+        {
+            while (running)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait_for(lock, config.poll_interval, [this] { return !running.load(); });
+                }
+                if (!running)
+                {
+                    break;
+                }
+
+                poll_once();
+                dispatch();
+            }
+        }
+
+        #ifdef __linux__
+        void add_inotify_watch(const std::filesystem::path& path, bool recursive)
+        {
+            constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE;
+
+            int wd = inotify_add_watch(inotify_fd, path.string().c_str(), mask);
+            if (wd < 0)
+            {
+                logger::warn("FileWatcher: cannot watch " + path.string());
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                watch_paths[wd]     = normalize(path);
+                watch_recursive[wd] = recursive;
+            }
+
+            if (recursive)
+            {
+                std::error_code ec;
+                for (std::filesystem::directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec))
+                {
+                    if (it->is_directory(ec))
+                    {
+                        add_inotify_watch(it->path(), true);
+                    }
+                }
+            }
+        }
+
+        void run_inotify()
+        {
+            alignas(inotify_event) char buffer[16 * 1024];
+
+            while (running)
+            {
+                // Wake periodically to notice stop() and to flush debounced batches
+                pollfd pfd{inotify_fd, POLLIN, 0};
+                int    timeout = pending.empty() ? 100 : static_cast<int>(config.debounce.count());
+                int    ready   = ::poll(&pfd, 1, timeout);
+
+                if (ready > 0 && (pfd.revents & POLLIN))
+                {
+                    ssize_t length = ::read(inotify_fd, buffer, sizeof(buffer));
+                    for (ssize_t offset = 0; offset < length;)
+                    {
+                        const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                        if (event->mask & IN_Q_OVERFLOW)
+                        {
+                            logger::warn("FileWatcher: inotify queue overflow, some changes may be missed");
+                            continue;
+                        }
+
+                        std::filesystem::path dir;
+                        bool                  recursive = false;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            auto                        it = watch_paths.find(event->wd);
+                            if (it == watch_paths.end())
+                            {
+                                continue;
+                            }
+                            if (event->mask & IN_IGNORED)
+                            {
+                                watch_paths.erase(it);
+                                watch_recursive.erase(event->wd);
+                                continue;
+                            }
+                            dir       = it->second;
+                            recursive = watch_recursive[event->wd];
+                        }
+
+                        if (event->len == 0)
+                        {
+                            continue;
+                        }
+
+                        std::filesystem::path path = dir / event->name;
+                        if (event->mask & IN_ISDIR)
+                        {
+                            if (recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                            {
+                                add_inotify_watch(path, true);
+                            }
+                            continue;
+                        }
+
+                        if (event->mask & IN_CREATE)
+                        {
+                            continue; // Reported on IN_CLOSE_WRITE once the writer is done
+                        }
+
+                        pending.insert(path);
+                        last_event = std::chrono::steady_clock::now();
+                    }
+                }
+
+                if (!pending.empty() && std::chrono::steady_clock::now() - last_event >= config.debounce)
+                {
+                    dispatch();
+                }
+            }
+        }
+        #endif
+    };
+
+    FileWatcher::FileWatcher(Callback callback)
+        : FileWatcher(std::move(callback), Config{})
+    {
+    }
+
+    FileWatcher::FileWatcher(Callback callback, const Config& config)
+        : impl_(std::make_unique<Impl>())
+    {
+        impl_->callback = std::move(callback);
+        impl_->config   = config;
+
+        #ifdef __linux__
+        if (!config.force_polling)
+        {
+            impl_->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (impl_->inotify_fd >= 0)
+            {
+                impl_->backend = Backend::Inotify;
+            }
+            else
+            {
+                logger::warn("FileWatcher: inotify unavailable, falling back to polling");
+            }
+        }
+        #endif
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        stop();
+
+        #ifdef __linux__
+        if (impl_->inotify_fd >= 0)
+        {
+            ::close(impl_->inotify_fd);
+        }
+        #endif
+    }
+
+    void FileWatcher::add_directory(const std::filesystem::path& directory, bool recursive)
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec))
+        {
+            logger::warn("FileWatcher: not a directory: " + directory.string());
+            return;
+        }
+
+        Impl::WatchedDirectory dir{normalize(directory), recursive};
+
+        #ifdef __linux__
+        if (impl_->backend == Backend::Inotify)
+        {
+            impl_->add_inotify_watch(dir.path, recursive);
+        }
+        #endif
+
+        if (impl_->backend == Backend::Polling)
+        {
+            // Baseline now so changes made before the first scan are still detected
+            std::unordered_map<std::string, Impl::FileStamp> baseline;
+            impl_->scan(dir, baseline);
+
+            std::lock_guard<std::mutex> lock(impl_->mutex);
+            impl_->snapshot.insert(baseline.begin(), baseline.end());
+            impl_->directories.push_back(std::move(dir));
+            ++impl_->directories_version;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->directories.push_back(std::move(dir));
+    }
+
+    void FileWatcher::start()
+    {
+        if (impl_->running.exchange(true))
+        {
+            return;
+        }
+
+        impl_->thread = std::thread([impl = impl_.get()]()
+        {
+            #ifdef __linux__
+            if (impl->backend == Backend::Inotify)
+            {
+                impl->run_inotify();
+                return;
+            }
+            #endif
+            impl->run_polling();
+        });
+    }
+
+    void FileWatcher::stop()
+    {
+        if (!impl_->running.exchange(false))
+        {
+            return;
+        }
+
+        impl_->wake.notify_all();
+        if (impl_->thread.joinable())
+        {
+            impl_->thread.join();
+        }
+    }
+
+    bool FileWatcher::is_running() const
+    {
+        return impl_->running;
+    }
+
+    FileWatcher::Backend FileWatcher::backend() const
+    {
+        return impl_->backend;
+    }
+
+    std::filesystem::path FileWatcher::normalize(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        auto            absolute = std::filesystem::absolute(path, ec);
+        return (ec ? path : absolute).lexically_normal();
+    }
+} // namespace vulkan_engine::filesystem
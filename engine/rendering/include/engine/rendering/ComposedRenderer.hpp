@@ -42,11 +42,19 @@ namespace vulkan_engine::rendering
         public:
             struct Config
             {
-                uint32_t scene_width          = 1280;
-                uint32_t scene_height         = 720;
-                bool     enable_gpu_timing    = true;
-                bool     enable_vsync         = true;
-                uint32_t max_frames_in_flight = 2;
+                uint32_t scene_width                = 1280;
+                uint32_t scene_height               = 720;
+                bool     enable_gpu_timing          = true;
+                bool     enable_pipeline_statistics = false; // Per-pass counters, needs device support
+                bool     enable_vsync               = true;
+                uint32_t max_frames_in_flight       = 2;
+
+                // Scene and UI share the UI frame's timeline value and go out in one vkQueueSubmit;
+                // false keeps the scene on its own submission, chained by a semaphore
+                bool single_submission = true;
+
+                // Scene render scale, see DynamicResolution
+                DynamicResolution::Config dynamic_resolution;
             };
 
             // 娓叉煋鍥炶皟
@@ -142,6 +150,7 @@ namespace vulkan_engine::rendering
             // ========== GPU 璁℃椂 ==========
 
             float get_scene_gpu_time_ms() const { return scene_renderer_.get_gpu_render_time_ms(); }
+            float scene_render_scale() const { return scene_renderer_.dynamic_resolution().scale(); }
 
             // ========== 鐘舵€佹煡璇?==========
 
@@ -155,6 +164,8 @@ namespace vulkan_engine::rendering
             SceneRenderer scene_renderer_;
             UIRenderer    ui_renderer_;
 
-            uint32_t current_frame_ = 0;
+            uint32_t current_frame_        = 0;
+            uint32_t max_frames_in_flight_ = 2;
+            bool     single_submission_    = true;
     };
 } // namespace vulkan_engine::rendering
\ No newline at end of file
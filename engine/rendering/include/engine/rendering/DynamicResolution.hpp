@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+namespace vulkan_engine::rendering
+{
+    // ============================================================================
+    // DynamicResolution - Scene render scale driven by GPU frame time
+    // ============================================================================
+    // The scene render target stays allocated at the output size. Each frame only
+    // its top-left scaled_extent() is rendered (viewport and scissor shrink with
+    // it) and the UI composite samples that region back up to the viewport, so a
+    // scale change never reallocates anything.
+    //
+    // update() takes the GPU time of every resolved scene frame and moves the
+    // scale with a PID controller on the normalised headroom
+    // (target - gpu) / target:
+    //
+    //  - GPU time follows the pixel count, i.e. scale squared, so the controller
+    //    output scales the pixel fraction and is converted back to a side scale.
+    //  - Inside dead_band the scale holds and the integral bleeds off, so a scene
+    //    sitting on the target does not flicker between two sizes.
+    //  - Changes smaller than min_step are held back, and after a change the next
+    //    settle_frames samples are skipped: timings resolve frames_in_flight
+    //    frames late and would still describe the previous size.
+    class DynamicResolution
+    {
+        public:
+            struct Config
+            {
+                bool     enabled       = false;
+                float    target_gpu_ms = 16.0f;
+                float    min_scale     = 0.5f;
+                float    max_scale     = 1.0f;  // Upper bound; also the fixed scale while disabled
+                float    dead_band     = 0.05f; // Headroom fraction treated as on target
+                float    min_step      = 0.02f; // Smallest scale change that is applied
+                float    kp            = 0.6f;
+                float    ki            = 0.15f;
+                float    kd            = 0.1f;
+                uint32_t settle_frames = 3; // Samples skipped after a change
+            };
+
+            DynamicResolution();
+            explicit DynamicResolution(const Config& config);
+
+            // Restarts the controller at max_scale
+            void          set_config(const Config& config);
+            const Config& config() const { return config_; }
+
+            // GPU milliseconds of one resolved scene frame; returns the new scale
+            float update(float gpu_ms);
+
+            // Back to max_scale with a cleared history
+            void reset();
+
+            float scale() const { return scale_; }
+
+            // Rendered region of a target of the given size, at least 1x1
+            VkExtent2D scaled_extent(VkExtent2D full) const;
+
+        private:
+            Config config_;
+
+            float    scale_      = 1.0f;
+            float    integral_   = 0.0f;
+            float    prev_error_ = 0.0f;
+            uint32_t settle_     = 0;
+    };
+} // namespace vulkan_engine::rendering
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "engine/rendering/SceneRenderer.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace vulkan_engine::vulkan
+{
+    class DeviceManager;
+}
+
+namespace vulkan_engine::rendering
+{
+    /**
+     * @brief Offscreen renderer - the scene pipeline without a window or swap chain
+     *
+     * Drives a SceneRenderer in external_submit mode on a device created with
+     * DeviceManager::CreateInfo::headless, so it runs on display-less machines
+     * and software implementations (lavapipe):
+     *
+     * 1. begin_frame() - wait for the frame slot's graphics timeline value
+     * 2. render_scene() - render the scene into the RenderTarget
+     * 3. end_frame() - submit; the timeline value stands in for present
+     *
+     * capture() reads the next rendered frame back and writes it as a PNG once
+     * the copy has retired, max_frames_in_flight frames later. Keep rendering
+     * until pending_captures() is 0, or call flush() before shutting down.
+     */
+    class HeadlessRenderer
+    {
+        public:
+            struct Config
+            {
+                uint32_t width                      = 1280;
+                uint32_t height                     = 720;
+                bool     enable_gpu_timing          = true;
+                bool     enable_pipeline_statistics = false; // Per-pass counters, needs device support
+                uint32_t max_frames_in_flight       = 2;
+
+                // Scene render scale, see DynamicResolution
+                DynamicResolution::Config dynamic_resolution;
+            };
+
+            using SceneRenderCallback = SceneRenderer::SceneRenderCallback;
+
+        public:
+            HeadlessRenderer();
+            ~HeadlessRenderer();
+
+            // Non-copyable, non-movable (capture callbacks point back here)
+            HeadlessRenderer(const HeadlessRenderer&)            = delete;
+            HeadlessRenderer& operator=(const HeadlessRenderer&) = delete;
+
+            // ========== Lifecycle ==========
+
+            bool initialize(std::shared_ptr<vulkan::DeviceManager> device, const Config& config = {});
+            void shutdown();
+
+            // ========== Render loop ==========
+
+            bool begin_frame();
+            void render_scene(SceneRenderCallback callback);
+            void end_frame();
+
+            // Cycle the frame slots without rendering until every recorded capture
+            // is written; false if some capture was never recorded or a wait failed
+            bool flush();
+
+            // ========== Capture ==========
+
+            /**
+             * @brief Write the next rendered frame to path as a PNG
+             * @return False when the scene has no readback queue
+             */
+            bool capture(std::filesystem::path path);
+
+            uint32_t pending_captures() const { return static_cast<uint32_t>(captures_.size()); }
+            uint32_t failed_captures() const { return failed_captures_; }
+
+            // ========== Render graph ==========
+
+            RenderGraphBuilder& scene_render_graph_builder() { return scene_renderer_.render_graph_builder(); }
+            RenderGraph&        scene_render_graph() { return scene_renderer_.render_graph(); }
+            void                compile_scene_render_graph() { scene_renderer_.compile_render_graph(); }
+
+            // ========== Accessors ==========
+
+            SceneRenderer&                scene_renderer() { return scene_renderer_; }
+            std::shared_ptr<RenderTarget> scene_render_target() const { return scene_renderer_.render_target(); }
+            std::shared_ptr<Viewport>     scene_viewport() const { return scene_renderer_.viewport(); }
+
+            void resize(uint32_t width, uint32_t height) { scene_renderer_.resize(width, height); }
+
+            float get_scene_gpu_time_ms() const { return scene_renderer_.get_gpu_render_time_ms(); }
+            float scene_render_scale() const { return scene_renderer_.dynamic_resolution().scale(); }
+
+            bool     is_initialized() const { return initialized_; }
+            uint32_t current_frame() const { return current_frame_; }
+            uint64_t frames_rendered() const { return frames_rendered_; }
+
+        private:
+            bool write_capture(const vulkan::memory::ReadbackTicket& ticket, const std::filesystem::path& path);
+            void retire_captures();
+
+        private:
+            bool initialized_ = false;
+
+            std::shared_ptr<vulkan::DeviceManager> device_;
+            SceneRenderer                          scene_renderer_;
+
+            std::vector<uint64_t> frame_values_; // Graphics timeline value of each slot's last submit
+            uint32_t              current_frame_        = 0;
+            uint32_t              max_frames_in_flight_ = 2;
+            bool                  frame_started_        = false;
+            uint64_t              frames_rendered_      = 0;
+
+            // Tickets of captures not yet written; a failed readback never calls back
+            std::vector<vulkan::memory::ReadbackTicketPtr> captures_;
+            uint32_t                                       failed_captures_ = 0;
+    };
+} // namespace vulkan_engine::rendering
@@ -247,8 +247,7 @@ namespace vulkan_engine::rendering
             // 娓叉煋瀛愭楠?
             void record_scene_commands(SceneRenderCallback callback);
             void record_ui_commands_dynamic(editor::Editor& editor);
-            void submit_scene_commands();
-            void submit_ui_commands_dynamic();
+            void submit_frame();
 
             // GPU 璁℃椂
             void update_gpu_timing();
@@ -303,13 +302,15 @@ namespace vulkan_engine::rendering
             std::vector<float>        gpu_frame_times_; // 鍘嗗彶璁板綍
             uint32_t                  gpu_time_write_index_ = 0;
             float                     gpu_render_time_ms_   = 0.0f;
+            float                     gpu_time_sum_us_      = 0.0f; // Running sum of gpu_frame_times_
             static constexpr uint32_t GPU_TIME_HISTORY_SIZE = 60;
             std::vector<bool>         query_pools_initialized_;
 
             // 甯х姸鎬?
-            uint32_t current_frame_ = 0;
-            uint32_t current_image_ = 0;
-            bool     frame_started_ = false;
+            uint32_t current_frame_  = 0;
+            uint32_t current_image_  = 0;
+            bool     frame_started_  = false;
+            bool     scene_recorded_ = false; // Scene commands go out with the UI in submit_frame()
 
             // 灏哄璋冩暣
             bool     resize_pending_ = false;
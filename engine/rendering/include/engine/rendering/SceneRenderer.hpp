@@ -1,9 +1,14 @@
 #pragma once
 
+#include "engine/rendering/DynamicResolution.hpp"
 #include "engine/rendering/render_graph/RenderGraph.hpp"
+#include "engine/rendering/resources/GeometryBuffer.hpp"
 #include "engine/rendering/resources/RenderTarget.hpp"
 #include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/rhi/vulkan/command/GpuProfiler.hpp"
 #include "engine/rhi/vulkan/sync/Synchronization.hpp"
+#include "engine/rhi/vulkan/memory/ReadbackQueue.hpp"
+#include "engine/core/memory/LinearArena.hpp"
 
 #include <memory>
 #include <functional>
@@ -43,10 +48,25 @@ namespace vulkan_engine::rendering
         public:
             struct Config
             {
-                uint32_t width                = 1280;
-                uint32_t height               = 720;
-                bool     enable_gpu_timing    = true;
-                uint32_t max_frames_in_flight = 2;
+                uint32_t width                      = 1280;
+                uint32_t height                     = 720;
+                bool     enable_gpu_timing          = true;
+                bool     enable_pipeline_statistics = false; // Per-pass counters, needs device support
+                uint32_t max_frames_in_flight       = 2;
+
+                // The owner waits for the frame slot and submits frame_command_buffer()
+                // together with its own work; no semaphore is created here
+                bool external_submit = false;
+
+                // Per-frame CPU scratch memory
+                size_t frame_arena_size = 256 * 1024; // Bytes, grows on demand
+
+                // Shared vertex/index buffers scene meshes sub-allocate from (in elements)
+                uint32_t geometry_vertex_capacity = 256 * 1024;
+                uint32_t geometry_index_capacity  = 768 * 1024;
+
+                // Render scale of the scene; adapts to the GPU time when enabled
+                DynamicResolution::Config dynamic_resolution;
             };
 
             // 娓叉煋甯т笂涓嬫枃
@@ -57,6 +77,12 @@ namespace vulkan_engine::rendering
                 uint32_t height;       // 娓叉煋鐩爣楂樺害
                 float    delta_time;   // 甯ф椂闂?
                 float    elapsed_time; // 绱鏃堕棿
+
+                // Rewound when this frame slot's timeline value is reached
+                core::LinearArena* frame_arena = nullptr;
+
+                // Null when GPU timing is disabled or unsupported
+                vulkan::GpuProfiler* gpu_profiler = nullptr;
             };
 
             // 娓叉煋鍥炶皟
@@ -99,6 +125,12 @@ namespace vulkan_engine::rendering
              */
             bool begin_frame();
 
+            /**
+             * @brief Start a frame of an external_submit renderer
+             * @param frame_index Frame slot the owner has already waited on
+             */
+            bool begin_frame(uint32_t frame_index);
+
             /**
              * @brief 娓叉煋鍦烘櫙
              * @param callback 鍦烘櫙娓叉煋鍥炶皟
@@ -174,6 +206,12 @@ namespace vulkan_engine::rendering
              */
             VkSemaphore get_scene_finished_semaphore() const;
 
+            /**
+             * @brief Scene commands recorded this frame, for external_submit owners;
+             *        VK_NULL_HANDLE when nothing was recorded
+             */
+            VkCommandBuffer frame_command_buffer() const;
+
             /**
              * @brief 璋冩暣娓叉煋鐩爣灏哄
              */
@@ -194,12 +232,26 @@ namespace vulkan_engine::rendering
             /**
              * @brief 鑾峰彇涓婁竴甯х殑 GPU 娓叉煋鏃堕棿锛堟绉掞級
              */
-            float get_gpu_render_time_ms() const { return gpu_render_time_ms_; }
+            float get_gpu_render_time_ms() const { return gpu_profiler_ ? gpu_profiler_->root_average_ms() : 0.0f; }
 
             /**
              * @brief 鏄惁鍚敤 GPU 璁℃椂
              */
-            bool is_gpu_timing_enabled() const { return !query_pools_.empty(); }
+            bool is_gpu_timing_enabled() const { return gpu_profiler_ != nullptr; }
+
+            // ========== Dynamic resolution ==========
+
+            /**
+             * @brief Render scale controller; the target keeps its full size and only
+             *        render_target()->render_extent() is rendered
+             */
+            DynamicResolution&       dynamic_resolution() { return dynamic_resolution_; }
+            const DynamicResolution& dynamic_resolution() const { return dynamic_resolution_; }
+
+            /**
+             * @brief Per-pass GPU timings of the last resolved frame; null when timing is off
+             */
+            vulkan::GpuProfiler* gpu_profiler() const { return gpu_profiler_.get(); }
 
             // ========== 鐘舵€佹煡璇?==========
 
@@ -208,20 +260,41 @@ namespace vulkan_engine::rendering
             const Config&                          config() const { return config_; }
             std::shared_ptr<vulkan::DeviceManager> device() const { return device_; }
 
+            core::LinearArena* frame_arena() const { return frame_arena_.get(); }
+
+            // Pass to Mesh::upload; freed slices are recycled as frame slots retire
+            const std::shared_ptr<GeometryBuffer>& geometry_buffer() const { return geometry_buffer_; }
+
+            // ========== Readback ==========
+
+            /**
+             * @brief Copy a region of the scene color target to host memory without stalling
+             * @param region Pixels to read; a zero extent reads the whole target
+             * @param on_ready Called from begin_frame() once the data is available
+             * @return Ticket that becomes ready max_frames_in_flight frames after the copy is
+             *         recorded; null when no ResourceManager is registered with the device
+             */
+            vulkan::memory::ReadbackTicketPtr request_readback(VkRect2D region = {}, vulkan::memory::ReadbackTicket::Callback on_ready = {});
+
+            // Null when the device has no ResourceManager
+            vulkan::memory::ReadbackQueue* readback_queue() const { return readback_queue_.get(); }
+
         private:
             bool initialize_vma_allocator();
             bool initialize_render_pass_manager();
             bool initialize_frame_sync();
             bool initialize_command_pool();
-            bool initialize_query_pools();
+            bool initialize_gpu_profiler();
+            bool initialize_frame_allocators();
             bool initialize_render_target();
             bool initialize_viewport();
 
+            bool begin_frame_slot();
             void record_commands(SceneRenderCallback callback);
+            void record_readbacks(VkCommandBuffer cmd);
+            void update_render_extent();
             void submit_commands();
 
-            void update_gpu_timing();
-            void destroy_query_pools();
             void recreate_render_target();
             void cleanup_resources();
 
@@ -242,7 +315,7 @@ namespace vulkan_engine::rendering
             // 鍦烘櫙涓撶敤鍚屾瀵硅薄
             struct FrameSync
             {
-                std::unique_ptr<vulkan::Fence>     in_flight_fence;
+                uint64_t                           submitted_value = 0; // Graphics timeline value of the last submit
                 std::unique_ptr<vulkan::Semaphore> scene_finished_semaphore;
             };
 
@@ -252,17 +325,34 @@ namespace vulkan_engine::rendering
             std::unique_ptr<vulkan::RenderCommandPool> command_pool_;
             std::vector<vulkan::RenderCommandBuffer>   command_buffers_;
 
-            // GPU 璁℃椂
-            std::vector<VkQueryPool>  query_pools_;
-            std::vector<float>        gpu_frame_times_;
-            uint32_t                  gpu_time_write_index_ = 0;
-            float                     gpu_render_time_ms_   = 0.0f;
-            static constexpr uint32_t GPU_TIME_HISTORY_SIZE = 60;
-            std::vector<bool>         query_pools_initialized_;
+            // GPU timing: one query pool per frame slot, a scope per render graph pass
+            std::unique_ptr<vulkan::GpuProfiler> gpu_profiler_;
+
+            // Fed the scene's GPU time each time the profiler resolves a frame
+            DynamicResolution dynamic_resolution_;
+            uint64_t          last_resolved_frame_ = 0;
+
+            // Per-frame scratch memory
+            std::unique_ptr<core::LinearArena> frame_arena_;
+
+            // Vertex/index megabuffers for MeshVertex meshes
+            std::shared_ptr<GeometryBuffer> geometry_buffer_;
+
+            // GPU -> CPU copies; requests wait here until the next recorded frame
+            struct PendingReadback
+            {
+                VkRect2D                          region{};
+                vulkan::memory::ReadbackTicketPtr ticket;
+            };
+
+            std::unique_ptr<vulkan::memory::ReadbackQueue> readback_queue_;
+            std::vector<PendingReadback>                   pending_readbacks_;
 
             // 甯х姸鎬?
-            uint32_t current_frame_ = 0;
-            bool     frame_started_ = false;
+            uint32_t current_frame_  = 0;
+            uint64_t frame_number_   = 0; // Recorded frames, drives ResourceManager::beginFrame
+            bool     frame_started_  = false;
+            bool     frame_recorded_ = false;
 
             // 灏哄璋冩暣
             bool     resize_pending_ = false;
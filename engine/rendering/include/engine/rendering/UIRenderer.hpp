@@ -81,11 +81,14 @@ namespace vulkan_engine::rendering
          * @param editor Editor 瀹炰緥
          * @param scene_render_target 鍦烘櫙娓叉煋鐩爣锛堝彲閫夛紝鐢ㄤ簬鏄剧ず锛?
          * @param scene_finished_semaphore 鍦烘櫙娓叉煋瀹屾垚淇″彿閲忥紙鍙€夛紝鐢ㄤ簬绛夊緟鍦烘櫙锛?
+         * @param scene_commands Recorded scene commands submitted ahead of the UI in the same
+         *        vkQueueSubmit, tracked by the UI frame's timeline value (single-submission frames)
          */
             void render(
                 editor::Editor&               editor,
                 std::shared_ptr<RenderTarget> scene_render_target      = nullptr,
-                VkSemaphore                   scene_finished_semaphore = VK_NULL_HANDLE);
+                VkSemaphore                   scene_finished_semaphore = VK_NULL_HANDLE,
+                VkCommandBuffer               scene_commands           = VK_NULL_HANDLE);
 
             /**
          * @brief 鍛堢幇鍒板睆骞?
@@ -101,6 +104,7 @@ namespace vulkan_engine::rendering
             // ========== 鐘舵€佹煡璇?==========
 
             bool     is_initialized() const { return initialized_; }
+            uint32_t current_frame() const { return current_frame_; }
             uint32_t current_image() const { return current_image_; }
             uint32_t image_count() const;
 
@@ -114,7 +118,10 @@ namespace vulkan_engine::rendering
             bool initialize_framebuffer_pool();
 
             void record_commands(editor::Editor& editor, std::shared_ptr<RenderTarget> scene_render_target);
-            void submit_commands(VkSemaphore image_available_semaphore, VkSemaphore scene_finished_semaphore = VK_NULL_HANDLE);
+            void submit_commands(
+                VkSemaphore     image_available_semaphore,
+                VkSemaphore     scene_finished_semaphore = VK_NULL_HANDLE,
+                VkCommandBuffer scene_commands           = VK_NULL_HANDLE);
 
             void recreate_swap_chain_resources();
             void cleanup_resources();
@@ -131,7 +138,7 @@ namespace vulkan_engine::rendering
             // 浣跨敤 per-frame fence 鍜?acquire semaphore锛宲er-image render_finished semaphore
             struct FrameSync
             {
-                std::unique_ptr<vulkan::Fence>     in_flight_fence;
+                uint64_t                           submitted_value = 0; // Graphics timeline value of the last submit
                 std::unique_ptr<vulkan::Semaphore> image_available_semaphore;
             };
 
@@ -1,16 +1,20 @@
 #pragma once
 
 #include "engine/rhi/vulkan/pipelines/Pipeline.hpp"
+#include "engine/rhi/vulkan/pipelines/LayoutCache.hpp"
+#include "engine/rhi/vulkan/pipelines/ShaderReflection.hpp"
 #include "engine/rhi/vulkan/resources/Buffer.hpp"
 #include "engine/rhi/vulkan/resources/Image.hpp"
-#include "engine/rhi/vulkan/resources/UniformBuffer.hpp"
 #include "engine/rhi/vulkan/device/Device.hpp"
 #include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/rhi/vulkan/memory/BudgetGovernor.hpp"
+#include "engine/rendering/material/MaterialParameterBuffer.hpp"
 
 #include <string>
 #include <unordered_map>
 #include <memory>
 #include <variant>
+#include <vector>
 #include <mutex>
 
 #include <glm/glm.hpp>
@@ -42,8 +46,14 @@ namespace vulkan_engine::rendering
     {
         std::string                                    name;
         std::string                                    shader_name; // References a shader program
+        std::string                                    vertex_shader_path;   // As written in the file
+        std::string                                    fragment_shader_path; // As written in the file
+        bool                                           depth_test  = true;
+        bool                                           depth_write = true;
+        VkCullModeFlags                                cull_mode   = VK_CULL_MODE_BACK_BIT;
         std::unordered_map<std::string, MaterialParam> parameters;
         std::vector<std::string>                       texture_bindings; // Texture slot names
+        std::unordered_map<std::string, std::string>   texture_paths;    // Slot name -> texture file
     };
 
     // ============================================================================
@@ -67,6 +77,16 @@ namespace vulkan_engine::rendering
                 // Dynamic Rendering formats (used when render_pass is VK_NULL_HANDLE)
                 VkFormat color_format = VK_FORMAT_UNDEFINED;
                 VkFormat depth_format = VK_FORMAT_UNDEFINED;
+
+                // Shared parameter ring; a private single-material buffer is created when null
+                std::shared_ptr<MaterialParameterBuffer> parameter_buffer;
+                uint32_t                                 max_frames_in_flight = 2; // Slots of the private buffer
+
+                // Shared layout cache; a private cache is created when null
+                std::shared_ptr<vulkan::LayoutCache> layout_cache;
+
+                // Shared Vulkan pipeline cache (optional)
+                std::shared_ptr<vulkan::PipelineCache> pipeline_cache;
             };
 
             Material(std::shared_ptr<vulkan::DeviceManager> device, const Config& config);
@@ -83,8 +103,9 @@ namespace vulkan_engine::rendering
             // Build the pipeline for dynamic rendering
             void build(VkFormat color_format, VkFormat depth_format);
 
-            // Bind material for rendering
-            void bind(vulkan::RenderCommandBuffer& cmd);
+            // Bind material for rendering (frame_index selects the parameter ring slot).
+            // screen_coverage (0..1) feeds the residency priority of the bound textures.
+            void bind(vulkan::RenderCommandBuffer& cmd, uint32_t frame_index = 0, float screen_coverage = 0.0f);
 
             // Set parameter values
             void set_float(const std::string& name, float value);
@@ -95,14 +116,40 @@ namespace vulkan_engine::rendering
             void set_bool(const std::string& name, bool value);
             void set_texture(const std::string& name, std::shared_ptr<vulkan::Image> texture, VkImageView view);
 
+            // Revert a slot to the default white texture (used while a texture is evicted)
+            void clear_texture(const std::string& name);
+
+            // Budget governor entries of the textures this material samples; touched on bind
+            void set_residency(std::weak_ptr<vulkan::memory::BudgetGovernor>       governor,
+                               std::vector<vulkan::memory::BudgetGovernor::Handle> handles);
+
+            // Replace the parameter block layout (e.g. with offsets reflected from the shader).
+            // Values of members present in both layouts are preserved.
+            void                           set_parameter_layout(const MaterialParameterLayout& layout);
+            const MaterialParameterLayout& parameter_layout() const { return parameter_layout_; }
+
             // Getters
             const std::string& name() const { return config_.name; }
             bool               is_built() const { return pipeline_ != nullptr; }
             VkPipelineLayout   pipeline_layout() const { return pipeline_layout_; }
+            VkShaderStageFlags push_constant_stages() const;
+
+            // Shader interface the layouts were built from
+            const vulkan::ShaderReflection& reflection() const { return reflection_; }
 
             // Access to pipeline
             vulkan::GraphicsPipeline* pipeline() const { return pipeline_.get(); }
 
+            // Hot reload. create_pipeline() builds a new pipeline from the current shader
+            // files against the existing layouts without touching the bound one, so it may
+            // run on a worker thread; swap_pipeline() installs it between frames and returns
+            // the old pipeline, which must outlive the frames still using it.
+            const std::string&                        vertex_shader_path() const { return config_.vertex_shader_path; }
+            const std::string&                        fragment_shader_path() const { return config_.fragment_shader_path; }
+            bool                                      is_layout_compatible(const vulkan::ShaderReflection& reflection) const;
+            std::unique_ptr<vulkan::GraphicsPipeline> create_pipeline() const;
+            std::unique_ptr<vulkan::GraphicsPipeline> swap_pipeline(std::unique_ptr<vulkan::GraphicsPipeline> pipeline);
+
         private:
             std::shared_ptr<vulkan::DeviceManager> device_;
             Config                                 config_;
@@ -111,23 +158,20 @@ namespace vulkan_engine::rendering
             std::unique_ptr<vulkan::GraphicsPipeline> pipeline_;
             VkPipelineLayout                          pipeline_layout_       = VK_NULL_HANDLE;
             VkDescriptorSetLayout                     descriptor_set_layout_ = VK_NULL_HANDLE;
+            VkFormat                                  color_format_          = VK_FORMAT_UNDEFINED;
+            VkFormat                                  depth_format_          = VK_FORMAT_UNDEFINED;
 
-            // Uniform buffer for material parameters (std140 layout)
-            struct UniformBufferData
-            {
-                glm::vec4 color{1.0f, 1.0f, 1.0f, 1.0f}; // offset 0,   size 16
-                float     roughness   = 0.5f;            // offset 16,  size 4
-                float     metallic    = 0.0f;            // offset 20,  size 4
-                float     emissive    = 0.0f;            // offset 24,  size 4
-                float     has_texture = 0.0f;            // offset 28,  size 4
-                // New fields for vec2/int/bool support
-                glm::vec2 uv_scale{1.0f, 1.0f};  // offset 32,  size 8
-                int       texture_id     = 0;    // offset 40,  size 4
-                int       use_normal_map = 0;    // offset 44,  size 4 (bool as int)
-                float     padding        = 0.0f; // offset 48,  size 4 (padding to 64 bytes)
-            };
+            // Layouts are owned by the cache and derived from the reflected shader interface
+            std::shared_ptr<vulkan::LayoutCache> layout_cache_;
+            vulkan::ShaderReflection             reflection_;
+            uint32_t                             parameter_binding_ = UINT32_MAX; // Set 0 binding of the parameter block
 
-            std::unique_ptr<vulkan::UniformBuffer<UniformBufferData>> uniform_buffer_;
+            // Material parameters live in a block of the (possibly shared) parameter ring.
+            // Setters only touch the CPU shadow copy; the owner of the ring flushes once per frame.
+            std::shared_ptr<MaterialParameterBuffer> parameter_buffer_;
+            uint32_t                                 parameter_block_       = MaterialParameterBuffer::INVALID_BLOCK;
+            bool                                     owns_parameter_buffer_ = false;
+            MaterialParameterLayout                  parameter_layout_;
 
             // Descriptor set
             VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
@@ -139,10 +183,15 @@ namespace vulkan_engine::rendering
                 std::shared_ptr<vulkan::Image> image;
                 VkImageView                    view = VK_NULL_HANDLE;
                 uint32_t                       binding;
+                uint32_t                       generation = 0; // image->generation() when view was written
             };
 
             std::unordered_map<std::string, TextureBinding> textures_;
 
+            // Residency of the textures above
+            std::weak_ptr<vulkan::memory::BudgetGovernor>       residency_governor_;
+            std::vector<vulkan::memory::BudgetGovernor::Handle> residency_handles_;
+
             // Default sampler for texture binding
             VkSampler default_sampler_ = VK_NULL_HANDLE;
 
@@ -150,18 +199,19 @@ namespace vulkan_engine::rendering
             std::shared_ptr<vulkan::Image> default_white_texture_;
             VkImageView                    default_white_texture_view_ = VK_NULL_HANDLE;
 
-            // Mutex for thread-safe uniform buffer updates
-            mutable std::mutex uniform_mutex_;
-
             // Helper methods
-            void create_descriptor_set_layout();
-            void create_pipeline_layout();
-            void create_descriptor_set();
-            void create_default_sampler();
-            void create_default_white_texture();
-            void update_descriptor_set();
-            void update_uniform_buffer();
-            void build_internal(VkFormat color_format, VkFormat depth_format);
+            void     reflect_shaders();
+            void     create_layouts();
+            void     create_descriptor_set();
+            uint32_t resolve_texture_binding(const std::string& name) const;
+            void     create_default_sampler();
+            void     create_default_white_texture();
+            void     update_descriptor_set();
+            void     renew_descriptor_set();
+            void     retire_texture(std::shared_ptr<vulkan::Image> image);
+            void     write_parameter(const std::string& name, const void* data, uint32_t size);
+            void     write_default_parameters();
+            void     build_internal(VkFormat color_format, VkFormat depth_format);
 
             void cleanup();
     };
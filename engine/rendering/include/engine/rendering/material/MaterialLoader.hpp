@@ -5,18 +5,35 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace vulkan_engine::rendering
 {
     // ============================================================================
     // MaterialLoader - Loads material definitions from JSON files
     // ============================================================================
+    // Parsed definitions are kept in a binary cache file keyed by path, size and
+    // modification time, so warm loads of unchanged files skip JSON entirely.
+    // Batch loads parse definitions and decode textures on worker threads, load
+    // each distinct texture once, and compile the pipelines in parallel.
     class MaterialLoader
     {
         public:
-            explicit MaterialLoader(std::shared_ptr<vulkan::DeviceManager> device);
-            ~MaterialLoader() = default;
+            struct BatchStats
+            {
+                uint32_t requested          = 0;
+                uint32_t loaded             = 0;
+                uint32_t reused             = 0; // Already in the material cache
+                uint32_t definitions_cached = 0; // Served from the definition cache
+                uint32_t textures_loaded    = 0;
+                uint32_t textures_shared    = 0; // References satisfied by an already loaded texture
+                double   milliseconds       = 0.0;
+            };
+
+            explicit MaterialLoader(std::shared_ptr<vulkan::DeviceManager> device, uint32_t frames_in_flight = 2);
+            ~MaterialLoader();
 
             // Load a material from JSON file (traditional render pass)
             std::shared_ptr<Material> load(const std::string& path, VkRenderPass render_pass);
@@ -24,6 +41,19 @@ namespace vulkan_engine::rendering
             // Load a material from JSON file (dynamic rendering with formats)
             std::shared_ptr<Material> load(const std::string& path, VkFormat color_format, VkFormat depth_format);
 
+            // Load many materials at once. Results are in input order, null where loading failed.
+            std::vector<std::shared_ptr<Material>> load_batch(const std::vector<std::string>& paths,
+                                                              VkFormat                        color_format,
+                                                              VkFormat                        depth_format);
+
+            // Load every *.json file in a directory (relative to the base directory), sorted by file name
+            std::vector<std::shared_ptr<Material>> load_directory(const std::string& directory,
+                                                                  VkFormat           color_format,
+                                                                  VkFormat           depth_format);
+
+            // Read a material definition, from the definition cache when the file is unchanged. Thread-safe.
+            bool load_definition(const std::string& path, MaterialDefinition& definition);
+
             // Get cached material
             std::shared_ptr<Material> get(const std::string& name) const;
 
@@ -39,16 +69,106 @@ namespace vulkan_engine::rendering
             // Set textures base directory
             void set_texture_directory(const std::string& path) { texture_loader_.set_base_directory(path); }
 
+            // Register textures loaded from now on with the budget governor. Under memory
+            // pressure cold textures are re-uploaded without their top mips or evicted, in
+            // which case their materials sample the default white texture until the next
+            // bind brings them back.
+            void set_budget_governor(std::shared_ptr<vulkan::memory::BudgetGovernor> governor) { budget_governor_ = governor; }
+
+            // Definition cache file (default: {base_directory}.cache/materials.bin)
+            void set_definition_cache_file(const std::string& path);
+            bool save_definition_cache();
+
+            const BatchStats& last_batch_stats() const { return last_batch_stats_; }
+
+            // Parameter ring shared by all loaded materials; flush once per frame before drawing
+            const std::shared_ptr<MaterialParameterBuffer>& parameter_buffer() const { return parameter_buffer_; }
+
+            // Descriptor set / pipeline layouts shared by materials with the same shader interface
+            const std::shared_ptr<vulkan::LayoutCache>& layout_cache() const { return layout_cache_; }
+
+            // Vulkan pipeline cache shared by all material pipelines
+            const std::shared_ptr<vulkan::PipelineCache>& pipeline_cache() const { return pipeline_cache_; }
+
         private:
-            std::shared_ptr<vulkan::DeviceManager>                     device_;
-            std::string                                                base_directory_ = "materials/";
-            std::unordered_map<std::string, std::shared_ptr<Material>> material_cache_;
-            TextureLoader                                              texture_loader_;
+            // Materials are cached per (name, attachment formats)
+            struct MaterialKey
+            {
+                std::string name;
+                VkFormat    color_format = VK_FORMAT_UNDEFINED;
+                VkFormat    depth_format = VK_FORMAT_UNDEFINED;
+
+                bool operator==(const MaterialKey& other) const
+                {
+                    return name == other.name && color_format == other.color_format && depth_format == other.depth_format;
+                }
+            };
+
+            struct MaterialKeyHash
+            {
+                size_t operator()(const MaterialKey& key) const;
+            };
+
+            struct CachedDefinition
+            {
+                int64_t            write_time = 0;
+                uint64_t           file_size  = 0;
+                MaterialDefinition definition;
+            };
+
+            std::shared_ptr<vulkan::DeviceManager>                                      device_;
+            std::string                                                                 base_directory_ = "materials/";
+            std::unordered_map<MaterialKey, std::shared_ptr<Material>, MaterialKeyHash> material_cache_;
+            TextureLoader                                                               texture_loader_;
+            std::unordered_map<std::string, std::weak_ptr<vulkan::Image>>               texture_cache_; // Resolved path -> image
+            std::shared_ptr<MaterialParameterBuffer>                                    parameter_buffer_;
+            std::shared_ptr<vulkan::LayoutCache>                                        layout_cache_;
+            std::shared_ptr<vulkan::PipelineCache>                                      pipeline_cache_;
+            BatchStats                                                                  last_batch_stats_;
+
+            // Textures registered with the budget governor, keyed by resolved path
+            struct ResidentTexture
+            {
+                vulkan::memory::BudgetGovernor::Handle                       handle         = vulkan::memory::BudgetGovernor::INVALID_HANDLE;
+                uint32_t                                                     dropped_levels = 0; // Top mips removed by demotion
+                VkDeviceSize                                                 size           = 0; // Current GPU size
+                std::vector<std::pair<std::weak_ptr<Material>, std::string>> users;              // Materials and slots sampling it
+            };
+
+            std::weak_ptr<vulkan::memory::BudgetGovernor>    budget_governor_;
+            std::unordered_map<std::string, ResidentTexture> resident_textures_;
+
+            // Definition cache (guarded by definitions_mutex_)
+            std::unordered_map<std::string, CachedDefinition> definitions_;
+            std::string                                       definition_cache_file_;
+            bool                                              definitions_loaded_ = false;
+            bool                                              definitions_dirty_  = false;
+            std::mutex                                        definitions_mutex_;
+
+            void read_definition_cache();
+
+            // Loaded texture for a resolved path, reloading it first if the governor evicted it
+            std::shared_ptr<vulkan::Image> cached_texture(const std::string& path);
+
+            // Budget governor callbacks
+            void         register_resident_texture(const std::string& path, const std::shared_ptr<vulkan::Image>& image);
+            VkDeviceSize demote_texture(const std::string& path);
+            void         evict_texture(const std::string& path);
+            bool         reload_texture(const std::string& path);
+            bool         upload_resident_texture(ResidentTexture& texture, const std::string& path, uint32_t dropped_levels);
+            void         release_resident_textures();
+
+            // Create a material from a definition (not yet built)
+            std::shared_ptr<Material> create_material(
+                const MaterialDefinition&                                              definition,
+                VkFormat                                                               color_format,
+                VkFormat                                                               depth_format,
+                const std::unordered_map<std::string, std::shared_ptr<vulkan::Image>>& textures);
 
-            // Parse JSON file
-            Material::Config parse_json(const std::string& path, VkRenderPass render_pass);
+            // Helper to resolve material file paths
+            std::string resolve_material_path(const std::string& path) const;
 
             // Helper to resolve shader paths
             std::string resolve_path(const std::string& path) const;
     };
-} // namespace vulkan_engine::rendering
\ No newline at end of file
+} // namespace vulkan_engine::rendering
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/memory/OffsetAllocator.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::rendering
+{
+    // ============================================================================
+    // MaterialParameterLayout - Byte ranges of named members in a parameter block
+    // ============================================================================
+    struct MaterialParameterLayout
+    {
+        struct Member
+        {
+            uint32_t offset = 0;
+            uint32_t size   = 0;
+        };
+
+        std::unordered_map<std::string, Member> members;
+        uint32_t                                size = 0; // Total block size in bytes
+
+        void          add(const std::string& name, uint32_t offset, uint32_t member_size);
+        const Member* find(const std::string& name) const;
+        bool          empty() const { return members.empty(); }
+
+        // Fallback layout (std140) used when the material's shaders cannot be reflected
+        static MaterialParameterLayout default_pbr();
+    };
+
+    // ============================================================================
+    // MaterialParameterBuffer - Frame-ring uniform buffer shared by materials
+    // ============================================================================
+    // Materials write into a CPU shadow copy; only the ranges touched since a
+    // frame slot was last flushed are copied into that slot, and adjacent dirty
+    // blocks are coalesced so a frame issues a handful of memcpy calls instead of
+    // one mapped write per setter. Blocks are bound as dynamic uniform buffers.
+    // When a page is full another one is chained rather than failing, so a
+    // block's VkBuffer comes from buffer(block), not from the ring as a whole.
+    // Pages are persistently mapped buffers from the resource manager's Uniform pool.
+    class MaterialParameterBuffer
+    {
+        public:
+            struct Config
+            {
+                uint32_t     frame_count   = 2;         // Must match frames in flight
+                VkDeviceSize slot_capacity = 64 * 1024; // Bytes per frame slot of each page
+                VkDeviceSize coalesce_gap  = 256;       // Merge dirty ranges closer than this
+            };
+
+            struct Stats
+            {
+                uint32_t     page_count      = 0;
+                uint32_t     block_count     = 0;
+                VkDeviceSize used_bytes      = 0;
+                uint32_t     last_copy_count = 0; // memcpy calls issued by the last flush
+                VkDeviceSize last_copy_bytes = 0;
+            };
+
+            static constexpr uint32_t INVALID_BLOCK = UINT32_MAX;
+
+            MaterialParameterBuffer(std::shared_ptr<vulkan::DeviceManager> device, const Config& config);
+            ~MaterialParameterBuffer();
+
+            // Non-copyable, non-movable (blocks are referenced by id from materials)
+            MaterialParameterBuffer(const MaterialParameterBuffer&)            = delete;
+            MaterialParameterBuffer& operator=(const MaterialParameterBuffer&) = delete;
+
+            // Block management
+            uint32_t allocate(uint32_t size);
+            void     free(uint32_t block);
+
+            // Shadow copy access (thread-safe)
+            void write(uint32_t block, uint32_t offset, const void* data, uint32_t size);
+            void read(uint32_t block, uint32_t offset, void* data, uint32_t size) const;
+
+            // Copy dirty ranges for the given frame slot. Call once per frame after
+            // the slot's fence has been waited on and before recording draws.
+            // scratch (e.g. the scene's frame arena) backs the sorted range list.
+            void flush(uint32_t frame_index, std::pmr::memory_resource* scratch = nullptr);
+
+            // Binding information
+            VkBuffer     buffer(uint32_t block) const;
+            VkDeviceSize block_range(uint32_t block) const;
+            uint32_t     dynamic_offset(uint32_t block, uint32_t frame_index) const;
+            uint32_t     frame_count() const { return config_.frame_count; }
+
+            Stats stats() const;
+
+        private:
+            struct DirtyRange
+            {
+                uint32_t begin = UINT32_MAX;
+                uint32_t end   = 0;
+
+                bool empty() const { return begin >= end; }
+            };
+
+            // One buffer holding frame_count slots of slot_size bytes
+            struct Page
+            {
+                vulkan::memory::VmaBufferPtr    buffer;
+                uint8_t*                        mapped    = nullptr;
+                VkDeviceSize                    slot_size = 0;
+                vulkan::memory::OffsetAllocator allocator{0, 1}; // Freed blocks merge with free neighbours
+                std::vector<uint8_t>            shadow;          // Mirrors one slot
+            };
+
+            struct BlockInfo
+            {
+                uint32_t                               page   = 0;
+                VkDeviceSize                           offset = 0;
+                VkDeviceSize                           size   = 0;
+                vulkan::memory::OffsetAllocator::Range range; // In units of alignment_
+                bool                                   in_use = false;
+                std::vector<DirtyRange>                dirty;  // One range per frame slot
+                std::vector<uint8_t>                   queued; // Block already listed in dirty_blocks_[slot]
+            };
+
+            std::shared_ptr<vulkan::DeviceManager>           device_;
+            std::shared_ptr<vulkan::memory::ResourceManager> resource_manager_;
+            Config                                           config_;
+
+            VkDeviceSize alignment_ = 256;
+
+            std::vector<Page>                  pages_;
+            std::vector<BlockInfo>             blocks_;
+            std::vector<uint32_t>              free_block_ids_;
+            std::vector<std::vector<uint32_t>> dirty_blocks_; // Per frame slot
+
+            uint32_t     last_copy_count_ = 0;
+            VkDeviceSize last_copy_bytes_ = 0;
+
+            mutable std::mutex mutex_;
+
+            void mark_dirty(uint32_t block, uint32_t begin, uint32_t end);
+            uint32_t create_page(VkDeviceSize slot_size);
+            void     destroy_page(Page& page);
+    };
+} // namespace vulkan_engine::rendering
@@ -24,6 +24,8 @@ namespace vulkan_engine::rendering
                 vulkan::Buffer* index_buffer  = nullptr;
                 uint32_t        index_count   = 0;
                 VkIndexType     index_type    = VK_INDEX_TYPE_UINT16; // Default to 16-bit for cube
+                uint32_t        first_index   = 0;                    // Slice of a shared GeometryBuffer
+                int32_t         vertex_offset = 0;
 
                 // Material (required for rendering)
                 // Using weak_ptr to avoid dangling pointer if Material is destroyed
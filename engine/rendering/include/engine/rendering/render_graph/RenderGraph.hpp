@@ -2,11 +2,16 @@
 
 #include "engine/rendering/render_graph/RenderGraphTypes.hpp"
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/command/CommandBuffer.hpp"
 
 #include <vulkan/vulkan.h>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <concepts>
 #include <functional>
@@ -16,6 +21,11 @@ namespace vulkan_engine::vulkan
     class RenderCommandBuffer;
 }
 
+namespace vulkan_engine::core
+{
+    class LinearArena;
+}
+
 namespace vulkan_engine::rendering
 {
     // Forward declarations
@@ -49,6 +59,39 @@ namespace vulkan_engine::rendering
             virtual std::vector<ImageHandle>  get_image_outputs() const = 0;
     };
 
+    // Destroys a node owned by a RenderGraphBuilder. Nodes built in place live in
+    // the graph's compile arena; nodes handed over with add_node() are on the heap.
+    struct RenderGraphNodeDeleter
+    {
+        std::pmr::memory_resource* resource  = nullptr; // nullptr = heap
+        size_t                     size      = 0;
+        size_t                     alignment = 0;
+
+        RenderGraphNodeDeleter() = default;
+        RenderGraphNodeDeleter(std::pmr::memory_resource* resource, size_t size, size_t alignment)
+            : resource(resource), size(size), alignment(alignment)
+        {
+        }
+
+        // Accept heap nodes from std::unique_ptr<RenderGraphNode>
+        RenderGraphNodeDeleter(std::default_delete<RenderGraphNode>) noexcept
+        {
+        }
+
+        void operator()(RenderGraphNode* node) const
+        {
+            if (!resource)
+            {
+                delete node;
+                return;
+            }
+            node->~RenderGraphNode();
+            resource->deallocate(node, size, alignment);
+        }
+    };
+
+    using RenderGraphNodePtr = std::unique_ptr<RenderGraphNode, RenderGraphNodeDeleter>;
+
     // Forward declaration
     class RenderGraph;
 
@@ -56,6 +99,13 @@ namespace vulkan_engine::rendering
     class RenderGraphBuilder
     {
         public:
+            // Nodes built with add_pass()/emplace_node() are allocated from resource
+            // (the owning graph's compile arena); nullptr uses the heap
+            explicit RenderGraphBuilder(std::pmr::memory_resource* resource = nullptr)
+                : resource_(resource)
+            {
+            }
+
             // Resource creation
             BufferHandle  create_buffer(const ResourceDesc& desc);
             ImageHandle   create_image(const ResourceDesc& desc);
@@ -64,14 +114,47 @@ namespace vulkan_engine::rendering
             // Pass creation
             template <RenderPass Pass> void add_pass(Pass&& pass)
             {
-                auto node = std::make_unique<std::decay_t<Pass>>(std::forward<Pass>(pass));
-                nodes_.push_back(std::move(node));
+                emplace_node<std::decay_t<Pass>>(std::forward<Pass>(pass));
+            }
+
+            // Construct a node in place, without a heap allocation per node
+            template <typename Node, typename... Args> Node& emplace_node(Args&&... args)
+            {
+                static_assert(std::is_base_of_v<RenderGraphNode, Node>, "Node must derive from RenderGraphNode");
+
+                if (!resource_)
+                {
+                    Node* node = new Node(std::forward<Args>(args)...);
+                    nodes_.push_back(RenderGraphNodePtr(node));
+                    return *node;
+                }
+
+                void* memory = resource_->allocate(sizeof(Node), alignof(Node));
+                Node* node;
+                try
+                {
+                    node = ::new (memory) Node(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    resource_->deallocate(memory, sizeof(Node), alignof(Node));
+                    throw;
+                }
+                nodes_.push_back(RenderGraphNodePtr(node, RenderGraphNodeDeleter(resource_, sizeof(Node), alignof(Node))));
+                return *node;
             }
 
             // Add a render graph node directly
             void add_node(std::unique_ptr<RenderGraphNode> node)
             {
-                nodes_.push_back(std::move(node));
+                nodes_.push_back(RenderGraphNodePtr(std::move(node)));
+            }
+
+            // Destroy all nodes; the node list keeps its capacity for the next build
+            void clear()
+            {
+                nodes_.clear();
+                resources_.clear();
             }
 
             // Resource access
@@ -81,10 +164,11 @@ namespace vulkan_engine::rendering
             void write(ImageHandle image);
 
             // Allow RenderGraph to access nodes
-            const std::vector<std::unique_ptr<RenderGraphNode>>& nodes() const { return nodes_; }
+            const std::vector<RenderGraphNodePtr>& nodes() const { return nodes_; }
 
         private:
-            std::vector<std::unique_ptr<RenderGraphNode>>         nodes_;
+            std::pmr::memory_resource*                            resource_ = nullptr;
+            std::vector<RenderGraphNodePtr>                       nodes_;
             std::unordered_map<std::string, ResourceHandle<void>> resources_;
 
             friend class RenderGraph;
@@ -93,10 +177,21 @@ namespace vulkan_engine::rendering
     // Forward declarations
     struct RenderContext;
 
-    // Main render graph class
+    // Main render graph class. Everything built for one graph (nodes, per-pass
+    // barrier lists) is allocated from a monotonic compile arena that is rewound
+    // by reset(), so rebuilding a graph of the same shape does not touch the heap.
     class RenderGraph
     {
         public:
+            // What recording one pass cost during the last execute(); commands
+            // include the barriers submitted ahead of the pass
+            struct PassStats
+            {
+                std::string_view     name; // Owned by the node, valid until reset()
+                float                cpu_ms = 0.0f;
+                vulkan::CommandStats commands;
+            };
+
             RenderGraph();
             ~RenderGraph();
 
@@ -150,7 +245,17 @@ namespace vulkan_engine::rendering
             // Get resource pool
             RenderGraphResourcePool* resource_pool() const { return resource_pool_.get(); }
 
+            // Arena for data that lives until the next reset(), e.g. pass setup scratch
+            core::LinearArena* compile_arena() const { return compile_arena_.get(); }
+
+            // One entry per pass in execution order; GPU times and pipeline
+            // statistics come from GpuProfiler scopes of the same name
+            const std::vector<PassStats>& pass_stats() const { return pass_stats_; }
+
         private:
+            // Declared first: destroyed after everything allocated from it
+            std::unique_ptr<core::LinearArena> compile_arena_;
+
             RenderGraphBuilder            builder_;
             bool                          compiled_ = false;
             std::vector<RenderGraphNode*> execution_order_;
@@ -166,6 +271,12 @@ namespace vulkan_engine::rendering
             // Per-pass barrier batches
             std::vector<BarrierBatch> pass_barriers_;
 
+            // Sized by compile(), overwritten by every execute()
+            std::vector<PassStats> pass_stats_;
+
+            // CPU profiler zone per pass, interned by compile() so they outlive the graph
+            std::vector<const char*> pass_zone_names_;
+
             // Analyze dependencies and build execution order
             void build_execution_order();
 
@@ -12,6 +12,7 @@ namespace vulkan_engine::vulkan
     class RenderCommandBuffer;
     class GraphicsPipeline;
     class Buffer;
+    class GpuProfiler;
 }
 
 namespace vulkan_engine::rendering
@@ -39,6 +40,10 @@ namespace vulkan_engine::rendering
 
         // Device
         std::shared_ptr<vulkan::DeviceManager> device;
+
+        // Null when GPU timing is off. RenderGraph::execute wraps every pass in a
+        // scope; passes may open nested scopes of their own.
+        vulkan::GpuProfiler* gpu_profiler = nullptr;
     };
 
     // Resource barriers for automatic synchronization
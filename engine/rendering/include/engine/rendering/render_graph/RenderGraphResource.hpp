@@ -5,9 +5,11 @@
 #include "engine/rhi/vulkan/resources/Buffer.hpp"
 #include "engine/rhi/vulkan/device/Device.hpp"
 #include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/core/memory/ObjectPool.hpp"
 
 #include <vulkan/vulkan.h>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -44,13 +46,19 @@ namespace vulkan_engine::rendering
         bool                            is_external = false;
     };
 
-    // Resource pool for managing render graph resources
+    // Resource pool for managing render graph resources. Resource records come
+    // from fixed-size object pools and the lookup tables from a pooled memory
+    // resource, so a rebuild after reset() reuses the previous build's storage.
     class RenderGraphResourcePool
     {
         public:
             explicit RenderGraphResourcePool(std::shared_ptr<vulkan::DeviceManager> device);
             ~RenderGraphResourcePool();
 
+            // Non-copyable, non-movable (handles resolve to records owned by the pools)
+            RenderGraphResourcePool(const RenderGraphResourcePool&)            = delete;
+            RenderGraphResourcePool& operator=(const RenderGraphResourcePool&) = delete;
+
             // Create or acquire an image resource
             ImageResourceInfo* acquire_image(const ResourceDesc& desc, ImageHandle handle);
 
@@ -83,8 +91,13 @@ namespace vulkan_engine::rendering
         private:
             std::shared_ptr<vulkan::DeviceManager> device_;
 
-            std::unordered_map<uint32_t, std::unique_ptr<ImageResourceInfo>>  images_;
-            std::unordered_map<uint32_t, std::unique_ptr<BufferResourceInfo>> buffers_;
+            // Declared before the tables and records that allocate from them
+            std::pmr::unsynchronized_pool_resource table_resource_;
+            core::ObjectPool<ImageResourceInfo>    image_infos_;
+            core::ObjectPool<BufferResourceInfo>   buffer_infos_;
+
+            std::pmr::unordered_map<uint32_t, ImageResourceInfo*>  images_;
+            std::pmr::unordered_map<uint32_t, BufferResourceInfo*> buffers_;
 
             // Resource creation helpers
             std::unique_ptr<vulkan::Image>  create_image(const ResourceDesc& desc);
@@ -120,8 +133,8 @@ namespace vulkan_engine::rendering
 
             void compile(RenderGraphResourcePool& pool);
 
-            // Get barriers to insert before a pass
-            BarrierBatch get_barriers_for_pass(uint32_t pass_index) const;
+            // Append the barriers to insert before a pass to batch
+            void get_barriers_for_pass(uint32_t pass_index, BarrierBatch& batch) const;
 
             void clear();
 
@@ -2,6 +2,7 @@
 
 #include <vulkan/vulkan.h>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -97,13 +98,20 @@ namespace vulkan_engine::rendering
         } format = Format::R8G8B8A8_UNORM;
     };
 
-    // Barrier batch for efficient submission
+    // Barrier batch for efficient submission. The barrier lists use the memory
+    // resource given at construction (the graph's compile arena), the heap by default.
     struct BarrierBatch
     {
-        std::vector<VkImageMemoryBarrier>  image_barriers;
-        std::vector<VkBufferMemoryBarrier> buffer_barriers;
-        VkPipelineStageFlags               src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        VkPipelineStageFlags               dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        std::pmr::vector<VkImageMemoryBarrier>  image_barriers;
+        std::pmr::vector<VkBufferMemoryBarrier> buffer_barriers;
+        VkPipelineStageFlags                    src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        VkPipelineStageFlags                    dst_stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+        BarrierBatch() = default;
+        explicit BarrierBatch(std::pmr::memory_resource* resource)
+            : image_barriers(resource), buffer_barriers(resource)
+        {
+        }
 
         bool empty() const { return image_barriers.empty() && buffer_barriers.empty(); }
 
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "engine/rhi/vulkan/resources/Buffer.hpp"
+#include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/rhi/vulkan/memory/OffsetAllocator.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vulkan_engine::rendering
+{
+    // Part of a GeometryBuffer owned by one mesh. Offsets are in elements, so they
+    // are directly the vertexOffset / firstIndex of an indexed draw.
+    struct GeometrySlice
+    {
+        vulkan::memory::OffsetAllocator::Range vertices;
+        vulkan::memory::OffsetAllocator::Range indices;
+        uint32_t                               vertex_count = 0;
+        uint32_t                               index_count  = 0;
+
+        bool     valid() const { return vertices.isValid() && indices.isValid(); }
+        int32_t  vertex_offset() const { return valid() ? static_cast<int32_t>(vertices.offset) : 0; }
+        uint32_t first_index() const { return valid() ? indices.offset : 0; }
+    };
+
+    // ============================================================================
+    // GeometryBuffer - Vertex and index megabuffers shared by many meshes
+    // ============================================================================
+    // Small meshes sub-allocate from one vertex and one 32-bit index buffer instead
+    // of owning two buffers each. A pass binds the buffers once and every draw
+    // selects its mesh with firstIndex/vertexOffset. Ranges come from O(1)
+    // OffsetAllocators; freed ranges are held back for frames_in_flight frames
+    // so in-flight draws never see them overwritten. The buffers are device-local
+    // and written through a staging copy, except on integrated GPUs where
+    // host-visible memory is just as fast and write() is a plain memcpy.
+    class GeometryBuffer
+    {
+        public:
+            struct Config
+            {
+                uint32_t vertex_stride    = 0; // Bytes per vertex, required
+                uint32_t vertex_capacity  = 1024 * 1024;
+                uint32_t index_capacity   = 3 * 1024 * 1024;
+                uint32_t max_allocations  = 16 * 1024;
+                uint32_t frames_in_flight = 2;
+            };
+
+            struct Stats
+            {
+                uint32_t allocation_count      = 0;
+                uint32_t free_vertices         = 0;
+                uint32_t free_indices          = 0;
+                uint32_t largest_free_vertices = 0;
+                uint32_t largest_free_indices  = 0;
+                uint32_t pending_frees         = 0; // Waiting for their frames to retire
+            };
+
+            GeometryBuffer(std::shared_ptr<vulkan::DeviceManager> device, const Config& config);
+            ~GeometryBuffer();
+
+            // Non-copyable, non-movable (slices are tied to this buffer)
+            GeometryBuffer(const GeometryBuffer&)            = delete;
+            GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+
+            // Thread-safe. Returns an invalid slice when either buffer is full.
+            GeometrySlice allocate(uint32_t vertex_count, uint32_t index_count);
+            void          free(const GeometrySlice& slice);
+
+            // Copy data into a slice (vertices are vertex_count * vertex_stride bytes).
+            // Device-local buffers are filled by a copy on the graphics timeline; draws
+            // submitted afterwards to the same queue see the data without waiting.
+            void write(const GeometrySlice& slice, const void* vertices, const uint32_t* indices);
+
+            // Call once per frame after the frame's fence wait; returns ranges
+            // freed frames_in_flight frames ago to the allocators
+            void begin_frame();
+
+            // Bind both buffers; draws then use the slice offsets
+            void bind(vulkan::RenderCommandBuffer& cmd) const;
+
+            vulkan::Buffer* vertex_buffer() const { return vertex_buffer_.get(); }
+            vulkan::Buffer* index_buffer() const { return index_buffer_.get(); }
+            uint32_t        vertex_stride() const { return config_.vertex_stride; }
+            bool            host_visible() const { return host_visible_; }
+
+            Stats stats() const;
+
+        private:
+            struct RetiredSlice
+            {
+                GeometrySlice slice;
+                uint64_t      frame = 0;
+            };
+
+            std::shared_ptr<vulkan::DeviceManager> device_;
+            Config                                 config_;
+            bool                                   host_visible_ = false;
+
+            std::unique_ptr<vulkan::Buffer> vertex_buffer_;
+            std::unique_ptr<vulkan::Buffer> index_buffer_;
+
+            vulkan::memory::OffsetAllocator vertex_allocator_;
+            vulkan::memory::OffsetAllocator index_allocator_;
+
+            std::vector<RetiredSlice> retired_;
+            uint64_t                  frame_ = 0;
+
+            mutable std::mutex mutex_;
+
+            void upload(
+                const void*     vertices,
+                VkDeviceSize    vertex_bytes,
+                VkDeviceSize    vertex_offset,
+                const uint32_t* indices,
+                VkDeviceSize    index_bytes,
+                VkDeviceSize    index_offset);
+    };
+} // namespace vulkan_engine::rendering
@@ -2,6 +2,8 @@
 
 #include "engine/rhi/vulkan/resources/Buffer.hpp"
 #include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/rhi/vulkan/memory/BudgetGovernor.hpp"
+#include "engine/rendering/resources/GeometryBuffer.hpp"
 #include <glm/glm.hpp>
 #include <vector>
 #include <memory>
@@ -39,37 +41,54 @@ namespace vulkan_engine::rendering
     class Mesh
     {
         public:
-            Mesh()  = default;
-            ~Mesh() = default;
+            Mesh() = default;
+            ~Mesh();
 
             // Non-copyable
             Mesh(const Mesh&)            = delete;
             Mesh& operator=(const Mesh&) = delete;
 
             // Movable
-            Mesh(Mesh&&)            = default;
-            Mesh& operator=(Mesh&&) = default;
+            Mesh(Mesh&& other) noexcept;
+            Mesh& operator=(Mesh&& other) noexcept;
 
             // Upload mesh data to GPU
             void upload(std::shared_ptr<vulkan::DeviceManager> device, const MeshData& data);
 
-            // Bind for rendering
-            void bind(vulkan::RenderCommandBuffer& cmd);
+            // Upload into a shared GeometryBuffer instead of dedicated buffers. Falls
+            // back to dedicated buffers when the geometry buffer is full.
+            void upload(std::shared_ptr<GeometryBuffer> geometry, std::shared_ptr<vulkan::DeviceManager> device, const MeshData& data);
 
-            // Draw
+            // Let the budget governor evict the buffers when the mesh goes cold. The
+            // contents are read back to the CPU on eviction and re-uploaded by the next
+            // bind(). Do not enable for meshes whose buffers are referenced elsewhere.
+            // Meshes in a GeometryBuffer are not tracked individually.
+            void enable_residency(std::shared_ptr<vulkan::memory::BudgetGovernor> governor);
+
+            // Bind for rendering. screen_coverage (0..1) feeds the residency priority.
+            // Passes drawing many meshes of one GeometryBuffer can bind it once and
+            // only call draw().
+            void bind(vulkan::RenderCommandBuffer& cmd, float screen_coverage = 0.0f);
+
+            // Draw (with firstIndex/vertexOffset of the slice when sub-allocated)
             void draw(vulkan::RenderCommandBuffer& cmd);
 
             // Getters
             uint32_t vertex_count() const { return vertex_count_; }
             uint32_t index_count() const { return index_count_; }
-            bool     is_uploaded() const { return vertex_buffer_ != nullptr; }
+            bool     is_uploaded() const { return vertex_buffer_ != nullptr || slice_.valid(); }
+
+            // Sub-allocation (null / zero for meshes with dedicated buffers)
+            const std::shared_ptr<GeometryBuffer>& geometry() const { return geometry_; }
+            uint32_t                               first_index() const { return slice_.first_index(); }
+            int32_t                                vertex_offset() const { return slice_.vertex_offset(); }
 
             const std::string& name() const { return name_; }
             void               set_name(const std::string& name) { name_ = name; }
 
             // Buffer access for integration with existing render passes
-            vulkan::Buffer* vertex_buffer() const { return vertex_buffer_.get(); }
-            vulkan::Buffer* index_buffer() const { return index_buffer_.get(); }
+            vulkan::Buffer* vertex_buffer() const { return geometry_ ? geometry_->vertex_buffer() : vertex_buffer_.get(); }
+            vulkan::Buffer* index_buffer() const { return geometry_ ? geometry_->index_buffer() : index_buffer_.get(); }
 
         private:
             std::shared_ptr<vulkan::DeviceManager> device_;
@@ -78,5 +97,21 @@ namespace vulkan_engine::rendering
             uint32_t                               vertex_count_ = 0;
             uint32_t                               index_count_  = 0;
             std::string                            name_;
+
+            // Shared buffers; slice_ is invalid when the mesh owns its buffers
+            std::shared_ptr<GeometryBuffer> geometry_;
+            GeometrySlice                   slice_;
+
+            // Residency
+            std::weak_ptr<vulkan::memory::BudgetGovernor> governor_;
+            vulkan::memory::BudgetGovernor::Handle        residency_handle_ = vulkan::memory::BudgetGovernor::INVALID_HANDLE;
+            MeshData                                      evicted_data_; // Buffer contents while evicted
+
+            void                                      create_buffers(const MeshData& data);
+            void                                      evict();
+            bool                                      reload();
+            vulkan::memory::BudgetGovernor::Callbacks residency_callbacks();
+            void                                      release_residency();
+            void                                      release_slice();
     };
 } // namespace vulkan_engine::rendering
\ No newline at end of file
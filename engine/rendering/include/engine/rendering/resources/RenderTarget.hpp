@@ -64,6 +64,10 @@ namespace vulkan_engine::rendering
             // 閲嶆柊鍒涘缓锛堝昂瀵稿彉鍖栨椂锛?
             void resize(uint32_t width, uint32_t height);
 
+            // Records the layout transitions a resize() left pending. Call right
+            // after beginning the command buffer that first renders the target.
+            void record_pending_layouts(VkCommandBuffer cmd);
+
             // Getters - 杩斿洖鏍煎紡/灏哄淇℃伅
             VkFormat              color_format() const { return color_format_; }
             VkFormat              depth_format() const { return depth_format_; }
@@ -72,6 +76,11 @@ namespace vulkan_engine::rendering
             uint32_t              height() const { return height_; }
             VkSampleCountFlagBits samples() const { return samples_; }
 
+            // Top-left region rendered this frame (dynamic resolution). Clamped to
+            // extent(); resize() resets it to the full size.
+            void       set_render_extent(uint32_t width, uint32_t height);
+            VkExtent2D render_extent() const { return render_extent_; }
+
             // 妫€鏌ユ槸鍚︽湁棰滆壊/娣卞害闄勪欢
             bool has_color() const { return color_image_ != nullptr; }
             bool has_depth() const { return depth_image_ != nullptr; }
@@ -102,6 +111,7 @@ namespace vulkan_engine::rendering
             VkFormat              color_format_ = VK_FORMAT_UNDEFINED;
             VkFormat              depth_format_ = VK_FORMAT_UNDEFINED;
             VkSampleCountFlagBits samples_      = VK_SAMPLE_COUNT_1_BIT;
+            VkExtent2D            render_extent_{};
             bool                  create_color_ = true;
             bool                  create_depth_ = true;
 
@@ -116,9 +126,12 @@ namespace vulkan_engine::rendering
             // Framebuffer锛圧AII 绠＄悊锛?
             std::unique_ptr<vulkan::Framebuffer> framebuffer_;
 
+            bool layouts_pending_ = false; // Set by resize(), cleared by record_pending_layouts()
+
             void create_images();
             void create_color_image();
             void create_depth_image();
             void transition_image_layout();
+            void record_layout_transitions(VkCommandBuffer cmd_buffer);
     };
 } // namespace vulkan_engine::rendering
\ No newline at end of file
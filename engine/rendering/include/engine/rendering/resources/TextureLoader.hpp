@@ -3,8 +3,10 @@
 #include "engine/rhi/vulkan/resources/Image.hpp"
 #include "engine/rhi/vulkan/device/Device.hpp"
 
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace vulkan_engine::rendering
 {
@@ -14,6 +16,15 @@ namespace vulkan_engine::rendering
     class TextureLoader
     {
         public:
+            // Decoded RGBA8 pixels, ready for upload
+            struct TextureData
+            {
+                std::string          path; // Resolved file path
+                std::vector<uint8_t> pixels;
+                uint32_t             width  = 0;
+                uint32_t             height = 0;
+            };
+
             explicit TextureLoader(std::shared_ptr<vulkan::DeviceManager> device);
             ~TextureLoader() = default;
 
@@ -29,6 +40,17 @@ namespace vulkan_engine::rendering
                 VkFormat           format,
                 bool               generate_mipmaps = true);
 
+            // Read and decode a texture file without touching the GPU. Thread-safe, so
+            // batches of textures can be decoded on worker threads.
+            bool decode_texture(const std::string& path, TextureData& data) const;
+
+            // Create the GPU image for decoded pixels (submits to the graphics queue)
+            std::shared_ptr<vulkan::Image> upload_texture(const TextureData& data, bool generate_mipmaps = true);
+
+            // Halve the resolution with a 2x2 box filter, for uploading a texture without its
+            // top mip. Returns false once the image is 1x1.
+            static bool downsample(TextureData& data);
+
             // Set base directory for texture paths
             void set_base_directory(const std::string& path) { base_directory_ = path; }
 
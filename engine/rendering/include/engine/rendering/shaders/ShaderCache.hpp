@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::rendering
+{
+    // ============================================================================
+    // ShaderCache - Content-addressed on-disk store of compiled SPIR-V
+    // ============================================================================
+    // Entries are named by a key derived from everything that affects the output
+    // (source and include contents, defines, entry point, stage, compiler version),
+    // so a stale entry can never be returned and no invalidation is needed.
+    // Writes go through a temporary file and a rename, which keeps concurrent
+    // compiles of the same variant from observing partial files.
+    class ShaderCache
+    {
+        public:
+            explicit ShaderCache(std::filesystem::path directory);
+
+            const std::filesystem::path& directory() const { return directory_; }
+            std::filesystem::path        entry_path(const std::string& key) const;
+
+            bool load(const std::string& key, std::vector<uint32_t>& bytecode) const;
+            bool store(const std::string& key, const std::vector<uint32_t>& bytecode) const;
+
+            // Hashing helpers used to build keys (64-bit FNV-1a)
+            static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+            static uint64_t    hash_bytes(const void* data, size_t size, uint64_t seed = HASH_SEED);
+            static uint64_t    hash_string(const std::string& text, uint64_t seed = HASH_SEED);
+            static bool        hash_file(const std::filesystem::path& path, uint64_t& hash);
+            static std::string to_hex(uint64_t value);
+
+            // Canonical, order-independent form of a define set ("ALPHA_TEST;NORMAL_MAP=1")
+            static std::string permutation_key(const std::unordered_map<std::string, std::string>& defines);
+
+        private:
+            std::filesystem::path directory_;
+    };
+} // namespace vulkan_engine::rendering
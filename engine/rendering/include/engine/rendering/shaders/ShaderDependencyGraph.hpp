@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::rendering
+{
+    // ============================================================================
+    // ShaderDependencyGraph - Which shader artifacts depend on which inputs
+    // ============================================================================
+    // Nodes are normalized file paths (sources, imports, SPIR-V outputs) or
+    // synthetic ids for things built from them ("program:pbr", "material:Gold").
+    // An edge dependency -> dependent means the dependent must be rebuilt when
+    // the dependency changes, so a file change maps to exactly the programs and
+    // pipelines that read it, transitively. Thread-safe.
+    class ShaderDependencyGraph
+    {
+        public:
+            void add_edge(const std::string& dependency, const std::string& dependent);
+
+            // Forget everything the node depends on (before re-recording it after a rebuild)
+            void clear_dependencies(const std::string& dependent);
+
+            // Remove the node and all edges touching it
+            void remove_node(const std::string& node);
+
+            // Every node reachable from the changed nodes, excluding the changed nodes
+            // themselves unless they are reachable from one another
+            std::set<std::string> collect_affected(const std::vector<std::string>& changed) const;
+
+            std::set<std::string> dependencies_of(const std::string& node) const;
+            bool                  contains(const std::string& node) const;
+            size_t                node_count() const;
+
+        private:
+            std::unordered_map<std::string, std::set<std::string>> dependents_;   // dependency -> dependents
+            std::unordered_map<std::string, std::set<std::string>> dependencies_; // dependent -> dependencies
+            mutable std::mutex                                     mutex_;
+    };
+} // namespace vulkan_engine::rendering
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "engine/platform/filesystem/FileWatcher.hpp"
+#include "engine/rendering/shaders/ShaderDependencyGraph.hpp"
+#include "engine/rendering/shaders/ShaderManager.hpp"
+#include "engine/rendering/material/Material.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::rendering
+{
+    // ============================================================================
+    // ShaderHotReloader - Event-driven rebuild of material pipelines
+    // ============================================================================
+    // Tracks a dependency graph of .slang source (and its imports) -> SPIR-V ->
+    // material. A file watcher reports changes; a worker thread recompiles the
+    // affected sources, and for every material downstream of a changed .spv
+    // builds a replacement pipeline against the material's existing layouts.
+    // Nothing touches the frame loop until apply_pending(), which swaps the
+    // finished pipelines in between frames and retires the old ones once no
+    // frame in flight can still reference them.
+    //
+    // Shader edits that change the resource interface (bindings, push constants,
+    // vertex inputs or parameter offsets) are reported and skipped; those need
+    // the material itself to be reloaded.
+    class ShaderHotReloader
+    {
+        public:
+            struct Config
+            {
+                uint32_t                        frames_in_flight = 2;
+                filesystem::FileWatcher::Config watcher;
+            };
+
+            struct Stats
+            {
+                uint32_t tracked_materials  = 0;
+                uint32_t sources_recompiled = 0;
+                uint32_t pipelines_rebuilt  = 0;
+                uint32_t pipelines_swapped  = 0;
+                uint32_t failures           = 0;
+                uint32_t retired_pipelines  = 0; // Old pipelines waiting for frames in flight to finish
+            };
+
+            // shader_manager compiles .slang sources through its SPIR-V cache; may be null,
+            // in which case only .spv changes (from an external build) are picked up
+            ShaderHotReloader(std::shared_ptr<ShaderManager> shader_manager, const Config& config);
+            ~ShaderHotReloader();
+
+            // Non-copyable
+            ShaderHotReloader(const ShaderHotReloader&)            = delete;
+            ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+            // Start watching the material's shaders (and their .slang sources, if present).
+            // Materials are held weakly; destroyed materials are dropped automatically.
+            void track_material(const std::shared_ptr<Material>& material);
+
+            // Main thread, once per frame after the current frame's fence has been waited on.
+            // Installs pipelines finished since the last call; returns how many were swapped.
+            uint32_t apply_pending();
+
+            Stats stats() const;
+
+        private:
+            struct SourceOutput
+            {
+                std::filesystem::path spirv_path;
+                ShaderType            type;
+                const char*           entry_point;
+            };
+
+            struct ReadyPipeline
+            {
+                std::weak_ptr<Material>                   material;
+                std::unique_ptr<vulkan::GraphicsPipeline> pipeline;
+            };
+
+            struct RetiredPipeline
+            {
+                std::unique_ptr<vulkan::GraphicsPipeline> pipeline;
+                uint64_t                                  retire_frame;
+            };
+
+            std::shared_ptr<ShaderManager> shader_manager_;
+            Config                         config_;
+            ShaderDependencyGraph          graph_;
+
+            // Tracked state (guarded by mutex_)
+            std::unordered_map<std::string, std::weak_ptr<Material>>   materials_; // "material:<id>" -> material
+            std::unordered_map<std::string, std::vector<SourceOutput>> sources_;   // .slang path -> SPIR-V outputs
+            std::vector<std::filesystem::path>                         watched_directories_;
+            Stats                                                      stats_;
+            mutable std::mutex                                         mutex_;
+
+            // Worker queue (guarded by mutex_)
+            std::vector<std::filesystem::path> changed_files_;
+            std::condition_variable            wake_;
+            bool                               stopping_ = false;
+            std::thread                        worker_;
+
+            // Finished pipelines (guarded by mutex_) and retired ones (main thread only)
+            std::vector<ReadyPipeline>   ready_;
+            std::vector<RetiredPipeline> retired_;
+            uint64_t                     frame_counter_ = 0;
+
+            // Declared last so it stops before the state its callback writes to is destroyed
+            std::unique_ptr<filesystem::FileWatcher> watcher_;
+
+            void watch_directory(const std::filesystem::path& directory);
+            void record_source_dependencies(const std::filesystem::path& source);
+            void worker_loop();
+            void process_changes(const std::vector<std::filesystem::path>& changed);
+            bool recompile_source(const std::string& source);
+            void rebuild_material(const std::string& node);
+    };
+} // namespace vulkan_engine::rendering
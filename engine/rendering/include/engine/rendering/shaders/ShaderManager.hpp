@@ -1,5 +1,8 @@
 #pragma once
 
+#include "engine/rhi/vulkan/pipelines/ShaderReflection.hpp"
+#include "engine/rendering/shaders/ShaderDependencyGraph.hpp"
+
 #include <cstdint>
 #include <filesystem>
 #include <string>
@@ -23,11 +26,12 @@ namespace vulkan_engine::rendering
     {
         std::string                                  name;
         ShaderType                                   type;
-        std::string                                  source;
+        std::filesystem::path                        source_path; // Slang source file
+        std::string                                  source;      // Inline source, used when source_path is empty
         std::string                                  entry_point = "main";
         uint32_t                                     version     = 450;
         std::vector<std::filesystem::path>           include_paths;
-        std::unordered_map<std::string, std::string> defines;
+        std::unordered_map<std::string, std::string> defines; // Permutation, e.g. {"NORMAL_MAP", "1"}
     };
 
     struct ShaderCompileResult
@@ -39,21 +43,33 @@ namespace vulkan_engine::rendering
         std::vector<uint32_t>    bytecode;
         std::string              error_message;
         std::vector<std::string> warnings;
+        std::string              cache_key;          // Content hash of all compile inputs (empty if not cacheable)
+        bool                     from_cache = false; // Served from the on-disk SPIR-V cache
+
+        // Reflected from bytecode on load; null if the module could not be reflected
+        std::shared_ptr<const vulkan::ShaderReflection> reflection;
     };
 
     struct ShaderProgram
     {
-        std::string         name;
-        ShaderCompileResult vertex_shader;
-        ShaderCompileResult fragment_shader;
-        ShaderCompileResult geometry_shader;
-        ShaderCompileResult compute_shader;
-        // Vulkan pipeline layout, descriptor set layout, etc.
+        std::string                                  name;
+        std::unordered_map<std::string, std::string> defines; // Permutation this program was built with
+        ShaderCompileResult                          vertex_shader;
+        ShaderCompileResult                          fragment_shader;
+        ShaderCompileResult                          geometry_shader;
+        ShaderCompileResult                          compute_shader;
+
+        // Interface of all stages combined; feed to vulkan::LayoutCache for shared layouts
+        vulkan::ShaderReflection reflection;
     };
 
     class ShaderManager
     {
         public:
+            // Entry point names used by the engine's .slang files
+            static constexpr const char* VERTEX_ENTRY_POINT   = "vertexMain";
+            static constexpr const char* FRAGMENT_ENTRY_POINT = "fragmentMain";
+
             ShaderManager();
             ~ShaderManager();
 
@@ -62,11 +78,20 @@ namespace vulkan_engine::rendering
 
             // Load shaders
             std::shared_ptr<ShaderProgram> load_shader_program(const std::string& name);
+
+            // Load a permutation of {name}.slang, compiling missing stages in parallel
+            std::shared_ptr<ShaderProgram> load_shader_program(
+                const std::string&                                  name,
+                const std::unordered_map<std::string, std::string>& defines);
             ShaderCompileResult            load_shader(const std::filesystem::path& path, ShaderType type);
 
-            // Compile shaders
+            // Compile shaders through slangc, reusing cached SPIR-V when all inputs match
             ShaderCompileResult compile_shader(const ShaderCompileInfo& info);
 
+            // Compile a batch of variants; cache misses are compiled on worker threads.
+            // Results are returned in input order.
+            std::vector<ShaderCompileResult> compile_variants(const std::vector<ShaderCompileInfo>& infos);
+
             // Load pre-compiled SPIR-V
             ShaderCompileResult load_spirv(const std::filesystem::path& path, ShaderType type);
 
@@ -76,14 +101,23 @@ namespace vulkan_engine::rendering
                 ShaderType type,
                 const std::string& entry_point = "main");
 
+            // Source files imported by a shader, transitively (resolved against the
+            // source directory and include paths; unresolved modules are skipped)
+            std::vector<std::filesystem::path> resolve_dependencies(const ShaderCompileInfo& info);
+
             // Reload
             void reload_shader(const std::string& name);
             void reload_all_shaders();
+
+            // Reload the programs affected by files changed since the last call. Changes
+            // are collected by a background file watcher, so this does no filesystem
+            // polling of its own and is cheap to call every frame.
             void update_hot_reloads();
 
             // Configuration
             void set_shader_directory(const std::filesystem::path& directory);
-            void set_cache_directory(const std::string& directory);
+            void set_cache_directory(const std::string& directory); // Default: {shader_dir}/.cache
+            void set_compiler_path(const std::string& path);        // Default: slangc from PATH
             void enable_caching(bool enable);
             void enable_hot_reloading(bool enable);
 
@@ -92,6 +126,9 @@ namespace vulkan_engine::rendering
             bool                           is_shader_loaded(const std::string& name) const;
             std::vector<std::string>       get_loaded_shader_names() const;
 
+            // File -> source -> "program:<key>" edges recorded while loading
+            const ShaderDependencyGraph& dependency_graph() const;
+
         private:
             struct Impl;
             std::unique_ptr<Impl> impl_;
@@ -4,6 +4,9 @@
 #include "engine/rhi/vulkan/device/SwapChain.hpp"
 #include "engine/platform/windowing/Window.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
+
+#include <algorithm>
 
 namespace vulkan_engine::rendering
 {
@@ -26,6 +29,8 @@ namespace vulkan_engine::rendering
         , scene_renderer_(std::move(other.scene_renderer_))
         , ui_renderer_(std::move(other.ui_renderer_))
         , current_frame_(other.current_frame_)
+        , max_frames_in_flight_(other.max_frames_in_flight_)
+        , single_submission_(other.single_submission_)
     {
         other.initialized_ = false;
     }
@@ -36,10 +41,12 @@ namespace vulkan_engine::rendering
         {
             shutdown();
 
-            initialized_    = other.initialized_;
-            scene_renderer_ = std::move(other.scene_renderer_);
-            ui_renderer_    = std::move(other.ui_renderer_);
-            current_frame_  = other.current_frame_;
+            initialized_          = other.initialized_;
+            scene_renderer_       = std::move(other.scene_renderer_);
+            ui_renderer_          = std::move(other.ui_renderer_);
+            current_frame_        = other.current_frame_;
+            max_frames_in_flight_ = other.max_frames_in_flight_;
+            single_submission_    = other.single_submission_;
 
             other.initialized_ = false;
         }
@@ -66,10 +73,13 @@ namespace vulkan_engine::rendering
 
         // 鍒濆鍖栧満鏅覆鏌撳櫒
         SceneRenderer::Config scene_config;
-        scene_config.width                = config.scene_width;
-        scene_config.height               = config.scene_height;
-        scene_config.enable_gpu_timing    = config.enable_gpu_timing;
-        scene_config.max_frames_in_flight = config.max_frames_in_flight;
+        scene_config.width                      = config.scene_width;
+        scene_config.height                     = config.scene_height;
+        scene_config.enable_gpu_timing          = config.enable_gpu_timing;
+        scene_config.enable_pipeline_statistics = config.enable_pipeline_statistics;
+        scene_config.max_frames_in_flight       = config.max_frames_in_flight;
+        scene_config.external_submit            = config.single_submission;
+        scene_config.dynamic_resolution         = config.dynamic_resolution;
 
         if (!scene_renderer_.initialize(device, scene_config))
         {
@@ -89,6 +99,10 @@ namespace vulkan_engine::rendering
             return false;
         }
 
+        max_frames_in_flight_ = std::max(config.max_frames_in_flight, 1u);
+        single_submission_    = config.single_submission;
+        current_frame_        = 0;
+
         initialized_ = true;
         logger::info("ComposedRenderer initialized successfully");
         return true;
@@ -116,11 +130,26 @@ namespace vulkan_engine::rendering
 
     bool ComposedRenderer::begin_frame()
     {
+        PROFILE_SCOPE("ComposedRenderer::begin_frame");
+
         if (!initialized_)
         {
             return false;
         }
 
+        // Single submission: the UI slot's timeline value covers the whole frame,
+        // so the scene starts on the slot that wait just released
+        if (single_submission_)
+        {
+            if (!ui_renderer_.acquire_next_image())
+            {
+                return false;
+            }
+
+            scene_renderer_.begin_frame(ui_renderer_.current_frame());
+            return true;
+        }
+
         // 1. 寮€濮嬪満鏅抚锛堝満鏅覆鏌撳櫒鏈夎嚜宸辩殑鏆傚仠鎺у埗锛?
         scene_renderer_.begin_frame();
 
@@ -138,6 +167,8 @@ namespace vulkan_engine::rendering
 
     void ComposedRenderer::render_scene(SceneRenderCallback callback)
     {
+        PROFILE_SCOPE("ComposedRenderer::render_scene");
+
         if (!initialized_)
         {
             return;
@@ -149,6 +180,8 @@ namespace vulkan_engine::rendering
 
     void ComposedRenderer::render_ui(editor::Editor& editor)
     {
+        PROFILE_SCOPE("ComposedRenderer::render_ui");
+
         if (!initialized_)
         {
             return;
@@ -160,11 +193,13 @@ namespace vulkan_engine::rendering
                                           : scene_renderer_.get_scene_finished_semaphore();
 
         // 浼犻€掑満鏅覆鏌撶洰鏍囦緵UI鏄剧ず
-        ui_renderer_.render(editor, scene_renderer_.render_target(), scene_semaphore);
+        ui_renderer_.render(editor, scene_renderer_.render_target(), scene_semaphore, scene_renderer_.frame_command_buffer());
     }
 
     void ComposedRenderer::end_frame()
     {
+        PROFILE_SCOPE("ComposedRenderer::end_frame");
+
         if (!initialized_)
         {
             return;
@@ -176,7 +211,7 @@ namespace vulkan_engine::rendering
         // 2. 鍛堢幇UI
         ui_renderer_.present();
 
-        current_frame_ = (current_frame_ + 1) % 2; // 鍋囪 max_frames_in_flight = 2
+        current_frame_ = (current_frame_ + 1) % max_frames_in_flight_;
     }
 
     // ============================================================================
@@ -0,0 +1,106 @@
+#include "engine/rendering/DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vulkan_engine::rendering
+{
+    namespace
+    {
+        constexpr float INTEGRAL_LIMIT   = 2.0f;  // Anti-windup bound on the summed error
+        constexpr float MAX_AREA_CHANGE  = 0.5f;  // Largest pixel-fraction change per step
+        constexpr float INTEGRAL_RELEASE = 0.5f;  // Integral kept per sample inside the dead band
+    } // namespace
+
+    DynamicResolution::DynamicResolution()
+        : DynamicResolution(Config{})
+    {
+    }
+
+    DynamicResolution::DynamicResolution(const Config& config)
+    {
+        set_config(config);
+    }
+
+    void DynamicResolution::set_config(const Config& config)
+    {
+        config_               = config;
+        config_.target_gpu_ms = std::max(config_.target_gpu_ms, 0.1f);
+        config_.max_scale     = std::clamp(config_.max_scale, 0.1f, 1.0f);
+        config_.min_scale     = std::clamp(config_.min_scale, 0.1f, config_.max_scale);
+        config_.dead_band     = std::max(config_.dead_band, 0.0f);
+        config_.min_step      = std::max(config_.min_step, 0.0f);
+        reset();
+    }
+
+    void DynamicResolution::reset()
+    {
+        scale_      = config_.max_scale;
+        integral_   = 0.0f;
+        prev_error_ = 0.0f;
+        settle_     = 0;
+    }
+
+    float DynamicResolution::update(float gpu_ms)
+    {
+        if (!config_.enabled)
+        {
+            scale_ = config_.max_scale;
+            return scale_;
+        }
+        if (gpu_ms <= 0.0f)
+        {
+            return scale_;
+        }
+
+        const float error = std::clamp((config_.target_gpu_ms - gpu_ms) / config_.target_gpu_ms, -1.0f, 1.0f);
+        if (settle_ > 0)
+        {
+            --settle_;
+            prev_error_ = error;
+            return scale_;
+        }
+
+        if (std::abs(error) < config_.dead_band)
+        {
+            integral_ *= INTEGRAL_RELEASE;
+            prev_error_ = error;
+            return scale_;
+        }
+
+        const float integral   = std::clamp(integral_ + error, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+        const float derivative = error - prev_error_;
+        prev_error_            = error;
+
+        const float output = std::clamp(config_.kp * error + config_.ki * integral + config_.kd * derivative, -MAX_AREA_CHANGE, MAX_AREA_CHANGE);
+        const float area   = scale_ * scale_ * (1.0f + output);
+        const float target = std::clamp(std::sqrt(std::max(area, 0.0f)), config_.min_scale, config_.max_scale);
+
+        // Stop integrating while pinned at a bound, or it winds up and overshoots
+        // on the way back
+        const bool saturated = (target >= config_.max_scale && error > 0.0f) || (target <= config_.min_scale && error < 0.0f);
+        if (!saturated)
+        {
+            integral_ = integral;
+        }
+
+        if (std::abs(target - scale_) < config_.min_step)
+        {
+            return scale_;
+        }
+
+        scale_  = target;
+        settle_ = config_.settle_frames;
+        return scale_;
+    }
+
+    VkExtent2D DynamicResolution::scaled_extent(VkExtent2D full) const
+    {
+        auto scale_side = [this](uint32_t side)
+        {
+            const auto scaled = static_cast<uint32_t>(std::lround(static_cast<float>(side) * scale_));
+            return std::clamp(scaled, 1u, std::max(side, 1u));
+        };
+        return {scale_side(full.width), scale_side(full.height)};
+    }
+} // namespace vulkan_engine::rendering
@@ -0,0 +1,296 @@
+#include "engine/rendering/HeadlessRenderer.hpp"
+#include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <system_error>
+
+namespace vulkan_engine::rendering
+{
+    // ============================================================================
+    // Constructor / Destructor
+    // ============================================================================
+
+    HeadlessRenderer::HeadlessRenderer() = default;
+
+    HeadlessRenderer::~HeadlessRenderer()
+    {
+        if (initialized_)
+        {
+            shutdown();
+        }
+    }
+
+    // ============================================================================
+    // Initialization
+    // ============================================================================
+
+    bool HeadlessRenderer::initialize(std::shared_ptr<vulkan::DeviceManager> device, const Config& config)
+    {
+        if (initialized_)
+        {
+            logger::warn("HeadlessRenderer already initialized");
+            return true;
+        }
+
+        if (!device || !device->graphics_timeline())
+        {
+            logger::error("HeadlessRenderer: device not initialized");
+            return false;
+        }
+
+        logger::info("Initializing HeadlessRenderer...");
+
+        max_frames_in_flight_ = std::max(config.max_frames_in_flight, 1u);
+
+        // The scene records, this class waits and submits
+        SceneRenderer::Config scene_config;
+        scene_config.width                      = config.width;
+        scene_config.height                     = config.height;
+        scene_config.enable_gpu_timing          = config.enable_gpu_timing;
+        scene_config.enable_pipeline_statistics = config.enable_pipeline_statistics;
+        scene_config.max_frames_in_flight       = max_frames_in_flight_;
+        scene_config.external_submit            = true;
+        scene_config.dynamic_resolution         = config.dynamic_resolution;
+
+        if (!scene_renderer_.initialize(device, scene_config))
+        {
+            logger::error("Failed to initialize SceneRenderer");
+            return false;
+        }
+
+        device_ = std::move(device);
+        frame_values_.assign(max_frames_in_flight_, 0); // Value 0 is always complete
+        current_frame_   = 0;
+        frames_rendered_ = 0;
+
+        initialized_ = true;
+        logger::info("HeadlessRenderer initialized: ", config.width, "x", config.height);
+        return true;
+    }
+
+    void HeadlessRenderer::shutdown()
+    {
+        if (!initialized_)
+        {
+            return;
+        }
+
+        logger::info("Shutting down HeadlessRenderer...");
+
+        if (!captures_.empty())
+        {
+            logger::warn("HeadlessRenderer: ", captures_.size(), " capture(s) dropped at shutdown");
+        }
+
+        scene_renderer_.shutdown();
+        captures_.clear();
+        frame_values_.clear();
+        device_.reset();
+
+        initialized_ = false;
+        logger::info("HeadlessRenderer shutdown complete");
+    }
+
+    // ============================================================================
+    // Render Loop
+    // ============================================================================
+
+    bool HeadlessRenderer::begin_frame()
+    {
+        PROFILE_SCOPE("HeadlessRenderer::begin_frame");
+
+        if (!initialized_)
+        {
+            return false;
+        }
+
+        // Paces the loop the way present would: at most max_frames_in_flight frames queued
+        vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+        if (!timeline->wait(frame_values_[current_frame_]))
+        {
+            logger::error("HeadlessRenderer: frame wait failed");
+            return false;
+        }
+
+        // No present loop here, so released resources are collected per frame
+        if (vulkan::DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            deletion_queue->collect(timeline->last_submitted(), timeline->completed_value());
+        }
+
+        // Completes readbacks recorded in this slot, which may write captures
+        frame_started_ = scene_renderer_.begin_frame(current_frame_);
+        retire_captures();
+        return frame_started_;
+    }
+
+    void HeadlessRenderer::render_scene(SceneRenderCallback callback)
+    {
+        PROFILE_SCOPE("HeadlessRenderer::render_scene");
+
+        if (!frame_started_)
+        {
+            return;
+        }
+
+        scene_renderer_.render(std::move(callback));
+    }
+
+    void HeadlessRenderer::end_frame()
+    {
+        PROFILE_SCOPE("HeadlessRenderer::end_frame");
+
+        if (!frame_started_)
+        {
+            return;
+        }
+
+        // Nothing recorded (e.g. a flush) leaves the slot's value as it was
+        VkCommandBuffer cmd = scene_renderer_.frame_command_buffer();
+        if (cmd != VK_NULL_HANDLE)
+        {
+            VkSubmitInfo submit_info{};
+            submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submit_info.commandBufferCount = 1;
+            submit_info.pCommandBuffers    = &cmd;
+
+            const uint64_t value = device_->graphics_timeline()->submit(&submit_info, 1);
+            if (value == 0)
+            {
+                logger::error("HeadlessRenderer: failed to submit scene commands");
+            }
+            else
+            {
+                frame_values_[current_frame_] = value;
+                ++frames_rendered_;
+            }
+        }
+
+        scene_renderer_.end_frame();
+        current_frame_ = (current_frame_ + 1) % max_frames_in_flight_;
+        frame_started_ = false;
+    }
+
+    bool HeadlessRenderer::flush()
+    {
+        // Visiting every slot once retires all recorded copies without rendering
+        for (uint32_t i = 0; i < max_frames_in_flight_ && !captures_.empty(); ++i)
+        {
+            if (!begin_frame())
+            {
+                return false;
+            }
+            end_frame();
+        }
+
+        if (!captures_.empty())
+        {
+            // Requested after the last rendered frame, so never recorded
+            logger::warn("HeadlessRenderer: flush left ", captures_.size(), " capture(s) unrecorded");
+            return false;
+        }
+        return true;
+    }
+
+    // ============================================================================
+    // Capture
+    // ============================================================================
+
+    bool HeadlessRenderer::capture(std::filesystem::path path)
+    {
+        if (!initialized_)
+        {
+            return false;
+        }
+
+        auto readback = scene_renderer_.request_readback({}, [this, path](const vulkan::memory::ReadbackTicket& ticket)
+        {
+            if (!write_capture(ticket, path))
+            {
+                ++failed_captures_;
+            }
+        });
+
+        if (!readback)
+        {
+            return false;
+        }
+
+        captures_.push_back(std::move(readback));
+        return true;
+    }
+
+    void HeadlessRenderer::retire_captures()
+    {
+        std::erase_if(captures_, [this](const vulkan::memory::ReadbackTicketPtr& ticket)
+        {
+            using State = vulkan::memory::ReadbackTicket::State;
+            if (ticket->state() == State::Failed)
+            {
+                logger::error("HeadlessRenderer: capture readback failed");
+                ++failed_captures_;
+            }
+            return ticket->state() != State::Pending;
+        });
+    }
+
+    bool HeadlessRenderer::write_capture(const vulkan::memory::ReadbackTicket& ticket, const std::filesystem::path& path)
+    {
+        const auto       data   = ticket.data();
+        const VkExtent2D extent = ticket.extent();
+        if (!ticket.ready() || data.empty() || ticket.texelSize() != 4)
+        {
+            logger::error("HeadlessRenderer: capture readback failed for " + path.string());
+            return false;
+        }
+
+        bool swap_red_blue = false;
+        switch (ticket.format())
+        {
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                swap_red_blue = true;
+                break;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                break;
+            default:
+                logger::error("HeadlessRenderer: capture format ", ticket.format(), " is not 8-bit RGBA");
+                return false;
+        }
+
+        // RGB8 with the alpha dropped: the scene clears to opaque, and image
+        // diffs should not depend on what a pass leaves in alpha
+        std::vector<uint8_t> pixels(static_cast<size_t>(extent.width) * extent.height * 3);
+        const auto*          src = reinterpret_cast<const uint8_t*>(data.data());
+        for (size_t i = 0, count = static_cast<size_t>(extent.width) * extent.height; i < count; ++i)
+        {
+            pixels[i * 3 + 0] = src[i * 4 + (swap_red_blue ? 2 : 0)];
+            pixels[i * 3 + 1] = src[i * 4 + 1];
+            pixels[i * 3 + 2] = src[i * 4 + (swap_red_blue ? 0 : 2)];
+        }
+
+        if (path.has_parent_path())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        const int row_stride = static_cast<int>(extent.width * 3);
+        if (!stbi_write_png(path.string().c_str(), static_cast<int>(extent.width), static_cast<int>(extent.height), 3, pixels.data(), row_stride))
+        {
+            logger::error("HeadlessRenderer: failed to write " + path.string());
+            return false;
+        }
+
+        logger::info("Captured ", extent.width, "x", extent.height, " frame to ", path.string());
+        return true;
+    }
+} // namespace vulkan_engine::rendering
@@ -7,8 +7,11 @@
 #include "engine/rhi/vulkan/resources/Framebuffer.hpp"
 #include "engine/rhi/vulkan/memory/VmaAllocator.hpp"
 #include "engine/rhi/vulkan/memory/VmaImage.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
 #include "engine/editor/Editor.hpp"
 
 #include <algorithm>
@@ -50,10 +53,12 @@ namespace vulkan_engine::rendering
         , gpu_frame_times_(std::move(other.gpu_frame_times_))
         , gpu_time_write_index_(other.gpu_time_write_index_)
         , gpu_render_time_ms_(other.gpu_render_time_ms_)
+        , gpu_time_sum_us_(other.gpu_time_sum_us_)
         , query_pools_initialized_(std::move(other.query_pools_initialized_))
         , current_frame_(other.current_frame_)
         , current_image_(other.current_image_)
         , frame_started_(other.frame_started_)
+        , scene_recorded_(other.scene_recorded_)
         , resize_pending_(other.resize_pending_)
         , pending_width_(other.pending_width_)
         , pending_height_(other.pending_height_)
@@ -88,10 +93,12 @@ namespace vulkan_engine::rendering
             gpu_frame_times_         = std::move(other.gpu_frame_times_);
             gpu_time_write_index_    = other.gpu_time_write_index_;
             gpu_render_time_ms_      = other.gpu_render_time_ms_;
+            gpu_time_sum_us_         = other.gpu_time_sum_us_;
             query_pools_initialized_ = std::move(other.query_pools_initialized_);
             current_frame_           = other.current_frame_;
             current_image_           = other.current_image_;
             frame_started_           = other.frame_started_;
+            scene_recorded_          = other.scene_recorded_;
             resize_pending_          = other.resize_pending_;
             pending_width_           = other.pending_width_;
             pending_height_          = other.pending_height_;
@@ -163,7 +170,7 @@ namespace vulkan_engine::rendering
                                                               device_,
                                                               swap_chain_->width(),
                                                               swap_chain_->height());
-        logger::info("Depth buffer created: " + std::to_string(swap_chain_->width()) + "x" + std::to_string(swap_chain_->height()));
+        logger::info("Depth buffer created: ", swap_chain_->width(), "x", swap_chain_->height());
         return true;
     }
 
@@ -178,7 +185,7 @@ namespace vulkan_engine::rendering
     {
         frame_sync_ = std::make_unique<vulkan::FrameSyncManager>(device_, config_.max_frames_in_flight);
         frame_sync_->resize_render_finished_semaphores(swap_chain_->image_count());
-        logger::info("FrameSyncManager created with " + std::to_string(config_.max_frames_in_flight) + " frames");
+        logger::info("FrameSyncManager created with ", config_.max_frames_in_flight, " frames");
         return true;
     }
 
@@ -235,7 +242,7 @@ namespace vulkan_engine::rendering
 
             if (vkCreateQueryPool(device_->device().handle(), &pool_info, nullptr, &query_pools_[i]) != VK_SUCCESS)
             {
-                logger::error("Failed to create query pool for frame " + std::to_string(i));
+                logger::error("Failed to create query pool for frame ", i);
                 return false;
             }
         }
@@ -268,15 +275,15 @@ namespace vulkan_engine::rendering
             submit_info.commandBufferCount = 1;
             submit_info.pCommandBuffers    = &init_cmd;
 
-            vkQueueSubmit(device_->graphics_queue().handle(), 1, &submit_info, VK_NULL_HANDLE);
-            vkQueueWaitIdle(device_->graphics_queue().handle());
+            vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+            timeline->wait(timeline->submit(&submit_info, 1));
 
             vkFreeCommandBuffers(device_->device().handle(), scene_cmd_pool_->handle(), 1, &init_cmd);
 
             std::fill(query_pools_initialized_.begin(), query_pools_initialized_.end(), true);
         }
 
-        logger::info("GPU query pools created: " + std::to_string(config_.max_frames_in_flight));
+        logger::info("GPU query pools created: ", config_.max_frames_in_flight);
         return true;
     }
 
@@ -303,7 +310,7 @@ namespace vulkan_engine::rendering
                                                  swap_chain_->height(),
                                                  depth_buffer_->view());
 
-        logger::info("Framebuffer pool initialized with " + std::to_string(swap_chain_->image_count()) + " framebuffers");
+        logger::info("Framebuffer pool initialized with ", swap_chain_->image_count(), " framebuffers");
         return true;
     }
 
@@ -328,7 +335,7 @@ namespace vulkan_engine::rendering
         // 鍒涘缓 Framebuffer
         render_target_->create_framebuffer(offscreen_pass);
 
-        logger::info("RenderTarget initialized: " + std::to_string(config_.width) + "x" + std::to_string(config_.height));
+        logger::info("RenderTarget initialized: ", config_.width, "x", config_.height);
         return true;
     }
 
@@ -412,13 +419,22 @@ namespace vulkan_engine::rendering
 
     bool Renderer::begin_frame()
     {
+        PROFILE_SCOPE("Renderer::begin_frame");
+
         if (!initialized_ || !frame_sync_ || !swap_chain_)
         {
             return false;
         }
 
         // 绛夊緟涓婁竴甯у畬鎴愶紙CPU-GPU 鍚屾锛?
-        frame_sync_->wait_and_reset_current_frame_fence();
+        frame_sync_->wait_for_current_frame();
+
+        // Whatever was deleted while work that is now complete was in flight can go
+        if (vulkan::DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+            deletion_queue->collect(timeline->last_submitted(), timeline->completed_value());
+        }
 
         // 鑾峰彇涓嬩竴甯?image
         bool acquired = swap_chain_->acquire_next_image(
@@ -431,8 +447,9 @@ namespace vulkan_engine::rendering
             return false;
         }
 
-        current_frame_ = frame_sync_->current_frame();
-        frame_started_ = true;
+        current_frame_  = frame_sync_->current_frame();
+        frame_started_  = true;
+        scene_recorded_ = false;
 
         // 鏇存柊 GPU 璁℃椂锛堣鍙栦笂涓€甯х粨鏋滐級
         if (config_.enable_gpu_timing && !query_pools_.empty())
@@ -451,7 +468,6 @@ namespace vulkan_engine::rendering
         }
 
         record_scene_commands(callback);
-        submit_scene_commands();
     }
 
     void Renderer::record_scene_commands(SceneRenderCallback callback)
@@ -469,6 +485,7 @@ namespace vulkan_engine::rendering
         // 閲嶇疆骞跺綍鍒跺懡浠ょ紦鍐?
         vkResetCommandBuffer(cmd_handle, 0);
         cmd.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        render_target_->record_pending_layouts(cmd_handle);
 
         // 鍐欏叆寮€濮嬫椂闂存埑
         if (!query_pools_.empty() && query_pools_[current_frame_] != VK_NULL_HANDLE)
@@ -548,25 +565,7 @@ namespace vulkan_engine::rendering
         }
 
         cmd.end();
-    }
-
-    void Renderer::submit_scene_commands()
-    {
-        auto& cmd = scene_cmd_buffers_[current_frame_];
-
-        // 鎻愪氦鍦烘櫙娓叉煋锛屼俊鍙?scene_finished semaphore
-        VkSemaphore signal_semaphores[] = {frame_sync_->get_current_scene_finished_semaphore().handle()};
-
-        VkSubmitInfo submit_info{};
-        submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.commandBufferCount   = 1;
-        VkCommandBuffer cmd_handle       = cmd.handle();
-        submit_info.pCommandBuffers      = &cmd_handle;
-        submit_info.signalSemaphoreCount = 1;
-        submit_info.pSignalSemaphores    = signal_semaphores;
-
-        // 鍦烘櫙鎻愪氦涓嶉渶瑕?fence锛孖mGui 鎻愪氦浼氫娇鐢?frame_fence
-        vkQueueSubmit(device_->graphics_queue().handle(), 1, &submit_info, VK_NULL_HANDLE);
+        scene_recorded_ = true;
     }
 
     void Renderer::render_ui(editor::Editor& editor)
@@ -578,7 +577,7 @@ namespace vulkan_engine::rendering
 
         // 浣跨敤 Dynamic Rendering 娓叉煋 UI 鍒?SwapChain
         record_ui_commands_dynamic(editor);
-        submit_ui_commands_dynamic();
+        submit_frame();
     }
 
     void Renderer::record_ui_commands_dynamic(editor::Editor& editor)
@@ -662,26 +661,34 @@ namespace vulkan_engine::rendering
         cmd.end();
     }
 
-    void Renderer::submit_ui_commands_dynamic()
+    void Renderer::submit_frame()
     {
         auto& cmd = ui_cmd_buffers_[current_frame_];
 
-        // 绛夊緟锛?) swap chain image 鍙敤, 2) 鍦烘櫙娓叉煋瀹屾垚
-        VkSemaphore wait_semaphores[] = {
-            frame_sync_->get_current_acquire_semaphore().handle(),
-            frame_sync_->get_current_scene_finished_semaphore().handle()
-        };
-        VkPipelineStageFlags wait_stages[] = {
-            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
-        };
-
-        // 淇″彿锛歳ender finished锛坧er-image锛?
+        // Scene and UI go out in one vkQueueSubmit under one timeline value. The scene
+        // batch does not wait for the swap chain image; the barrier that ends it
+        // (SHADER_READ_ONLY_OPTIMAL) orders it before the UI batch that samples it.
+        VkSubmitInfo submit_infos[2]{};
+        uint32_t     submit_count = 0;
+
+        VkCommandBuffer scene_handle = scene_cmd_buffers_[current_frame_].handle();
+        if (scene_recorded_)
+        {
+            VkSubmitInfo& scene_info      = submit_infos[submit_count++];
+            scene_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            scene_info.commandBufferCount = 1;
+            scene_info.pCommandBuffers    = &scene_handle;
+        }
+
+        VkSemaphore          wait_semaphores[] = {frame_sync_->get_current_acquire_semaphore().handle()};
+        VkPipelineStageFlags wait_stages[]     = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+
+        // Per-image render finished semaphore for present
         VkSemaphore signal_semaphores[] = {frame_sync_->get_render_finished_semaphore(current_image_).handle()};
 
-        VkSubmitInfo submit_info{};
+        VkSubmitInfo& submit_info        = submit_infos[submit_count++];
         submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.waitSemaphoreCount   = 2;
+        submit_info.waitSemaphoreCount   = 1;
         submit_info.pWaitSemaphores      = wait_semaphores;
         submit_info.pWaitDstStageMask    = wait_stages;
         submit_info.commandBufferCount   = 1;
@@ -690,13 +697,13 @@ namespace vulkan_engine::rendering
         submit_info.signalSemaphoreCount = 1;
         submit_info.pSignalSemaphores    = signal_semaphores;
 
-        // 浣跨敤 frame fence
-        VkFence frame_fence = frame_sync_->get_current_frame_fence().handle();
-        vkQueueSubmit(device_->graphics_queue().handle(), 1, &submit_info, frame_fence);
+        frame_sync_->set_current_frame_value(device_->graphics_timeline()->submit(submit_infos, submit_count));
     }
 
     void Renderer::end_frame()
     {
+        PROFILE_SCOPE("Renderer::end_frame");
+
         if (!frame_started_)
         {
             return;
@@ -750,7 +757,7 @@ namespace vulkan_engine::rendering
         config_.width  = width;
         config_.height = height;
 
-        logger::info("Renderer resize marked as pending: " + std::to_string(width) + "x" + std::to_string(height));
+        logger::info("Renderer resize marked as pending: ", width, "x", height);
     }
 
     VkRenderPass Renderer::get_offscreen_render_pass() const
@@ -782,22 +789,21 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        resize_pending_ = false;
-
-        // 绛夊緟 GPU 瀹屾垚
-        vkDeviceWaitIdle(device_->device().handle());
-
         // 閲嶅缓 swap chain
+        // No device wait: the old swap chain, depth buffer and framebuffers go
+        // through the deletion queue while the frames that use them drain
         if (!swap_chain_->recreate())
         {
-            logger::error("Failed to recreate swap chain");
+            // Minimized; stay pending until the window has a size again
+            logger::warn("Swap chain not recreated during resize");
             return;
         }
+        resize_pending_ = false;
 
         // 閲嶅缓鐩稿叧璧勬簮
         recreate_swap_chain_resources();
 
-        logger::info("Renderer resize applied: " + std::to_string(pending_width_) + "x" + std::to_string(pending_height_));
+        logger::info("Renderer resize applied: ", pending_width_, "x", pending_height_);
     }
 
     void Renderer::recreate_swap_chain_resources()
@@ -831,9 +837,8 @@ namespace vulkan_engine::rendering
                                                  swap_chain_->height(),
                                                  depth_buffer_->view());
 
-        // 閲嶅缓鍚屾瀵硅薄
-        frame_sync_.reset();
-        frame_sync_ = std::make_unique<vulkan::FrameSyncManager>(device_, config_.max_frames_in_flight);
+        // Frame sync objects are kept: presents still queued on the old swap chain
+        // wait on the render_finished semaphores, which only ever grow
         frame_sync_->resize_render_finished_semaphores(swap_chain_->image_count());
 
         // 閲嶅缓 RenderTarget
@@ -895,24 +900,17 @@ namespace vulkan_engine::rendering
         if (result == VK_SUCCESS && timestamps[1] > timestamps[0])
         {
             // 璁＄畻 GPU 鏃堕棿
-            VkPhysicalDeviceProperties props;
-            vkGetPhysicalDeviceProperties(device_->physical_device().handle(), &props);
-            float timestamp_period = props.limits.timestampPeriod; // nanoseconds per tick
+            float timestamp_period = device_->properties().limits.timestampPeriod; // nanoseconds per tick, cached by the device
 
             uint64_t gpu_time_ns = static_cast<uint64_t>((timestamps[1] - timestamps[0]) * timestamp_period);
             float    gpu_time_us = static_cast<float>(gpu_time_ns) / 1000.0f;
 
-            // 瀛樺叆鐜舰缂撳啿鍖?
-            gpu_frame_times_[gpu_time_write_index_] = gpu_time_us;
-            gpu_time_write_index_                   = (gpu_time_write_index_ + 1) % GPU_TIME_HISTORY_SIZE;
+            // Replace the oldest sample and keep the sum current instead of re-adding the ring
+            gpu_time_sum_us_                        += gpu_time_us - gpu_frame_times_[gpu_time_write_index_];
+            gpu_frame_times_[gpu_time_write_index_]  = gpu_time_us;
+            gpu_time_write_index_                    = (gpu_time_write_index_ + 1) % GPU_TIME_HISTORY_SIZE;
 
-            // 璁＄畻骞虫粦骞冲潎鍊?
-            float sum = 0.0f;
-            for (float t : gpu_frame_times_)
-            {
-                sum += t;
-            }
-            gpu_render_time_ms_ = (sum / GPU_TIME_HISTORY_SIZE) / 1000.0f; // 杞崲涓烘绉?
+            gpu_render_time_ms_ = (gpu_time_sum_us_ / GPU_TIME_HISTORY_SIZE) / 1000.0f;
         }
     }
 } // namespace vulkan_engine::rendering
@@ -1,10 +1,14 @@
 #include "engine/rendering/SceneRenderer.hpp"
 #include "engine/rendering/Viewport.hpp"
+#include "engine/rendering/resources/Mesh.hpp"
 #include "engine/rhi/vulkan/device/Device.hpp"
 #include "engine/rhi/vulkan/pipelines/RenderPassManager.hpp"
 #include "engine/rhi/vulkan/memory/VmaAllocator.hpp"
 #include "engine/rhi/vulkan/memory/VmaImage.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
 
 #include <algorithm>
 
@@ -37,19 +41,24 @@ namespace vulkan_engine::rendering
         , frame_syncs_(std::move(other.frame_syncs_))
         , command_pool_(std::move(other.command_pool_))
         , command_buffers_(std::move(other.command_buffers_))
-        , query_pools_(std::move(other.query_pools_))
-        , gpu_frame_times_(std::move(other.gpu_frame_times_))
-        , gpu_time_write_index_(other.gpu_time_write_index_)
-        , gpu_render_time_ms_(other.gpu_render_time_ms_)
-        , query_pools_initialized_(std::move(other.query_pools_initialized_))
+        , gpu_profiler_(std::move(other.gpu_profiler_))
+        , dynamic_resolution_(std::move(other.dynamic_resolution_))
+        , last_resolved_frame_(other.last_resolved_frame_)
+        , frame_arena_(std::move(other.frame_arena_))
+        , geometry_buffer_(std::move(other.geometry_buffer_))
+        , readback_queue_(std::move(other.readback_queue_))
+        , pending_readbacks_(std::move(other.pending_readbacks_))
         , current_frame_(other.current_frame_)
+        , frame_number_(other.frame_number_)
         , frame_started_(other.frame_started_)
+        , frame_recorded_(other.frame_recorded_)
         , resize_pending_(other.resize_pending_)
         , pending_width_(other.pending_width_)
         , pending_height_(other.pending_height_)
     {
-        other.initialized_   = false;
-        other.frame_started_ = false;
+        other.initialized_    = false;
+        other.frame_started_  = false;
+        other.frame_recorded_ = false;
     }
 
     SceneRenderer& SceneRenderer::operator=(SceneRenderer&& other) noexcept
@@ -58,31 +67,36 @@ namespace vulkan_engine::rendering
         {
             shutdown();
 
-            config_                  = std::move(other.config_);
-            initialized_             = other.initialized_;
-            paused_                  = other.paused_;
-            device_                  = std::move(other.device_);
-            vma_allocator_           = std::move(other.vma_allocator_);
-            render_graph_            = std::move(other.render_graph_);
-            render_target_           = std::move(other.render_target_);
-            viewport_                = std::move(other.viewport_);
-            render_pass_manager_     = std::move(other.render_pass_manager_);
-            frame_syncs_             = std::move(other.frame_syncs_);
-            command_pool_            = std::move(other.command_pool_);
-            command_buffers_         = std::move(other.command_buffers_);
-            query_pools_             = std::move(other.query_pools_);
-            gpu_frame_times_         = std::move(other.gpu_frame_times_);
-            gpu_time_write_index_    = other.gpu_time_write_index_;
-            gpu_render_time_ms_      = other.gpu_render_time_ms_;
-            query_pools_initialized_ = std::move(other.query_pools_initialized_);
-            current_frame_           = other.current_frame_;
-            frame_started_           = other.frame_started_;
-            resize_pending_          = other.resize_pending_;
-            pending_width_           = other.pending_width_;
-            pending_height_          = other.pending_height_;
-
-            other.initialized_   = false;
-            other.frame_started_ = false;
+            config_              = std::move(other.config_);
+            initialized_         = other.initialized_;
+            paused_              = other.paused_;
+            device_              = std::move(other.device_);
+            vma_allocator_       = std::move(other.vma_allocator_);
+            render_graph_        = std::move(other.render_graph_);
+            render_target_       = std::move(other.render_target_);
+            viewport_            = std::move(other.viewport_);
+            render_pass_manager_ = std::move(other.render_pass_manager_);
+            frame_syncs_         = std::move(other.frame_syncs_);
+            command_pool_        = std::move(other.command_pool_);
+            command_buffers_     = std::move(other.command_buffers_);
+            gpu_profiler_        = std::move(other.gpu_profiler_);
+            dynamic_resolution_  = std::move(other.dynamic_resolution_);
+            last_resolved_frame_ = other.last_resolved_frame_;
+            frame_arena_         = std::move(other.frame_arena_);
+            geometry_buffer_     = std::move(other.geometry_buffer_);
+            readback_queue_      = std::move(other.readback_queue_);
+            pending_readbacks_   = std::move(other.pending_readbacks_);
+            current_frame_       = other.current_frame_;
+            frame_number_        = other.frame_number_;
+            frame_started_       = other.frame_started_;
+            frame_recorded_      = other.frame_recorded_;
+            resize_pending_      = other.resize_pending_;
+            pending_width_       = other.pending_width_;
+            pending_height_      = other.pending_height_;
+
+            other.initialized_    = false;
+            other.frame_started_  = false;
+            other.frame_recorded_ = false;
         }
         return *this;
     }
@@ -118,9 +132,11 @@ namespace vulkan_engine::rendering
         if (!initialize_command_pool()) return false;
         if (!initialize_render_target()) return false;
         if (!initialize_viewport()) return false;
-        if (!initialize_query_pools()) return false;
+        if (!initialize_gpu_profiler()) return false;
+        if (!initialize_frame_allocators()) return false;
 
         render_graph_.initialize(device_);
+        dynamic_resolution_.set_config(config_.dynamic_resolution);
 
         initialized_ = true;
         logger::info("SceneRenderer initialized successfully");
@@ -136,6 +152,29 @@ namespace vulkan_engine::rendering
         return true;
     }
 
+    bool SceneRenderer::initialize_frame_allocators()
+    {
+        frame_arena_ = std::make_unique<core::LinearArena>(config_.frame_arena_size);
+
+        // Readback and geometry buffers come from the application's pools
+        if (auto resource_manager = device_->resource_manager())
+        {
+            vulkan::memory::ReadbackQueue::Config readback_config;
+            readback_config.framesInFlight = config_.max_frames_in_flight;
+            readback_queue_                = std::make_unique<vulkan::memory::ReadbackQueue>(resource_manager, readback_config);
+
+            GeometryBuffer::Config geometry_config;
+            geometry_config.vertex_stride    = sizeof(MeshVertex);
+            geometry_config.vertex_capacity  = config_.geometry_vertex_capacity;
+            geometry_config.index_capacity   = config_.geometry_index_capacity;
+            geometry_config.frames_in_flight = config_.max_frames_in_flight;
+            geometry_buffer_                 = std::make_shared<GeometryBuffer>(device_, geometry_config);
+        }
+
+        logger::info("Frame allocators created: ", config_.frame_arena_size / 1024, " KB frame arena");
+        return true;
+    }
+
     bool SceneRenderer::initialize_render_pass_manager()
     {
         render_pass_manager_ = std::make_unique<vulkan::RenderPassManager>(device_);
@@ -145,15 +184,21 @@ namespace vulkan_engine::rendering
 
     bool SceneRenderer::initialize_frame_sync()
     {
+        if (config_.external_submit)
+        {
+            logger::info("Scene frames are synchronised and submitted by the owner");
+            return true;
+        }
+
         frame_syncs_.resize(config_.max_frames_in_flight);
 
         for (uint32_t i = 0; i < config_.max_frames_in_flight; ++i)
         {
-            frame_syncs_[i].in_flight_fence          = std::make_unique<vulkan::Fence>(device_, true); // signaled
+            frame_syncs_[i].submitted_value          = 0; // Always complete
             frame_syncs_[i].scene_finished_semaphore = std::make_unique<vulkan::Semaphore>(device_);
         }
 
-        logger::info("Frame sync objects created: " + std::to_string(config_.max_frames_in_flight));
+        logger::info("Frame sync objects created: ", config_.max_frames_in_flight);
         return true;
     }
 
@@ -171,7 +216,7 @@ namespace vulkan_engine::rendering
         return true;
     }
 
-    bool SceneRenderer::initialize_query_pools()
+    bool SceneRenderer::initialize_gpu_profiler()
     {
         if (!config_.enable_gpu_timing)
         {
@@ -179,69 +224,19 @@ namespace vulkan_engine::rendering
             return true;
         }
 
-        VkPhysicalDeviceProperties props;
-        vkGetPhysicalDeviceProperties(device_->physical_device().handle(), &props);
-        if (props.limits.timestampComputeAndGraphics == VK_FALSE)
-        {
-            logger::warn("GPU timestamp queries not supported");
-            return true;
-        }
-
-        query_pools_.resize(config_.max_frames_in_flight);
-        query_pools_initialized_.resize(config_.max_frames_in_flight, false);
-        gpu_frame_times_.resize(GPU_TIME_HISTORY_SIZE, 0.0f);
-
-        for (uint32_t i = 0; i < config_.max_frames_in_flight; ++i)
-        {
-            VkQueryPoolCreateInfo pool_info{};
-            pool_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
-            pool_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
-            pool_info.queryCount = 2;
+        vulkan::GpuProfiler::Config profiler_config;
+        profiler_config.frame_count         = config_.max_frames_in_flight;
+        profiler_config.pipeline_statistics = config_.enable_pipeline_statistics;
 
-            if (vkCreateQueryPool(device_->device().handle(), &pool_info, nullptr, &query_pools_[i]) != VK_SUCCESS)
-            {
-                logger::error("Failed to create query pool for frame " + std::to_string(i));
-                return false;
-            }
-        }
-
-        // 鍒濆鍖栨煡璇㈡睜
+        gpu_profiler_ = std::make_unique<vulkan::GpuProfiler>(device_, profiler_config);
+        if (!gpu_profiler_->is_supported())
         {
-            VkCommandBufferAllocateInfo alloc_info{};
-            alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            alloc_info.commandPool        = command_pool_->handle();
-            alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-            alloc_info.commandBufferCount = 1;
-
-            VkCommandBuffer init_cmd = VK_NULL_HANDLE;
-            vkAllocateCommandBuffers(device_->device().handle(), &alloc_info, &init_cmd);
-
-            VkCommandBufferBeginInfo begin_info{};
-            begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-            begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-            vkBeginCommandBuffer(init_cmd, &begin_info);
-
-            for (size_t i = 0; i < query_pools_.size(); ++i)
-            {
-                vkCmdResetQueryPool(init_cmd, query_pools_[i], 0, 2);
-            }
-
-            vkEndCommandBuffer(init_cmd);
-
-            VkSubmitInfo submit_info{};
-            submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submit_info.commandBufferCount = 1;
-            submit_info.pCommandBuffers    = &init_cmd;
-
-            vkQueueSubmit(device_->graphics_queue().handle(), 1, &submit_info, VK_NULL_HANDLE);
-            vkQueueWaitIdle(device_->graphics_queue().handle());
-
-            vkFreeCommandBuffers(device_->device().handle(), command_pool_->handle(), 1, &init_cmd);
-
-            std::fill(query_pools_initialized_.begin(), query_pools_initialized_.end(), true);
+            // Not fatal, the scene just renders without timings
+            gpu_profiler_.reset();
+            return true;
         }
 
-        logger::info("GPU query pools created");
+        logger::info("GPU profiler initialized");
         return true;
     }
 
@@ -264,7 +259,7 @@ namespace vulkan_engine::rendering
 
         render_target_->create_framebuffer(offscreen_pass);
 
-        logger::info("RenderTarget initialized: " + std::to_string(config_.width) + "x" + std::to_string(config_.height));
+        logger::info("RenderTarget initialized: ", config_.width, "x", config_.height);
         return true;
     }
 
@@ -295,11 +290,26 @@ namespace vulkan_engine::rendering
     void SceneRenderer::cleanup_resources()
     {
         render_graph_.reset();
-        destroy_query_pools();
+        gpu_profiler_.reset();
 
         viewport_.reset();
         render_target_.reset();
 
+        frame_arena_.reset();
+
+        // Meshes still holding slices keep the buffers alive
+        geometry_buffer_.reset();
+
+        if (readback_queue_)
+        {
+            for (auto& pending : pending_readbacks_)
+            {
+                readback_queue_->cancel(pending.ticket);
+            }
+            readback_queue_.reset();
+        }
+        pending_readbacks_.clear();
+
         command_buffers_.clear();
         command_pool_.reset();
 
@@ -309,49 +319,72 @@ namespace vulkan_engine::rendering
         vma_allocator_.reset();
     }
 
-    void SceneRenderer::destroy_query_pools()
-    {
-        for (auto& pool : query_pools_)
-        {
-            if (pool != VK_NULL_HANDLE)
-            {
-                vkDestroyQueryPool(device_->device().handle(), pool, nullptr);
-                pool = VK_NULL_HANDLE;
-            }
-        }
-        query_pools_.clear();
-        query_pools_initialized_.clear();
-    }
-
     // ============================================================================
     // Render Loop
     // ============================================================================
 
     bool SceneRenderer::begin_frame()
     {
+        PROFILE_SCOPE("SceneRenderer::begin_frame");
+
         if (!initialized_ || paused_)
         {
             return false;
         }
 
+        if (config_.external_submit)
+        {
+            logger::error("SceneRenderer: external_submit frames must be started with begin_frame(frame_index)");
+            return false;
+        }
+
         // 绛夊緟涓婁竴甯у畬鎴?
-        auto& sync = frame_syncs_[current_frame_];
-        sync.in_flight_fence->wait();
-        sync.in_flight_fence->reset();
+        device_->graphics_timeline()->wait(frame_syncs_[current_frame_].submitted_value);
 
-        // Explicitly reset command buffer after fence wait to ensure it's not in use
-        if (current_frame_ < command_buffers_.size())
+        return begin_frame_slot();
+    }
+
+    bool SceneRenderer::begin_frame(uint32_t frame_index)
+    {
+        PROFILE_SCOPE("SceneRenderer::begin_frame");
+
+        if (!initialized_ || paused_)
         {
-            vkResetCommandBuffer(command_buffers_[current_frame_].handle(), 0);
+            return false;
+        }
+
+        if (!config_.external_submit)
+        {
+            logger::error("SceneRenderer: begin_frame(frame_index) requires external_submit");
+            return false;
+        }
+
+        // Follow the owner's slot so a paused scene cannot drift out of step with its timeline values
+        current_frame_ = frame_index % config_.max_frames_in_flight;
+        return begin_frame_slot();
+    }
+
+    bool SceneRenderer::begin_frame_slot()
+    {
+        // The GPU is done with this slot and the last frame's scratch data is dead
+        frame_arena_->reset();
+        if (geometry_buffer_)
+        {
+            geometry_buffer_->begin_frame();
+        }
+        if (readback_queue_)
+        {
+            readback_queue_->beginFrame(current_frame_);
         }
 
-        // 鏇存柊 GPU 璁℃椂
-        if (config_.enable_gpu_timing && !query_pools_.empty())
+        // Explicitly reset command buffer after the timeline wait to ensure it's not in use
+        if (current_frame_ < command_buffers_.size())
         {
-            update_gpu_timing();
+            vkResetCommandBuffer(command_buffers_[current_frame_].handle(), 0);
         }
 
-        frame_started_ = true;
+        frame_started_  = true;
+        frame_recorded_ = false;
         return true;
     }
 
@@ -363,11 +396,16 @@ namespace vulkan_engine::rendering
         }
 
         record_commands(callback);
-        submit_commands();
+        if (!config_.external_submit)
+        {
+            submit_commands();
+        }
     }
 
     void SceneRenderer::record_commands(SceneRenderCallback callback)
     {
+        PROFILE_SCOPE("SceneRenderer::record_commands");
+
         auto&           cmd        = command_buffers_[current_frame_];
         VkCommandBuffer cmd_handle = cmd.handle();
 
@@ -380,12 +418,23 @@ namespace vulkan_engine::rendering
         vkResetCommandBuffer(cmd_handle, 0);
         cmd.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
-        // 鍐欏叆寮€濮嬫椂闂存埑
-        if (!query_pools_.empty() && query_pools_[current_frame_] != VK_NULL_HANDLE)
+        // Advances VMA's frame index and drives incremental defragmentation; its copies
+        // land ahead of this frame's draws, which already see the relocated handles
+        if (auto resource_manager = device_->resource_manager())
+        {
+            resource_manager->beginFrame(cmd_handle, ++frame_number_);
+        }
+
+        render_target_->record_pending_layouts(cmd_handle);
+
+        // Resolves this slot's timings from max_frames_in_flight frames ago (the
+        // timeline value was waited on in begin_frame) and resets its queries
+        if (gpu_profiler_)
         {
-            vkCmdResetQueryPool(cmd_handle, query_pools_[current_frame_], 0, 2);
-            vkCmdWriteTimestamp(cmd_handle, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_pools_[current_frame_], 0);
+            gpu_profiler_->begin_frame(cmd_handle, current_frame_);
+            gpu_profiler_->begin_scope(cmd_handle, "Scene");
         }
+        update_render_extent();
 
         // Dynamic Rendering
         VkImageView color_view = render_target_->color_image_view();
@@ -430,21 +479,27 @@ namespace vulkan_engine::rendering
             VkClearValue depth_clear{};
             depth_clear.depthStencil = {1.0f, 0};
 
+            // Only the scaled region is rendered; passes size their viewport and
+            // scissor from ctx, and the UI samples the same region
+            const VkExtent2D render_extent = render_target_->render_extent();
             cmd.begin_dynamic_rendering(
                                         color_view,
                                         depth_view,
-                                        render_target_->width(),
-                                        render_target_->height(),
+                                        render_extent.width,
+                                        render_extent.height,
                                         &color_clear,
                                         &depth_clear);
 
             FrameContext ctx{};
             ctx.frame_index  = current_frame_;
-            ctx.width        = render_target_->width();
-            ctx.height       = render_target_->height();
+            ctx.width        = render_extent.width;
+            ctx.height       = render_extent.height;
             ctx.delta_time   = 0.0f;
             ctx.elapsed_time = 0.0f;
 
+            ctx.frame_arena  = frame_arena_.get();
+            ctx.gpu_profiler = gpu_profiler_.get();
+
             callback(cmd, ctx);
 
             cmd.end_dynamic_rendering();
@@ -481,13 +536,65 @@ namespace vulkan_engine::rendering
                                  &barrier);
         }
 
-        // 鍐欏叆缁撴潫鏃堕棿鎴?
-        if (!query_pools_.empty() && query_pools_[current_frame_] != VK_NULL_HANDLE)
+        // Outside the render pass, with the color image already in SHADER_READ_ONLY_OPTIMAL
+        record_readbacks(cmd_handle);
+
+        if (gpu_profiler_)
         {
-            vkCmdWriteTimestamp(cmd_handle, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pools_[current_frame_], 1);
+            gpu_profiler_->end_scope(cmd_handle);
         }
 
         cmd.end();
+        frame_recorded_ = true;
+    }
+
+    void SceneRenderer::record_readbacks(VkCommandBuffer cmd)
+    {
+        if (!readback_queue_ || pending_readbacks_.empty() || !render_target_ || !render_target_->color_image())
+        {
+            return;
+        }
+
+        for (auto& pending : pending_readbacks_)
+        {
+            vulkan::memory::ReadbackQueue::ImageRegion region;
+            region.image     = render_target_->color_image()->handle();
+            region.format    = render_target_->color_format();
+            region.layout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            region.imageSize = render_target_->render_extent(); // Only this part holds the frame
+            region.offset    = pending.region.offset;
+            region.extent    = pending.region.extent;
+
+            readback_queue_->recordImage(cmd, region, pending.ticket);
+        }
+        pending_readbacks_.clear();
+    }
+
+    void SceneRenderer::update_render_extent()
+    {
+        // begin_frame() above resolved a frame only if the counter moved; the
+        // sample describes the size rendered max_frames_in_flight frames ago
+        if (gpu_profiler_ && gpu_profiler_->resolved_frames() != last_resolved_frame_)
+        {
+            last_resolved_frame_ = gpu_profiler_->resolved_frames();
+            dynamic_resolution_.update(gpu_profiler_->root_ms());
+        }
+
+        const VkExtent2D extent = dynamic_resolution_.scaled_extent(render_target_->extent());
+        render_target_->set_render_extent(extent.width, extent.height);
+    }
+
+    vulkan::memory::ReadbackTicketPtr SceneRenderer::request_readback(VkRect2D region, vulkan::memory::ReadbackTicket::Callback on_ready)
+    {
+        if (!readback_queue_)
+        {
+            logger::warn("SceneRenderer: readback requested but no ResourceManager is registered");
+            return nullptr;
+        }
+
+        auto ticket = std::make_shared<vulkan::memory::ReadbackTicket>(std::move(on_ready));
+        pending_readbacks_.push_back({region, ticket});
+        return ticket;
     }
 
     void SceneRenderer::submit_commands()
@@ -497,26 +604,30 @@ namespace vulkan_engine::rendering
 
         VkSemaphore signal_semaphores[] = {sync.scene_finished_semaphore->handle()};
 
+        // An empty submission when recording was skipped still signals the timeline and semaphore
         VkSubmitInfo submit_info{};
         submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.commandBufferCount   = 1;
+        submit_info.commandBufferCount   = frame_recorded_ ? 1 : 0;
         VkCommandBuffer cmd_handle       = cmd.handle();
         submit_info.pCommandBuffers      = &cmd_handle;
         submit_info.signalSemaphoreCount = 1;
         submit_info.pSignalSemaphores    = signal_semaphores;
 
-        vkQueueSubmit(device_->graphics_queue().handle(), 1, &submit_info, sync.in_flight_fence->handle());
+        sync.submitted_value = device_->graphics_timeline()->submit(&submit_info, 1);
     }
 
     void SceneRenderer::end_frame()
     {
+        PROFILE_SCOPE("SceneRenderer::end_frame");
+
         if (!frame_started_)
         {
             return;
         }
 
-        current_frame_ = (current_frame_ + 1) % config_.max_frames_in_flight;
-        frame_started_ = false;
+        current_frame_  = (current_frame_ + 1) % config_.max_frames_in_flight;
+        frame_started_  = false;
+        frame_recorded_ = false;
 
         if (resize_pending_)
         {
@@ -524,52 +635,6 @@ namespace vulkan_engine::rendering
         }
     }
 
-    // ============================================================================
-    // GPU Timing
-    // ============================================================================
-
-    void SceneRenderer::update_gpu_timing()
-    {
-        if (query_pools_.empty() || current_frame_ >= query_pools_.size())
-            return;
-
-        uint32_t prev_frame = (current_frame_ + config_.max_frames_in_flight - 1) % config_.max_frames_in_flight;
-
-        if (!query_pools_initialized_[prev_frame])
-            return;
-
-        uint64_t timestamps[2];
-        VkResult result = vkGetQueryPoolResults(
-                                                device_->device().handle(),
-                                                query_pools_[prev_frame],
-                                                0,
-                                                2,
-                                                sizeof(timestamps),
-                                                timestamps,
-                                                sizeof(uint64_t),
-                                                VK_QUERY_RESULT_64_BIT);
-
-        if (result == VK_SUCCESS)
-        {
-            VkPhysicalDeviceProperties props;
-            vkGetPhysicalDeviceProperties(device_->physical_device().handle(), &props);
-            float timestamp_period = props.limits.timestampPeriod;
-
-            float frame_time_ns = static_cast<float>(timestamps[1] - timestamps[0]) * timestamp_period;
-            float frame_time_ms = frame_time_ns / 1000000.0f;
-
-            gpu_frame_times_[gpu_time_write_index_] = frame_time_ms;
-            gpu_time_write_index_                   = (gpu_time_write_index_ + 1) % GPU_TIME_HISTORY_SIZE;
-
-            float total_time = 0.0f;
-            for (float time : gpu_frame_times_)
-            {
-                total_time += time;
-            }
-            gpu_render_time_ms_ = total_time / GPU_TIME_HISTORY_SIZE;
-        }
-    }
-
     // ============================================================================
     // Resize
     // ============================================================================
@@ -588,7 +653,7 @@ namespace vulkan_engine::rendering
         config_.width  = width;
         config_.height = height;
 
-        logger::info("SceneRenderer resize pending: " + std::to_string(width) + "x" + std::to_string(height));
+        logger::info("SceneRenderer resize pending: ", width, "x", height);
     }
 
     void SceneRenderer::apply_pending_resize()
@@ -598,10 +663,10 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        logger::info("Applying SceneRenderer resize: " + std::to_string(pending_width_) + "x" + std::to_string(pending_height_));
-
-        vkDeviceWaitIdle(device_->device().handle());
+        logger::info("Applying SceneRenderer resize: ", pending_width_, "x", pending_height_);
 
+        // No device wait: frames still in flight keep the old attachments alive
+        // through the deletion queue
         recreate_render_target();
 
         if (viewport_)
@@ -653,6 +718,15 @@ namespace vulkan_engine::rendering
         return VK_NULL_HANDLE;
     }
 
+    VkCommandBuffer SceneRenderer::frame_command_buffer() const
+    {
+        if (frame_started_ && frame_recorded_ && current_frame_ < command_buffers_.size())
+        {
+            return command_buffers_[current_frame_].handle();
+        }
+        return VK_NULL_HANDLE;
+    }
+
     void SceneRenderer::compile_render_graph()
     {
         render_graph_.compile();
@@ -5,6 +5,8 @@
 #include "engine/rhi/vulkan/device/SwapChain.hpp"
 #include "engine/rhi/vulkan/pipelines/RenderPassManager.hpp"
 #include "engine/rhi/vulkan/resources/Framebuffer.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/platform/windowing/Window.hpp"
 #include "engine/core/utils/Logger.hpp"
 
@@ -156,7 +158,7 @@ namespace vulkan_engine::rendering
                                                  swap_chain_->height(),
                                                  VK_NULL_HANDLE); // No depth for UI
 
-        logger::info("UI Framebuffer pool initialized with " + std::to_string(swap_chain_->image_count()) + " framebuffers");
+        logger::info("UI Framebuffer pool initialized with ", swap_chain_->image_count(), " framebuffers");
         return true;
     }
 
@@ -166,7 +168,7 @@ namespace vulkan_engine::rendering
 
         for (uint32_t i = 0; i < config_.max_frames_in_flight; ++i)
         {
-            frame_syncs_[i].in_flight_fence           = std::make_unique<vulkan::Fence>(device_, true); // signaled
+            frame_syncs_[i].submitted_value           = 0; // Always complete
             frame_syncs_[i].image_available_semaphore = std::make_unique<vulkan::Semaphore>(device_);
         }
 
@@ -178,8 +180,7 @@ namespace vulkan_engine::rendering
             render_finished_semaphores_[i] = std::make_unique<vulkan::Semaphore>(device_);
         }
 
-        logger::info("UI Frame sync objects created: " + std::to_string(config_.max_frames_in_flight) +
-                     " frames, " + std::to_string(image_count) + " images");
+        logger::info("UI Frame sync objects created: ", config_.max_frames_in_flight, " frames, ", image_count, " images");
         return true;
     }
 
@@ -260,8 +261,15 @@ namespace vulkan_engine::rendering
         auto& sync = frame_syncs_[current_frame_];
 
         // 绛夊緟涓婁竴甯у畬鎴?
-        sync.in_flight_fence->wait();
-        sync.in_flight_fence->reset();
+        vulkan::QueueTimeline& timeline = *device_->graphics_timeline();
+        timeline.wait(sync.submitted_value);
+
+        // The frame's submission carries the scene batch too, so its timeline value
+        // covers the whole frame
+        if (vulkan::DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            deletion_queue->collect(timeline.last_submitted(), timeline.completed_value());
+        }
 
         // Additional safety: ensure command buffer is not in use by resetting it
         // This is a no-op if the command buffer is already reset, but ensures clean state
@@ -285,7 +293,11 @@ namespace vulkan_engine::rendering
         return true;
     }
 
-    void UIRenderer::render(editor::Editor& editor, std::shared_ptr<RenderTarget> scene_render_target, VkSemaphore scene_finished_semaphore)
+    void UIRenderer::render(
+        editor::Editor&               editor,
+        std::shared_ptr<RenderTarget> scene_render_target,
+        VkSemaphore                   scene_finished_semaphore,
+        VkCommandBuffer               scene_commands)
     {
         (void)scene_render_target; // Unused for now, reserved for future use
 
@@ -297,7 +309,7 @@ namespace vulkan_engine::rendering
         record_commands(editor, scene_render_target);
 
         // 绛夊緟 image available 鍜屽満鏅畬鎴愶紙濡傛灉鏈夛級
-        submit_commands(frame_syncs_[current_frame_].image_available_semaphore->handle(), scene_finished_semaphore);
+        submit_commands(frame_syncs_[current_frame_].image_available_semaphore->handle(), scene_finished_semaphore, scene_commands);
     }
 
     void UIRenderer::record_commands(editor::Editor& editor, std::shared_ptr<RenderTarget> scene_render_target)
@@ -314,7 +326,7 @@ namespace vulkan_engine::rendering
         vulkan::Framebuffer* framebuffer = framebuffer_pool_->get_framebuffer(current_image_);
         if (!framebuffer)
         {
-            logger::error("Failed to get framebuffer for image " + std::to_string(current_image_));
+            logger::error("Failed to get framebuffer for image ", current_image_);
             return;
         }
         VkFramebuffer vk_framebuffer = framebuffer->handle();
@@ -345,7 +357,7 @@ namespace vulkan_engine::rendering
         cmd.end();
     }
 
-    void UIRenderer::submit_commands(VkSemaphore image_available_semaphore, VkSemaphore scene_finished_semaphore)
+    void UIRenderer::submit_commands(VkSemaphore image_available_semaphore, VkSemaphore scene_finished_semaphore, VkCommandBuffer scene_commands)
     {
         auto& cmd  = command_buffers_[current_frame_];
         auto& sync = frame_syncs_[current_frame_];
@@ -371,7 +383,21 @@ namespace vulkan_engine::rendering
         // 浣跨敤 per-image render_finished semaphore
         VkSemaphore signal_semaphores[] = {render_finished_semaphores_[current_image_]->handle()};
 
-        VkSubmitInfo submit_info{};
+        // Scene commands go in their own batch so they do not wait for the swap chain
+        // image; their final layout barrier orders them before the UI batch, and the
+        // timeline value signalled after the UI batch covers both
+        VkSubmitInfo submit_infos[2]{};
+        uint32_t     submit_count = 0;
+
+        if (scene_commands != VK_NULL_HANDLE)
+        {
+            VkSubmitInfo& scene_info      = submit_infos[submit_count++];
+            scene_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            scene_info.commandBufferCount = 1;
+            scene_info.pCommandBuffers    = &scene_commands;
+        }
+
+        VkSubmitInfo& submit_info        = submit_infos[submit_count++];
         submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submit_info.waitSemaphoreCount   = wait_count;
         submit_info.pWaitSemaphores      = wait_semaphores;
@@ -382,7 +408,7 @@ namespace vulkan_engine::rendering
         submit_info.signalSemaphoreCount = 1;
         submit_info.pSignalSemaphores    = signal_semaphores;
 
-        vkQueueSubmit(device_->graphics_queue().handle(), 1, &submit_info, sync.in_flight_fence->handle());
+        sync.submitted_value = device_->graphics_timeline()->submit(submit_infos, submit_count);
     }
 
     void UIRenderer::present()
@@ -415,7 +441,7 @@ namespace vulkan_engine::rendering
         pending_height_ = height;
         resize_pending_ = true;
 
-        logger::info("UIRenderer resize marked: " + std::to_string(width) + "x" + std::to_string(height));
+        logger::info("UIRenderer resize marked: ", width, "x", height);
     }
 
     void UIRenderer::apply_pending_resize()
@@ -425,18 +451,18 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        logger::info("Applying UIRenderer resize: " + std::to_string(pending_width_) + "x" + std::to_string(pending_height_));
+        logger::info("Applying UIRenderer resize: ", pending_width_, "x", pending_height_);
 
-        vkDeviceWaitIdle(device_->device().handle());
-
-        // CRITICAL: Recreate swap chain first to get new-sized images
+        // No device wait: the old swap chain and framebuffers go through the
+        // deletion queue while the frames that use them drain
         if (!swap_chain_->recreate())
         {
-            logger::error("Failed to recreate swap chain during resize");
+            // Minimized; stay pending until the window has a size again
+            logger::warn("Swap chain not recreated during resize");
             return;
         }
 
-        logger::info("Swap chain recreated: " + std::to_string(swap_chain_->width()) + "x" + std::to_string(swap_chain_->height()));
+        logger::info("Swap chain recreated: ", swap_chain_->width(), "x", swap_chain_->height());
 
         // Update render pass if format changed
         present_render_pass_ = render_pass_manager_->get_present_render_pass(swap_chain_->format());
@@ -466,15 +492,25 @@ namespace vulkan_engine::rendering
     void UIRenderer::recreate_swap_chain_resources()
     {
         // 閲嶆柊鍒涘缓 per-image render_finished semaphores
-        uint32_t new_image_count = swap_chain_->image_count();
+        // Presents still queued on the retired swap chain wait on the old set, so
+        // the new chain gets fresh semaphores and the old ones go with it
+        uint32_t                 new_image_count = swap_chain_->image_count();
+        std::vector<VkSemaphore> old_semaphores;
+        old_semaphores.reserve(render_finished_semaphores_.size());
+        for (auto& semaphore : render_finished_semaphores_)
+        {
+            old_semaphores.push_back(semaphore->release());
+        }
+        swap_chain_->retire_semaphores(old_semaphores);
+
         render_finished_semaphores_.clear();
-        render_finished_semaphores_.resize(new_image_count);
+        render_finished_semaphores_.reserve(new_image_count);
         for (uint32_t i = 0; i < new_image_count; ++i)
         {
-            render_finished_semaphores_[i] = std::make_unique<vulkan::Semaphore>(device_);
+            render_finished_semaphores_.push_back(std::make_unique<vulkan::Semaphore>(device_));
         }
 
-        logger::info("UIRenderer swap chain resources updated, " + std::to_string(new_image_count) + " images");
+        logger::info("UIRenderer swap chain resources updated, ", new_image_count, " images");
     }
 
     // ============================================================================
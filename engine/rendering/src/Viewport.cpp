@@ -56,7 +56,7 @@ namespace vulkan_engine::rendering
 
         imgui_texture_dirty_ = true;
 
-        logger::info("Viewport initialized: " + std::to_string(display_width_) + "x" + std::to_string(display_height_));
+        logger::info("Viewport initialized: ", display_width_, "x", display_height_);
     }
 
     void Viewport::cleanup()
@@ -101,7 +101,7 @@ namespace vulkan_engine::rendering
         // 鏍囪 ImGui 绾圭悊闇€瑕佹洿鏂?
         imgui_texture_dirty_ = true;
 
-        logger::info("Viewport resized to: " + std::to_string(width) + "x" + std::to_string(height));
+        logger::info("Viewport resized to: ", width, "x", height);
     }
 
     float Viewport::aspect_ratio() const
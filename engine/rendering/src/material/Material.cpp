@@ -1,24 +1,117 @@
 #include "engine/rendering/material/Material.hpp"
+#include "engine/rendering/resources/Mesh.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
+#include "engine/rhi/vulkan/pipelines/ShaderModule.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
 
 namespace vulkan_engine::rendering
 {
+    namespace
+    {
+        // MeshVertex attribute offsets indexed by shader input location
+        constexpr uint32_t mesh_vertex_offsets[] = {
+            offsetof(MeshVertex, position),
+            offsetof(MeshVertex, normal),
+            offsetof(MeshVertex, uv),
+            offsetof(MeshVertex, color)
+        };
+
+        // Interface of the original hand-written material layout, used when the
+        // shaders cannot be reflected (missing files, unsupported SPIR-V)
+        vulkan::ShaderReflection legacy_reflection()
+        {
+            vulkan::ShaderReflection reflection;
+            reflection.stages      = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+            reflection.entry_point = "main";
+
+            MaterialParameterLayout       params = MaterialParameterLayout::default_pbr();
+            vulkan::ShaderResourceBinding ubo;
+            ubo.name            = "material";
+            ubo.set             = 0;
+            ubo.binding         = 0;
+            ubo.descriptor_type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            ubo.stages          = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+            ubo.block_size      = params.size;
+            for (const auto& [name, member] : params.members)
+            {
+                ubo.members.push_back({name, member.offset, member.size});
+            }
+            reflection.bindings.push_back(std::move(ubo));
+
+            const char* texture_names[] = {"albedo", "normal", "roughness", "metallic"};
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                vulkan::ShaderResourceBinding texture;
+                texture.name            = texture_names[i];
+                texture.binding         = i + 1;
+                texture.descriptor_type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                texture.stages          = VK_SHADER_STAGE_FRAGMENT_BIT;
+                reflection.bindings.push_back(std::move(texture));
+            }
+
+            vulkan::ShaderPushConstantBlock push;
+            push.name  = "pushConsts";
+            push.range = {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4)}; // MVP matrix
+            reflection.push_constants.push_back(push);
+
+            reflection.vertex_inputs = {
+                {"position", 0, VK_FORMAT_R32G32B32_SFLOAT},
+                {"normal", 1, VK_FORMAT_R32G32B32_SFLOAT},
+                {"uv", 2, VK_FORMAT_R32G32_SFLOAT},
+                {"color", 3, VK_FORMAT_R32G32B32_SFLOAT}
+            };
+            return reflection;
+        }
+
+        bool same_layout_bindings(const std::vector<VkDescriptorSetLayoutBinding>& a,
+                                  const std::vector<VkDescriptorSetLayoutBinding>& b)
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                              [](const VkDescriptorSetLayoutBinding& x, const VkDescriptorSetLayoutBinding& y)
+                              {
+                                  return x.binding == y.binding && x.descriptorType == y.descriptorType &&
+                                         x.descriptorCount == y.descriptorCount && x.stageFlags == y.stageFlags;
+                              });
+        }
+    } // namespace
+
     Material::Material(std::shared_ptr<vulkan::DeviceManager> device, const Config& config)
         : device_(std::move(device)), config_(config)
     {
-        // Initialize uniform buffer with default values
-        uniform_buffer_ = std::make_unique<vulkan::UniformBuffer<UniformBufferData>>(device_, 1);
+        // Parameter block in the shared ring, or a private one-material ring with a
+        // slot per frame in flight so bind() never overwrites data the GPU still reads
+        parameter_buffer_ = config_.parameter_buffer;
+        if (!parameter_buffer_)
+        {
+            MaterialParameterBuffer::Config buffer_config;
+            buffer_config.frame_count   = std::max(config_.max_frames_in_flight, 1u);
+            buffer_config.slot_capacity = 256;
+            parameter_buffer_           = std::make_shared<MaterialParameterBuffer>(device_, buffer_config);
+            owns_parameter_buffer_      = true;
+        }
+        config_.parameter_buffer = nullptr; // Held in parameter_buffer_ only
 
-        // Upload initial default values
-        UniformBufferData initial_data{};
-        uniform_buffer_->update(0, initial_data);
+        layout_cache_        = config_.layout_cache ? config_.layout_cache : std::make_shared<vulkan::LayoutCache>(device_);
+        config_.layout_cache = nullptr; // Held in layout_cache_ only
+
+        // Derive the parameter block and layouts from the shader interface
+        reflect_shaders();
+        if (parameter_layout_.size > 0)
+        {
+            parameter_block_ = parameter_buffer_->allocate(parameter_layout_.size);
+        }
+        write_default_parameters();
 
-        // Create descriptor set layout and pipeline layout
-        create_descriptor_set_layout();
-        create_pipeline_layout();
+        create_layouts();
         create_descriptor_set();
         create_default_sampler();
         create_default_white_texture();
@@ -35,14 +128,25 @@ namespace vulkan_engine::rendering
         , pipeline_(std::move(other.pipeline_))
         , pipeline_layout_(other.pipeline_layout_)
         , descriptor_set_layout_(other.descriptor_set_layout_)
-        , uniform_buffer_(std::move(other.uniform_buffer_))
+        , color_format_(other.color_format_)
+        , depth_format_(other.depth_format_)
+        , layout_cache_(std::move(other.layout_cache_))
+        , reflection_(std::move(other.reflection_))
+        , parameter_binding_(other.parameter_binding_)
+        , parameter_buffer_(std::move(other.parameter_buffer_))
+        , parameter_block_(other.parameter_block_)
+        , owns_parameter_buffer_(other.owns_parameter_buffer_)
+        , parameter_layout_(std::move(other.parameter_layout_))
         , descriptor_pool_(other.descriptor_pool_)
         , descriptor_set_(other.descriptor_set_)
         , textures_(std::move(other.textures_))
+        , residency_governor_(std::move(other.residency_governor_))
+        , residency_handles_(std::move(other.residency_handles_))
         , default_sampler_(other.default_sampler_)
         , default_white_texture_(std::move(other.default_white_texture_))
         , default_white_texture_view_(other.default_white_texture_view_)
     {
+        other.parameter_block_            = MaterialParameterBuffer::INVALID_BLOCK;
         other.pipeline_layout_            = VK_NULL_HANDLE;
         other.descriptor_set_layout_      = VK_NULL_HANDLE;
         other.descriptor_pool_            = VK_NULL_HANDLE;
@@ -62,14 +166,25 @@ namespace vulkan_engine::rendering
             pipeline_                   = std::move(other.pipeline_);
             pipeline_layout_            = other.pipeline_layout_;
             descriptor_set_layout_      = other.descriptor_set_layout_;
-            uniform_buffer_             = std::move(other.uniform_buffer_);
+            color_format_               = other.color_format_;
+            depth_format_               = other.depth_format_;
+            layout_cache_               = std::move(other.layout_cache_);
+            reflection_                 = std::move(other.reflection_);
+            parameter_binding_          = other.parameter_binding_;
+            parameter_buffer_           = std::move(other.parameter_buffer_);
+            parameter_block_            = other.parameter_block_;
+            owns_parameter_buffer_      = other.owns_parameter_buffer_;
+            parameter_layout_           = std::move(other.parameter_layout_);
             descriptor_pool_            = other.descriptor_pool_;
             descriptor_set_             = other.descriptor_set_;
             textures_                   = std::move(other.textures_);
+            residency_governor_         = std::move(other.residency_governor_);
+            residency_handles_          = std::move(other.residency_handles_);
             default_sampler_            = other.default_sampler_;
             default_white_texture_      = std::move(other.default_white_texture_);
             default_white_texture_view_ = other.default_white_texture_view_;
 
+            other.parameter_block_            = MaterialParameterBuffer::INVALID_BLOCK;
             other.pipeline_layout_            = VK_NULL_HANDLE;
             other.descriptor_set_layout_      = VK_NULL_HANDLE;
             other.descriptor_pool_            = VK_NULL_HANDLE;
@@ -99,19 +214,10 @@ namespace vulkan_engine::rendering
         // Destroy pipeline
         pipeline_.reset();
 
-        // Destroy pipeline layout
-        if (pipeline_layout_ != VK_NULL_HANDLE)
-        {
-            vkDestroyPipelineLayout(device, pipeline_layout_, nullptr);
-            pipeline_layout_ = VK_NULL_HANDLE;
-        }
-
-        // Destroy descriptor set layout
-        if (descriptor_set_layout_ != VK_NULL_HANDLE)
-        {
-            vkDestroyDescriptorSetLayout(device, descriptor_set_layout_, nullptr);
-            descriptor_set_layout_ = VK_NULL_HANDLE;
-        }
+        // Layouts belong to the cache, which may be shared with other materials
+        pipeline_layout_       = VK_NULL_HANDLE;
+        descriptor_set_layout_ = VK_NULL_HANDLE;
+        layout_cache_.reset();
 
         // Destroy default sampler
         if (default_sampler_ != VK_NULL_HANDLE)
@@ -120,8 +226,13 @@ namespace vulkan_engine::rendering
             default_sampler_ = VK_NULL_HANDLE;
         }
 
-        // Destroy uniform buffer
-        uniform_buffer_.reset();
+        // Release parameter block
+        if (parameter_buffer_ && parameter_block_ != MaterialParameterBuffer::INVALID_BLOCK)
+        {
+            parameter_buffer_->free(parameter_block_);
+            parameter_block_ = MaterialParameterBuffer::INVALID_BLOCK;
+        }
+        parameter_buffer_.reset();
 
         // Clear textures (shared_ptr will handle cleanup)
         textures_.clear();
@@ -133,6 +244,8 @@ namespace vulkan_engine::rendering
 
     void Material::build(VkFormat color_format, VkFormat depth_format)
     {
+        PROFILE_SCOPE("Material::build");
+
         if (color_format == VK_FORMAT_UNDEFINED)
         {
             logger::error("Material " + config_.name + " cannot build: no color format provided");
@@ -151,32 +264,54 @@ namespace vulkan_engine::rendering
 
     void Material::build_internal(VkFormat color_format, VkFormat depth_format)
     {
+        color_format_ = color_format;
+        depth_format_ = depth_format;
+
         // Update descriptor set
         update_descriptor_set();
 
+        try
+        {
+            pipeline_ = create_pipeline();
+            logger::info("Material " + config_.name + " built successfully");
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Failed to build material " + config_.name + ": " + e.what());
+            throw;
+        }
+    }
+
+    std::unique_ptr<vulkan::GraphicsPipeline> Material::create_pipeline() const
+    {
+        if (color_format_ == VK_FORMAT_UNDEFINED)
+        {
+            throw std::runtime_error("Material " + config_.name + " has not been built");
+        }
+
         // Create pipeline config for dynamic rendering
         vulkan::GraphicsPipelineConfig pipeline_config{};
         pipeline_config.render_pass          = VK_NULL_HANDLE; // Dynamic rendering
-        pipeline_config.color_format         = color_format;
-        pipeline_config.depth_format         = depth_format;
+        pipeline_config.color_format         = color_format_;
+        pipeline_config.depth_format         = depth_format_;
         pipeline_config.vertex_shader_path   = config_.vertex_shader_path;
         pipeline_config.fragment_shader_path = config_.fragment_shader_path;
         pipeline_config.layout               = pipeline_layout_;
 
-        // Vertex input matching MeshVertex: position(3) + normal(3) + uv(2) + color(3) = 11 floats = 44 bytes
+        // Vertex input: the shader's reflected locations and formats, fetched from the MeshVertex stream
         pipeline_config.vertex_bindings = {
-            {0, sizeof(float) * 11, VK_VERTEX_INPUT_RATE_VERTEX}
+            {0, sizeof(MeshVertex), VK_VERTEX_INPUT_RATE_VERTEX}
         };
 
-        pipeline_config.vertex_attributes = {
-            {0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0},
-            // position at location 0, offset 0
-            {1, 0, VK_FORMAT_R32G32B32_SFLOAT, sizeof(float) * 3},
-            // normal at location 1, offset 12
-            {2, 0, VK_FORMAT_R32G32_SFLOAT, sizeof(float) * 6},
-            // uv at location 2, offset 24
-            {3, 0, VK_FORMAT_R32G32B32_SFLOAT, sizeof(float) * 8} // color at location 3, offset 32
-        };
+        for (const auto& input : reflection_.vertex_inputs)
+        {
+            if (input.location >= std::size(mesh_vertex_offsets) || input.format == VK_FORMAT_UNDEFINED)
+            {
+                throw std::runtime_error("Material " + config_.name + ": vertex input '" + input.name + "' at location " +
+                                         std::to_string(input.location) + " has no matching MeshVertex attribute");
+            }
+            pipeline_config.vertex_attributes.push_back({input.location, 0, input.format, mesh_vertex_offsets[input.location]});
+        }
 
         pipeline_config.primitive_topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         pipeline_config.polygon_mode       = VK_POLYGON_MODE_FILL;
@@ -186,20 +321,73 @@ namespace vulkan_engine::rendering
         pipeline_config.depth_write_enable = config_.depth_write;
         pipeline_config.depth_compare_op   = config_.depth_compare_op;
         pipeline_config.blend_enable       = config_.blend_enable;
+        pipeline_config.pipeline_cache     = config_.pipeline_cache ? config_.pipeline_cache->handle() : VK_NULL_HANDLE;
 
-        try
+        return std::make_unique<vulkan::GraphicsPipeline>(device_, pipeline_config);
+    }
+
+    std::unique_ptr<vulkan::GraphicsPipeline> Material::swap_pipeline(std::unique_ptr<vulkan::GraphicsPipeline> pipeline)
+    {
+        std::swap(pipeline_, pipeline);
+        return pipeline;
+    }
+
+    bool Material::is_layout_compatible(const vulkan::ShaderReflection& reflection) const
+    {
+        // Descriptor sets and push constants must map onto the existing pipeline layout
+        uint32_t set_count = std::max(reflection.set_count(), reflection_.set_count());
+        for (uint32_t set = 0; set < set_count; ++set)
         {
-            pipeline_ = std::make_unique<vulkan::GraphicsPipeline>(device_, pipeline_config);
-            logger::info("Material " + config_.name + " built successfully");
+            if (!same_layout_bindings(reflection.set_layout_bindings(set), reflection_.set_layout_bindings(set)))
+            {
+                return false;
+            }
         }
-        catch (const std::exception& e)
+
+        auto new_ranges = reflection.push_constant_ranges();
+        auto old_ranges = reflection_.push_constant_ranges();
+        if (!std::equal(new_ranges.begin(), new_ranges.end(), old_ranges.begin(), old_ranges.end(),
+                        [](const VkPushConstantRange& a, const VkPushConstantRange& b)
+                        {
+                            return a.stageFlags == b.stageFlags && a.offset == b.offset && a.size == b.size;
+                        }))
         {
-            logger::error("Failed to build material " + config_.name + ": " + e.what());
-            throw;
+            return false;
+        }
+
+        // Vertex attributes are fetched with the reflected formats
+        if (!std::equal(reflection.vertex_inputs.begin(), reflection.vertex_inputs.end(),
+                        reflection_.vertex_inputs.begin(), reflection_.vertex_inputs.end(),
+                        [](const vulkan::ShaderVertexInput& a, const vulkan::ShaderVertexInput& b)
+                        {
+                            return a.location == b.location && a.format == b.format;
+                        }))
+        {
+            return false;
+        }
+
+        // The parameter block is written at the offsets reflected at creation
+        if (parameter_binding_ != UINT32_MAX)
+        {
+            const auto* params = reflection.find_binding(0, parameter_binding_);
+            if (!params)
+            {
+                return false;
+            }
+            for (const auto& member : params->members)
+            {
+                const auto* current = parameter_layout_.find(member.name);
+                if (!current || current->offset != member.offset || current->size != member.size)
+                {
+                    return false;
+                }
+            }
         }
+
+        return true;
     }
 
-    void Material::bind(vulkan::RenderCommandBuffer& cmd)
+    void Material::bind(vulkan::RenderCommandBuffer& cmd, uint32_t frame_index, float screen_coverage)
     {
         if (!pipeline_)
         {
@@ -207,192 +395,311 @@ namespace vulkan_engine::rendering
             return;
         }
 
+        // Evicted textures sample the default white texture until the governor reloads them
+        if (auto governor = residency_governor_.lock())
+        {
+            for (auto handle : residency_handles_)
+            {
+                governor->touch(handle, screen_coverage);
+            }
+        }
+
+        // Defragmentation moved a texture to a new image and view since the set was written
+        bool relocated = false;
+        for (auto& [name, texture] : textures_)
+        {
+            if (texture.image && texture.image->generation() != texture.generation)
+            {
+                texture.view       = texture.image->view();
+                texture.generation = texture.image->generation();
+                relocated          = true;
+            }
+        }
+        if (relocated && descriptor_set_ != VK_NULL_HANDLE)
+        {
+            renew_descriptor_set();
+        }
+
         // Bind pipeline
         cmd.bind_graphics_pipeline(*pipeline_);
 
-        // Bind descriptor set
+        // A private ring has no external owner to flush it
+        if (owns_parameter_buffer_)
+        {
+            parameter_buffer_->flush(frame_index);
+        }
+
+        // Bind descriptor set with the parameter block offset for this frame slot
         if (descriptor_set_ != VK_NULL_HANDLE)
         {
-            cmd.bind_descriptor_sets(pipeline_layout_, 0, {descriptor_set_});
+            if (parameter_binding_ != UINT32_MAX)
+            {
+                uint32_t dynamic_offset = parameter_buffer_->dynamic_offset(parameter_block_, frame_index);
+                cmd.bind_descriptor_set(pipeline_layout_, 0, descriptor_set_, 1, &dynamic_offset);
+            }
+            else
+            {
+                cmd.bind_descriptor_set(pipeline_layout_, 0, descriptor_set_);
+            }
         }
     }
 
-    void Material::set_float(const std::string& name, float value)
+    VkShaderStageFlags Material::push_constant_stages() const
     {
-        std::lock_guard<std::mutex> lock(uniform_mutex_);
-        UniformBufferData           data = uniform_buffer_->get_data(0);
-        if (name == "roughness")
-            data.roughness = value;
-        else if (name == "metallic")
-            data.metallic = value;
-        else if (name == "emissive")
-            data.emissive = value;
-        uniform_buffer_->update(0, data);
+        VkShaderStageFlags stages = 0;
+        for (const auto& block : reflection_.push_constants)
+        {
+            stages |= block.range.stageFlags;
+        }
+        return stages;
     }
 
-    void Material::set_vec3(const std::string& name, const glm::vec3& value)
+    void Material::write_parameter(const std::string& name, const void* data, uint32_t size)
     {
-        if (name == "color")
+        const auto* member = parameter_layout_.find(name);
+        if (!member)
         {
-            std::lock_guard<std::mutex> lock(uniform_mutex_);
-            UniformBufferData           data = uniform_buffer_->get_data(0);
-            data.color                       = glm::vec4(value, 1.0f);
-            uniform_buffer_->update(0, data);
+            return; // Not part of this shader's parameter block
         }
+
+        parameter_buffer_->write(parameter_block_, member->offset, data, std::min(size, member->size));
+    }
+
+    void Material::write_default_parameters()
+    {
+        set_vec4("color", glm::vec4(1.0f));
+        set_float("roughness", 0.5f);
+        set_vec2("uv_scale", glm::vec2(1.0f));
+    }
+
+    void Material::set_float(const std::string& name, float value)
+    {
+        write_parameter(name, &value, sizeof(value));
+    }
+
+    void Material::set_vec3(const std::string& name, const glm::vec3& value)
+    {
+        // vec3 members occupy a vec4 slot in std140; keep alpha opaque for colors
+        glm::vec4 padded(value, 1.0f);
+        write_parameter(name, &padded, sizeof(padded));
     }
 
     void Material::set_vec4(const std::string& name, const glm::vec4& value)
     {
-        if (name == "color")
-        {
-            std::lock_guard<std::mutex> lock(uniform_mutex_);
-            UniformBufferData           data = uniform_buffer_->get_data(0);
-            data.color                       = value;
-            uniform_buffer_->update(0, data);
-        }
+        write_parameter(name, &value, sizeof(value));
     }
 
     void Material::set_vec2(const std::string& name, const glm::vec2& value)
     {
-        std::lock_guard<std::mutex> lock(uniform_mutex_);
-        UniformBufferData           data = uniform_buffer_->get_data(0);
-        if (name == "uv_scale")
+        write_parameter(name, &value, sizeof(value));
+    }
+
+    void Material::set_int(const std::string& name, int value)
+    {
+        write_parameter(name, &value, sizeof(value));
+    }
+
+    void Material::set_bool(const std::string& name, bool value)
+    {
+        int as_int = value ? 1 : 0;
+        write_parameter(name, &as_int, sizeof(as_int));
+    }
+
+    void Material::set_parameter_layout(const MaterialParameterLayout& layout)
+    {
+        if (layout.size == 0)
         {
-            data.uv_scale = value;
+            logger::warn("Material " + config_.name + ": ignoring empty parameter layout");
+            return;
         }
-        else if (name == "uv_offset")
+
+        // Carry over values of members that exist in both layouts
+        std::vector<std::pair<std::string, std::vector<uint8_t>>> preserved;
+        for (const auto& [name, member] : parameter_layout_.members)
         {
-            // Store in uv_scale's neighboring field or add separate field if needed
-            // For now, we can use the padding area or extend the struct
-            data.uv_scale = value; // Placeholder: use uv_scale for now
+            const auto* target = layout.find(name);
+            if (target)
+            {
+                std::vector<uint8_t> bytes(std::min(member.size, target->size));
+                parameter_buffer_->read(parameter_block_, member.offset, bytes.data(), static_cast<uint32_t>(bytes.size()));
+                preserved.emplace_back(name, std::move(bytes));
+            }
         }
-        uniform_buffer_->update(0, data);
-    }
 
-    void Material::set_int(const std::string& name, int value)
-    {
-        std::lock_guard<std::mutex> lock(uniform_mutex_);
-        UniformBufferData           data = uniform_buffer_->get_data(0);
-        if (name == "texture_id")
+        uint32_t new_block = parameter_buffer_->allocate(layout.size);
+        parameter_buffer_->free(parameter_block_);
+        parameter_block_  = new_block;
+        parameter_layout_ = layout;
+
+        for (const auto& [name, bytes] : preserved)
+        {
+            write_parameter(name, bytes.data(), static_cast<uint32_t>(bytes.size()));
+        }
+
+        if (descriptor_set_ != VK_NULL_HANDLE)
         {
-            data.texture_id = value;
+            update_descriptor_set();
         }
-        uniform_buffer_->update(0, data);
     }
 
-    void Material::set_bool(const std::string& name, bool value)
+    void Material::set_texture(const std::string& name, std::shared_ptr<vulkan::Image> texture, VkImageView view)
     {
-        std::lock_guard<std::mutex> lock(uniform_mutex_);
-        UniformBufferData           data = uniform_buffer_->get_data(0);
-        if (name == "use_normal_map")
+        uint32_t binding = resolve_texture_binding(name);
+        if (binding == UINT32_MAX)
         {
-            data.use_normal_map = value ? 1 : 0;
+            logger::warn("Material " + config_.name + ": shader has no texture binding for '" + name + "'");
+            return;
         }
-        uniform_buffer_->update(0, data);
+
+        const uint32_t generation = texture ? texture->generation() : 0;
+        TextureBinding previous   = std::exchange(textures_[name], {std::move(texture), view, binding, generation});
+
+        // Update has_texture flag in the parameter block
+        set_float("has_texture", 1.0f);
+
+        // Update descriptor set if already created
+        if (descriptor_set_ != VK_NULL_HANDLE)
+        {
+            renew_descriptor_set();
+        }
+        retire_texture(std::move(previous.image));
     }
 
-    void Material::set_texture(const std::string& name, std::shared_ptr<vulkan::Image> texture, VkImageView view)
+    void Material::clear_texture(const std::string& name)
     {
-        uint32_t binding = 0;
-        if (name == "albedo") binding = 1;
-        else if (name == "normal") binding = 2;
-        else if (name == "roughness") binding = 3;
-        else if (name == "metallic") binding = 4;
+        auto it = textures_.find(name);
+        if (it == textures_.end())
+        {
+            return;
+        }
 
-        textures_[name] = {std::move(texture), view, binding};
+        std::shared_ptr<vulkan::Image> previous = std::move(it->second.image);
+        textures_.erase(it);
 
-        // Update has_texture flag in uniform buffer
+        if (textures_.empty())
         {
-            std::lock_guard<std::mutex> lock(uniform_mutex_);
-            UniformBufferData           data = uniform_buffer_->get_data(0);
-            data.has_texture                 = 1.0f;
-            uniform_buffer_->update(0, data);
+            set_float("has_texture", 0.0f);
         }
 
-        // Update descriptor set if already created
         if (descriptor_set_ != VK_NULL_HANDLE)
         {
-            update_descriptor_set();
+            renew_descriptor_set();
         }
+        retire_texture(std::move(previous));
     }
 
-    void Material::create_descriptor_set_layout()
+    void Material::set_residency(std::weak_ptr<vulkan::memory::BudgetGovernor>       governor,
+                                 std::vector<vulkan::memory::BudgetGovernor::Handle> handles)
     {
-        // Uniform buffer binding (binding 0)
-        VkDescriptorSetLayoutBinding ubo_binding{};
-        ubo_binding.binding            = 0;
-        ubo_binding.descriptorType     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        ubo_binding.descriptorCount    = 1;
-        ubo_binding.stageFlags         = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        ubo_binding.pImmutableSamplers = nullptr;
+        residency_governor_ = std::move(governor);
+        residency_handles_  = std::move(handles);
+    }
 
-        // Texture bindings (bindings 1-4)
-        VkDescriptorSetLayoutBinding texture_bindings[4] = {};
-        for (int i = 0; i < 4; ++i)
+    uint32_t Material::resolve_texture_binding(const std::string& name) const
+    {
+        // Accept the parameter name as written in material files ("albedo") or the
+        // shader-side naming conventions ("albedo_texture", "albedo_map")
+        for (const std::string& candidate : {name, name + "_texture", name + "_map"})
         {
-            texture_bindings[i].binding            = i + 1;
-            texture_bindings[i].descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            texture_bindings[i].descriptorCount    = 1;
-            texture_bindings[i].stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT;
-            texture_bindings[i].pImmutableSamplers = nullptr;
+            const auto* binding = reflection_.find_binding(candidate);
+            if (binding && binding->set == 0 &&
+                (binding->descriptor_type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ||
+                 binding->descriptor_type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER))
+            {
+                return binding->binding;
+            }
         }
+        return UINT32_MAX;
+    }
 
-        // Combine all bindings
-        VkDescriptorSetLayoutBinding all_bindings[5] = {
-            ubo_binding,
-            texture_bindings[0],
-            texture_bindings[1],
-            texture_bindings[2],
-            texture_bindings[3]
-        };
+    void Material::reflect_shaders()
+    {
+        try
+        {
+            reflection_ = vulkan::ShaderReflection::reflect(vulkan::ShaderModule::load_spirv_from_file(config_.vertex_shader_path));
+            reflection_.merge(vulkan::ShaderReflection::reflect(
+                                                                vulkan::ShaderModule::load_spirv_from_file(config_.fragment_shader_path)));
+        }
+        catch (const std::exception& e)
+        {
+            logger::warn("Material " + config_.name + ": shader reflection failed (" + e.what() +
+                         "), using built-in PBR layout");
+            reflection_ = legacy_reflection();
+        }
 
-        VkDescriptorSetLayoutCreateInfo layout_info{};
-        layout_info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layout_info.bindingCount = 5;
-        layout_info.pBindings    = all_bindings;
+        // The parameter block is the set 0 uniform buffer named "material", or the first one
+        const vulkan::ShaderResourceBinding* params = reflection_.find_binding("material");
+        if (!params || params->set != 0 || params->descriptor_type != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+        {
+            params = nullptr;
+            for (const auto& binding : reflection_.bindings)
+            {
+                if (binding.set == 0 && binding.descriptor_type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                {
+                    params = &binding;
+                    break;
+                }
+            }
+        }
 
-        VkResult result = vkCreateDescriptorSetLayout(device_->device(), &layout_info, nullptr, &descriptor_set_layout_);
-        if (result != VK_SUCCESS)
+        parameter_binding_ = UINT32_MAX;
+        parameter_layout_  = {};
+        if (params)
         {
-            throw vulkan::VulkanError(result, "Failed to create material descriptor set layout", __FILE__, __LINE__);
+            parameter_binding_ = params->binding;
+            for (const auto& member : params->members)
+            {
+                parameter_layout_.add(member.name, member.offset, member.size);
+            }
+            parameter_layout_.size = (std::max(parameter_layout_.size, params->block_size) + 15) & ~15u;
         }
     }
 
-    void Material::create_pipeline_layout()
+    void Material::create_layouts()
     {
-        // Push constant range for MVP matrix (vertex shader)
-        VkPushConstantRange push_constant_range{};
-        push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-        push_constant_range.offset     = 0;
-        push_constant_range.size       = sizeof(glm::mat4); // MVP matrix
+        std::vector<std::pair<uint32_t, uint32_t>> dynamic_bindings;
+        if (parameter_binding_ != UINT32_MAX)
+        {
+            dynamic_bindings.emplace_back(0, parameter_binding_);
+        }
 
-        VkPipelineLayoutCreateInfo layout_info{};
-        layout_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        layout_info.setLayoutCount         = 1;
-        layout_info.pSetLayouts            = &descriptor_set_layout_;
-        layout_info.pushConstantRangeCount = 1;
-        layout_info.pPushConstantRanges    = &push_constant_range;
+        std::vector<VkDescriptorSetLayout> set_layouts;
+        pipeline_layout_       = layout_cache_->pipeline_layout(reflection_, set_layouts, dynamic_bindings);
+        descriptor_set_layout_ = set_layouts.empty() ? VK_NULL_HANDLE : set_layouts[0];
 
-        VkResult result = vkCreatePipelineLayout(device_->device(), &layout_info, nullptr, &pipeline_layout_);
-        if (result != VK_SUCCESS)
+        if (set_layouts.size() > 1)
         {
-            throw vulkan::VulkanError(result, "Failed to create material pipeline layout", __FILE__, __LINE__);
+            logger::warn("Material ", config_.name, ": shader uses ", set_layouts.size(),
+                         " descriptor sets, only set 0 is managed by the material");
         }
     }
 
     void Material::create_descriptor_set()
     {
-        // Create descriptor pool
-        VkDescriptorPoolSize pool_sizes[2] = {};
-        pool_sizes[0].type                 = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        pool_sizes[0].descriptorCount      = 1;
-        pool_sizes[1].type                 = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        pool_sizes[1].descriptorCount      = 4;
+        auto bindings = reflection_.set_layout_bindings(0);
+        if (descriptor_set_layout_ == VK_NULL_HANDLE || bindings.empty())
+        {
+            return; // Shader has no material resources
+        }
+
+        // Create descriptor pool sized for the reflected bindings
+        std::map<VkDescriptorType, uint32_t> type_counts;
+        for (const auto& binding : bindings)
+        {
+            VkDescriptorType type = binding.binding == parameter_binding_ ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : binding.descriptorType;
+            type_counts[type] += binding.descriptorCount;
+        }
+
+        std::vector<VkDescriptorPoolSize> pool_sizes;
+        for (const auto& [type, count] : type_counts)
+        {
+            pool_sizes.push_back({type, count});
+        }
 
         VkDescriptorPoolCreateInfo pool_info{};
         pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        pool_info.poolSizeCount = 2;
-        pool_info.pPoolSizes    = pool_sizes;
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes    = pool_sizes.data();
         pool_info.maxSets       = 1;
 
         VkResult result = vkCreateDescriptorPool(device_->device(), &pool_info, nullptr, &descriptor_pool_);
@@ -415,6 +722,35 @@ namespace vulkan_engine::rendering
         }
     }
 
+    void Material::renew_descriptor_set()
+    {
+        // Frames in flight may have bound the current set, which must not be rewritten
+        // under them: write a fresh one and let the deletion queue drop the old pool
+        vulkan::DeletionQueue* deletion_queue = device_->deletion_queue();
+        if (!deletion_queue)
+        {
+            update_descriptor_set();
+            return;
+        }
+
+        deletion_queue->defer(descriptor_pool_);
+        descriptor_pool_ = VK_NULL_HANDLE;
+        descriptor_set_  = VK_NULL_HANDLE;
+
+        create_descriptor_set();
+        update_descriptor_set();
+    }
+
+    void Material::retire_texture(std::shared_ptr<vulkan::Image> image)
+    {
+        // Other materials may still share the image; the last one hands it over
+        vulkan::DeletionQueue* deletion_queue = device_->deletion_queue();
+        if (image && image.use_count() == 1 && deletion_queue)
+        {
+            image->retire(*deletion_queue);
+        }
+    }
+
     void Material::create_default_sampler()
     {
         VkSamplerCreateInfo sampler_info{};
@@ -458,33 +794,12 @@ namespace vulkan_engine::rendering
         // Create staging buffer with white pixel data
         uint32_t white_pixel = 0xFFFFFFFF; // White (RGBA)
 
-        VkBuffer       staging_buffer;
-        VkDeviceMemory staging_memory;
-
-        VkBufferCreateInfo buffer_info{};
-        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_info.size  = sizeof(white_pixel);
-        buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-        vkCreateBuffer(device_->device(), &buffer_info, nullptr, &staging_buffer);
-
-        VkMemoryRequirements mem_requirements;
-        vkGetBufferMemoryRequirements(device_->device(), staging_buffer, &mem_requirements);
-
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize  = mem_requirements.size;
-        alloc_info.memoryTypeIndex = device_->find_memory_type(
-                                                               mem_requirements.memoryTypeBits,
-                                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        vkAllocateMemory(device_->device(), &alloc_info, nullptr, &staging_memory);
-        vkBindBufferMemory(device_->device(), staging_buffer, staging_memory, 0);
-
-        void* data;
-        vkMapMemory(device_->device(), staging_memory, 0, sizeof(white_pixel), 0, &data);
-        memcpy(data, &white_pixel, sizeof(white_pixel));
-        vkUnmapMemory(device_->device(), staging_memory);
+        vulkan::Buffer staging(
+                               device_,
+                               sizeof(white_pixel),
+                               VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        staging.write(&white_pixel, sizeof(white_pixel));
 
         // Create command buffer for layout transition and copy
         VkCommandPool   command_pool;
@@ -550,7 +865,7 @@ namespace vulkan_engine::rendering
 
         vkCmdCopyBufferToImage(
                                command_buffer,
-                               staging_buffer,
+                               staging.handle(),
                                default_white_texture_->handle(),
                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                1,
@@ -582,14 +897,13 @@ namespace vulkan_engine::rendering
         submit_info.commandBufferCount = 1;
         submit_info.pCommandBuffers    = &command_buffer;
 
-        vkQueueSubmit(device_->graphics_queue(), 1, &submit_info, VK_NULL_HANDLE);
-        vkQueueWaitIdle(device_->graphics_queue());
+        // Waits for this upload only, not for frames already in flight
+        vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+        timeline->wait(timeline->submit(&submit_info, 1));
 
         // Cleanup
         vkFreeCommandBuffers(device_->device(), command_pool, 1, &command_buffer);
         vkDestroyCommandPool(device_->device(), command_pool, nullptr);
-        vkFreeMemory(device_->device(), staging_memory, nullptr);
-        vkDestroyBuffer(device_->device(), staging_buffer, nullptr);
 
         default_white_texture_view_ = default_white_texture_->view();
 
@@ -598,80 +912,104 @@ namespace vulkan_engine::rendering
 
     void Material::update_descriptor_set()
     {
-        if (!uniform_buffer_ || descriptor_set_ == VK_NULL_HANDLE)
+        if (!parameter_buffer_ || descriptor_set_ == VK_NULL_HANDLE)
         {
             return;
         }
 
-        // Update uniform buffer binding
-        VkDescriptorBufferInfo buffer_info{};
-        buffer_info.buffer = uniform_buffer_->buffer(0);
-        buffer_info.offset = 0;
-        buffer_info.range  = sizeof(UniformBufferData);
-
-        VkWriteDescriptorSet descriptor_write{};
-        descriptor_write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptor_write.dstSet          = descriptor_set_;
-        descriptor_write.dstBinding      = 0;
-        descriptor_write.dstArrayElement = 0;
-        descriptor_write.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptor_write.descriptorCount = 1;
-        descriptor_write.pBufferInfo     = &buffer_info;
-
-        vkUpdateDescriptorSets(device_->device(), 1, &descriptor_write, 0, nullptr);
+        if (default_sampler_ == VK_NULL_HANDLE)
+        {
+            logger::error("Material " + config_.name + ": default sampler is null, descriptors not written");
+            return;
+        }
 
-        // Update texture bindings - always bind something to avoid validation errors
+        // Reserve up front so the info pointers held by the writes stay valid
+        size_t element_count = 0;
+        for (const auto& binding : reflection_.bindings)
+        {
+            element_count += std::max<uint32_t>(binding.count, 1);
+        }
 
-        for (uint32_t binding_slot = 1; binding_slot <= 4; ++binding_slot)
+        std::vector<VkDescriptorBufferInfo> buffer_infos;
+        std::vector<VkDescriptorImageInfo>  image_infos;
+        std::vector<VkWriteDescriptorSet>   writes;
+        buffer_infos.reserve(element_count);
+        image_infos.reserve(element_count);
 
+        for (const auto& binding : reflection_.bindings)
         {
-            VkImageView view = default_white_texture_view_;
-
-            VkSampler sampler = default_sampler_;
-            if (sampler == VK_NULL_HANDLE)
+            if (binding.set != 0)
             {
-                logger::error("Default sampler is null for binding " + std::to_string(binding_slot));
                 continue;
             }
 
-            // Check if we have a texture for this binding slot
-
-            for (const auto& [name, binding] : textures_)
+            VkWriteDescriptorSet write{};
+            write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet          = descriptor_set_;
+            write.dstBinding      = binding.binding;
+            write.dstArrayElement = 0;
+            write.descriptorType  = binding.descriptor_type;
+            write.descriptorCount = std::max<uint32_t>(binding.count, 1);
 
+            switch (binding.descriptor_type)
             {
-                if (binding.binding == binding_slot && binding.image && binding.view != VK_NULL_HANDLE)
-
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
                 {
-                    view = binding.view;
-
+                    if (binding.binding != parameter_binding_ || parameter_block_ == MaterialParameterBuffer::INVALID_BLOCK)
+                    {
+                        continue; // Not a material-owned buffer
+                    }
+
+                    // Parameter block binding (offset supplied dynamically at bind time)
+                    VkDescriptorBufferInfo buffer_info{};
+                    buffer_info.buffer = parameter_buffer_->buffer(parameter_block_);
+                    buffer_info.offset = 0;
+                    buffer_info.range  = parameter_layout_.size;
+                    buffer_infos.push_back(buffer_info);
+
+                    write.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                    write.descriptorCount = 1;
+                    write.pBufferInfo     = &buffer_infos.back();
                     break;
                 }
-            }
 
+                case VK_DESCRIPTOR_TYPE_SAMPLER:
+                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+                {
+                    // Always bind something to avoid validation errors
+                    VkImageView view = default_white_texture_view_;
+                    for (const auto& [name, texture] : textures_)
+                    {
+                        if (texture.binding == binding.binding && texture.image && texture.view != VK_NULL_HANDLE)
+                        {
+                            view = texture.view;
+                            break;
+                        }
+                    }
+
+                    write.pImageInfo = image_infos.data() + image_infos.size();
+                    for (uint32_t element = 0; element < write.descriptorCount; ++element)
+                    {
+                        VkDescriptorImageInfo image_info{};
+                        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                        image_info.imageView   = element == 0 ? view : default_white_texture_view_;
+                        image_info.sampler     = default_sampler_;
+                        image_infos.push_back(image_info);
+                    }
+                    break;
+                }
 
-            VkDescriptorImageInfo image_info{};
-            image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            image_info.imageView   = view;
-            image_info.sampler     = sampler;
-
-            VkWriteDescriptorSet texture_write{};
-
-            texture_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-            texture_write.dstSet = descriptor_set_;
-
-            texture_write.dstBinding = binding_slot;
-
-            texture_write.dstArrayElement = 0;
-
-            texture_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-
-            texture_write.descriptorCount = 1;
-
-            texture_write.pImageInfo = &image_info;
+                default:
+                    continue; // Storage/texel buffers are not material parameters
+            }
 
+            writes.push_back(write);
+        }
 
-            vkUpdateDescriptorSets(device_->device(), 1, &texture_write, 0, nullptr);
+        if (!writes.empty())
+        {
+            vkUpdateDescriptorSets(device_->device(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
         }
     }
 } // namespace vulkan_engine::rendering
\ No newline at end of file
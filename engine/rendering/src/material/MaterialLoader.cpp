@@ -1,390 +1,988 @@
 #include "engine/rendering/material/MaterialLoader.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
 #include "engine/platform/filesystem/PathUtils.hpp"
 #include "engine/platform/filesystem/FileSystem.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <thread>
 #include <nlohmann/json.hpp>
 
 namespace vulkan_engine::rendering
 {
     using json = nlohmann::json;
 
-    // Helper to generate cache key that includes format information
-    static std::string generate_cache_key(const std::string& name, VkFormat color_format, VkFormat depth_format)
+    namespace
     {
-        return name + "_" + std::to_string(color_format) + "_" + std::to_string(depth_format);
-    }
+        constexpr uint32_t DEFINITION_CACHE_MAGIC   = 0x4645444D; // "MDEF"
+        constexpr uint32_t DEFINITION_CACHE_VERSION = 1;
 
-    // Helper to generate cache key for traditional render pass
-    static std::string generate_cache_key(const std::string& name, VkRenderPass render_pass)
-    {
-        return name + "_rp_" + std::to_string(reinterpret_cast<uint64_t>(render_pass));
-    }
+        // Run function(i) for i in [0, count) on up to hardware_concurrency threads
+        template <typename Function>
+        void parallel_for(size_t count, Function&& function)
+        {
+            std::atomic<size_t> next_job{0};
 
-    MaterialLoader::MaterialLoader(std::shared_ptr<vulkan::DeviceManager> device)
-        : device_(std::move(device)), texture_loader_(device_)
-    {
-    }
+            auto worker = [&]()
+            {
+                for (size_t job = next_job++; job < count; job = next_job++)
+                {
+                    function(job);
+                }
+            };
 
-    std::shared_ptr<Material> MaterialLoader::load(const std::string& path, VkRenderPass render_pass)
-    {
-        // 鐩存帴鍐欐璺緞锛屼笉瑙ｆ瀽
-        std::string full_path = "D:/TechArt/Vulkan/materials/" + path;
+            size_t worker_count = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
 
-        // Parse JSON and create material
-        try
-        {
-            // Read JSON file
-            auto file = std::ifstream(full_path);
-            if (!file.is_open())
+            std::vector<std::thread> workers;
+            for (size_t i = 1; i < worker_count; ++i)
             {
-                logger::error("Failed to open material file: " + full_path);
-                return nullptr;
+                workers.emplace_back(worker);
             }
+            worker();
 
-            json j;
-            file >> j;
-            file.close();
+            for (auto& thread : workers)
+            {
+                thread.join();
+            }
+        }
+
+        VkCullModeFlags parse_cull_mode(const std::string& mode)
+        {
+            if (mode == "none")
+            {
+                return VK_CULL_MODE_NONE;
+            }
+            if (mode == "front")
+            {
+                return VK_CULL_MODE_FRONT_BIT;
+            }
+            return VK_CULL_MODE_BACK_BIT;
+        }
 
-            // Parse config
-            Material::Config config;
-            config.render_pass = render_pass;
-            config.name        = j.value("name", "DefaultMaterial");
+        // Parameters are either {"type": "...", "value": ...} objects or bare values
+        bool parse_parameter(const std::string& name, const json& entry, MaterialParam& param)
+        {
+            const json& value = entry.is_object() ? entry.at("value") : entry;
+            std::string type  = entry.is_object() ? entry.value("type", "") : "";
 
-            // Generate cache key that includes render pass
-            std::string cache_key = generate_cache_key(config.name, render_pass);
+            param.name    = name;
+            param.binding = 0;
+            param.offset  = 0;
 
-            // Check cache using generated key
-            auto it = material_cache_.find(cache_key);
-            if (it != material_cache_.end())
+            if (type == "bool" || value.is_boolean())
             {
-                logger::info("Material '" + config.name + "' (render pass) found in cache");
-                return it->second;
+                param.value = value.get<bool>();
             }
-
-            // Parse shader paths
-            if (j.contains("shader"))
+            else if (type == "int")
+            {
+                param.value = value.get<int>();
+            }
+            else if (value.is_number())
             {
-                config.vertex_shader_path   = j["shader"].value("vertex", "shaders/pbr.vert.spv");
-                config.fragment_shader_path = j["shader"].value("fragment", "shaders/pbr.frag.spv");
+                param.value = value.get<float>();
+            }
+            else if (value.is_array() && value.size() == 2)
+            {
+                param.value = glm::vec2(value[0].get<float>(), value[1].get<float>());
+            }
+            else if (value.is_array() && value.size() == 3)
+            {
+                param.value = glm::vec3(value[0].get<float>(), value[1].get<float>(), value[2].get<float>());
+            }
+            else if (value.is_array() && value.size() == 4)
+            {
+                param.value = glm::vec4(value[0].get<float>(), value[1].get<float>(), value[2].get<float>(), value[3].get<float>());
             }
             else
             {
-                // Default to PBR shaders
-                config.vertex_shader_path   = "shaders/pbr.vert.spv";
-                config.fragment_shader_path = "shaders/pbr.frag.spv";
+                return false;
             }
+            return true;
+        }
 
-            // Resolve paths
-            config.vertex_shader_path   = resolve_path(config.vertex_shader_path);
-            config.fragment_shader_path = resolve_path(config.fragment_shader_path);
+        bool parse_definition_json(const std::string& full_path, MaterialDefinition& definition)
+        {
+            auto file = core::PathUtils::open_input_file(full_path, std::ios::binary);
+            if (!file.is_open())
+            {
+                logger::error("Failed to open material file: " + full_path);
+                return false;
+            }
 
-            // Parse render states
-            if (j.contains("render_states"))
+            json j;
+            file >> j;
+
+            definition      = {};
+            definition.name = j.value("name", "DefaultMaterial");
+
+            // Default to PBR shaders
+            definition.vertex_shader_path   = "shaders/pbr.vert.spv";
+            definition.fragment_shader_path = "shaders/pbr.frag.spv";
+            if (j.contains("shader"))
             {
-                auto& rs           = j["render_states"];
-                config.depth_test  = rs.value("depth_test", true);
-                config.depth_write = rs.value("depth_write", true);
+                definition.shader_name          = j["shader"].value("name", "");
+                definition.vertex_shader_path   = j["shader"].value("vertex", definition.vertex_shader_path);
+                definition.fragment_shader_path = j["shader"].value("fragment", definition.fragment_shader_path);
             }
 
-            // Create material
-            auto material = std::make_shared<Material>(device_, config);
+            if (j.contains("render_states"))
+            {
+                auto& rs               = j["render_states"];
+                definition.depth_test  = rs.value("depth_test", true);
+                definition.depth_write = rs.value("depth_write", true);
+                definition.cull_mode   = parse_cull_mode(rs.value("cull_mode", "back"));
+            }
 
-            // Parse and set parameters
             if (j.contains("parameters"))
             {
-                auto& params = j["parameters"];
-
-                // Color
-                if (params.contains("color"))
+                for (const auto& item : j["parameters"].items())
                 {
-                    auto& color = params["color"];
-                    if (color.contains("value"))
+                    const std::string& name = item.key();
+                    MaterialParam      param;
+                    if (parse_parameter(name, item.value(), param))
+                    {
+                        definition.parameters[name] = std::move(param);
+                    }
+                    else
                     {
-                        auto& val = color["value"];
-                        if (val.is_array() && val.size() >= 3)
-                        {
-                            glm::vec3 color_vec(val[0].get<float>(), val[1].get<float>(), val[2].get<float>());
-                            material->set_vec3("color", color_vec);
-                            logger::info("  Color: " + std::to_string(color_vec.r) + ", " +
-                                         std::to_string(color_vec.g) + ", " + std::to_string(color_vec.b));
-                        }
+                        logger::warn("Material " + definition.name + ": unsupported value for parameter '" + name + "'");
                     }
                 }
+            }
 
-                // Roughness
-                if (params.contains("roughness"))
+            if (j.contains("textures"))
+            {
+                for (const auto& item : j["textures"].items())
                 {
-                    float roughness = params["roughness"].value("value", 0.5f);
-                    material->set_float("roughness", roughness);
-                    logger::info("  Roughness: " + std::to_string(roughness));
+                    const std::string& slot         = item.key();
+                    const json&        entry        = item.value();
+                    std::string        texture_path = entry.is_object() ? entry.value("path", "") : entry.get<std::string>();
+                    if (!texture_path.empty())
+                    {
+                        definition.texture_bindings.push_back(slot);
+                        definition.texture_paths[slot] = texture_path;
+                    }
                 }
+            }
 
-                // Metallic
-                if (params.contains("metallic"))
-                {
-                    float metallic = params["metallic"].value("value", 0.0f);
-                    material->set_float("metallic", metallic);
-                    logger::info("  Metallic: " + std::to_string(metallic));
-                }
+            return true;
+        }
+
+        // ========================================================================
+        // Definition cache serialization
+        // ========================================================================
+        class BinaryWriter
+        {
+            public:
+                explicit BinaryWriter(std::ostream& stream) : stream_(stream) {}
+
+                template <typename T>
+                void write(const T& value) { stream_.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
 
-                // Emissive
-                if (params.contains("emissive"))
+                void write_string(const std::string& value)
                 {
-                    float emissive = params["emissive"].value("value", 0.0f);
-                    material->set_float("emissive", emissive);
-                    logger::info("  Emissive: " + std::to_string(emissive));
+                    write(static_cast<uint32_t>(value.size()));
+                    stream_.write(value.data(), static_cast<std::streamsize>(value.size()));
                 }
-            }
 
-            // Parse and load textures
-            if (j.contains("textures"))
-            {
-                auto& textures = j["textures"];
+            private:
+                std::ostream& stream_;
+        };
+
+        class BinaryReader
+        {
+            public:
+                explicit BinaryReader(std::istream& stream) : stream_(stream) {}
 
-                // Albedo/Diffuse texture (binding 1)
-                if (textures.contains("albedo"))
+                template <typename T>
+                T read()
                 {
-                    std::string texture_path = textures["albedo"].value("path", "");
-                    if (!texture_path.empty())
-                    {
-                        auto texture = texture_loader_.load_texture(texture_path, true);
-                        if (texture)
-                        {
-                            material->set_texture("albedo", texture, texture->view());
-                            logger::info("  Albedo texture: " + texture_path);
-                        }
-                    }
+                    T value{};
+                    stream_.read(reinterpret_cast<char*>(&value), sizeof(T));
+                    return value;
                 }
 
-                // Normal map (binding 2)
-                if (textures.contains("normal"))
+                std::string read_string()
                 {
-                    std::string texture_path = textures["normal"].value("path", "");
-                    if (!texture_path.empty())
+                    uint32_t size = read<uint32_t>();
+                    if (!stream_ || size > (1u << 20))
                     {
-                        auto texture = texture_loader_.load_texture(texture_path, true);
-                        if (texture)
-                        {
-                            material->set_texture("normal", texture, texture->view());
-                            logger::info("  Normal texture: " + texture_path);
-                        }
+                        stream_.setstate(std::ios::failbit);
+                        return {};
                     }
+                    std::string value(size, '\0');
+                    stream_.read(value.data(), size);
+                    return value;
                 }
 
-                // Roughness map (binding 3)
-                if (textures.contains("roughness"))
+                bool ok() const { return static_cast<bool>(stream_); }
+
+            private:
+                std::istream& stream_;
+        };
+
+        void write_definition(BinaryWriter& out, const MaterialDefinition& definition)
+        {
+            out.write_string(definition.name);
+            out.write_string(definition.shader_name);
+            out.write_string(definition.vertex_shader_path);
+            out.write_string(definition.fragment_shader_path);
+            out.write(static_cast<uint8_t>(definition.depth_test));
+            out.write(static_cast<uint8_t>(definition.depth_write));
+            out.write(static_cast<uint32_t>(definition.cull_mode));
+
+            out.write(static_cast<uint32_t>(definition.parameters.size()));
+            for (const auto& [name, param] : definition.parameters)
+            {
+                out.write_string(name);
+                out.write(param.binding);
+                out.write(param.offset);
+                out.write(static_cast<uint8_t>(param.value.index()));
+                std::visit([&](const auto& value)
                 {
-                    std::string texture_path = textures["roughness"].value("path", "");
-                    if (!texture_path.empty())
+                    using T = std::decay_t<decltype(value)>;
+                    if constexpr (std::is_same_v<T, std::string>)
                     {
-                        auto texture = texture_loader_.load_texture(texture_path, true);
-                        if (texture)
-                        {
-                            material->set_texture("roughness", texture, texture->view());
-                            logger::info("  Roughness texture: " + texture_path);
-                        }
+                        out.write_string(value);
                     }
-                }
-
-                // Metallic map (binding 4)
-                if (textures.contains("metallic"))
-                {
-                    std::string texture_path = textures["metallic"].value("path", "");
-                    if (!texture_path.empty())
+                    else if constexpr (std::is_same_v<T, bool>)
                     {
-                        auto texture = texture_loader_.load_texture(texture_path, true);
-                        if (texture)
-                        {
-                            material->set_texture("metallic", texture, texture->view());
-                            logger::info("  Metallic texture: " + texture_path);
-                        }
+                        out.write(static_cast<uint8_t>(value));
                     }
-                }
+                    else
+                    {
+                        out.write(value);
+                    }
+                }, param.value);
             }
 
-            // For traditional render pass version, we need to get formats from somewhere
-            // This version is deprecated, use the color_format/depth_format version instead
-            logger::warn("MaterialLoader::load(path, render_pass) is deprecated, use load(path, color_format, depth_format) instead");
-            material->build(VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_D32_SFLOAT);
+            out.write(static_cast<uint32_t>(definition.texture_bindings.size()));
+            for (const auto& slot : definition.texture_bindings)
+            {
+                out.write_string(slot);
+                out.write_string(definition.texture_paths.at(slot));
+            }
+        }
 
-            // Cache the material using key that includes render pass
-            material_cache_[cache_key] = material;
+        bool read_definition(BinaryReader& in, MaterialDefinition& definition)
+        {
+            definition.name                 = in.read_string();
+            definition.shader_name          = in.read_string();
+            definition.vertex_shader_path   = in.read_string();
+            definition.fragment_shader_path = in.read_string();
+            definition.depth_test           = in.read<uint8_t>() != 0;
+            definition.depth_write          = in.read<uint8_t>() != 0;
+            definition.cull_mode            = in.read<uint32_t>();
+
+            uint32_t parameter_count = in.read<uint32_t>();
+            for (uint32_t i = 0; i < parameter_count && in.ok(); ++i)
+            {
+                MaterialParam param;
+                param.name    = in.read_string();
+                param.binding = in.read<uint32_t>();
+                param.offset  = in.read<uint32_t>();
+                switch (in.read<uint8_t>())
+                {
+                    case 0: param.value = in.read<float>(); break;
+                    case 1: param.value = in.read<glm::vec2>(); break;
+                    case 2: param.value = in.read<glm::vec3>(); break;
+                    case 3: param.value = in.read<glm::vec4>(); break;
+                    case 4: param.value = in.read<int>(); break;
+                    case 5: param.value = in.read<uint8_t>() != 0; break;
+                    case 6: param.value = in.read_string(); break;
+                    default: return false;
+                }
+                definition.parameters[param.name] = param;
+            }
 
-            logger::info("Material " + config.name + " loaded from " + full_path);
+            uint32_t texture_count = in.read<uint32_t>();
+            for (uint32_t i = 0; i < texture_count && in.ok(); ++i)
+            {
+                std::string slot = in.read_string();
+                definition.texture_bindings.push_back(slot);
+                definition.texture_paths[slot] = in.read_string();
+            }
 
-            return material;
+            return in.ok();
         }
-        catch (const std::exception& e)
+
+        bool file_stamp(const std::string& path, int64_t& write_time, uint64_t& file_size)
         {
-            logger::error("Failed to load material from " + full_path + ": " + e.what());
-            return nullptr;
+            std::error_code ec;
+            auto            time = std::filesystem::last_write_time(path, ec);
+            if (ec)
+            {
+                return false;
+            }
+            file_size = std::filesystem::file_size(path, ec);
+            if (ec)
+            {
+                return false;
+            }
+            write_time = static_cast<int64_t>(time.time_since_epoch().count());
+            return true;
         }
+    } // namespace
+
+    size_t MaterialLoader::MaterialKeyHash::operator()(const MaterialKey& key) const
+    {
+        size_t hash = std::hash<std::string>()(key.name);
+        hash ^= std::hash<uint32_t>()(static_cast<uint32_t>(key.color_format)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint32_t>()(static_cast<uint32_t>(key.depth_format)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    MaterialLoader::MaterialLoader(std::shared_ptr<vulkan::DeviceManager> device, uint32_t frames_in_flight)
+        : device_(std::move(device)), texture_loader_(device_)
+    {
+        MaterialParameterBuffer::Config buffer_config;
+        buffer_config.frame_count = frames_in_flight;
+        parameter_buffer_         = std::make_shared<MaterialParameterBuffer>(device_, buffer_config);
+        layout_cache_             = std::make_shared<vulkan::LayoutCache>(device_);
+        pipeline_cache_           = std::make_shared<vulkan::PipelineCache>(device_);
+    }
+
+    MaterialLoader::~MaterialLoader()
+    {
+        release_resident_textures();
+        save_definition_cache();
+    }
+
+    std::shared_ptr<Material> MaterialLoader::load(const std::string& path, VkRenderPass render_pass)
+    {
+        (void)render_pass;
+
+        // Materials always build for dynamic rendering; this overload only picks default formats
+        logger::warn("MaterialLoader::load(path, render_pass) is deprecated, use load(path, color_format, depth_format) instead");
+        return load(path, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_D32_SFLOAT);
     }
 
     std::shared_ptr<Material> MaterialLoader::load(const std::string& path, VkFormat color_format, VkFormat depth_format)
     {
-        // 鐩存帴鍐欐璺緞锛屼笉瑙ｆ瀽
-        std::string full_path = "D:/TechArt/Vulkan/materials/" + path;
+        return load_batch({path}, color_format, depth_format).front();
+    }
 
-        // Parse JSON and create material
-        try
-        {
-            // Read JSON file
-            auto file = std::ifstream(full_path);
-            if (!file.is_open())
-            {
-                logger::error("Failed to open material file: " + full_path);
-                return nullptr;
-            }
+    std::vector<std::shared_ptr<Material>> MaterialLoader::load_batch(const std::vector<std::string>& paths,
+                                                                      VkFormat                        color_format,
+                                                                      VkFormat                        depth_format)
+    {
+        PROFILE_SCOPE("MaterialLoader::load_batch");
+        auto start_time = std::chrono::steady_clock::now();
 
-            json j;
-            file >> j;
-            file.close();
+        BatchStats stats;
+        stats.requested = static_cast<uint32_t>(paths.size());
 
-            // Parse config
-            Material::Config config;
-            config.color_format = color_format;
-            config.depth_format = depth_format;
-            config.name         = j.value("name", "DefaultMaterial");
+        std::vector<std::shared_ptr<Material>> results(paths.size());
 
-            // Generate cache key that includes color and depth formats
-            std::string cache_key = generate_cache_key(config.name, color_format, depth_format);
+        // 1. Definitions, parsed or read from the definition cache on worker threads
+        std::vector<MaterialDefinition> definitions(paths.size());
+        std::vector<uint8_t>            parsed(paths.size(), 0);
+        std::atomic<uint32_t>           definitions_cached{0};
 
-            // Check cache using generated key
-            auto it = material_cache_.find(cache_key);
-            if (it != material_cache_.end())
+        read_definition_cache();
+        parallel_for(paths.size(), [&](size_t i)
+        {
+            PROFILE_SCOPE("MaterialLoader::definition");
+            std::string full_path  = resolve_material_path(paths[i]);
+            int64_t     write_time = 0;
+            uint64_t    file_size  = 0;
+            if (file_stamp(full_path, write_time, file_size))
             {
-                logger::info("Material '" + config.name + "' (" + std::to_string(color_format) + "/" + std::to_string(depth_format) +
-                             ") found in cache");
-                return it->second;
+                std::lock_guard<std::mutex> lock(definitions_mutex_);
+                auto                        it = definitions_.find(full_path);
+                if (it != definitions_.end() && it->second.write_time == write_time && it->second.file_size == file_size)
+                {
+                    definitions[i] = it->second.definition;
+                    parsed[i]      = 1;
+                    ++definitions_cached;
+                    return;
+                }
             }
 
-            // Parse shader paths
-            if (j.contains("shader"))
+            try
             {
-                config.vertex_shader_path   = j["shader"].value("vertex", "shaders/pbr.vert.spv");
-                config.fragment_shader_path = j["shader"].value("fragment", "shaders/pbr.frag.spv");
+                parsed[i] = load_definition(full_path, definitions[i]);
             }
-            else
+            catch (const std::exception& e)
             {
-                config.vertex_shader_path   = "shaders/pbr.vert.spv";
-                config.fragment_shader_path = "shaders/pbr.frag.spv";
+                logger::error("Failed to load material from " + full_path + ": " + e.what());
             }
+        });
+        stats.definitions_cached = definitions_cached;
 
-            // Resolve paths
-            config.vertex_shader_path   = resolve_path(config.vertex_shader_path);
-            config.fragment_shader_path = resolve_path(config.fragment_shader_path);
+        // 2. Reuse cached materials and gather the distinct textures the rest need
+        std::unordered_map<MaterialKey, size_t, MaterialKeyHash> first_in_batch;
+        std::vector<size_t>                                      pending;
+        std::vector<size_t>                                      duplicates;
 
-            // Parse render states
-            if (j.contains("render_states"))
+        std::unordered_map<std::string, std::shared_ptr<vulkan::Image>> textures; // Resolved path -> image
+        std::vector<std::string>                                        to_decode;
+
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            if (!parsed[i])
             {
-                auto& rs           = j["render_states"];
-                config.depth_test  = rs.value("depth_test", true);
-                config.depth_write = rs.value("depth_write", true);
+                continue;
             }
 
-            // Create material
-            auto material = std::make_shared<Material>(device_, config);
-
-            // Parse and set parameters (reuse same logic)
-            if (j.contains("parameters"))
+            MaterialKey key{definitions[i].name, color_format, depth_format};
+            auto        cached = material_cache_.find(key);
+            if (cached != material_cache_.end())
+            {
+                results[i] = cached->second;
+                ++stats.reused;
+                continue;
+            }
+            if (!first_in_batch.emplace(key, i).second)
             {
-                auto& params = j["parameters"];
+                duplicates.push_back(i);
+                continue;
+            }
+            pending.push_back(i);
 
-                if (params.contains("color"))
+            for (const auto& [slot, texture_path] : definitions[i].texture_paths)
+            {
+                std::string resolved = texture_loader_.resolve_path(texture_path);
+                if (textures.count(resolved))
                 {
-                    auto& color = params["color"];
-                    if (color.contains("value"))
-                    {
-                        auto& val = color["value"];
-                        if (val.is_array() && val.size() >= 3)
-                        {
-                            glm::vec3 color_vec(val[0].get<float>(), val[1].get<float>(), val[2].get<float>());
-                            material->set_vec3("color", color_vec);
-                            logger::info("  Color: " + std::to_string(color_vec.r) + ", " +
-                                         std::to_string(color_vec.g) + ", " + std::to_string(color_vec.b));
-                        }
-                    }
+                    ++stats.textures_shared;
+                    continue;
                 }
 
-                if (params.contains("roughness"))
+                if (auto loaded = cached_texture(resolved))
                 {
-                    float roughness = params["roughness"].value("value", 0.5f);
-                    material->set_float("roughness", roughness);
-                    logger::info("  Roughness: " + std::to_string(roughness));
+                    textures[resolved] = std::move(loaded);
+                    ++stats.textures_shared;
+                    continue;
                 }
 
-                if (params.contains("metallic"))
-                {
-                    float metallic = params["metallic"].value("value", 0.0f);
-                    material->set_float("metallic", metallic);
-                    logger::info("  Metallic: " + std::to_string(metallic));
-                }
+                textures[resolved] = nullptr;
+                to_decode.push_back(resolved);
+            }
+        }
 
-                if (params.contains("emissive"))
-                {
-                    float emissive = params["emissive"].value("value", 0.0f);
-                    material->set_float("emissive", emissive);
-                    logger::info("  Emissive: " + std::to_string(emissive));
-                }
+        // 3. Decode textures on worker threads; uploads go through the graphics queue on this thread
+        std::vector<TextureLoader::TextureData> decoded(to_decode.size());
+        parallel_for(to_decode.size(), [&](size_t i)
+        {
+            PROFILE_SCOPE("MaterialLoader::decode_texture");
+            texture_loader_.decode_texture(to_decode[i], decoded[i]);
+        });
+        for (size_t i = 0; i < to_decode.size(); ++i)
+        {
+            auto image = texture_loader_.upload_texture(decoded[i], true);
+            if (image)
+            {
+                textures[to_decode[i]]       = image;
+                texture_cache_[to_decode[i]] = image;
+                register_resident_texture(to_decode[i], image);
+                ++stats.textures_loaded;
             }
+            decoded[i] = {}; // Release pixels early
+        }
 
-            // Parse and load textures
-            if (j.contains("textures"))
+        // 4. Create materials (descriptor pools, samplers) here, then compile pipelines in parallel
+        for (size_t i : pending)
+        {
+            try
             {
-                auto& textures = j["textures"];
+                results[i] = create_material(definitions[i], color_format, depth_format, textures);
+            }
+            catch (const std::exception& e)
+            {
+                logger::error("Failed to create material " + definitions[i].name + ": " + e.what());
+            }
+        }
 
-                if (textures.contains("albedo"))
-                {
-                    std::string texture_path = textures["albedo"].value("path", "");
-                    if (!texture_path.empty())
-                    {
-                        auto texture = texture_loader_.load_texture(texture_path, true);
-                        if (texture)
-                        {
-                            material->set_texture("albedo", texture, texture->view());
-                            logger::info("  Albedo texture: " + texture_path);
-                        }
-                    }
-                }
+        parallel_for(pending.size(), [&](size_t job)
+        {
+            size_t i = pending[job];
+            if (!results[i])
+            {
+                return;
+            }
+            try
+            {
+                results[i]->build(color_format, depth_format);
+            }
+            catch (const std::exception&)
+            {
+                results[i] = nullptr; // Logged by Material::build
             }
+        });
 
-            // Build for dynamic rendering
-            material->build(color_format, depth_format);
+        for (size_t i : pending)
+        {
+            if (results[i])
+            {
+                material_cache_[{definitions[i].name, color_format, depth_format}] = results[i];
+                ++stats.loaded;
+                logger::info("Material " + definitions[i].name + " loaded from " + paths[i]);
+            }
+        }
+        for (size_t i : duplicates)
+        {
+            results[i] = results[first_in_batch[{definitions[i].name, color_format, depth_format}]];
+            ++stats.reused;
+        }
 
-            // Cache the material using key that includes formats
-            material_cache_[cache_key] = material;
+        save_definition_cache();
 
-            logger::info("Material " + config.name + " loaded from " + full_path);
-            return material;
+        stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+        last_batch_stats_  = stats;
+
+        if (paths.size() > 1)
+        {
+            logger::info("MaterialLoader: ", stats.loaded, "/", stats.requested, " materials built, ", stats.reused, " reused, ",
+                         stats.definitions_cached, " definitions cached, ", stats.textures_loaded, " textures loaded (",
+                         stats.textures_shared, " shared) in ", stats.milliseconds, " ms");
         }
-        catch (const std::exception& e)
+
+        return results;
+    }
+
+    std::vector<std::shared_ptr<Material>> MaterialLoader::load_directory(const std::string& directory,
+                                                                          VkFormat           color_format,
+                                                                          VkFormat           depth_format)
+    {
+        std::filesystem::path dir = directory;
+        if (dir.is_relative() && std::filesystem::is_directory(base_directory_ + directory))
+        {
+            dir = base_directory_ + directory;
+        }
+
+        std::vector<std::string> paths;
+        std::error_code          ec;
+        for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if (it->is_regular_file(ec) && it->path().extension() == ".json")
+            {
+                paths.push_back(it->path().string());
+            }
+        }
+
+        if (paths.empty())
+        {
+            logger::warn("MaterialLoader: no material files in " + dir.string());
+            return {};
+        }
+
+        std::sort(paths.begin(), paths.end());
+        return load_batch(paths, color_format, depth_format);
+    }
+
+    bool MaterialLoader::load_definition(const std::string& path, MaterialDefinition& definition)
+    {
+        std::string full_path = resolve_material_path(path);
+
+        CachedDefinition entry;
+        if (!file_stamp(full_path, entry.write_time, entry.file_size) || !parse_definition_json(full_path, entry.definition))
+        {
+            return false;
+        }
+        definition = entry.definition;
+
+        std::lock_guard<std::mutex> lock(definitions_mutex_);
+        definitions_[full_path] = std::move(entry);
+        definitions_dirty_      = true;
+        return true;
+    }
+
+    std::shared_ptr<Material> MaterialLoader::create_material(
+        const MaterialDefinition&                                              definition,
+        VkFormat                                                               color_format,
+        VkFormat                                                               depth_format,
+        const std::unordered_map<std::string, std::shared_ptr<vulkan::Image>>& textures)
+    {
+        Material::Config config;
+        config.name                 = definition.name;
+        config.color_format         = color_format;
+        config.depth_format         = depth_format;
+        config.vertex_shader_path   = resolve_path(definition.vertex_shader_path);
+        config.fragment_shader_path = resolve_path(definition.fragment_shader_path);
+        config.depth_test           = definition.depth_test;
+        config.depth_write          = definition.depth_write;
+        config.cull_mode            = definition.cull_mode;
+        config.parameter_buffer     = parameter_buffer_;
+        config.layout_cache         = layout_cache_;
+        config.pipeline_cache       = pipeline_cache_;
+
+        auto material = std::make_shared<Material>(device_, config);
+
+        for (const auto& [name, param] : definition.parameters)
+        {
+            if (const auto* value = std::get_if<float>(&param.value))
+            {
+                material->set_float(name, *value);
+            }
+            else if (const auto* value = std::get_if<glm::vec2>(&param.value))
+            {
+                material->set_vec2(name, *value);
+            }
+            else if (const auto* value = std::get_if<glm::vec3>(&param.value))
+            {
+                material->set_vec3(name, *value);
+            }
+            else if (const auto* value = std::get_if<glm::vec4>(&param.value))
+            {
+                material->set_vec4(name, *value);
+            }
+            else if (const auto* value = std::get_if<int>(&param.value))
+            {
+                material->set_int(name, *value);
+            }
+            else if (const auto* value = std::get_if<bool>(&param.value))
+            {
+                material->set_bool(name, *value);
+            }
+        }
+
+        std::vector<vulkan::memory::BudgetGovernor::Handle> residency_handles;
+        for (const auto& slot : definition.texture_bindings)
+        {
+            std::string resolved = texture_loader_.resolve_path(definition.texture_paths.at(slot));
+            auto        it       = textures.find(resolved);
+            if (it != textures.end() && it->second)
+            {
+                material->set_texture(slot, it->second, it->second->view());
+
+                auto resident = resident_textures_.find(resolved);
+                if (resident != resident_textures_.end())
+                {
+                    resident->second.users.emplace_back(material, slot);
+                    residency_handles.push_back(resident->second.handle);
+                }
+            }
+        }
+
+        if (!residency_handles.empty())
         {
-            logger::error("Failed to load material from " + full_path + ": " + e.what());
-            return nullptr;
+            material->set_residency(budget_governor_, std::move(residency_handles));
         }
+
+        return material;
     }
 
     std::shared_ptr<Material> MaterialLoader::get(const std::string& name) const
     {
-        auto it = material_cache_.find(name);
-        if (it != material_cache_.end())
+        for (const auto& [key, material] : material_cache_)
         {
-            return it->second;
+            if (key.name == name)
+            {
+                return material;
+            }
         }
         return nullptr;
     }
 
     bool MaterialLoader::has(const std::string& name) const
     {
-        return material_cache_.find(name) != material_cache_.end();
+        return get(name) != nullptr;
     }
 
     void MaterialLoader::clear_cache()
     {
+        release_resident_textures();
         material_cache_.clear();
+        texture_cache_.clear();
+    }
+
+    std::shared_ptr<vulkan::Image> MaterialLoader::cached_texture(const std::string& path)
+    {
+        auto loaded = texture_cache_.find(path);
+        if (loaded != texture_cache_.end() && !loaded->second.expired())
+        {
+            return loaded->second.lock();
+        }
+
+        // Evicted: reload through the governor so its bookkeeping and the existing users follow
+        auto resident = resident_textures_.find(path);
+        auto governor = budget_governor_.lock();
+        if (resident != resident_textures_.end() && governor && governor->ensureResident(resident->second.handle))
+        {
+            loaded = texture_cache_.find(path);
+            if (loaded != texture_cache_.end())
+            {
+                return loaded->second.lock();
+            }
+        }
+        return nullptr;
+    }
+
+    void MaterialLoader::register_resident_texture(const std::string& path, const std::shared_ptr<vulkan::Image>& image)
+    {
+        auto governor = budget_governor_.lock();
+        if (!governor || !image->allocation())
+        {
+            return;
+        }
+
+        auto existing = resident_textures_.find(path);
+        if (existing != resident_textures_.end())
+        {
+            governor->unregisterResource(existing->second.handle);
+            resident_textures_.erase(existing);
+        }
+
+        const auto info = image->allocation()->allocationInfo();
+
+        // Unregistered by clear_cache() and the destructor, so the callbacks never outlive the loader
+        vulkan::memory::BudgetGovernor::ResourceDesc desc;
+        desc.name             = "texture " + path;
+        desc.kind             = vulkan::memory::BudgetGovernor::ResourceKind::Texture;
+        desc.memoryTypeIndex  = info.memoryTypeIndex;
+        desc.size             = info.size;
+        desc.callbacks.demote = [this, path]() { return demote_texture(path); };
+        desc.callbacks.evict  = [this, path]() { evict_texture(path); };
+        desc.callbacks.reload = [this, path]() { return reload_texture(path); };
+
+        ResidentTexture texture;
+        texture.size   = info.size;
+        texture.handle = governor->registerResource(std::move(desc));
+        resident_textures_.emplace(path, std::move(texture));
+    }
+
+    VkDeviceSize MaterialLoader::demote_texture(const std::string& path)
+    {
+        // Textures this small are not worth a re-upload
+        constexpr uint32_t MIN_DEMOTED_SIZE = 64;
+
+        auto it = resident_textures_.find(path);
+        if (it == resident_textures_.end())
+        {
+            return 0;
+        }
+
+        // Only the size is needed; holding the image would keep the materials from retiring it
+        ResidentTexture& texture = it->second;
+        uint32_t         extent  = 0;
+        if (auto current = texture_cache_[path].lock())
+        {
+            extent = std::max(current->width(), current->height());
+        }
+        if (extent / 2 < MIN_DEMOTED_SIZE)
+        {
+            return texture.size;
+        }
+
+        upload_resident_texture(texture, path, texture.dropped_levels + 1);
+        return texture.size;
+    }
+
+    void MaterialLoader::evict_texture(const std::string& path)
+    {
+        auto it = resident_textures_.find(path);
+        if (it == resident_textures_.end())
+        {
+            return;
+        }
+
+        // The last material reference owns the image and retires it through the deletion queue
+        ResidentTexture& texture = it->second;
+        for (auto& [user, slot] : texture.users)
+        {
+            if (auto material = user.lock())
+            {
+                material->clear_texture(slot);
+            }
+        }
+        texture_cache_.erase(path);
+        texture.size = 0;
+
+        logger::info("MaterialLoader: evicted texture " + path);
+    }
+
+    bool MaterialLoader::reload_texture(const std::string& path)
+    {
+        auto it = resident_textures_.find(path);
+        return it != resident_textures_.end() && upload_resident_texture(it->second, path, 0);
+    }
+
+    bool MaterialLoader::upload_resident_texture(ResidentTexture& texture, const std::string& path, uint32_t dropped_levels)
+    {
+        TextureLoader::TextureData data;
+        if (!texture_loader_.decode_texture(path, data))
+        {
+            return false;
+        }
+        uint32_t levels = 0;
+        while (levels < dropped_levels && TextureLoader::downsample(data))
+        {
+            ++levels;
+        }
+
+        // The upload does not wait: frames sampling the image are submitted after it, and the
+        // materials below write fresh descriptor sets and retire the image they replace
+        auto image = texture_loader_.upload_texture(data, true);
+        if (!image)
+        {
+            return false;
+        }
+
+        texture.users.erase(std::remove_if(texture.users.begin(), texture.users.end(), [](const auto& user)
+        {
+            return user.first.expired();
+        }), texture.users.end());
+
+        for (auto& [user, slot] : texture.users)
+        {
+            user.lock()->set_texture(slot, image, image->view());
+        }
+
+        texture_cache_[path]   = image;
+        texture.dropped_levels = levels;
+        texture.size           = image->allocation()->allocationInfo().size;
+        return true;
+    }
+
+    void MaterialLoader::release_resident_textures()
+    {
+        if (auto governor = budget_governor_.lock())
+        {
+            for (const auto& [path, texture] : resident_textures_)
+            {
+                governor->unregisterResource(texture.handle);
+            }
+        }
+        resident_textures_.clear();
+    }
+
+    void MaterialLoader::set_definition_cache_file(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(definitions_mutex_);
+        definition_cache_file_ = path;
+        definitions_loaded_    = false;
+    }
+
+    void MaterialLoader::read_definition_cache()
+    {
+        std::lock_guard<std::mutex> lock(definitions_mutex_);
+        if (definitions_loaded_)
+        {
+            return;
+        }
+        definitions_loaded_ = true;
+
+        if (definition_cache_file_.empty())
+        {
+            definition_cache_file_ = base_directory_ + ".cache/materials.bin";
+        }
+
+        auto file = core::PathUtils::open_input_file(definition_cache_file_, std::ios::binary);
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        BinaryReader in(file);
+        if (in.read<uint32_t>() != DEFINITION_CACHE_MAGIC || in.read<uint32_t>() != DEFINITION_CACHE_VERSION)
+        {
+            logger::warn("MaterialLoader: ignoring incompatible definition cache " + definition_cache_file_);
+            return;
+        }
+
+        std::unordered_map<std::string, CachedDefinition> entries;
+        uint32_t                                          count = in.read<uint32_t>();
+        for (uint32_t i = 0; i < count && in.ok(); ++i)
+        {
+            std::string      path = in.read_string();
+            CachedDefinition entry;
+            entry.write_time = in.read<int64_t>();
+            entry.file_size  = in.read<uint64_t>();
+            if (!read_definition(in, entry.definition))
+            {
+                break;
+            }
+            entries[path] = std::move(entry);
+        }
+
+        if (!in.ok())
+        {
+            logger::warn("MaterialLoader: definition cache " + definition_cache_file_ + " is truncated, ignoring it");
+            return;
+        }
+
+        // Entries parsed in this session are newer than the file
+        for (auto& [path, entry] : definitions_)
+        {
+            entries[path] = std::move(entry);
+        }
+        definitions_ = std::move(entries);
+        logger::debug("MaterialLoader: ", count, " cached material definitions");
+    }
+
+    bool MaterialLoader::save_definition_cache()
+    {
+        std::lock_guard<std::mutex> lock(definitions_mutex_);
+        if (!definitions_dirty_ || definition_cache_file_.empty())
+        {
+            return true;
+        }
+
+        std::filesystem::path cache_path = definition_cache_file_;
+        std::filesystem::path temp_path  = cache_path;
+        temp_path += ".tmp";
+
+        std::error_code ec;
+        std::filesystem::create_directories(cache_path.parent_path(), ec);
+
+        {
+            auto file = core::PathUtils::open_output_file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                logger::warn("MaterialLoader: cannot write definition cache " + temp_path.string());
+                return false;
+            }
+
+            BinaryWriter out(file);
+            out.write(DEFINITION_CACHE_MAGIC);
+            out.write(DEFINITION_CACHE_VERSION);
+            out.write(static_cast<uint32_t>(definitions_.size()));
+            for (const auto& [path, entry] : definitions_)
+            {
+                out.write_string(path);
+                out.write(entry.write_time);
+                out.write(entry.file_size);
+                write_definition(out, entry.definition);
+            }
+
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp_path, cache_path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+
+        definitions_dirty_ = false;
+        return true;
+    }
+
+    std::string MaterialLoader::resolve_material_path(const std::string& path) const
+    {
+        std::filesystem::path file = path;
+        if (file.is_absolute())
+        {
+            return file.lexically_normal().string();
+        }
+
+        std::error_code ec;
+        if (std::filesystem::exists(base_directory_ + path, ec))
+        {
+            return std::filesystem::absolute(base_directory_ + path, ec).lexically_normal().string();
+        }
+
+        return std::filesystem::absolute(resolve_path(path), ec).lexically_normal().string();
     }
 
     std::string MaterialLoader::resolve_path(const std::string& path) const
@@ -419,4 +1017,4 @@ namespace vulkan_engine::rendering
         // (let the caller handle the error)
         return resolved.string();
     }
-} // namespace vulkan_engine::rendering
\ No newline at end of file
+} // namespace vulkan_engine::rendering
@@ -0,0 +1,351 @@
+#include "engine/rendering/material/MaterialParameterBuffer.hpp"
+#include "engine/core/utils/Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vulkan_engine::rendering
+{
+    namespace
+    {
+        VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    // ============================================================================
+    // MaterialParameterLayout
+    // ============================================================================
+
+    void MaterialParameterLayout::add(const std::string& name, uint32_t offset, uint32_t member_size)
+    {
+        members[name] = {offset, member_size};
+        size          = std::max(size, offset + member_size);
+    }
+
+    const MaterialParameterLayout::Member* MaterialParameterLayout::find(const std::string& name) const
+    {
+        auto it = members.find(name);
+        return it != members.end() ? &it->second : nullptr;
+    }
+
+    MaterialParameterLayout MaterialParameterLayout::default_pbr()
+    {
+        MaterialParameterLayout layout;
+        layout.add("color", 0, 16);
+        layout.add("roughness", 16, 4);
+        layout.add("metallic", 20, 4);
+        layout.add("emissive", 24, 4);
+        layout.add("has_texture", 28, 4);
+        layout.add("uv_scale", 32, 8);
+        layout.add("texture_id", 40, 4);
+        layout.add("use_normal_map", 44, 4);
+        layout.size = 64; // Padded to a vec4 multiple
+        return layout;
+    }
+
+    // ============================================================================
+    // MaterialParameterBuffer
+    // ============================================================================
+
+    MaterialParameterBuffer::MaterialParameterBuffer(std::shared_ptr<vulkan::DeviceManager> device, const Config& config)
+        : device_(std::move(device)), config_(config)
+    {
+        if (config_.frame_count == 0)
+        {
+            throw std::runtime_error("MaterialParameterBuffer requires at least one frame slot");
+        }
+
+        resource_manager_ = device_->resource_manager();
+        if (!resource_manager_)
+        {
+            throw std::runtime_error("MaterialParameterBuffer: no memory::ResourceManager attached to the DeviceManager");
+        }
+
+        alignment_ = std::max<VkDeviceSize>(device_->properties().limits.minUniformBufferOffsetAlignment, 16);
+        dirty_blocks_.resize(config_.frame_count);
+
+        create_page(align_up(config_.slot_capacity, alignment_));
+    }
+
+    MaterialParameterBuffer::~MaterialParameterBuffer()
+    {
+        for (auto& page : pages_)
+        {
+            destroy_page(page);
+        }
+    }
+
+    uint32_t MaterialParameterBuffer::create_page(VkDeviceSize slot_size)
+    {
+        Page page;
+        page.slot_size = slot_size;
+
+        // Blocks are placed in whole alignment units, so every offset is a valid dynamic offset
+        const uint32_t unit_count = static_cast<uint32_t>(slot_size / alignment_);
+        page.allocator            = vulkan::memory::OffsetAllocator(unit_count, unit_count);
+        page.shadow.resize(static_cast<size_t>(slot_size), 0);
+
+        // Mapped buffers are never relocated, so page.mapped stays valid for the page's lifetime
+        page.buffer = resource_manager_->createPooledBuffer(
+                                                            slot_size * config_.frame_count,
+                                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                            true);
+        page.mapped = static_cast<uint8_t*>(page.buffer->map());
+
+        pages_.push_back(std::move(page));
+        return static_cast<uint32_t>(pages_.size() - 1);
+    }
+
+    void MaterialParameterBuffer::destroy_page(Page& page)
+    {
+        page.mapped = nullptr;
+        if (page.buffer)
+        {
+            resource_manager_->destroyBuffer(std::move(page.buffer));
+        }
+    }
+
+    uint32_t MaterialParameterBuffer::allocate(uint32_t size)
+    {
+        if (size == 0)
+        {
+            return INVALID_BLOCK;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const VkDeviceSize aligned_size = align_up(size, alignment_);
+        const uint32_t     unit_count   = static_cast<uint32_t>(aligned_size / alignment_);
+
+        uint32_t                               page_index = 0;
+        vulkan::memory::OffsetAllocator::Range range;
+        for (; page_index < pages_.size(); ++page_index)
+        {
+            range = pages_[page_index].allocator.allocate(unit_count);
+            if (range.isValid())
+            {
+                break;
+            }
+        }
+
+        // Every page is full: chain another one, large enough for an oversized block
+        if (page_index == pages_.size())
+        {
+            page_index = create_page(std::max(align_up(config_.slot_capacity, alignment_), aligned_size));
+            range      = pages_[page_index].allocator.allocate(unit_count);
+            logger::info("MaterialParameterBuffer grew to ", pages_.size(), " pages");
+        }
+
+        uint32_t id;
+        if (!free_block_ids_.empty())
+        {
+            id = free_block_ids_.back();
+            free_block_ids_.pop_back();
+        }
+        else
+        {
+            id = static_cast<uint32_t>(blocks_.size());
+            blocks_.emplace_back();
+            blocks_[id].dirty.resize(config_.frame_count);
+            blocks_[id].queued.resize(config_.frame_count, 0);
+        }
+
+        BlockInfo& block = blocks_[id];
+        block.page       = page_index;
+        block.offset     = static_cast<VkDeviceSize>(range.offset) * alignment_;
+        block.size       = aligned_size;
+        block.range      = range;
+        block.in_use     = true;
+
+        std::memset(pages_[page_index].shadow.data() + block.offset, 0, static_cast<size_t>(aligned_size));
+        mark_dirty(id, 0, static_cast<uint32_t>(aligned_size));
+
+        return id;
+    }
+
+    void MaterialParameterBuffer::free(uint32_t block)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (block >= blocks_.size() || !blocks_[block].in_use)
+        {
+            return;
+        }
+
+        BlockInfo& info = blocks_[block];
+        info.in_use     = false;
+        for (auto& range : info.dirty)
+        {
+            range = {};
+        }
+
+        pages_[info.page].allocator.free(info.range);
+        info.range = {};
+        free_block_ids_.push_back(block);
+    }
+
+    void MaterialParameterBuffer::write(uint32_t block, uint32_t offset, const void* data, uint32_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (block >= blocks_.size() || !blocks_[block].in_use || offset + size > blocks_[block].size)
+        {
+            logger::error("MaterialParameterBuffer: write out of range");
+            return;
+        }
+
+        const BlockInfo& info = blocks_[block];
+        uint8_t*         dst  = pages_[info.page].shadow.data() + info.offset + offset;
+        if (std::memcmp(dst, data, size) == 0)
+        {
+            return; // Unchanged, nothing to upload
+        }
+
+        std::memcpy(dst, data, size);
+        mark_dirty(block, offset, offset + size);
+    }
+
+    void MaterialParameterBuffer::read(uint32_t block, uint32_t offset, void* data, uint32_t size) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (block >= blocks_.size() || !blocks_[block].in_use || offset + size > blocks_[block].size)
+        {
+            return;
+        }
+
+        const BlockInfo& info = blocks_[block];
+        std::memcpy(data, pages_[info.page].shadow.data() + info.offset + offset, size);
+    }
+
+    void MaterialParameterBuffer::mark_dirty(uint32_t block, uint32_t begin, uint32_t end)
+    {
+        BlockInfo& info = blocks_[block];
+        for (uint32_t slot = 0; slot < config_.frame_count; ++slot)
+        {
+            DirtyRange& range = info.dirty[slot];
+            range.begin       = std::min(range.begin, begin);
+            range.end         = std::max(range.end, end);
+
+            if (!info.queued[slot])
+            {
+                info.queued[slot] = 1;
+                dirty_blocks_[slot].push_back(block);
+            }
+        }
+    }
+
+    void MaterialParameterBuffer::flush(uint32_t frame_index, std::pmr::memory_resource* scratch)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        uint32_t slot    = frame_index % config_.frame_count;
+        auto&    dirty   = dirty_blocks_[slot];
+        last_copy_count_ = 0;
+        last_copy_bytes_ = 0;
+
+        if (dirty.empty())
+        {
+            return;
+        }
+
+        struct CopyRange
+        {
+            uint32_t     page;
+            VkDeviceSize begin;
+            VkDeviceSize end;
+
+            bool operator<(const CopyRange& other) const
+            {
+                return page != other.page ? page < other.page : begin < other.begin;
+            }
+        };
+
+        // Gather byte ranges within each page, sorted so neighbouring blocks can be merged
+        std::pmr::vector<CopyRange> ranges(scratch ? scratch : std::pmr::get_default_resource());
+        ranges.reserve(dirty.size());
+        for (uint32_t id : dirty)
+        {
+            BlockInfo& info   = blocks_[id];
+            info.queued[slot] = 0;
+
+            DirtyRange& range = info.dirty[slot];
+            if (info.in_use && !range.empty())
+            {
+                ranges.push_back({info.page, info.offset + range.begin, info.offset + range.end});
+            }
+            range = {};
+        }
+        dirty.clear();
+
+        std::sort(ranges.begin(), ranges.end());
+
+        // The shadow copy mirrors the slot layout, so copying the small gaps
+        // between nearby ranges is harmless and saves separate memcpy calls
+        size_t i = 0;
+        while (i < ranges.size())
+        {
+            const Page&  page  = pages_[ranges[i].page];
+            VkDeviceSize begin = ranges[i].begin;
+            VkDeviceSize end   = ranges[i].end;
+            for (++i; i < ranges.size() && ranges[i].page == ranges[i - 1].page && ranges[i].begin <= end + config_.coalesce_gap; ++i)
+            {
+                end = std::max(end, ranges[i].end);
+            }
+
+            uint8_t* slot_base = page.mapped + slot * page.slot_size;
+            std::memcpy(slot_base + begin, page.shadow.data() + begin, static_cast<size_t>(end - begin));
+            ++last_copy_count_;
+            last_copy_bytes_ += end - begin;
+        }
+    }
+
+    VkBuffer MaterialParameterBuffer::buffer(uint32_t block) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return block < blocks_.size() ? pages_[blocks_[block].page].buffer->handle() : VK_NULL_HANDLE;
+    }
+
+    VkDeviceSize MaterialParameterBuffer::block_range(uint32_t block) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return block < blocks_.size() ? blocks_[block].size : 0;
+    }
+
+    uint32_t MaterialParameterBuffer::dynamic_offset(uint32_t block, uint32_t frame_index) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (block >= blocks_.size())
+        {
+            return 0;
+        }
+
+        const BlockInfo& info = blocks_[block];
+        uint32_t         slot = frame_index % config_.frame_count;
+        return static_cast<uint32_t>(slot * pages_[info.page].slot_size + info.offset);
+    }
+
+    MaterialParameterBuffer::Stats MaterialParameterBuffer::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Stats stats;
+        stats.page_count = static_cast<uint32_t>(pages_.size());
+        for (const auto& block : blocks_)
+        {
+            if (block.in_use)
+            {
+                ++stats.block_count;
+                stats.used_bytes += block.size;
+            }
+        }
+        stats.last_copy_count = last_copy_count_;
+        stats.last_copy_bytes = last_copy_bytes_;
+        return stats;
+    }
+} // namespace vulkan_engine::rendering
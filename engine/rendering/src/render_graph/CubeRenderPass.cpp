@@ -39,7 +39,7 @@ namespace vulkan_engine::rendering
         }
 
         // Bind material
-        material->bind(cmd);
+        material->bind(cmd, ctx.frame_index);
 
         // Set viewport
         cmd.set_viewport(
@@ -55,7 +55,7 @@ namespace vulkan_engine::rendering
 
         // Push MVP matrix
         cmd.push_constants(material->pipeline_layout(),
-                           VK_SHADER_STAGE_VERTEX_BIT,
+                           material->push_constant_stages(),
                            0,
                            sizeof(glm::mat4),
                            &current_mvp_);
@@ -67,7 +67,7 @@ namespace vulkan_engine::rendering
         cmd.bind_index_buffer(config_.index_buffer->handle(), config_.index_type);
 
         // Draw indexed
-        cmd.draw_indexed(config_.index_count, 1, 0, 0, 0);
+        cmd.draw_indexed(config_.index_count, 1, config_.first_index, config_.vertex_offset, 0);
     }
 
     void CubeRenderPass::set_mvp_matrix(const glm::mat4& mvp)
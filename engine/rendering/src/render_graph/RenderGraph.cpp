@@ -2,8 +2,12 @@
 #include "engine/rendering/render_graph/RenderGraphPass.hpp"
 #include "engine/rendering/render_graph/RenderGraphResource.hpp"
 #include "engine/rhi/vulkan/command/CommandBuffer.hpp"
+#include "engine/rhi/vulkan/command/GpuProfiler.hpp"
+#include "engine/core/memory/LinearArena.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
 #include <algorithm>
+#include <chrono>
 #include <stdexcept>
 
 namespace vulkan_engine::rendering
@@ -12,7 +16,17 @@ namespace vulkan_engine::rendering
     // RenderGraph Implementation
     // ============================================================================
 
-    RenderGraph::RenderGraph() = default;
+    namespace
+    {
+        // Holds the nodes and barrier lists of a typical graph in one block
+        constexpr size_t COMPILE_ARENA_BLOCK_SIZE = 16 * 1024;
+    }
+
+    RenderGraph::RenderGraph()
+        : compile_arena_(std::make_unique<core::LinearArena>(COMPILE_ARENA_BLOCK_SIZE))
+        , builder_(compile_arena_.get())
+    {
+    }
 
     RenderGraph::~RenderGraph()
     {
@@ -21,7 +35,8 @@ namespace vulkan_engine::rendering
     }
 
     RenderGraph::RenderGraph(RenderGraph&& other) noexcept
-        : builder_(std::move(other.builder_))
+        : compile_arena_(std::move(other.compile_arena_))
+        , builder_(std::move(other.builder_))
         , compiled_(other.compiled_)
         , execution_order_(std::move(other.execution_order_))
         , device_(std::move(other.device_))
@@ -29,17 +44,22 @@ namespace vulkan_engine::rendering
         , barrier_manager_(std::move(other.barrier_manager_))
         , next_resource_id_(other.next_resource_id_)
         , pass_barriers_(std::move(other.pass_barriers_))
+        , pass_stats_(std::move(other.pass_stats_))
+        , pass_zone_names_(std::move(other.pass_zone_names_))
     {
         other.compiled_         = false;
         other.next_resource_id_ = 1;
+        other.builder_          = RenderGraphBuilder(); // The arena moved with the nodes
     }
 
     RenderGraph& RenderGraph::operator=(RenderGraph&& other) noexcept
     {
         if (this != &other)
         {
+            // Nothing may point into the current arena once it is replaced
             reset();
 
+            compile_arena_    = std::move(other.compile_arena_);
             builder_          = std::move(other.builder_);
             compiled_         = other.compiled_;
             execution_order_  = std::move(other.execution_order_);
@@ -48,9 +68,12 @@ namespace vulkan_engine::rendering
             barrier_manager_  = std::move(other.barrier_manager_);
             next_resource_id_ = other.next_resource_id_;
             pass_barriers_    = std::move(other.pass_barriers_);
+            pass_stats_       = std::move(other.pass_stats_);
+            pass_zone_names_  = std::move(other.pass_zone_names_);
 
             other.compiled_         = false;
             other.next_resource_id_ = 1;
+            other.builder_          = RenderGraphBuilder();
         }
         return *this;
     }
@@ -67,8 +90,10 @@ namespace vulkan_engine::rendering
         compiled_ = false;
         execution_order_.clear();
         pass_barriers_.clear();
+        pass_stats_.clear();
+        pass_zone_names_.clear();
         // Clear builder nodes to prevent accumulation
-        builder_ = RenderGraphBuilder();
+        builder_.clear();
         if (resource_pool_)
         {
             resource_pool_->reset();
@@ -78,6 +103,12 @@ namespace vulkan_engine::rendering
             barrier_manager_->clear();
         }
         next_resource_id_ = 1;
+
+        // Nodes and barrier lists are gone; rewind the arena they lived in
+        if (compile_arena_)
+        {
+            compile_arena_->reset();
+        }
     }
 
     ImageHandle RenderGraph::create_image(const ResourceDesc& desc)
@@ -133,14 +164,20 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        pass_barriers_.resize(execution_order_.size());
+        // Barrier lists are built in the compile arena, which reset() rewinds. A
+        // recompile without reset() leaves the old lists there until then.
+        std::pmr::memory_resource* resource = compile_arena_ ? compile_arena_.get() : std::pmr::get_default_resource();
+
+        pass_barriers_.clear();
+        pass_barriers_.reserve(execution_order_.size());
 
         for (size_t i = 0; i < execution_order_.size(); ++i)
         {
             auto* node = execution_order_[i];
 
             // Get barriers from barrier manager
-            pass_barriers_[i] = barrier_manager_->get_barriers_for_pass(static_cast<uint32_t>(i));
+            pass_barriers_.emplace_back(resource);
+            barrier_manager_->get_barriers_for_pass(static_cast<uint32_t>(i), pass_barriers_[i]);
 
             // Also check for image transitions needed by this pass
             if (auto* pass_base = dynamic_cast<RenderPassBase*>(node))
@@ -214,13 +251,15 @@ namespace vulkan_engine::rendering
     // RenderGraph implementation
     void RenderGraph::compile()
     {
+        PROFILE_SCOPE("RenderGraph::compile");
+
         if (!resource_pool_)
         {
             logger::error("RenderGraph not initialized - call initialize() first");
             return;
         }
 
-        logger::info("Compiling RenderGraph...");
+        LOG_INFO("Compiling RenderGraph...");
 
         // Build execution order based on dependencies
         build_execution_order();
@@ -228,8 +267,16 @@ namespace vulkan_engine::rendering
         // Generate barriers for resource transitions
         generate_barriers();
 
+        pass_stats_.clear();
+        pass_zone_names_.clear();
+        for (auto* node : execution_order_)
+        {
+            pass_stats_.push_back({node->name(), 0.0f, {}});
+            pass_zone_names_.push_back(profiler::Profiler::instance().intern(node->name()));
+        }
+
         compiled_ = true;
-        logger::info("RenderGraph compiled successfully with " + std::to_string(execution_order_.size()) + " passes");
+        LOG_INFO("RenderGraph compiled successfully with " << execution_order_.size() << " passes");
     }
 
     void RenderGraph::execute()
@@ -244,6 +291,8 @@ namespace vulkan_engine::rendering
 
     void RenderGraph::execute(vulkan::RenderCommandBuffer& cmd, const RenderContext& ctx)
     {
+        PROFILE_SCOPE("RenderGraph::execute");
+
         if (!compiled_)
         {
             compile();
@@ -258,7 +307,8 @@ namespace vulkan_engine::rendering
         // Execute each node in order with barriers
         for (size_t i = 0; i < execution_order_.size(); ++i)
         {
-            auto* node = execution_order_[i];
+            auto*                      node           = execution_order_[i];
+            const vulkan::CommandStats commands_start = cmd.stats();
 
             // Submit barriers before this pass
             if (i < pass_barriers_.size())
@@ -269,7 +319,17 @@ namespace vulkan_engine::rendering
             // Execute the pass
             if (auto* pass_base = dynamic_cast<RenderPassBase*>(node))
             {
-                pass_base->execute(cmd, ctx);
+                PROFILE_SCOPE(i < pass_zone_names_.size() ? pass_zone_names_[i] : "RenderGraph::pass");
+                const auto cpu_start = std::chrono::steady_clock::now();
+                {
+                    vulkan::GpuProfiler::Scope scope(ctx.gpu_profiler, cmd.handle(), node->name(), true);
+                    pass_base->execute(cmd, ctx);
+                }
+                if (i < pass_stats_.size())
+                {
+                    pass_stats_[i].cpu_ms   = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - cpu_start).count();
+                    pass_stats_[i].commands = cmd.stats() - commands_start;
+                }
             }
             else
             {
@@ -129,8 +129,7 @@ namespace vulkan_engine::rendering
             // Bind descriptor set if provided
             if (mesh.pipeline_layout != VK_NULL_HANDLE && mesh.descriptor_set != VK_NULL_HANDLE)
             {
-                std::vector<VkDescriptorSet> sets = {mesh.descriptor_set};
-                cmd.bind_descriptor_sets(mesh.pipeline_layout, 0, sets);
+                cmd.bind_descriptor_set(mesh.pipeline_layout, 0, mesh.descriptor_set);
             }
 
             // Bind vertex buffer
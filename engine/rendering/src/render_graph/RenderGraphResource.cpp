@@ -10,6 +10,10 @@ namespace vulkan_engine::rendering
 
     RenderGraphResourcePool::RenderGraphResourcePool(std::shared_ptr<vulkan::DeviceManager> device)
         : device_(std::move(device))
+        , image_infos_(32)
+        , buffer_infos_(32)
+        , images_(&table_resource_)
+        , buffers_(&table_resource_)
     {
     }
 
@@ -26,11 +30,11 @@ namespace vulkan_engine::rendering
         if (it != images_.end())
         {
             // Return existing resource
-            return it->second.get();
+            return it->second;
         }
 
         // Create new image
-        auto info         = std::make_unique<ImageResourceInfo>();
+        auto info         = image_infos_.make();
         info->handle      = handle;
         info->desc        = desc;
         info->state       = {}; // Default state
@@ -55,9 +59,8 @@ namespace vulkan_engine::rendering
             throw vulkan::VulkanError(result, "Failed to create image view", __FILE__, __LINE__);
         }
 
-        ImageResourceInfo* ptr = info.get();
-        images_[id]            = std::move(info);
-        return ptr;
+        images_[id] = info.get();
+        return info.release();
     }
 
     BufferResourceInfo* RenderGraphResourcePool::acquire_buffer(const ResourceDesc& desc, BufferHandle handle)
@@ -67,19 +70,18 @@ namespace vulkan_engine::rendering
         auto it = buffers_.find(id);
         if (it != buffers_.end())
         {
-            return it->second.get();
+            return it->second;
         }
 
-        auto info         = std::make_unique<BufferResourceInfo>();
+        auto info         = buffer_infos_.make();
         info->handle      = handle;
         info->desc        = desc;
         info->state       = {};
         info->is_external = false;
         info->buffer      = create_buffer(desc);
 
-        BufferResourceInfo* ptr = info.get();
-        buffers_[id]            = std::move(info);
-        return ptr;
+        buffers_[id] = info.get();
+        return info.release();
     }
 
     ImageResourceInfo* RenderGraphResourcePool::import_image(
@@ -92,7 +94,7 @@ namespace vulkan_engine::rendering
     {
         uint32_t id = handle.id();
 
-        auto info              = std::make_unique<ImageResourceInfo>();
+        auto info              = image_infos_.make();
         info->handle           = handle;
         info->desc.type        = ResourceDesc::Type::Image;
         info->desc.width       = width;
@@ -104,9 +106,14 @@ namespace vulkan_engine::rendering
         // Note: We don't own the image, so we don't create a wrapper
         info->state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-        ImageResourceInfo* ptr = info.get();
-        images_[id]            = std::move(info);
-        return ptr;
+        // Importing the same handle again replaces the record
+        if (auto it = images_.find(id); it != images_.end())
+        {
+            image_infos_.destroy(it->second);
+        }
+
+        images_[id] = info.get();
+        return info.release();
     }
 
     ImageResourceInfo* RenderGraphResourcePool::get_image(ImageHandle handle)
@@ -114,7 +121,7 @@ namespace vulkan_engine::rendering
         auto it = images_.find(handle.id());
         if (it != images_.end())
         {
-            return it->second.get();
+            return it->second;
         }
         return nullptr;
     }
@@ -124,7 +131,7 @@ namespace vulkan_engine::rendering
         auto it = buffers_.find(handle.id());
         if (it != buffers_.end())
         {
-            return it->second.get();
+            return it->second;
         }
         return nullptr;
     }
@@ -138,7 +145,14 @@ namespace vulkan_engine::rendering
             {
                 vkDestroyImageView(device_->device(), info->view, nullptr);
             }
+            image_infos_.destroy(info);
+        }
+        for (auto& [id, info] : buffers_)
+        {
+            buffer_infos_.destroy(info);
         }
+
+        // clear() keeps the bucket arrays and returns the nodes to table_resource_
         images_.clear();
         buffers_.clear();
     }
@@ -262,13 +276,9 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        vkCmdPipelineBarrier(
-                             cmd.handle(),
+        cmd.pipeline_barrier(
                              batch.src_stage,
                              batch.dst_stage,
-                             0,
-                             0,
-                             nullptr,
                              static_cast<uint32_t>(batch.buffer_barriers.size()),
                              batch.buffer_barriers.empty() ? nullptr : batch.buffer_barriers.data(),
                              static_cast<uint32_t>(batch.image_barriers.size()),
@@ -318,14 +328,12 @@ namespace vulkan_engine::rendering
         }
     }
 
-    BarrierBatch BarrierManager::get_barriers_for_pass(uint32_t pass_index) const
+    void BarrierManager::get_barriers_for_pass(uint32_t pass_index, BarrierBatch& batch) const
     {
-        BarrierBatch batch;
-
         auto it = pass_transitions_.find(pass_index);
         if (it == pass_transitions_.end())
         {
-            return batch;
+            return;
         }
 
         // Build barriers from transitions
@@ -367,8 +375,6 @@ namespace vulkan_engine::rendering
                 batch.dst_stage |= transition.to.stage;
             }
         }
-
-        return batch;
     }
 
     void BarrierManager::clear()
@@ -210,24 +210,24 @@ namespace vulkan_engine::rendering
                                                          });
 
         logger::info("Created transient resources:");
-        logger::info("  - GBuffer Position: ID=" + std::to_string(gbuffer_position.id()));
-        logger::info("  - GBuffer Normal: ID=" + std::to_string(gbuffer_normal.id()));
-        logger::info("  - GBuffer Albedo: ID=" + std::to_string(gbuffer_albedo.id()));
-        logger::info("  - Lighting Buffer: ID=" + std::to_string(lighting_buffer.id()));
+        logger::info("  - GBuffer Position: ID=", gbuffer_position.id());
+        logger::info("  - GBuffer Normal: ID=", gbuffer_normal.id());
+        logger::info("  - GBuffer Albedo: ID=", gbuffer_albedo.id());
+        logger::info("  - Lighting Buffer: ID=", lighting_buffer.id());
 
         // Create passes
         GBufferPass::Config gbuffer_config;
         gbuffer_config.position_output = gbuffer_position;
         gbuffer_config.normal_output   = gbuffer_normal;
         gbuffer_config.albedo_output   = gbuffer_albedo;
-        render_graph.builder().add_node(std::make_unique<GBufferPass>(gbuffer_config));
+        render_graph.builder().emplace_node<GBufferPass>(gbuffer_config);
 
         DeferredLightingPass::Config lighting_config;
         lighting_config.position_input  = gbuffer_position;
         lighting_config.normal_input    = gbuffer_normal;
         lighting_config.albedo_input    = gbuffer_albedo;
         lighting_config.lighting_output = lighting_buffer;
-        render_graph.builder().add_node(std::make_unique<DeferredLightingPass>(lighting_config));
+        render_graph.builder().emplace_node<DeferredLightingPass>(lighting_config);
 
         // Compile render graph - this triggers barrier generation
         logger::info("\nCompiling Render Graph...");
@@ -0,0 +1,254 @@
+#include "engine/rendering/resources/GeometryBuffer.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include "engine/rhi/vulkan/memory/AllocationTracker.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
+#include "engine/rhi/vulkan/utils/VulkanError.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace vulkan_engine::rendering
+{
+    GeometryBuffer::GeometryBuffer(std::shared_ptr<vulkan::DeviceManager> device, const Config& config)
+        : device_(std::move(device))
+        , config_(config)
+        , vertex_allocator_(config.vertex_capacity, config.max_allocations)
+        , index_allocator_(config.index_capacity, config.max_allocations)
+    {
+        if (config_.vertex_stride == 0)
+        {
+            throw std::runtime_error("GeometryBuffer requires a vertex stride");
+        }
+
+        vulkan::memory::AllocationScope scope(vulkan::memory::AllocationCategory::Mesh, "GeometryBuffer");
+
+        // Every draw reads these, so they live in VRAM on discrete GPUs. Integrated GPUs
+        // have one memory pool, where a staging copy would only add work.
+        host_visible_ = device_->properties().deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
+
+        const VkMemoryPropertyFlags properties = host_visible_ ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                                                               : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        // TRANSFER_SRC so defragmentation can move them
+        const VkBufferUsageFlags transfer = host_visible_ ? 0 : VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+        vertex_buffer_ = std::make_unique<vulkan::Buffer>(
+                                                          device_,
+                                                          static_cast<VkDeviceSize>(config_.vertex_capacity) * config_.vertex_stride,
+                                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | transfer,
+                                                          properties);
+        index_buffer_ = std::make_unique<vulkan::Buffer>(
+                                                         device_,
+                                                         static_cast<VkDeviceSize>(config_.index_capacity) * sizeof(uint32_t),
+                                                         VK_BUFFER_USAGE_INDEX_BUFFER_BIT | transfer,
+                                                         properties);
+
+        logger::info("GeometryBuffer created: ", config_.vertex_capacity, " vertices, ", config_.index_capacity, " indices (",
+                     host_visible_ ? "host-visible" : "device-local", ")");
+    }
+
+    GeometryBuffer::~GeometryBuffer() = default;
+
+    GeometrySlice GeometryBuffer::allocate(uint32_t vertex_count, uint32_t index_count)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        GeometrySlice slice;
+        slice.vertices = vertex_allocator_.allocate(vertex_count);
+        if (!slice.vertices.isValid())
+        {
+            return {};
+        }
+
+        slice.indices = index_allocator_.allocate(index_count);
+        if (!slice.indices.isValid())
+        {
+            vertex_allocator_.free(slice.vertices);
+            return {};
+        }
+
+        slice.vertex_count = vertex_count;
+        slice.index_count  = index_count;
+        return slice;
+    }
+
+    void GeometryBuffer::free(const GeometrySlice& slice)
+    {
+        if (!slice.valid())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.push_back({slice, frame_});
+    }
+
+    void GeometryBuffer::write(const GeometrySlice& slice, const void* vertices, const uint32_t* indices)
+    {
+        if (!slice.valid())
+        {
+            return;
+        }
+
+        const VkDeviceSize vertex_bytes  = static_cast<VkDeviceSize>(slice.vertex_count) * config_.vertex_stride;
+        const VkDeviceSize vertex_offset = static_cast<VkDeviceSize>(slice.vertices.offset) * config_.vertex_stride;
+        const VkDeviceSize index_bytes   = static_cast<VkDeviceSize>(slice.index_count) * sizeof(uint32_t);
+        const VkDeviceSize index_offset  = static_cast<VkDeviceSize>(slice.indices.offset) * sizeof(uint32_t);
+
+        if (host_visible_)
+        {
+            vertex_buffer_->write(vertices, vertex_bytes, vertex_offset);
+            index_buffer_->write(indices, index_bytes, index_offset);
+            return;
+        }
+
+        if (vertex_bytes + index_bytes > 0)
+        {
+            upload(vertices, vertex_bytes, vertex_offset, indices, index_bytes, index_offset);
+        }
+    }
+
+    void GeometryBuffer::upload(
+        const void*     vertices,
+        VkDeviceSize    vertex_bytes,
+        VkDeviceSize    vertex_offset,
+        const uint32_t* indices,
+        VkDeviceSize    index_bytes,
+        VkDeviceSize    index_offset)
+    {
+        // One staging buffer from the Staging pool holds the vertices followed by the indices
+        auto staging = std::make_unique<vulkan::Buffer>(
+                                                        device_,
+                                                        vertex_bytes + index_bytes,
+                                                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        staging->write(vertices, vertex_bytes, 0);
+        staging->write(indices, index_bytes, vertex_bytes);
+
+        VkCommandPool           command_pool = VK_NULL_HANDLE;
+        VkCommandPoolCreateInfo pool_info{};
+        pool_info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_info.queueFamilyIndex = device_->graphics_queue_family();
+        pool_info.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+        VkResult result = vkCreateCommandPool(device_->device(), &pool_info, nullptr, &command_pool);
+        if (result != VK_SUCCESS)
+        {
+            throw vulkan::VulkanError(result, "Failed to create geometry upload command pool", __FILE__, __LINE__);
+        }
+
+        VkCommandBuffer             command_buffer = VK_NULL_HANDLE;
+        VkCommandBufferAllocateInfo cmd_alloc_info{};
+        cmd_alloc_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        cmd_alloc_info.commandPool        = command_pool;
+        cmd_alloc_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        cmd_alloc_info.commandBufferCount = 1;
+
+        result = vkAllocateCommandBuffers(device_->device(), &cmd_alloc_info, &command_buffer);
+        if (result != VK_SUCCESS)
+        {
+            vkDestroyCommandPool(device_->device(), command_pool, nullptr);
+            throw vulkan::VulkanError(result, "Failed to allocate geometry upload command buffer", __FILE__, __LINE__);
+        }
+
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(command_buffer, &begin_info);
+
+        VkBufferCopy vertex_region{0, vertex_offset, vertex_bytes};
+        VkBufferCopy index_region{vertex_bytes, index_offset, index_bytes};
+        if (vertex_bytes > 0)
+        {
+            vkCmdCopyBuffer(command_buffer, staging->handle(), vertex_buffer_->handle(), 1, &vertex_region);
+        }
+        if (index_bytes > 0)
+        {
+            vkCmdCopyBuffer(command_buffer, staging->handle(), index_buffer_->handle(), 1, &index_region);
+        }
+
+        // Make the copies visible to vertex input of every later submission
+        VkMemoryBarrier barrier{};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+
+        vkCmdPipelineBarrier(
+                             command_buffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        vkEndCommandBuffer(command_buffer);
+
+        VkSubmitInfo submit_info{};
+        submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers    = &command_buffer;
+
+        // Same as TextureLoader: nothing waits, the staging buffer and the pool go once the copy has retired
+        vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+        const uint64_t         value    = timeline->submit(&submit_info, 1);
+        if (vulkan::DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            staging->retire(*deletion_queue);
+            deletion_queue->defer(command_pool);
+        }
+        else
+        {
+            timeline->wait(value);
+            vkFreeCommandBuffers(device_->device(), command_pool, 1, &command_buffer);
+            vkDestroyCommandPool(device_->device(), command_pool, nullptr);
+        }
+    }
+
+    void GeometryBuffer::begin_frame()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        ++frame_;
+        auto retired_end = std::remove_if(
+                                          retired_.begin(),
+                                          retired_.end(),
+                                          [this](const RetiredSlice& retired)
+                                          {
+                                              if (frame_ - retired.frame < config_.frames_in_flight)
+                                              {
+                                                  return false;
+                                              }
+                                              vertex_allocator_.free(retired.slice.vertices);
+                                              index_allocator_.free(retired.slice.indices);
+                                              return true;
+                                          });
+        retired_.erase(retired_end, retired_.end());
+    }
+
+    void GeometryBuffer::bind(vulkan::RenderCommandBuffer& cmd) const
+    {
+        cmd.bind_vertex_buffer(vertex_buffer_->handle(), 0);
+        cmd.bind_index_buffer(index_buffer_->handle(), VK_INDEX_TYPE_UINT32);
+    }
+
+    GeometryBuffer::Stats GeometryBuffer::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto vertices = vertex_allocator_.storageReport();
+        auto indices  = index_allocator_.storageReport();
+
+        Stats stats;
+        stats.allocation_count      = vertex_allocator_.allocationCount();
+        stats.free_vertices         = vertices.totalFree;
+        stats.free_indices          = indices.totalFree;
+        stats.largest_free_vertices = vertices.largestFree;
+        stats.largest_free_indices  = indices.largestFree;
+        stats.pending_frees         = static_cast<uint32_t>(retired_.size());
+        return stats;
+    }
+} // namespace vulkan_engine::rendering
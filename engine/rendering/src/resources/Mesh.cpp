@@ -1,9 +1,70 @@
 #include "engine/rendering/resources/Mesh.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/rhi/vulkan/memory/AllocationTracker.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include <cstring>
 
 namespace vulkan_engine::rendering
 {
+    Mesh::~Mesh()
+    {
+        release_residency();
+        release_slice();
+    }
+
+    Mesh::Mesh(Mesh&& other) noexcept
+        : device_(std::move(other.device_))
+        , vertex_buffer_(std::move(other.vertex_buffer_))
+        , index_buffer_(std::move(other.index_buffer_))
+        , vertex_count_(other.vertex_count_)
+        , index_count_(other.index_count_)
+        , name_(std::move(other.name_))
+        , geometry_(std::move(other.geometry_))
+        , slice_(other.slice_)
+        , governor_(std::move(other.governor_))
+        , residency_handle_(other.residency_handle_)
+        , evicted_data_(std::move(other.evicted_data_))
+    {
+        other.residency_handle_ = vulkan::memory::BudgetGovernor::INVALID_HANDLE;
+        other.slice_            = {};
+
+        // The callbacks captured the old address
+        if (auto governor = governor_.lock())
+        {
+            governor->setCallbacks(residency_handle_, residency_callbacks());
+        }
+    }
+
+    Mesh& Mesh::operator=(Mesh&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release_residency();
+            release_slice();
+
+            device_           = std::move(other.device_);
+            vertex_buffer_    = std::move(other.vertex_buffer_);
+            index_buffer_     = std::move(other.index_buffer_);
+            vertex_count_     = other.vertex_count_;
+            index_count_      = other.index_count_;
+            name_             = std::move(other.name_);
+            geometry_         = std::move(other.geometry_);
+            slice_            = other.slice_;
+            governor_         = std::move(other.governor_);
+            residency_handle_ = other.residency_handle_;
+            evicted_data_     = std::move(other.evicted_data_);
+
+            other.residency_handle_ = vulkan::memory::BudgetGovernor::INVALID_HANDLE;
+            other.slice_            = {};
+
+            if (auto governor = governor_.lock())
+            {
+                governor->setCallbacks(residency_handle_, residency_callbacks());
+            }
+        }
+        return *this;
+    }
+
     void Mesh::upload(std::shared_ptr<vulkan::DeviceManager> device, const MeshData& data)
     {
         device_ = device;
@@ -15,10 +76,84 @@ namespace vulkan_engine::rendering
             return;
         }
 
+        // Re-register so the governor sees the new size
+        auto governor = governor_.lock();
+        release_residency();
+        evicted_data_.clear();
+        release_slice();
+
+        create_buffers(data);
+
+        if (governor)
+        {
+            enable_residency(governor);
+        }
+
+        logger::info("Mesh '", name_, "' uploaded to GPU: ", vertex_count_, " vertices, ", index_count_, " indices");
+    }
+
+    void Mesh::upload(std::shared_ptr<GeometryBuffer> geometry, std::shared_ptr<vulkan::DeviceManager> device, const MeshData& data)
+    {
+        if (!geometry)
+        {
+            upload(std::move(device), data);
+            return;
+        }
+
+        device_ = device;
+        name_   = data.name;
+
+        if (data.is_empty())
+        {
+            logger::warn("Mesh::upload called with empty mesh data");
+            return;
+        }
+
+        release_residency();
+        release_slice();
+        evicted_data_.clear();
+        vertex_buffer_.reset();
+        index_buffer_.reset();
+
+        GeometrySlice slice = geometry->allocate(
+                                                 static_cast<uint32_t>(data.vertices.size()),
+                                                 static_cast<uint32_t>(data.indices.size()));
+        if (!slice.valid())
+        {
+            logger::warn("GeometryBuffer full, mesh '" + name_ + "' gets dedicated buffers");
+            upload(std::move(device), data);
+            return;
+        }
+
+        geometry->write(slice, data.vertices.data(), data.indices.data());
+
+        geometry_     = std::move(geometry);
+        slice_        = slice;
+        vertex_count_ = slice.vertex_count;
+        index_count_  = slice.index_count;
+
+        logger::info("Mesh '", name_, "' sub-allocated: ", vertex_count_, " vertices at ", slice.vertices.offset, ", ",
+                     index_count_, " indices at ", slice.indices.offset);
+    }
+
+    void Mesh::release_slice()
+    {
+        if (geometry_)
+        {
+            geometry_->free(slice_);
+        }
+        geometry_.reset();
+        slice_ = {};
+    }
+
+    void Mesh::create_buffers(const MeshData& data)
+    {
+        vulkan::memory::AllocationScope scope(vulkan::memory::AllocationCategory::Mesh, name_);
+
         // Create vertex buffer
         VkDeviceSize vertex_buffer_size = sizeof(MeshVertex) * data.vertices.size();
         vertex_buffer_                  = std::make_unique<vulkan::Buffer>(
-                                                          device,
+                                                          device_,
                                                           vertex_buffer_size,
                                                           VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
@@ -32,7 +167,7 @@ namespace vulkan_engine::rendering
         // Create index buffer
         VkDeviceSize index_buffer_size = sizeof(uint32_t) * data.indices.size();
         index_buffer_                  = std::make_unique<vulkan::Buffer>(
-                                                         device,
+                                                         device_,
                                                          index_buffer_size,
                                                          VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                                                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
@@ -42,14 +177,114 @@ namespace vulkan_engine::rendering
         index_buffer_->unmap();
 
         index_count_ = static_cast<uint32_t>(data.indices.size());
+    }
+
+    void Mesh::enable_residency(std::shared_ptr<vulkan::memory::BudgetGovernor> governor)
+    {
+        release_residency();
+        if (!governor || !vertex_buffer_)
+        {
+            return;
+        }
+
+        vulkan::memory::BudgetGovernor::ResourceDesc desc;
+        desc.name            = "mesh '" + name_ + "'";
+        desc.kind            = vulkan::memory::BudgetGovernor::ResourceKind::Mesh;
+        desc.memoryTypeIndex = vertex_buffer_->allocation()->allocationInfo().memoryTypeIndex;
+        desc.size            = vertex_buffer_->size() + index_buffer_->size();
+        desc.callbacks       = residency_callbacks();
+
+        residency_handle_ = governor->registerResource(std::move(desc));
+        governor_         = governor;
+    }
+
+    vulkan::memory::BudgetGovernor::Callbacks Mesh::residency_callbacks()
+    {
+        vulkan::memory::BudgetGovernor::Callbacks callbacks;
+        callbacks.evict  = [this]() { evict(); };
+        callbacks.reload = [this]() { return reload(); };
+        return callbacks;
+    }
+
+    void Mesh::release_residency()
+    {
+        if (auto governor = governor_.lock())
+        {
+            governor->unregisterResource(residency_handle_);
+        }
+        governor_.reset();
+        residency_handle_ = vulkan::memory::BudgetGovernor::INVALID_HANDLE;
+    }
+
+    void Mesh::evict()
+    {
+        if (!is_uploaded())
+        {
+            return;
+        }
 
-        logger::info("Mesh '" + name_ + "' uploaded to GPU: " +
-                     std::to_string(vertex_count_) + " vertices, " +
-                     std::to_string(index_count_) + " indices");
+        // Host-visible buffers, so the contents can be read back without a copy pass
+        evicted_data_.name = name_;
+        evicted_data_.vertices.resize(vertex_count_);
+        evicted_data_.indices.resize(index_count_);
+        vertex_buffer_->read(evicted_data_.vertices.data(), sizeof(MeshVertex) * vertex_count_);
+        index_buffer_->read(evicted_data_.indices.data(), sizeof(uint32_t) * index_count_);
+
+        // Frames in flight may still read them
+        if (vulkan::DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            vertex_buffer_->retire(*deletion_queue);
+            index_buffer_->retire(*deletion_queue);
+        }
+        vertex_buffer_.reset();
+        index_buffer_.reset();
     }
 
-    void Mesh::bind(vulkan::RenderCommandBuffer& cmd)
+    bool Mesh::reload()
     {
+        if (is_uploaded())
+        {
+            return true;
+        }
+        if (evicted_data_.is_empty())
+        {
+            return false;
+        }
+
+        try
+        {
+            create_buffers(evicted_data_);
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Failed to reload mesh '" + name_ + "': " + e.what());
+            vertex_buffer_.reset();
+            index_buffer_.reset();
+            return false;
+        }
+
+        evicted_data_.clear();
+        return true;
+    }
+
+    void Mesh::bind(vulkan::RenderCommandBuffer& cmd, float screen_coverage)
+    {
+        if (auto governor = governor_.lock())
+        {
+            // An evicted mesh is re-uploaded on the spot; its buffers are host-visible,
+            // so this does not wait on the GPU
+            if (!governor->touch(residency_handle_, screen_coverage))
+            {
+                governor->ensureResident(residency_handle_);
+            }
+        }
+
+        if (geometry_)
+        {
+            geometry_->bind(cmd);
+            return;
+        }
+
         if (!is_uploaded())
         {
             return;
@@ -66,6 +301,6 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        cmd.draw_indexed(index_count_, 1, 0, 0, 0);
+        cmd.draw_indexed(index_count_, 1, slice_.first_index(), slice_.vertex_offset(), 0);
     }
 } // namespace vulkan_engine::rendering
\ No newline at end of file
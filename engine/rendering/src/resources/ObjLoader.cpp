@@ -1,5 +1,6 @@
 #include "engine/rendering/resources/ObjLoader.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include "engine/core/utils/Profiler.hpp"
 #include "engine/platform/filesystem/PathUtils.hpp"
 #include <fstream>
 #include <sstream>
@@ -19,6 +20,8 @@ namespace vulkan_engine::rendering
 {
     MeshData ObjLoader::load(const std::string& path)
     {
+        PROFILE_SCOPE("ObjLoader::load");
+
         MeshData result;
         result.name = path;
 
@@ -165,7 +168,7 @@ namespace vulkan_engine::rendering
             const auto& v = result.vertices[i];
             if (std::isnan(v.position.x) || std::isnan(v.position.y) || std::isnan(v.position.z))
             {
-                logger::error("Vertex " + std::to_string(i) + " has NaN position");
+                logger::error("Vertex ", i, " has NaN position");
                 has_invalid = true;
             }
         }
@@ -175,9 +178,7 @@ namespace vulkan_engine::rendering
         {
             if (result.indices[i] >= result.vertices.size())
             {
-                logger::error("Index " + std::to_string(i) + " out of bounds: " +
-                              std::to_string(result.indices[i]) + " >= " +
-                              std::to_string(result.vertices.size()));
+                logger::error("Index ", i, " out of bounds: ", result.indices[i], " >= ", result.vertices.size());
                 has_invalid = true;
             }
         }
@@ -190,10 +191,7 @@ namespace vulkan_engine::rendering
             for (size_t i = 0; i < count; ++i)
             {
                 const auto& v = result.vertices[i];
-                logger::info("  v[" + std::to_string(i) + "]: pos=(" +
-                             std::to_string(v.position.x) + ", " +
-                             std::to_string(v.position.y) + ", " +
-                             std::to_string(v.position.z) + ")");
+                logger::info("  v[", i, "]: pos=(", v.position.x, ", ", v.position.y, ", ", v.position.z, ")");
             }
         }
 
@@ -2,9 +2,13 @@
 #include "engine/rhi/vulkan/resources/Framebuffer.hpp"
 #include "engine/rhi/vulkan/memory/VmaImage.hpp"
 #include "engine/rhi/vulkan/memory/VmaAllocator.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include "engine/core/utils/Logger.hpp"
 
+#include <algorithm>
+
 namespace vulkan_engine::rendering
 {
     RenderTarget::RenderTarget() = default;
@@ -21,6 +25,7 @@ namespace vulkan_engine::rendering
         , color_format_(other.color_format_)
         , depth_format_(other.depth_format_)
         , samples_(other.samples_)
+        , render_extent_(other.render_extent_)
         , create_color_(other.create_color_)
         , create_depth_(other.create_depth_)
         , color_image_(std::move(other.color_image_))
@@ -28,9 +33,11 @@ namespace vulkan_engine::rendering
         , depth_image_(std::move(other.depth_image_))
         , depth_image_view_(other.depth_image_view_)
         , framebuffer_(std::move(other.framebuffer_))
+        , layouts_pending_(other.layouts_pending_)
     {
         other.color_image_view_ = VK_NULL_HANDLE;
         other.depth_image_view_ = VK_NULL_HANDLE;
+        other.layouts_pending_  = false;
     }
 
     RenderTarget& RenderTarget::operator=(RenderTarget&& other) noexcept
@@ -45,6 +52,7 @@ namespace vulkan_engine::rendering
             color_format_     = other.color_format_;
             depth_format_     = other.depth_format_;
             samples_          = other.samples_;
+            render_extent_    = other.render_extent_;
             create_color_     = other.create_color_;
             create_depth_     = other.create_depth_;
             color_image_      = std::move(other.color_image_);
@@ -52,23 +60,26 @@ namespace vulkan_engine::rendering
             depth_image_      = std::move(other.depth_image_);
             depth_image_view_ = other.depth_image_view_;
             framebuffer_      = std::move(other.framebuffer_);
+            layouts_pending_  = other.layouts_pending_;
 
             other.color_image_view_ = VK_NULL_HANDLE;
             other.depth_image_view_ = VK_NULL_HANDLE;
+            other.layouts_pending_  = false;
         }
         return *this;
     }
 
     void RenderTarget::initialize(std::shared_ptr<vulkan::memory::VmaAllocator> allocator, const CreateInfo& info)
     {
-        allocator_    = allocator;
-        width_        = info.width;
-        height_       = info.height;
-        color_format_ = info.color_format;
-        depth_format_ = info.depth_format;
-        samples_      = info.samples;
-        create_color_ = info.create_color;
-        create_depth_ = info.create_depth;
+        allocator_     = allocator;
+        width_         = info.width;
+        height_        = info.height;
+        color_format_  = info.color_format;
+        depth_format_  = info.depth_format;
+        samples_       = info.samples;
+        create_color_  = info.create_color;
+        create_depth_  = info.create_depth;
+        render_extent_ = {width_, height_};
 
         create_images();
         transition_image_layout();
@@ -81,25 +92,44 @@ namespace vulkan_engine::rendering
         if (!allocator_)
             return;
 
-        VkDevice device = allocator_->device()->device().handle();
-        vkDeviceWaitIdle(device);
+        // With a deletion queue the attachments are destroyed once the frames
+        // that may still use them have retired; otherwise wait for the device.
+        vulkan::DeletionQueue* deletion_queue = allocator_->device()->deletion_queue();
+        if (!deletion_queue)
+        {
+            vkDeviceWaitIdle(allocator_->device()->device().handle());
+        }
 
         // 棣栧厛閿€姣?Framebuffer锛堝洜涓哄畠渚濊禆 ImageView锛?
         destroy_framebuffer();
 
         // 閿€姣?ImageView锛堢敱 VmaImage 绠＄悊锛?
-        if (color_image_view_ != VK_NULL_HANDLE && color_image_)
+        if (deletion_queue)
         {
-            color_image_->destroyView(color_image_view_);
-            color_image_view_ = VK_NULL_HANDLE;
+            // retire() hands over the views together with the images
+            if (color_image_)
+            {
+                color_image_->retire(*deletion_queue);
+            }
+            if (depth_image_)
+            {
+                depth_image_->retire(*deletion_queue);
+            }
         }
-        if (depth_image_view_ != VK_NULL_HANDLE && depth_image_)
+        else
         {
-            depth_image_->destroyView(depth_image_view_);
-            depth_image_view_ = VK_NULL_HANDLE;
+            if (color_image_view_ != VK_NULL_HANDLE && color_image_)
+            {
+                color_image_->destroyView(color_image_view_);
+            }
+            if (depth_image_view_ != VK_NULL_HANDLE && depth_image_)
+            {
+                depth_image_->destroyView(depth_image_view_);
+            }
         }
+        color_image_view_ = VK_NULL_HANDLE;
+        depth_image_view_ = VK_NULL_HANDLE;
 
-        // VmaImage 浼氳嚜鍔ㄦ竻鐞?
         color_image_.reset();
         depth_image_.reset();
     }
@@ -112,15 +142,25 @@ namespace vulkan_engine::rendering
         // 鍏堥攢姣?Framebuffer锛堝洜涓哄畠渚濊禆鏃х殑 ImageView锛?
         destroy_framebuffer();
 
+        // The old attachments drain through the deletion queue; the new ones
+        // are transitioned by the next frame's command buffer instead of a
+        // blocking one-off submit
         cleanup();
-        width_  = width;
-        height_ = height;
+        width_         = width;
+        height_        = height;
+        render_extent_ = {width_, height_};
         create_images();
-        transition_image_layout();
+        layouts_pending_ = true;
 
         LOG_INFO("RenderTarget resized to: " + std::to_string(width_) + "x" + std::to_string(height_));
     }
 
+    void RenderTarget::set_render_extent(uint32_t width, uint32_t height)
+    {
+        render_extent_.width  = std::clamp(width, 1u, std::max(width_, 1u));
+        render_extent_.height = std::clamp(height, 1u, std::max(height_, 1u));
+    }
+
     void RenderTarget::create_images()
     {
         if (create_color_)
@@ -173,6 +213,36 @@ namespace vulkan_engine::rendering
                                                     );
     }
 
+    void RenderTarget::record_pending_layouts(VkCommandBuffer cmd)
+    {
+        if (!layouts_pending_)
+            return;
+
+        layouts_pending_ = false;
+        record_layout_transitions(cmd);
+    }
+
+    void RenderTarget::record_layout_transitions(VkCommandBuffer cmd_buffer)
+    {
+        if (color_image_)
+        {
+            color_image_->transitionLayout(
+                                           cmd_buffer,
+                                           VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                                           vulkan::memory::ImageSubresourceRange::colorAll()
+                                          );
+        }
+
+        if (depth_image_)
+        {
+            depth_image_->transitionLayout(
+                                           cmd_buffer,
+                                           VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                                           vulkan::memory::ImageSubresourceRange::depthAll()
+                                          );
+        }
+    }
+
     void RenderTarget::transition_image_layout()
     {
         VkDevice device = allocator_->device()->device().handle();
@@ -200,23 +270,7 @@ namespace vulkan_engine::rendering
         VK_CHECK(vkBeginCommandBuffer(cmd_buffer, &begin_info));
 
         // 浣跨敤 VmaImage 鐨?transitionLayout 鏂规硶
-        if (color_image_)
-        {
-            color_image_->transitionLayout(
-                                           cmd_buffer,
-                                           VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                                           vulkan::memory::ImageSubresourceRange::colorAll()
-                                          );
-        }
-
-        if (depth_image_)
-        {
-            depth_image_->transitionLayout(
-                                           cmd_buffer,
-                                           VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                                           vulkan::memory::ImageSubresourceRange::depthAll()
-                                          );
-        }
+        record_layout_transitions(cmd_buffer);
 
         VK_CHECK(vkEndCommandBuffer(cmd_buffer));
 
@@ -225,8 +279,13 @@ namespace vulkan_engine::rendering
         submit_info.commandBufferCount = 1;
         submit_info.pCommandBuffers    = &cmd_buffer;
 
-        VK_CHECK(vkQueueSubmit(allocator_->device()->graphics_queue().handle(), 1, &submit_info, VK_NULL_HANDLE));
-        VK_CHECK(vkQueueWaitIdle(allocator_->device()->graphics_queue().handle()));
+        vulkan::QueueTimeline* timeline = allocator_->device()->graphics_timeline();
+        const uint64_t         value    = timeline->submit(&submit_info, 1);
+        if (value == 0)
+        {
+            throw vulkan::VulkanError(VK_ERROR_UNKNOWN, "Failed to submit render target layout transition", __FILE__, __LINE__);
+        }
+        timeline->wait(value);
 
         vkFreeCommandBuffers(device, cmd_pool, 1, &cmd_buffer);
         vkDestroyCommandPool(device, cmd_pool, nullptr);
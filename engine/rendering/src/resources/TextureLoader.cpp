@@ -1,4 +1,8 @@
 #include "engine/rendering/resources/TextureLoader.hpp"
+#include "engine/rhi/vulkan/resources/Buffer.hpp"
+#include "engine/rhi/vulkan/memory/AllocationTracker.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/core/utils/Logger.hpp"
 #include "engine/platform/filesystem/PathUtils.hpp"
 
@@ -6,6 +10,7 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+#include <algorithm>
 #include <fstream>
 #include <cstring>
 #include <vector>
@@ -31,6 +36,17 @@ namespace vulkan_engine::rendering
         bool               generate_mipmaps)
     {
         (void)format; // Currently always uses VK_FORMAT_R8G8B8A8_UNORM
+
+        TextureData data;
+        if (!decode_texture(path, data))
+        {
+            return nullptr;
+        }
+        return upload_texture(data, generate_mipmaps);
+    }
+
+    bool TextureLoader::decode_texture(const std::string& path, TextureData& data) const
+    {
         std::string full_path = resolve_path(path);
 
         // Load file into memory first (handles Unicode paths correctly)
@@ -38,7 +54,7 @@ namespace vulkan_engine::rendering
         if (!file.is_open())
         {
             logger::error("Failed to open texture file: " + core::PathUtils::to_string(std::filesystem::path(full_path)));
-            return nullptr;
+            return false;
         }
 
         std::streamsize file_size = file.tellg();
@@ -47,7 +63,7 @@ namespace vulkan_engine::rendering
         if (!file.read(reinterpret_cast<char*>(buffer.data()), file_size))
         {
             logger::error("Failed to read texture file: " + core::PathUtils::to_string(std::filesystem::path(full_path)));
-            return nullptr;
+            return false;
         }
         file.close();
 
@@ -59,30 +75,79 @@ namespace vulkan_engine::rendering
         {
             logger::error("Failed to load texture: " + std::string(stbi_failure_reason()) + " - " +
                           core::PathUtils::to_string(std::filesystem::path(full_path)));
-            return nullptr;
+            return false;
         }
 
-        logger::info("Loaded texture: " + core::PathUtils::to_string(std::filesystem::path(full_path)) + " (" + std::to_string(width) + "x" +
-                     std::to_string(height) + ", " + std::to_string(channels) +
+        logger::info("Loaded texture: ", core::PathUtils::to_string(std::filesystem::path(full_path)), " (", width, "x", height, ", ", channels,
                      " channels)");
 
-        // Create GPU image
-        auto image = create_image_from_data(pixels, width, height, 4, generate_mipmaps);
+        data.path   = full_path;
+        data.width  = static_cast<uint32_t>(width);
+        data.height = static_cast<uint32_t>(height);
+        data.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
 
         // Free stb_image data
         stbi_image_free(pixels);
 
-        return image;
+        return true;
     }
 
-    std::string TextureLoader::resolve_path(const std::string& path) const
+    std::shared_ptr<vulkan::Image> TextureLoader::upload_texture(const TextureData& data, bool generate_mipmaps)
     {
-        // 直接写死路径
-        std::string full_path = "D:/TechArt/Vulkan/Textures/" + path;
+        if (data.pixels.empty())
+        {
+            return nullptr;
+        }
+        vulkan::memory::AllocationScope scope(vulkan::memory::AllocationCategory::Texture, data.path);
+        return create_image_from_data(data.pixels.data(), data.width, data.height, 4, generate_mipmaps);
+    }
+
+    bool TextureLoader::downsample(TextureData& data)
+    {
+        if (data.pixels.empty() || (data.width <= 1 && data.height <= 1))
+        {
+            return false;
+        }
+
+        const uint32_t width  = data.width > 1 ? data.width / 2 : 1;
+        const uint32_t height = data.height > 1 ? data.height / 2 : 1;
 
-        if (std::filesystem::exists(full_path))
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+        for (uint32_t y = 0; y < height; ++y)
         {
-            return full_path;
+            // Odd or unit source dimensions clamp to the last row/column
+            const uint32_t y0 = std::min(y * 2, data.height - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, data.height - 1);
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, data.width - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, data.width - 1);
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const uint32_t sum = data.pixels[(static_cast<size_t>(y0) * data.width + x0) * 4 + c] +
+                                         data.pixels[(static_cast<size_t>(y0) * data.width + x1) * 4 + c] +
+                                         data.pixels[(static_cast<size_t>(y1) * data.width + x0) * 4 + c] +
+                                         data.pixels[(static_cast<size_t>(y1) * data.width + x1) * 4 + c];
+                    pixels[(static_cast<size_t>(y) * width + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        data.pixels = std::move(pixels);
+        data.width  = width;
+        data.height = height;
+        return true;
+    }
+
+    std::string TextureLoader::resolve_path(const std::string& path) const
+    {
+        // Relative to the configured texture directory first, then the project texture directory
+        for (const auto& candidate : {std::filesystem::path(base_directory_ + path), core::PathUtils::textures_dir() / path})
+        {
+            if (std::filesystem::exists(candidate))
+            {
+                return candidate.string();
+            }
         }
 
         // Fallback: try path as-is
@@ -91,7 +156,7 @@ namespace vulkan_engine::rendering
             return path;
         }
 
-        return full_path;
+        return base_directory_ + path;
     }
 
     std::shared_ptr<vulkan::Image> TextureLoader::create_image_from_data(
@@ -106,52 +171,26 @@ namespace vulkan_engine::rendering
         // Create staging buffer
         VkDeviceSize image_size = width * height * channels;
 
-        VkBuffer       staging_buffer;
-        VkDeviceMemory staging_memory;
-
-        VkBufferCreateInfo buffer_info{};
-        buffer_info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_info.size        = image_size;
-        buffer_info.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-        if (vkCreateBuffer(device_->device(), &buffer_info, nullptr, &staging_buffer) != VK_SUCCESS)
+        // Sub-allocated from the Staging pool and released at the end of the upload
+        std::unique_ptr<vulkan::Buffer> staging;
+        try
         {
-            logger::error("Failed to create staging buffer for texture");
-            return nullptr;
+            staging = std::make_unique<vulkan::Buffer>(
+                                                       device_,
+                                                       image_size,
+                                                       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
         }
-
-        VkMemoryRequirements mem_requirements;
-        vkGetBufferMemoryRequirements(device_->device(), staging_buffer, &mem_requirements);
-
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize  = mem_requirements.size;
-        alloc_info.memoryTypeIndex = device_->find_memory_type(
-                                                               mem_requirements.memoryTypeBits,
-                                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        if (vkAllocateMemory(device_->device(), &alloc_info, nullptr, &staging_memory) != VK_SUCCESS)
+        catch (const std::exception& e)
         {
-            vkDestroyBuffer(device_->device(), staging_buffer, nullptr);
-            logger::error("Failed to allocate staging memory for texture");
+            logger::error(std::string("Failed to create staging buffer for texture: ") + e.what());
             return nullptr;
         }
-
-        vkBindBufferMemory(device_->device(), staging_buffer, staging_memory, 0);
-
-        // Copy pixel data to staging buffer
-        void* data;
-        vkMapMemory(device_->device(), staging_memory, 0, image_size, 0, &data);
-        memcpy(data, pixel_data, static_cast<size_t>(image_size));
-        vkUnmapMemory(device_->device(), staging_memory);
+        staging->write(pixel_data, image_size);
 
         // Create GPU image
-        VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        if (generate_mipmaps)
-        {
-            usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-        }
+        // TRANSFER_SRC for mip generation, and so defragmentation can copy the image out
+        VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
 
         auto image = std::make_shared<vulkan::Image>(
                                                      device_,
@@ -229,7 +268,7 @@ namespace vulkan_engine::rendering
 
         vkCmdCopyBufferToImage(
                                command_buffer,
-                               staging_buffer,
+                               staging->handle(),
                                image->handle(),
                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                1,
@@ -363,19 +402,26 @@ namespace vulkan_engine::rendering
         submit_info.commandBufferCount = 1;
         submit_info.pCommandBuffers    = &command_buffer;
 
-        vkQueueSubmit(device_->graphics_queue(), 1, &submit_info, VK_NULL_HANDLE);
-        vkQueueWaitIdle(device_->graphics_queue());
-
-        // Cleanup
-        vkFreeCommandBuffers(device_->device(), command_pool, 1, &command_buffer);
-        vkDestroyCommandPool(device_->device(), command_pool, nullptr);
-        vkFreeMemory(device_->device(), staging_memory, nullptr);
-        vkDestroyBuffer(device_->device(), staging_buffer, nullptr);
+        // Frames that sample the image are submitted to the same queue after the copy, so
+        // nothing waits here: the staging buffer and the pool go once the copy has retired
+        vulkan::QueueTimeline* timeline = device_->graphics_timeline();
+        const uint64_t         value    = timeline->submit(&submit_info, 1);
+        if (vulkan::DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            staging->retire(*deletion_queue);
+            deletion_queue->defer(command_pool);
+        }
+        else
+        {
+            timeline->wait(value);
+            vkFreeCommandBuffers(device_->device(), command_pool, 1, &command_buffer);
+            vkDestroyCommandPool(device_->device(), command_pool, nullptr);
+        }
 
         // Update image layout tracking (TextureLoader already emitted barriers)
         image->set_layout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-        logger::info("Created GPU texture with " + std::to_string(mip_levels) + " mip levels");
+        logger::info("Created GPU texture with ", mip_levels, " mip levels");
 
         return image;
     }
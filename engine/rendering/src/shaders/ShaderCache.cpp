@@ -0,0 +1,138 @@
+#include "engine/rendering/shaders/ShaderCache.hpp"
+#include "engine/platform/filesystem/PathUtils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace vulkan_engine::rendering
+{
+    ShaderCache::ShaderCache(std::filesystem::path directory)
+        : directory_(std::move(directory))
+    {
+    }
+
+    std::filesystem::path ShaderCache::entry_path(const std::string& key) const
+    {
+        return directory_ / (key + ".spv");
+    }
+
+    bool ShaderCache::load(const std::string& key, std::vector<uint32_t>& bytecode) const
+    {
+        auto file = core::PathUtils::open_input_file(entry_path(key), std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        auto file_size = static_cast<size_t>(file.tellg());
+        if (file_size == 0 || file_size % 4 != 0)
+        {
+            return false;
+        }
+
+        bytecode.resize(file_size / sizeof(uint32_t));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytecode.data()), file_size);
+
+        return file.good() && bytecode[0] == 0x07230203;
+    }
+
+    bool ShaderCache::store(const std::string& key, const std::vector<uint32_t>& bytecode) const
+    {
+        static std::atomic<uint32_t> temp_counter{0};
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+
+        // Unique temporary name per write, then an atomic rename into place
+        std::filesystem::path temp_path = directory_ / (key + "." + std::to_string(temp_counter++) + ".tmp");
+        {
+            auto file = core::PathUtils::open_output_file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(bytecode.data()), bytecode.size() * sizeof(uint32_t));
+            if (!file.good())
+            {
+                file.close();
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temp_path, entry_path(key), ec);
+        if (ec)
+        {
+            // Another thread may have published the same entry first; either copy is valid
+            std::filesystem::remove(temp_path, ec);
+            return std::filesystem::exists(entry_path(key));
+        }
+        return true;
+    }
+
+    uint64_t ShaderCache::hash_bytes(const void* data, size_t size, uint64_t seed)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t    hash  = seed;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    uint64_t ShaderCache::hash_string(const std::string& text, uint64_t seed)
+    {
+        // Include the length so concatenated fields cannot alias ("ab"+"c" vs "a"+"bc")
+        uint64_t length = text.size();
+        return hash_bytes(text.data(), text.size(), hash_bytes(&length, sizeof(length), seed));
+    }
+
+    bool ShaderCache::hash_file(const std::filesystem::path& path, uint64_t& hash)
+    {
+        auto file = core::PathUtils::open_input_file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        hash = hash_string(contents);
+        return true;
+    }
+
+    std::string ShaderCache::to_hex(uint64_t value)
+    {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+
+    std::string ShaderCache::permutation_key(const std::unordered_map<std::string, std::string>& defines)
+    {
+        std::vector<std::string> entries;
+        entries.reserve(defines.size());
+        for (const auto& [name, value] : defines)
+        {
+            entries.push_back(value.empty() ? name : name + "=" + value);
+        }
+        std::sort(entries.begin(), entries.end());
+
+        std::string key;
+        for (const auto& entry : entries)
+        {
+            if (!key.empty())
+            {
+                key += ";";
+            }
+            key += entry;
+        }
+        return key;
+    }
+} // namespace vulkan_engine::rendering
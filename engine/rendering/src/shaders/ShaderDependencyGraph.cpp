@@ -0,0 +1,120 @@
+#include "engine/rendering/shaders/ShaderDependencyGraph.hpp"
+
+namespace vulkan_engine::rendering
+{
+    void ShaderDependencyGraph::add_edge(const std::string& dependency, const std::string& dependent)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dependents_[dependency].insert(dependent);
+        dependencies_[dependent].insert(dependency);
+    }
+
+    void ShaderDependencyGraph::clear_dependencies(const std::string& dependent)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = dependencies_.find(dependent);
+        if (it == dependencies_.end())
+        {
+            return;
+        }
+
+        for (const auto& dependency : it->second)
+        {
+            auto users = dependents_.find(dependency);
+            if (users != dependents_.end())
+            {
+                users->second.erase(dependent);
+                if (users->second.empty())
+                {
+                    dependents_.erase(users);
+                }
+            }
+        }
+        dependencies_.erase(it);
+    }
+
+    void ShaderDependencyGraph::remove_node(const std::string& node)
+    {
+        clear_dependencies(node);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = dependents_.find(node);
+        if (it == dependents_.end())
+        {
+            return;
+        }
+
+        for (const auto& dependent : it->second)
+        {
+            auto inputs = dependencies_.find(dependent);
+            if (inputs != dependencies_.end())
+            {
+                inputs->second.erase(node);
+                if (inputs->second.empty())
+                {
+                    dependencies_.erase(inputs);
+                }
+            }
+        }
+        dependents_.erase(it);
+    }
+
+    std::set<std::string> ShaderDependencyGraph::collect_affected(const std::vector<std::string>& changed) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::set<std::string>    affected;
+        std::vector<std::string> pending(changed.begin(), changed.end());
+        while (!pending.empty())
+        {
+            std::string node = std::move(pending.back());
+            pending.pop_back();
+
+            auto it = dependents_.find(node);
+            if (it == dependents_.end())
+            {
+                continue;
+            }
+
+            for (const auto& dependent : it->second)
+            {
+                if (affected.insert(dependent).second)
+                {
+                    pending.push_back(dependent);
+                }
+            }
+        }
+        return affected;
+    }
+
+    std::set<std::string> ShaderDependencyGraph::dependencies_of(const std::string& node) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto                        it = dependencies_.find(node);
+        return it != dependencies_.end() ? it->second : std::set<std::string>{};
+    }
+
+    bool ShaderDependencyGraph::contains(const std::string& node) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dependents_.count(node) > 0 || dependencies_.count(node) > 0;
+    }
+
+    size_t ShaderDependencyGraph::node_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::set<std::string> nodes;
+        for (const auto& [node, _] : dependents_)
+        {
+            nodes.insert(node);
+        }
+        for (const auto& [node, _] : dependencies_)
+        {
+            nodes.insert(node);
+        }
+        return nodes.size();
+    }
+} // namespace vulkan_engine::rendering
@@ -0,0 +1,397 @@
+#include "engine/rendering/shaders/ShaderHotReloader.hpp"
+#include "engine/platform/filesystem/PathUtils.hpp"
+#include "engine/rhi/vulkan/pipelines/ShaderModule.hpp"
+#include "engine/core/utils/Logger.hpp"
+
+#include <algorithm>
+#include <set>
+
+namespace vulkan_engine::rendering
+{
+    namespace
+    {
+        std::string file_node(const std::filesystem::path& path)
+        {
+            return filesystem::FileWatcher::normalize(path).string();
+        }
+
+        std::string material_node(const Material* material)
+        {
+            return "material:" + std::to_string(reinterpret_cast<uintptr_t>(material));
+        }
+
+        // shaders/pbr.vert.spv -> shaders/pbr.slang
+        std::filesystem::path slang_source_for(const std::filesystem::path& spirv_path)
+        {
+            return spirv_path.parent_path() / (spirv_path.stem().stem().string() + ".slang");
+        }
+
+        // Write through a temporary file so readers never see a partial module
+        bool write_spirv(const std::filesystem::path& path, const std::vector<uint32_t>& bytecode)
+        {
+            std::filesystem::path temp_path = path;
+            temp_path += ".tmp";
+            {
+                auto file = core::PathUtils::open_output_file(temp_path, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                {
+                    return false;
+                }
+                file.write(reinterpret_cast<const char*>(bytecode.data()),
+                           static_cast<std::streamsize>(bytecode.size() * sizeof(uint32_t)));
+                if (!file)
+                {
+                    return false;
+                }
+            }
+
+            std::error_code ec;
+            std::filesystem::rename(temp_path, path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+            return true;
+        }
+    } // namespace
+
+    ShaderHotReloader::ShaderHotReloader(std::shared_ptr<ShaderManager> shader_manager, const Config& config)
+        : shader_manager_(std::move(shader_manager)), config_(config)
+    {
+        auto on_change = [this](const std::vector<std::filesystem::path>& files)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                changed_files_.insert(changed_files_.end(), files.begin(), files.end());
+            }
+            wake_.notify_one();
+        };
+
+        worker_  = std::thread([this]() { worker_loop(); });
+        watcher_ = std::make_unique<filesystem::FileWatcher>(on_change, config_.watcher);
+        watcher_->start();
+
+        logger::info(std::string("Shader hot reload enabled (") +
+                     (watcher_->backend() == filesystem::FileWatcher::Backend::Inotify ? "inotify" : "polling") + ")");
+    }
+
+    ShaderHotReloader::~ShaderHotReloader()
+    {
+        // No new events, then let the worker finish its current batch
+        watcher_.reset();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (worker_.joinable())
+        {
+            worker_.join();
+        }
+    }
+
+    void ShaderHotReloader::track_material(const std::shared_ptr<Material>& material)
+    {
+        if (!material)
+        {
+            return;
+        }
+
+        std::string node = material_node(material.get());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto it = materials_.begin(); it != materials_.end();)
+            {
+                if (it->second.expired())
+                {
+                    graph_.remove_node(it->first);
+                    it = materials_.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            materials_[node]         = material;
+            stats_.tracked_materials = static_cast<uint32_t>(materials_.size());
+        }
+
+        struct Stage
+        {
+            const std::string& path;
+            ShaderType         type;
+            const char*        entry_point;
+        };
+
+        graph_.clear_dependencies(node);
+        for (const Stage& stage : {Stage{material->vertex_shader_path(), ShaderType::Vertex, ShaderManager::VERTEX_ENTRY_POINT},
+                                   Stage{material->fragment_shader_path(), ShaderType::Fragment, ShaderManager::FRAGMENT_ENTRY_POINT}})
+        {
+            std::filesystem::path spirv_path = filesystem::FileWatcher::normalize(stage.path);
+            graph_.add_edge(spirv_path.string(), node);
+            watch_directory(spirv_path.parent_path());
+
+            // Recompile from source when the .slang file sits next to the SPIR-V
+            std::filesystem::path source_path = slang_source_for(spirv_path);
+            std::error_code       ec;
+            if (!shader_manager_ || !std::filesystem::exists(source_path, ec))
+            {
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto&                       outputs = sources_[source_path.string()];
+                bool                        known   = std::any_of(outputs.begin(), outputs.end(),
+                                                                  [&](const SourceOutput& output) { return output.spirv_path == spirv_path; });
+                if (!known)
+                {
+                    outputs.push_back({spirv_path, stage.type, stage.entry_point});
+                }
+            }
+
+            graph_.add_edge(source_path.string(), spirv_path.string());
+            record_source_dependencies(source_path);
+        }
+    }
+
+    uint32_t ShaderHotReloader::apply_pending()
+    {
+        ++frame_counter_;
+
+        std::vector<ReadyPipeline> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready.swap(ready_);
+        }
+
+        uint32_t swapped = 0;
+        for (auto& entry : ready)
+        {
+            auto material = entry.material.lock();
+            if (!material)
+            {
+                continue; // Never bound, safe to destroy right away
+            }
+
+            auto old_pipeline = material->swap_pipeline(std::move(entry.pipeline));
+            if (old_pipeline)
+            {
+                retired_.push_back({std::move(old_pipeline), frame_counter_});
+            }
+            ++swapped;
+            logger::info("Hot reloaded material " + material->name());
+        }
+
+        // A retired pipeline may still be referenced by every frame in flight
+        retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                      [this](const RetiredPipeline& retired)
+                                      {
+                                          return frame_counter_ - retired.retire_frame >= config_.frames_in_flight;
+                                      }),
+                       retired_.end());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.pipelines_swapped += swapped;
+        stats_.retired_pipelines = static_cast<uint32_t>(retired_.size());
+        return swapped;
+    }
+
+    ShaderHotReloader::Stats ShaderHotReloader::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void ShaderHotReloader::watch_directory(const std::filesystem::path& directory)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (std::find(watched_directories_.begin(), watched_directories_.end(), directory) != watched_directories_.end())
+            {
+                return;
+            }
+            watched_directories_.push_back(directory);
+        }
+        watcher_->add_directory(directory);
+    }
+
+    void ShaderHotReloader::record_source_dependencies(const std::filesystem::path& source)
+    {
+        ShaderCompileInfo info;
+        info.name        = source.stem().string();
+        info.source_path = source;
+
+        std::string source_node = file_node(source);
+        graph_.clear_dependencies(source_node);
+        for (const auto& dependency : shader_manager_->resolve_dependencies(info))
+        {
+            graph_.add_edge(file_node(dependency), source_node);
+            watch_directory(filesystem::FileWatcher::normalize(dependency).parent_path());
+        }
+    }
+
+    void ShaderHotReloader::worker_loop()
+    {
+        while (true)
+        {
+            std::vector<std::filesystem::path> changed;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this]() { return stopping_ || !changed_files_.empty(); });
+                if (stopping_)
+                {
+                    return;
+                }
+                changed.swap(changed_files_);
+            }
+
+            process_changes(changed);
+        }
+    }
+
+    void ShaderHotReloader::process_changes(const std::vector<std::filesystem::path>& changed)
+    {
+        std::vector<std::string> changed_nodes;
+        std::vector<std::string> changed_spirv;
+        for (const auto& path : changed)
+        {
+            changed_nodes.push_back(path.string());
+            if (path.extension() == ".spv")
+            {
+                changed_spirv.push_back(path.string());
+            }
+        }
+
+        // Sources first. Recompiling rewrites their SPIR-V, which comes back from the
+        // watcher as a .spv change and rebuilds the materials in a later batch.
+        std::set<std::string> candidates = graph_.collect_affected(changed_nodes);
+        candidates.insert(changed_nodes.begin(), changed_nodes.end());
+
+        std::vector<std::string> sources;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& node : candidates)
+            {
+                if (sources_.count(node))
+                {
+                    sources.push_back(node);
+                }
+            }
+        }
+        for (const auto& source : sources)
+        {
+            recompile_source(source);
+        }
+
+        // Materials downstream of SPIR-V that changed on disk
+        if (changed_spirv.empty())
+        {
+            return;
+        }
+        for (const auto& node : graph_.collect_affected(changed_spirv))
+        {
+            if (node.rfind("material:", 0) == 0)
+            {
+                rebuild_material(node);
+            }
+        }
+    }
+
+    bool ShaderHotReloader::recompile_source(const std::string& source)
+    {
+        std::vector<SourceOutput> outputs;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            outputs = sources_[source];
+        }
+
+        std::vector<ShaderCompileInfo> infos(outputs.size());
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            infos[i].name        = outputs[i].spirv_path.stem().string();
+            infos[i].type        = outputs[i].type;
+            infos[i].source_path = source;
+            infos[i].entry_point = outputs[i].entry_point;
+        }
+
+        auto results = shader_manager_->compile_variants(infos);
+        for (const auto& result : results)
+        {
+            if (!result.success)
+            {
+                logger::error("Hot reload: failed to compile " + source + ": " + result.error_message);
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.failures;
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            // Leave untouched output alone (e.g. a comment-only edit) so no rebuild follows
+            auto current = shader_manager_->load_spirv(outputs[i].spirv_path, outputs[i].type);
+            if (current.success && current.bytecode == results[i].bytecode)
+            {
+                continue;
+            }
+
+            if (!write_spirv(outputs[i].spirv_path, results[i].bytecode))
+            {
+                logger::error("Hot reload: failed to write " + outputs[i].spirv_path.string());
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.failures;
+                return false;
+            }
+        }
+
+        // Imports may have been added or removed by the edit
+        record_source_dependencies(source);
+
+        logger::info("Hot reload: recompiled " + source);
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.sources_recompiled;
+        return true;
+    }
+
+    void ShaderHotReloader::rebuild_material(const std::string& node)
+    {
+        std::shared_ptr<Material> material;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = materials_.find(node);
+            if (it == materials_.end() || !(material = it->second.lock()))
+            {
+                return;
+            }
+        }
+
+        try
+        {
+            auto reflection = vulkan::ShaderReflection::reflect(vulkan::ShaderModule::load_spirv_from_file(material->vertex_shader_path()));
+            reflection.merge(vulkan::ShaderReflection::reflect(vulkan::ShaderModule::load_spirv_from_file(material->fragment_shader_path())));
+
+            if (!material->is_layout_compatible(reflection))
+            {
+                logger::warn("Hot reload: shader interface of material " + material->name() +
+                             " changed, reload the material to pick up the new layout");
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.failures;
+                return;
+            }
+
+            auto pipeline = material->create_pipeline();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back({material, std::move(pipeline)});
+            ++stats_.pipelines_rebuilt;
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Hot reload: failed to rebuild material " + material->name() + ": " + e.what());
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.failures;
+        }
+    }
+} // namespace vulkan_engine::rendering
@@ -1,11 +1,120 @@
 #include "engine/rendering/shaders/ShaderManager.hpp"
+#include "engine/rendering/shaders/ShaderCache.hpp"
+#include "engine/platform/filesystem/FileWatcher.hpp"
 #include "engine/platform/filesystem/PathUtils.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
 
 namespace vulkan_engine::rendering
 {
+    namespace
+    {
+        const char* slang_stage_name(ShaderType type)
+        {
+            switch (type)
+            {
+                case ShaderType::Vertex: return "vertex";
+                case ShaderType::Fragment: return "fragment";
+                case ShaderType::Geometry: return "geometry";
+                case ShaderType::Compute: return "compute";
+                case ShaderType::TessellationControl: return "hull";
+                case ShaderType::TessellationEvaluation: return "domain";
+            }
+            return "vertex";
+        }
+
+        std::string quote(const std::filesystem::path& path)
+        {
+            return "\"" + path.string() + "\"";
+        }
+
+        // Module names referenced by `import foo.bar;`, `__include foo;` or `#include "foo.slang"`
+        std::vector<std::string> scan_dependencies(const std::string& source)
+        {
+            std::vector<std::string> dependencies;
+            std::istringstream       stream(source);
+            std::string              line;
+            while (std::getline(stream, line))
+            {
+                size_t start = line.find_first_not_of(" \t");
+                if (start == std::string::npos)
+                {
+                    continue;
+                }
+                line = line.substr(start);
+
+                if (line.rfind("#include", 0) == 0)
+                {
+                    size_t open  = line.find_first_of("\"<");
+                    size_t close = line.find_first_of("\">", open + 1);
+                    if (open != std::string::npos && close != std::string::npos)
+                    {
+                        dependencies.push_back(line.substr(open + 1, close - open - 1));
+                    }
+                    continue;
+                }
+
+                for (const char* keyword : {"import ", "__include "})
+                {
+                    std::string prefix = keyword;
+                    if (line.rfind(prefix, 0) == 0)
+                    {
+                        std::string module = line.substr(prefix.size());
+                        module             = module.substr(0, module.find_first_of("; \t\r"));
+                        if (!module.empty() && module.front() == '"')
+                        {
+                            dependencies.push_back(module.substr(1, module.find('"', 1) - 1));
+                        }
+                        else
+                        {
+                            // Slang maps dotted module names to directories and '_' to '-'
+                            std::replace(module.begin(), module.end(), '.', '/');
+                            std::replace(module.begin(), module.end(), '_', '-');
+                            dependencies.push_back(module + ".slang");
+                        }
+                    }
+                }
+            }
+            return dependencies;
+        }
+
+        bool read_text_file(const std::filesystem::path& path, std::string& text)
+        {
+            auto file = core::PathUtils::open_input_file(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            text.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return true;
+        }
+
+        // Dependency graph node names
+        std::string file_node(const std::filesystem::path& path)
+        {
+            return filesystem::FileWatcher::normalize(path).string();
+        }
+
+        std::string program_node(const std::string& program_key)
+        {
+            return "program:" + program_key;
+        }
+    } // namespace
+
     struct ShaderManager::Impl
     {
         std::unordered_map<std::string, std::shared_ptr<ShaderProgram>> programs;
@@ -16,8 +125,129 @@ namespace vulkan_engine::rendering
         bool                  enable_cache      = true;
         bool                  enable_hot_reload = false;
 
+        // Compiler
+        std::string    compiler = "slangc";
+        std::string    compiler_version;
+        std::once_flag compiler_version_once;
+
         // Hot reload tracking
-        std::unordered_map<std::string, std::filesystem::file_time_type> file_timestamps;
+        ShaderDependencyGraph              graph;
+        std::vector<std::filesystem::path> changed_files; // Filled by the watcher thread
+        std::mutex                         mutex;         // Guards changed_files
+
+        // Declared last so the watcher thread stops before the state it writes to is destroyed
+        std::unique_ptr<filesystem::FileWatcher> watcher;
+
+        std::filesystem::path cache_path() const
+        {
+            return cache_directory.empty() ? shader_directory / ".cache" : std::filesystem::path(cache_directory);
+        }
+
+        const std::string& query_compiler_version()
+        {
+            std::call_once(compiler_version_once, [this]()
+            {
+                compiler_version = "unknown";
+                std::string command = compiler + " -version 2>&1";
+                if (FILE* pipe = popen(command.c_str(), "r"))
+                {
+                    std::string output;
+                    char        buffer[256];
+                    while (fgets(buffer, sizeof(buffer), pipe))
+                    {
+                        output += buffer;
+                    }
+                    if (pclose(pipe) == 0 && !output.empty())
+                    {
+                        compiler_version = output.substr(0, output.find_first_of("\r\n"));
+                    }
+                }
+            });
+            return compiler_version;
+        }
+
+        // Hash of every input that can change the compiled output. Returns an empty
+        // key if the source or one of its imports cannot be read. The files of all
+        // resolved imports are appended to resolved when given.
+        std::string cache_key(const ShaderCompileInfo&            info,
+                              const std::string&                  source,
+                              std::vector<std::filesystem::path>* resolved = nullptr)
+        {
+            uint64_t hash = ShaderCache::hash_string(source);
+            hash          = ShaderCache::hash_string(info.entry_point, hash);
+            hash          = ShaderCache::hash_string(slang_stage_name(info.type), hash);
+            hash          = ShaderCache::hash_string(ShaderCache::permutation_key(info.defines), hash);
+            hash          = ShaderCache::hash_string(query_compiler_version(), hash);
+
+            // Transitive imports, in a stable order
+            std::vector<std::filesystem::path> search_dirs;
+            search_dirs.push_back(info.source_path.empty() ? shader_directory : info.source_path.parent_path());
+            search_dirs.insert(search_dirs.end(), info.include_paths.begin(), info.include_paths.end());
+
+            bool                     hash_valid = true;
+            std::set<std::string>    visited;
+            std::vector<std::string> pending = scan_dependencies(source);
+            while (!pending.empty())
+            {
+                std::string dependency = pending.back();
+                pending.pop_back();
+                if (!visited.insert(dependency).second)
+                {
+                    continue;
+                }
+
+                bool found = false;
+                for (const auto& dir : search_dirs)
+                {
+                    std::string text;
+                    if (read_text_file(dir / dependency, text))
+                    {
+                        auto nested = scan_dependencies(text);
+                        pending.insert(pending.end(), nested.begin(), nested.end());
+                        hash  = ShaderCache::hash_string(dependency, hash);
+                        hash  = ShaderCache::hash_string(text, hash);
+                        found = true;
+                        if (resolved)
+                        {
+                            resolved->push_back(dir / dependency);
+                        }
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    hash_valid = false; // Unresolved (possibly built-in) module: do not cache
+                }
+            }
+
+            return hash_valid ? ShaderCache::to_hex(hash) : std::string();
+        }
+
+        // Record source -> import edges so an edited import reaches every program using it
+        void record_dependencies(const std::filesystem::path& source_path, const std::vector<std::filesystem::path>& imports)
+        {
+            std::string source = file_node(source_path);
+            graph.clear_dependencies(source);
+            for (const auto& dependency : imports)
+            {
+                graph.add_edge(file_node(dependency), source);
+            }
+        }
+
+        std::vector<std::string> take_changed_files()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            std::vector<std::string> changed;
+            changed.reserve(changed_files.size());
+            for (const auto& path : changed_files)
+            {
+                changed.push_back(path.string());
+            }
+            changed_files.clear();
+            return changed;
+        }
     };
 
     ShaderManager::ShaderManager()
@@ -34,6 +264,7 @@ namespace vulkan_engine::rendering
 
     void ShaderManager::shutdown()
     {
+        impl_->watcher.reset();
         impl_->programs.clear();
         impl_->compiled_shaders.clear();
     }
@@ -49,22 +280,27 @@ namespace vulkan_engine::rendering
 
         // Try to load pre-compiled SPIR-V files
         // Slang naming convention: {name}.vert.spv, {name}.frag.spv
-        auto vertex_shader   = load_shader(name + ".vert.spv", ShaderType::Vertex);
-        auto fragment_shader = load_shader(name + ".frag.spv", ShaderType::Fragment);
+        std::filesystem::path vertex_path     = name + ".vert.spv";
+        std::filesystem::path fragment_path   = name + ".frag.spv";
+        auto                  vertex_shader   = load_shader(vertex_path, ShaderType::Vertex);
+        auto                  fragment_shader = load_shader(fragment_path, ShaderType::Fragment);
 
         // If not found, try alternative naming
         if (!vertex_shader.success)
         {
-            vertex_shader = load_shader(name + "_vert.spv", ShaderType::Vertex);
+            vertex_path   = name + "_vert.spv";
+            vertex_shader = load_shader(vertex_path, ShaderType::Vertex);
         }
         if (!fragment_shader.success)
         {
-            fragment_shader = load_shader(name + "_frag.spv", ShaderType::Fragment);
+            fragment_path   = name + "_frag.spv";
+            fragment_shader = load_shader(fragment_path, ShaderType::Fragment);
         }
 
         if (!vertex_shader.success || !fragment_shader.success)
         {
-            return nullptr;
+            // No pre-compiled SPIR-V: build the default permutation from {name}.slang
+            return load_shader_program(name, {});
         }
 
         // Create program
@@ -73,10 +309,98 @@ namespace vulkan_engine::rendering
         program->vertex_shader   = std::move(vertex_shader);
         program->fragment_shader = std::move(fragment_shader);
 
+        try
+        {
+            for (const auto* stage : {&program->vertex_shader, &program->fragment_shader})
+            {
+                if (stage->reflection)
+                {
+                    program->reflection.merge(*stage->reflection);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Shader program '" + name + "' has incompatible stage interfaces: " + e.what());
+            return nullptr;
+        }
+
+        impl_->graph.clear_dependencies(program_node(name));
+        impl_->graph.add_edge(file_node(impl_->shader_directory / vertex_path), program_node(name));
+        impl_->graph.add_edge(file_node(impl_->shader_directory / fragment_path), program_node(name));
+
         impl_->programs[name] = program;
         return program;
     }
 
+    std::shared_ptr<ShaderProgram> ShaderManager::load_shader_program(
+        const std::string&                                  name,
+        const std::unordered_map<std::string, std::string>& defines)
+    {
+        std::string permutation = ShaderCache::permutation_key(defines);
+        std::string program_key = permutation.empty() ? name : name + "#" + permutation;
+
+        auto it = impl_->programs.find(program_key);
+        if (it != impl_->programs.end())
+        {
+            return it->second;
+        }
+
+        std::filesystem::path source_path = impl_->shader_directory / (name + ".slang");
+
+        std::vector<ShaderCompileInfo> stages(2);
+        stages[0].name        = name + ".vert";
+        stages[0].type        = ShaderType::Vertex;
+        stages[0].entry_point = VERTEX_ENTRY_POINT;
+        stages[1].name        = name + ".frag";
+        stages[1].type        = ShaderType::Fragment;
+        stages[1].entry_point = FRAGMENT_ENTRY_POINT;
+        for (auto& stage : stages)
+        {
+            stage.source_path = source_path;
+            stage.defines     = defines;
+        }
+
+        // Recorded before compiling so a failed build is retried when the source is fixed
+        impl_->graph.clear_dependencies(program_node(program_key));
+        impl_->graph.add_edge(file_node(source_path), program_node(program_key));
+
+        auto results = compile_variants(stages);
+        for (const auto& result : results)
+        {
+            if (!result.success)
+            {
+                logger::error("Failed to build shader program '" + program_key + "': " + result.error_message);
+                return nullptr;
+            }
+        }
+
+        auto program             = std::make_shared<ShaderProgram>();
+        program->name            = name;
+        program->defines         = defines;
+        program->vertex_shader   = std::move(results[0]);
+        program->fragment_shader = std::move(results[1]);
+
+        try
+        {
+            for (const auto* stage : {&program->vertex_shader, &program->fragment_shader})
+            {
+                if (stage->reflection)
+                {
+                    program->reflection.merge(*stage->reflection);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            logger::error("Shader program '" + program_key + "' has incompatible stage interfaces: " + e.what());
+            return nullptr;
+        }
+
+        impl_->programs[program_key] = program;
+        return program;
+    }
+
     ShaderCompileResult ShaderManager::load_shader(const std::filesystem::path& path, ShaderType type)
     {
         ShaderCompileResult result;
@@ -95,15 +419,6 @@ namespace vulkan_engine::rendering
                                    ". Expected .spv (pre-compiled SPIR-V)";
         }
 
-        if (result.success)
-        {
-            // Store timestamp for hot reload
-            if (std::filesystem::exists(full_path))
-            {
-                impl_->file_timestamps[path.string()] = std::filesystem::last_write_time(full_path);
-            }
-        }
-
         return result;
     }
 
@@ -148,6 +463,17 @@ namespace vulkan_engine::rendering
             return result;
         }
 
+        // Reflect once here so every consumer of the cached result shares it
+        try
+        {
+            result.reflection = std::make_shared<const vulkan::ShaderReflection>(
+                                                                                vulkan::ShaderReflection::reflect(result.bytecode));
+        }
+        catch (const std::exception& e)
+        {
+            result.warnings.push_back(std::string("SPIR-V reflection failed: ") + e.what());
+        }
+
         result.success = true;
         return result;
     }
@@ -160,12 +486,161 @@ namespace vulkan_engine::rendering
         result.type    = info.type;
         result.version = info.version;
 
-        // Runtime compilation not supported - use pre-compiled .spv files
-        // For Slang shaders, use compile_slang() method or pre-compile using slangc
-        result.error_message = "Runtime shader compilation not supported. "
-                "Please use pre-compiled .spv files or call compile_slang() for Slang shaders.";
+        ShaderCache           cache(impl_->cache_path());
+        std::filesystem::path source_path = info.source_path;
+        std::string           source;
 
-        return result;
+        if (!source_path.empty())
+        {
+            if (!read_text_file(source_path, source))
+            {
+                result.error_message = "Failed to open shader source: " + source_path.string();
+                return result;
+            }
+        }
+        else if (!info.source.empty())
+        {
+            // slangc works on files; give inline source a content-addressed one
+            source      = info.source;
+            source_path = cache.directory() / ("inline_" + ShaderCache::to_hex(ShaderCache::hash_string(source)) + ".slang");
+
+            std::error_code ec;
+            std::filesystem::create_directories(cache.directory(), ec);
+            if (!std::filesystem::exists(source_path))
+            {
+                auto file = core::PathUtils::open_output_file(source_path, std::ios::binary);
+                file << source;
+            }
+        }
+        else
+        {
+            result.error_message = "ShaderCompileInfo for '" + info.name + "' has no source";
+            return result;
+        }
+
+        std::vector<std::filesystem::path> imports;
+        result.cache_key = impl_->cache_key(info, source, &imports);
+        if (!info.source_path.empty())
+        {
+            impl_->record_dependencies(info.source_path, imports);
+        }
+
+        // Cache hit: no compiler invocation at all
+        if (impl_->enable_cache && !result.cache_key.empty() && cache.load(result.cache_key, result.bytecode))
+        {
+            auto cached       = load_spirv(cache.entry_path(result.cache_key), info.type);
+            cached.name       = info.name;
+            cached.version    = info.version;
+            cached.cache_key  = result.cache_key;
+            cached.from_cache = cached.success;
+            if (cached.success)
+            {
+                return cached;
+            }
+            result.bytecode.clear();
+        }
+
+        // Cache miss: compile into a unique temporary file
+        static std::atomic<uint32_t> output_counter{0};
+
+        std::error_code ec;
+        std::filesystem::create_directories(cache.directory(), ec);
+        std::string           stem        = result.cache_key.empty() ? info.name : result.cache_key;
+        std::string           unique      = stem + "." + std::to_string(output_counter++);
+        std::filesystem::path output_path = cache.directory() / (unique + ".out.spv");
+        std::filesystem::path log_path    = cache.directory() / (unique + ".log");
+
+        std::string command = impl_->compiler + " " + quote(source_path) +
+                              " -target spirv" +
+                              " -stage " + slang_stage_name(info.type) +
+                              " -entry " + info.entry_point +
+                              " -o " + quote(output_path);
+        for (const auto& [name, value] : info.defines)
+        {
+            command += " -D" + name + (value.empty() ? "" : "=" + value);
+        }
+        for (const auto& include : info.include_paths)
+        {
+            command += " -I " + quote(include);
+        }
+        command += " 2> " + quote(log_path);
+
+#ifdef _WIN32
+        // cmd.exe strips the outermost quotes of the whole command line
+        command = "\"" + command + "\"";
+#endif
+
+        int exit_code = std::system(command.c_str());
+
+        std::string log;
+        read_text_file(log_path, log);
+        std::filesystem::remove(log_path, ec);
+
+        if (exit_code != 0 || !std::filesystem::exists(output_path))
+        {
+            result.error_message = "slangc failed for " + source_path.string() + " (" + slang_stage_name(info.type) + ", " +
+                                   info.entry_point + ")" + (log.empty() ? "" : ":\n" + log);
+            std::filesystem::remove(output_path, ec);
+            return result;
+        }
+
+        auto compiled      = load_spirv(output_path, info.type);
+        compiled.name      = info.name;
+        compiled.version   = info.version;
+        compiled.cache_key = result.cache_key;
+        if (!log.empty())
+        {
+            compiled.warnings.push_back(log);
+        }
+
+        if (compiled.success && impl_->enable_cache && !compiled.cache_key.empty())
+        {
+            cache.store(compiled.cache_key, compiled.bytecode);
+        }
+        std::filesystem::remove(output_path, ec);
+
+        return compiled;
+    }
+
+    std::vector<ShaderCompileResult> ShaderManager::compile_variants(const std::vector<ShaderCompileInfo>& infos)
+    {
+        std::vector<ShaderCompileResult> results(infos.size());
+        if (infos.empty())
+        {
+            return results;
+        }
+
+        // Each variant hits the cache or compiles independently, so workers only
+        // share the job counter; slangc processes provide the actual parallelism
+        std::atomic<size_t> next_job{0};
+
+        auto worker = [&]()
+        {
+            for (size_t job = next_job++; job < infos.size(); job = next_job++)
+            {
+                results[job] = compile_shader(infos[job]);
+            }
+        };
+
+        size_t worker_count = std::min<size_t>(infos.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; ++i)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+
+        size_t cached = std::count_if(results.begin(), results.end(), [](const ShaderCompileResult& r) { return r.from_cache; });
+        logger::debug("ShaderManager: ", infos.size(), " variants, ", cached, " from cache");
+
+        return results;
     }
 
     ShaderCompileResult ShaderManager::compile_slang(
@@ -173,13 +648,19 @@ namespace vulkan_engine::rendering
         ShaderType                   type,
         const std::string&           entry_point)
     {
-        ShaderCompileResult result;
-        result.success = false;
-        result.name    = source_path.stem().string();
-        result.type    = type;
+        ShaderCompileInfo info;
+        info.name        = source_path.stem().string();
+        info.type        = type;
+        info.source_path = source_path;
+        info.entry_point = entry_point;
 
-        // Check if slangc is available
-        // For now, just check if the expected output .spv file exists
+        ShaderCompileResult result = compile_shader(info);
+        if (result.success)
+        {
+            return result;
+        }
+
+        // Fall back to a pre-compiled .spv next to the source (e.g. slangc not installed)
         std::filesystem::path spv_path = source_path;
         spv_path.replace_extension();
 
@@ -193,55 +674,85 @@ namespace vulkan_engine::rendering
                 spv_path += ".frag.spv";
                 break;
             default:
-                result.error_message = "Unsupported shader type for Slang compilation";
                 return result;
         }
 
-        // Check if pre-compiled .spv exists
         if (std::filesystem::exists(spv_path))
         {
-            result = load_spirv(spv_path, type);
-            if (result.success)
+            auto precompiled = load_spirv(spv_path, type);
+            if (precompiled.success)
             {
-                // Store timestamp for hot reload tracking
-                impl_->file_timestamps[source_path.string()] = std::filesystem::last_write_time(source_path);
+                precompiled.warnings.push_back(result.error_message);
+                return precompiled;
             }
-            return result;
         }
 
-        // If .spv doesn't exist, report error with instructions
-        result.error_message = "Pre-compiled SPIR-V not found: " + spv_path.string() +
-                               "\nPlease compile Slang shader using: "
-                               "slangc -target spirv -stage " +
-                               (type == ShaderType::Vertex ? "vertex" : "fragment") +
-                               " -entry " + entry_point + " " + source_path.string() +
-                               " -o " + spv_path.string();
         return result;
     }
 
+    std::vector<std::filesystem::path> ShaderManager::resolve_dependencies(const ShaderCompileInfo& info)
+    {
+        std::string source = info.source;
+        if (!info.source_path.empty() && !read_text_file(info.source_path, source))
+        {
+            return {};
+        }
+
+        std::vector<std::filesystem::path> imports;
+        impl_->cache_key(info, source, &imports);
+        return imports;
+    }
+
     void ShaderManager::reload_shader(const std::string& name)
     {
-        auto it = impl_->programs.find(name);
-        if (it != impl_->programs.end())
+        // Reload every permutation of the program
+        std::vector<std::unordered_map<std::string, std::string>> permutations;
+        for (auto it = impl_->programs.begin(); it != impl_->programs.end();)
         {
-            impl_->programs.erase(it);
-            load_shader_program(name);
+            if (it->second->name == name)
+            {
+                permutations.push_back(it->second->defines);
+                it = impl_->programs.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for (const auto& defines : permutations)
+        {
+            if (defines.empty())
+            {
+                load_shader_program(name);
+            }
+            else
+            {
+                load_shader_program(name, defines);
+            }
         }
     }
 
     void ShaderManager::reload_all_shaders()
     {
-        std::vector<std::string> names;
-        for (const auto& [name, _] : impl_->programs)
+        std::vector<std::pair<std::string, std::unordered_map<std::string, std::string>>> programs;
+        for (const auto& [key, program] : impl_->programs)
         {
-            names.push_back(name);
+            programs.emplace_back(program->name, program->defines);
         }
 
         impl_->programs.clear();
 
-        for (const auto& name : names)
+        for (const auto& [name, defines] : programs)
         {
-            load_shader_program(name);
+            if (defines.empty())
+            {
+                load_shader_program(name);
+            }
+            else
+            {
+                load_shader_program(name, defines);
+            }
         }
     }
 
@@ -252,23 +763,33 @@ namespace vulkan_engine::rendering
             return;
         }
 
-        for (auto& [path, last_time] : impl_->file_timestamps)
+        std::vector<std::string> changed = impl_->take_changed_files();
+        if (changed.empty())
         {
-            std::filesystem::path full_path = impl_->shader_directory / path;
-            if (!std::filesystem::exists(full_path))
+            return;
+        }
+
+        // Only the programs downstream of the changed files are rebuilt
+        const std::string prefix = program_node("");
+        for (const auto& node : impl_->graph.collect_affected(changed))
+        {
+            if (node.rfind(prefix, 0) != 0)
             {
                 continue;
             }
 
-            auto current_time = std::filesystem::last_write_time(full_path);
-            if (current_time > last_time)
+            auto it = impl_->programs.find(node.substr(prefix.size()));
+            if (it == impl_->programs.end())
             {
-                // File has been modified, reload
-                last_time = current_time;
-
-                std::string shader_name = std::filesystem::path(path).stem().string();
-                reload_shader(shader_name);
+                continue;
             }
+
+            std::string name    = it->second->name;
+            auto        defines = it->second->defines;
+            impl_->programs.erase(it);
+
+            auto program = defines.empty() ? load_shader_program(name) : load_shader_program(name, defines);
+            logger::info("Hot reloaded shader program " + node.substr(prefix.size()) + (program ? "" : " (failed)"));
         }
     }
 
@@ -282,6 +803,11 @@ namespace vulkan_engine::rendering
         impl_->cache_directory = directory;
     }
 
+    void ShaderManager::set_compiler_path(const std::string& path)
+    {
+        impl_->compiler = path;
+    }
+
     void ShaderManager::enable_caching(bool enable)
     {
         impl_->enable_cache = enable;
@@ -290,6 +816,35 @@ namespace vulkan_engine::rendering
     void ShaderManager::enable_hot_reloading(bool enable)
     {
         impl_->enable_hot_reload = enable;
+        if (!enable)
+        {
+            impl_->watcher.reset();
+            return;
+        }
+
+        if (impl_->watcher || impl_->shader_directory.empty())
+        {
+            return;
+        }
+
+        // Compiler output lands in the cache directory; those writes are not source changes
+        std::string cache_prefix = filesystem::FileWatcher::normalize(impl_->cache_path()).string();
+
+        auto on_change = [impl = impl_.get(), cache_prefix](const std::vector<std::filesystem::path>& files)
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            for (const auto& file : files)
+            {
+                if (file.string().rfind(cache_prefix, 0) != 0)
+                {
+                    impl->changed_files.push_back(file);
+                }
+            }
+        };
+
+        impl_->watcher = std::make_unique<filesystem::FileWatcher>(on_change);
+        impl_->watcher->add_directory(impl_->shader_directory);
+        impl_->watcher->start();
     }
 
     std::shared_ptr<ShaderProgram> ShaderManager::get_shader_program(const std::string& name)
@@ -303,6 +858,11 @@ namespace vulkan_engine::rendering
         return impl_->programs.find(name) != impl_->programs.end();
     }
 
+    const ShaderDependencyGraph& ShaderManager::dependency_graph() const
+    {
+        return impl_->graph;
+    }
+
     std::vector<std::string> ShaderManager::get_loaded_shader_names() const
     {
         std::vector<std::string> names;
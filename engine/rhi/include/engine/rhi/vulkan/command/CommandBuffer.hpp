@@ -12,6 +12,50 @@ namespace vulkan_engine::vulkan
     class Framebuffer;
     class GraphicsPipeline;
 
+    // Commands are counted only when the build defines VULKAN_ENGINE_ENABLE_COMMAND_STATS
+    // (CMake option of the same name); otherwise the counters stay zero and the
+    // increments compile away.
+    #if defined(VULKAN_ENGINE_ENABLE_COMMAND_STATS) && VULKAN_ENGINE_ENABLE_COMMAND_STATS
+    inline constexpr bool COMMAND_STATS_COMPILED_IN = true;
+    #else
+    inline constexpr bool COMMAND_STATS_COMPILED_IN = false;
+    #endif
+
+    // Commands recorded through a RenderCommandBuffer since begin(). The difference
+    // of two snapshots counts what was recorded in between, e.g. one render pass.
+    struct CommandStats
+    {
+        uint32_t draws            = 0;
+        uint64_t primitives       = 0; // Triangles of all draws, assuming triangle lists
+        uint32_t pipeline_binds   = 0;
+        uint32_t descriptor_binds = 0; // Sets bound, not bind calls
+        uint32_t push_constants   = 0;
+        uint32_t barriers         = 0; // Memory, buffer and image barriers, not barrier calls
+
+        CommandStats& operator+=(const CommandStats& other)
+        {
+            draws += other.draws;
+            primitives += other.primitives;
+            pipeline_binds += other.pipeline_binds;
+            descriptor_binds += other.descriptor_binds;
+            push_constants += other.push_constants;
+            barriers += other.barriers;
+            return *this;
+        }
+
+        CommandStats operator-(const CommandStats& other) const
+        {
+            CommandStats result;
+            result.draws            = draws - other.draws;
+            result.primitives       = primitives - other.primitives;
+            result.pipeline_binds   = pipeline_binds - other.pipeline_binds;
+            result.descriptor_binds = descriptor_binds - other.descriptor_binds;
+            result.push_constants   = push_constants - other.push_constants;
+            result.barriers         = barriers - other.barriers;
+            return result;
+        }
+    };
+
     // Command buffer wrapper for easy recording
     class RenderCommandBuffer
     {
@@ -85,6 +129,14 @@ namespace vulkan_engine::vulkan
                 const std::vector<VkDescriptorSet>& descriptor_sets,
                 const std::vector<uint32_t>&        dynamic_offsets = {});
 
+            // Single set without temporary vectors (per-draw hot path)
+            void bind_descriptor_set(
+                VkPipelineLayout layout,
+                uint32_t         set,
+                VkDescriptorSet  descriptor_set,
+                uint32_t         dynamic_offset_count = 0,
+                const uint32_t*  dynamic_offsets      = nullptr);
+
             // Push constants
             void push_constants(
                 VkPipelineLayout   layout,
@@ -120,6 +172,15 @@ namespace vulkan_engine::vulkan
                 VkImageLayout      new_layout,
                 VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
 
+            // Barriers; either list may be empty
+            void pipeline_barrier(
+                VkPipelineStageFlags         src_stage,
+                VkPipelineStageFlags         dst_stage,
+                uint32_t                     buffer_barrier_count,
+                const VkBufferMemoryBarrier* buffer_barriers,
+                uint32_t                     image_barrier_count,
+                const VkImageMemoryBarrier*  image_barriers);
+
             // Copy commands
             void copy_buffer_to_image(
                 VkBuffer                              src_buffer,
@@ -132,6 +193,9 @@ namespace vulkan_engine::vulkan
             bool            valid() const { return cmd_buffer_ != VK_NULL_HANDLE; }
             bool            is_recording() const { return is_recording_; }
 
+            // Counters of the current recording, reset by begin()
+            const CommandStats& stats() const { return stats_; }
+
             // Submit helpers
             void submit(
                 VkQueue                                  queue,
@@ -145,6 +209,7 @@ namespace vulkan_engine::vulkan
             VkCommandBuffer                cmd_buffer_   = VK_NULL_HANDLE;
             VkCommandPool                  pool_         = VK_NULL_HANDLE;
             bool                           is_recording_ = false;
+            CommandStats                   stats_;
     };
 
     // Command pool manager
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "engine/rhi/vulkan/device/Device.hpp"
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::vulkan
+{
+    // ============================================================================
+    // GpuProfiler - Hierarchical GPU timestamps per frame slot
+    // ============================================================================
+    // Each frame in flight owns a timestamp query pool (two queries per scope) and,
+    // optionally, a pipeline-statistics pool. Scopes nest; the results form a tree
+    // stored in pre-order with a parent index per scope. begin_frame() reads the
+    // slot's previous results with VK_QUERY_RESULT_WITH_AVAILABILITY_BIT and no
+    // wait flag, so a query the GPU has not written yet is skipped, never waited on.
+    //
+    //     profiler.begin_frame(cmd, frame_index);   // after the slot's fence wait
+    //     {
+    //         GpuProfiler::Scope frame(&profiler, cmd, "Frame");
+    //         GpuProfiler::Scope pass(&profiler, cmd, "GBuffer", true);
+    //         ...
+    //     }
+    //     for (auto& scope : profiler.results()) ...
+    //
+    // Not thread-safe; scopes must be recorded into one command buffer per frame.
+    class GpuProfiler
+    {
+        public:
+            static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+            struct Config
+            {
+                uint32_t frame_count         = 2;     // Must match frames in flight
+                uint32_t max_scopes          = 128;   // Per frame; further scopes are dropped
+                bool     pipeline_statistics = false; // Needs the pipelineStatisticsQuery feature
+                float    smoothing           = 0.05f; // Weight of the newest sample in average_ms
+            };
+
+            // Counters of VK_QUERY_TYPE_PIPELINE_STATISTICS, in query result order
+            struct PipelineStatistics
+            {
+                uint64_t input_vertices       = 0;
+                uint64_t input_primitives     = 0;
+                uint64_t vertex_invocations   = 0;
+                uint64_t clipping_primitives  = 0;
+                uint64_t fragment_invocations = 0;
+                uint64_t compute_invocations  = 0;
+            };
+
+            struct ScopeTiming
+            {
+                std::string        name;
+                uint32_t           depth          = 0;
+                uint32_t           parent         = NO_PARENT; // Index into results()
+                float              gpu_ms         = 0.0f;      // This frame
+                float              average_ms     = 0.0f;      // Exponential moving average by name and depth
+                bool               has_statistics = false;
+                PipelineStatistics statistics;
+            };
+
+            GpuProfiler(std::shared_ptr<DeviceManager> device, const Config& config);
+            ~GpuProfiler();
+
+            // Non-copyable, non-movable (scopes keep a pointer to the profiler)
+            GpuProfiler(const GpuProfiler&)            = delete;
+            GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+            // False when the graphics queue cannot write timestamps; all calls are then no-ops
+            bool is_supported() const { return supported_; }
+            bool has_pipeline_statistics() const { return statistics_enabled_; }
+
+            // Call once per frame after the slot's fence wait, before any scope and
+            // outside a render pass: resolves what the slot recorded last time and
+            // records the query resets into cmd.
+            void begin_frame(VkCommandBuffer cmd, uint32_t frame_index);
+
+            // statistics = also count pipeline statistics for this scope. Ignored
+            // while another statistics scope is open (queries of one type cannot
+            // nest); the scope must then begin and end in the same render pass.
+            void begin_scope(VkCommandBuffer cmd, std::string_view name, bool statistics = false);
+            void end_scope(VkCommandBuffer cmd);
+
+            // Scopes of the most recently resolved frame, parents before children
+            const std::vector<ScopeTiming>& results() const { return results_; }
+
+            // Smoothed time of the first root scope, 0 before any frame resolved
+            float root_average_ms() const { return results_.empty() ? 0.0f : results_.front().average_ms; }
+
+            // Unsmoothed time of the first root scope of the most recently resolved frame
+            float root_ms() const { return results_.empty() ? 0.0f : results_.front().gpu_ms; }
+
+            // Bumped by every begin_frame() that resolved a frame; tells new results from old
+            uint64_t resolved_frames() const { return resolved_frames_; }
+
+            // RAII scope; a null profiler makes it a no-op
+            class Scope
+            {
+                public:
+                    Scope(GpuProfiler* profiler, VkCommandBuffer cmd, std::string_view name, bool statistics = false)
+                        : profiler_(profiler)
+                        , cmd_(cmd)
+                    {
+                        if (profiler_)
+                        {
+                            profiler_->begin_scope(cmd_, name, statistics);
+                        }
+                    }
+
+                    ~Scope()
+                    {
+                        if (profiler_)
+                        {
+                            profiler_->end_scope(cmd_);
+                        }
+                    }
+
+                    Scope(const Scope&)            = delete;
+                    Scope& operator=(const Scope&) = delete;
+
+                private:
+                    GpuProfiler*    profiler_;
+                    VkCommandBuffer cmd_;
+            };
+
+        private:
+            static constexpr uint32_t DROPPED_SCOPE = UINT32_MAX;
+
+            struct ScopeRecord
+            {
+                std::string name;
+                uint32_t    depth      = 0;
+                uint32_t    parent     = NO_PARENT;
+                uint32_t    result     = NO_PARENT; // Index in results_ after resolve()
+                bool        closed     = false;
+                bool        statistics = false;
+            };
+
+            struct FrameSlot
+            {
+                VkQueryPool              timestamp_pool  = VK_NULL_HANDLE;
+                VkQueryPool              statistics_pool = VK_NULL_HANDLE;
+                std::vector<ScopeRecord> scopes;            // Sized max_scopes, first scope_count in use
+                uint32_t                 scope_count = 0;
+                bool                     reset       = false; // Queries reset at least once
+            };
+
+            std::shared_ptr<DeviceManager> device_;
+            Config                         config_;
+            bool                           supported_          = false;
+            bool                           statistics_enabled_ = false;
+            float                          timestamp_period_   = 1.0f; // Nanoseconds per tick
+            uint64_t                       timestamp_mask_     = ~0ull; // timestampValidBits of the queue
+
+            std::vector<FrameSlot> slots_;
+            FrameSlot*             current_          = nullptr;
+            std::vector<uint32_t>  open_scopes_;      // Stack of indices into current_->scopes
+            uint32_t               open_statistics_ = DROPPED_SCOPE;
+
+            std::vector<ScopeTiming>               results_;
+            uint64_t                               resolved_frames_ = 0;
+            std::vector<uint64_t>                  timestamp_data_;  // Value/availability pairs
+            std::vector<uint64_t>                  statistics_data_; // Counters + availability per scope
+            std::unordered_map<std::string, float> averages_;        // Keyed by depth and name
+
+            void create_pools();
+            void destroy_pools();
+            void resolve(FrameSlot& slot);
+    };
+} // namespace vulkan_engine::vulkan
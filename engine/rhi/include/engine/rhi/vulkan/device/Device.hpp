@@ -9,6 +9,14 @@
 
 namespace vulkan_engine::vulkan
 {
+    namespace memory
+    {
+        class ResourceManager;
+    }
+
+    class DeletionQueue;
+    class QueueTimeline;
+
     // Type-safe Vulkan handle wrappers
     template <typename Tag, typename HandleType> class VulkanHandleBase
     {
@@ -108,6 +116,7 @@ namespace vulkan_engine::vulkan
         bool timeline_semaphores   : 1 = false;
         bool buffer_device_address : 1 = false;
         bool descriptor_indexing   : 1 = false;
+        bool pipeline_statistics   : 1 = false;
     };
 
     // Queue family information
@@ -158,6 +167,11 @@ namespace vulkan_engine::vulkan
                 bool enable_validation  = true;
                 bool enable_debug_utils = true;
 
+                // No surface or swapchain extensions: the device only renders into
+                // offscreen targets, so it also runs on display-less software
+                // implementations such as lavapipe
+                bool headless = false;
+
                 DeviceSelectionCriteria device_criteria{};
             };
 
@@ -185,17 +199,38 @@ namespace vulkan_engine::vulkan
 
             // Feature support
             const DeviceFeatures& features() const { return features_; }
+            bool                  headless() const { return create_info_.headless; }
             bool                  supports_feature(const DeviceFeatures& required) const;
 
-            // Memory properties
+            // Device and memory properties
+            const VkPhysicalDeviceProperties&       properties() const { return properties_; }
             const VkPhysicalDeviceMemoryProperties& memory_properties() const { return memory_properties_; }
 
             // Utility functions
             uint32_t find_memory_type(uint32_t type_filter, VkMemoryPropertyFlags properties) const;
 
+            // Pooled memory for Buffer/Image/DepthBuffer/UniformBuffer. Owned by the
+            // application (it holds a reference back to this device); the device only
+            // keeps a weak reference so resources can find it.
+            void                                     set_resource_manager(std::weak_ptr<memory::ResourceManager> resource_manager);
+            std::shared_ptr<memory::ResourceManager> resource_manager() const { return resource_manager_.lock(); }
+
+            // Frame-deferred destruction shared by everything created on this device.
+            // Null before initialize() and after shutdown().
+            DeletionQueue* deletion_queue() const { return deletion_queue_.get(); }
+
+            // Timeline of the graphics queue: every frame and one-off submission goes
+            // through it, so completion of any of them is a value comparison.
+            // Null before initialize() and after shutdown().
+            QueueTimeline* graphics_timeline() const { return graphics_timeline_.get(); }
+
         private:
             CreateInfo create_info_;
 
+            std::weak_ptr<memory::ResourceManager> resource_manager_;
+            std::unique_ptr<DeletionQueue>         deletion_queue_;
+            std::unique_ptr<QueueTimeline>         graphics_timeline_;
+
             // Vulkan objects
             Instance       instance_;
             PhysicalDevice physical_device_;
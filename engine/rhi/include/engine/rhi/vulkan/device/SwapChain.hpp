@@ -56,7 +56,10 @@ namespace vulkan_engine::vulkan
             bool initialize();
             void shutdown();
 
-            // Recreate swap chain (e.g., on window resize)
+            // Recreate swap chain (e.g., on window resize). Does not wait for the
+            // device: the old swap chain is passed as oldSwapchain and retired
+            // through the device's deletion queue once frames on the new one
+            // have been submitted. Returns false while the window is minimized.
             bool recreate();
 
             // Acquire next image for rendering
@@ -92,6 +95,7 @@ namespace vulkan_engine::vulkan
 
             // Check if swap chain needs recreation
             bool needs_recreation() const { return needs_recreation_; }
+            void request_recreation() { needs_recreation_ = true; }
 
             // Create default render pass for this swap chain
             bool create_default_render_pass();
@@ -99,6 +103,10 @@ namespace vulkan_engine::vulkan
             // Create render pass with depth attachment
             bool create_render_pass_with_depth(VkFormat depth_format);
 
+            // Hands over semaphores that presents on the last retired swap chain wait
+            // on; they are released together with it
+            void retire_semaphores(const std::vector<VkSemaphore>& semaphores);
+
             // Get present queue family index
             uint32_t present_queue_family() const { return present_queue_family_; }
 
@@ -122,6 +130,17 @@ namespace vulkan_engine::vulkan
             // Images
             std::vector<SwapChainImage> images_;
 
+            // Replaced by recreate(); its images may still be presenting
+            struct RetiredSwapChain
+            {
+                VkSwapchainKHR           swap_chain = VK_NULL_HANDLE;
+                std::vector<VkImageView> views;
+                std::vector<VkSemaphore> semaphores;
+                uint64_t                 release_after = 0; // Graphics timeline value of the first frame on the new one
+            };
+
+            std::vector<RetiredSwapChain> retired_;
+
             // Queue families
             uint32_t graphics_queue_family_ = UINT32_MAX;
             uint32_t present_queue_family_  = UINT32_MAX;
@@ -139,10 +158,11 @@ namespace vulkan_engine::vulkan
             bool select_surface_format();
             bool select_present_mode();
             bool select_extent();
-            bool create_swap_chain();
+            bool create_swap_chain(VkSwapchainKHR old_swap_chain = VK_NULL_HANDLE);
             bool create_image_views();
             void cleanup_image_views();
             void cleanup_swap_chain();
+            void release_retired(bool device_idle);
 
             // Support queries
             std::vector<VkSurfaceFormatKHR> get_surface_formats() const;
@@ -55,6 +55,10 @@ namespace vulkan_engine::vulkan::memory
             // 鑾峰彇鍘熺敓鍒嗛厤鍙ユ焺
             VmaAllocation handle() const noexcept { return allocation_; }
 
+            // Gives up ownership without freeing, so the memory can be handed to a
+            // DeletionQueue. The tracker already counts it as freed.
+            VmaAllocation release() noexcept;
+
             // 鑾峰彇鍒嗛厤鍣?
             std::shared_ptr<VmaAllocator> allocator() const { return allocator_.lock(); }
 
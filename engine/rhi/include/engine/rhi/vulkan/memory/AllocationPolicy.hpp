@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace vulkan_engine::vulkan
+{
+    class DeviceManager;
+}
+
+namespace vulkan_engine::vulkan::memory
+{
+    // How long a resource lives and how often it changes
+    enum class ResourceLifetime : uint8_t
+    {
+        Static,    // Created once, lives for a level or longer (meshes, textures, render targets)
+        Dynamic,   // Rewritten by the CPU every frame or so (uniforms, host-visible buffers)
+        Transient, // Created and destroyed within a few frames
+        Streaming, // Paged in and out by the budget governor
+        Count
+    };
+
+    enum class AllocationPlacement : uint8_t
+    {
+        Pooled,    // Sub-allocated from a MemoryPoolManager pool
+        Shared,    // Sub-allocated from VMA's default blocks
+        Dedicated, // Own VkDeviceMemory
+        Count
+    };
+
+    const char* toString(ResourceLifetime lifetime);
+    const char* toString(AllocationPlacement placement);
+
+    // What the policy knows about a resource before it is allocated
+    struct AllocationRequest
+    {
+        VkDeviceSize          size          = 0;
+        bool                  image         = false;
+        VkFlags               usage         = 0; // VkBufferUsageFlags or VkImageUsageFlags
+        VkMemoryPropertyFlags properties    = 0;
+        ResourceLifetime      lifetime      = ResourceLifetime::Static;
+        bool                  poolAvailable = false; // The caller has a pool that can back it
+
+        // VK_KHR_dedicated_allocation (core in 1.1) hints from the driver
+        bool prefersDedicated  = false;
+        bool requiresDedicated = false;
+    };
+
+    struct AllocationDecision
+    {
+        AllocationPlacement      placement    = AllocationPlacement::Shared;
+        VmaAllocationCreateFlags flags        = 0; // Strategy and dedicated bits
+        float                    priority     = 0.5f;
+        bool                     driverHinted = false; // Dedicated because the driver asked for it
+        const char*              reason       = "";
+    };
+
+    // Driver's view of a resource that has not been created yet
+    struct MemoryRequirementsHint
+    {
+        VkDeviceSize size              = 0;
+        bool         prefersDedicated  = false;
+        bool         requiresDedicated = false;
+        bool         exact             = false; // false = estimated, the device lacks vkGetDevice*MemoryRequirements
+    };
+
+    // ============================================================================
+    // AllocationPolicy - Central choice of placement, strategy and priority
+    // ============================================================================
+    // Render targets and large images get dedicated memory with a high priority so
+    // the driver can place (and compress) them freely and they are the last to be
+    // demoted under pressure. Small resources go to the pools. Frequently recreated
+    // resources use the fast allocation strategy, long-lived ones the tight one.
+    // Decisions are counted per placement so the thresholds can be tuned from the
+    // stats. Thread-safe.
+    class AllocationPolicy
+    {
+        public:
+            struct Config
+            {
+                VkDeviceSize pooledMaxSize          = 4ull * 1024 * 1024;  // Larger resources would strand pool space
+                VkDeviceSize dedicatedImageMinSize  = 16ull * 1024 * 1024; // Images at least this large get own memory
+                VkDeviceSize dedicatedBufferMinSize = 64ull * 1024 * 1024;
+                VkDeviceSize driverHintMinSize      = 1ull * 1024 * 1024;  // Below this prefersDedicated is ignored
+                bool         dedicatedRenderTargets = true;
+                bool         honorDriverHints       = true;
+                float        renderTargetPriority   = 1.0f;
+                float        largeImagePriority     = 0.75f;
+                float        defaultPriority        = 0.5f;
+                float        streamingPriority      = 0.25f;
+                float        transientPriority      = 0.25f;
+            };
+
+            struct PlacementTotals
+            {
+                uint64_t     count = 0;
+                VkDeviceSize bytes = 0;
+            };
+
+            struct Stats
+            {
+                std::array<PlacementTotals, static_cast<size_t>(AllocationPlacement::Count)> placements{};
+                std::array<uint64_t, static_cast<size_t>(ResourceLifetime::Count)>           lifetimes{};
+                uint64_t                                                                     driverHinted  = 0; // Dedicated because the driver asked
+                uint64_t                                                                     poolFallbacks = 0; // Pooled decisions the pool could not serve
+            };
+
+            AllocationPolicy() = default;
+            explicit AllocationPolicy(const Config& config) : config_(config)
+            {
+            }
+
+            // Non-copyable (owns a mutex)
+            AllocationPolicy(const AllocationPolicy&)            = delete;
+            AllocationPolicy& operator=(const AllocationPolicy&) = delete;
+
+            AllocationDecision decide(const AllocationRequest& request) const;
+
+            // Writes the decision into allocInfo. Non-pooled placements drop allocInfo.pool.
+            static void apply(const AllocationDecision& decision, VmaAllocationCreateInfo& allocInfo);
+
+            // Count an allocation that was made; placement is what actually happened
+            void record(const AllocationRequest& request, const AllocationDecision& decision, AllocationPlacement placement);
+
+            Config config() const;
+            void   setConfig(const Config& config);
+            Stats  stats() const;
+            void   resetStats();
+
+            // Size and dedicated hints without creating the resource (Vulkan 1.3
+            // vkGetDevice*MemoryRequirements); estimated on older devices
+            static MemoryRequirementsHint queryImageRequirements(const DeviceManager& device, const VkImageCreateInfo& imageInfo);
+            static MemoryRequirementsHint queryBufferRequirements(const DeviceManager& device, VkDeviceSize size, VkBufferUsageFlags usage);
+
+        private:
+            mutable std::mutex mutex_;
+            Config             config_;
+            Stats              stats_;
+    };
+} // namespace vulkan_engine::vulkan::memory
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::vulkan::memory
+{
+    // What an allocation is for, to attribute VRAM to asset classes
+    enum class AllocationCategory : uint8_t
+    {
+        Unknown,
+        Mesh,
+        Texture,
+        RenderTarget,
+        Uniform,
+        Staging,
+        Storage,
+        Count
+    };
+
+    const char* toString(AllocationCategory category);
+
+    // Category derived from usage flags, used when no AllocationScope says otherwise
+    AllocationCategory categorizeBuffer(VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+    AllocationCategory categorizeImage(VkImageUsageFlags usage);
+
+    struct AllocationTag
+    {
+        AllocationCategory category = AllocationCategory::Unknown;
+        std::string        owner;
+    };
+
+    // Tags every VMA allocation made on this thread while it is alive:
+    //
+    //     AllocationScope scope(AllocationCategory::Texture, path);
+    //     auto image = loader.upload_texture(data);
+    //
+    // Scopes nest; the innermost wins. Staging buffers are always tagged Staging
+    // (with the scope's owner), so uploads do not hide inside the asset's category.
+    class AllocationScope
+    {
+        public:
+            AllocationScope(AllocationCategory category, std::string owner);
+            ~AllocationScope();
+
+            AllocationScope(const AllocationScope&)            = delete;
+            AllocationScope& operator=(const AllocationScope&) = delete;
+
+            static const AllocationTag* current();
+
+        private:
+            AllocationTag        tag_;
+            const AllocationTag* previous_ = nullptr;
+    };
+
+    // Tag for an allocation being created now: the current scope, else derived from usage
+    AllocationTag resolveBufferTag(VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+    AllocationTag resolveImageTag(VkImageUsageFlags usage);
+
+    // Live allocation table plus a ring buffer of allocate/free events.
+    //
+    // Each VmaAllocation's user data (unless the creator set its own) points at its
+    // record and its VMA name is set to "category:owner", so VMA's own JSON dump is
+    // attributed too. capture() takes a snapshot that can be diffed against another
+    // one, e.g. before and after loading a level: allocations made in between that
+    // are still alive are the leak suspects.
+    // Thread-safe.
+    class AllocationTracker
+    {
+        public:
+            static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(AllocationCategory::Count);
+
+            enum class EventType : uint8_t
+            {
+                Allocate,
+                Free
+            };
+
+            struct Event
+            {
+                uint64_t           sequence        = 0; // Of the allocation the event belongs to
+                uint64_t           frame           = 0;
+                double             timeMs          = 0.0; // Since the tracker was created
+                EventType          type            = EventType::Allocate;
+                AllocationCategory category        = AllocationCategory::Unknown;
+                VkDeviceSize       size            = 0;
+                uint32_t           memoryTypeIndex = 0;
+                std::string        owner;
+            };
+
+            struct Record
+            {
+                uint64_t           sequence        = 0; // Allocation order, unique for the tracker's lifetime
+                uint64_t           frame           = 0; // Frame it was allocated in
+                AllocationCategory category        = AllocationCategory::Unknown;
+                VkDeviceSize       size            = 0;
+                uint32_t           memoryTypeIndex = 0;
+                std::string        owner;
+            };
+
+            struct CategoryTotals
+            {
+                uint32_t     count = 0;
+                VkDeviceSize bytes = 0;
+            };
+
+            struct Snapshot
+            {
+                uint64_t                                   sequence = 0; // Last allocation sequence at capture time
+                uint64_t                                   frame    = 0;
+                double                                     timeMs   = 0.0;
+                std::array<CategoryTotals, CATEGORY_COUNT> categories{};
+                std::vector<Record>                        allocations; // Sorted by sequence
+            };
+
+            struct CategoryDelta
+            {
+                int64_t count = 0;
+                int64_t bytes = 0;
+            };
+
+            struct SnapshotDiff
+            {
+                std::array<CategoryDelta, CATEGORY_COUNT> categories{};
+                std::vector<Record>                       added; // Allocated after `before`, still alive at `after`
+                std::vector<Record>                       freed; // Alive at `before`, gone at `after`
+            };
+
+            explicit AllocationTracker(size_t eventCapacity = 4096);
+
+            // Non-copyable
+            AllocationTracker(const AllocationTracker&)            = delete;
+            AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+            // Called by VmaBuffer/VmaImage after creation and by Allocation before vmaFreeMemory
+            void onAllocate(::VmaAllocator allocator, VmaAllocation allocation, const AllocationTag& tag, VkDeviceSize size, uint32_t memoryTypeIndex);
+            void onFree(VmaAllocation allocation);
+
+            // Frame number stamped on subsequent events
+            void setFrame(uint64_t frame) { frame_ = frame; }
+
+            Snapshot                                   capture() const;
+            std::array<CategoryTotals, CATEGORY_COUNT> totals() const;
+            std::vector<Event>                         events(uint64_t sinceSequence = 0) const; // Oldest first
+            uint64_t                                   droppedEvents() const;                    // Overwritten by the ring
+
+            static SnapshotDiff diff(const Snapshot& before, const Snapshot& after);
+
+            // JSON export
+            static std::string toJson(const Snapshot& snapshot);
+            static std::string toJson(const SnapshotDiff& diff);
+            std::string        timelineJson(uint64_t sinceSequence = 0) const;
+            static bool        writeFile(const std::string& path, const std::string& json);
+
+        private:
+            mutable std::mutex                         mutex_;
+            std::unordered_map<VmaAllocation, Record>  live_;
+            std::array<CategoryTotals, CATEGORY_COUNT> totals_{};
+            uint64_t                                   nextSequence_ = 1;
+            std::atomic<uint64_t>                      frame_{0};
+
+            // Event ring
+            std::vector<Event> events_;
+            size_t             eventHead_  = 0; // Next slot to write
+            uint64_t           eventCount_ = 0; // Total events ever recorded
+
+            std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+            double elapsedMs() const;
+            void   pushEvent(Event event);
+    };
+} // namespace vulkan_engine::vulkan::memory
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkan_engine::vulkan::memory
+{
+    // Keeps every memory heap inside its VmaBudget by degrading cold resources.
+    //
+    // Textures and meshes register with callbacks that know how to shrink, drop and
+    // recreate their GPU data. Renderers touch() them when they are drawn, which
+    // records the frame and the screen coverage that make up the residency priority.
+    // update() runs once per frame: when a heap approaches its budget the coldest
+    // textures lose their top mip, and past the eviction threshold cold resources are
+    // released entirely. Touching an evicted resource queues it for reload, and
+    // demoted textures regain their mips once the heap has headroom again.
+    //
+    // Resources used within the last minIdleFrames frames are never demoted or evicted.
+    // Callbacks must not wait for the GPU either: what they release goes through the
+    // device's DeletionQueue, and descriptor sets are replaced rather than rewritten.
+    // Not thread-safe; call from the thread that records frames.
+    class BudgetGovernor
+    {
+        public:
+            using Handle                           = uint32_t;
+            static constexpr Handle INVALID_HANDLE = 0;
+
+            enum class ResourceKind
+            {
+                Texture,
+                Mesh
+            };
+
+            enum class ResidencyState
+            {
+                Resident,
+                Demoted, // Resident with fewer mip levels than it was registered with
+                Evicted  // No GPU memory; reloaded when next touched
+            };
+
+            struct Config
+            {
+                float    demoteThreshold    = 0.85f; // Heap usage / budget at which cold textures lose mips
+                float    evictThreshold     = 0.95f; // Heap usage / budget at which cold resources are evicted
+                float    targetUsage        = 0.80f; // Relief stops once the heap is projected below this
+                float    restoreThreshold   = 0.70f; // Below this, recently used demoted textures are restored
+                uint32_t minIdleFrames      = 3;     // Frames in flight + 1 keeps queued frames' resources
+                uint32_t evictIdleFrames    = 600;   // Below evictThreshold only resources idle this long are evicted
+                uint32_t maxActionsPerFrame = 8;     // Demotions + evictions per update
+                uint32_t maxReloadsPerFrame = 4;     // Reloads + restores per update
+            };
+
+            // Invoked from update() and ensureResident(); they must not register or unregister resources
+            struct Callbacks
+            {
+                std::function<VkDeviceSize()> demote; // Drop the top mip; returns the new size (unchanged if it cannot). Optional.
+                std::function<void()>         evict;  // Release all GPU memory but keep what is needed to reload
+                std::function<bool()>         reload; // Recreate at full quality; false if it failed
+            };
+
+            struct ResourceDesc
+            {
+                std::string  name;
+                ResourceKind kind            = ResourceKind::Texture;
+                uint32_t     memoryTypeIndex = 0;
+                VkDeviceSize size            = 0; // Full-quality size
+                Callbacks    callbacks;
+            };
+
+            struct HeapUsage
+            {
+                VkDeviceSize usage  = 0; // Bytes that cannot be handed out (free space inside blocks excluded)
+                VkDeviceSize budget = 0;
+
+                float ratio() const { return budget > 0 ? static_cast<float>(usage) / static_cast<float>(budget) : 0.0f; }
+            };
+
+            struct Stats
+            {
+                uint32_t               resident      = 0;
+                uint32_t               demoted       = 0;
+                uint32_t               evicted       = 0;
+                uint64_t               demotions     = 0; // Totals since creation
+                uint64_t               evictions     = 0;
+                uint64_t               reloads       = 0;
+                uint64_t               failedReloads = 0;
+                VkDeviceSize           bytesReleased = 0;
+                std::vector<HeapUsage> heaps; // As of the last update()
+            };
+
+            explicit BudgetGovernor(ResourceManagerPtr resourceManager, const Config& config = {});
+            ~BudgetGovernor() = default;
+
+            // Non-copyable
+            BudgetGovernor(const BudgetGovernor&)            = delete;
+            BudgetGovernor& operator=(const BudgetGovernor&) = delete;
+
+            Handle registerResource(ResourceDesc desc);
+            void   unregisterResource(Handle handle);
+
+            // Owners that move replace the callbacks bound to their old address
+            void setCallbacks(Handle handle, Callbacks callbacks);
+
+            // Record a use this frame. screenCoverage is the fraction of the viewport the
+            // resource covers (0 if unknown). Returns false if the resource is evicted,
+            // in which case it is reloaded by the next update().
+            bool touch(Handle handle, float screenCoverage = 0.0f);
+
+            // Reload an evicted resource immediately. Returns true if it is resident.
+            bool ensureResident(Handle handle);
+
+            // Once per frame, before recording
+            void update(uint64_t frameNumber);
+
+            ResidencyState state(Handle handle) const;
+            Stats          stats() const;
+
+            const Config& config() const { return config_; }
+            void          setConfig(const Config& config) { config_ = config; }
+
+            // Higher is more important. Recently used resources covering much of the
+            // screen rank highest; the priority halves every 60 idle frames.
+            static float priority(float screenCoverage, uint64_t idleFrames);
+
+        private:
+            struct Entry
+            {
+                ResourceDesc   desc;
+                uint32_t       heapIndex      = 0;
+                ResidencyState state          = ResidencyState::Resident;
+                VkDeviceSize   residentSize   = 0;
+                uint32_t       demotedLevels  = 0;
+                uint64_t       lastUsedFrame  = 0;
+                float          screenCoverage = 0.0f; // Largest coverage reported in lastUsedFrame
+                bool           reloadPending  = false;
+            };
+
+            ResourceManagerPtr                resourceManager_;
+            Config                            config_;
+            std::unordered_map<Handle, Entry> entries_;
+            Handle                            nextHandle_       = 1;
+            uint64_t                          currentFrame_     = 0;
+            uint32_t                          actionsThisFrame_ = 0;
+            std::vector<HeapUsage>            heaps_;
+            Stats                             totals_; // Counters only; residency counts are computed in stats()
+
+            uint64_t idleFrames(const Entry& entry) const;
+            float    entryPriority(const Entry& entry) const;
+
+            void refreshHeapUsage();
+            void relieveHeap(uint32_t heapIndex, VkDeviceSize bytesToFree, bool critical);
+            void processReloads();
+            void restoreDemoted();
+            bool reload(Entry& entry);
+    };
+
+    using BudgetGovernorPtr = std::shared_ptr<BudgetGovernor>;
+} // namespace vulkan_engine::vulkan::memory
@@ -7,6 +7,8 @@
 #include <string>
 #include <unordered_map>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace vulkan_engine::vulkan::memory
 {
@@ -51,16 +53,17 @@ namespace vulkan_engine::vulkan::memory
             MemoryPool& operator=(MemoryPool&& other) noexcept;
 
             // 鑾峰彇鍘熺敓姹犲彞鏌?
-            VmaPool handle() const noexcept { return pool_; }
-            bool    isValid() const noexcept { return pool_ != VK_NULL_HANDLE; }
+            VmaPool  handle() const noexcept { return pool_; }
+            bool     isValid() const noexcept { return pool_ != VK_NULL_HANDLE; }
+            uint32_t memoryTypeIndex() const noexcept { return memoryTypeIndex_; }
 
             // 鑾峰彇缁熻淇℃伅
             struct Stats
             {
-                VkDeviceSize size;
-                VkDeviceSize usedSize;
-                uint32_t     allocationCount;
-                uint32_t     blockCount;
+                VkDeviceSize size;            // Bytes in VkDeviceMemory blocks
+                VkDeviceSize usedSize;        // Bytes handed out to resources
+                uint32_t     allocationCount; // Resources sub-allocated from the pool
+                uint32_t     blockCount;      // vkAllocateMemory calls made by the pool
             };
 
             Stats getStats() const;
@@ -70,7 +73,8 @@ namespace vulkan_engine::vulkan::memory
 
         private:
             std::shared_ptr<VmaAllocator> allocator_;
-            VmaPool                       pool_ = VK_NULL_HANDLE;
+            VmaPool                       pool_            = VK_NULL_HANDLE;
+            uint32_t                      memoryTypeIndex_ = UINT32_MAX;
             std::string                   name_;
 
             void cleanup() noexcept;
@@ -108,6 +112,9 @@ namespace vulkan_engine::vulkan::memory
             // 鍒涘缓鑷畾涔夋睜
             MemoryPoolPtr createPool(const MemoryPool::CreateInfo& createInfo);
 
+            // Per-pool statistics, in PoolType order
+            std::vector<std::pair<PoolType, MemoryPool::Stats>> collectStats() const;
+
             // 鑾峰彇鎵€鏈夋睜鐨勭粺璁′俊鎭?
             void printStats() const;
 
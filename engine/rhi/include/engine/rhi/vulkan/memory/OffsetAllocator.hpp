@@ -0,0 +1,121 @@
+// Based on OffsetAllocator by Sebastian Aaltonen
+// https://github.com/sebbbi/OffsetAllocator
+//
+// MIT License
+//
+// Copyright (c) 2023 Sebastian Aaltonen
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace vulkan_engine::vulkan::memory
+{
+    // Two-level segregated-fit (TLSF-like) allocator over an abstract range of
+    // units. It owns no memory; callers map the offsets into a buffer of their own:
+    //
+    //     OffsetAllocator vertices(vertexCapacity);   // Units are vertices
+    //     auto range = vertices.allocate(mesh.vertexCount);
+    //     cmd.draw_indexed(indexCount, 1, firstIndex, range.offset, 0);
+    //
+    // Free ranges are kept in 256 size bins indexed by a small float (5-bit
+    // exponent, 3-bit mantissa), with a two-level bitmask over the non-empty bins,
+    // so allocate() and free() are O(1). Freed ranges are merged with their free
+    // neighbours immediately. Bookkeeping is two nodes per allocation, reserved
+    // up front. Not thread-safe.
+    class OffsetAllocator
+    {
+        public:
+            static constexpr uint32_t NO_SPACE = 0xffffffff;
+
+            struct Range
+            {
+                uint32_t offset   = NO_SPACE;
+                uint32_t metadata = NO_SPACE; // Internal node index, needed by free()
+
+                bool isValid() const noexcept { return offset != NO_SPACE; }
+            };
+
+            struct StorageReport
+            {
+                uint32_t totalFree   = 0;
+                uint32_t largestFree = 0; // Largest request that is guaranteed to succeed
+            };
+
+            explicit OffsetAllocator(uint32_t capacity, uint32_t maxAllocations = 16 * 1024);
+
+            // Non-copyable
+            OffsetAllocator(const OffsetAllocator&)            = delete;
+            OffsetAllocator& operator=(const OffsetAllocator&) = delete;
+
+            // Movable
+            OffsetAllocator(OffsetAllocator&&) noexcept            = default;
+            OffsetAllocator& operator=(OffsetAllocator&&) noexcept = default;
+
+            // Returns an invalid range when no free range is large enough or the
+            // node pool is exhausted
+            Range allocate(uint32_t size);
+            void  free(Range range);
+
+            uint32_t      rangeSize(Range range) const;
+            StorageReport storageReport() const;
+
+            // Drop every allocation
+            void reset();
+
+            uint32_t capacity() const noexcept { return capacity_; }
+            uint32_t allocationCount() const noexcept { return allocationCount_; }
+
+        private:
+            static constexpr uint32_t NUM_TOP_BINS         = 32;
+            static constexpr uint32_t BINS_PER_LEAF        = 8;
+            static constexpr uint32_t TOP_BINS_INDEX_SHIFT = 3;
+            static constexpr uint32_t LEAF_BINS_INDEX_MASK = 0x7;
+            static constexpr uint32_t NUM_LEAF_BINS        = NUM_TOP_BINS * BINS_PER_LEAF;
+            static constexpr uint32_t UNUSED               = 0xffffffff;
+
+            struct Node
+            {
+                uint32_t dataOffset   = 0;
+                uint32_t dataSize     = 0;
+                uint32_t binListPrev  = UNUSED;
+                uint32_t binListNext  = UNUSED;
+                uint32_t neighborPrev = UNUSED;
+                uint32_t neighborNext = UNUSED;
+                bool     used         = false;
+            };
+
+            uint32_t capacity_        = 0;
+            uint32_t maxAllocations_  = 0;
+            uint32_t freeStorage_     = 0;
+            uint32_t allocationCount_ = 0;
+
+            uint32_t              usedBinsTop_ = 0; // Bit per top bin with a non-empty leaf
+            uint8_t               usedBins_[NUM_TOP_BINS]{};
+            uint32_t              binIndices_[NUM_LEAF_BINS]{}; // Head node of each bin's free list
+            std::vector<Node>     nodes_;
+            std::vector<uint32_t> freeNodes_; // Stack of unused node indices
+
+            uint32_t insertNodeIntoBin(uint32_t size, uint32_t dataOffset);
+            void     removeNodeFromBin(uint32_t nodeIndex);
+    };
+} // namespace vulkan_engine::vulkan::memory
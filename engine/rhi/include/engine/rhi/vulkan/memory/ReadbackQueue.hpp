@@ -0,0 +1,175 @@
+#pragma once
+
+#include "engine/rhi/vulkan/memory/VmaBuffer.hpp"
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vulkan_engine::vulkan::memory
+{
+    class ResourceManager;
+
+    // Result of one GPU -> CPU copy. Pending until the frame that recorded the copy
+    // has retired on the GPU, then ready with data() pointing into host-cached
+    // readback memory. The data stays valid while the ticket (and its queue) is alive.
+    class ReadbackTicket
+    {
+        public:
+            enum class State : uint8_t
+            {
+                Pending,
+                Ready,
+                Failed
+            };
+
+            // Runs on the thread calling ReadbackQueue::beginFrame(), once the data is ready
+            using Callback = std::function<void(const ReadbackTicket&)>;
+
+            explicit ReadbackTicket(Callback onReady = {}) : onReady_(std::move(onReady))
+            {
+            }
+
+            State state() const noexcept { return state_.load(std::memory_order_acquire); }
+            bool  ready() const noexcept { return state() == State::Ready; }
+            bool  failed() const noexcept { return state() == State::Failed; }
+
+            // Empty until ready. Image rows are tightly packed: rowPitch() = width * texelSize().
+            std::span<const std::byte> data() const noexcept { return ready() ? data_ : std::span<const std::byte>{}; }
+
+            // Image readbacks only
+            VkFormat   format() const noexcept { return format_; }
+            VkExtent2D extent() const noexcept { return extent_; }
+            uint32_t   texelSize() const noexcept { return texelSize_; }
+            uint32_t   rowPitch() const noexcept { return extent_.width * texelSize_; }
+
+        private:
+            friend class ReadbackQueue;
+
+            std::atomic<State>         state_{State::Pending};
+            std::span<const std::byte> data_;
+            VkFormat                   format_    = VK_FORMAT_UNDEFINED;
+            VkExtent2D                 extent_    = {0, 0};
+            uint32_t                   texelSize_ = 0;
+            Callback                   onReady_;
+    };
+
+    using ReadbackTicketPtr = std::shared_ptr<ReadbackTicket>;
+
+    // ============================================================================
+    // ReadbackQueue - Asynchronous GPU -> CPU transfers without pipeline stalls
+    // ============================================================================
+    // request*() records a copy into a buffer from the Readback pool (host-visible,
+    // host-cached where the device has it) and returns a ticket. Nothing waits on
+    // the GPU: beginFrame(), called after a frame slot's fence wait, completes the
+    // copies recorded in that slot framesInFlight frames earlier. Readback buffers
+    // are recycled once their tickets are released.
+    //
+    //     auto ticket = readback.requestImage(cmd, {image, format, layout});
+    //     ...                                  // framesInFlight frames later
+    //     if (ticket->ready()) savePng(ticket->data(), ticket->extent());
+    //
+    // Copies must be recorded outside of a render pass. Not thread-safe.
+    class ReadbackQueue
+    {
+        public:
+            struct Config
+            {
+                uint32_t     framesInFlight = 2;
+                VkDeviceSize minBufferSize  = 64 * 1024; // Small requests (picking) share one size class
+                uint32_t     maxIdleBuffers = 4;         // Unused buffers kept for reuse
+            };
+
+            // Source of an image readback. A zero extent copies the whole mip level
+            // from offset; the image is returned to `layout` after the copy.
+            struct ImageRegion
+            {
+                VkImage            image      = VK_NULL_HANDLE;
+                VkFormat           format     = VK_FORMAT_UNDEFINED;
+                VkImageLayout      layout     = VK_IMAGE_LAYOUT_UNDEFINED;
+                VkExtent2D         imageSize  = {0, 0}; // Size of mipLevel, used for a zero extent
+                VkOffset2D         offset     = {0, 0};
+                VkExtent2D         extent     = {0, 0};
+                VkImageAspectFlags aspect     = VK_IMAGE_ASPECT_COLOR_BIT;
+                uint32_t           mipLevel   = 0;
+                uint32_t           arrayLayer = 0;
+            };
+
+            struct Stats
+            {
+                uint32_t     pending     = 0; // Recorded, waiting for their frame to retire
+                uint32_t     buffers     = 0;
+                uint32_t     idleBuffers = 0;
+                VkDeviceSize bufferBytes = 0;
+                uint64_t     completed   = 0;
+                uint64_t     failed      = 0;
+            };
+
+            ReadbackQueue(std::shared_ptr<ResourceManager> resourceManager, const Config& config = {});
+            ~ReadbackQueue();
+
+            // Non-copyable, non-movable (tickets point into the queue's buffers)
+            ReadbackQueue(const ReadbackQueue&)            = delete;
+            ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+            // Record the copy into cmd, which must be submitted in the current frame slot
+            ReadbackTicketPtr requestBuffer(
+                VkCommandBuffer          cmd,
+                VkBuffer                 source,
+                VkDeviceSize             offset,
+                VkDeviceSize             size,
+                ReadbackTicket::Callback onReady = {});
+            ReadbackTicketPtr requestImage(VkCommandBuffer cmd, const ImageRegion& region, ReadbackTicket::Callback onReady = {});
+
+            // Record into a ticket created earlier, for callers that hand out tickets
+            // before they have a command buffer. Returns false (ticket failed) on error.
+            bool recordBuffer(VkCommandBuffer cmd, VkBuffer source, VkDeviceSize offset, VkDeviceSize size, const ReadbackTicketPtr& ticket);
+            bool recordImage(VkCommandBuffer cmd, const ImageRegion& region, const ReadbackTicketPtr& ticket);
+
+            // Call after the fence of frameIndex has been waited on. Completes the
+            // copies recorded in that slot and makes it the slot for new requests.
+            void beginFrame(uint32_t frameIndex);
+
+            // Fail everything still pending, e.g. before the device is torn down
+            void cancelPending();
+
+            // Fail a ticket that will never be recorded
+            void cancel(const ReadbackTicketPtr& ticket);
+
+            Stats stats() const;
+
+            // Bytes per texel of the formats that can be read back; 0 if unsupported
+            static uint32_t texelSize(VkFormat format, VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+        private:
+            struct PooledBuffer
+            {
+                VmaBufferPtr                  buffer;
+                std::weak_ptr<ReadbackTicket> owner; // Free once the owning ticket is released
+            };
+
+            struct PendingReadback
+            {
+                ReadbackTicketPtr ticket;
+                VmaBufferPtr      buffer;
+                VkDeviceSize      size = 0;
+            };
+
+            std::shared_ptr<ResourceManager> resourceManager_;
+            Config                           config_;
+
+            std::vector<PooledBuffer>                 buffers_;
+            std::vector<std::vector<PendingReadback>> pending_; // One list per frame slot
+            uint32_t                                  frameIndex_ = 0;
+            uint64_t                                  completed_  = 0;
+            uint64_t                                  failed_     = 0;
+
+            // Free buffer of at least size bytes, created if needed, now owned by ticket
+            VmaBufferPtr acquireBuffer(VkDeviceSize size, const ReadbackTicketPtr& ticket);
+            void         trimIdleBuffers();
+    };
+} // namespace vulkan_engine::vulkan::memory
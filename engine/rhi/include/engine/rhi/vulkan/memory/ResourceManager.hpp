@@ -4,9 +4,14 @@
 #include "engine/rhi/vulkan/memory/VmaBuffer.hpp"
 #include "engine/rhi/vulkan/memory/VmaImage.hpp"
 #include "engine/rhi/vulkan/memory/MemoryPool.hpp"
+#include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace vulkan_engine::vulkan::memory
 {
@@ -19,10 +24,52 @@ namespace vulkan_engine::vulkan::memory
                 bool enableDefaultPools    = true;
                 bool enableDefragmentation = true;
                 bool enableBudget          = true;
+
+                // Automatic defragmentation, checked from beginFrame() every autoDefragmentInterval
+                // frames (0 = only on request). A run starts on the Vertex, Index or Texture pool
+                // with the most unused block bytes once they exceed both limits.
+                uint32_t     autoDefragmentInterval  = 240;
+                float        autoDefragmentThreshold = 0.25f;                // Unused fraction of the pool's blocks
+                VkDeviceSize autoDefragmentMinBytes  = 32ull * 1024 * 1024; // Also required growth since the last run
             };
 
+            // Incremental defragmentation: at most one VMA pass is in flight at a time and
+            // each pass is bounded by these budgets, so the copy cost is spread over frames.
+            // A pass ends once the graphics timeline has passed the submission holding its copies.
+            struct DefragmentationConfig
+            {
+                VmaPool                 pool                  = VK_NULL_HANDLE; // VK_NULL_HANDLE = default pools
+                VmaDefragmentationFlags algorithm             = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+                VkDeviceSize            maxBytesPerPass       = 16ull * 1024 * 1024; // 0 = unlimited
+                uint32_t                maxAllocationsPerPass = 64;                  // 0 = unlimited
+            };
+
+            struct DefragmentationStats
+            {
+                uint32_t     passes                  = 0;
+                uint32_t     allocationsMoved        = 0;
+                uint32_t     allocationsSkipped      = 0; // Not owned by this manager or not relocatable
+                VkDeviceSize bytesMoved              = 0;
+                VkDeviceSize bytesFreed              = 0; // Filled in when defragmentation finishes
+                uint32_t     deviceMemoryBlocksFreed = 0;
+            };
+
+            // Allocation counts per pool, to verify that resources share VkDeviceMemory blocks
+            struct AllocationStats
+            {
+                std::vector<std::pair<PoolType, MemoryPool::Stats>> pools;
+                uint32_t                                             unpooledResources  = 0; // Pooled requests that fell back to VMA's default blocks
+                uint32_t                                             deviceMemoryBlocks = 0; // Live VkDeviceMemory objects across all heaps
+                AllocationPolicy::Stats                              policy;                 // Placement decisions, to tune the policy thresholds
+            };
+
+            // Invoked as soon as a pass has swapped the moved resources to their new handles,
+            // before the rest of the frame is recorded, so descriptor owners can rewrite their
+            // sets. The old handles are deferred until the frames still using them retire.
+            using RelocationCallback = std::function<void(const std::vector<VmaBuffer*>&, const std::vector<VmaImage*>&)>;
+
             explicit ResourceManager(std::shared_ptr<DeviceManager> deviceManager, const CreateInfo& createInfo = {});
-            ~ResourceManager() = default;
+            ~ResourceManager();
 
             // Non-copyable
             ResourceManager(const ResourceManager&)            = delete;
@@ -61,16 +108,41 @@ namespace vulkan_engine::vulkan::memory
                 uint32_t arrayLayers = 1);
             VmaImagePtr createCubemap(uint32_t size, VkFormat format, uint32_t mipLevels = 1);
 
+            // Pooled creation used by the RHI wrappers (Buffer, Image, DepthBuffer, UniformBuffer).
+            // The pool is chosen from usage and memory properties. The allocation policy may
+            // place the resource in dedicated memory instead (render targets, large resources);
+            // if the pool's memory type cannot back it, or the pool is full, VMA's default
+            // blocks are used.
+            // Defragmentation may move them: the wrappers read the handle from the VmaBuffer /
+            // VmaImage, views are rebuilt there, and descriptor owners compare generation().
+            VmaBufferPtr createPooledBuffer(
+                VkDeviceSize          size,
+                VkBufferUsageFlags    usage,
+                VkMemoryPropertyFlags properties,
+                bool                  persistentMap = false);
+            VmaImagePtr createPooledImage(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags properties);
+
+            // Persistently mapped TRANSFER_DST buffer for GPU -> CPU copies, from the Readback
+            // pool. Host-cached memory is preferred but not required; reads must invalidate().
+            VmaBufferPtr createReadbackBuffer(VkDeviceSize size);
+
+            static std::optional<PoolType> selectBufferPool(VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+            static PoolType                selectImagePool(VkImageUsageFlags usage);
+
             // 鍐呭瓨姹犺闂?
             MemoryPoolManager&       poolManager() { return *poolManager_; }
             const MemoryPoolManager& poolManager() const { return *poolManager_; }
 
             // 缁熻淇℃伅
-            void printStats() const;
+            void            printStats() const;
+            AllocationStats allocationStats() const;
 
             // 鑾峰彇 JSON 鏍煎紡鐨勮缁嗙粺璁?
             std::string buildStatsString(bool detailed = true) const;
 
+            // Per-category attribution and allocation timeline; null when tracking is disabled
+            AllocationTracker* tracker() const noexcept { return allocator_->tracker(); }
+
             // 棰勭畻鏌ヨ
             std::vector<VmaBudget> getHeapBudgets() const;
             bool                   isMemoryAvailable(VkDeviceSize requiredBytes) const;
@@ -79,18 +151,84 @@ namespace vulkan_engine::vulkan::memory
             void destroyBuffer(VmaBufferPtr buffer);
             void destroyImage(VmaImagePtr image);
 
+            // Per-frame housekeeping. Call once per frame after the frame slot's timeline value
+            // has been waited on, with the command buffer about to record this frame's rendering
+            // (SceneRenderer does this). Advances the VMA frame index, starts an automatic
+            // defragmentation run when a pool is fragmented (see CreateInfo), and drives the active
+            // one: a pass whose copies have completed on the graphics timeline ends, then the
+            // next pass records its copies and swaps the owners to the new handles.
+            void beginFrame(VkCommandBuffer cmd, uint64_t frameNumber);
+
+            // Defragmentation
+            bool                        beginDefragmentation(const DefragmentationConfig& config = {});
+            void                        cancelDefragmentation();
+            bool                        isDefragmenting() const noexcept { return defragContext_ != VK_NULL_HANDLE; }
+            const DefragmentationStats& defragmentationStats() const noexcept { return defragStats_; }
+            void                        setRelocationCallback(RelocationCallback callback) { relocationCallback_ = std::move(callback); }
+
             // 寮哄埗鍨冨溇鍥炴敹锛堥噴鏀炬湭浣跨敤鐨勫唴瀛樺潡锛?
-            void defragment();
-            void flush();
+            void defragment(); // beginDefragmentation() with the default budgets
+            void flush();      // Waits on the timeline for the in-flight pass's copies, then ends it. Only between frames.
 
         private:
+            struct PendingMove
+            {
+                VmaBufferPtr buffer;
+                VmaImagePtr  image;
+                VkBuffer     relocatedBuffer = VK_NULL_HANDLE;
+                VkImage      relocatedImage  = VK_NULL_HANDLE;
+                VkDeviceSize size            = 0;
+            };
+
             std::shared_ptr<DeviceManager>     device_;
             std::shared_ptr<VmaAllocator>      allocator_;
             std::unique_ptr<MemoryPoolManager> poolManager_;
+            CreateInfo                         createInfo_;
+
+            // Defragmentation state
+            VmaDefragmentationContext      defragContext_ = VK_NULL_HANDLE;
+            VmaDefragmentationPassMoveInfo defragPass_{};
+            DefragmentationConfig          defragConfig_;
+            DefragmentationStats           defragStats_;
+            std::vector<PendingMove>       pendingMoves_; // Parallel to defragPass_.pMoves
+            bool                           passInFlight_ = false;
+            uint64_t                       passValue_    = 0; // Graphics timeline value covering the copies; 0 until submitted
+            uint64_t                       currentFrame_ = 0;
+            RelocationCallback             relocationCallback_;
+
+            // Automatic runs: the pool being defragmented, and per pool the unused bytes
+            // left by its last run, so a pool that cannot be compacted further is not retried
+            std::optional<PoolType>                    autoDefragPool_;
+            std::unordered_map<PoolType, VkDeviceSize> settledUnused_;
+
+            VmaPool compatiblePool(PoolType type, VkMemoryPropertyFlags properties) const;
+
+            // Create through the allocator's AllocationPolicy: pool (may be null) is used only
+            // for a Pooled decision; placement receives where the resource actually ended up
+            VmaBufferPtr createPlacedBuffer(
+                VkDeviceSize            size,
+                VkBufferUsageFlags      usage,
+                VmaAllocationCreateInfo allocInfo,
+                VmaPool                 pool,
+                ResourceLifetime        lifetime,
+                AllocationPlacement&    placement);
+            VmaImagePtr createPlacedImage(
+                const VkImageCreateInfo& imageInfo,
+                VmaAllocationCreateInfo  allocInfo,
+                VmaPool                  pool,
+                ResourceLifetime         lifetime,
+                AllocationPlacement&     placement);
+
+            void startAutomaticDefragmentation();
+            void recordDefragmentationPass(VkCommandBuffer cmd);
+            void completeDefragmentationPass();
+            void finishDefragmentation();
 
             // 杩借釜鎵€鏈夎祫婧愶紙鐢ㄤ簬璋冭瘯鍜岀粺璁★級
             std::unordered_map<VmaBuffer*, VmaBufferPtr> buffers_;
             std::unordered_map<VmaImage*, VmaImagePtr>   images_;
+            std::unordered_set<const void*>              unpooled_; // Pooled requests that ended up in VMA's default blocks
+            std::unordered_set<const void*>              pinned_;   // Readers hold pointers into the mapping; never relocated
     };
 
     using ResourceManagerPtr = std::shared_ptr<ResourceManager>;
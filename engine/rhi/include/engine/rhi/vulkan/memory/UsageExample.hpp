@@ -136,6 +136,22 @@ resourceManager->destroyBuffer(stagingBuffer);
 resourceManager->destroyImage(texture);
 
 
+// 11. Incremental defragmentation
+// Each frame's pass is bounded by maxBytesPerPass / maxAllocationsPerPass. Moved
+// buffers/images get new handles (views are rebuilt) as soon as the copies are recorded;
+// the old handles go to the device's deletion queue and the old memory is released once
+// the graphics timeline has passed the copies.
+memory::ResourceManager::DefragmentationConfig defragConfig;
+defragConfig.maxBytesPerPass = 8 * 1024 * 1024;
+resourceManager->setRelocationCallback([&](const auto& buffers, const auto& images) {
+    // Rewrite descriptor sets that reference the relocated resources
+});
+resourceManager->beginDefragmentation(defragConfig);
+
+// Every frame, after waiting on the frame slot and before recording rendering
+// (SceneRenderer does this with its own command buffer):
+resourceManager->beginFrame(cmd, frameNumber);
+
 ================= 楂樼骇鍔熻兘 =================
 
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/memory/AllocationPolicy.hpp"
+#include "engine/rhi/vulkan/memory/AllocationTracker.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
@@ -32,6 +34,9 @@ namespace vulkan_engine::vulkan::memory
                 bool enableBudget              = true;  // 鍚敤棰勭畻鏌ヨ
                 bool recordAllocations         = false; // Debug build 鏃跺惎鐢?
                 bool enableMemoryLeakDetection = false;
+                bool trackAllocations          = true; // Tag allocations and keep an event timeline (AllocationTracker)
+
+                AllocationPolicy::Config policy; // Dedicated/pooled thresholds and priorities
             };
 
             VmaAllocator(std::shared_ptr<DeviceManager> deviceManager, const CreateInfo& createInfo = {});
@@ -75,10 +80,18 @@ namespace vulkan_engine::vulkan::memory
             // 宸ュ叿鍑芥暟
             static std::string allocationFlagsToString(VmaAllocationCreateFlags flags);
 
+            // Allocation attribution and timeline; null when trackAllocations is off
+            AllocationTracker* tracker() const noexcept { return tracker_.get(); }
+
+            // Dedicated/pooled placement, strategy and priority for new allocations
+            AllocationPolicy& policy() const noexcept { return *policy_; }
+
         private:
-            std::shared_ptr<DeviceManager> deviceManager_;
-            ::VmaAllocator                 allocator_ = VK_NULL_HANDLE;
-            std::vector<VmaPool>           pools_;
+            std::shared_ptr<DeviceManager>     deviceManager_;
+            ::VmaAllocator                     allocator_ = VK_NULL_HANDLE;
+            std::vector<VmaPool>               pools_;
+            std::unique_ptr<AllocationTracker> tracker_;
+            std::unique_ptr<AllocationPolicy>  policy_;
 
             void cleanup() noexcept;
     };
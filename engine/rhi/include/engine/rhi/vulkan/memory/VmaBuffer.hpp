@@ -9,8 +9,15 @@
 #include <optional>
 #include <cstring>
 
+namespace vulkan_engine::vulkan
+{
+    class DeletionQueue;
+}
+
 namespace vulkan_engine::vulkan::memory
 {
+    class ResourceManager;
+
     // VMA Buffer 绫?
     class VmaBuffer
     {
@@ -68,6 +75,14 @@ namespace vulkan_engine::vulkan::memory
             AllocationInfo     allocationInfo() const { return allocationInfo_; }
             bool               isValid() const noexcept { return buffer_ != VK_NULL_HANDLE && allocation_.isValid(); }
 
+            // Hands the buffer and its memory to the queue instead of destroying them
+            // now; the object is left empty.
+            void retire(DeletionQueue& queue);
+
+            // Bumped whenever defragmentation moves the buffer to a new VkBuffer;
+            // descriptor owners compare it against the value they last wrote.
+            uint32_t generation() const noexcept { return generation_; }
+
             // 鑾峰彇鍒嗛厤
             const Allocation& allocation() const { return allocation_; }
 
@@ -85,8 +100,17 @@ namespace vulkan_engine::vulkan::memory
             VkBufferUsageFlags            usage_ = 0;
             AllocationInfo                allocationInfo_{};
             void*                         mappedData_ = nullptr;
+            uint32_t                      generation_ = 0;
 
             void cleanup() noexcept;
+
+            // Defragmentation support (driven by ResourceManager)
+            friend class ResourceManager;
+
+            bool     isRelocatable() const noexcept;
+            VkBuffer createRelocationTarget(VmaAllocation target) const;
+            void     adoptRelocation(VkBuffer relocated, DeletionQueue& queue);
+            void     refreshAllocationInfo();
     };
 
     using VmaBufferPtr = std::shared_ptr<VmaBuffer>;
@@ -8,6 +8,11 @@
 #include <vector>
 #include <optional>
 
+namespace vulkan_engine::vulkan
+{
+    class DeletionQueue;
+}
+
 namespace vulkan_engine::vulkan::memory
 {
     // Image 瀛愯祫婧愯寖鍥?
@@ -40,6 +45,8 @@ namespace vulkan_engine::vulkan::memory
         }
     };
 
+    class ResourceManager;
+
     // VMA Image 绫?
     class VmaImage
     {
@@ -64,6 +71,10 @@ namespace vulkan_engine::vulkan::memory
             void        destroyView(VkImageView view);
             void        destroyAllViews();
 
+            // Hands the views, the image and its memory to the queue instead of
+            // destroying them now; the object is left empty.
+            void retire(DeletionQueue& queue);
+
             // 鑾峰彇榛樿 view锛堝垱寤虹殑绗竴涓?view锛?
             VkImageView defaultView() const { return views_.empty() ? VK_NULL_HANDLE : views_[0]; }
 
@@ -93,6 +104,10 @@ namespace vulkan_engine::vulkan::memory
             VkImageType           imageType() const noexcept { return imageType_; }
             bool                  isValid() const noexcept { return image_ != VK_NULL_HANDLE && allocation_.isValid(); }
 
+            // Bumped whenever defragmentation moves the image; the VkImage and every
+            // view created through createView() are replaced at that point.
+            uint32_t generation() const noexcept { return generation_; }
+
             AllocationInfo    allocationInfo() const { return allocationInfo_; }
             const Allocation& allocation() const { return allocation_; }
 
@@ -105,6 +120,16 @@ namespace vulkan_engine::vulkan::memory
             Allocation                    allocation_;
             std::vector<VkImageView>      views_;
 
+            // Creation parameters of views_, kept so they can be rebuilt after a move
+            struct ViewDesc
+            {
+                VkImageViewType       viewType;
+                VkFormat              format;
+                ImageSubresourceRange range;
+            };
+
+            std::vector<ViewDesc> viewDescs_;
+
             // Image 灞炴€?
             VkFormat              format_        = VK_FORMAT_UNDEFINED;
             VkExtent3D            extent_        = {0, 0, 0};
@@ -113,10 +138,23 @@ namespace vulkan_engine::vulkan::memory
             VkSampleCountFlagBits samples_       = VK_SAMPLE_COUNT_1_BIT;
             VkImageUsageFlags     usage_         = 0;
             VkImageType           imageType_     = VK_IMAGE_TYPE_2D;
+            VkImageCreateFlags    flags_         = 0;
+            VkImageTiling         tiling_        = VK_IMAGE_TILING_OPTIMAL;
             VkImageLayout         currentLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
             AllocationInfo        allocationInfo_{};
+            uint32_t              generation_ = 0;
+
+            void        cleanup() noexcept;
+            VkImageView makeView(const ViewDesc& desc) const;
+
+            // Defragmentation support (driven by ResourceManager)
+            friend class ResourceManager;
 
-            void cleanup() noexcept;
+            bool    isRelocatable() const noexcept;
+            VkImage createRelocationTarget(VmaAllocation target) const;
+            void    recordRelocationCopy(VkCommandBuffer cmd, VkImage relocated) const;
+            void    adoptRelocation(VkImage relocated, DeletionQueue& queue);
+            void    refreshAllocationInfo();
 
             // 杈呭姪鍑芥暟
             static VkAccessFlags        getAccessMask(VkImageLayout layout);
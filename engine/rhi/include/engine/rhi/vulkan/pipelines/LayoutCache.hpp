@@ -0,0 +1,55 @@
+#pragma once
+
+#include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/pipelines/ShaderReflection.hpp"
+#include <vulkan/vulkan.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace vulkan_engine::vulkan
+{
+    // ============================================================================
+    // LayoutCache - Deduplicated descriptor set and pipeline layouts
+    // ============================================================================
+    // Shaders with identical interfaces receive the same VkDescriptorSetLayout and
+    // VkPipelineLayout handles, so materials sharing a shader are layout-compatible
+    // and the driver sees one object per distinct interface. The cache owns every
+    // handle it returns; they stay valid until the cache is destroyed.
+    class LayoutCache
+    {
+        public:
+            explicit LayoutCache(std::shared_ptr<DeviceManager> device);
+            ~LayoutCache();
+
+            // Non-copyable
+            LayoutCache(const LayoutCache&)            = delete;
+            LayoutCache& operator=(const LayoutCache&) = delete;
+
+            // Binding order does not matter; immutable samplers are not supported
+            VkDescriptorSetLayout descriptor_set_layout(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+            VkPipelineLayout      pipeline_layout(
+                const std::vector<VkDescriptorSetLayout>& set_layouts,
+                const std::vector<VkPushConstantRange>&   push_constants);
+
+            // One set layout per set in [0, set_count) plus the reflected push constant ranges.
+            // dynamic_bindings lists (set, binding) pairs promoted to *_DYNAMIC buffer types.
+            VkPipelineLayout pipeline_layout(
+                const ShaderReflection&                           reflection,
+                std::vector<VkDescriptorSetLayout>&               out_set_layouts,
+                const std::vector<std::pair<uint32_t, uint32_t>>& dynamic_bindings = {});
+
+            size_t descriptor_set_layout_count() const;
+            size_t pipeline_layout_count() const;
+
+        private:
+            std::shared_ptr<DeviceManager> device_;
+
+            std::map<std::vector<uint64_t>, VkDescriptorSetLayout> set_layouts_;
+            std::map<std::vector<uint64_t>, VkPipelineLayout>      pipeline_layouts_;
+
+            mutable std::mutex mutex_;
+    };
+} // namespace vulkan_engine::vulkan
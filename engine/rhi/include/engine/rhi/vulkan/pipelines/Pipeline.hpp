@@ -68,6 +68,9 @@ namespace vulkan_engine::vulkan
         // Dynamic Rendering formats (used when render_pass is VK_NULL_HANDLE)
         VkFormat color_format = VK_FORMAT_UNDEFINED;
         VkFormat depth_format = VK_FORMAT_UNDEFINED;
+
+        // Optional; shared caches let pipelines built on several threads reuse compiled state
+        VkPipelineCache pipeline_cache = VK_NULL_HANDLE;
     };
 
     class GraphicsPipeline
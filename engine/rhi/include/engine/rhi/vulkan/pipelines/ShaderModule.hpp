@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/pipelines/ShaderReflection.hpp"
 #include <vulkan/vulkan.h>
 #include <string>
 #include <vector>
@@ -42,12 +43,19 @@ namespace vulkan_engine::vulkan
             VkShaderModule handle() const { return module_; }
             bool           valid() const { return module_ != VK_NULL_HANDLE; }
 
+            // Resource interface reflected from the SPIR-V at creation (null if reflection failed)
+            std::shared_ptr<const ShaderReflection> reflection() const { return reflection_; }
+
             // Utility functions
             static std::vector<uint32_t> load_spirv_from_file(const std::string& path);
 
         private:
             std::shared_ptr<DeviceManager> device_;
             VkShaderModule                 module_ = VK_NULL_HANDLE;
+
+            std::shared_ptr<const ShaderReflection> reflection_;
+
+            void reflect(const std::vector<uint32_t>& code);
     };
 
     // Shader stage configuration helper
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vulkan_engine::vulkan
+{
+    // Member of a uniform/storage/push-constant block
+    struct ShaderBlockMember
+    {
+        std::string name;
+        uint32_t    offset = 0;
+        uint32_t    size   = 0;
+    };
+
+    // Descriptor binding declared by a shader
+    struct ShaderResourceBinding
+    {
+        std::string                    name;
+        uint32_t                       set             = 0;
+        uint32_t                       binding         = 0;
+        VkDescriptorType               descriptor_type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        uint32_t                       count           = 1; // 0 for runtime-sized arrays
+        VkShaderStageFlags             stages          = 0;
+        uint32_t                       block_size      = 0; // Buffers only
+        std::vector<ShaderBlockMember> members;             // Buffers only
+    };
+
+    // Push constant block declared by a shader
+    struct ShaderPushConstantBlock
+    {
+        std::string                    name;
+        VkPushConstantRange            range{};
+        std::vector<ShaderBlockMember> members;
+    };
+
+    // Vertex shader input attribute
+    struct ShaderVertexInput
+    {
+        std::string name;
+        uint32_t    location = 0;
+        VkFormat    format   = VK_FORMAT_UNDEFINED;
+    };
+
+    // ============================================================================
+    // ShaderReflection - Resource interface extracted from SPIR-V
+    // ============================================================================
+    struct ShaderReflection
+    {
+        VkShaderStageFlags                   stages = 0;
+        std::string                          entry_point;
+        std::vector<ShaderResourceBinding>   bindings; // Sorted by (set, binding)
+        std::vector<ShaderPushConstantBlock> push_constants;
+        std::vector<ShaderVertexInput>       vertex_inputs; // Sorted by location
+
+        // Parse a SPIR-V module. Throws std::runtime_error on malformed input.
+        static ShaderReflection reflect(const std::vector<uint32_t>& spirv);
+
+        // Combine with another stage of the same program (e.g. vertex + fragment).
+        // Throws std::runtime_error if both declare the same binding with different types.
+        void merge(const ShaderReflection& other);
+
+        // Queries
+        const ShaderResourceBinding* find_binding(uint32_t set, uint32_t binding) const;
+        const ShaderResourceBinding* find_binding(const std::string& name) const;
+        uint32_t                     set_count() const;
+
+        // Layout helpers
+        std::vector<VkDescriptorSetLayoutBinding> set_layout_bindings(uint32_t set) const;
+        std::vector<VkPushConstantRange>          push_constant_ranges() const;
+    };
+} // namespace vulkan_engine::vulkan
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/memory/VmaBuffer.hpp"
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <memory>
@@ -8,6 +9,8 @@
 
 namespace vulkan_engine::vulkan
 {
+    // Memory is sub-allocated from the device's memory::ResourceManager pools
+    // (see ResourceManager::selectBufferPool) instead of one vkAllocateMemory per buffer.
     class Buffer
     {
         public:
@@ -41,18 +44,24 @@ namespace vulkan_engine::vulkan
             void flush(VkDeviceSize size, VkDeviceSize offset = 0);
             void invalidate(VkDeviceSize size, VkDeviceSize offset = 0);
 
+            // Hand the buffer to the deletion queue instead of destroying it, for
+            // submitted work that still reads it. The Buffer is empty afterwards.
+            void retire(DeletionQueue& queue);
+
             // Accessors
-            VkBuffer       handle() const { return buffer_; }
-            VkDeviceMemory memory() const { return memory_; }
-            VkDeviceSize   size() const { return size_; }
-            bool           is_mapped() const { return mapped_data_ != nullptr; }
+            VkBuffer                    handle() const { return allocation_ ? allocation_->handle() : VK_NULL_HANDLE; }
+            const memory::VmaBufferPtr& allocation() const { return allocation_; }
+            VkDeviceSize                size() const { return size_; }
+            bool                        is_mapped() const { return mapped_data_ != nullptr; }
 
         private:
-            std::shared_ptr<DeviceManager> device_;
-            VkBuffer                       buffer_      = VK_NULL_HANDLE;
-            VkDeviceMemory                 memory_      = VK_NULL_HANDLE;
-            VkDeviceSize                   size_        = 0;
-            void*                          mapped_data_ = nullptr;
+            std::shared_ptr<DeviceManager>           device_;
+            std::shared_ptr<memory::ResourceManager> resource_manager_;
+            memory::VmaBufferPtr                     allocation_;
+            VkDeviceSize                             size_        = 0;
+            void*                                    mapped_data_ = nullptr;
+
+            void release() noexcept;
     };
 
     class BufferBuilder
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/memory/VmaImage.hpp"
 #include <vulkan/vulkan.h>
 #include <memory>
 
@@ -23,23 +24,25 @@ namespace vulkan_engine::vulkan
             DepthBuffer(DepthBuffer&& other) noexcept;
             DepthBuffer& operator=(DepthBuffer&& other) noexcept;
 
-            VkImage        image() const { return image_; }
-            VkImageView    view() const { return view_; }
-            VkDeviceMemory memory() const { return memory_; }
-            VkFormat       format() const { return format_; }
+            VkImage                    image() const { return image_; }
+            VkImageView                view() const { return view_; }
+            const memory::VmaImagePtr& allocation() const { return allocation_; }
+            VkFormat                   format() const { return format_; }
 
             static VkFormat find_depth_format(std::shared_ptr<DeviceManager> device);
 
         private:
-            std::shared_ptr<DeviceManager> device_;
-            VkImage                        image_  = VK_NULL_HANDLE;
-            VkImageView                    view_   = VK_NULL_HANDLE;
-            VkDeviceMemory                 memory_ = VK_NULL_HANDLE;
-            VkFormat                       format_ = VK_FORMAT_UNDEFINED;
-            uint32_t                       width_  = 0;
-            uint32_t                       height_ = 0;
+            std::shared_ptr<DeviceManager>           device_;
+            std::shared_ptr<memory::ResourceManager> resource_manager_;
+            memory::VmaImagePtr                      allocation_; // RenderTarget pool
+            VkImage                                  image_  = VK_NULL_HANDLE;
+            VkImageView                              view_   = VK_NULL_HANDLE;
+            VkFormat                                 format_ = VK_FORMAT_UNDEFINED;
+            uint32_t                                 width_  = 0;
+            uint32_t                                 height_ = 0;
 
             void create_image();
             void create_view();
+            void release() noexcept;
     };
 } // namespace vulkan_engine::vulkan
\ No newline at end of file
@@ -67,6 +67,7 @@ namespace vulkan_engine::vulkan
             void create_framebuffer(
                 VkRenderPass                    render_pass,
                 const std::vector<VkImageView>& attachments);
+            void destroy_framebuffer();
 
             std::shared_ptr<DeviceManager> device_;
             VkFramebuffer                  framebuffer_ = VK_NULL_HANDLE;
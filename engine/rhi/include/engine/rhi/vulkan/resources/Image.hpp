@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/memory/VmaImage.hpp"
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <memory>
@@ -16,6 +17,9 @@ namespace vulkan_engine::vulkan
         uint32_t           layer_count      = 1;
     };
 
+    // Memory comes from the device's memory::ResourceManager Texture/RenderTarget pools.
+    // Defragmentation may move a sampled image: handle() and view() then return the new
+    // objects and generation() changes, so descriptor owners know to write a new set.
     class Image
     {
         public:
@@ -39,13 +43,13 @@ namespace vulkan_engine::vulkan
 
             // Layout transitions
             // Set layout tracking only (no barrier emitted)
-            void set_layout(VkImageLayout new_layout) { current_layout_ = new_layout; }
+            void set_layout(VkImageLayout new_layout) { allocation_->setLayout(new_layout); }
 
             // Transition layout with actual barrier emission (requires command buffer)
             void transition_layout(VkCommandBuffer cmd, VkImageLayout new_layout);
 
-            // Get current tracked layout
-            VkImageLayout current_layout() const { return current_layout_; }
+            // Get current tracked layout (kept on the allocation, which relocation copies from)
+            VkImageLayout current_layout() const { return allocation_ ? allocation_->currentLayout() : VK_IMAGE_LAYOUT_UNDEFINED; }
 
             // Helper: determine access masks and stage masks for layout transition
             struct TransitionInfo
@@ -64,27 +68,30 @@ namespace vulkan_engine::vulkan
             void upload_data(const void* data, VkDeviceSize size);
             void download_data(void* data, VkDeviceSize size);
 
+            // Hand the image and its view to the deletion queue instead of destroying
+            // them, for frames in flight that still sample it. The Image is empty afterwards.
+            void retire(DeletionQueue& queue);
+
             // Accessors
-            VkImage        handle() const { return image_; }
-            VkImageView    view() const { return view_; }
-            VkDeviceMemory memory() const { return memory_; }
-            VkFormat       format() const { return format_; }
-            uint32_t       width() const { return width_; }
-            uint32_t       height() const { return height_; }
-            uint32_t       mip_levels() const { return mip_levels_; }
-            uint32_t       array_layers() const { return array_layers_; }
+            VkImage                    handle() const { return allocation_ ? allocation_->handle() : VK_NULL_HANDLE; }
+            VkImageView                view() const { return allocation_ ? allocation_->defaultView() : VK_NULL_HANDLE; }
+            uint32_t                   generation() const { return allocation_ ? allocation_->generation() : 0; }
+            const memory::VmaImagePtr& allocation() const { return allocation_; }
+            VkFormat                   format() const { return format_; }
+            uint32_t                   width() const { return width_; }
+            uint32_t                   height() const { return height_; }
+            uint32_t                   mip_levels() const { return mip_levels_; }
+            uint32_t                   array_layers() const { return array_layers_; }
 
         private:
-            std::shared_ptr<DeviceManager> device_;
-            VkImage                        image_  = VK_NULL_HANDLE;
-            VkImageView                    view_   = VK_NULL_HANDLE;
-            VkDeviceMemory                 memory_ = VK_NULL_HANDLE;
-            VkFormat                       format_;
-            uint32_t                       width_          = 0;
-            uint32_t                       height_         = 0;
-            uint32_t                       mip_levels_     = 1;
-            uint32_t                       array_layers_   = 1;
-            VkImageLayout                  current_layout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+            std::shared_ptr<DeviceManager>           device_;
+            std::shared_ptr<memory::ResourceManager> resource_manager_;
+            memory::VmaImagePtr                      allocation_; // Owns the image and its view
+            VkFormat                                 format_;
+            uint32_t                                 width_        = 0;
+            uint32_t                                 height_       = 0;
+            uint32_t                                 mip_levels_   = 1;
+            uint32_t                                 array_layers_ = 1;
     };
 
     class ImageBuilder
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+namespace vulkan_engine::vulkan
+{
+    /**
+     * @brief Frame-deferred destruction of Vulkan handles
+     *
+     * Instead of waiting for the device to go idle, owners hand their handles to
+     * the queue and the frame loop destroys them once every frame that could still
+     * reference them has retired:
+     *
+     *     queue.defer(framebuffer);
+     *     queue.defer(image, allocation, vma_allocator);
+     *
+     * Records are plain typed handles, not closures. defer()/enqueue() may be
+     * called from any thread and are lock-free (a CAS push onto an intake stack).
+     * collect(submitted, completed) is called by the thread that owns the frame
+     * loop with the graphics QueueTimeline's values: everything enqueued so far
+     * is tagged with the last submitted value, and every batch whose value the
+     * GPU has reached is destroyed. No frame slots, so it works for any number
+     * of frames in flight and for work submitted outside the frame loop.
+     *
+     * Header-only so both RHI layers can share it.
+     */
+    class DeletionQueue
+    {
+        public:
+            enum class HandleType : uint8_t
+            {
+                Buffer, // With an allocation: vmaDestroyBuffer
+                Image,  // With an allocation: vmaDestroyImage
+                ImageView,
+                Sampler,
+                Framebuffer,
+                RenderPass,
+                Pipeline,
+                PipelineLayout,
+                DescriptorPool,
+                DescriptorSetLayout,
+                ShaderModule,
+                Semaphore,
+                Fence,
+                Event,
+                QueryPool,
+                CommandPool,
+                DeviceMemory,
+                Swapchain,
+                Allocation // VmaAllocation only: vmaFreeMemory
+            };
+
+            struct Record
+            {
+                uint64_t       handle        = 0;
+                VmaAllocation  allocation    = VK_NULL_HANDLE;
+                ::VmaAllocator vma_allocator = VK_NULL_HANDLE;
+                HandleType     type          = HandleType::Buffer;
+            };
+
+            explicit DeletionQueue(VkDevice device)
+                : device_(device)
+            {
+            }
+
+            // The device must be idle by now
+            ~DeletionQueue() { flush(); }
+
+            DeletionQueue(const DeletionQueue&)            = delete;
+            DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+            // Any thread
+            void enqueue(const Record& record)
+            {
+                if (record.handle == 0 && record.allocation == VK_NULL_HANDLE)
+                {
+                    return;
+                }
+
+                Node* node = new Node{record, intake_.load(std::memory_order_relaxed)};
+                while (!intake_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            // Any thread. Handles owned by VMA pass the allocation and its allocator.
+            template <typename Handle> void defer(Handle handle, VmaAllocation allocation = VK_NULL_HANDLE, ::VmaAllocator vma_allocator = VK_NULL_HANDLE)
+            {
+                enqueue({to_bits(handle), allocation, vma_allocator, handle_type<Handle>()});
+            }
+
+            void defer_free(VmaAllocation allocation, ::VmaAllocator vma_allocator)
+            {
+                enqueue({0, allocation, vma_allocator, HandleType::Allocation});
+            }
+
+            // Frame-loop thread, while no recorded-but-unsubmitted work uses deleted
+            // handles. submitted_value / completed_value come from the queue timeline.
+            void collect(uint64_t submitted_value, uint64_t completed_value)
+            {
+                // Whatever was deleted so far was last used by work submitted up to now
+                if (pending_.empty() || pending_.back().value != submitted_value)
+                {
+                    pending_.push_back({submitted_value, take_spare()});
+                }
+                drain_intake(pending_.back().records);
+                if (pending_.back().records.empty())
+                {
+                    spare_.push_back(std::move(pending_.back().records));
+                    pending_.pop_back();
+                }
+
+                while (!pending_.empty() && pending_.front().value <= completed_value)
+                {
+                    auto& retired = pending_.front().records;
+                    for (const Record& record : retired)
+                    {
+                        destroy(record);
+                    }
+                    retired.clear();
+                    spare_.push_back(std::move(retired));
+                    pending_.pop_front();
+                }
+            }
+
+            // Destroy everything now. Only when the device is idle.
+            void flush()
+            {
+                for (Batch& batch : pending_)
+                {
+                    for (const Record& record : batch.records)
+                    {
+                        destroy(record);
+                    }
+                }
+                pending_.clear();
+
+                std::vector<Record> pending;
+                drain_intake(pending);
+                for (const Record& record : pending)
+                {
+                    destroy(record);
+                }
+            }
+
+        private:
+            struct Node
+            {
+                Record record;
+                Node*  next = nullptr;
+            };
+
+            // Records last used by work up to `value` on the queue timeline
+            struct Batch
+            {
+                uint64_t            value = 0;
+                std::vector<Record> records;
+            };
+
+            VkDevice                         device_ = VK_NULL_HANDLE;
+            std::atomic<Node*>               intake_{nullptr};
+            std::deque<Batch>                pending_; // Frame-loop thread only, ascending values
+            std::vector<std::vector<Record>> spare_;   // Cleared vectors kept for their capacity
+
+            std::vector<Record> take_spare()
+            {
+                if (spare_.empty())
+                {
+                    return {};
+                }
+                std::vector<Record> records = std::move(spare_.back());
+                spare_.pop_back();
+                return records;
+            }
+
+            void drain_intake(std::vector<Record>& out)
+            {
+                // The stack is newest-first; keep enqueue order so views go before their images
+                Node* head     = intake_.exchange(nullptr, std::memory_order_acquire);
+                Node* reversed = nullptr;
+                while (head)
+                {
+                    Node* next = head->next;
+                    head->next = reversed;
+                    reversed   = head;
+                    head       = next;
+                }
+                while (reversed)
+                {
+                    Node* next = reversed->next;
+                    out.push_back(reversed->record);
+                    delete reversed;
+                    reversed = next;
+                }
+            }
+
+            template <typename Handle> static uint64_t to_bits(Handle handle)
+            {
+                if constexpr (std::is_pointer_v<Handle>)
+                {
+                    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+                }
+                else
+                {
+                    return static_cast<uint64_t>(handle);
+                }
+            }
+
+            template <typename Handle> static Handle from_bits(uint64_t bits)
+            {
+                if constexpr (std::is_pointer_v<Handle>)
+                {
+                    return reinterpret_cast<Handle>(static_cast<uintptr_t>(bits));
+                }
+                else
+                {
+                    return static_cast<Handle>(bits);
+                }
+            }
+
+            template <typename Handle> static constexpr HandleType handle_type()
+            {
+                if constexpr (std::is_same_v<Handle, VkBuffer>) return HandleType::Buffer;
+                else if constexpr (std::is_same_v<Handle, VkImage>) return HandleType::Image;
+                else if constexpr (std::is_same_v<Handle, VkImageView>) return HandleType::ImageView;
+                else if constexpr (std::is_same_v<Handle, VkSampler>) return HandleType::Sampler;
+                else if constexpr (std::is_same_v<Handle, VkFramebuffer>) return HandleType::Framebuffer;
+                else if constexpr (std::is_same_v<Handle, VkRenderPass>) return HandleType::RenderPass;
+                else if constexpr (std::is_same_v<Handle, VkPipeline>) return HandleType::Pipeline;
+                else if constexpr (std::is_same_v<Handle, VkPipelineLayout>) return HandleType::PipelineLayout;
+                else if constexpr (std::is_same_v<Handle, VkDescriptorPool>) return HandleType::DescriptorPool;
+                else if constexpr (std::is_same_v<Handle, VkDescriptorSetLayout>) return HandleType::DescriptorSetLayout;
+                else if constexpr (std::is_same_v<Handle, VkShaderModule>) return HandleType::ShaderModule;
+                else if constexpr (std::is_same_v<Handle, VkSemaphore>) return HandleType::Semaphore;
+                else if constexpr (std::is_same_v<Handle, VkFence>) return HandleType::Fence;
+                else if constexpr (std::is_same_v<Handle, VkEvent>) return HandleType::Event;
+                else if constexpr (std::is_same_v<Handle, VkQueryPool>) return HandleType::QueryPool;
+                else if constexpr (std::is_same_v<Handle, VkCommandPool>) return HandleType::CommandPool;
+                else if constexpr (std::is_same_v<Handle, VkDeviceMemory>) return HandleType::DeviceMemory;
+                else if constexpr (std::is_same_v<Handle, VkSwapchainKHR>) return HandleType::Swapchain;
+                else static_assert(sizeof(Handle) == 0, "DeletionQueue: unsupported handle type");
+            }
+
+            void destroy(const Record& record) const
+            {
+                const uint64_t h = record.handle;
+                switch (record.type)
+                {
+                    case HandleType::Buffer:
+                        if (record.allocation != VK_NULL_HANDLE)
+                        {
+                            vmaDestroyBuffer(record.vma_allocator, from_bits<VkBuffer>(h), record.allocation);
+                        }
+                        else
+                        {
+                            vkDestroyBuffer(device_, from_bits<VkBuffer>(h), nullptr);
+                        }
+                        break;
+                    case HandleType::Image:
+                        if (record.allocation != VK_NULL_HANDLE)
+                        {
+                            vmaDestroyImage(record.vma_allocator, from_bits<VkImage>(h), record.allocation);
+                        }
+                        else
+                        {
+                            vkDestroyImage(device_, from_bits<VkImage>(h), nullptr);
+                        }
+                        break;
+                    case HandleType::ImageView: vkDestroyImageView(device_, from_bits<VkImageView>(h), nullptr);
+                        break;
+                    case HandleType::Sampler: vkDestroySampler(device_, from_bits<VkSampler>(h), nullptr);
+                        break;
+                    case HandleType::Framebuffer: vkDestroyFramebuffer(device_, from_bits<VkFramebuffer>(h), nullptr);
+                        break;
+                    case HandleType::RenderPass: vkDestroyRenderPass(device_, from_bits<VkRenderPass>(h), nullptr);
+                        break;
+                    case HandleType::Pipeline: vkDestroyPipeline(device_, from_bits<VkPipeline>(h), nullptr);
+                        break;
+                    case HandleType::PipelineLayout: vkDestroyPipelineLayout(device_, from_bits<VkPipelineLayout>(h), nullptr);
+                        break;
+                    case HandleType::DescriptorPool: vkDestroyDescriptorPool(device_, from_bits<VkDescriptorPool>(h), nullptr);
+                        break;
+                    case HandleType::DescriptorSetLayout: vkDestroyDescriptorSetLayout(device_, from_bits<VkDescriptorSetLayout>(h), nullptr);
+                        break;
+                    case HandleType::ShaderModule: vkDestroyShaderModule(device_, from_bits<VkShaderModule>(h), nullptr);
+                        break;
+                    case HandleType::Semaphore: vkDestroySemaphore(device_, from_bits<VkSemaphore>(h), nullptr);
+                        break;
+                    case HandleType::Fence: vkDestroyFence(device_, from_bits<VkFence>(h), nullptr);
+                        break;
+                    case HandleType::Event: vkDestroyEvent(device_, from_bits<VkEvent>(h), nullptr);
+                        break;
+                    case HandleType::QueryPool: vkDestroyQueryPool(device_, from_bits<VkQueryPool>(h), nullptr);
+                        break;
+                    case HandleType::CommandPool: vkDestroyCommandPool(device_, from_bits<VkCommandPool>(h), nullptr);
+                        break;
+                    case HandleType::DeviceMemory: vkFreeMemory(device_, from_bits<VkDeviceMemory>(h), nullptr);
+                        break;
+                    case HandleType::Swapchain: vkDestroySwapchainKHR(device_, from_bits<VkSwapchainKHR>(h), nullptr);
+                        break;
+                    case HandleType::Allocation: vmaFreeMemory(record.vma_allocator, record.allocation);
+                        break;
+                }
+            }
+    };
+} // namespace vulkan_engine::vulkan
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+namespace vulkan_engine::vulkan
+{
+    /**
+     * @brief One monotonically increasing timeline value per queue
+     *
+     * Every submission made through submit() signals the queue's timeline
+     * semaphore with the next value, so "all work up to submission N has
+     * finished" is a single counter comparison. Frame slots, uploads, deferred
+     * deletion, readback and query resolve keep the value they were submitted
+     * with and ask is_complete(N) / wait(N) instead of owning fences:
+     *
+     *     const uint64_t value = timeline.submit(&submit_info, 1);
+     *     ...
+     *     if (timeline.is_complete(value)) { reuse(); }
+     *
+     * submit() serialises access to the queue, so values are signalled in the
+     * order they are handed out. Queries may be made from any thread.
+     */
+    class QueueTimeline
+    {
+        public:
+            // A value to wait for on some queue's timeline
+            struct WaitPoint
+            {
+                const QueueTimeline* timeline = nullptr;
+                uint64_t             value    = 0;
+            };
+
+            QueueTimeline(VkDevice device, VkQueue queue);
+            ~QueueTimeline();
+
+            QueueTimeline(const QueueTimeline&)            = delete;
+            QueueTimeline& operator=(const QueueTimeline&) = delete;
+
+            // Submit the batches; the last one additionally signals the timeline and
+            // must not chain its own VkTimelineSemaphoreSubmitInfo. Returns the
+            // signalled value, or 0 if the submission failed.
+            uint64_t submit(VkSubmitInfo* batches, uint32_t batch_count, VkFence fence = VK_NULL_HANDLE);
+
+            // Value of the most recent submit(); 0 before the first one
+            uint64_t last_submitted() const { return last_submitted_.load(std::memory_order_acquire); }
+
+            // Highest value the GPU has reached. Queries the semaphore.
+            uint64_t completed_value() const;
+
+            // Value 0 is always complete
+            bool is_complete(uint64_t value) const;
+
+            // False on timeout or device loss
+            bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
+            bool wait_idle(uint64_t timeout = UINT64_MAX) const { return wait(last_submitted(), timeout); }
+
+            // One vkWaitSemaphores call for points on several queues (all must share a device)
+            static bool wait_all(std::span<const WaitPoint> points, uint64_t timeout = UINT64_MAX);
+
+            VkSemaphore semaphore() const { return semaphore_; }
+            VkQueue     queue() const { return queue_; }
+
+        private:
+            VkDevice    device_    = VK_NULL_HANDLE;
+            VkQueue     queue_     = VK_NULL_HANDLE;
+            VkSemaphore semaphore_ = VK_NULL_HANDLE;
+
+            std::mutex                    submit_mutex_; // Queue access and value order
+            std::atomic<uint64_t>         last_submitted_{0};
+            mutable std::atomic<uint64_t> completed_{0}; // Cache, so satisfied queries skip the driver
+    };
+} // namespace vulkan_engine::vulkan
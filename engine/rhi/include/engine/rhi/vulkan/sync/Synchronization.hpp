@@ -4,6 +4,7 @@
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace vulkan_engine::vulkan
@@ -46,7 +47,14 @@ namespace vulkan_engine::vulkan
 
             VkSemaphore handle() const { return semaphore_; }
 
+            // Gives up ownership without destroying, so the semaphore can outlive
+            // presents or submits that still wait on it
+            VkSemaphore release() noexcept;
+
         protected:
+            // create_next is chained into VkSemaphoreCreateInfo (semaphore type)
+            Semaphore(std::shared_ptr<DeviceManager> device, const void* create_next);
+
             std::shared_ptr<DeviceManager> device_;
             VkSemaphore                    semaphore_ = VK_NULL_HANDLE;
     };
@@ -57,9 +65,13 @@ namespace vulkan_engine::vulkan
             TimelineSemaphore(std::shared_ptr<DeviceManager> device, uint64_t initial_value = 0);
             ~TimelineSemaphore() = default;
 
+            // Host-side signal and wait; wait returns false on timeout
             void     signal(uint64_t value);
-            void     wait(uint64_t value, uint64_t timeout = UINT64_MAX);
+            bool     wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
             uint64_t get_value() const;
+
+        private:
+            TimelineSemaphore(std::shared_ptr<DeviceManager> device, const VkSemaphoreTypeCreateInfo& type_info);
     };
 
     class Event
@@ -102,6 +114,11 @@ namespace vulkan_engine::vulkan
                 uint64_t                                   timeout  = UINT64_MAX);
             void reset_fences(const std::vector<std::shared_ptr<Fence>>& fences);
 
+            // One host wait for several timeline values, e.g. across queues
+            bool wait_for_timelines(
+                const std::vector<std::pair<std::shared_ptr<TimelineSemaphore>, uint64_t>>& values,
+                uint64_t                                                                  timeout = UINT64_MAX);
+
             void submit_with_sync(
                 VkQueue                                        queue,
                 VkCommandBuffer                                cmd,
@@ -117,12 +134,13 @@ namespace vulkan_engine::vulkan
      * @brief Simplified frame synchronization manager
      * 
      * Hybrid architecture:
-     * - Per-frame: Fence (for command buffer lifecycle management)
+     * - Per-frame: graphics timeline value (for command buffer lifecycle management)
      * - Per-image: Semaphore (for swapchain image synchronization)
      * 
      * This design follows Vulkan best practices:
      * - Each swapchain image gets its own acquire/render_finished semaphore
-     * - Fence tracks per-frame CPU-GPU synchronization
+     * - A frame slot is free once the device's graphics QueueTimeline has reached
+     *   the value its last submission signalled; no per-frame fences
      */
     class FrameSyncManager
     {
@@ -154,18 +172,18 @@ namespace vulkan_engine::vulkan
                 return current_frame_;
             }
 
-            // Per-frame: CPU-GPU synchronization (for command buffer recycling)
-            Fence& get_frame_fence(uint32_t frame) { return *frame_fences_[frame]; }
-            Fence& get_current_frame_fence() { return *frame_fences_[current_frame_]; }
+            // Per-frame: timeline value signalled by the slot's last submission (0 = none yet)
+            uint64_t frame_value(uint32_t frame) const { return frame_values_[frame]; }
+            void     set_current_frame_value(uint64_t value) { frame_values_[current_frame_] = value; }
 
             /**
-             * @brief Wait for frame fence and reset for reuse
+             * @brief Wait until the GPU has finished the frame slot's last submission
              * 
              * This ensures GPU has finished all work for this frame slot
              * and the command buffers can be safely reset.
              */
-            void wait_and_reset_frame_fence(uint32_t frame, uint64_t timeout = UINT64_MAX);
-            void wait_and_reset_current_frame_fence(uint64_t timeout = UINT64_MAX);
+            bool wait_for_frame(uint32_t frame, uint64_t timeout = UINT64_MAX);
+            bool wait_for_current_frame(uint64_t timeout = UINT64_MAX) { return wait_for_frame(current_frame_, timeout); }
 
             // Per-frame: acquire semaphore for vkAcquireNextImageKHR
             // (must be per-frame because we don't know image index until after acquire)
@@ -178,10 +196,6 @@ namespace vulkan_engine::vulkan
             // Resize per-image semaphores when swapchain is recreated
             void resize_render_finished_semaphores(uint32_t image_count);
 
-            // Per-frame: Scene rendering synchronization
-            Semaphore& get_scene_finished_semaphore(uint32_t frame) { return *scene_finished_semaphores_[frame]; }
-            Semaphore& get_current_scene_finished_semaphore() { return *scene_finished_semaphores_[current_frame_]; }
-
             uint32_t max_frames_in_flight() const { return max_frames_in_flight_; }
 
             /**
@@ -195,11 +209,8 @@ namespace vulkan_engine::vulkan
             uint32_t                       max_frames_in_flight_;
             uint32_t                       current_frame_ = 0;
 
-            // Per-frame: CPU-GPU synchronization (fence for command buffer lifecycle)
-            std::vector<std::unique_ptr<Fence>> frame_fences_;
-
-            // Per-frame: Scene -> ImGui dependency
-            std::vector<std::unique_ptr<Semaphore>> scene_finished_semaphores_;
+            // Per-frame: CPU-GPU synchronization (graphics timeline value for command buffer lifecycle)
+            std::vector<uint64_t> frame_values_;
 
             // Per-image: GPU-GPU synchronization for swapchain
             // These are indexed by swapchain image index
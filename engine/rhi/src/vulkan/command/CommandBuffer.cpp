@@ -30,6 +30,7 @@ namespace vulkan_engine::vulkan
         , cmd_buffer_(other.cmd_buffer_)
         , pool_(other.pool_)
         , is_recording_(other.is_recording_)
+        , stats_(other.stats_)
     {
         other.cmd_buffer_   = VK_NULL_HANDLE;
         other.pool_         = VK_NULL_HANDLE;
@@ -44,6 +45,7 @@ namespace vulkan_engine::vulkan
             cmd_buffer_   = other.cmd_buffer_;
             pool_         = other.pool_;
             is_recording_ = other.is_recording_;
+            stats_        = other.stats_;
 
             other.cmd_buffer_   = VK_NULL_HANDLE;
             other.pool_         = VK_NULL_HANDLE;
@@ -64,6 +66,7 @@ namespace vulkan_engine::vulkan
             throw VulkanError(result, "Failed to begin command buffer", __FILE__, __LINE__);
         }
         is_recording_ = true;
+        stats_        = {};
     }
 
     void RenderCommandBuffer::end()
@@ -174,11 +177,15 @@ namespace vulkan_engine::vulkan
     void RenderCommandBuffer::bind_pipeline(VkPipeline pipeline)
     {
         vkCmdBindPipeline(cmd_buffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            ++stats_.pipeline_binds;
+        }
     }
 
     void RenderCommandBuffer::bind_graphics_pipeline(GraphicsPipeline& pipeline)
     {
-        vkCmdBindPipeline(cmd_buffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.handle());
+        bind_pipeline(pipeline.handle());
     }
 
     void RenderCommandBuffer::bind_descriptor_sets(
@@ -196,6 +203,32 @@ namespace vulkan_engine::vulkan
                                 descriptor_sets.data(),
                                 static_cast<uint32_t>(dynamic_offsets.size()),
                                 dynamic_offsets.empty() ? nullptr : dynamic_offsets.data());
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            stats_.descriptor_binds += static_cast<uint32_t>(descriptor_sets.size());
+        }
+    }
+
+    void RenderCommandBuffer::bind_descriptor_set(
+        VkPipelineLayout layout,
+        uint32_t         set,
+        VkDescriptorSet  descriptor_set,
+        uint32_t         dynamic_offset_count,
+        const uint32_t*  dynamic_offsets)
+    {
+        vkCmdBindDescriptorSets(
+                                cmd_buffer_,
+                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                layout,
+                                set,
+                                1,
+                                &descriptor_set,
+                                dynamic_offset_count,
+                                dynamic_offsets);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            ++stats_.descriptor_binds;
+        }
     }
 
     void RenderCommandBuffer::push_constants(
@@ -206,6 +239,10 @@ namespace vulkan_engine::vulkan
         const void*        values)
     {
         vkCmdPushConstants(cmd_buffer_, layout, stage_flags, offset, size, values);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            ++stats_.push_constants;
+        }
     }
 
     void RenderCommandBuffer::set_viewport(float x, float y, float width, float height, float min_depth, float max_depth)
@@ -249,6 +286,11 @@ namespace vulkan_engine::vulkan
     void RenderCommandBuffer::draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
     {
         vkCmdDraw(cmd_buffer_, vertex_count, instance_count, first_vertex, first_instance);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            ++stats_.draws;
+            stats_.primitives += static_cast<uint64_t>(vertex_count / 3) * instance_count;
+        }
     }
 
     void RenderCommandBuffer::draw_indexed(
@@ -259,6 +301,11 @@ namespace vulkan_engine::vulkan
         uint32_t first_instance)
     {
         vkCmdDrawIndexed(cmd_buffer_, index_count, instance_count, first_index, vertex_offset, first_instance);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            ++stats_.draws;
+            stats_.primitives += static_cast<uint64_t>(index_count / 3) * instance_count;
+        }
     }
 
     void RenderCommandBuffer::transition_image_layout(
@@ -326,6 +373,10 @@ namespace vulkan_engine::vulkan
                              nullptr,
                              1,
                              &barrier);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            ++stats_.barriers;
+        }
     }
 
     void RenderCommandBuffer::transition_image_layout(
@@ -344,6 +395,31 @@ namespace vulkan_engine::vulkan
         transition_image_layout(image, old_layout, new_layout, subresource_range);
     }
 
+    void RenderCommandBuffer::pipeline_barrier(
+        VkPipelineStageFlags         src_stage,
+        VkPipelineStageFlags         dst_stage,
+        uint32_t                     buffer_barrier_count,
+        const VkBufferMemoryBarrier* buffer_barriers,
+        uint32_t                     image_barrier_count,
+        const VkImageMemoryBarrier*  image_barriers)
+    {
+        vkCmdPipelineBarrier(
+                             cmd_buffer_,
+                             src_stage,
+                             dst_stage,
+                             0,
+                             0,
+                             nullptr,
+                             buffer_barrier_count,
+                             buffer_barriers,
+                             image_barrier_count,
+                             image_barriers);
+        if constexpr (COMMAND_STATS_COMPILED_IN)
+        {
+            stats_.barriers += buffer_barrier_count + image_barrier_count;
+        }
+    }
+
     void RenderCommandBuffer::submit(
         VkQueue                                  queue,
         VkFence                                  fence,
@@ -0,0 +1,345 @@
+#include "engine/rhi/vulkan/command/GpuProfiler.hpp"
+#include "engine/core/utils/Logger.hpp"
+
+#include <algorithm>
+
+namespace vulkan_engine::vulkan
+{
+    namespace
+    {
+        constexpr VkQueryPipelineStatisticFlags STATISTICS_FLAGS =
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+        constexpr uint32_t STATISTICS_COUNTERS = 6; // Bits set in STATISTICS_FLAGS
+    } // namespace
+
+    GpuProfiler::GpuProfiler(std::shared_ptr<DeviceManager> device, const Config& config)
+        : device_(std::move(device))
+        , config_(config)
+    {
+        config_.frame_count = std::max(config_.frame_count, 1u);
+        config_.max_scopes  = std::max(config_.max_scopes, 1u);
+
+        // Both read once; the old timer queried the device properties on every read
+        const VkPhysicalDeviceLimits& limits = device_->properties().limits;
+        timestamp_period_                    = limits.timestampPeriod;
+
+        uint32_t family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device_->physical_device().handle(), &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(device_->physical_device().handle(), &family_count, families.data());
+
+        uint32_t valid_bits = 0;
+        if (device_->graphics_queue_family() < family_count)
+        {
+            valid_bits = families[device_->graphics_queue_family()].timestampValidBits;
+        }
+
+        supported_ = valid_bits > 0 && limits.timestampPeriod > 0.0f;
+        if (!supported_)
+        {
+            logger::warn("GPU timestamp queries not supported on the graphics queue");
+            return;
+        }
+        timestamp_mask_ = valid_bits >= 64 ? ~0ull : (1ull << valid_bits) - 1;
+
+        statistics_enabled_ = config_.pipeline_statistics && device_->features().pipeline_statistics;
+        if (config_.pipeline_statistics && !statistics_enabled_)
+        {
+            logger::warn("Pipeline statistics queries not supported, GPU profiler records timestamps only");
+        }
+
+        create_pools();
+    }
+
+    GpuProfiler::~GpuProfiler()
+    {
+        destroy_pools();
+    }
+
+    void GpuProfiler::create_pools()
+    {
+        VkDevice device = device_->device().handle();
+
+        slots_.resize(config_.frame_count);
+        for (auto& slot : slots_)
+        {
+            VkQueryPoolCreateInfo pool_info{};
+            pool_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            pool_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+            pool_info.queryCount = config_.max_scopes * 2;
+
+            if (vkCreateQueryPool(device, &pool_info, nullptr, &slot.timestamp_pool) != VK_SUCCESS)
+            {
+                logger::error("Failed to create GPU profiler timestamp pool");
+                supported_ = false;
+                break;
+            }
+
+            if (statistics_enabled_)
+            {
+                VkQueryPoolCreateInfo statistics_info{};
+                statistics_info.sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+                statistics_info.queryType          = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+                statistics_info.queryCount         = config_.max_scopes;
+                statistics_info.pipelineStatistics = STATISTICS_FLAGS;
+
+                if (vkCreateQueryPool(device, &statistics_info, nullptr, &slot.statistics_pool) != VK_SUCCESS)
+                {
+                    logger::warn("Failed to create GPU profiler statistics pool, recording timestamps only");
+                    statistics_enabled_ = false;
+                }
+            }
+
+            slot.scopes.resize(config_.max_scopes);
+        }
+
+        if (!supported_)
+        {
+            destroy_pools();
+            return;
+        }
+
+        if (!statistics_enabled_)
+        {
+            // A later slot failed; drop the statistics pools the earlier ones got
+            for (auto& slot : slots_)
+            {
+                if (slot.statistics_pool != VK_NULL_HANDLE)
+                {
+                    vkDestroyQueryPool(device, slot.statistics_pool, nullptr);
+                    slot.statistics_pool = VK_NULL_HANDLE;
+                }
+            }
+        }
+
+        timestamp_data_.resize(static_cast<size_t>(config_.max_scopes) * 4);
+        if (statistics_enabled_)
+        {
+            statistics_data_.resize(static_cast<size_t>(config_.max_scopes) * (STATISTICS_COUNTERS + 1));
+        }
+        open_scopes_.reserve(16);
+        results_.reserve(config_.max_scopes);
+    }
+
+    void GpuProfiler::destroy_pools()
+    {
+        if (!device_)
+        {
+            return;
+        }
+
+        VkDevice device = device_->device().handle();
+        for (auto& slot : slots_)
+        {
+            if (slot.timestamp_pool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(device, slot.timestamp_pool, nullptr);
+            }
+            if (slot.statistics_pool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(device, slot.statistics_pool, nullptr);
+            }
+        }
+        slots_.clear();
+        current_ = nullptr;
+    }
+
+    void GpuProfiler::begin_frame(VkCommandBuffer cmd, uint32_t frame_index)
+    {
+        if (!supported_ || slots_.empty())
+        {
+            return;
+        }
+
+        if (!open_scopes_.empty())
+        {
+            logger::warn("GPU profiler: ", open_scopes_.size(), " scope(s) left open in the previous frame");
+            open_scopes_.clear();
+        }
+        open_statistics_ = DROPPED_SCOPE;
+
+        FrameSlot& slot = slots_[frame_index % slots_.size()];
+        if (slot.reset && slot.scope_count > 0)
+        {
+            resolve(slot);
+        }
+
+        vkCmdResetQueryPool(cmd, slot.timestamp_pool, 0, config_.max_scopes * 2);
+        if (slot.statistics_pool != VK_NULL_HANDLE)
+        {
+            vkCmdResetQueryPool(cmd, slot.statistics_pool, 0, config_.max_scopes);
+        }
+        slot.reset       = true;
+        slot.scope_count = 0;
+        current_         = &slot;
+    }
+
+    void GpuProfiler::begin_scope(VkCommandBuffer cmd, std::string_view name, bool statistics)
+    {
+        if (!current_)
+        {
+            return;
+        }
+
+        if (current_->scope_count >= config_.max_scopes)
+        {
+            open_scopes_.push_back(DROPPED_SCOPE);
+            return;
+        }
+
+        const uint32_t index  = current_->scope_count++;
+        ScopeRecord&   record = current_->scopes[index];
+        record.name.assign(name); // Reuses the string's capacity from earlier frames
+        record.depth      = static_cast<uint32_t>(open_scopes_.size());
+        record.parent     = NO_PARENT;
+        record.closed     = false;
+        record.statistics = false;
+
+        // Skip over dropped scopes to the nearest recorded ancestor
+        for (auto it = open_scopes_.rbegin(); it != open_scopes_.rend(); ++it)
+        {
+            if (*it != DROPPED_SCOPE)
+            {
+                record.parent = *it;
+                break;
+            }
+        }
+
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, current_->timestamp_pool, index * 2);
+
+        if (statistics && current_->statistics_pool != VK_NULL_HANDLE && open_statistics_ == DROPPED_SCOPE)
+        {
+            vkCmdBeginQuery(cmd, current_->statistics_pool, index, 0);
+            record.statistics = true;
+            open_statistics_  = index;
+        }
+
+        open_scopes_.push_back(index);
+    }
+
+    void GpuProfiler::end_scope(VkCommandBuffer cmd)
+    {
+        if (!current_ || open_scopes_.empty())
+        {
+            return;
+        }
+
+        const uint32_t index = open_scopes_.back();
+        open_scopes_.pop_back();
+        if (index == DROPPED_SCOPE)
+        {
+            return;
+        }
+
+        if (open_statistics_ == index)
+        {
+            vkCmdEndQuery(cmd, current_->statistics_pool, index);
+            open_statistics_ = DROPPED_SCOPE;
+        }
+
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, current_->timestamp_pool, index * 2 + 1);
+        current_->scopes[index].closed = true;
+    }
+
+    void GpuProfiler::resolve(FrameSlot& slot)
+    {
+        VkDevice       device = device_->device().handle();
+        const uint32_t count  = slot.scope_count;
+
+        // No WAIT bit: VK_NOT_READY just means some availability words are zero
+        const VkQueryResultFlags flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+
+        VkResult result = vkGetQueryPoolResults(
+                                                device,
+                                                slot.timestamp_pool,
+                                                0,
+                                                count * 2,
+                                                sizeof(uint64_t) * 4 * count,
+                                                timestamp_data_.data(),
+                                                sizeof(uint64_t) * 2,
+                                                flags);
+        if (result != VK_SUCCESS && result != VK_NOT_READY)
+        {
+            return;
+        }
+
+        bool statistics_valid = false;
+        if (slot.statistics_pool != VK_NULL_HANDLE)
+        {
+            const size_t stride = sizeof(uint64_t) * (STATISTICS_COUNTERS + 1);
+            result              = vkGetQueryPoolResults(
+                                                        device,
+                                                        slot.statistics_pool,
+                                                        0,
+                                                        count,
+                                                        stride * count,
+                                                        statistics_data_.data(),
+                                                        stride,
+                                                        flags);
+            statistics_valid = result == VK_SUCCESS || result == VK_NOT_READY;
+        }
+
+        // A scope that was not recorded or not yet available gets no entry, so
+        // parents are remapped to their index in results_. Entries are reused to
+        // keep their name strings' capacity.
+        size_t      used = 0;
+        std::string key;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            ScopeRecord&    record = slot.scopes[i];
+            const uint64_t* begin  = &timestamp_data_[static_cast<size_t>(i) * 4];
+            const uint64_t* end    = begin + 2;
+
+            record.result = NO_PARENT;
+            if (!record.closed || begin[1] == 0 || end[1] == 0)
+            {
+                continue;
+            }
+
+            const uint64_t ticks = (end[0] - begin[0]) & timestamp_mask_;
+
+            ScopeTiming& timing = used < results_.size() ? results_[used] : results_.emplace_back();
+            timing.name.assign(record.name);
+            timing.depth          = record.depth;
+            timing.parent         = record.parent == NO_PARENT ? NO_PARENT : slot.scopes[record.parent].result;
+            timing.gpu_ms         = static_cast<float>(static_cast<double>(ticks) * timestamp_period_ / 1000000.0);
+            timing.has_statistics = false;
+            timing.statistics     = {};
+
+            // Running average instead of summing a history ring every frame
+            key.assign(1, static_cast<char>('0' + std::min(record.depth, 9u)));
+            key.append(record.name);
+            auto [it, inserted] = averages_.try_emplace(key, timing.gpu_ms);
+            if (!inserted)
+            {
+                it->second += (timing.gpu_ms - it->second) * config_.smoothing;
+            }
+            timing.average_ms = it->second;
+
+            if (statistics_valid && record.statistics)
+            {
+                const uint64_t* counters = &statistics_data_[static_cast<size_t>(i) * (STATISTICS_COUNTERS + 1)];
+                if (counters[STATISTICS_COUNTERS] != 0)
+                {
+                    timing.has_statistics                  = true;
+                    timing.statistics.input_vertices       = counters[0];
+                    timing.statistics.input_primitives     = counters[1];
+                    timing.statistics.vertex_invocations   = counters[2];
+                    timing.statistics.clipping_primitives  = counters[3];
+                    timing.statistics.fragment_invocations = counters[4];
+                    timing.statistics.compute_invocations  = counters[5];
+                }
+            }
+
+            record.result = static_cast<uint32_t>(used++);
+        }
+        results_.resize(used);
+        ++resolved_frames_;
+    }
+} // namespace vulkan_engine::vulkan
@@ -3,6 +3,8 @@
 #endif
 
 #include "engine/rhi/vulkan/device/Device.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/core/utils/Logger.hpp"
 #include <set>
 #include <string>
@@ -45,6 +47,9 @@ namespace vulkan_engine::vulkan
             setup_debug_messenger();
         }
 
+        deletion_queue_    = std::make_unique<DeletionQueue>(device_.handle());
+        graphics_timeline_ = std::make_unique<QueueTimeline>(device_.handle(), graphics_queue_.handle());
+
         LOG_INFO("DeviceManager initialized successfully");
         return true;
     }
@@ -62,6 +67,13 @@ namespace vulkan_engine::vulkan
             }
         }
 
+        if (deletion_queue_)
+        {
+            vkDeviceWaitIdle(device_);
+            deletion_queue_.reset();
+        }
+        graphics_timeline_.reset();
+
         if (device_)
         {
             vkDestroyDevice(device_, nullptr);
@@ -93,6 +105,11 @@ namespace vulkan_engine::vulkan
         throw std::runtime_error("Failed to find suitable memory type");
     }
 
+    void DeviceManager::set_resource_manager(std::weak_ptr<memory::ResourceManager> resource_manager)
+    {
+        resource_manager_ = std::move(resource_manager);
+    }
+
     bool DeviceManager::create_instance()
     {
         VkApplicationInfo app_info{};
@@ -108,12 +125,14 @@ namespace vulkan_engine::vulkan
         create_info.pApplicationInfo = &app_info;
 
         // Required extensions
-        std::vector<const char*> extensions = {
-            VK_KHR_SURFACE_EXTENSION_NAME,
+        std::vector<const char*> extensions;
+        if (!create_info_.headless)
+        {
+            extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
             #ifdef _WIN32
-            VK_KHR_WIN32_SURFACE_EXTENSION_NAME,
+            extensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
             #endif
-        };
+        }
 
         if (create_info_.enable_debug_utils)
         {
@@ -161,7 +180,14 @@ namespace vulkan_engine::vulkan
 
         for (auto device : devices)
         {
-            uint64_t score = static_cast<uint64_t>(score_device(device));
+            if (!check_device_support(device))
+            {
+                continue;
+            }
+
+            // +1 so a supported device always beats "none", even a CPU
+            // implementation with no device-local heap worth scoring
+            uint64_t score = score_device(device) + 1;
             if (score > best_score)
             {
                 best_score  = score;
@@ -208,7 +234,11 @@ namespace vulkan_engine::vulkan
         }
 
         // Device features
+        VkPhysicalDeviceFeatures supported_features{};
+        vkGetPhysicalDeviceFeatures(physical_device_.handle(), &supported_features);
+
         VkPhysicalDeviceFeatures device_features{};
+        device_features.pipelineStatisticsQuery = supported_features.pipelineStatisticsQuery; // GPU profiler counters
 
         // Create device queues
         std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
@@ -227,15 +257,24 @@ namespace vulkan_engine::vulkan
 
         // Required device extensions
         std::vector<const char*> device_extensions = {
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME,
             VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME // Enable Dynamic Rendering
         };
+        if (!create_info_.headless)
+        {
+            device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
 
         // Enable Dynamic Rendering feature
         VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features{};
         dynamic_rendering_features.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
         dynamic_rendering_features.dynamicRendering = VK_TRUE;
 
+        // Timeline semaphores (core in 1.2) back the per-queue frame/resource timeline
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features{};
+        timeline_semaphore_features.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+        dynamic_rendering_features.pNext              = &timeline_semaphore_features;
+
         VkDeviceCreateInfo create_info{};
         create_info.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         create_info.pNext                   = &dynamic_rendering_features; // Chain dynamic rendering features
@@ -254,7 +293,9 @@ namespace vulkan_engine::vulkan
         device_.set_handle(device_handle);
 
         // Mark dynamic rendering as enabled
-        features_.dynamic_rendering = true;
+        features_.dynamic_rendering   = true;
+        features_.timeline_semaphores = true;
+        features_.pipeline_statistics = device_features.pipelineStatisticsQuery == VK_TRUE;
         LOG_INFO("Dynamic Rendering enabled");
 
         // Get graphics queue
@@ -313,18 +354,25 @@ namespace vulkan_engine::vulkan
         vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, available_extensions.data());
 
         std::set<std::string> required_extensions = {
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME,
             VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME
         };
+        if (!create_info_.headless)
+        {
+            required_extensions.insert(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
 
         for (const auto& extension : available_extensions)
         {
             required_extensions.erase(extension.extensionName);
         }
 
-        // Also check if dynamic rendering feature is supported
+        // Also check if dynamic rendering and timeline semaphores are supported
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features{};
+        timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
         VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features{};
         dynamic_rendering_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+        dynamic_rendering_features.pNext = &timeline_semaphore_features;
 
         VkPhysicalDeviceFeatures2 features2{};
         features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
@@ -338,6 +386,12 @@ namespace vulkan_engine::vulkan
             return false;
         }
 
+        if (!timeline_semaphore_features.timelineSemaphore)
+        {
+            LOG_WARN("Device does not support timeline semaphores");
+            return false;
+        }
+
         return required_extensions.empty();
     }
 
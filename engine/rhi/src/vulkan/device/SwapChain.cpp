@@ -6,6 +6,8 @@
 
 #include "engine/rhi/vulkan/device/SwapChain.hpp"
 #include "engine/platform/windowing/Window.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include <algorithm>
 #include <limits>
@@ -42,6 +44,7 @@ namespace vulkan_engine::vulkan
         , extent_(other.extent_)
         , transform_(other.transform_)
         , images_(std::move(other.images_))
+        , retired_(std::move(other.retired_))
         , graphics_queue_family_(other.graphics_queue_family_)
         , present_queue_family_(other.present_queue_family_)
         , queues_are_same_(other.queues_are_same_)
@@ -71,6 +74,7 @@ namespace vulkan_engine::vulkan
             extent_                = other.extent_;
             transform_             = other.transform_;
             images_                = std::move(other.images_);
+            retired_               = std::move(other.retired_);
             graphics_queue_family_ = other.graphics_queue_family_;
             present_queue_family_  = other.present_queue_family_;
             queues_are_same_       = other.queues_are_same_;
@@ -140,6 +144,7 @@ namespace vulkan_engine::vulkan
             vkDeviceWaitIdle(device_->device());
         }
 
+        release_retired(true);
         cleanup_image_views();
 
         if (default_render_pass_ != VK_NULL_HANDLE)
@@ -159,49 +164,45 @@ namespace vulkan_engine::vulkan
 
     bool SwapChain::recreate()
     {
-        // Wait for device to be idle
-        vkDeviceWaitIdle(device_->device());
-
-        // Cleanup old render pass
-        if (default_render_pass_ != VK_NULL_HANDLE)
-        {
-            vkDestroyRenderPass(device_->device(), default_render_pass_, nullptr);
-            default_render_pass_ = VK_NULL_HANDLE;
-        }
-
-        // Cleanup old swap chain
-        cleanup_image_views();
-        cleanup_swap_chain();
-
-        // Get new window size
+        // Window is minimized, delay recreation
         auto [width, height] = window_->size();
         if (width == 0 || height == 0)
         {
-            // Window is minimized, delay recreation
             return false;
         }
 
-        // Recreate
         if (!select_extent())
         {
             return false;
         }
 
-        if (!create_swap_chain())
+        // No device wait: frames in flight keep using the old images. They are
+        // retired once a frame on the new swap chain has been submitted, which
+        // orders their release after every present queued before it.
+        QueueTimeline*   timeline = device_->graphics_timeline();
+        RetiredSwapChain retired{};
+        retired.swap_chain    = swap_chain_;
+        retired.release_after = timeline ? timeline->last_submitted() + 1 : 0;
+        for (auto& image : images_)
         {
-            return false;
+            retired.views.push_back(image.view);
         }
+        images_.clear();
+        swap_chain_ = VK_NULL_HANDLE;
+        retired_.push_back(std::move(retired));
 
-        if (!create_image_views())
+        if (!create_swap_chain(retired_.back().swap_chain))
         {
             return false;
         }
 
-        if (!create_default_render_pass())
+        if (!create_image_views())
         {
             return false;
         }
 
+        // The default render pass only depends on the format, which a resize keeps
+
         needs_recreation_ = false;
 
         // Notify callback
@@ -213,11 +214,76 @@ namespace vulkan_engine::vulkan
         return true;
     }
 
+    void SwapChain::retire_semaphores(const std::vector<VkSemaphore>& semaphores)
+    {
+        if (retired_.empty())
+        {
+            // Nothing is presenting on an older swap chain
+            for (VkSemaphore semaphore : semaphores)
+            {
+                vkDestroySemaphore(device_->device(), semaphore, nullptr);
+            }
+            return;
+        }
+
+        auto& retired = retired_.back().semaphores;
+        retired.insert(retired.end(), semaphores.begin(), semaphores.end());
+    }
+
+    void SwapChain::release_retired(bool device_idle)
+    {
+        if (retired_.empty())
+        {
+            return;
+        }
+
+        QueueTimeline* timeline       = device_->graphics_timeline();
+        DeletionQueue* deletion_queue = device_->deletion_queue();
+
+        auto it = retired_.begin();
+        while (it != retired_.end())
+        {
+            if (device_idle)
+            {
+                for (VkImageView view : it->views)
+                {
+                    vkDestroyImageView(device_->device(), view, nullptr);
+                }
+                for (VkSemaphore semaphore : it->semaphores)
+                {
+                    vkDestroySemaphore(device_->device(), semaphore, nullptr);
+                }
+                vkDestroySwapchainKHR(device_->device(), it->swap_chain, nullptr);
+            }
+            else if (deletion_queue && timeline && timeline->last_submitted() >= it->release_after)
+            {
+                // Destroyed once the first frame on the new swap chain has completed
+                for (VkImageView view : it->views)
+                {
+                    deletion_queue->defer(view);
+                }
+                for (VkSemaphore semaphore : it->semaphores)
+                {
+                    deletion_queue->defer(semaphore);
+                }
+                deletion_queue->defer(it->swap_chain);
+            }
+            else
+            {
+                ++it;
+                continue;
+            }
+            it = retired_.erase(it);
+        }
+    }
+
     bool SwapChain::acquire_next_image(
         VkSemaphore image_available_semaphore,
         VkFence     fence,
         uint32_t&   out_image_index)
     {
+        release_retired(false);
+
         VkResult result = vkAcquireNextImageKHR(
                                                 device_->device(),
                                                 swap_chain_,
@@ -379,7 +445,7 @@ namespace vulkan_engine::vulkan
         return extent_.width > 0 && extent_.height > 0;
     }
 
-    bool SwapChain::create_swap_chain()
+    bool SwapChain::create_swap_chain(VkSwapchainKHR old_swap_chain)
     {
         VkSurfaceCapabilitiesKHR capabilities = get_surface_capabilities();
 
@@ -414,7 +480,7 @@ namespace vulkan_engine::vulkan
         create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
         create_info.presentMode    = present_mode_;
         create_info.clipped        = VK_TRUE;
-        create_info.oldSwapchain   = VK_NULL_HANDLE;
+        create_info.oldSwapchain   = old_swap_chain; // Lets the driver hand over resources and keep presenting
 
         VkResult result = vkCreateSwapchainKHR(device_->device(), &create_info, nullptr, &swap_chain_);
         if (result != VK_SUCCESS)
@@ -60,6 +60,10 @@ namespace vulkan_engine::vulkan::memory
                 {
                     vmaUnmapMemory(allocator->handle(), allocation_);
                 }
+                if (AllocationTracker* tracker = allocator->tracker())
+                {
+                    tracker->onFree(allocation_);
+                }
                 vmaFreeMemory(allocator->handle(), allocation_);
             }
             allocation_       = VK_NULL_HANDLE;
@@ -68,6 +72,29 @@ namespace vulkan_engine::vulkan::memory
         }
     }
 
+    VmaAllocation Allocation::release() noexcept
+    {
+        VmaAllocation allocation = allocation_;
+        if (allocation != VK_NULL_HANDLE)
+        {
+            if (auto allocator = allocator_.lock())
+            {
+                if (explicitlyMapped_ && mappedData_ != nullptr)
+                {
+                    vmaUnmapMemory(allocator->handle(), allocation);
+                }
+                if (AllocationTracker* tracker = allocator->tracker())
+                {
+                    tracker->onFree(allocation);
+                }
+            }
+            allocation_       = VK_NULL_HANDLE;
+            mappedData_       = nullptr;
+            explicitlyMapped_ = false;
+        }
+        return allocation;
+    }
+
     AllocationInfo Allocation::getInfo() const
     {
         AllocationInfo result = {};
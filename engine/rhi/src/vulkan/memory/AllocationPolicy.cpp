@@ -0,0 +1,243 @@
+#include "engine/rhi/vulkan/memory/AllocationPolicy.hpp"
+#include "engine/rhi/vulkan/device/Device.hpp"
+#include <algorithm>
+
+namespace vulkan_engine::vulkan::memory
+{
+    const char* toString(ResourceLifetime lifetime)
+    {
+        switch (lifetime)
+        {
+            case ResourceLifetime::Static:
+                return "Static";
+            case ResourceLifetime::Dynamic:
+                return "Dynamic";
+            case ResourceLifetime::Transient:
+                return "Transient";
+            case ResourceLifetime::Streaming:
+                return "Streaming";
+            default:
+                return "Unknown";
+        }
+    }
+
+    const char* toString(AllocationPlacement placement)
+    {
+        switch (placement)
+        {
+            case AllocationPlacement::Pooled:
+                return "Pooled";
+            case AllocationPlacement::Shared:
+                return "Shared";
+            case AllocationPlacement::Dedicated:
+                return "Dedicated";
+            default:
+                return "Unknown";
+        }
+    }
+
+    AllocationDecision AllocationPolicy::decide(const AllocationRequest& request) const
+    {
+        const Config config = this->config();
+
+        constexpr VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        const bool                  renderTarget    = request.image && (request.usage & attachmentUsage) != 0;
+
+        AllocationDecision decision;
+
+        // Short-lived resources are allocated often, so find a fit fast; long-lived
+        // ones stay put, so spend the time on a tight fit
+        const bool shortLived = request.lifetime == ResourceLifetime::Dynamic || request.lifetime == ResourceLifetime::Transient;
+        decision.flags        = shortLived ? VMA_ALLOCATION_CREATE_STRATEGY_MIN_TIME_BIT : VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT;
+
+        switch (request.lifetime)
+        {
+            case ResourceLifetime::Streaming:
+                decision.priority = config.streamingPriority;
+                break;
+            case ResourceLifetime::Transient:
+                decision.priority = config.transientPriority;
+                break;
+            default:
+                decision.priority = config.defaultPriority;
+                break;
+        }
+
+        if (request.requiresDedicated)
+        {
+            decision.placement    = AllocationPlacement::Dedicated;
+            decision.driverHinted = true;
+            decision.reason       = "driver requires dedicated";
+        }
+        else if (renderTarget && config.dedicatedRenderTargets)
+        {
+            decision.placement = AllocationPlacement::Dedicated;
+            decision.priority  = config.renderTargetPriority;
+            decision.reason    = "render target";
+        }
+        else if (request.prefersDedicated && config.honorDriverHints && request.size >= config.driverHintMinSize)
+        {
+            decision.placement    = AllocationPlacement::Dedicated;
+            decision.driverHinted = true;
+            decision.reason       = "driver prefers dedicated";
+        }
+        else if (request.image && request.size >= config.dedicatedImageMinSize)
+        {
+            decision.placement = AllocationPlacement::Dedicated;
+            decision.priority  = std::max(decision.priority, config.largeImagePriority);
+            decision.reason    = "large image";
+        }
+        else if (!request.image && request.size >= config.dedicatedBufferMinSize)
+        {
+            decision.placement = AllocationPlacement::Dedicated;
+            decision.reason    = "large buffer";
+        }
+        else if (request.poolAvailable && request.size <= config.pooledMaxSize)
+        {
+            decision.placement = AllocationPlacement::Pooled;
+            decision.reason    = "small resource";
+        }
+        else
+        {
+            decision.placement = AllocationPlacement::Shared;
+            decision.reason    = request.poolAvailable ? "too large for pool" : "no pool";
+        }
+
+        if (renderTarget)
+        {
+            decision.priority = config.renderTargetPriority;
+        }
+
+        if (decision.placement == AllocationPlacement::Dedicated)
+        {
+            // Strategy bits only matter when sub-allocating from a block
+            decision.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        }
+        return decision;
+    }
+
+    void AllocationPolicy::apply(const AllocationDecision& decision, VmaAllocationCreateInfo& allocInfo)
+    {
+        allocInfo.flags |= decision.flags;
+        allocInfo.priority = decision.priority;
+        if (decision.placement != AllocationPlacement::Pooled)
+        {
+            allocInfo.pool = VK_NULL_HANDLE;
+        }
+    }
+
+    void AllocationPolicy::record(const AllocationRequest& request, const AllocationDecision& decision, AllocationPlacement placement)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto& totals = stats_.placements[static_cast<size_t>(placement)];
+        totals.count++;
+        totals.bytes += request.size;
+        stats_.lifetimes[static_cast<size_t>(request.lifetime)]++;
+
+        if (decision.driverHinted)
+        {
+            stats_.driverHinted++;
+        }
+        if (decision.placement == AllocationPlacement::Pooled && placement != AllocationPlacement::Pooled)
+        {
+            stats_.poolFallbacks++;
+        }
+    }
+
+    AllocationPolicy::Config AllocationPolicy::config() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return config_;
+    }
+
+    void AllocationPolicy::setConfig(const Config& config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+    }
+
+    AllocationPolicy::Stats AllocationPolicy::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void AllocationPolicy::resetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = {};
+    }
+
+    MemoryRequirementsHint AllocationPolicy::queryImageRequirements(const DeviceManager& device, const VkImageCreateInfo& imageInfo)
+    {
+        MemoryRequirementsHint hint;
+
+        if (device.properties().apiVersion >= VK_API_VERSION_1_3)
+        {
+            VkDeviceImageMemoryRequirements info = {};
+            info.sType                           = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+            info.pCreateInfo                     = &imageInfo;
+
+            VkMemoryDedicatedRequirements dedicated = {};
+            dedicated.sType                         = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+            VkMemoryRequirements2 requirements = {};
+            requirements.sType                 = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+            requirements.pNext                 = &dedicated;
+
+            vkGetDeviceImageMemoryRequirements(device.device().handle(), &info, &requirements);
+
+            hint.size              = requirements.memoryRequirements.size;
+            hint.prefersDedicated  = dedicated.prefersDedicatedAllocation == VK_TRUE;
+            hint.requiresDedicated = dedicated.requiresDedicatedAllocation == VK_TRUE;
+            hint.exact             = true;
+            return hint;
+        }
+
+        // Rough estimate: 4 bytes per texel, a full mip chain adds a third
+        VkDeviceSize texels = static_cast<VkDeviceSize>(imageInfo.extent.width) * imageInfo.extent.height *
+                              std::max(imageInfo.extent.depth, 1u) * std::max(imageInfo.arrayLayers, 1u) *
+                              static_cast<VkDeviceSize>(imageInfo.samples);
+        hint.size = texels * 4;
+        if (imageInfo.mipLevels > 1)
+        {
+            hint.size += hint.size / 3;
+        }
+        return hint;
+    }
+
+    MemoryRequirementsHint AllocationPolicy::queryBufferRequirements(const DeviceManager& device, VkDeviceSize size, VkBufferUsageFlags usage)
+    {
+        MemoryRequirementsHint hint;
+        hint.size = size;
+
+        if (device.properties().apiVersion >= VK_API_VERSION_1_3)
+        {
+            VkBufferCreateInfo bufferInfo = {};
+            bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferInfo.size               = size;
+            bufferInfo.usage              = usage;
+            bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+
+            VkDeviceBufferMemoryRequirements info = {};
+            info.sType                            = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS;
+            info.pCreateInfo                      = &bufferInfo;
+
+            VkMemoryDedicatedRequirements dedicated = {};
+            dedicated.sType                         = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+            VkMemoryRequirements2 requirements = {};
+            requirements.sType                 = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+            requirements.pNext                 = &dedicated;
+
+            vkGetDeviceBufferMemoryRequirements(device.device().handle(), &info, &requirements);
+
+            hint.size              = requirements.memoryRequirements.size;
+            hint.prefersDedicated  = dedicated.prefersDedicatedAllocation == VK_TRUE;
+            hint.requiresDedicated = dedicated.requiresDedicatedAllocation == VK_TRUE;
+            hint.exact             = true;
+        }
+        return hint;
+    }
+} // namespace vulkan_engine::vulkan::memory
@@ -0,0 +1,376 @@
+#include "engine/rhi/vulkan/memory/AllocationTracker.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace vulkan_engine::vulkan::memory
+{
+    namespace
+    {
+        thread_local const AllocationTag* currentScope = nullptr;
+
+        void writeJsonString(std::ostringstream& out, const std::string& value)
+        {
+            out << '"';
+            for (char c : value)
+            {
+                switch (c)
+                {
+                    case '"': out << "\\\"";
+                        break;
+                    case '\\': out << "\\\\";
+                        break;
+                    case '\n': out << "\\n";
+                        break;
+                    case '\r': out << "\\r";
+                        break;
+                    case '\t': out << "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            out << ' ';
+                        }
+                        else
+                        {
+                            out << c;
+                        }
+                }
+            }
+            out << '"';
+        }
+
+        void writeRecord(std::ostringstream& out, const AllocationTracker::Record& record)
+        {
+            out << "{\"sequence\":" << record.sequence << ",\"frame\":" << record.frame << ",\"category\":\""
+                << toString(record.category) << "\",\"owner\":";
+            writeJsonString(out, record.owner);
+            out << ",\"size\":" << record.size << ",\"memoryType\":" << record.memoryTypeIndex << "}";
+        }
+
+        void writeRecords(std::ostringstream& out, const std::vector<AllocationTracker::Record>& records)
+        {
+            out << "[";
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                out << (i > 0 ? "," : "");
+                writeRecord(out, records[i]);
+            }
+            out << "]";
+        }
+    }
+
+    const char* toString(AllocationCategory category)
+    {
+        switch (category)
+        {
+            case AllocationCategory::Mesh: return "mesh";
+            case AllocationCategory::Texture: return "texture";
+            case AllocationCategory::RenderTarget: return "render_target";
+            case AllocationCategory::Uniform: return "uniform";
+            case AllocationCategory::Staging: return "staging";
+            case AllocationCategory::Storage: return "storage";
+            default: return "unknown";
+        }
+    }
+
+    AllocationCategory categorizeBuffer(VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+    {
+        if (usage == VK_BUFFER_USAGE_TRANSFER_SRC_BIT && (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+        {
+            return AllocationCategory::Staging;
+        }
+        if (usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT))
+        {
+            return AllocationCategory::Mesh;
+        }
+        if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+        {
+            return AllocationCategory::Uniform;
+        }
+        if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        {
+            return AllocationCategory::Storage;
+        }
+        return AllocationCategory::Unknown;
+    }
+
+    AllocationCategory categorizeImage(VkImageUsageFlags usage)
+    {
+        if (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT))
+        {
+            return AllocationCategory::RenderTarget;
+        }
+        return AllocationCategory::Texture;
+    }
+
+    // ============================================================================
+    // AllocationScope
+    // ============================================================================
+
+    AllocationScope::AllocationScope(AllocationCategory category, std::string owner)
+        : tag_{category, std::move(owner)}
+        , previous_(currentScope)
+    {
+        currentScope = &tag_;
+    }
+
+    AllocationScope::~AllocationScope()
+    {
+        currentScope = previous_;
+    }
+
+    const AllocationTag* AllocationScope::current()
+    {
+        return currentScope;
+    }
+
+    AllocationTag resolveBufferTag(VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+    {
+        AllocationCategory derived = categorizeBuffer(usage, properties);
+        if (const AllocationTag* scope = currentScope)
+        {
+            return {derived == AllocationCategory::Staging ? derived : scope->category, scope->owner};
+        }
+        return {derived, {}};
+    }
+
+    AllocationTag resolveImageTag(VkImageUsageFlags usage)
+    {
+        if (const AllocationTag* scope = currentScope)
+        {
+            return *scope;
+        }
+        return {categorizeImage(usage), {}};
+    }
+
+    // ============================================================================
+    // AllocationTracker
+    // ============================================================================
+
+    AllocationTracker::AllocationTracker(size_t eventCapacity)
+        : events_(std::max<size_t>(eventCapacity, 1))
+    {
+    }
+
+    void AllocationTracker::onAllocate(::VmaAllocator allocator, VmaAllocation allocation, const AllocationTag& tag, VkDeviceSize size, uint32_t memoryTypeIndex)
+    {
+        if (allocation == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        std::string name = std::string(toString(tag.category)) + (tag.owner.empty() ? "" : ":" + tag.owner);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Record record;
+        record.sequence        = nextSequence_++;
+        record.frame           = frame_.load(std::memory_order_relaxed);
+        record.category        = tag.category;
+        record.size            = size;
+        record.memoryTypeIndex = memoryTypeIndex;
+        record.owner           = tag.owner;
+
+        auto& totals = totals_[static_cast<size_t>(tag.category)];
+        ++totals.count;
+        totals.bytes += size;
+
+        pushEvent({record.sequence, record.frame, elapsedMs(), EventType::Allocate, record.category, size, memoryTypeIndex, record.owner});
+
+        // Records are node-stable, so the user data stays valid until onFree(). User data
+        // supplied through AllocationBuilder::userData() is left alone.
+        auto [it, inserted] = live_.insert_or_assign(allocation, std::move(record));
+
+        VmaAllocationInfo info = {};
+        vmaGetAllocationInfo(allocator, allocation, &info);
+        if (info.pUserData == nullptr)
+        {
+            vmaSetAllocationUserData(allocator, allocation, &it->second);
+        }
+        vmaSetAllocationName(allocator, allocation, name.c_str());
+    }
+
+    void AllocationTracker::onFree(VmaAllocation allocation)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = live_.find(allocation);
+        if (it == live_.end())
+        {
+            return; // Allocated before tracking was enabled, or by another allocator wrapper
+        }
+
+        const Record& record = it->second;
+        auto&         totals = totals_[static_cast<size_t>(record.category)];
+        --totals.count;
+        totals.bytes -= record.size;
+
+        pushEvent({record.sequence, frame_.load(std::memory_order_relaxed), elapsedMs(), EventType::Free, record.category, record.size,
+                   record.memoryTypeIndex, record.owner});
+        live_.erase(it);
+    }
+
+    AllocationTracker::Snapshot AllocationTracker::capture() const
+    {
+        Snapshot snapshot;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot.sequence   = nextSequence_ - 1;
+        snapshot.frame      = frame_.load(std::memory_order_relaxed);
+        snapshot.timeMs     = elapsedMs();
+        snapshot.categories = totals_;
+        snapshot.allocations.reserve(live_.size());
+        for (const auto& [allocation, record] : live_)
+        {
+            snapshot.allocations.push_back(record);
+        }
+
+        std::sort(snapshot.allocations.begin(), snapshot.allocations.end(), [](const Record& a, const Record& b)
+        {
+            return a.sequence < b.sequence;
+        });
+        return snapshot;
+    }
+
+    std::array<AllocationTracker::CategoryTotals, AllocationTracker::CATEGORY_COUNT> AllocationTracker::totals() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return totals_;
+    }
+
+    std::vector<AllocationTracker::Event> AllocationTracker::events(uint64_t sinceSequence) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const size_t capacity = events_.size();
+        const size_t count    = static_cast<size_t>(std::min<uint64_t>(eventCount_, capacity));
+        const size_t first    = (eventHead_ + capacity - count) % capacity;
+
+        std::vector<Event> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Event& event = events_[(first + i) % capacity];
+            if (event.sequence > sinceSequence)
+            {
+                result.push_back(event);
+            }
+        }
+        return result;
+    }
+
+    uint64_t AllocationTracker::droppedEvents() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return eventCount_ > events_.size() ? eventCount_ - events_.size() : 0;
+    }
+
+    AllocationTracker::SnapshotDiff AllocationTracker::diff(const Snapshot& before, const Snapshot& after)
+    {
+        SnapshotDiff result;
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+        {
+            result.categories[i].count = static_cast<int64_t>(after.categories[i].count) - static_cast<int64_t>(before.categories[i].count);
+            result.categories[i].bytes = static_cast<int64_t>(after.categories[i].bytes) - static_cast<int64_t>(before.categories[i].bytes);
+        }
+
+        // Both lists are sorted by sequence; sequences are never reused
+        size_t b = 0;
+        size_t a = 0;
+        while (b < before.allocations.size() || a < after.allocations.size())
+        {
+            if (a == after.allocations.size() || (b < before.allocations.size() && before.allocations[b].sequence < after.allocations[a].sequence))
+            {
+                result.freed.push_back(before.allocations[b++]);
+            }
+            else if (b == before.allocations.size() || after.allocations[a].sequence < before.allocations[b].sequence)
+            {
+                result.added.push_back(after.allocations[a++]);
+            }
+            else
+            {
+                ++a;
+                ++b;
+            }
+        }
+        return result;
+    }
+
+    std::string AllocationTracker::toJson(const Snapshot& snapshot)
+    {
+        std::ostringstream out;
+        out << "{\"sequence\":" << snapshot.sequence << ",\"frame\":" << snapshot.frame << ",\"timeMs\":" << snapshot.timeMs
+            << ",\"categories\":{";
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+        {
+            out << (i > 0 ? "," : "") << "\"" << toString(static_cast<AllocationCategory>(i)) << "\":{\"count\":"
+                << snapshot.categories[i].count << ",\"bytes\":" << snapshot.categories[i].bytes << "}";
+        }
+        out << "},\"allocations\":";
+        writeRecords(out, snapshot.allocations);
+        out << "}";
+        return out.str();
+    }
+
+    std::string AllocationTracker::toJson(const SnapshotDiff& diff)
+    {
+        std::ostringstream out;
+        out << "{\"categories\":{";
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+        {
+            out << (i > 0 ? "," : "") << "\"" << toString(static_cast<AllocationCategory>(i)) << "\":{\"count\":"
+                << diff.categories[i].count << ",\"bytes\":" << diff.categories[i].bytes << "}";
+        }
+        out << "},\"added\":";
+        writeRecords(out, diff.added);
+        out << ",\"freed\":";
+        writeRecords(out, diff.freed);
+        out << "}";
+        return out.str();
+    }
+
+    std::string AllocationTracker::timelineJson(uint64_t sinceSequence) const
+    {
+        auto list = events(sinceSequence);
+
+        std::ostringstream out;
+        out << "{\"dropped\":" << droppedEvents() << ",\"events\":[";
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+            const Event& event = list[i];
+            out << (i > 0 ? "," : "") << "{\"type\":\"" << (event.type == EventType::Allocate ? "alloc" : "free")
+                << "\",\"sequence\":" << event.sequence << ",\"frame\":" << event.frame << ",\"timeMs\":" << event.timeMs
+                << ",\"category\":\"" << toString(event.category) << "\",\"owner\":";
+            writeJsonString(out, event.owner);
+            out << ",\"size\":" << event.size << ",\"memoryType\":" << event.memoryTypeIndex << "}";
+        }
+        out << "]}";
+        return out.str();
+    }
+
+    bool AllocationTracker::writeFile(const std::string& path, const std::string& json)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            LOG_WARN("AllocationTracker: cannot write " << path);
+            return false;
+        }
+        file << json;
+        return file.good();
+    }
+
+    double AllocationTracker::elapsedMs() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    void AllocationTracker::pushEvent(Event event)
+    {
+        events_[eventHead_] = std::move(event);
+        eventHead_          = (eventHead_ + 1) % events_.size();
+        ++eventCount_;
+    }
+} // namespace vulkan_engine::vulkan::memory
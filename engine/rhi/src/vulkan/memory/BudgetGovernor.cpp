@@ -0,0 +1,351 @@
+#include "engine/rhi/vulkan/memory/BudgetGovernor.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace vulkan_engine::vulkan::memory
+{
+    BudgetGovernor::BudgetGovernor(ResourceManagerPtr resourceManager, const Config& config)
+        : resourceManager_(std::move(resourceManager))
+        , config_(config)
+    {
+        if (!resourceManager_)
+        {
+            throw std::runtime_error("BudgetGovernor: resourceManager is null");
+        }
+        refreshHeapUsage();
+    }
+
+    BudgetGovernor::Handle BudgetGovernor::registerResource(ResourceDesc desc)
+    {
+        const auto& memoryProperties = resourceManager_->device()->memory_properties();
+        if (desc.memoryTypeIndex >= memoryProperties.memoryTypeCount)
+        {
+            throw std::runtime_error("BudgetGovernor: invalid memory type index for " + desc.name);
+        }
+
+        Entry entry;
+        entry.heapIndex     = memoryProperties.memoryTypes[desc.memoryTypeIndex].heapIndex;
+        entry.residentSize  = desc.size;
+        entry.lastUsedFrame = currentFrame_;
+        entry.desc          = std::move(desc);
+
+        Handle handle = nextHandle_++;
+        entries_.emplace(handle, std::move(entry));
+        return handle;
+    }
+
+    void BudgetGovernor::unregisterResource(Handle handle)
+    {
+        entries_.erase(handle);
+    }
+
+    void BudgetGovernor::setCallbacks(Handle handle, Callbacks callbacks)
+    {
+        auto it = entries_.find(handle);
+        if (it != entries_.end())
+        {
+            it->second.desc.callbacks = std::move(callbacks);
+        }
+    }
+
+    bool BudgetGovernor::touch(Handle handle, float screenCoverage)
+    {
+        auto it = entries_.find(handle);
+        if (it == entries_.end())
+        {
+            return false;
+        }
+
+        Entry& entry   = it->second;
+        screenCoverage = std::clamp(screenCoverage, 0.0f, 1.0f);
+        if (entry.lastUsedFrame != currentFrame_)
+        {
+            entry.lastUsedFrame  = currentFrame_;
+            entry.screenCoverage = screenCoverage;
+        }
+        else
+        {
+            entry.screenCoverage = std::max(entry.screenCoverage, screenCoverage);
+        }
+
+        if (entry.state == ResidencyState::Evicted)
+        {
+            entry.reloadPending = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool BudgetGovernor::ensureResident(Handle handle)
+    {
+        auto it = entries_.find(handle);
+        if (it == entries_.end())
+        {
+            return false;
+        }
+
+        Entry& entry = it->second;
+        if (entry.state != ResidencyState::Evicted)
+        {
+            return true;
+        }
+        entry.lastUsedFrame = currentFrame_;
+        return reload(entry);
+    }
+
+    void BudgetGovernor::update(uint64_t frameNumber)
+    {
+        currentFrame_     = frameNumber;
+        actionsThisFrame_ = 0;
+        refreshHeapUsage();
+
+        // Make room for the reloads first, so they do not push the heap straight back over
+        std::vector<VkDeviceSize> pendingBytes(heaps_.size(), 0);
+        for (const auto& [handle, entry] : entries_)
+        {
+            if (entry.reloadPending && entry.heapIndex < pendingBytes.size())
+            {
+                pendingBytes[entry.heapIndex] += entry.desc.size;
+            }
+        }
+
+        for (uint32_t heap = 0; heap < heaps_.size(); ++heap)
+        {
+            const HeapUsage& usage = heaps_[heap];
+            if (usage.budget == 0)
+            {
+                continue;
+            }
+
+            const double projected = static_cast<double>(usage.usage + pendingBytes[heap]);
+            const double budget    = static_cast<double>(usage.budget);
+            if (projected <= config_.demoteThreshold * budget)
+            {
+                continue;
+            }
+
+            const double target = config_.targetUsage * budget;
+            relieveHeap(heap, static_cast<VkDeviceSize>(projected - std::min(projected, target)), projected >= config_.evictThreshold * budget);
+        }
+
+        processReloads();
+        restoreDemoted();
+    }
+
+    BudgetGovernor::ResidencyState BudgetGovernor::state(Handle handle) const
+    {
+        auto it = entries_.find(handle);
+        return it != entries_.end() ? it->second.state : ResidencyState::Evicted;
+    }
+
+    BudgetGovernor::Stats BudgetGovernor::stats() const
+    {
+        Stats stats = totals_;
+        stats.heaps = heaps_;
+        for (const auto& [handle, entry] : entries_)
+        {
+            if (entry.state == ResidencyState::Resident)
+            {
+                ++stats.resident;
+            }
+            else if (entry.state == ResidencyState::Demoted)
+            {
+                ++stats.demoted;
+            }
+            else
+            {
+                ++stats.evicted;
+            }
+        }
+        return stats;
+    }
+
+    float BudgetGovernor::priority(float screenCoverage, uint64_t idleFrames)
+    {
+        // A small floor keeps recency meaningful for resources that report no coverage
+        return (0.05f + std::clamp(screenCoverage, 0.0f, 1.0f)) * std::exp2(-static_cast<float>(idleFrames) / 60.0f);
+    }
+
+    uint64_t BudgetGovernor::idleFrames(const Entry& entry) const
+    {
+        return currentFrame_ > entry.lastUsedFrame ? currentFrame_ - entry.lastUsedFrame : 0;
+    }
+
+    float BudgetGovernor::entryPriority(const Entry& entry) const
+    {
+        return priority(entry.screenCoverage, idleFrames(entry));
+    }
+
+    void BudgetGovernor::refreshHeapUsage()
+    {
+        auto budgets = resourceManager_->getHeapBudgets();
+
+        heaps_.assign(budgets.size(), {});
+        for (size_t i = 0; i < budgets.size(); ++i)
+        {
+            // Free space inside our own blocks is reusable without growing the heap, and
+            // releasing a pooled resource only returns its range to the block
+            const VkDeviceSize slack = budgets[i].statistics.blockBytes - budgets[i].statistics.allocationBytes;
+            heaps_[i].usage          = budgets[i].usage > slack ? budgets[i].usage - slack : 0;
+            heaps_[i].budget         = budgets[i].budget;
+        }
+    }
+
+    void BudgetGovernor::relieveHeap(uint32_t heapIndex, VkDeviceSize bytesToFree, bool critical)
+    {
+        std::vector<Entry*> candidates;
+        for (auto& [handle, entry] : entries_)
+        {
+            if (entry.heapIndex == heapIndex && entry.state != ResidencyState::Evicted && !entry.reloadPending &&
+                idleFrames(entry) >= config_.minIdleFrames)
+            {
+                candidates.push_back(&entry);
+            }
+        }
+
+        // Coldest first
+        std::sort(candidates.begin(), candidates.end(), [this](const Entry* a, const Entry* b)
+        {
+            return entryPriority(*a) < entryPriority(*b);
+        });
+
+        VkDeviceSize freed     = 0;
+        uint32_t     demotions = 0;
+        uint32_t     evictions = 0;
+        for (Entry* entry : candidates)
+        {
+            if (freed >= bytesToFree || actionsThisFrame_ >= config_.maxActionsPerFrame)
+            {
+                break;
+            }
+
+            // Below the eviction threshold, losing a mip is preferred over losing the resource
+            if (!critical && entry->desc.callbacks.demote)
+            {
+                VkDeviceSize newSize = entry->desc.callbacks.demote();
+                if (newSize < entry->residentSize)
+                {
+                    freed += entry->residentSize - newSize;
+                    totals_.bytesReleased += entry->residentSize - newSize;
+                    entry->residentSize = newSize;
+                    entry->state        = ResidencyState::Demoted;
+                    ++entry->demotedLevels;
+                    ++totals_.demotions;
+                    ++demotions;
+                    ++actionsThisFrame_;
+                    continue;
+                }
+            }
+
+            if ((critical || idleFrames(*entry) >= config_.evictIdleFrames) && entry->desc.callbacks.evict)
+            {
+                entry->desc.callbacks.evict();
+                freed += entry->residentSize;
+                totals_.bytesReleased += entry->residentSize;
+                entry->residentSize = 0;
+                entry->state        = ResidencyState::Evicted;
+                ++totals_.evictions;
+                ++evictions;
+                ++actionsThisFrame_;
+            }
+        }
+
+        if (demotions > 0 || evictions > 0)
+        {
+            const HeapUsage& usage = heaps_[heapIndex];
+            LOG_INFO("BudgetGovernor: heap " << heapIndex << " at " << static_cast<int>(usage.ratio() * 100.0f)
+                << "% of budget, demoted " << demotions << " and evicted " << evictions << " resources ("
+                << freed / (1024 * 1024) << " MB)");
+        }
+        else if (critical && freed < bytesToFree)
+        {
+            LOG_WARN("BudgetGovernor: heap " << heapIndex << " is over its eviction threshold but nothing cold enough to release");
+        }
+    }
+
+    void BudgetGovernor::processReloads()
+    {
+        std::vector<Entry*> pending;
+        for (auto& [handle, entry] : entries_)
+        {
+            if (entry.reloadPending)
+            {
+                pending.push_back(&entry);
+            }
+        }
+
+        // Hottest first
+        std::sort(pending.begin(), pending.end(), [this](const Entry* a, const Entry* b)
+        {
+            return entryPriority(*a) > entryPriority(*b);
+        });
+
+        uint32_t reloads = 0;
+        for (Entry* entry : pending)
+        {
+            if (reloads++ >= config_.maxReloadsPerFrame)
+            {
+                break;
+            }
+            reload(*entry);
+        }
+    }
+
+    void BudgetGovernor::restoreDemoted()
+    {
+        std::vector<Entry*> demoted;
+        for (auto& [handle, entry] : entries_)
+        {
+            if (entry.state == ResidencyState::Demoted && idleFrames(entry) < config_.minIdleFrames)
+            {
+                demoted.push_back(&entry);
+            }
+        }
+
+        std::sort(demoted.begin(), demoted.end(), [this](const Entry* a, const Entry* b)
+        {
+            return entryPriority(*a) > entryPriority(*b);
+        });
+
+        uint32_t restores = 0;
+        for (Entry* entry : demoted)
+        {
+            if (restores >= config_.maxReloadsPerFrame)
+            {
+                break;
+            }
+
+            HeapUsage&   usage  = heaps_[entry->heapIndex];
+            VkDeviceSize growth = entry->desc.size - entry->residentSize;
+            if (usage.budget == 0 || static_cast<double>(usage.usage + growth) > config_.restoreThreshold * static_cast<double>(usage.budget))
+            {
+                continue;
+            }
+
+            if (reload(*entry))
+            {
+                usage.usage += growth;
+                ++restores;
+            }
+        }
+    }
+
+    bool BudgetGovernor::reload(Entry& entry)
+    {
+        entry.reloadPending = false;
+        if (!entry.desc.callbacks.reload || !entry.desc.callbacks.reload())
+        {
+            ++totals_.failedReloads;
+            LOG_WARN("BudgetGovernor: failed to reload " << entry.desc.name);
+            return false;
+        }
+
+        entry.state         = ResidencyState::Resident;
+        entry.residentSize  = entry.desc.size;
+        entry.demotedLevels = 0;
+        ++totals_.reloads;
+        return true;
+    }
+} // namespace vulkan_engine::vulkan::memory
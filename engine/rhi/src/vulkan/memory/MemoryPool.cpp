@@ -1,5 +1,6 @@
 #include "engine/rhi/vulkan/memory/MemoryPool.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include <algorithm>
 #include <sstream>
 
 namespace vulkan_engine::vulkan::memory
@@ -51,6 +52,7 @@ namespace vulkan_engine::vulkan::memory
         {
             throw VulkanError(result, "Failed to create VMA memory pool: " + name_, __FILE__, __LINE__);
         }
+        memoryTypeIndex_ = memoryTypeIndex;
 
         std::ostringstream oss;
         oss << "MemoryPool created: name=" << name_ << ", memoryTypeIndex=" << memoryTypeIndex;
@@ -65,6 +67,7 @@ namespace vulkan_engine::vulkan::memory
     MemoryPool::MemoryPool(MemoryPool&& other) noexcept
         : allocator_(std::move(other.allocator_))
         , pool_(other.pool_)
+        , memoryTypeIndex_(other.memoryTypeIndex_)
         , name_(std::move(other.name_))
     {
         other.pool_ = VK_NULL_HANDLE;
@@ -75,10 +78,11 @@ namespace vulkan_engine::vulkan::memory
         if (this != &other)
         {
             cleanup();
-            allocator_  = std::move(other.allocator_);
-            pool_       = other.pool_;
-            name_       = std::move(other.name_);
-            other.pool_ = VK_NULL_HANDLE;
+            allocator_       = std::move(other.allocator_);
+            pool_            = other.pool_;
+            memoryTypeIndex_ = other.memoryTypeIndex_;
+            name_            = std::move(other.name_);
+            other.pool_      = VK_NULL_HANDLE;
         }
         return *this;
     }
@@ -99,15 +103,16 @@ namespace vulkan_engine::vulkan::memory
     MemoryPool::Stats MemoryPool::getStats() const
     {
         Stats stats = {};
-        if (pool_ != VK_NULL_HANDLE)
+        if (pool_ != VK_NULL_HANDLE && allocator_)
         {
-            // VMA 3.3.0 API: Use vmaGetPoolStatistics if available, otherwise return zeros
-            // Note: vmaGetPoolStatistics is not available in all VMA versions
-            // Fallback to basic estimation
-            stats.size            = 0;
-            stats.usedSize        = 0;
-            stats.allocationCount = 0;
-            stats.blockCount      = 0;
+            // Cheap O(1) counters kept by VMA; safe to call every frame
+            VmaStatistics vmaStats = {};
+            vmaGetPoolStatistics(allocator_->handle(), pool_, &vmaStats);
+
+            stats.size            = vmaStats.blockBytes;
+            stats.usedSize        = vmaStats.allocationBytes;
+            stats.allocationCount = vmaStats.allocationCount;
+            stats.blockCount      = vmaStats.blockCount;
         }
         return stats;
     }
@@ -241,22 +246,37 @@ namespace vulkan_engine::vulkan::memory
         return std::make_shared < MemoryPool > (allocator_, createInfo);
     }
 
-    void MemoryPoolManager::printStats() const
+    std::vector<std::pair<PoolType, MemoryPool::Stats>> MemoryPoolManager::collectStats() const
     {
-        LOG_INFO("=== Memory Pool Statistics ===");
+        std::vector<std::pair<PoolType, MemoryPool::Stats>> result;
+        result.reserve(pools_.size());
         for (const auto& [type, pool] : pools_)
         {
             if (pool && pool->isValid())
             {
-                auto               stats = pool->getStats();
-                std::ostringstream oss;
-                oss << "  " << poolTypeToString(type) << ": "
-                        << stats.usedSize / (1024.0 * 1024.0) << " MB / "
-                        << stats.size / (1024.0 * 1024.0) << " MB, allocations="
-                        << stats.allocationCount << ", blocks=" << stats.blockCount;
-                LOG_INFO(oss.str());
+                result.emplace_back(type, pool->getStats());
             }
         }
+
+        std::sort(result.begin(), result.end(), [](const auto& a, const auto& b)
+        {
+            return a.first < b.first;
+        });
+        return result;
+    }
+
+    void MemoryPoolManager::printStats() const
+    {
+        LOG_INFO("=== Memory Pool Statistics ===");
+        for (const auto& [type, stats] : collectStats())
+        {
+            std::ostringstream oss;
+            oss << "  " << poolTypeToString(type) << ": "
+                    << stats.usedSize / (1024.0 * 1024.0) << " MB / "
+                    << stats.size / (1024.0 * 1024.0) << " MB, allocations="
+                    << stats.allocationCount << ", blocks=" << stats.blockCount;
+            LOG_INFO(oss.str());
+        }
     }
 
     const char* MemoryPoolManager::poolTypeToString(PoolType type)
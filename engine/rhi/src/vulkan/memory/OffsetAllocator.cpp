@@ -0,0 +1,394 @@
+// Based on OffsetAllocator by Sebastian Aaltonen
+// https://github.com/sebbbi/OffsetAllocator
+//
+// MIT License
+//
+// Copyright (c) 2023 Sebastian Aaltonen
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "engine/rhi/vulkan/memory/OffsetAllocator.hpp"
+#include <bit>
+#include <cassert>
+#include <stdexcept>
+
+namespace vulkan_engine::vulkan::memory
+{
+    namespace
+    {
+        // Sizes are binned as small floats: 3 mantissa bits and a 5-bit exponent,
+        // which bounds the wasted space of a bin to 1/8 of the request
+        constexpr uint32_t MANTISSA_BITS  = 3;
+        constexpr uint32_t MANTISSA_VALUE = 1u << MANTISSA_BITS;
+        constexpr uint32_t MANTISSA_MASK  = MANTISSA_VALUE - 1;
+
+        // Bin whose every range is at least `size` (used for allocation)
+        uint32_t sizeToBinRoundUp(uint32_t size)
+        {
+            uint32_t exponent = 0;
+            uint32_t mantissa = 0;
+
+            if (size < MANTISSA_VALUE)
+            {
+                mantissa = size; // Denormal: 0..7
+            }
+            else
+            {
+                uint32_t highestSetBit    = 31 - static_cast<uint32_t>(std::countl_zero(size));
+                uint32_t mantissaStartBit = highestSetBit - MANTISSA_BITS;
+                exponent                  = mantissaStartBit + 1;
+                mantissa                  = (size >> mantissaStartBit) & MANTISSA_MASK;
+
+                uint32_t lowBitsMask = (1u << mantissaStartBit) - 1;
+                if ((size & lowBitsMask) != 0)
+                {
+                    mantissa++;
+                }
+            }
+
+            // Addition, not or: a mantissa overflow carries into the exponent
+            return (exponent << MANTISSA_BITS) + mantissa;
+        }
+
+        // Bin a free range of `size` is stored in
+        uint32_t sizeToBinRoundDown(uint32_t size)
+        {
+            uint32_t exponent = 0;
+            uint32_t mantissa = 0;
+
+            if (size < MANTISSA_VALUE)
+            {
+                mantissa = size;
+            }
+            else
+            {
+                uint32_t highestSetBit    = 31 - static_cast<uint32_t>(std::countl_zero(size));
+                uint32_t mantissaStartBit = highestSetBit - MANTISSA_BITS;
+                exponent                  = mantissaStartBit + 1;
+                mantissa                  = (size >> mantissaStartBit) & MANTISSA_MASK;
+            }
+
+            return (exponent << MANTISSA_BITS) | mantissa;
+        }
+
+        // Smallest size stored in a bin
+        uint32_t binToSize(uint32_t bin)
+        {
+            uint32_t exponent = bin >> MANTISSA_BITS;
+            uint32_t mantissa = bin & MANTISSA_MASK;
+            if (exponent == 0)
+            {
+                return mantissa;
+            }
+            return (mantissa | MANTISSA_VALUE) << (exponent - 1);
+        }
+
+        uint32_t findLowestSetBitAfter(uint32_t mask, uint32_t startBit)
+        {
+            if (startBit >= 32)
+            {
+                return OffsetAllocator::NO_SPACE;
+            }
+            uint32_t maskAfterStart = mask & ~((1u << startBit) - 1);
+            if (maskAfterStart == 0)
+            {
+                return OffsetAllocator::NO_SPACE;
+            }
+            return static_cast<uint32_t>(std::countr_zero(maskAfterStart));
+        }
+    } // namespace
+
+    OffsetAllocator::OffsetAllocator(uint32_t capacity, uint32_t maxAllocations)
+        : capacity_(capacity)
+        , maxAllocations_(maxAllocations)
+    {
+        if (maxAllocations_ == 0)
+        {
+            throw std::invalid_argument("OffsetAllocator: maxAllocations must be non-zero");
+        }
+        reset();
+    }
+
+    void OffsetAllocator::reset()
+    {
+        freeStorage_     = 0;
+        allocationCount_ = 0;
+        usedBinsTop_     = 0;
+        for (uint8_t& bins : usedBins_)
+        {
+            bins = 0;
+        }
+        for (uint32_t& head : binIndices_)
+        {
+            head = UNUSED;
+        }
+
+        // Free ranges are always merged, so there is at most one between two
+        // allocations: maxAllocations + 1 of them at worst
+        const uint32_t nodeCount = maxAllocations_ * 2 + 1;
+        nodes_.assign(nodeCount, Node{});
+        freeNodes_.resize(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i)
+        {
+            // Popped from the back, so lower indices are handed out first
+            freeNodes_[i] = nodeCount - 1 - i;
+        }
+
+        if (capacity_ > 0)
+        {
+            insertNodeIntoBin(capacity_, 0);
+        }
+    }
+
+    OffsetAllocator::Range OffsetAllocator::allocate(uint32_t size)
+    {
+        if (size == 0 || allocationCount_ >= maxAllocations_)
+        {
+            return {};
+        }
+
+        uint32_t minBinIndex = sizeToBinRoundUp(size);
+        uint32_t minTopBin   = minBinIndex >> TOP_BINS_INDEX_SHIFT;
+        uint32_t minLeafBin  = minBinIndex & LEAF_BINS_INDEX_MASK;
+
+        uint32_t topBin  = minTopBin;
+        uint32_t leafBin = NO_SPACE;
+
+        // Same top bin: only leaves at or above the rounded-up size fit
+        if (usedBinsTop_ & (1u << topBin))
+        {
+            leafBin = findLowestSetBitAfter(usedBins_[topBin], minLeafBin);
+        }
+
+        // Otherwise any leaf of the next non-empty top bin fits
+        if (leafBin == NO_SPACE)
+        {
+            topBin = findLowestSetBitAfter(usedBinsTop_, minTopBin + 1);
+            if (topBin == NO_SPACE)
+            {
+                return {};
+            }
+            leafBin = static_cast<uint32_t>(std::countr_zero(static_cast<uint32_t>(usedBins_[topBin])));
+        }
+
+        uint32_t binIndex  = (topBin << TOP_BINS_INDEX_SHIFT) | leafBin;
+        uint32_t nodeIndex = binIndices_[binIndex];
+        Node&    node      = nodes_[nodeIndex];
+
+        uint32_t nodeTotalSize = node.dataSize;
+        node.dataSize          = size;
+        node.used              = true;
+
+        // Pop the head of the bin's list
+        binIndices_[binIndex] = node.binListNext;
+        if (node.binListNext != UNUSED)
+        {
+            nodes_[node.binListNext].binListPrev = UNUSED;
+        }
+        freeStorage_ -= nodeTotalSize;
+
+        if (binIndices_[binIndex] == UNUSED)
+        {
+            usedBins_[topBin] &= static_cast<uint8_t>(~(1u << leafBin));
+            if (usedBins_[topBin] == 0)
+            {
+                usedBinsTop_ &= ~(1u << topBin);
+            }
+        }
+
+        // Return the tail to the bins as a new free neighbour
+        uint32_t remainder = nodeTotalSize - size;
+        if (remainder > 0)
+        {
+            uint32_t newNodeIndex = insertNodeIntoBin(remainder, node.dataOffset + size);
+
+            Node& current = nodes_[nodeIndex];
+            if (current.neighborNext != UNUSED)
+            {
+                nodes_[current.neighborNext].neighborPrev = newNodeIndex;
+            }
+            nodes_[newNodeIndex].neighborPrev = nodeIndex;
+            nodes_[newNodeIndex].neighborNext = current.neighborNext;
+            current.neighborNext              = newNodeIndex;
+        }
+
+        allocationCount_++;
+        return {nodes_[nodeIndex].dataOffset, nodeIndex};
+    }
+
+    void OffsetAllocator::free(Range range)
+    {
+        if (!range.isValid() || range.metadata >= nodes_.size())
+        {
+            return;
+        }
+
+        uint32_t nodeIndex = range.metadata;
+        Node&    node      = nodes_[nodeIndex];
+        assert(node.used && "OffsetAllocator: double free");
+        if (!node.used)
+        {
+            return;
+        }
+
+        uint32_t offset = node.dataOffset;
+        uint32_t size   = node.dataSize;
+
+        // Merge with the free neighbour before...
+        if (node.neighborPrev != UNUSED && !nodes_[node.neighborPrev].used)
+        {
+            Node& prev = nodes_[node.neighborPrev];
+            offset     = prev.dataOffset;
+            size += prev.dataSize;
+
+            uint32_t prevIndex = node.neighborPrev;
+            node.neighborPrev  = prev.neighborPrev;
+            removeNodeFromBin(prevIndex);
+        }
+
+        // ...and after it
+        if (node.neighborNext != UNUSED && !nodes_[node.neighborNext].used)
+        {
+            Node& next = nodes_[node.neighborNext];
+            size += next.dataSize;
+
+            uint32_t nextIndex = node.neighborNext;
+            node.neighborNext  = next.neighborNext;
+            removeNodeFromBin(nextIndex);
+        }
+
+        uint32_t neighborPrev = node.neighborPrev;
+        uint32_t neighborNext = node.neighborNext;
+
+        node = Node{};
+        freeNodes_.push_back(nodeIndex);
+        allocationCount_--;
+
+        uint32_t combinedIndex = insertNodeIntoBin(size, offset);
+        if (neighborNext != UNUSED)
+        {
+            nodes_[combinedIndex].neighborNext = neighborNext;
+            nodes_[neighborNext].neighborPrev  = combinedIndex;
+        }
+        if (neighborPrev != UNUSED)
+        {
+            nodes_[combinedIndex].neighborPrev = neighborPrev;
+            nodes_[neighborPrev].neighborNext  = combinedIndex;
+        }
+    }
+
+    uint32_t OffsetAllocator::rangeSize(Range range) const
+    {
+        if (!range.isValid() || range.metadata >= nodes_.size())
+        {
+            return 0;
+        }
+        return nodes_[range.metadata].dataSize;
+    }
+
+    OffsetAllocator::StorageReport OffsetAllocator::storageReport() const
+    {
+        StorageReport report;
+        if (allocationCount_ >= maxAllocations_)
+        {
+            return report; // Nothing more can be allocated
+        }
+
+        report.totalFree = freeStorage_;
+        if (usedBinsTop_ != 0)
+        {
+            uint32_t topBin   = 31 - static_cast<uint32_t>(std::countl_zero(usedBinsTop_));
+            uint32_t leafBin  = 31 - static_cast<uint32_t>(std::countl_zero(static_cast<uint32_t>(usedBins_[topBin])));
+            report.largestFree = binToSize((topBin << TOP_BINS_INDEX_SHIFT) | leafBin);
+        }
+        return report;
+    }
+
+    uint32_t OffsetAllocator::insertNodeIntoBin(uint32_t size, uint32_t dataOffset)
+    {
+        uint32_t binIndex = sizeToBinRoundDown(size);
+        uint32_t topBin   = binIndex >> TOP_BINS_INDEX_SHIFT;
+        uint32_t leafBin  = binIndex & LEAF_BINS_INDEX_MASK;
+
+        if (binIndices_[binIndex] == UNUSED)
+        {
+            usedBins_[topBin] |= static_cast<uint8_t>(1u << leafBin);
+            usedBinsTop_ |= 1u << topBin;
+        }
+
+        uint32_t topNodeIndex = binIndices_[binIndex];
+        uint32_t nodeIndex    = freeNodes_.back();
+        freeNodes_.pop_back();
+
+        Node& node       = nodes_[nodeIndex];
+        node             = Node{};
+        node.dataOffset  = dataOffset;
+        node.dataSize    = size;
+        node.binListNext = topNodeIndex;
+        if (topNodeIndex != UNUSED)
+        {
+            nodes_[topNodeIndex].binListPrev = nodeIndex;
+        }
+        binIndices_[binIndex] = nodeIndex;
+
+        freeStorage_ += size;
+        return nodeIndex;
+    }
+
+    void OffsetAllocator::removeNodeFromBin(uint32_t nodeIndex)
+    {
+        Node& node = nodes_[nodeIndex];
+
+        if (node.binListPrev != UNUSED)
+        {
+            // Middle or tail of the list
+            nodes_[node.binListPrev].binListNext = node.binListNext;
+            if (node.binListNext != UNUSED)
+            {
+                nodes_[node.binListNext].binListPrev = node.binListPrev;
+            }
+        }
+        else
+        {
+            // Head of the list
+            uint32_t binIndex = sizeToBinRoundDown(node.dataSize);
+            uint32_t topBin   = binIndex >> TOP_BINS_INDEX_SHIFT;
+            uint32_t leafBin  = binIndex & LEAF_BINS_INDEX_MASK;
+
+            binIndices_[binIndex] = node.binListNext;
+            if (node.binListNext != UNUSED)
+            {
+                nodes_[node.binListNext].binListPrev = UNUSED;
+            }
+
+            if (binIndices_[binIndex] == UNUSED)
+            {
+                usedBins_[topBin] &= static_cast<uint8_t>(~(1u << leafBin));
+                if (usedBins_[topBin] == 0)
+                {
+                    usedBinsTop_ &= ~(1u << topBin);
+                }
+            }
+        }
+
+        freeStorage_ -= node.dataSize;
+        node = Node{};
+        freeNodes_.push_back(nodeIndex);
+    }
+} // namespace vulkan_engine::vulkan::memory
@@ -0,0 +1,373 @@
+#include "engine/rhi/vulkan/memory/ReadbackQueue.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/utils/VulkanError.hpp"
+#include "engine/core/utils/Logger.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace vulkan_engine::vulkan::memory
+{
+    ReadbackQueue::ReadbackQueue(std::shared_ptr<ResourceManager> resourceManager, const Config& config)
+        : resourceManager_(std::move(resourceManager))
+        , config_(config)
+    {
+        if (!resourceManager_)
+        {
+            throw std::invalid_argument("ReadbackQueue requires a ResourceManager");
+        }
+        if (config_.framesInFlight == 0)
+        {
+            throw std::invalid_argument("ReadbackQueue: framesInFlight must be non-zero");
+        }
+        pending_.resize(config_.framesInFlight);
+    }
+
+    ReadbackQueue::~ReadbackQueue()
+    {
+        cancelPending();
+        for (auto& pooled : buffers_)
+        {
+            resourceManager_->destroyBuffer(std::move(pooled.buffer));
+        }
+    }
+
+    ReadbackTicketPtr ReadbackQueue::requestBuffer(
+        VkCommandBuffer          cmd,
+        VkBuffer                 source,
+        VkDeviceSize             offset,
+        VkDeviceSize             size,
+        ReadbackTicket::Callback onReady)
+    {
+        auto ticket = std::make_shared<ReadbackTicket>(std::move(onReady));
+        recordBuffer(cmd, source, offset, size, ticket);
+        return ticket;
+    }
+
+    ReadbackTicketPtr ReadbackQueue::requestImage(VkCommandBuffer cmd, const ImageRegion& region, ReadbackTicket::Callback onReady)
+    {
+        auto ticket = std::make_shared<ReadbackTicket>(std::move(onReady));
+        recordImage(cmd, region, ticket);
+        return ticket;
+    }
+
+    bool ReadbackQueue::recordBuffer(VkCommandBuffer cmd, VkBuffer source, VkDeviceSize offset, VkDeviceSize size, const ReadbackTicketPtr& ticket)
+    {
+        if (!ticket)
+        {
+            return false;
+        }
+        if (cmd == VK_NULL_HANDLE || source == VK_NULL_HANDLE || size == 0)
+        {
+            cancel(ticket);
+            return false;
+        }
+
+        VmaBufferPtr target = acquireBuffer(size, ticket);
+        if (!target)
+        {
+            cancel(ticket);
+            return false;
+        }
+
+        // Whatever wrote the source earlier in this command buffer must finish first
+        VkMemoryBarrier before = {};
+        before.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        before.srcAccessMask   = VK_ACCESS_MEMORY_WRITE_BIT;
+        before.dstAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &before, 0, nullptr, 0, nullptr);
+
+        VkBufferCopy copy = {};
+        copy.srcOffset    = offset;
+        copy.dstOffset    = 0;
+        copy.size         = size;
+        vkCmdCopyBuffer(cmd, source, target->handle(), 1, &copy);
+
+        // Make the copy visible to host reads once the frame's fence has signaled
+        VkBufferMemoryBarrier after = {};
+        after.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        after.srcAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
+        after.dstAccessMask         = VK_ACCESS_HOST_READ_BIT;
+        after.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+        after.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+        after.buffer                = target->handle();
+        after.offset                = 0;
+        after.size                  = size;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &after, 0, nullptr);
+
+        pending_[frameIndex_].push_back({ticket, std::move(target), size});
+        return true;
+    }
+
+    bool ReadbackQueue::recordImage(VkCommandBuffer cmd, const ImageRegion& region, const ReadbackTicketPtr& ticket)
+    {
+        if (!ticket)
+        {
+            return false;
+        }
+
+        VkExtent2D extent = region.extent;
+        if (extent.width == 0 || extent.height == 0)
+        {
+            extent.width  = region.imageSize.width > static_cast<uint32_t>(region.offset.x) ? region.imageSize.width - region.offset.x : 0;
+            extent.height = region.imageSize.height > static_cast<uint32_t>(region.offset.y) ? region.imageSize.height - region.offset.y : 0;
+        }
+
+        const uint32_t texel = texelSize(region.format, region.aspect);
+        if (cmd == VK_NULL_HANDLE || region.image == VK_NULL_HANDLE || texel == 0 || extent.width == 0 || extent.height == 0)
+        {
+            if (texel == 0)
+            {
+                logger::warn("ReadbackQueue: unsupported format ", static_cast<int>(region.format));
+            }
+            cancel(ticket);
+            return false;
+        }
+
+        const VkDeviceSize size   = static_cast<VkDeviceSize>(extent.width) * extent.height * texel;
+        VmaBufferPtr       target = acquireBuffer(size, ticket);
+        if (!target)
+        {
+            cancel(ticket);
+            return false;
+        }
+
+        ticket->format_    = region.format;
+        ticket->extent_    = extent;
+        ticket->texelSize_ = texel;
+
+        VkImageSubresourceRange range = {};
+        range.aspectMask              = region.aspect;
+        range.baseMipLevel            = region.mipLevel;
+        range.levelCount              = 1;
+        range.baseArrayLayer          = region.arrayLayer;
+        range.layerCount              = 1;
+
+        const bool needsTransition = region.layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        if (needsTransition)
+        {
+            VkImageMemoryBarrier toTransfer = {};
+            toTransfer.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            toTransfer.srcAccessMask        = VK_ACCESS_MEMORY_WRITE_BIT;
+            toTransfer.dstAccessMask        = VK_ACCESS_TRANSFER_READ_BIT;
+            toTransfer.oldLayout            = region.layout;
+            toTransfer.newLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            toTransfer.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.image                = region.image;
+            toTransfer.subresourceRange     = range;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+        }
+
+        VkBufferImageCopy copy               = {};
+        copy.bufferOffset                    = 0;
+        copy.bufferRowLength                 = 0; // Tightly packed
+        copy.bufferImageHeight               = 0;
+        copy.imageSubresource.aspectMask     = region.aspect;
+        copy.imageSubresource.mipLevel       = region.mipLevel;
+        copy.imageSubresource.baseArrayLayer = region.arrayLayer;
+        copy.imageSubresource.layerCount     = 1;
+        copy.imageOffset                     = {region.offset.x, region.offset.y, 0};
+        copy.imageExtent                     = {extent.width, extent.height, 1};
+        vkCmdCopyImageToBuffer(cmd, region.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, target->handle(), 1, &copy);
+
+        if (needsTransition)
+        {
+            // Back to where the caller left it; later work only has to wait for the read
+            VkImageMemoryBarrier toOriginal = {};
+            toOriginal.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            toOriginal.srcAccessMask        = 0;
+            toOriginal.dstAccessMask        = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            toOriginal.oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            toOriginal.newLayout            = region.layout;
+            toOriginal.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+            toOriginal.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+            toOriginal.image                = region.image;
+            toOriginal.subresourceRange     = range;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &toOriginal);
+        }
+
+        VkBufferMemoryBarrier toHost = {};
+        toHost.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        toHost.srcAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask         = VK_ACCESS_HOST_READ_BIT;
+        toHost.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+        toHost.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+        toHost.buffer                = target->handle();
+        toHost.offset                = 0;
+        toHost.size                  = size;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &toHost, 0, nullptr);
+
+        pending_[frameIndex_].push_back({ticket, std::move(target), size});
+        return true;
+    }
+
+    void ReadbackQueue::beginFrame(uint32_t frameIndex)
+    {
+        frameIndex_ = frameIndex % config_.framesInFlight;
+
+        // The fence of this slot has signaled, so every copy recorded in it is done
+        auto completed = std::move(pending_[frameIndex_]);
+        pending_[frameIndex_].clear();
+
+        for (auto& readback : completed)
+        {
+            readback.buffer->invalidate(0, readback.size); // No-op on coherent memory
+
+            auto* mapped           = static_cast<const std::byte*>(readback.buffer->allocationInfo().mappedData);
+            readback.ticket->data_ = std::span<const std::byte>(mapped, static_cast<size_t>(readback.size));
+            readback.ticket->state_.store(ReadbackTicket::State::Ready, std::memory_order_release);
+            ++completed_;
+
+            if (readback.ticket->onReady_)
+            {
+                readback.ticket->onReady_(*readback.ticket);
+                readback.ticket->onReady_ = nullptr;
+            }
+        }
+
+        trimIdleBuffers();
+    }
+
+    void ReadbackQueue::cancelPending()
+    {
+        for (auto& slot : pending_)
+        {
+            for (auto& readback : slot)
+            {
+                cancel(readback.ticket);
+            }
+            slot.clear();
+        }
+    }
+
+    ReadbackQueue::Stats ReadbackQueue::stats() const
+    {
+        Stats stats;
+        for (const auto& slot : pending_)
+        {
+            stats.pending += static_cast<uint32_t>(slot.size());
+        }
+        for (const auto& pooled : buffers_)
+        {
+            stats.buffers++;
+            stats.bufferBytes += pooled.buffer->size();
+            if (pooled.owner.expired())
+            {
+                stats.idleBuffers++;
+            }
+        }
+        stats.completed = completed_;
+        stats.failed    = failed_;
+        return stats;
+    }
+
+    uint32_t ReadbackQueue::texelSize(VkFormat format, VkImageAspectFlags aspect)
+    {
+        // Copies of a depth/stencil image read one aspect at a time
+        if (aspect == VK_IMAGE_ASPECT_STENCIL_BIT)
+        {
+            return format == VK_FORMAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D32_SFLOAT_S8_UINT ? 1 : 0;
+        }
+
+        switch (format)
+        {
+            case VK_FORMAT_R8_UNORM:
+            case VK_FORMAT_R8_UINT:
+                return 1;
+            case VK_FORMAT_R8G8_UNORM:
+            case VK_FORMAT_R16_UINT:
+            case VK_FORMAT_R16_SFLOAT:
+            case VK_FORMAT_D16_UNORM:
+                return 2;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+            case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+            case VK_FORMAT_R16G16_SFLOAT:
+            case VK_FORMAT_R32_UINT:
+            case VK_FORMAT_R32_SFLOAT:
+            case VK_FORMAT_D32_SFLOAT:
+            case VK_FORMAT_D32_SFLOAT_S8_UINT: // Depth aspect
+            case VK_FORMAT_X8_D24_UNORM_PACK32:
+            case VK_FORMAT_D24_UNORM_S8_UINT: // Depth aspect, 24 bits in 32
+                return 4;
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+            case VK_FORMAT_R32G32_UINT:
+            case VK_FORMAT_R32G32_SFLOAT:
+                return 8;
+            case VK_FORMAT_R32G32B32A32_UINT:
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    VmaBufferPtr ReadbackQueue::acquireBuffer(VkDeviceSize size, const ReadbackTicketPtr& ticket)
+    {
+        // Smallest idle buffer that fits
+        PooledBuffer* best = nullptr;
+        for (auto& pooled : buffers_)
+        {
+            if (pooled.owner.expired() && pooled.buffer->size() >= size &&
+                (!best || pooled.buffer->size() < best->buffer->size()))
+            {
+                best = &pooled;
+            }
+        }
+
+        if (!best)
+        {
+            // Round up so a resized screenshot or a burst of picks can reuse the buffer
+            VkDeviceSize bufferSize = std::max(config_.minBufferSize, size);
+            bufferSize              = (bufferSize + config_.minBufferSize - 1) / config_.minBufferSize * config_.minBufferSize;
+
+            try
+            {
+                buffers_.push_back({resourceManager_->createReadbackBuffer(bufferSize), {}});
+            }
+            catch (const VulkanError& e)
+            {
+                logger::error(std::string("ReadbackQueue: failed to allocate readback buffer: ") + e.what());
+                return nullptr;
+            }
+            best = &buffers_.back();
+        }
+
+        best->owner = ticket;
+        return best->buffer;
+    }
+
+    void ReadbackQueue::trimIdleBuffers()
+    {
+        uint32_t idle = 0;
+        auto     end  = std::remove_if(
+                                       buffers_.begin(),
+                                       buffers_.end(),
+                                       [this, &idle](PooledBuffer& pooled)
+                                       {
+                                           if (!pooled.owner.expired() || ++idle <= config_.maxIdleBuffers)
+                                           {
+                                               return false;
+                                           }
+                                           // Idle means completed, so the GPU no longer uses it
+                                           resourceManager_->destroyBuffer(std::move(pooled.buffer));
+                                           return true;
+                                       });
+        buffers_.erase(end, buffers_.end());
+    }
+
+    void ReadbackQueue::cancel(const ReadbackTicketPtr& ticket)
+    {
+        if (!ticket || ticket->state() != ReadbackTicket::State::Pending)
+        {
+            return;
+        }
+        ticket->state_.store(ReadbackTicket::State::Failed, std::memory_order_release);
+        ticket->onReady_ = nullptr;
+        ++failed_;
+    }
+} // namespace vulkan_engine::vulkan::memory
@@ -1,10 +1,15 @@
 #include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/core/utils/Logger.hpp"
+#include <algorithm>
+#include <unordered_map>
 
 namespace vulkan_engine::vulkan::memory
 {
     ResourceManager::ResourceManager(std::shared_ptr<DeviceManager> deviceManager, const CreateInfo& createInfo)
         : device_(std::move(deviceManager))
+        , createInfo_(createInfo)
     {
         if (!device_)
         {
@@ -30,6 +35,11 @@ namespace vulkan_engine::vulkan::memory
         LOG_INFO("ResourceManager created successfully");
     }
 
+    ResourceManager::~ResourceManager()
+    {
+        cancelDefragmentation();
+    }
+
     VmaBufferPtr ResourceManager::createBuffer(
         VkDeviceSize                   size,
         VkBufferUsageFlags             usage,
@@ -62,13 +72,14 @@ namespace vulkan_engine::vulkan::memory
         allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
         allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        // 浣跨敤 vertex pool锛堝鏋滃彲鐢級
-        if (auto pool = poolManager_->getPoolHandle(PoolType::Vertex))
-        {
-            allocInfo.pool = pool;
-        }
-
-        return createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, allocInfo);
+        // TRANSFER_SRC lets defragmentation copy the contents out when relocating
+        AllocationPlacement placement;
+        return createPlacedBuffer(size,
+                                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                  allocInfo,
+                                  poolManager_->getPoolHandle(PoolType::Vertex),
+                                  ResourceLifetime::Static,
+                                  placement);
     }
 
     VmaBufferPtr ResourceManager::createIndexBuffer(VkDeviceSize size)
@@ -77,13 +88,13 @@ namespace vulkan_engine::vulkan::memory
         allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
         allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        // 浣跨敤 index pool锛堝鏋滃彲鐢級
-        if (auto pool = poolManager_->getPoolHandle(PoolType::Index))
-        {
-            allocInfo.pool = pool;
-        }
-
-        return createBuffer(size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, allocInfo);
+        AllocationPlacement placement;
+        return createPlacedBuffer(size,
+                                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                  allocInfo,
+                                  poolManager_->getPoolHandle(PoolType::Index),
+                                  ResourceLifetime::Static,
+                                  placement);
     }
 
     VmaBufferPtr ResourceManager::createUniformBuffer(VkDeviceSize size, bool persistentMap)
@@ -147,12 +158,6 @@ namespace vulkan_engine::vulkan::memory
         allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
         allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        // 浣跨敤 render target pool锛堝鏋滃彲鐢級
-        if (auto pool = poolManager_->getPoolHandle(PoolType::RenderTarget))
-        {
-            allocInfo.pool = pool;
-        }
-
         VkImageCreateInfo imageInfo = {};
         imageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType         = VK_IMAGE_TYPE_2D;
@@ -166,9 +171,8 @@ namespace vulkan_engine::vulkan::memory
         imageInfo.samples           = samples;
         imageInfo.sharingMode       = VK_SHARING_MODE_EXCLUSIVE;
 
-        auto image           = std::make_shared<VmaImage>(allocator_, imageInfo, allocInfo);
-        images_[image.get()] = image;
-        return image;
+        AllocationPlacement placement;
+        return createPlacedImage(imageInfo, allocInfo, poolManager_->getPoolHandle(PoolType::RenderTarget), ResourceLifetime::Static, placement);
     }
 
     VmaImagePtr ResourceManager::createDepthAttachment(
@@ -181,12 +185,6 @@ namespace vulkan_engine::vulkan::memory
         allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
         allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        // 浣跨敤 render target pool锛堝鏋滃彲鐢級
-        if (auto pool = poolManager_->getPoolHandle(PoolType::RenderTarget))
-        {
-            allocInfo.pool = pool;
-        }
-
         VkImageCreateInfo imageInfo = {};
         imageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType         = VK_IMAGE_TYPE_2D;
@@ -200,9 +198,8 @@ namespace vulkan_engine::vulkan::memory
         imageInfo.samples           = samples;
         imageInfo.sharingMode       = VK_SHARING_MODE_EXCLUSIVE;
 
-        auto image           = std::make_shared<VmaImage>(allocator_, imageInfo, allocInfo);
-        images_[image.get()] = image;
-        return image;
+        AllocationPlacement placement;
+        return createPlacedImage(imageInfo, allocInfo, poolManager_->getPoolHandle(PoolType::RenderTarget), ResourceLifetime::Static, placement);
     }
 
     VmaImagePtr ResourceManager::createTexture(
@@ -216,12 +213,6 @@ namespace vulkan_engine::vulkan::memory
         allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
         allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        // 浣跨敤 texture pool锛堝鏋滃彲鐢級
-        if (auto pool = poolManager_->getPoolHandle(PoolType::Texture))
-        {
-            allocInfo.pool = pool;
-        }
-
         VkImageCreateInfo imageInfo = {};
         imageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType         = VK_IMAGE_TYPE_2D;
@@ -235,9 +226,8 @@ namespace vulkan_engine::vulkan::memory
         imageInfo.samples           = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode       = VK_SHARING_MODE_EXCLUSIVE;
 
-        auto image           = std::make_shared<VmaImage>(allocator_, imageInfo, allocInfo);
-        images_[image.get()] = image;
-        return image;
+        AllocationPlacement placement;
+        return createPlacedImage(imageInfo, allocInfo, poolManager_->getPoolHandle(PoolType::Texture), ResourceLifetime::Static, placement);
     }
 
     VmaImagePtr ResourceManager::createCubemap(uint32_t size, VkFormat format, uint32_t mipLevels)
@@ -260,15 +250,296 @@ namespace vulkan_engine::vulkan::memory
         imageInfo.samples           = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode       = VK_SHARING_MODE_EXCLUSIVE;
 
-        auto image           = std::make_shared<VmaImage>(allocator_, imageInfo, allocInfo);
-        images_[image.get()] = image;
+        AllocationPlacement placement;
+        return createPlacedImage(imageInfo, allocInfo, VK_NULL_HANDLE, ResourceLifetime::Static, placement);
+    }
+
+    std::optional<PoolType> ResourceManager::selectBufferPool(VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+    {
+        if (properties & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)
+        {
+            return PoolType::Readback;
+        }
+
+        if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+            {
+                return PoolType::Uniform;
+            }
+            if (usage == VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+            {
+                return PoolType::Staging;
+            }
+            return PoolType::Dynamic;
+        }
+
+        if (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+        {
+            return PoolType::Vertex;
+        }
+        if (usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+        {
+            return PoolType::Index;
+        }
+
+        // Device-local storage/indirect buffers have no dedicated pool
+        return std::nullopt;
+    }
+
+    PoolType ResourceManager::selectImagePool(VkImageUsageFlags usage)
+    {
+        constexpr VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                                      VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                                                      VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        return (usage & attachmentUsage) ? PoolType::RenderTarget : PoolType::Texture;
+    }
+
+    VmaPool ResourceManager::compatiblePool(PoolType type, VkMemoryPropertyFlags properties) const
+    {
+        MemoryPool* pool = poolManager_->getPool(type);
+        if (!pool || !pool->isValid())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // Pools are created from a property mask, so the type they settled on may lack some
+        // of the requested flags (e.g. Readback on a device without HOST_CACHED memory)
+        const auto& memProps = device_->memory_properties();
+        if ((memProps.memoryTypes[pool->memoryTypeIndex()].propertyFlags & properties) != properties)
+        {
+            return VK_NULL_HANDLE;
+        }
+        return pool->handle();
+    }
+
+    VmaBufferPtr ResourceManager::createPooledBuffer(
+        VkDeviceSize          size,
+        VkBufferUsageFlags    usage,
+        VkMemoryPropertyFlags properties,
+        bool                  persistentMap)
+    {
+        // Same memory type selection as DeviceManager::find_memory_type, but sub-allocated
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage                   = VMA_MEMORY_USAGE_UNKNOWN;
+        allocInfo.requiredFlags           = properties;
+        if (persistentMap)
+        {
+            allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
+
+        auto    type = selectBufferPool(usage, properties);
+        VmaPool pool = type ? compatiblePool(*type, properties) : VK_NULL_HANDLE;
+
+        const ResourceLifetime lifetime = (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? ResourceLifetime::Dynamic : ResourceLifetime::Static;
+
+        AllocationPlacement placement;
+        auto                buffer = createPlacedBuffer(size, usage, allocInfo, pool, lifetime, placement);
+        if (placement == AllocationPlacement::Shared)
+        {
+            unpooled_.insert(buffer.get());
+        }
+        return buffer;
+    }
+
+    VmaImagePtr ResourceManager::createPooledImage(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags properties)
+    {
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage                   = VMA_MEMORY_USAGE_UNKNOWN;
+        allocInfo.requiredFlags           = properties;
+
+        const ResourceLifetime lifetime = (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? ResourceLifetime::Dynamic : ResourceLifetime::Static;
+
+        AllocationPlacement placement;
+        auto                image = createPlacedImage(imageInfo,
+                                                      allocInfo,
+                                                      compatiblePool(selectImagePool(imageInfo.usage), properties),
+                                                      lifetime,
+                                                      placement);
+        if (placement == AllocationPlacement::Shared)
+        {
+            unpooled_.insert(image.get());
+        }
+        return image;
+    }
+
+    VmaBufferPtr ResourceManager::createPlacedBuffer(
+        VkDeviceSize            size,
+        VkBufferUsageFlags      usage,
+        VmaAllocationCreateInfo allocInfo,
+        VmaPool                 pool,
+        ResourceLifetime        lifetime,
+        AllocationPlacement&    placement)
+    {
+        AllocationPolicy& policy = allocator_->policy();
+
+        AllocationRequest request;
+        request.size          = size;
+        request.usage         = usage;
+        request.properties    = allocInfo.requiredFlags;
+        request.lifetime      = lifetime;
+        request.poolAvailable = pool != VK_NULL_HANDLE;
+
+        // Below driverHintMinSize a prefersDedicated hint is ignored anyway, so small
+        // buffers (the common case) skip the driver query
+        if (size >= policy.config().driverHintMinSize)
+        {
+            auto hint                 = AllocationPolicy::queryBufferRequirements(*device_, size, usage);
+            request.prefersDedicated  = hint.prefersDedicated;
+            request.requiresDedicated = hint.requiresDedicated;
+        }
+
+        AllocationDecision decision = policy.decide(request);
+        AllocationPolicy::apply(decision, allocInfo);
+
+        if (decision.placement == AllocationPlacement::Pooled)
+        {
+            allocInfo.pool = pool;
+            try
+            {
+                auto buffer = createBuffer(size, usage, allocInfo);
+                placement   = AllocationPlacement::Pooled;
+                policy.record(request, decision, placement);
+                return buffer;
+            }
+            catch (const VulkanError&)
+            {
+                // memoryTypeBits excludes the pool's type, or the pool hit maxBlockCount
+                allocInfo.pool = VK_NULL_HANDLE;
+            }
+        }
+
+        auto buffer = createBuffer(size, usage, allocInfo);
+        placement   = decision.placement == AllocationPlacement::Dedicated ? AllocationPlacement::Dedicated : AllocationPlacement::Shared;
+        policy.record(request, decision, placement);
+        return buffer;
+    }
+
+    VmaImagePtr ResourceManager::createPlacedImage(
+        const VkImageCreateInfo& imageInfo,
+        VmaAllocationCreateInfo  allocInfo,
+        VmaPool                  pool,
+        ResourceLifetime         lifetime,
+        AllocationPlacement&     placement)
+    {
+        AllocationPolicy& policy = allocator_->policy();
+        auto              hint   = AllocationPolicy::queryImageRequirements(*device_, imageInfo);
+
+        AllocationRequest request;
+        request.size              = hint.size;
+        request.image             = true;
+        request.usage             = imageInfo.usage;
+        request.properties        = allocInfo.requiredFlags;
+        request.lifetime          = lifetime;
+        request.poolAvailable     = pool != VK_NULL_HANDLE;
+        request.prefersDedicated  = hint.prefersDedicated;
+        request.requiresDedicated = hint.requiresDedicated;
+
+        AllocationDecision decision = policy.decide(request);
+        AllocationPolicy::apply(decision, allocInfo);
+
+        if (decision.placement == AllocationPlacement::Pooled)
+        {
+            allocInfo.pool = pool;
+            try
+            {
+                auto image = createImage(imageInfo, allocInfo);
+                placement  = AllocationPlacement::Pooled;
+                policy.record(request, decision, placement);
+                return image;
+            }
+            catch (const VulkanError&)
+            {
+                allocInfo.pool = VK_NULL_HANDLE;
+            }
+        }
+
+        auto image = createImage(imageInfo, allocInfo);
+        placement  = decision.placement == AllocationPlacement::Dedicated ? AllocationPlacement::Dedicated : AllocationPlacement::Shared;
+        policy.record(request, decision, placement);
         return image;
     }
 
+    VmaBufferPtr ResourceManager::createReadbackBuffer(VkDeviceSize size)
+    {
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage                   = VMA_MEMORY_USAGE_UNKNOWN;
+        allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        allocInfo.preferredFlags          = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        allocInfo.flags                   = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+
+        AllocationScope scope(AllocationCategory::Staging, "Readback");
+
+        // The pool only fits devices that really have HOST_CACHED memory; elsewhere the
+        // default blocks still give an uncached host-visible buffer
+        if (VmaPool pool = compatiblePool(PoolType::Readback, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT))
+        {
+            allocInfo.pool = pool;
+            try
+            {
+                auto buffer = createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, allocInfo);
+                pinned_.insert(buffer.get());
+                return buffer;
+            }
+            catch (const VulkanError&)
+            {
+                allocInfo.pool = VK_NULL_HANDLE;
+            }
+        }
+
+        // Readers hold pointers into the mapping, so these are never relocated
+        auto buffer = createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, allocInfo);
+        pinned_.insert(buffer.get());
+        unpooled_.insert(buffer.get());
+        return buffer;
+    }
+
     void ResourceManager::printStats() const
     {
         allocator_->printStats();
         poolManager_->printStats();
+
+        auto stats = allocationStats();
+        LOG_INFO("  Unpooled: " << stats.unpooledResources << " resources, device memory blocks="
+                 << stats.deviceMemoryBlocks);
+
+        for (size_t i = 0; i < stats.policy.placements.size(); ++i)
+        {
+            const auto& totals = stats.policy.placements[i];
+            if (totals.count > 0)
+            {
+                LOG_INFO("  " << toString(static_cast<AllocationPlacement>(i)) << ": " << totals.count
+                         << " allocations, " << totals.bytes / (1024.0 * 1024.0) << " MB");
+            }
+        }
+        LOG_INFO("  Policy: driver-hinted dedicated=" << stats.policy.driverHinted
+                 << ", pool fallbacks=" << stats.policy.poolFallbacks);
+
+        if (AllocationTracker* tracker = allocator_->tracker())
+        {
+            auto totals = tracker->totals();
+            for (size_t i = 0; i < totals.size(); ++i)
+            {
+                if (totals[i].count > 0)
+                {
+                    LOG_INFO("  " << toString(static_cast<AllocationCategory>(i)) << ": " << totals[i].count
+                             << " allocations, " << totals[i].bytes / (1024.0 * 1024.0) << " MB");
+                }
+            }
+        }
+    }
+
+    ResourceManager::AllocationStats ResourceManager::allocationStats() const
+    {
+        AllocationStats stats;
+        stats.pools             = poolManager_->collectStats();
+        stats.unpooledResources = static_cast<uint32_t>(unpooled_.size());
+        stats.policy            = allocator_->policy().stats();
+        for (const auto& budget : getHeapBudgets())
+        {
+            stats.deviceMemoryBlocks += budget.statistics.blockCount;
+        }
+        return stats;
     }
 
     std::string ResourceManager::buildStatsString(bool detailed) const
@@ -298,6 +569,8 @@ namespace vulkan_engine::vulkan::memory
     {
         if (buffer)
         {
+            unpooled_.erase(buffer.get());
+            pinned_.erase(buffer.get());
             buffers_.erase(buffer.get());
             buffer.reset();
         }
@@ -307,25 +580,387 @@ namespace vulkan_engine::vulkan::memory
     {
         if (image)
         {
+            unpooled_.erase(image.get());
+            pinned_.erase(image.get());
             images_.erase(image.get());
             image.reset();
         }
     }
 
+    void ResourceManager::beginFrame(VkCommandBuffer cmd, uint64_t frameNumber)
+    {
+        currentFrame_ = frameNumber;
+        vmaSetCurrentFrameIndex(allocator_->handle(), static_cast<uint32_t>(frameNumber));
+
+        if (!isDefragmenting())
+        {
+            startAutomaticDefragmentation();
+            if (!isDefragmenting())
+            {
+                return;
+            }
+        }
+
+        if (passInFlight_)
+        {
+            // The copies went out with the previous frame's submission, so the latest
+            // value covers them; VMA frees the old memory only once it has completed
+            QueueTimeline* timeline = device_->graphics_timeline();
+            if (passValue_ == 0)
+            {
+                passValue_ = timeline->last_submitted();
+            }
+            if (!timeline->is_complete(passValue_))
+            {
+                return;
+            }
+            completeDefragmentationPass();
+            if (!isDefragmenting())
+            {
+                return;
+            }
+        }
+
+        recordDefragmentationPass(cmd);
+    }
+
+    bool ResourceManager::beginDefragmentation(const DefragmentationConfig& config)
+    {
+        if (!createInfo_.enableDefragmentation)
+        {
+            LOG_WARN("ResourceManager::beginDefragmentation: defragmentation is disabled");
+            return false;
+        }
+        if (isDefragmenting())
+        {
+            return false;
+        }
+        if (!device_->deletion_queue() || !device_->graphics_timeline())
+        {
+            LOG_WARN("ResourceManager::beginDefragmentation: the device has no deletion queue or graphics timeline");
+            return false;
+        }
+
+        VmaDefragmentationInfo info = {};
+        info.flags                  = config.algorithm;
+        info.pool                   = config.pool;
+        info.maxBytesPerPass        = config.maxBytesPerPass;
+        info.maxAllocationsPerPass  = config.maxAllocationsPerPass;
+
+        VkResult result = vmaBeginDefragmentation(allocator_->handle(), &info, &defragContext_);
+        if (result != VK_SUCCESS)
+        {
+            defragContext_ = VK_NULL_HANDLE;
+            throw VulkanError(result, "Failed to begin defragmentation", __FILE__, __LINE__);
+        }
+
+        defragConfig_ = config;
+        defragStats_  = {};
+        LOG_INFO("ResourceManager: defragmentation started (maxBytesPerPass=" << config.maxBytesPerPass
+                 << ", maxAllocationsPerPass=" << config.maxAllocationsPerPass << ")");
+        return true;
+    }
+
+    void ResourceManager::cancelDefragmentation()
+    {
+        if (!isDefragmenting())
+        {
+            return;
+        }
+
+        // A recorded pass cannot be abandoned halfway: its owners already use the new
+        // handles, so let the copies land before ending it.
+        flush();
+        if (isDefragmenting())
+        {
+            finishDefragmentation();
+        }
+    }
+
+    void ResourceManager::startAutomaticDefragmentation()
+    {
+        const uint32_t interval = createInfo_.autoDefragmentInterval;
+        if (interval == 0 || currentFrame_ % interval != 0 || !createInfo_.enableDefragmentation ||
+            !device_->deletion_queue() || !device_->graphics_timeline())
+        {
+            return;
+        }
+
+        // Only these pools hold relocatable resources: staging, uniform and readback memory
+        // is mapped, render targets are rewritten every frame
+        std::optional<PoolType> candidate;
+        VkDeviceSize            candidateUnused = 0;
+        for (const auto& [type, stats] : poolManager_->collectStats())
+        {
+            // With a single block there is nothing to compact into
+            if ((type != PoolType::Vertex && type != PoolType::Index && type != PoolType::Texture) || stats.blockCount < 2)
+            {
+                continue;
+            }
+
+            const VkDeviceSize unused  = stats.size - stats.usedSize;
+            VkDeviceSize&      settled = settledUnused_[type];
+            settled                    = std::min(settled, unused); // Frees since the last run re-arm the pool
+
+            if (unused < createInfo_.autoDefragmentMinBytes ||
+                static_cast<double>(unused) < static_cast<double>(stats.size) * createInfo_.autoDefragmentThreshold ||
+                unused - settled < createInfo_.autoDefragmentMinBytes || unused <= candidateUnused)
+            {
+                continue;
+            }
+            candidate       = type;
+            candidateUnused = unused;
+        }
+
+        if (!candidate)
+        {
+            return;
+        }
+
+        DefragmentationConfig config;
+        config.pool = poolManager_->getPoolHandle(*candidate);
+        if (config.pool != VK_NULL_HANDLE && beginDefragmentation(config))
+        {
+            autoDefragPool_ = candidate;
+        }
+    }
+
+    void ResourceManager::recordDefragmentationPass(VkCommandBuffer cmd)
+    {
+        VkResult result = vmaBeginDefragmentationPass(allocator_->handle(), defragContext_, &defragPass_);
+        if (result == VK_SUCCESS)
+        {
+            // Nothing left to move
+            finishDefragmentation();
+            return;
+        }
+        if (result != VK_INCOMPLETE)
+        {
+            throw VulkanError(result, "Failed to begin defragmentation pass", __FILE__, __LINE__);
+        }
+
+        // VMA reports allocations; map them back to the owning resources
+        std::unordered_map<VmaAllocation, VmaBufferPtr> bufferOwners;
+        std::unordered_map<VmaAllocation, VmaImagePtr>  imageOwners;
+        bufferOwners.reserve(buffers_.size());
+        imageOwners.reserve(images_.size());
+        for (const auto& [ptr, buffer] : buffers_)
+        {
+            if (!pinned_.contains(ptr))
+            {
+                bufferOwners.emplace(buffer->allocation().handle(), buffer);
+            }
+        }
+        for (const auto& [ptr, image] : images_)
+        {
+            if (!pinned_.contains(ptr))
+            {
+                imageOwners.emplace(image->allocation().handle(), image);
+            }
+        }
+
+        pendingMoves_.assign(defragPass_.moveCount, {});
+        bool anyMoves   = false;
+        bool anyBuffers = false;
+        for (uint32_t i = 0; i < defragPass_.moveCount; ++i)
+        {
+            VmaDefragmentationMove& move    = defragPass_.pMoves[i];
+            PendingMove&            pending = pendingMoves_[i];
+
+            VmaAllocationInfo srcInfo;
+            vmaGetAllocationInfo(allocator_->handle(), move.srcAllocation, &srcInfo);
+            pending.size = srcInfo.size;
+
+            try
+            {
+                if (auto it = bufferOwners.find(move.srcAllocation); it != bufferOwners.end() && it->second->isRelocatable())
+                {
+                    pending.buffer          = it->second;
+                    pending.relocatedBuffer = pending.buffer->createRelocationTarget(move.dstTmpAllocation);
+                    anyBuffers              = true;
+                }
+                else if (auto it2 = imageOwners.find(move.srcAllocation); it2 != imageOwners.end() && it2->second->isRelocatable())
+                {
+                    pending.image          = it2->second;
+                    pending.relocatedImage = pending.image->createRelocationTarget(move.dstTmpAllocation);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARN("ResourceManager: skipping defragmentation move: " << e.what());
+                pending = {};
+            }
+
+            if (pending.relocatedBuffer == VK_NULL_HANDLE && pending.relocatedImage == VK_NULL_HANDLE)
+            {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                ++defragStats_.allocationsSkipped;
+                continue;
+            }
+            anyMoves = true;
+        }
+
+        if (anyBuffers)
+        {
+            VkMemoryBarrier before = {};
+            before.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            before.srcAccessMask   = VK_ACCESS_MEMORY_WRITE_BIT;
+            before.dstAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &before, 0,
+                                 nullptr, 0, nullptr);
+        }
+
+        for (const PendingMove& pending : pendingMoves_)
+        {
+            if (pending.relocatedBuffer != VK_NULL_HANDLE)
+            {
+                VkBufferCopy region = {0, 0, pending.buffer->size()};
+                vkCmdCopyBuffer(cmd, pending.buffer->handle(), pending.relocatedBuffer, 1, &region);
+            }
+            else if (pending.relocatedImage != VK_NULL_HANDLE)
+            {
+                pending.image->recordRelocationCopy(cmd, pending.relocatedImage);
+            }
+        }
+
+        if (anyBuffers)
+        {
+            VkMemoryBarrier after = {};
+            after.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            after.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            after.dstAccessMask   = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &after, 0,
+                                 nullptr, 0, nullptr);
+        }
+
+        // Swap now: the rest of this frame and every later one use the new handles, while
+        // frames already queued keep the old ones until the deletion queue retires them
+        DeletionQueue&          deletionQueue = *device_->deletion_queue();
+        std::vector<VmaBuffer*> relocatedBuffers;
+        std::vector<VmaImage*>  relocatedImages;
+        for (PendingMove& pending : pendingMoves_)
+        {
+            if (pending.relocatedBuffer != VK_NULL_HANDLE)
+            {
+                pending.buffer->adoptRelocation(pending.relocatedBuffer, deletionQueue);
+                relocatedBuffers.push_back(pending.buffer.get());
+            }
+            else if (pending.relocatedImage != VK_NULL_HANDLE)
+            {
+                try
+                {
+                    pending.image->adoptRelocation(pending.relocatedImage, deletionQueue);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("ResourceManager: failed to rebuild views after defragmentation: " << e.what());
+                }
+                relocatedImages.push_back(pending.image.get());
+            }
+            else
+            {
+                continue;
+            }
+            ++defragStats_.allocationsMoved;
+            defragStats_.bytesMoved += pending.size;
+        }
+
+        passInFlight_ = true;
+        passValue_    = 0;
+
+        if (relocationCallback_ && (!relocatedBuffers.empty() || !relocatedImages.empty()))
+        {
+            relocationCallback_(relocatedBuffers, relocatedImages);
+        }
+
+        // Every move was skipped, so there is no GPU work to wait for
+        if (!anyMoves)
+        {
+            completeDefragmentationPass();
+        }
+    }
+
+    void ResourceManager::completeDefragmentationPass()
+    {
+        // Owners already hold the new handles; this releases the old memory and
+        // repoints their allocations at the new one
+        VkResult result = vmaEndDefragmentationPass(allocator_->handle(), defragContext_, &defragPass_);
+        ++defragStats_.passes;
+
+        for (PendingMove& pending : pendingMoves_)
+        {
+            if (pending.relocatedBuffer != VK_NULL_HANDLE)
+            {
+                pending.buffer->refreshAllocationInfo();
+            }
+            else if (pending.relocatedImage != VK_NULL_HANDLE)
+            {
+                pending.image->refreshAllocationInfo();
+            }
+        }
+
+        pendingMoves_.clear();
+        defragPass_   = {};
+        passInFlight_ = false;
+        passValue_    = 0;
+
+        if (result == VK_SUCCESS)
+        {
+            finishDefragmentation();
+        }
+        else if (result != VK_INCOMPLETE)
+        {
+            LOG_ERROR("ResourceManager: vmaEndDefragmentationPass failed (" << result << ")");
+            finishDefragmentation();
+        }
+    }
+
+    void ResourceManager::finishDefragmentation()
+    {
+        VmaDefragmentationStats stats = {};
+        vmaEndDefragmentation(allocator_->handle(), defragContext_, &stats);
+        defragContext_ = VK_NULL_HANDLE;
+
+        defragStats_.bytesFreed              = stats.bytesFreed;
+        defragStats_.deviceMemoryBlocksFreed = stats.deviceMemoryBlocksFreed;
+
+        if (autoDefragPool_)
+        {
+            for (const auto& [type, poolStats] : poolManager_->collectStats())
+            {
+                if (type == *autoDefragPool_)
+                {
+                    settledUnused_[type] = poolStats.size - poolStats.usedSize;
+                }
+            }
+            autoDefragPool_.reset();
+        }
+
+        LOG_INFO("ResourceManager: defragmentation finished after " << defragStats_.passes << " passes, moved "
+                 << defragStats_.allocationsMoved << " allocations (" << defragStats_.bytesMoved << " bytes), skipped "
+                 << defragStats_.allocationsSkipped << ", freed " << stats.deviceMemoryBlocksFreed << " blocks ("
+                 << stats.bytesFreed << " bytes)");
+    }
+
     void ResourceManager::defragment()
     {
-        // VMA 3.3.0+ 鏀寔纰庣墖鏁寸悊
-        // 杩欐槸涓€涓崰浣嶇瀹炵幇锛屽畬鏁寸殑瀹炵幇闇€瑕佷娇鐢?vmaDefragmentationBegin/vmaDefragmentationEnd
-        LOG_INFO("ResourceManager::defragment called (placeholder)");
+        // Passes are recorded and retired from beginFrame()
+        beginDefragmentation();
     }
 
     void ResourceManager::flush()
     {
-        // 寮哄埗閲婃斁鏈娇鐢ㄧ殑鍐呭瓨鍧?
-        if (allocator_)
+        if (!passInFlight_)
+        {
+            return;
+        }
+
+        // Between frames the copies have been submitted, so the latest value covers them.
+        // Without a timeline the device has been shut down and is idle already.
+        if (QueueTimeline* timeline = device_->graphics_timeline())
         {
-            vmaSetCurrentFrameIndex(allocator_->handle(), 0);
+            timeline->wait(passValue_ != 0 ? passValue_ : timeline->last_submitted());
         }
-        LOG_INFO("ResourceManager::flush called");
+        completeDefragmentationPass();
     }
-} // namespace vulkan_engine::vulkan::memory
\ No newline at end of file
+} // namespace vulkan_engine::vulkan::memory
@@ -2,6 +2,7 @@
 #define VMA_IMPLEMENTATION
 
 #include "engine/rhi/vulkan/memory/VmaAllocator.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include "engine/core/utils/Logger.hpp"
 #include <cstring>
 #include <sstream>
@@ -75,6 +76,12 @@ namespace vulkan_engine::vulkan::memory
             throw VulkanError(result, "Failed to create VMA allocator", __FILE__, __LINE__);
         }
 
+        if (createInfo.trackAllocations)
+        {
+            tracker_ = std::make_unique<AllocationTracker>();
+        }
+        policy_ = std::make_unique<AllocationPolicy>(createInfo.policy);
+
         LOG_INFO("VMA Allocator created successfully");
     }
 
@@ -87,6 +94,8 @@ namespace vulkan_engine::vulkan::memory
         : deviceManager_(std::move(other.deviceManager_))
         , allocator_(other.allocator_)
         , pools_(std::move(other.pools_))
+        , tracker_(std::move(other.tracker_))
+        , policy_(std::move(other.policy_))
     {
         other.allocator_ = VK_NULL_HANDLE;
     }
@@ -99,6 +108,8 @@ namespace vulkan_engine::vulkan::memory
             deviceManager_   = std::move(other.deviceManager_);
             allocator_       = other.allocator_;
             pools_           = std::move(other.pools_);
+            tracker_         = std::move(other.tracker_);
+            policy_          = std::move(other.policy_);
             other.allocator_ = VK_NULL_HANDLE;
         }
         return *this;
@@ -108,6 +119,13 @@ namespace vulkan_engine::vulkan::memory
     {
         if (allocator_ != VK_NULL_HANDLE)
         {
+            // Deferred VMA records must not outlive the allocator they point at
+            if (DeletionQueue* deletion_queue = deviceManager_ ? deviceManager_->deletion_queue() : nullptr)
+            {
+                vkDeviceWaitIdle(deviceManager_->device().handle());
+                deletion_queue->flush();
+            }
+
             // 閿€姣佹墍鏈夋睜
             for (VmaPool pool : pools_)
             {
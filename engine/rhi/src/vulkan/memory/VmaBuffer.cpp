@@ -1,4 +1,5 @@
 #include "engine/rhi/vulkan/memory/VmaBuffer.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include "engine/core/utils/Logger.hpp"
 #include <cstring>
 #include <sstream>
@@ -36,6 +37,14 @@ namespace vulkan_engine::vulkan::memory
 
         allocation_ = Allocation(allocator_, allocation);
 
+        if (AllocationTracker* tracker = allocator_->tracker())
+        {
+            const auto& memoryProperties = allocator_->device()->memory_properties();
+            tracker->onAllocate(allocator_->handle(), allocation,
+                                resolveBufferTag(usage, memoryProperties.memoryTypes[allocationInfo.memoryType].propertyFlags),
+                                allocationInfo.size, allocationInfo.memoryType);
+        }
+
         // 瀛樺偍鍒嗛厤淇℃伅
         allocationInfo_.size               = allocationInfo.size;
         allocationInfo_.memoryTypeIndex    = allocationInfo.memoryType;
@@ -68,6 +77,7 @@ namespace vulkan_engine::vulkan::memory
         , usage_(other.usage_)
         , allocationInfo_(other.allocationInfo_)
         , mappedData_(other.mappedData_)
+        , generation_(other.generation_)
     {
         other.buffer_     = VK_NULL_HANDLE;
         other.size_       = 0;
@@ -86,6 +96,7 @@ namespace vulkan_engine::vulkan::memory
             usage_            = other.usage_;
             allocationInfo_   = other.allocationInfo_;
             mappedData_       = other.mappedData_;
+            generation_       = other.generation_;
             other.buffer_     = VK_NULL_HANDLE;
             other.size_       = 0;
             other.mappedData_ = nullptr;
@@ -107,6 +118,74 @@ namespace vulkan_engine::vulkan::memory
         }
     }
 
+    void VmaBuffer::retire(DeletionQueue& queue)
+    {
+        if (buffer_ != VK_NULL_HANDLE && allocator_)
+        {
+            queue.defer(buffer_, allocation_.release(), allocator_->handle());
+        }
+        buffer_     = VK_NULL_HANDLE;
+        size_       = 0;
+        mappedData_ = nullptr;
+    }
+
+    bool VmaBuffer::isRelocatable() const noexcept
+    {
+        // The move is a GPU copy from the old buffer into a twin with the same usage,
+        // so both transfer directions are required. Host-visible buffers are written
+        // by the CPU every frame and would lose those writes while the copy is in flight.
+        constexpr VkBufferUsageFlags transferBits = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        return isValid() && (usage_ & transferBits) == transferBits && mappedData_ == nullptr
+               && !allocationInfo_.isPersistentMapped;
+    }
+
+    VkBuffer VmaBuffer::createRelocationTarget(VmaAllocation target) const
+    {
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size               = size_;
+        bufferInfo.usage              = usage_;
+        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkDevice device    = allocator_->device()->device().handle();
+        VkBuffer relocated = VK_NULL_HANDLE;
+        VkResult result    = vkCreateBuffer(device, &bufferInfo, nullptr, &relocated);
+        if (result != VK_SUCCESS)
+        {
+            throw VulkanError(result, "Failed to create relocation buffer", __FILE__, __LINE__);
+        }
+
+        result = vmaBindBufferMemory(allocator_->handle(), target, relocated);
+        if (result != VK_SUCCESS)
+        {
+            vkDestroyBuffer(device, relocated, nullptr);
+            throw VulkanError(result, "Failed to bind relocation buffer", __FILE__, __LINE__);
+        }
+        return relocated;
+    }
+
+    void VmaBuffer::adoptRelocation(VkBuffer relocated, DeletionQueue& queue)
+    {
+        // Frames recorded before the swap still use the old VkBuffer, so it is deferred.
+        // The VmaAllocation handle stays valid and is repointed at the new memory when
+        // the defragmentation pass ends.
+        if (buffer_ != VK_NULL_HANDLE)
+        {
+            queue.defer(buffer_);
+        }
+        buffer_ = relocated;
+        ++generation_;
+    }
+
+    void VmaBuffer::refreshAllocationInfo()
+    {
+        VmaAllocationInfo info;
+        vmaGetAllocationInfo(allocator_->handle(), allocation_.handle(), &info);
+        allocationInfo_.size            = info.size;
+        allocationInfo_.memoryTypeIndex = info.memoryType;
+        allocationInfo_.mappedData      = info.pMappedData;
+    }
+
     void* VmaBuffer::map()
     {
         if (mappedData_ != nullptr)
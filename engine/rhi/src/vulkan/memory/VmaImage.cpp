@@ -1,5 +1,6 @@
 #include "engine/rhi/vulkan/memory/VmaImage.hpp"
 #include "engine/rhi/vulkan/memory/VmaBuffer.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include "engine/core/utils/Logger.hpp"
 #include <cstring>
 #include <sstream>
@@ -7,6 +8,28 @@
 
 namespace vulkan_engine::vulkan::memory
 {
+    namespace
+    {
+        VkImageAspectFlags aspectMaskFor(VkFormat format)
+        {
+            switch (format)
+            {
+                case VK_FORMAT_D16_UNORM:
+                case VK_FORMAT_X8_D24_UNORM_PACK32:
+                case VK_FORMAT_D32_SFLOAT:
+                    return VK_IMAGE_ASPECT_DEPTH_BIT;
+                case VK_FORMAT_D16_UNORM_S8_UINT:
+                case VK_FORMAT_D24_UNORM_S8_UINT:
+                case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                    return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+                case VK_FORMAT_S8_UINT:
+                    return VK_IMAGE_ASPECT_STENCIL_BIT;
+                default:
+                    return VK_IMAGE_ASPECT_COLOR_BIT;
+            }
+        }
+    } // namespace
+
     VmaImage::VmaImage(
         std::shared_ptr<VmaAllocator>  allocator,
         const VkImageCreateInfo&       imageInfo,
@@ -19,6 +42,8 @@ namespace vulkan_engine::vulkan::memory
         , samples_(imageInfo.samples)
         , usage_(imageInfo.usage)
         , imageType_(imageInfo.imageType)
+        , flags_(imageInfo.flags)
+        , tiling_(imageInfo.tiling)
         , currentLayout_(imageInfo.initialLayout)
     {
         if (!allocator_)
@@ -37,6 +62,12 @@ namespace vulkan_engine::vulkan::memory
 
         allocation_ = Allocation(allocator_, allocation);
 
+        if (AllocationTracker* tracker = allocator_->tracker())
+        {
+            tracker->onAllocate(allocator_->handle(), allocation, resolveImageTag(imageInfo.usage), allocationInfo.size,
+                                allocationInfo.memoryType);
+        }
+
         // 瀛樺偍鍒嗛厤淇℃伅
         allocationInfo_.size            = allocationInfo.size;
         allocationInfo_.memoryTypeIndex = allocationInfo.memoryType;
@@ -59,6 +90,7 @@ namespace vulkan_engine::vulkan::memory
         , image_(other.image_)
         , allocation_(std::move(other.allocation_))
         , views_(std::move(other.views_))
+        , viewDescs_(std::move(other.viewDescs_))
         , format_(other.format_)
         , extent_(other.extent_)
         , mipLevels_(other.mipLevels_)
@@ -66,11 +98,15 @@ namespace vulkan_engine::vulkan::memory
         , samples_(other.samples_)
         , usage_(other.usage_)
         , imageType_(other.imageType_)
+        , flags_(other.flags_)
+        , tiling_(other.tiling_)
         , currentLayout_(other.currentLayout_)
         , allocationInfo_(other.allocationInfo_)
+        , generation_(other.generation_)
     {
         other.image_ = VK_NULL_HANDLE;
         other.views_.clear();
+        other.viewDescs_.clear();
     }
 
     VmaImage& VmaImage::operator=(VmaImage&& other) noexcept
@@ -82,6 +118,7 @@ namespace vulkan_engine::vulkan::memory
             image_          = other.image_;
             allocation_     = std::move(other.allocation_);
             views_          = std::move(other.views_);
+            viewDescs_      = std::move(other.viewDescs_);
             format_         = other.format_;
             extent_         = other.extent_;
             mipLevels_      = other.mipLevels_;
@@ -89,10 +126,14 @@ namespace vulkan_engine::vulkan::memory
             samples_        = other.samples_;
             usage_          = other.usage_;
             imageType_      = other.imageType_;
+            flags_          = other.flags_;
+            tiling_         = other.tiling_;
             currentLayout_  = other.currentLayout_;
             allocationInfo_ = other.allocationInfo_;
+            generation_     = other.generation_;
             other.image_    = VK_NULL_HANDLE;
             other.views_.clear();
+            other.viewDescs_.clear();
         }
         return *this;
     }
@@ -108,6 +149,7 @@ namespace vulkan_engine::vulkan::memory
             }
         }
         views_.clear();
+        viewDescs_.clear();
 
         // 閿€姣?image锛坅llocation 浼氳嚜鍔ㄩ噴鏀撅級
         if (image_ != VK_NULL_HANDLE)
@@ -121,17 +163,27 @@ namespace vulkan_engine::vulkan::memory
     }
 
     VkImageView VmaImage::createView(VkImageViewType viewType, VkFormat format, const ImageSubresourceRange& range)
+    {
+        ViewDesc    desc{viewType, format == VK_FORMAT_UNDEFINED ? format_ : format, range};
+        VkImageView view = makeView(desc);
+
+        views_.push_back(view);
+        viewDescs_.push_back(desc);
+        return view;
+    }
+
+    VkImageView VmaImage::makeView(const ViewDesc& desc) const
     {
         VkImageViewCreateInfo viewInfo           = {};
         viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         viewInfo.image                           = image_;
-        viewInfo.viewType                        = viewType;
-        viewInfo.format                          = format == VK_FORMAT_UNDEFINED ? format_ : format;
-        viewInfo.subresourceRange.aspectMask     = range.aspectMask;
-        viewInfo.subresourceRange.baseMipLevel   = range.baseMipLevel;
-        viewInfo.subresourceRange.levelCount     = range.levelCount;
-        viewInfo.subresourceRange.baseArrayLayer = range.baseArrayLayer;
-        viewInfo.subresourceRange.layerCount     = range.layerCount;
+        viewInfo.viewType                        = desc.viewType;
+        viewInfo.format                          = desc.format;
+        viewInfo.subresourceRange.aspectMask     = desc.range.aspectMask;
+        viewInfo.subresourceRange.baseMipLevel   = desc.range.baseMipLevel;
+        viewInfo.subresourceRange.levelCount     = desc.range.levelCount;
+        viewInfo.subresourceRange.baseArrayLayer = desc.range.baseArrayLayer;
+        viewInfo.subresourceRange.layerCount     = desc.range.layerCount;
 
         VkImageView view   = VK_NULL_HANDLE;
         VkResult    result = vkCreateImageView(allocator_->device()->device().handle(), &viewInfo, nullptr, &view);
@@ -139,8 +191,6 @@ namespace vulkan_engine::vulkan::memory
         {
             throw VulkanError(result, "Failed to create image view", __FILE__, __LINE__);
         }
-
-        views_.push_back(view);
         return view;
     }
 
@@ -150,10 +200,27 @@ namespace vulkan_engine::vulkan::memory
         if (it != views_.end())
         {
             vkDestroyImageView(allocator_->device()->device().handle(), view, nullptr);
+            viewDescs_.erase(viewDescs_.begin() + (it - views_.begin()));
             views_.erase(it);
         }
     }
 
+    void VmaImage::retire(DeletionQueue& queue)
+    {
+        for (VkImageView view : views_)
+        {
+            queue.defer(view);
+        }
+        views_.clear();
+        viewDescs_.clear();
+
+        if (image_ != VK_NULL_HANDLE && allocator_)
+        {
+            queue.defer(image_, allocation_.release(), allocator_->handle());
+        }
+        image_ = VK_NULL_HANDLE;
+    }
+
     void VmaImage::destroyAllViews()
     {
         for (VkImageView view : views_)
@@ -164,6 +231,150 @@ namespace vulkan_engine::vulkan::memory
             }
         }
         views_.clear();
+        viewDescs_.clear();
+    }
+
+    bool VmaImage::isRelocatable() const noexcept
+    {
+        // Attachments and storage images are rewritten by the GPU every frame, so
+        // anything rendered between the copy and the handle swap would be lost.
+        constexpr VkImageUsageFlags transferBits = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        constexpr VkImageUsageFlags gpuWritten   = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                                 VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+        return isValid() && tiling_ == VK_IMAGE_TILING_OPTIMAL && (usage_ & transferBits) == transferBits &&
+               (usage_ & gpuWritten) == 0;
+    }
+
+    VkImage VmaImage::createRelocationTarget(VmaAllocation target) const
+    {
+        VkImageCreateInfo imageInfo = {};
+        imageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.flags             = flags_;
+        imageInfo.imageType         = imageType_;
+        imageInfo.format            = format_;
+        imageInfo.extent            = extent_;
+        imageInfo.mipLevels         = mipLevels_;
+        imageInfo.arrayLayers       = arrayLayers_;
+        imageInfo.samples           = samples_;
+        imageInfo.tiling            = tiling_;
+        imageInfo.usage             = usage_;
+        imageInfo.sharingMode       = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VkDevice device    = allocator_->device()->device().handle();
+        VkImage  relocated = VK_NULL_HANDLE;
+        VkResult result    = vkCreateImage(device, &imageInfo, nullptr, &relocated);
+        if (result != VK_SUCCESS)
+        {
+            throw VulkanError(result, "Failed to create relocation image", __FILE__, __LINE__);
+        }
+
+        result = vmaBindImageMemory(allocator_->handle(), target, relocated);
+        if (result != VK_SUCCESS)
+        {
+            vkDestroyImage(device, relocated, nullptr);
+            throw VulkanError(result, "Failed to bind relocation image", __FILE__, __LINE__);
+        }
+        return relocated;
+    }
+
+    void VmaImage::recordRelocationCopy(VkCommandBuffer cmd, VkImage relocated) const
+    {
+        // Nothing has been written yet, the new image can start out undefined as well
+        if (currentLayout_ == VK_IMAGE_LAYOUT_UNDEFINED)
+        {
+            return;
+        }
+
+        VkImageSubresourceRange range = {aspectMaskFor(format_), 0, mipLevels_, 0, arrayLayers_};
+
+        VkImageMemoryBarrier toTransfer[2] = {};
+        toTransfer[0].sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer[0].srcAccessMask        = getAccessMask(currentLayout_);
+        toTransfer[0].dstAccessMask        = VK_ACCESS_TRANSFER_READ_BIT;
+        toTransfer[0].oldLayout            = currentLayout_;
+        toTransfer[0].newLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer[0].srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer[0].dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer[0].image                = image_;
+        toTransfer[0].subresourceRange     = range;
+        toTransfer[1]                      = toTransfer[0];
+        toTransfer[1].srcAccessMask        = 0;
+        toTransfer[1].dstAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toTransfer[1].oldLayout            = VK_IMAGE_LAYOUT_UNDEFINED;
+        toTransfer[1].newLayout            = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer[1].image                = relocated;
+
+        vkCmdPipelineBarrier(cmd, getStageMask(currentLayout_) | VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 2, toTransfer);
+
+        std::vector<VkImageCopy> regions(mipLevels_);
+        for (uint32_t mip = 0; mip < mipLevels_; ++mip)
+        {
+            VkImageCopy& region   = regions[mip];
+            region.srcSubresource = {range.aspectMask, mip, 0, arrayLayers_};
+            region.srcOffset      = {0, 0, 0};
+            region.dstSubresource = region.srcSubresource;
+            region.dstOffset      = {0, 0, 0};
+            region.extent         = {
+                std::max(1u, extent_.width >> mip),
+                std::max(1u, extent_.height >> mip),
+                std::max(1u, extent_.depth >> mip)
+            };
+        }
+        vkCmdCopyImage(cmd, image_, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, relocated, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       static_cast<uint32_t>(regions.size()), regions.data());
+
+        // Both images go back to the tracked layout: frames recorded before the swap
+        // keep sampling the old image, later ones the new image.
+        VkImageMemoryBarrier restore[2] = {toTransfer[0], toTransfer[1]};
+        restore[0].srcAccessMask        = VK_ACCESS_TRANSFER_READ_BIT;
+        restore[0].dstAccessMask        = getAccessMask(currentLayout_);
+        restore[0].oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        restore[0].newLayout            = currentLayout_;
+        restore[1].srcAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+        restore[1].dstAccessMask        = getAccessMask(currentLayout_);
+        restore[1].oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        restore[1].newLayout            = currentLayout_;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, getStageMask(currentLayout_) | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0, 0, nullptr, 0, nullptr, 2, restore);
+    }
+
+    void VmaImage::adoptRelocation(VkImage relocated, DeletionQueue& queue)
+    {
+        // Frames recorded before the swap still sample the old image and views
+        for (VkImageView& view : views_)
+        {
+            if (view != VK_NULL_HANDLE)
+            {
+                queue.defer(view);
+                view = VK_NULL_HANDLE;
+            }
+        }
+
+        // The VmaAllocation stays ours; VMA repoints it when the pass ends
+        if (image_ != VK_NULL_HANDLE)
+        {
+            queue.defer(image_);
+        }
+        image_ = relocated;
+        ++generation_;
+
+        // Rebuild in the original order so defaultView() keeps referring to the same view
+        for (size_t i = 0; i < viewDescs_.size(); ++i)
+        {
+            views_[i] = makeView(viewDescs_[i]);
+        }
+    }
+
+    void VmaImage::refreshAllocationInfo()
+    {
+        VmaAllocationInfo info;
+        vmaGetAllocationInfo(allocator_->handle(), allocation_.handle(), &info);
+        allocationInfo_.size            = info.size;
+        allocationInfo_.memoryTypeIndex = info.memoryType;
+        allocationInfo_.mappedData      = info.pMappedData;
     }
 
     void VmaImage::transitionLayout(VkCommandBuffer cmd, VkImageLayout newLayout, const ImageSubresourceRange& range)
@@ -515,7 +726,7 @@ namespace vulkan_engine::vulkan::memory
               .format(format)
               .mipLevels(mipLevels)
               .samples(samples)
-              .usage(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT)
+              .usage(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT) // Readback
               .deviceLocal()
               .build();
     }
@@ -0,0 +1,164 @@
+#include "engine/rhi/vulkan/pipelines/LayoutCache.hpp"
+#include "engine/rhi/vulkan/utils/VulkanError.hpp"
+
+#include <algorithm>
+
+namespace vulkan_engine::vulkan
+{
+    LayoutCache::LayoutCache(std::shared_ptr<DeviceManager> device)
+        : device_(std::move(device))
+    {
+    }
+
+    LayoutCache::~LayoutCache()
+    {
+        if (!device_ || device_->device() == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        for (auto& [key, layout] : pipeline_layouts_)
+        {
+            vkDestroyPipelineLayout(device_->device(), layout, nullptr);
+        }
+        for (auto& [key, layout] : set_layouts_)
+        {
+            vkDestroyDescriptorSetLayout(device_->device(), layout, nullptr);
+        }
+    }
+
+    VkDescriptorSetLayout LayoutCache::descriptor_set_layout(const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+    {
+        std::vector<VkDescriptorSetLayoutBinding> sorted = bindings;
+        std::sort(sorted.begin(), sorted.end(), [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b)
+        {
+            return a.binding < b.binding;
+        });
+
+        std::vector<uint64_t> key;
+        key.reserve(sorted.size() * 2);
+        for (const auto& b : sorted)
+        {
+            key.push_back((static_cast<uint64_t>(b.binding) << 32) | static_cast<uint32_t>(b.descriptorType));
+            key.push_back((static_cast<uint64_t>(b.descriptorCount) << 32) | b.stageFlags);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = set_layouts_.find(key);
+        if (it != set_layouts_.end())
+        {
+            return it->second;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layout_info{};
+        layout_info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.bindingCount = static_cast<uint32_t>(sorted.size());
+        layout_info.pBindings    = sorted.data();
+
+        VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+        VkResult              result = vkCreateDescriptorSetLayout(device_->device(), &layout_info, nullptr, &layout);
+        if (result != VK_SUCCESS)
+        {
+            throw VulkanError(result, "Failed to create descriptor set layout", __FILE__, __LINE__);
+        }
+
+        set_layouts_.emplace(std::move(key), layout);
+        return layout;
+    }
+
+    VkPipelineLayout LayoutCache::pipeline_layout(
+        const std::vector<VkDescriptorSetLayout>& set_layouts,
+        const std::vector<VkPushConstantRange>&   push_constants)
+    {
+        // Set order is significant, push constant order is not
+        std::vector<VkPushConstantRange> ranges = push_constants;
+        std::sort(ranges.begin(), ranges.end(), [](const VkPushConstantRange& a, const VkPushConstantRange& b)
+        {
+            return a.offset != b.offset ? a.offset < b.offset : a.stageFlags < b.stageFlags;
+        });
+
+        std::vector<uint64_t> key;
+        key.reserve(set_layouts.size() + ranges.size() * 2 + 1);
+        key.push_back(set_layouts.size());
+        for (VkDescriptorSetLayout layout : set_layouts)
+        {
+            key.push_back(reinterpret_cast<uint64_t>(layout));
+        }
+        for (const auto& range : ranges)
+        {
+            key.push_back((static_cast<uint64_t>(range.offset) << 32) | range.size);
+            key.push_back(range.stageFlags);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = pipeline_layouts_.find(key);
+        if (it != pipeline_layouts_.end())
+        {
+            return it->second;
+        }
+
+        VkPipelineLayoutCreateInfo layout_info{};
+        layout_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_info.setLayoutCount         = static_cast<uint32_t>(set_layouts.size());
+        layout_info.pSetLayouts            = set_layouts.empty() ? nullptr : set_layouts.data();
+        layout_info.pushConstantRangeCount = static_cast<uint32_t>(ranges.size());
+        layout_info.pPushConstantRanges    = ranges.empty() ? nullptr : ranges.data();
+
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkResult         result = vkCreatePipelineLayout(device_->device(), &layout_info, nullptr, &layout);
+        if (result != VK_SUCCESS)
+        {
+            throw VulkanError(result, "Failed to create pipeline layout", __FILE__, __LINE__);
+        }
+
+        pipeline_layouts_.emplace(std::move(key), layout);
+        return layout;
+    }
+
+    VkPipelineLayout LayoutCache::pipeline_layout(
+        const ShaderReflection&                           reflection,
+        std::vector<VkDescriptorSetLayout>&               out_set_layouts,
+        const std::vector<std::pair<uint32_t, uint32_t>>& dynamic_bindings)
+    {
+        out_set_layouts.clear();
+        for (uint32_t set = 0; set < reflection.set_count(); ++set)
+        {
+            auto bindings = reflection.set_layout_bindings(set);
+            for (auto& binding : bindings)
+            {
+                bool dynamic = std::find(dynamic_bindings.begin(), dynamic_bindings.end(),
+                                         std::make_pair(set, binding.binding)) != dynamic_bindings.end();
+                if (!dynamic)
+                {
+                    continue;
+                }
+
+                if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                {
+                    binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                }
+                else if (binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                {
+                    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                }
+            }
+            out_set_layouts.push_back(descriptor_set_layout(bindings));
+        }
+
+        return pipeline_layout(out_set_layouts, reflection.push_constant_ranges());
+    }
+
+    size_t LayoutCache::descriptor_set_layout_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return set_layouts_.size();
+    }
+
+    size_t LayoutCache::pipeline_layout_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pipeline_layouts_.size();
+    }
+} // namespace vulkan_engine::vulkan
@@ -217,8 +217,8 @@ namespace vulkan_engine::vulkan
         pipeline_info.subpass             = config.subpass;
 
         // Use dynamic rendering info if no render pass
-        logger::debug("Pipeline config: render_pass=" + std::to_string(reinterpret_cast<uint64_t>(config.render_pass)) +
-                      ", color_format=" + std::to_string(config.color_format));
+        logger::debug("Pipeline config: render_pass=", reinterpret_cast<uint64_t>(config.render_pass),
+                      ", color_format=", static_cast<int>(config.color_format));
 
         if (config.render_pass == VK_NULL_HANDLE && config.color_format != VK_FORMAT_UNDEFINED)
         {
@@ -235,7 +235,7 @@ namespace vulkan_engine::vulkan
         }
         pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
 
-        VkResult result = vkCreateGraphicsPipelines(device_->device(), VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline_);
+        VkResult result = vkCreateGraphicsPipelines(device_->device(), config.pipeline_cache, 1, &pipeline_info, nullptr, &pipeline_);
         if (result != VK_SUCCESS)
         {
             throw VulkanError(result, "Failed to create graphics pipeline", __FILE__, __LINE__);
@@ -117,9 +117,8 @@ namespace vulkan_engine::vulkan
         if (render_pass != VK_NULL_HANDLE)
         {
             cache_[key] = render_pass;
-            logger::info("Created RenderPass [color: " + std::to_string(key.color_format) +
-                         ", depth: " + std::to_string(key.depth_format) +
-                         ", offscreen: " + std::to_string(key.offscreen) + "]");
+            logger::info("Created RenderPass [color: ", key.color_format, ", depth: ", key.depth_format,
+                         ", offscreen: ", key.offscreen, "]");
         }
 
         return render_pass;
@@ -1,5 +1,6 @@
 #include "engine/rhi/vulkan/pipelines/ShaderModule.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
+#include "engine/core/utils/Logger.hpp"
 #include <fstream>
 #include <cstring>
 
@@ -26,6 +27,8 @@ namespace vulkan_engine::vulkan
         {
             throw VulkanError(result, "Failed to create shader module from code", __FILE__, __LINE__);
         }
+
+        reflect(code);
     }
 
     // Create from raw bytes (handles unaligned data)
@@ -56,6 +59,8 @@ namespace vulkan_engine::vulkan
         {
             throw VulkanError(result, "Failed to create shader module from bytes", __FILE__, __LINE__);
         }
+
+        reflect(code);
     }
 
     // Create from file path
@@ -76,6 +81,8 @@ namespace vulkan_engine::vulkan
         {
             throw VulkanError(result, "Failed to create shader module from file: " + file_path, __FILE__, __LINE__);
         }
+
+        reflect(code);
     }
 
     ShaderModule::~ShaderModule()
@@ -89,6 +96,7 @@ namespace vulkan_engine::vulkan
     ShaderModule::ShaderModule(ShaderModule&& other) noexcept
         : device_(std::move(other.device_))
         , module_(other.module_)
+        , reflection_(std::move(other.reflection_))
     {
         other.module_ = VK_NULL_HANDLE;
     }
@@ -104,11 +112,25 @@ namespace vulkan_engine::vulkan
 
             device_       = std::move(other.device_);
             module_       = other.module_;
+            reflection_   = std::move(other.reflection_);
             other.module_ = VK_NULL_HANDLE;
         }
         return *this;
     }
 
+    void ShaderModule::reflect(const std::vector<uint32_t>& code)
+    {
+        // Reflection is advisory; a module the driver accepts stays usable without it
+        try
+        {
+            reflection_ = std::make_shared<const ShaderReflection>(ShaderReflection::reflect(code));
+        }
+        catch (const std::exception& e)
+        {
+            logger::warn(std::string("ShaderModule: SPIR-V reflection failed: ") + e.what());
+        }
+    }
+
     std::vector<uint32_t> ShaderModule::load_spirv_from_file(const std::string& path)
     {
         std::ifstream file(path, std::ios::binary | std::ios::ate);
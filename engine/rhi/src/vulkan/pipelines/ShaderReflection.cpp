@@ -0,0 +1,756 @@
+#include "engine/rhi/vulkan/pipelines/ShaderReflection.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace vulkan_engine::vulkan
+{
+    namespace
+    {
+        // SPIR-V constants used by the parser (see the SPIR-V specification, section 3)
+        constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
+        enum Op : uint32_t
+        {
+            OpName               = 5,
+            OpMemberName         = 6,
+            OpEntryPoint         = 15,
+            OpTypeBool           = 20,
+            OpTypeInt            = 21,
+            OpTypeFloat          = 22,
+            OpTypeVector         = 23,
+            OpTypeMatrix         = 24,
+            OpTypeImage          = 25,
+            OpTypeSampler        = 26,
+            OpTypeSampledImage   = 27,
+            OpTypeArray          = 28,
+            OpTypeRuntimeArray   = 29,
+            OpTypeStruct         = 30,
+            OpTypePointer        = 32,
+            OpConstant           = 43,
+            OpSpecConstant       = 50,
+            OpVariable           = 59,
+            OpDecorate           = 71,
+            OpMemberDecorate     = 72,
+            OpTypeAccelStructKHR = 5341
+        };
+
+        enum Decoration : uint32_t
+        {
+            DecorationBlock         = 2,
+            DecorationBufferBlock   = 3,
+            DecorationArrayStride   = 6,
+            DecorationMatrixStride  = 7,
+            DecorationBuiltIn       = 11,
+            DecorationLocation      = 30,
+            DecorationBinding       = 33,
+            DecorationDescriptorSet = 34,
+            DecorationOffset        = 35
+        };
+
+        enum StorageClass : uint32_t
+        {
+            StorageUniformConstant = 0,
+            StorageInput           = 1,
+            StorageUniform         = 2,
+            StoragePushConstant    = 9,
+            StorageStorageBuffer   = 12
+        };
+
+        enum Dim : uint32_t
+        {
+            DimBuffer      = 5,
+            DimSubpassData = 6
+        };
+
+        struct TypeInfo
+        {
+            uint32_t              op = 0;
+            std::vector<uint32_t> operands; // Instruction words after the result id
+        };
+
+        struct MemberDecorations
+        {
+            uint32_t offset        = UINT32_MAX;
+            uint32_t matrix_stride = 0;
+            bool     builtin       = false;
+        };
+
+        struct IdDecorations
+        {
+            uint32_t set          = UINT32_MAX;
+            uint32_t binding      = UINT32_MAX;
+            uint32_t location     = UINT32_MAX;
+            uint32_t array_stride = 0;
+            bool     block        = false;
+            bool     buffer_block = false;
+            bool     builtin      = false;
+
+            std::unordered_map<uint32_t, MemberDecorations> members;
+        };
+
+        struct Variable
+        {
+            uint32_t id;
+            uint32_t pointer_type;
+            uint32_t storage_class;
+        };
+
+        std::string read_string(const uint32_t* words, size_t word_count)
+        {
+            std::string result;
+            for (size_t i = 0; i < word_count; ++i)
+            {
+                for (int b = 0; b < 4; ++b)
+                {
+                    char c = static_cast<char>((words[i] >> (b * 8)) & 0xFF);
+                    if (c == '\0')
+                    {
+                        return result;
+                    }
+                    result.push_back(c);
+                }
+            }
+            return result;
+        }
+
+        VkShaderStageFlags execution_model_to_stage(uint32_t model)
+        {
+            switch (model)
+            {
+                case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+                case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+                case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+                case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+                case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+                case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+                default: return 0;
+            }
+        }
+
+        class SpirvParser
+        {
+            public:
+                explicit SpirvParser(const std::vector<uint32_t>& code)
+                    : code_(code)
+                {
+                }
+
+                ShaderReflection parse()
+                {
+                    if (code_.size() < 5 || code_[0] != SPIRV_MAGIC)
+                    {
+                        throw std::runtime_error("Invalid SPIR-V module (bad header)");
+                    }
+
+                    scan_instructions();
+
+                    ShaderReflection reflection;
+                    reflection.stages      = stages_;
+                    reflection.entry_point = entry_point_;
+
+                    for (const auto& var : variables_)
+                    {
+                        reflect_variable(var, reflection);
+                    }
+
+                    std::sort(reflection.bindings.begin(), reflection.bindings.end(),
+                              [](const ShaderResourceBinding& a, const ShaderResourceBinding& b)
+                              {
+                                  return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+                              });
+                    std::sort(reflection.vertex_inputs.begin(), reflection.vertex_inputs.end(),
+                              [](const ShaderVertexInput& a, const ShaderVertexInput& b)
+                              {
+                                  return a.location < b.location;
+                              });
+
+                    return reflection;
+                }
+
+            private:
+                const std::vector<uint32_t>& code_;
+
+                VkShaderStageFlags stages_ = 0;
+                std::string        entry_point_;
+                bool               has_vertex_entry_ = false;
+
+                std::unordered_map<uint32_t, TypeInfo>                                  types_;
+                std::unordered_map<uint32_t, uint32_t>                                  constants_;
+                std::unordered_map<uint32_t, std::string>                               names_;
+                std::unordered_map<uint32_t, std::unordered_map<uint32_t, std::string>> member_names_;
+                std::unordered_map<uint32_t, IdDecorations>                             decorations_;
+                std::vector<Variable>                                                   variables_;
+
+                void scan_instructions()
+                {
+                    size_t pos = 5;
+                    while (pos < code_.size())
+                    {
+                        uint32_t word_count = code_[pos] >> 16;
+                        uint32_t opcode     = code_[pos] & 0xFFFF;
+                        if (word_count == 0 || pos + word_count > code_.size())
+                        {
+                            throw std::runtime_error("Invalid SPIR-V module (truncated instruction)");
+                        }
+
+                        const uint32_t* ops   = &code_[pos + 1];
+                        uint32_t        nops  = word_count - 1;
+                        handle_instruction(opcode, ops, nops);
+                        pos += word_count;
+                    }
+                }
+
+                void handle_instruction(uint32_t opcode, const uint32_t* ops, uint32_t nops)
+                {
+                    switch (opcode)
+                    {
+                        case OpEntryPoint:
+                            if (nops >= 3)
+                            {
+                                VkShaderStageFlags stage = execution_model_to_stage(ops[0]);
+                                stages_ |= stage;
+                                has_vertex_entry_ |= (stage == VK_SHADER_STAGE_VERTEX_BIT);
+                                if (entry_point_.empty())
+                                {
+                                    entry_point_ = read_string(ops + 2, nops - 2);
+                                }
+                            }
+                            break;
+
+                        case OpName:
+                            if (nops >= 2)
+                            {
+                                names_[ops[0]] = read_string(ops + 1, nops - 1);
+                            }
+                            break;
+
+                        case OpMemberName:
+                            if (nops >= 3)
+                            {
+                                member_names_[ops[0]][ops[1]] = read_string(ops + 2, nops - 2);
+                            }
+                            break;
+
+                        case OpDecorate:
+                            if (nops >= 2)
+                            {
+                                handle_decoration(decorations_[ops[0]], ops[1], nops > 2 ? ops[2] : 0);
+                            }
+                            break;
+
+                        case OpMemberDecorate:
+                            if (nops >= 3)
+                            {
+                                auto& member = decorations_[ops[0]].members[ops[1]];
+                                if (ops[2] == DecorationOffset && nops > 3)
+                                {
+                                    member.offset = ops[3];
+                                }
+                                else if (ops[2] == DecorationMatrixStride && nops > 3)
+                                {
+                                    member.matrix_stride = ops[3];
+                                }
+                                else if (ops[2] == DecorationBuiltIn)
+                                {
+                                    member.builtin = true;
+                                }
+                            }
+                            break;
+
+                        case OpTypeBool:
+                        case OpTypeInt:
+                        case OpTypeFloat:
+                        case OpTypeVector:
+                        case OpTypeMatrix:
+                        case OpTypeImage:
+                        case OpTypeSampler:
+                        case OpTypeSampledImage:
+                        case OpTypeArray:
+                        case OpTypeRuntimeArray:
+                        case OpTypeStruct:
+                        case OpTypePointer:
+                        case OpTypeAccelStructKHR:
+                            if (nops >= 1)
+                            {
+                                types_[ops[0]] = {opcode, std::vector<uint32_t>(ops + 1, ops + nops)};
+                            }
+                            break;
+
+                        case OpConstant:
+                        case OpSpecConstant:
+                            if (nops >= 3)
+                            {
+                                constants_[ops[1]] = ops[2]; // Low word is enough for array lengths
+                            }
+                            break;
+
+                        case OpVariable:
+                            if (nops >= 3)
+                            {
+                                variables_.push_back({ops[1], ops[0], ops[2]});
+                            }
+                            break;
+
+                        default:
+                            break;
+                    }
+                }
+
+                static void handle_decoration(IdDecorations& deco, uint32_t decoration, uint32_t value)
+                {
+                    switch (decoration)
+                    {
+                        case DecorationBlock: deco.block = true;
+                            break;
+                        case DecorationBufferBlock: deco.buffer_block = true;
+                            break;
+                        case DecorationArrayStride: deco.array_stride = value;
+                            break;
+                        case DecorationBuiltIn: deco.builtin = true;
+                            break;
+                        case DecorationLocation: deco.location = value;
+                            break;
+                        case DecorationBinding: deco.binding = value;
+                            break;
+                        case DecorationDescriptorSet: deco.set = value;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                const TypeInfo& type(uint32_t id) const
+                {
+                    auto it = types_.find(id);
+                    if (it == types_.end())
+                    {
+                        throw std::runtime_error("Invalid SPIR-V module (unknown type id " + std::to_string(id) + ")");
+                    }
+                    return it->second;
+                }
+
+                const IdDecorations* decorations(uint32_t id) const
+                {
+                    auto it = decorations_.find(id);
+                    return it != decorations_.end() ? &it->second : nullptr;
+                }
+
+                std::string name_of(uint32_t id) const
+                {
+                    auto it = names_.find(id);
+                    return it != names_.end() ? it->second : std::string{};
+                }
+
+                // Strip arrays, returning the element type and the element count (0 = runtime array)
+                uint32_t unwrap_arrays(uint32_t type_id, uint32_t& count) const
+                {
+                    count = 1;
+                    for (;;)
+                    {
+                        const TypeInfo& info = type(type_id);
+                        if (info.op == OpTypeArray)
+                        {
+                            auto it = constants_.find(info.operands[1]);
+                            count *= (it != constants_.end()) ? it->second : 1;
+                            type_id = info.operands[0];
+                        }
+                        else if (info.op == OpTypeRuntimeArray)
+                        {
+                            count   = 0;
+                            type_id = info.operands[0];
+                        }
+                        else
+                        {
+                            return type_id;
+                        }
+                    }
+                }
+
+                // Size in bytes of a type as laid out in a block (explicit strides where present)
+                uint32_t type_size(uint32_t type_id, uint32_t matrix_stride = 0) const
+                {
+                    const TypeInfo& info = type(type_id);
+                    switch (info.op)
+                    {
+                        case OpTypeBool:
+                            return 4;
+                        case OpTypeInt:
+                        case OpTypeFloat:
+                            return info.operands[0] / 8;
+                        case OpTypeVector:
+                            return type_size(info.operands[0]) * info.operands[1];
+                        case OpTypeMatrix:
+                        {
+                            uint32_t column_size = matrix_stride ? matrix_stride : type_size(info.operands[0]);
+                            return column_size * info.operands[1];
+                        }
+                        case OpTypeArray:
+                        {
+                            auto     it     = constants_.find(info.operands[1]);
+                            uint32_t length = (it != constants_.end()) ? it->second : 1;
+                            auto*    deco   = decorations(type_id);
+                            uint32_t stride = (deco && deco->array_stride) ? deco->array_stride : type_size(info.operands[0]);
+                            return stride * length;
+                        }
+                        case OpTypeRuntimeArray:
+                            return 0;
+                        case OpTypeStruct:
+                            return struct_size(type_id, nullptr);
+                        default:
+                            return 0;
+                    }
+                }
+
+                uint32_t struct_size(uint32_t struct_id, std::vector<ShaderBlockMember>* members) const
+                {
+                    const TypeInfo& info = type(struct_id);
+                    auto*           deco = decorations(struct_id);
+
+                    uint32_t size        = 0;
+                    uint32_t next_offset = 0;
+                    for (uint32_t i = 0; i < info.operands.size(); ++i)
+                    {
+                        const MemberDecorations* member_deco = nullptr;
+                        if (deco)
+                        {
+                            auto it = deco->members.find(i);
+                            if (it != deco->members.end())
+                            {
+                                member_deco = &it->second;
+                            }
+                        }
+
+                        uint32_t offset = (member_deco && member_deco->offset != UINT32_MAX) ? member_deco->offset : next_offset;
+                        uint32_t msize  = type_size(info.operands[i], member_deco ? member_deco->matrix_stride : 0);
+                        next_offset     = offset + msize;
+                        size            = std::max(size, next_offset);
+
+                        if (members)
+                        {
+                            std::string member_name;
+                            auto        names = member_names_.find(struct_id);
+                            if (names != member_names_.end())
+                            {
+                                auto it = names->second.find(i);
+                                if (it != names->second.end())
+                                {
+                                    member_name = it->second;
+                                }
+                            }
+                            members->push_back({member_name, offset, msize});
+                        }
+                    }
+                    return size;
+                }
+
+                VkFormat vertex_format(uint32_t type_id) const
+                {
+                    const TypeInfo& info       = type(type_id);
+                    uint32_t        components = 1;
+                    uint32_t        scalar_id  = type_id;
+                    if (info.op == OpTypeVector)
+                    {
+                        scalar_id  = info.operands[0];
+                        components = info.operands[1];
+                    }
+
+                    const TypeInfo& scalar = type(scalar_id);
+                    if (scalar.operands.empty() || scalar.operands[0] != 32 || components < 1 || components > 4)
+                    {
+                        return VK_FORMAT_UNDEFINED;
+                    }
+
+                    static constexpr VkFormat float_formats[] = {
+                        VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT
+                    };
+                    static constexpr VkFormat sint_formats[] = {
+                        VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT
+                    };
+                    static constexpr VkFormat uint_formats[] = {
+                        VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT
+                    };
+
+                    if (scalar.op == OpTypeFloat)
+                    {
+                        return float_formats[components - 1];
+                    }
+                    if (scalar.op == OpTypeInt)
+                    {
+                        bool is_signed = scalar.operands.size() > 1 && scalar.operands[1] != 0;
+                        return is_signed ? sint_formats[components - 1] : uint_formats[components - 1];
+                    }
+                    return VK_FORMAT_UNDEFINED;
+                }
+
+                VkDescriptorType descriptor_type(uint32_t storage_class, uint32_t type_id) const
+                {
+                    const TypeInfo& info = type(type_id);
+                    auto*           deco = decorations(type_id);
+
+                    if (storage_class == StorageStorageBuffer)
+                    {
+                        return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                    }
+                    if (storage_class == StorageUniform)
+                    {
+                        return (deco && deco->buffer_block) ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                    }
+
+                    switch (info.op)
+                    {
+                        case OpTypeSampler:
+                            return VK_DESCRIPTOR_TYPE_SAMPLER;
+                        case OpTypeSampledImage:
+                            return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                        case OpTypeImage:
+                        {
+                            uint32_t dim     = info.operands[1];
+                            uint32_t sampled = info.operands[5];
+                            if (dim == DimBuffer)
+                            {
+                                return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                            }
+                            if (dim == DimSubpassData)
+                            {
+                                return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                            }
+                            return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                        }
+                        default:
+                            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+                    }
+                }
+
+                void reflect_variable(const Variable& var, ShaderReflection& reflection) const
+                {
+                    const TypeInfo& pointer = type(var.pointer_type);
+                    if (pointer.op != OpTypePointer || pointer.operands.size() < 2)
+                    {
+                        return;
+                    }
+                    uint32_t pointee = pointer.operands[1];
+                    auto*    deco    = decorations(var.id);
+
+                    switch (var.storage_class)
+                    {
+                        case StorageUniformConstant:
+                        case StorageUniform:
+                        case StorageStorageBuffer:
+                        {
+                            if (!deco || deco->binding == UINT32_MAX)
+                            {
+                                return;
+                            }
+
+                            ShaderResourceBinding binding;
+                            uint32_t              element = unwrap_arrays(pointee, binding.count);
+                            binding.descriptor_type       = descriptor_type(var.storage_class, element);
+                            if (binding.descriptor_type == VK_DESCRIPTOR_TYPE_MAX_ENUM)
+                            {
+                                return;
+                            }
+
+                            binding.name    = name_of(var.id);
+                            binding.set     = deco->set == UINT32_MAX ? 0 : deco->set;
+                            binding.binding = deco->binding;
+                            binding.stages  = stages_;
+
+                            if (type(element).op == OpTypeStruct)
+                            {
+                                binding.block_size = struct_size(element, &binding.members);
+                                if (binding.name.empty())
+                                {
+                                    binding.name = name_of(element);
+                                }
+                            }
+
+                            reflection.bindings.push_back(std::move(binding));
+                            break;
+                        }
+
+                        case StoragePushConstant:
+                        {
+                            if (type(pointee).op != OpTypeStruct)
+                            {
+                                return;
+                            }
+
+                            ShaderPushConstantBlock block;
+                            block.name        = name_of(var.id);
+                            uint32_t end      = struct_size(pointee, &block.members);
+                            uint32_t begin    = end;
+                            for (const auto& member : block.members)
+                            {
+                                begin = std::min(begin, member.offset);
+                            }
+                            block.range.stageFlags = stages_;
+                            block.range.offset     = begin;
+                            block.range.size       = end - begin;
+
+                            reflection.push_constants.push_back(std::move(block));
+                            break;
+                        }
+
+                        case StorageInput:
+                        {
+                            if (!has_vertex_entry_ || !deco || deco->builtin || deco->location == UINT32_MAX)
+                            {
+                                return;
+                            }
+
+                            const TypeInfo& info = type(pointee);
+                            if (info.op == OpTypeMatrix)
+                            {
+                                // Matrices take one location per column
+                                VkFormat column_format = vertex_format(info.operands[0]);
+                                for (uint32_t c = 0; c < info.operands[1]; ++c)
+                                {
+                                    reflection.vertex_inputs.push_back({name_of(var.id), deco->location + c, column_format});
+                                }
+                                return;
+                            }
+
+                            reflection.vertex_inputs.push_back({name_of(var.id), deco->location, vertex_format(pointee)});
+                            break;
+                        }
+
+                        default:
+                            break;
+                    }
+                }
+        };
+    } // namespace
+
+    ShaderReflection ShaderReflection::reflect(const std::vector<uint32_t>& spirv)
+    {
+        return SpirvParser(spirv).parse();
+    }
+
+    void ShaderReflection::merge(const ShaderReflection& other)
+    {
+        stages |= other.stages;
+
+        for (const auto& binding : other.bindings)
+        {
+            auto it = std::find_if(bindings.begin(), bindings.end(), [&](const ShaderResourceBinding& b)
+            {
+                return b.set == binding.set && b.binding == binding.binding;
+            });
+
+            if (it == bindings.end())
+            {
+                bindings.push_back(binding);
+                continue;
+            }
+
+            if (it->descriptor_type != binding.descriptor_type)
+            {
+                throw std::runtime_error("Shader stages disagree on descriptor type of set " + std::to_string(binding.set) +
+                                         " binding " + std::to_string(binding.binding));
+            }
+
+            it->stages |= binding.stages;
+            it->count = std::max(it->count, binding.count);
+            if (binding.block_size > it->block_size)
+            {
+                it->block_size = binding.block_size;
+                it->members    = binding.members;
+            }
+        }
+
+        std::sort(bindings.begin(), bindings.end(), [](const ShaderResourceBinding& a, const ShaderResourceBinding& b)
+        {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+
+        for (const auto& block : other.push_constants)
+        {
+            auto it = std::find_if(push_constants.begin(), push_constants.end(), [&](const ShaderPushConstantBlock& p)
+            {
+                return p.range.offset == block.range.offset && p.range.size == block.range.size;
+            });
+
+            if (it != push_constants.end())
+            {
+                it->range.stageFlags |= block.range.stageFlags;
+            }
+            else
+            {
+                push_constants.push_back(block);
+            }
+        }
+
+        if (vertex_inputs.empty())
+        {
+            vertex_inputs = other.vertex_inputs;
+        }
+    }
+
+    const ShaderResourceBinding* ShaderReflection::find_binding(uint32_t set, uint32_t binding) const
+    {
+        for (const auto& b : bindings)
+        {
+            if (b.set == set && b.binding == binding)
+            {
+                return &b;
+            }
+        }
+        return nullptr;
+    }
+
+    const ShaderResourceBinding* ShaderReflection::find_binding(const std::string& name) const
+    {
+        for (const auto& b : bindings)
+        {
+            if (b.name == name)
+            {
+                return &b;
+            }
+        }
+        return nullptr;
+    }
+
+    uint32_t ShaderReflection::set_count() const
+    {
+        uint32_t count = 0;
+        for (const auto& b : bindings)
+        {
+            count = std::max(count, b.set + 1);
+        }
+        return count;
+    }
+
+    std::vector<VkDescriptorSetLayoutBinding> ShaderReflection::set_layout_bindings(uint32_t set) const
+    {
+        std::vector<VkDescriptorSetLayoutBinding> result;
+        for (const auto& b : bindings)
+        {
+            if (b.set != set)
+            {
+                continue;
+            }
+
+            VkDescriptorSetLayoutBinding layout_binding{};
+            layout_binding.binding            = b.binding;
+            layout_binding.descriptorType     = b.descriptor_type;
+            layout_binding.descriptorCount    = b.count == 0 ? 1 : b.count;
+            layout_binding.stageFlags         = b.stages;
+            layout_binding.pImmutableSamplers = nullptr;
+            result.push_back(layout_binding);
+        }
+        return result;
+    }
+
+    std::vector<VkPushConstantRange> ShaderReflection::push_constant_ranges() const
+    {
+        std::vector<VkPushConstantRange> result;
+        result.reserve(push_constants.size());
+        for (const auto& block : push_constants)
+        {
+            result.push_back(block.range);
+        }
+        return result;
+    }
+} // namespace vulkan_engine::vulkan
@@ -1,4 +1,6 @@
 #include "engine/rhi/vulkan/resources/Buffer.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include <cstring>
 
@@ -17,99 +19,119 @@ namespace vulkan_engine::vulkan
             throw std::runtime_error("Buffer: DeviceManager is null");
         }
 
-        // Create buffer
-        VkBufferCreateInfo buffer_info{};
-        buffer_info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_info.size        = size;
-        buffer_info.usage       = usage;
-        buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-        VkResult result = vkCreateBuffer(device_->device(), &buffer_info, nullptr, &buffer_);
-        if (result != VK_SUCCESS)
+        resource_manager_ = device_->resource_manager();
+        if (!resource_manager_)
         {
-            throw VulkanError(result, "Failed to create buffer", __FILE__, __LINE__);
+            throw std::runtime_error("Buffer: no memory::ResourceManager attached to the DeviceManager");
         }
 
-        // RAII guard for exception safety
-        struct BufferGuard
+        allocation_ = resource_manager_->createPooledBuffer(size, usage, properties);
+    }
+
+    Buffer::~Buffer()
+    {
+        release();
+    }
+
+    Buffer::Buffer(Buffer&& other) noexcept
+        : device_(std::move(other.device_))
+        , resource_manager_(std::move(other.resource_manager_))
+        , allocation_(std::move(other.allocation_))
+        , size_(other.size_)
+        , mapped_data_(other.mapped_data_)
+    {
+        other.size_        = 0;
+        other.mapped_data_ = nullptr;
+    }
+
+    Buffer& Buffer::operator=(Buffer&& other) noexcept
+    {
+        if (this != &other)
         {
-            VkDevice  device;
-            VkBuffer* buffer;
-
-            ~BufferGuard()
-            {
-                if (buffer && *buffer != VK_NULL_HANDLE)
-                {
-                    vkDestroyBuffer(device, *buffer, nullptr);
-                }
-            }
-        } guard{device_->device(), &buffer_};
-
-        // Get memory requirements
-        VkMemoryRequirements mem_requirements;
-        vkGetBufferMemoryRequirements(device_->device(), buffer_, &mem_requirements);
-
-        // Allocate memory
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize  = mem_requirements.size;
-        alloc_info.memoryTypeIndex = device_->find_memory_type(mem_requirements.memoryTypeBits, properties);
-
-        result = vkAllocateMemory(device_->device(), &alloc_info, nullptr, &memory_);
-        if (result != VK_SUCCESS)
+            release();
+            device_            = std::move(other.device_);
+            resource_manager_  = std::move(other.resource_manager_);
+            allocation_        = std::move(other.allocation_);
+            size_              = other.size_;
+            mapped_data_       = other.mapped_data_;
+            other.size_        = 0;
+            other.mapped_data_ = nullptr;
+        }
+        return *this;
+    }
+
+    void Buffer::release() noexcept
+    {
+        if (!allocation_)
         {
-            throw VulkanError(result, "Failed to allocate buffer memory", __FILE__, __LINE__);
+            return;
         }
 
-        // Bind memory to buffer
-        result = vkBindBufferMemory(device_->device(), buffer_, memory_, 0);
-        if (result != VK_SUCCESS)
+        if (mapped_data_)
         {
-            vkFreeMemory(device_->device(), memory_, nullptr);
-            memory_ = VK_NULL_HANDLE;
-            throw VulkanError(result, "Failed to bind buffer memory", __FILE__, __LINE__);
+            allocation_->unmap();
+            mapped_data_ = nullptr;
         }
 
-        // Success - disable guard cleanup
-        guard.buffer = nullptr;
+        // The manager keeps the VmaBuffer alive until told otherwise
+        resource_manager_->destroyBuffer(std::move(allocation_));
     }
 
-    Buffer::~Buffer()
+    void Buffer::retire(DeletionQueue& queue)
     {
-        if (buffer_ != VK_NULL_HANDLE)
+        if (!allocation_)
         {
-            vkDestroyBuffer(device_->device(), buffer_, nullptr);
+            return;
         }
-        if (memory_ != VK_NULL_HANDLE)
+
+        if (mapped_data_)
         {
-            vkFreeMemory(device_->device(), memory_, nullptr);
+            allocation_->unmap();
+            mapped_data_ = nullptr;
         }
+        allocation_->retire(queue);
+        resource_manager_->destroyBuffer(std::move(allocation_));
     }
 
     void* Buffer::map()
     {
-        void* data;
-        vkMapMemory(device_->device(), memory_, 0, size_, 0, &data);
-        return data;
+        if (!mapped_data_)
+        {
+            mapped_data_ = allocation_->map();
+        }
+        return mapped_data_;
     }
 
     void Buffer::unmap()
     {
-        vkUnmapMemory(device_->device(), memory_);
+        if (mapped_data_)
+        {
+            allocation_->unmap();
+            mapped_data_ = nullptr;
+        }
     }
 
     void Buffer::write(const void* data, VkDeviceSize size, VkDeviceSize offset)
     {
-        void* mapped = map();
+        // Leave a mapping made by the caller in place
+        const bool was_mapped = is_mapped();
+        void*      mapped     = map();
         memcpy(static_cast<char*>(mapped) + offset, data, static_cast<size_t>(size));
-        unmap();
+        if (!was_mapped)
+        {
+            unmap();
+        }
     }
 
     void Buffer::read(void* data, VkDeviceSize size, VkDeviceSize offset)
     {
-        void* mapped = map();
+        const bool was_mapped = is_mapped();
+        void*      mapped     = map();
         memcpy(data, static_cast<char*>(mapped) + offset, static_cast<size_t>(size));
-        unmap();
+        if (!was_mapped)
+        {
+            unmap();
+        }
     }
 
     void Buffer::copy_from(const Buffer& source, VkDeviceSize size, VkDeviceSize src_offset, VkDeviceSize dst_offset)
@@ -125,22 +147,13 @@ namespace vulkan_engine::vulkan
 
     void Buffer::flush(VkDeviceSize size, VkDeviceSize offset)
     {
-        VkMappedMemoryRange memory_range{};
-        memory_range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        memory_range.memory = memory_;
-        memory_range.offset = offset;
-        memory_range.size   = size;
-        vkFlushMappedMemoryRanges(device_->device(), 1, &memory_range);
+        // Offsets are relative to the buffer; VMA translates them into the shared block
+        allocation_->flush(offset, size);
     }
 
     void Buffer::invalidate(VkDeviceSize size, VkDeviceSize offset)
     {
-        VkMappedMemoryRange memory_range{};
-        memory_range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        memory_range.memory = memory_;
-        memory_range.offset = offset;
-        memory_range.size   = size;
-        vkInvalidateMappedMemoryRanges(device_->device(), 1, &memory_range);
+        allocation_->invalidate(offset, size);
     }
 
     // BufferBuilder implementation
@@ -224,14 +237,14 @@ namespace vulkan_engine::vulkan
     std::shared_ptr<Buffer> BufferManager::create_vertex_buffer(VkDeviceSize size)
     {
         return create_buffer(size,
-                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     }
 
     std::shared_ptr<Buffer> BufferManager::create_index_buffer(VkDeviceSize size)
     {
         return create_buffer(size,
-                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     }
 
@@ -1,6 +1,9 @@
 #include "engine/rhi/vulkan/resources/DepthBuffer.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include <algorithm>
+#include <stdexcept>
 
 namespace vulkan_engine::vulkan
 {
@@ -19,32 +22,21 @@ namespace vulkan_engine::vulkan
 
     DepthBuffer::~DepthBuffer()
     {
-        if (view_ != VK_NULL_HANDLE)
-        {
-            vkDestroyImageView(device_->device(), view_, nullptr);
-        }
-        if (image_ != VK_NULL_HANDLE)
-        {
-            vkDestroyImage(device_->device(), image_, nullptr);
-        }
-        if (memory_ != VK_NULL_HANDLE)
-        {
-            vkFreeMemory(device_->device(), memory_, nullptr);
-        }
+        release();
     }
 
     DepthBuffer::DepthBuffer(DepthBuffer&& other) noexcept
         : device_(std::move(other.device_))
+        , resource_manager_(std::move(other.resource_manager_))
+        , allocation_(std::move(other.allocation_))
         , image_(other.image_)
         , view_(other.view_)
-        , memory_(other.memory_)
         , format_(other.format_)
         , width_(other.width_)
         , height_(other.height_)
     {
-        other.image_  = VK_NULL_HANDLE;
-        other.view_   = VK_NULL_HANDLE;
-        other.memory_ = VK_NULL_HANDLE;
+        other.image_ = VK_NULL_HANDLE;
+        other.view_  = VK_NULL_HANDLE;
     }
 
     DepthBuffer& DepthBuffer::operator=(DepthBuffer&& other) noexcept
@@ -52,33 +44,50 @@ namespace vulkan_engine::vulkan
         if (this != &other)
         {
             // Cleanup existing
-            if (view_ != VK_NULL_HANDLE)
+            release();
+
+            // Move
+            device_           = std::move(other.device_);
+            resource_manager_ = std::move(other.resource_manager_);
+            allocation_       = std::move(other.allocation_);
+            image_            = other.image_;
+            view_             = other.view_;
+            format_           = other.format_;
+            width_            = other.width_;
+            height_           = other.height_;
+
+            other.image_ = VK_NULL_HANDLE;
+            other.view_  = VK_NULL_HANDLE;
+        }
+        return *this;
+    }
+
+    void DepthBuffer::release() noexcept
+    {
+        // Recreated on resize while earlier frames may still render into it, so
+        // hand the view and image to the deletion queue when there is one
+        DeletionQueue* deletion_queue = device_ ? device_->deletion_queue() : nullptr;
+        if (view_ != VK_NULL_HANDLE)
+        {
+            if (deletion_queue)
             {
-                vkDestroyImageView(device_->device(), view_, nullptr);
+                deletion_queue->defer(view_);
             }
-            if (image_ != VK_NULL_HANDLE)
+            else
             {
-                vkDestroyImage(device_->device(), image_, nullptr);
+                vkDestroyImageView(device_->device(), view_, nullptr);
             }
-            if (memory_ != VK_NULL_HANDLE)
+            view_ = VK_NULL_HANDLE;
+        }
+        if (allocation_)
+        {
+            if (deletion_queue)
             {
-                vkFreeMemory(device_->device(), memory_, nullptr);
+                allocation_->retire(*deletion_queue);
             }
-
-            // Move
-            device_ = std::move(other.device_);
-            image_  = other.image_;
-            view_   = other.view_;
-            memory_ = other.memory_;
-            format_ = other.format_;
-            width_  = other.width_;
-            height_ = other.height_;
-
-            other.image_  = VK_NULL_HANDLE;
-            other.view_   = VK_NULL_HANDLE;
-            other.memory_ = VK_NULL_HANDLE;
+            resource_manager_->destroyImage(std::move(allocation_));
         }
-        return *this;
+        image_ = VK_NULL_HANDLE;
     }
 
     VkFormat DepthBuffer::find_depth_format(std::shared_ptr<DeviceManager> device)
@@ -123,32 +132,15 @@ namespace vulkan_engine::vulkan
         image_info.samples       = VK_SAMPLE_COUNT_1_BIT;
         image_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
 
-        VkResult result = vkCreateImage(device_->device(), &image_info, nullptr, &image_);
-        if (result != VK_SUCCESS)
-        {
-            throw VulkanError(result, "Failed to create depth image", __FILE__, __LINE__);
-        }
-
-        // Get memory requirements
-        VkMemoryRequirements mem_requirements;
-        vkGetImageMemoryRequirements(device_->device(), image_, &mem_requirements);
-
-        // Allocate memory
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize  = mem_requirements.size;
-        alloc_info.memoryTypeIndex = device_->find_memory_type(
-                                                               mem_requirements.memoryTypeBits,
-                                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-        result = vkAllocateMemory(device_->device(), &alloc_info, nullptr, &memory_);
-        if (result != VK_SUCCESS)
+        resource_manager_ = device_->resource_manager();
+        if (!resource_manager_)
         {
-            throw VulkanError(result, "Failed to allocate depth image memory", __FILE__, __LINE__);
+            throw std::runtime_error("DepthBuffer: no memory::ResourceManager attached to the DeviceManager");
         }
 
-        // Bind memory to image
-        vkBindImageMemory(device_->device(), image_, memory_, 0);
+        // Resized with the swapchain, so it shares RenderTarget blocks instead of owning memory
+        allocation_ = resource_manager_->createPooledImage(image_info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        image_      = allocation_->handle();
     }
 
     void DepthBuffer::create_view()
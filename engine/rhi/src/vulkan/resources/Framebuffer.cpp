@@ -1,4 +1,5 @@
 #include "engine/rhi/vulkan/resources/Framebuffer.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include "engine/core/utils/Logger.hpp"
 
@@ -44,14 +45,12 @@ namespace vulkan_engine::vulkan
     {
         if (framebuffer_ != VK_NULL_HANDLE && device_)
         {
-            logger::debug("Destroying VkFramebuffer: " + std::to_string(reinterpret_cast<uint64_t>(framebuffer_)));
-            vkDestroyFramebuffer(device_->device(), framebuffer_, nullptr);
-            framebuffer_ = VK_NULL_HANDLE;
+            logger::debug("Destroying VkFramebuffer: ", reinterpret_cast<uint64_t>(framebuffer_));
+            destroy_framebuffer();
         }
         else if (framebuffer_ != VK_NULL_HANDLE)
         {
-            logger::error("VkFramebuffer " + std::to_string(reinterpret_cast<uint64_t>(framebuffer_)) +
-                          " leaked! Device is null.");
+            logger::error("VkFramebuffer ", reinterpret_cast<uint64_t>(framebuffer_), " leaked! Device is null.");
         }
     }
 
@@ -72,7 +71,7 @@ namespace vulkan_engine::vulkan
         {
             if (framebuffer_ != VK_NULL_HANDLE && device_)
             {
-                vkDestroyFramebuffer(device_->device(), framebuffer_, nullptr);
+                destroy_framebuffer();
             }
 
             device_      = std::move(other.device_);
@@ -87,6 +86,20 @@ namespace vulkan_engine::vulkan
         return *this;
     }
 
+    void Framebuffer::destroy_framebuffer()
+    {
+        // Frames in flight may still reference it; let the deletion queue retire it
+        if (DeletionQueue* deletion_queue = device_->deletion_queue())
+        {
+            deletion_queue->defer(framebuffer_);
+        }
+        else
+        {
+            vkDestroyFramebuffer(device_->device(), framebuffer_, nullptr);
+        }
+        framebuffer_ = VK_NULL_HANDLE;
+    }
+
     void Framebuffer::create_framebuffer(
         VkRenderPass                    render_pass,
         const std::vector<VkImageView>& attachments)
@@ -111,8 +124,8 @@ namespace vulkan_engine::vulkan
             throw VulkanError(result, "Failed to create framebuffer", __FILE__, __LINE__);
         }
 
-        logger::debug("Created VkFramebuffer: " + std::to_string(reinterpret_cast<uint64_t>(framebuffer_)) +
-                      " (width=" + std::to_string(width_) + ", height=" + std::to_string(height_) + ")");
+        logger::debug("Created VkFramebuffer: ", reinterpret_cast<uint64_t>(framebuffer_),
+                      " (width=", width_, ", height=", height_, ")");
     }
 
     // FramebufferBuilder implementation
@@ -216,7 +229,7 @@ namespace vulkan_engine::vulkan
 
     void FramebufferPool::clear()
     {
-        logger::debug("Clearing FramebufferPool, contains " + std::to_string(framebuffers_.size()) + " framebuffers");
+        logger::debug("Clearing FramebufferPool, contains ", framebuffers_.size(), " framebuffers");
         framebuffers_.clear();
         logger::debug("FramebufferPool cleared");
     }
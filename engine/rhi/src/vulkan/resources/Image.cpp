@@ -1,4 +1,6 @@
 #include "engine/rhi/vulkan/resources/Image.hpp"
+#include "engine/rhi/vulkan/memory/ResourceManager.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include <stdexcept>
 
 namespace vulkan_engine::vulkan
@@ -35,28 +37,13 @@ namespace vulkan_engine::vulkan
         image_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
         image_info.samples       = VK_SAMPLE_COUNT_1_BIT;
 
-        if (vkCreateImage(device_->device(), &image_info, nullptr, &image_) != VK_SUCCESS)
+        resource_manager_ = device_->resource_manager();
+        if (!resource_manager_)
         {
-            throw std::runtime_error("Failed to create image");
+            throw std::runtime_error("Image: no memory::ResourceManager attached to the DeviceManager");
         }
 
-        // Get memory requirements
-        VkMemoryRequirements mem_requirements;
-        vkGetImageMemoryRequirements(device_->device(), image_, &mem_requirements);
-
-        // Allocate memory
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize  = mem_requirements.size;
-        alloc_info.memoryTypeIndex = device_->find_memory_type(mem_requirements.memoryTypeBits, properties);
-
-        if (vkAllocateMemory(device_->device(), &alloc_info, nullptr, &memory_) != VK_SUCCESS)
-        {
-            throw std::runtime_error("Failed to allocate image memory");
-        }
-
-        // Bind memory to image
-        vkBindImageMemory(device_->device(), image_, memory_, 0);
+        allocation_ = resource_manager_->createPooledImage(image_info, properties);
 
         // Create default image view (whole image)
         create_view(VK_IMAGE_VIEW_TYPE_2D, format, {VK_IMAGE_ASPECT_COLOR_BIT, 0, mip_levels, 0, array_layers});
@@ -64,61 +51,48 @@ namespace vulkan_engine::vulkan
 
     Image::~Image()
     {
-        if (view_ != VK_NULL_HANDLE)
-        {
-            vkDestroyImageView(device_->device(), view_, nullptr);
-        }
-        if (image_ != VK_NULL_HANDLE)
+        // The view goes with the allocation
+        if (allocation_)
         {
-            vkDestroyImage(device_->device(), image_, nullptr);
-        }
-        if (memory_ != VK_NULL_HANDLE)
-        {
-            vkFreeMemory(device_->device(), memory_, nullptr);
+            resource_manager_->destroyImage(std::move(allocation_));
         }
     }
 
-    void Image::create_view(VkImageViewType view_type, VkFormat format, const ImageSubresourceRange& range)
+    void Image::retire(DeletionQueue& queue)
     {
-        // Destroy old view if exists
-        if (view_ != VK_NULL_HANDLE)
+        if (allocation_)
         {
-            vkDestroyImageView(device_->device(), view_, nullptr);
+            allocation_->retire(queue);
+            resource_manager_->destroyImage(std::move(allocation_));
         }
+    }
 
-        VkImageViewCreateInfo view_info{};
-        view_info.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        view_info.image                           = image_;
-        view_info.viewType                        = view_type;
-        view_info.format                          = format;
-        view_info.subresourceRange.aspectMask     = range.aspect_mask;
-        view_info.subresourceRange.baseMipLevel   = range.base_mip_level;
-        view_info.subresourceRange.levelCount     = range.level_count;
-        view_info.subresourceRange.baseArrayLayer = range.base_array_layer;
-        view_info.subresourceRange.layerCount     = range.layer_count;
-
-        if (vkCreateImageView(device_->device(), &view_info, nullptr, &view_) != VK_SUCCESS)
-        {
-            throw std::runtime_error("Failed to create image view");
-        }
+    void Image::create_view(VkImageViewType view_type, VkFormat format, const ImageSubresourceRange& range)
+    {
+        // The allocation owns the view so that it can rebuild it after a relocation
+        allocation_->destroyAllViews();
+        allocation_->createView(view_type,
+                                format,
+                                {range.aspect_mask, range.base_mip_level, range.level_count, range.base_array_layer, range.layer_count});
     }
 
     void Image::transition_layout(VkCommandBuffer cmd, VkImageLayout new_layout)
     {
-        if (current_layout_ == new_layout)
+        const VkImageLayout old_layout = current_layout();
+        if (old_layout == new_layout)
         {
             return;
         }
 
-        auto info = get_transition_info(current_layout_, new_layout);
+        auto info = get_transition_info(old_layout, new_layout);
 
         VkImageMemoryBarrier barrier{};
         barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout                       = current_layout_;
+        barrier.oldLayout                       = old_layout;
         barrier.newLayout                       = new_layout;
         barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image                           = image_;
+        barrier.image                           = handle();
         barrier.subresourceRange.aspectMask     = (format_ == VK_FORMAT_D32_SFLOAT || format_ == VK_FORMAT_D32_SFLOAT_S8_UINT || format_ == VK_FORMAT_D24_UNORM_S8_UINT)
                                                       ? VK_IMAGE_ASPECT_DEPTH_BIT
                                                       : VK_IMAGE_ASPECT_COLOR_BIT;
@@ -138,7 +112,7 @@ namespace vulkan_engine::vulkan
             0, nullptr,
             1, &barrier);
 
-        current_layout_ = new_layout;
+        allocation_->setLayout(new_layout);
     }
 
     Image::TransitionInfo Image::get_transition_info(VkImageLayout old_layout, VkImageLayout new_layout)
@@ -0,0 +1,160 @@
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
+#include "engine/rhi/vulkan/utils/VulkanError.hpp"
+
+#include <vector>
+
+namespace vulkan_engine::vulkan
+{
+    QueueTimeline::QueueTimeline(VkDevice device, VkQueue queue)
+        : device_(device)
+        , queue_(queue)
+    {
+        VkSemaphoreTypeCreateInfo type_info{};
+        type_info.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        type_info.initialValue  = 0;
+
+        VkSemaphoreCreateInfo semaphore_info{};
+        semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphore_info.pNext = &type_info;
+
+        VkResult result = vkCreateSemaphore(device_, &semaphore_info, nullptr, &semaphore_);
+        if (result != VK_SUCCESS)
+        {
+            throw VulkanError(result, "Failed to create queue timeline semaphore", __FILE__, __LINE__);
+        }
+    }
+
+    QueueTimeline::~QueueTimeline()
+    {
+        if (semaphore_ != VK_NULL_HANDLE)
+        {
+            vkDestroySemaphore(device_, semaphore_, nullptr);
+        }
+    }
+
+    uint64_t QueueTimeline::submit(VkSubmitInfo* batches, uint32_t batch_count, VkFence fence)
+    {
+        // With no batches, submit an empty one that only advances the timeline
+        VkSubmitInfo empty{};
+        empty.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        if (batch_count == 0)
+        {
+            batches     = &empty;
+            batch_count = 1;
+        }
+
+        std::lock_guard<std::mutex> lock(submit_mutex_);
+        const uint64_t              value = last_submitted_.load(std::memory_order_relaxed) + 1;
+
+        // Append the timeline to the last batch's signals. Binary semaphores
+        // ignore their entry in the value array.
+        VkSubmitInfo& last = batches[batch_count - 1];
+
+        std::vector<VkSemaphore> signals(last.pSignalSemaphores, last.pSignalSemaphores + last.signalSemaphoreCount);
+        signals.push_back(semaphore_);
+        std::vector<uint64_t> values(signals.size(), 0);
+        values.back() = value;
+
+        VkTimelineSemaphoreSubmitInfo timeline_info{};
+        timeline_info.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timeline_info.pNext                     = last.pNext;
+        timeline_info.signalSemaphoreValueCount = static_cast<uint32_t>(values.size());
+        timeline_info.pSignalSemaphoreValues    = values.data();
+
+        const VkSubmitInfo original = last;
+        last.pNext                  = &timeline_info;
+        last.signalSemaphoreCount   = static_cast<uint32_t>(signals.size());
+        last.pSignalSemaphores      = signals.data();
+
+        const VkResult result = vkQueueSubmit(queue_, batch_count, batches, fence);
+        last                  = original;
+
+        if (result != VK_SUCCESS)
+        {
+            return 0;
+        }
+
+        last_submitted_.store(value, std::memory_order_release);
+        return value;
+    }
+
+    uint64_t QueueTimeline::completed_value() const
+    {
+        uint64_t value = 0;
+        if (vkGetSemaphoreCounterValue(device_, semaphore_, &value) != VK_SUCCESS)
+        {
+            return completed_.load(std::memory_order_acquire);
+        }
+
+        // Keep the cache monotonic when several threads race to update it
+        uint64_t cached = completed_.load(std::memory_order_relaxed);
+        while (cached < value && !completed_.compare_exchange_weak(cached, value, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return value;
+    }
+
+    bool QueueTimeline::is_complete(uint64_t value) const
+    {
+        if (value <= completed_.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+        return value <= completed_value();
+    }
+
+    bool QueueTimeline::wait(uint64_t value, uint64_t timeout) const
+    {
+        if (is_complete(value))
+        {
+            return true;
+        }
+
+        const WaitPoint point{this, value};
+        return wait_all(std::span<const WaitPoint>(&point, 1), timeout);
+    }
+
+    bool QueueTimeline::wait_all(std::span<const WaitPoint> points, uint64_t timeout)
+    {
+        std::vector<VkSemaphore> semaphores;
+        std::vector<uint64_t>    values;
+        VkDevice                 device = VK_NULL_HANDLE;
+        for (const WaitPoint& point : points)
+        {
+            if (!point.timeline || point.timeline->is_complete(point.value))
+            {
+                continue;
+            }
+            semaphores.push_back(point.timeline->semaphore_);
+            values.push_back(point.value);
+            device = point.timeline->device_;
+        }
+
+        if (semaphores.empty())
+        {
+            return true;
+        }
+
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.semaphoreCount = static_cast<uint32_t>(semaphores.size());
+        wait_info.pSemaphores    = semaphores.data();
+        wait_info.pValues        = values.data();
+
+        if (vkWaitSemaphores(device, &wait_info, timeout) != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        // Refresh the caches so later is_complete() calls stay on the fast path
+        for (const WaitPoint& point : points)
+        {
+            if (point.timeline)
+            {
+                point.timeline->completed_value();
+            }
+        }
+        return true;
+    }
+} // namespace vulkan_engine::vulkan
@@ -1,4 +1,5 @@
 #include "engine/rhi/vulkan/sync/Synchronization.hpp"
+#include "engine/rhi/vulkan/sync/QueueTimeline.hpp"
 #include "engine/rhi/vulkan/utils/VulkanError.hpp"
 #include <stdexcept>
 
@@ -76,10 +77,16 @@ namespace vulkan_engine::vulkan
 
     // Semaphore implementation
     Semaphore::Semaphore(std::shared_ptr<DeviceManager> device)
+        : Semaphore(std::move(device), nullptr)
+    {
+    }
+
+    Semaphore::Semaphore(std::shared_ptr<DeviceManager> device, const void* create_next)
         : device_(std::move(device))
     {
         VkSemaphoreCreateInfo semaphore_info{};
         semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphore_info.pNext = create_next;
 
         VkResult result = vkCreateSemaphore(device_->device(), &semaphore_info, nullptr, &semaphore_);
         if (result != VK_SUCCESS)
@@ -119,32 +126,64 @@ namespace vulkan_engine::vulkan
         return *this;
     }
 
+    VkSemaphore Semaphore::release() noexcept
+    {
+        return std::exchange(semaphore_, VK_NULL_HANDLE);
+    }
+
     // TimelineSemaphore implementation
-    TimelineSemaphore::TimelineSemaphore(std::shared_ptr<DeviceManager> device, uint64_t /*initial_value*/)
-        : Semaphore(std::move(device))
+    namespace
+    {
+        VkSemaphoreTypeCreateInfo timeline_type_info(uint64_t initial_value)
+        {
+            VkSemaphoreTypeCreateInfo type_info{};
+            type_info.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+            type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            type_info.initialValue  = initial_value;
+            return type_info;
+        }
+    } // namespace
+
+    TimelineSemaphore::TimelineSemaphore(std::shared_ptr<DeviceManager> device, uint64_t initial_value)
+        : TimelineSemaphore(std::move(device), timeline_type_info(initial_value))
     {
-        // Note: Proper timeline semaphore requires Vulkan 1.2+
-        // For now, using regular semaphore as placeholder
-        // The base Semaphore class already creates the semaphore
     }
 
-    void TimelineSemaphore::signal(uint64_t /*value*/)
+    TimelineSemaphore::TimelineSemaphore(std::shared_ptr<DeviceManager> device, const VkSemaphoreTypeCreateInfo& type_info)
+        : Semaphore(std::move(device), &type_info)
     {
-        // Placeholder: Timeline semaphore signaling requires Vulkan 1.2+
-        // vkSignalSemaphore(device_->device(), &signal_info);
     }
 
-    void TimelineSemaphore::wait(uint64_t /*value*/, uint64_t /*timeout*/)
+    void TimelineSemaphore::signal(uint64_t value)
     {
-        // Placeholder: Timeline semaphore wait requires Vulkan 1.2+
-        // vkWaitSemaphores(device_->device(), &wait_info, timeout);
+        VkSemaphoreSignalInfo signal_info{};
+        signal_info.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        signal_info.semaphore = semaphore_;
+        signal_info.value     = value;
+
+        VkResult result = vkSignalSemaphore(device_->device(), &signal_info);
+        if (result != VK_SUCCESS)
+        {
+            throw VulkanError(result, "Failed to signal timeline semaphore", __FILE__, __LINE__);
+        }
+    }
+
+    bool TimelineSemaphore::wait(uint64_t value, uint64_t timeout) const
+    {
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores    = &semaphore_;
+        wait_info.pValues        = &value;
+
+        return vkWaitSemaphores(device_->device(), &wait_info, timeout) == VK_SUCCESS;
     }
 
     uint64_t TimelineSemaphore::get_value() const
     {
-        // Placeholder: Timeline semaphore counter value requires Vulkan 1.2+
-        // vkGetSemaphoreCounterValue(device_->device(), semaphore_, &value);
-        return 0;
+        uint64_t value = 0;
+        vkGetSemaphoreCounterValue(device_->device(), semaphore_, &value);
+        return value;
     }
 
     // Event implementation
@@ -266,6 +305,34 @@ namespace vulkan_engine::vulkan
         vkResetFences(device_->device(), static_cast<uint32_t>(vk_fences.size()), vk_fences.data());
     }
 
+    bool SynchronizationManager::wait_for_timelines(
+        const std::vector<std::pair<std::shared_ptr<TimelineSemaphore>, uint64_t>>& values,
+        uint64_t                                                                  timeout)
+    {
+        if (values.empty())
+        {
+            return true;
+        }
+
+        std::vector<VkSemaphore> semaphores;
+        std::vector<uint64_t>    wait_values;
+        semaphores.reserve(values.size());
+        wait_values.reserve(values.size());
+        for (const auto& [semaphore, value] : values)
+        {
+            semaphores.push_back(semaphore->handle());
+            wait_values.push_back(value);
+        }
+
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.semaphoreCount = static_cast<uint32_t>(semaphores.size());
+        wait_info.pSemaphores    = semaphores.data();
+        wait_info.pValues        = wait_values.data();
+
+        return vkWaitSemaphores(device_->device(), &wait_info, timeout) == VK_SUCCESS;
+    }
+
     void SynchronizationManager::submit_with_sync(
         VkQueue                                        queue,
         VkCommandBuffer                                cmd,
@@ -301,7 +368,7 @@ namespace vulkan_engine::vulkan
         vkQueueSubmit(queue, 1, &submit_info, fence_handle);
     }
 
-    // FrameSyncManager implementation (hybrid per-frame fence + per-image semaphore)
+    // FrameSyncManager implementation (hybrid per-frame timeline value + per-image semaphore)
     FrameSyncManager::FrameSyncManager(
         std::shared_ptr<DeviceManager> device,
         uint32_t                       max_frames_in_flight)
@@ -313,13 +380,9 @@ namespace vulkan_engine::vulkan
             throw std::invalid_argument("max_frames_in_flight must be > 0");
         }
 
-        // Per-frame: CPU-GPU synchronization fences (for command buffer recycling)
-        frame_fences_.reserve(max_frames_in_flight_);
-        for (uint32_t i = 0; i < max_frames_in_flight_; ++i)
-        {
-            // Start signaled so first frame doesn't wait
-            frame_fences_.push_back(std::make_unique<Fence>(device_, true));
-        }
+        // Per-frame: graphics timeline values (for command buffer recycling).
+        // 0 is always complete, so the first frames don't wait.
+        frame_values_.assign(max_frames_in_flight_, 0);
 
         // Per-frame: acquire semaphore for vkAcquireNextImageKHR
 
@@ -332,17 +395,6 @@ namespace vulkan_engine::vulkan
         }
 
 
-        // Per-frame: scene finished semaphore (Scene -> ImGui dependency)
-
-        scene_finished_semaphores_.reserve(max_frames_in_flight_);
-
-        for (uint32_t i = 0; i < max_frames_in_flight_; ++i)
-
-        {
-            scene_finished_semaphores_.push_back(std::make_unique<Semaphore>(device_));
-        }
-
-
         // Per-image render finished semaphores will be created on demand
 
 
@@ -382,13 +434,9 @@ namespace vulkan_engine::vulkan
                         // If swapchain has fewer images, we keep the extra semaphores (no harm)
                     }
 
-    void FrameSyncManager::wait_and_reset_frame_fence(uint32_t frame, uint64_t timeout)
-    {
-        frame_fences_[frame]->wait_and_reset(timeout);
-    }
-
-    void FrameSyncManager::wait_and_reset_current_frame_fence(uint64_t timeout)
+    bool FrameSyncManager::wait_for_frame(uint32_t frame, uint64_t timeout)
     {
-        frame_fences_[current_frame_]->wait_and_reset(timeout);
+        QueueTimeline* timeline = device_->graphics_timeline();
+        return !timeline || timeline->wait(frame_values_[frame], timeout);
     }
 } // namespace vulkan_engine::vulkan
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <functional>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <vector>
 #include <vulkan/vulkan_core.h>  // For VkDebugUtilsMessengerEXT, VkSurfaceKHR
@@ -12,6 +13,11 @@
 #include "SwapChain.hpp"
 #include "Texture.hpp"
 
+namespace vulkan_engine::vulkan
+{
+    class DeletionQueue;
+}
+
 namespace engine::rhi
 {
     // Device description
@@ -110,6 +116,12 @@ namespace engine::rhi
             // Garbage collection
             void runGarbageCollection();
 
+            // Submission counter for deferred deletion: every submit() takes the next
+            // value, and a value completes once its fence (or a later fence on the
+            // same queue) has signaled
+            [[nodiscard]] uint64_t submittedValue() const noexcept { return submittedValue_; }
+            [[nodiscard]] uint64_t completedValue() const noexcept { return completedValue_; }
+
             // Queries
             [[nodiscard]] const DeviceCapabilities& capabilities() const noexcept { return capabilities_; }
             [[nodiscard]] uint32_t                  currentFrameIndex() const noexcept { return currentFrameIndex_; }
@@ -156,14 +168,23 @@ namespace engine::rhi
             uint32_t                  currentFrameIndex_   = 0;
             static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
 
-            // Deletion queue
-            struct DeletionEntry
+            // Frame-deferred destruction, shared with engine/rhi
+            std::unique_ptr<vulkan_engine::vulkan::DeletionQueue> deletionQueue_;
+
+            // Submits whose completion has not been observed yet, oldest first
+            struct PendingSubmit
             {
-                uint32_t              frameIndex;
-                std::function<void()> deleter;
+                VkQueue  queue = nullptr;
+                VkFence  fence = nullptr; // May be null; completes with a later fence on the queue
+                uint64_t value = 0;
+                bool     done  = false;
             };
 
-            std::vector<DeletionEntry> deletionQueue_;
+            std::deque<PendingSubmit> pendingSubmits_;
+            uint64_t                  submittedValue_ = 0;
+            uint64_t                  completedValue_ = 0;
+
+            void updateCompletedValue();
 
             // Helper functions
             [[nodiscard]] Result createInstance(bool enableValidation);
@@ -141,6 +141,9 @@ namespace engine::rhi
             explicit Semaphore(const InternalData& data);
             void     release();
 
+            // Gives up the handle without destroying it (for deferred deletion)
+            [[nodiscard]] VkSemaphore detach() noexcept;
+
         private:
             VkSemaphore handle_ = nullptr;
             VkDevice    device_ = nullptr;
@@ -176,6 +179,9 @@ namespace engine::rhi
             explicit Fence(const InternalData& data);
             void     release();
 
+            // Gives up the handle without destroying it (for deferred deletion)
+            [[nodiscard]] VkFence detach() noexcept;
+
         private:
             VkFence  handle_ = nullptr;
             VkDevice device_ = nullptr;
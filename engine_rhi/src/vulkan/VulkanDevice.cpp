@@ -1,4 +1,5 @@
 #include "engine/rhi/Device.hpp"
+#include "engine/rhi/vulkan/sync/DeletionQueue.hpp"
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 #include <vector>
@@ -51,6 +52,9 @@ namespace engine::rhi
         , capabilities_(other.capabilities_)
         , currentFrameIndex_(other.currentFrameIndex_)
         , deletionQueue_(std::move(other.deletionQueue_))
+        , pendingSubmits_(std::move(other.pendingSubmits_))
+        , submittedValue_(other.submittedValue_)
+        , completedValue_(other.completedValue_)
     {
         other.nativeInstance_       = nullptr;
         other.nativePhysicalDevice_ = nullptr;
@@ -90,6 +94,9 @@ namespace engine::rhi
             capabilities_         = other.capabilities_;
             currentFrameIndex_    = other.currentFrameIndex_;
             deletionQueue_        = std::move(other.deletionQueue_);
+            pendingSubmits_       = std::move(other.pendingSubmits_);
+            submittedValue_       = other.submittedValue_;
+            completedValue_       = other.completedValue_;
 
             other.nativeInstance_       = nullptr;
             other.nativePhysicalDevice_ = nullptr;
@@ -156,6 +163,8 @@ namespace engine::rhi
         // Query capabilities
         queryCapabilities();
 
+        deletionQueue_ = std::make_unique<vulkan_engine::vulkan::DeletionQueue>(nativeDevice_);
+
         initialized_ = true;
         return Result::Success;
     }
@@ -174,11 +183,13 @@ namespace engine::rhi
         }
 
         // Process all pending deletions
-        for (auto& entry : deletionQueue_)
+        if (deletionQueue_)
         {
-            entry.deleter();
+            deletionQueue_->flush();
+            deletionQueue_.reset();
         }
-        deletionQueue_.clear();
+        pendingSubmits_.clear();
+        completedValue_ = submittedValue_;
 
         // Destroy command pools
         if (nativeDevice_)
@@ -793,6 +804,17 @@ namespace engine::rhi
             return Result::Error_DeviceLost;
         }
 
+        // A fence can only be resubmitted after it signaled and was reset, so an
+        // earlier submit on the same fence has completed
+        for (PendingSubmit& pending : pendingSubmits_)
+        {
+            if (vkFence && pending.fence == vkFence)
+            {
+                pending.done = true;
+            }
+        }
+        pendingSubmits_.push_back({queue, vkFence, ++submittedValue_, false});
+
         return Result::Success;
     }
 
@@ -806,28 +828,51 @@ namespace engine::rhi
             return Result::Error_DeviceLost;
         }
 
+        pendingSubmits_.clear();
+        completedValue_ = submittedValue_;
+
         return Result::Success;
     }
 
+    void Device::updateCompletedValue()
+    {
+        // A signaled fence completes its submit and everything before it on that queue
+        for (size_t i = pendingSubmits_.size(); i-- > 0;)
+        {
+            PendingSubmit& pending = pendingSubmits_[i];
+            if (pending.done || !pending.fence || vkGetFenceStatus(nativeDevice_, pending.fence) != VK_SUCCESS)
+            {
+                continue;
+            }
+            for (size_t j = 0; j <= i; ++j)
+            {
+                if (pendingSubmits_[j].queue == pending.queue)
+                {
+                    pendingSubmits_[j].done = true;
+                }
+            }
+        }
+
+        while (!pendingSubmits_.empty() && pendingSubmits_.front().done)
+        {
+            completedValue_ = pendingSubmits_.front().value;
+            pendingSubmits_.pop_front();
+        }
+        if (pendingSubmits_.empty())
+        {
+            completedValue_ = submittedValue_;
+        }
+    }
+
     void Device::runGarbageCollection()
     {
-        // Delete resources that are at least MAX_FRAMES_IN_FLIGHT frames old
-        const uint32_t safeFrame = currentFrameIndex_ - MAX_FRAMES_IN_FLIGHT;
-
-        deletionQueue_.erase(
-                             std::remove_if(deletionQueue_.begin(),
-                                            deletionQueue_.end(),
-                                            [safeFrame](const DeletionEntry& entry)
-                                            {
-                                                if (entry.frameIndex <= safeFrame)
-                                                {
-                                                    entry.deleter();
-                                                    return true;
-                                                }
-                                                return false;
-                                            }),
-                             deletionQueue_.end()
-                            );
+        // Called once per frame after the frame's fence wait: frees what was
+        // deleted before the submits that have completed since
+        updateCompletedValue();
+        if (deletionQueue_)
+        {
+            deletionQueue_->collect(submittedValue_, completedValue_);
+        }
 
         currentFrameIndex_++;
     }
@@ -967,10 +1012,11 @@ namespace engine::rhi
     {
         if (semaphore)
         {
-            deletionQueue_.push_back({
-                                         currentFrameIndex_,
-                                         [semaphore]() mutable { semaphore.reset(); }
-                                     });
+            // Other owners keep it alive; only the last reference defers the handle
+            if (deletionQueue_ && semaphore.use_count() == 1)
+            {
+                deletionQueue_->defer(semaphore->detach());
+            }
         }
     }
 
@@ -978,17 +1024,23 @@ namespace engine::rhi
     {
         if (fence)
         {
-            deletionQueue_.push_back({
-                                         currentFrameIndex_,
-                                         [fence]() mutable { fence.reset(); }
-                                     });
+            if (deletionQueue_ && fence.use_count() == 1)
+            {
+                deletionQueue_->defer(fence->detach());
+            }
         }
     }
 
     Result Device::waitForFence(FenceHandle fence, uint64_t timeout)
     {
         if (!fence) return Result::Error_InvalidParameter;
-        return fence->wait(timeout);
+
+        const Result result = fence->wait(timeout);
+        if (result == Result::Success)
+        {
+            updateCompletedValue();
+        }
+        return result;
     }
 
     Result Device::resetFence(FenceHandle fence)
@@ -219,6 +219,14 @@ namespace engine::rhi
         }
     }
 
+    VkSemaphore Semaphore::detach() noexcept
+    {
+        VkSemaphore handle = handle_;
+        handle_            = nullptr;
+        device_            = nullptr;
+        return handle;
+    }
+
     // Fence implementation
     Fence::~Fence()
     {
@@ -262,6 +270,14 @@ namespace engine::rhi
         }
     }
 
+    VkFence Fence::detach() noexcept
+    {
+        VkFence handle = handle_;
+        handle_        = nullptr;
+        device_        = nullptr;
+        return handle;
+    }
+
     Result Fence::wait(uint64_t timeout)
     {
         if (!handle_) return Result::Error_InvalidParameter;
@@ -0,0 +1,134 @@
+/**
+ * @file ShaderCacheTest.cpp
+ * @brief Shader cache key helpers and on-disk store tests (GTest), CPU only
+ */
+
+#include <gtest/gtest.h>
+#include "engine/rendering/shaders/ShaderCache.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace vulkan_engine::rendering;
+
+// ==================== Key helpers ====================
+
+TEST(ShaderCacheKeyTest, PermutationKeyIsOrderIndependent)
+{
+    std::unordered_map<std::string, std::string> a = {{"NORMAL_MAP", "1"}, {"ALPHA_TEST", ""}, {"LIGHTS", "4"}};
+    std::unordered_map<std::string, std::string> b;
+    b["LIGHTS"]     = "4";
+    b["ALPHA_TEST"] = "";
+    b["NORMAL_MAP"] = "1";
+
+    EXPECT_EQ(ShaderCache::permutation_key(a), "ALPHA_TEST;LIGHTS=4;NORMAL_MAP=1");
+    EXPECT_EQ(ShaderCache::permutation_key(a), ShaderCache::permutation_key(b));
+    EXPECT_EQ(ShaderCache::permutation_key({}), "");
+}
+
+TEST(ShaderCacheKeyTest, PermutationKeyDistinguishesValues)
+{
+    EXPECT_NE(ShaderCache::permutation_key({{"LIGHTS", "4"}}), ShaderCache::permutation_key({{"LIGHTS", "8"}}));
+    EXPECT_NE(ShaderCache::permutation_key({{"LIGHTS", ""}}), ShaderCache::permutation_key({{"LIGHTS", "1"}}));
+}
+
+TEST(ShaderCacheKeyTest, HashIsStableFnv1a)
+{
+    // Reference values of 64-bit FNV-1a
+    EXPECT_EQ(ShaderCache::hash_bytes("", 0), 0xcbf29ce484222325ull);
+    EXPECT_EQ(ShaderCache::hash_bytes("a", 1), 0xaf63dc4c8601ec8cull);
+    EXPECT_EQ(ShaderCache::hash_string("pbr.slang"), ShaderCache::hash_string("pbr.slang"));
+    EXPECT_NE(ShaderCache::hash_string("pbr.slang"), ShaderCache::hash_string("pbr.slanG"));
+}
+
+TEST(ShaderCacheKeyTest, ChainedFieldsDoNotAlias)
+{
+    // Keys are built by chaining fields; the length prefix keeps field boundaries significant
+    uint64_t ab_c = ShaderCache::hash_string("c", ShaderCache::hash_string("ab"));
+    uint64_t a_bc = ShaderCache::hash_string("bc", ShaderCache::hash_string("a"));
+    EXPECT_NE(ab_c, a_bc);
+
+    uint64_t main_vertex   = ShaderCache::hash_string("vertex", ShaderCache::hash_string("main"));
+    uint64_t main_fragment = ShaderCache::hash_string("fragment", ShaderCache::hash_string("main"));
+    EXPECT_NE(main_vertex, main_fragment);
+}
+
+TEST(ShaderCacheKeyTest, HexIsSixteenLowercaseDigits)
+{
+    EXPECT_EQ(ShaderCache::to_hex(0), "0000000000000000");
+    EXPECT_EQ(ShaderCache::to_hex(0xcbf29ce484222325ull), "cbf29ce484222325");
+}
+
+// ==================== On-disk store ====================
+
+class ShaderCacheStoreTest : public ::testing::Test
+{
+    protected:
+        std::filesystem::path directory;
+
+        void SetUp() override
+        {
+            directory = std::filesystem::temp_directory_path() /
+                        ("shader_cache_test_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+            std::filesystem::remove_all(directory);
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(directory, ec);
+        }
+};
+
+TEST_F(ShaderCacheStoreTest, StoreThenLoadRoundTrips)
+{
+    ShaderCache           cache(directory);
+    std::vector<uint32_t> spirv = {0x07230203, 0x00010000, 0, 8, 0, 0x00020011, 1};
+    const std::string     key   = ShaderCache::to_hex(ShaderCache::hash_string("triangle"));
+
+    ASSERT_TRUE(cache.store(key, spirv));
+    EXPECT_TRUE(std::filesystem::exists(cache.entry_path(key)));
+
+    std::vector<uint32_t> loaded;
+    ASSERT_TRUE(cache.load(key, loaded));
+    EXPECT_EQ(loaded, spirv);
+
+    // No temporary files are left next to the entry
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+    {
+        EXPECT_EQ(entry.path().extension(), ".spv");
+        ++files;
+    }
+    EXPECT_EQ(files, 1u);
+}
+
+TEST_F(ShaderCacheStoreTest, MissingEntryIsAMiss)
+{
+    ShaderCache           cache(directory);
+    std::vector<uint32_t> loaded;
+    EXPECT_FALSE(cache.load("0000000000000000", loaded));
+}
+
+TEST_F(ShaderCacheStoreTest, RejectsEntriesThatAreNotSpirv)
+{
+    ShaderCache cache(directory);
+    std::filesystem::create_directories(directory);
+
+    {
+        std::ofstream file(cache.entry_path("bad_magic"), std::ios::binary);
+        const uint32_t words[2] = {0xdeadbeef, 0};
+        file.write(reinterpret_cast<const char*>(words), sizeof(words));
+    }
+    {
+        std::ofstream file(cache.entry_path("odd_size"), std::ios::binary);
+        file.write("\x03\x02\x23\x07\x00", 5);
+    }
+
+    std::vector<uint32_t> loaded;
+    EXPECT_FALSE(cache.load("bad_magic", loaded));
+    EXPECT_FALSE(cache.load("odd_size", loaded));
+}
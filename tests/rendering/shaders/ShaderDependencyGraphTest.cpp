@@ -0,0 +1,89 @@
+/**
+ * @file ShaderDependencyGraphTest.cpp
+ * @brief Shader hot-reload dependency graph tests (GTest), CPU only
+ */
+
+#include <gtest/gtest.h>
+#include "engine/rendering/shaders/ShaderDependencyGraph.hpp"
+#include <set>
+#include <string>
+
+using namespace vulkan_engine::rendering;
+
+// ==================== Test fixture ====================
+
+// common.slang -> lighting.slang -> pbr.slang -> program:pbr -> material:Gold
+//                                                            -> material:Iron
+// common.slang -> unlit.slang -> program:unlit
+class ShaderDependencyGraphTest : public ::testing::Test
+{
+    protected:
+        ShaderDependencyGraph graph;
+
+        void SetUp() override
+        {
+            graph.add_edge("common.slang", "lighting.slang");
+            graph.add_edge("lighting.slang", "pbr.slang");
+            graph.add_edge("pbr.slang", "program:pbr");
+            graph.add_edge("program:pbr", "material:Gold");
+            graph.add_edge("program:pbr", "material:Iron");
+            graph.add_edge("common.slang", "unlit.slang");
+            graph.add_edge("unlit.slang", "program:unlit");
+        }
+};
+
+TEST_F(ShaderDependencyGraphTest, ChangePropagatesTransitively)
+{
+    auto affected = graph.collect_affected({"lighting.slang"});
+
+    std::set<std::string> expected = {"pbr.slang", "program:pbr", "material:Gold", "material:Iron"};
+    EXPECT_EQ(affected, expected);
+}
+
+TEST_F(ShaderDependencyGraphTest, SharedIncludeReachesEveryProgram)
+{
+    auto affected = graph.collect_affected({"common.slang"});
+
+    EXPECT_EQ(affected.size(), 7u);
+    EXPECT_TRUE(affected.contains("program:pbr"));
+    EXPECT_TRUE(affected.contains("program:unlit"));
+    EXPECT_FALSE(affected.contains("common.slang"));
+}
+
+TEST_F(ShaderDependencyGraphTest, LeavesAndUnknownNodesAffectNothing)
+{
+    EXPECT_TRUE(graph.collect_affected({"material:Gold"}).empty());
+    EXPECT_TRUE(graph.collect_affected({"missing.slang"}).empty());
+}
+
+TEST_F(ShaderDependencyGraphTest, ClearDependenciesDropsOnlyIncomingEdges)
+{
+    // A rebuilt pbr.slang no longer imports lighting.slang
+    graph.clear_dependencies("pbr.slang");
+
+    EXPECT_TRUE(graph.dependencies_of("pbr.slang").empty());
+    EXPECT_TRUE(graph.collect_affected({"lighting.slang"}).empty());
+    EXPECT_EQ(graph.collect_affected({"pbr.slang"}).size(), 3u);
+}
+
+TEST_F(ShaderDependencyGraphTest, RemoveNodeDropsAllEdges)
+{
+    EXPECT_EQ(graph.node_count(), 8u);
+
+    graph.remove_node("program:pbr");
+
+    EXPECT_FALSE(graph.contains("program:pbr"));
+    EXPECT_TRUE(graph.collect_affected({"pbr.slang"}).empty());
+    EXPECT_TRUE(graph.dependencies_of("material:Gold").empty());
+    EXPECT_EQ(graph.node_count(), 5u); // The orphaned materials go with their last edge
+}
+
+TEST(ShaderDependencyGraphCycleTest, CyclesTerminateAndIncludeTheChangedNode)
+{
+    ShaderDependencyGraph graph;
+    graph.add_edge("a.slang", "b.slang");
+    graph.add_edge("b.slang", "a.slang");
+
+    std::set<std::string> expected = {"a.slang", "b.slang"};
+    EXPECT_EQ(graph.collect_affected({"a.slang"}), expected);
+}
@@ -8,10 +8,20 @@
 #include "vulkan/memory/VmaBuffer.hpp"
 #include "vulkan/memory/VmaImage.hpp"
 #include "vulkan/memory/ResourceManager.hpp"
+#include "vulkan/memory/BudgetGovernor.hpp"
+#include "vulkan/memory/AllocationPolicy.hpp"
+#include "vulkan/memory/AllocationTracker.hpp"
+#include "vulkan/memory/OffsetAllocator.hpp"
+#include "vulkan/memory/ReadbackQueue.hpp"
 #include "vulkan/device/Device.hpp"
+#include "vulkan/resources/Buffer.hpp"
 #include <memory>
 #include <vector>
 #include <cstring>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
 
 using namespace vulkan_engine::vulkan;
 using namespace vulkan_engine::vulkan::memory;
@@ -618,6 +628,224 @@ TEST_F(ResourceManagerTest, ResourceCreationAndReuse)
     EXPECT_EQ(readData, testData);
 }
 
+TEST_F(ResourceManagerTest, PoolSelection)
+{
+    EXPECT_EQ(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+              PoolType::Staging);
+    EXPECT_EQ(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
+              PoolType::Uniform);
+    EXPECT_EQ(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
+              PoolType::Dynamic);
+    EXPECT_EQ(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+              PoolType::Vertex);
+    EXPECT_EQ(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+              PoolType::Index);
+    EXPECT_EQ(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT),
+              PoolType::Readback);
+    EXPECT_FALSE(ResourceManager::selectBufferPool(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT).has_value());
+
+    EXPECT_EQ(ResourceManager::selectImagePool(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT), PoolType::Texture);
+    EXPECT_EQ(ResourceManager::selectImagePool(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT), PoolType::RenderTarget);
+}
+
+TEST_F(ResourceManagerTest, PooledBuffersShareDeviceMemory)
+{
+    auto resourceManager = std::make_shared<ResourceManager>(deviceManager);
+
+    auto uniformStats = [&]()
+    {
+        for (const auto& [type, stats] : resourceManager->allocationStats().pools)
+        {
+            if (type == PoolType::Uniform)
+            {
+                return stats;
+            }
+        }
+        return MemoryPool::Stats{};
+    };
+
+    const auto before = uniformStats();
+
+    // 64 个 uniform buffer 应该共享 Uniform 池的内存块
+    std::vector<VmaBufferPtr> buffers;
+    for (int i = 0; i < 64; ++i)
+    {
+        buffers.push_back(resourceManager->createPooledBuffer(256,
+                                                              VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                              true));
+        ASSERT_NE(buffers.back()->handle(), VK_NULL_HANDLE);
+    }
+
+    const auto after = uniformStats();
+    EXPECT_EQ(after.allocationCount, before.allocationCount + 64);
+    EXPECT_EQ(after.blockCount, before.blockCount);
+    EXPECT_EQ(resourceManager->allocationStats().unpooledResources, 0u);
+
+    for (auto& buffer : buffers)
+    {
+        resourceManager->destroyBuffer(std::move(buffer));
+    }
+    EXPECT_EQ(uniformStats().allocationCount, before.allocationCount);
+}
+
+TEST_F(ResourceManagerTest, RhiBufferUsesAttachedManager)
+{
+    auto resourceManager = std::make_shared<ResourceManager>(deviceManager);
+    deviceManager->set_resource_manager(resourceManager);
+
+    {
+        Buffer staging(deviceManager, 4096, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        EXPECT_NE(staging.handle(), VK_NULL_HANDLE);
+
+        uint32_t value = 0xC0FFEE;
+        staging.write(&value, sizeof(value));
+        uint32_t readBack = 0;
+        staging.read(&readBack, sizeof(readBack));
+        EXPECT_EQ(readBack, value);
+    }
+
+    // 析构后应归还到池中
+    for (const auto& [type, stats] : resourceManager->allocationStats().pools)
+    {
+        if (type == PoolType::Staging)
+        {
+            EXPECT_EQ(stats.allocationCount, 0u);
+        }
+    }
+}
+
+TEST_F(ResourceManagerTest, BudgetGovernorPriority)
+{
+    // 最近使用且覆盖面积大的资源优先级最高
+    EXPECT_GT(BudgetGovernor::priority(0.5f, 0), BudgetGovernor::priority(0.0f, 0));
+    EXPECT_GT(BudgetGovernor::priority(0.0f, 0), BudgetGovernor::priority(0.0f, 120));
+    EXPECT_GT(BudgetGovernor::priority(0.5f, 10), BudgetGovernor::priority(0.5f, 300));
+}
+
+TEST_F(ResourceManagerTest, BudgetGovernorEvictsColdestAndReloads)
+{
+    auto resourceManager = std::make_shared<ResourceManager>(deviceManager);
+
+    // 阈值为 0：任何使用量都视为超出预算
+    BudgetGovernor::Config config;
+    config.demoteThreshold    = 0.0f;
+    config.evictThreshold     = 0.0f;
+    config.targetUsage        = 0.0f;
+    config.minIdleFrames      = 2;
+    config.maxActionsPerFrame = 1;
+    BudgetGovernor governor(resourceManager, config);
+
+    struct Texture
+    {
+        VmaImagePtr            image;
+        BudgetGovernor::Handle handle = BudgetGovernor::INVALID_HANDLE;
+    };
+    std::vector<Texture> textures(2);
+
+    for (auto& texture : textures)
+    {
+        texture.image = resourceManager->createTexture(256, 256, VK_FORMAT_R8G8B8A8_UNORM);
+        ASSERT_NE(texture.image, nullptr);
+
+        BudgetGovernor::ResourceDesc desc;
+        desc.name             = "test texture";
+        desc.memoryTypeIndex  = texture.image->allocationInfo().memoryTypeIndex;
+        desc.size             = texture.image->allocationInfo().size;
+        desc.callbacks.evict  = [&, ptr = &texture]() { resourceManager->destroyImage(std::move(ptr->image)); };
+        desc.callbacks.reload = [&, ptr = &texture]()
+        {
+            ptr->image = resourceManager->createTexture(256, 256, VK_FORMAT_R8G8B8A8_UNORM);
+            return ptr->image != nullptr;
+        };
+        texture.handle = governor.registerResource(std::move(desc));
+    }
+
+    // textures[1] 在第 10 帧使用过，textures[0] 更冷，应先被驱逐
+    governor.update(10);
+    EXPECT_TRUE(governor.touch(textures[1].handle, 0.5f));
+    governor.update(12);
+
+    EXPECT_EQ(governor.state(textures[0].handle), BudgetGovernor::ResidencyState::Evicted);
+    EXPECT_EQ(governor.state(textures[1].handle), BudgetGovernor::ResidencyState::Resident);
+    EXPECT_EQ(textures[0].image, nullptr);
+
+    // 再次使用被驱逐的资源时，下一次 update 重新加载
+    EXPECT_FALSE(governor.touch(textures[0].handle));
+    config.demoteThreshold = 2.0f;
+    config.evictThreshold  = 2.0f;
+    governor.setConfig(config);
+    governor.update(13);
+
+    EXPECT_EQ(governor.state(textures[0].handle), BudgetGovernor::ResidencyState::Resident);
+    EXPECT_NE(textures[0].image, nullptr);
+
+    auto stats = governor.stats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.reloads, 1u);
+    EXPECT_EQ(stats.resident, 2u);
+
+    for (auto& texture : textures)
+    {
+        governor.unregisterResource(texture.handle);
+    }
+}
+
+TEST_F(ResourceManagerTest, BudgetGovernorDemotesBeforeEvicting)
+{
+    auto resourceManager = std::make_shared<ResourceManager>(deviceManager);
+    auto image           = resourceManager->createTexture(512, 512, VK_FORMAT_R8G8B8A8_UNORM, 10);
+    ASSERT_NE(image, nullptr);
+
+    // 低于驱逐阈值时只降级 mip
+    BudgetGovernor::Config config;
+    config.demoteThreshold  = 0.0f;
+    config.evictThreshold   = 2.0f;
+    config.targetUsage      = 0.0f;
+    config.restoreThreshold = 0.0f;
+    config.minIdleFrames    = 2;
+    BudgetGovernor governor(resourceManager, config);
+
+    const VkDeviceSize fullSize = image->allocationInfo().size;
+    VkDeviceSize       size     = fullSize;
+    bool               evicted  = false;
+
+    BudgetGovernor::ResourceDesc desc;
+    desc.name             = "demotable texture";
+    desc.memoryTypeIndex  = image->allocationInfo().memoryTypeIndex;
+    desc.size             = fullSize;
+    desc.callbacks.demote = [&]() { return size /= 4; };
+    desc.callbacks.evict  = [&]() { evicted = true; };
+    desc.callbacks.reload = [&]()
+    {
+        size = fullSize;
+        return true;
+    };
+    auto handle = governor.registerResource(std::move(desc));
+
+    governor.update(5);
+    EXPECT_EQ(governor.state(handle), BudgetGovernor::ResidencyState::Demoted);
+    EXPECT_LT(size, fullSize);
+    EXPECT_FALSE(evicted);
+
+    // 有余量且资源正在使用时恢复完整 mip
+    config.demoteThreshold  = 2.0f;
+    config.restoreThreshold = 2.0f;
+    governor.setConfig(config);
+    EXPECT_TRUE(governor.touch(handle, 1.0f));
+    governor.update(6);
+
+    EXPECT_EQ(governor.state(handle), BudgetGovernor::ResidencyState::Resident);
+    EXPECT_EQ(size, fullSize);
+
+    governor.unregisterResource(handle);
+    resourceManager->destroyImage(std::move(image));
+}
+
 // ==================== Builder 测试 ====================
 
 TEST_F(VmaBufferTest, BufferBuilderBasic)
@@ -853,6 +1081,80 @@ TEST_F(VmaAllocatorTest, BudgetTrackingAfterAllocation)
     EXPECT_TRUE(usageIncreased);
 }
 
+TEST_F(VmaAllocatorTest, AllocationTrackerTagsCategories)
+{
+    AllocationTracker* tracker = allocator->tracker();
+    ASSERT_NE(tracker, nullptr);
+
+    VmaAllocationCreateInfo deviceInfo = {};
+    deviceInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    VmaAllocationCreateInfo hostInfo = {};
+    hostInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    hostInfo.flags                   = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+
+    // 无作用域时按用途推断类别
+    auto uniform = std::make_shared<VmaBuffer>(allocator, 256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, deviceInfo);
+
+    // 作用域提供类别和所有者，暂存缓冲区始终归为 Staging
+    std::shared_ptr<VmaBuffer> vertices;
+    std::shared_ptr<VmaBuffer> staging;
+    {
+        AllocationScope scope(AllocationCategory::Mesh, "cube");
+        vertices = std::make_shared<VmaBuffer>(allocator, 1024, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, deviceInfo);
+        staging  = std::make_shared<VmaBuffer>(allocator, 1024, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, hostInfo);
+    }
+    EXPECT_EQ(AllocationScope::current(), nullptr);
+
+    auto snapshot = tracker->capture();
+    ASSERT_EQ(snapshot.allocations.size(), 3u);
+    EXPECT_EQ(snapshot.allocations[0].category, AllocationCategory::Uniform);
+    EXPECT_EQ(snapshot.allocations[1].category, AllocationCategory::Mesh);
+    EXPECT_EQ(snapshot.allocations[1].owner, "cube");
+    EXPECT_EQ(snapshot.allocations[2].category, AllocationCategory::Staging);
+    EXPECT_EQ(snapshot.allocations[2].owner, "cube");
+    EXPECT_EQ(snapshot.categories[static_cast<size_t>(AllocationCategory::Mesh)].count, 1u);
+
+    staging.reset();
+    EXPECT_EQ(tracker->totals()[static_cast<size_t>(AllocationCategory::Staging)].count, 0u);
+    EXPECT_NE(AllocationTracker::toJson(tracker->capture()).find("\"owner\":\"cube\""), std::string::npos);
+}
+
+TEST_F(VmaAllocatorTest, AllocationTrackerSnapshotDiff)
+{
+    AllocationTracker* tracker = allocator->tracker();
+    ASSERT_NE(tracker, nullptr);
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    auto persistent = std::make_shared<VmaBuffer>(allocator, 4096, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, allocInfo);
+    auto transient  = std::make_shared<VmaBuffer>(allocator, 4096, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, allocInfo);
+    auto before     = tracker->capture();
+
+    // 模拟关卡加载：释放一个旧资源，新增一个未释放的资源
+    transient.reset();
+    std::shared_ptr<VmaBuffer> leaked;
+    {
+        AllocationScope scope(AllocationCategory::Texture, "level.png");
+        leaked = std::make_shared<VmaBuffer>(allocator, 8192, VK_BUFFER_USAGE_TRANSFER_DST_BIT, allocInfo);
+    }
+    auto after = tracker->capture();
+
+    auto diff = AllocationTracker::diff(before, after);
+    ASSERT_EQ(diff.added.size(), 1u);
+    EXPECT_EQ(diff.added[0].owner, "level.png");
+    ASSERT_EQ(diff.freed.size(), 1u);
+    EXPECT_EQ(diff.categories[static_cast<size_t>(AllocationCategory::Storage)].count, -1);
+    EXPECT_EQ(diff.categories[static_cast<size_t>(AllocationCategory::Texture)].bytes, static_cast<int64_t>(diff.added[0].size));
+
+    // 时间线只包含 before 之后的分配事件
+    auto events = tracker->events(before.sequence);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, AllocationTracker::EventType::Allocate);
+    EXPECT_NE(tracker->timelineJson().find("\"free\""), std::string::npos);
+}
+
 TEST_F(VmaBufferTest, LargeAllocationHandling)
 {
     VmaAllocationCreateInfo allocInfo = {};
@@ -918,6 +1220,264 @@ TEST_F(VmaImageTest, MultipleImageFormats)
     }
 }
 
+// ==================== OffsetAllocator 测试（纯 CPU，无需设备） ====================
+
+TEST(OffsetAllocatorTest, SplitsAndCoalesces)
+{
+    OffsetAllocator allocator(1024, 64);
+
+    auto a = allocator.allocate(100);
+    auto b = allocator.allocate(200);
+    auto c = allocator.allocate(300);
+    ASSERT_TRUE(a.isValid() && b.isValid() && c.isValid());
+    EXPECT_EQ(a.offset, 0u);
+    EXPECT_EQ(b.offset, 100u);
+    EXPECT_EQ(c.offset, 300u);
+    EXPECT_EQ(allocator.rangeSize(b), 200u);
+    EXPECT_EQ(allocator.storageReport().totalFree, 424u);
+
+    // 释放中间块后，与两侧空闲邻居合并回一整块
+    allocator.free(b);
+    allocator.free(a);
+    allocator.free(c);
+    EXPECT_EQ(allocator.allocationCount(), 0u);
+    EXPECT_EQ(allocator.storageReport().largestFree, 1024u);
+
+    // 超出容量或节点数时返回无效范围
+    EXPECT_FALSE(allocator.allocate(2048).isValid());
+    EXPECT_FALSE(allocator.allocate(0).isValid());
+}
+
+TEST(OffsetAllocatorTest, FragmentationStress)
+{
+    constexpr uint32_t capacity = 1u << 20;
+    OffsetAllocator    allocator(capacity, 8192);
+    std::mt19937       rng(1234);
+
+    std::vector<OffsetAllocator::Range> live;
+    std::map<uint32_t, uint32_t>        occupied; // offset -> size
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        if (live.size() < 6000 && rng() % 3 != 0)
+        {
+            // 以小网格为主，混入少量大块
+            uint32_t size  = 1 + rng() % (rng() % 8 == 0 ? 4096 : 96);
+            auto     range = allocator.allocate(size);
+            if (!range.isValid())
+            {
+                continue;
+            }
+
+            ASSERT_LE(range.offset + size, capacity);
+            auto next = occupied.lower_bound(range.offset);
+            if (next != occupied.end())
+            {
+                ASSERT_GE(next->first, range.offset + size) << "overlaps the next range";
+            }
+            if (next != occupied.begin())
+            {
+                auto prev = std::prev(next);
+                ASSERT_LE(prev->first + prev->second, range.offset) << "overlaps the previous range";
+            }
+            occupied[range.offset] = size;
+            live.push_back(range);
+        }
+        else if (!live.empty())
+        {
+            size_t index = rng() % live.size();
+            occupied.erase(live[index].offset);
+            allocator.free(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    uint64_t used = 0;
+    for (const auto& [offset, size] : occupied)
+    {
+        used += size;
+    }
+    auto report = allocator.storageReport();
+    EXPECT_EQ(used + report.totalFree, capacity);
+    EXPECT_GT(report.largestFree, 0u);
+
+    // 全部释放后没有残留碎片
+    for (const auto& range : live)
+    {
+        allocator.free(range);
+    }
+    report = allocator.storageReport();
+    EXPECT_EQ(report.totalFree, capacity);
+    EXPECT_EQ(report.largestFree, capacity);
+}
+
+TEST(OffsetAllocatorTest, AllocateFreeSpeed)
+{
+    OffsetAllocator                     allocator(1u << 28, 1u << 16);
+    std::vector<OffsetAllocator::Range> ranges;
+    ranges.reserve(50000);
+
+    uint32_t failed = 0;
+    auto     start  = std::chrono::steady_clock::now();
+    for (int round = 0; round < 20; ++round)
+    {
+        for (uint32_t i = 0; i < 50000; ++i)
+        {
+            ranges.push_back(allocator.allocate(1 + (i * 7919) % 1024));
+            failed += ranges.back().isValid() ? 0 : 1;
+        }
+        ASSERT_EQ(allocator.allocationCount(), 50000u);
+        for (const auto& range : ranges)
+        {
+            allocator.free(range);
+        }
+        ranges.clear();
+        ASSERT_EQ(allocator.allocationCount(), 0u);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // 100 万次分配 + 释放；耗时只输出不断言（共享 CI 机器上墙钟上限不稳定）
+    std::cout << "OffsetAllocator: 1M allocate/free pairs in " << ms << " ms" << std::endl;
+    EXPECT_EQ(failed, 0u);
+    EXPECT_EQ(allocator.storageReport().largestFree, 1u << 28);
+}
+
+// ==================== ReadbackQueue 测试 ====================
+
+TEST_F(ResourceManagerTest, ReadbackBufferIsPersistentlyMapped)
+{
+    auto resourceManager = std::make_shared<ResourceManager>(deviceManager);
+
+    auto buffer = resourceManager->createReadbackBuffer(64 * 1024);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_TRUE(buffer->isMapped());
+    EXPECT_NE(buffer->allocationInfo().mappedData, nullptr);
+    EXPECT_TRUE(buffer->usage() & VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    // 设备有 HOST_CACHED 内存时应落在 Readback 池中
+    const auto& memProps = deviceManager->memory_properties();
+    if (memProps.memoryTypes[buffer->allocationInfo().memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)
+    {
+        for (const auto& [type, stats] : resourceManager->allocationStats().pools)
+        {
+            if (type == PoolType::Readback)
+            {
+                EXPECT_GE(stats.allocationCount, 1u);
+            }
+        }
+    }
+}
+
+TEST_F(ResourceManagerTest, ReadbackTicketsFailWithoutRecording)
+{
+    auto          resourceManager = std::make_shared<ResourceManager>(deviceManager);
+    ReadbackQueue readback(resourceManager);
+
+    // 无命令缓冲 / 不支持的格式：票据立即失败，不会永远挂起
+    auto bufferTicket = readback.requestBuffer(VK_NULL_HANDLE, VK_NULL_HANDLE, 0, 256);
+    EXPECT_TRUE(bufferTicket->failed());
+    EXPECT_TRUE(bufferTicket->data().empty());
+
+    ReadbackQueue::ImageRegion region;
+    region.format    = VK_FORMAT_UNDEFINED;
+    region.imageSize = {16, 16};
+    auto imageTicket = readback.requestImage(VK_NULL_HANDLE, region);
+    EXPECT_TRUE(imageTicket->failed());
+
+    // 取消尚未录制的票据
+    auto deferred = std::make_shared<ReadbackTicket>();
+    readback.cancel(deferred);
+    EXPECT_TRUE(deferred->failed());
+
+    readback.beginFrame(1);
+    auto stats = readback.stats();
+    EXPECT_EQ(stats.pending, 0u);
+    EXPECT_EQ(stats.completed, 0u);
+    EXPECT_EQ(stats.failed, 3u);
+}
+
+TEST(ReadbackQueueTest, TexelSizes)
+{
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_B8G8R8A8_UNORM), 4u);
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_R32_UINT), 4u); // 拾取 ID
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_R16G16B16A16_SFLOAT), 8u);
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_R32G32B32A32_SFLOAT), 16u);
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_D32_SFLOAT, VK_IMAGE_ASPECT_DEPTH_BIT), 4u);
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_D24_UNORM_S8_UINT, VK_IMAGE_ASPECT_STENCIL_BIT), 1u);
+    EXPECT_EQ(ReadbackQueue::texelSize(VK_FORMAT_UNDEFINED), 0u);
+}
+
+TEST(AllocationPolicyTest, PlacementHeuristics)
+{
+    AllocationPolicy policy;
+
+    // 渲染目标：专用内存 + 最高优先级
+    AllocationRequest renderTarget;
+    renderTarget.size          = 8ull * 1024 * 1024;
+    renderTarget.image         = true;
+    renderTarget.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    renderTarget.poolAvailable = true;
+    auto decision              = policy.decide(renderTarget);
+    EXPECT_EQ(decision.placement, AllocationPlacement::Dedicated);
+    EXPECT_TRUE(decision.flags & VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT);
+    EXPECT_FLOAT_EQ(decision.priority, policy.config().renderTargetPriority);
+
+    // 小纹理：进入池，长期资源使用 MIN_MEMORY 策略
+    AllocationRequest texture;
+    texture.size          = 256 * 1024;
+    texture.image         = true;
+    texture.usage         = VK_IMAGE_USAGE_SAMPLED_BIT;
+    texture.poolAvailable = true;
+    decision              = policy.decide(texture);
+    EXPECT_EQ(decision.placement, AllocationPlacement::Pooled);
+    EXPECT_TRUE(decision.flags & VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT);
+
+    // 大纹理：专用内存
+    texture.size = 32ull * 1024 * 1024;
+    EXPECT_EQ(policy.decide(texture).placement, AllocationPlacement::Dedicated);
+
+    // 动态缓冲：MIN_TIME 策略；没有池时使用共享块
+    AllocationRequest uniform;
+    uniform.size     = 4096;
+    uniform.usage    = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    uniform.lifetime = ResourceLifetime::Dynamic;
+    decision         = policy.decide(uniform);
+    EXPECT_EQ(decision.placement, AllocationPlacement::Shared);
+    EXPECT_TRUE(decision.flags & VMA_ALLOCATION_CREATE_STRATEGY_MIN_TIME_BIT);
+
+    // 驱动提示：过小的资源忽略 prefers，requires 始终生效
+    uniform.prefersDedicated = true;
+    EXPECT_EQ(policy.decide(uniform).placement, AllocationPlacement::Shared);
+    uniform.requiresDedicated = true;
+    decision                  = policy.decide(uniform);
+    EXPECT_EQ(decision.placement, AllocationPlacement::Dedicated);
+    EXPECT_TRUE(decision.driverHinted);
+}
+
+TEST(AllocationPolicyTest, StatsCountFallbacks)
+{
+    AllocationPolicy policy;
+
+    AllocationRequest request;
+    request.size          = 1024;
+    request.poolAvailable = true;
+    auto decision         = policy.decide(request);
+    ASSERT_EQ(decision.placement, AllocationPlacement::Pooled);
+
+    policy.record(request, decision, AllocationPlacement::Pooled);
+    policy.record(request, decision, AllocationPlacement::Shared); // 池已满，回退到默认块
+
+    auto stats = policy.stats();
+    EXPECT_EQ(stats.placements[static_cast<size_t>(AllocationPlacement::Pooled)].count, 1u);
+    EXPECT_EQ(stats.placements[static_cast<size_t>(AllocationPlacement::Shared)].bytes, 1024u);
+    EXPECT_EQ(stats.lifetimes[static_cast<size_t>(ResourceLifetime::Static)], 2u);
+    EXPECT_EQ(stats.poolFallbacks, 1u);
+
+    policy.resetStats();
+    EXPECT_EQ(policy.stats().poolFallbacks, 0u);
+}
+
 // 主函数
 int main(int argc, char** argv)
 {
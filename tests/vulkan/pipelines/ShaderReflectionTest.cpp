@@ -0,0 +1,332 @@
+/**
+ * @file ShaderReflectionTest.cpp
+ * @brief SPIR-V reflection tests (GTest), CPU only
+ */
+
+#include <gtest/gtest.h>
+#include "engine/rhi/vulkan/pipelines/ShaderReflection.hpp"
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace vulkan_engine::vulkan;
+
+namespace
+{
+    // ==================== SPIR-V module ====================
+
+    // Opcodes, enums and decorations from the SPIR-V specification, section 3
+    enum : uint32_t
+    {
+        OpName                 = 5,
+        OpMemberName           = 6,
+        OpEntryPoint           = 15,
+        OpTypeInt              = 21,
+        OpTypeFloat            = 22,
+        OpTypeVector           = 23,
+        OpTypeMatrix           = 24,
+        OpTypeImage            = 25,
+        OpTypeSampler          = 26,
+        OpTypeStruct           = 30,
+        OpTypePointer          = 32,
+        OpVariable             = 59,
+        OpDecorate             = 71,
+        OpMemberDecorate       = 72,
+        ExecutionVertex        = 0,
+        ExecutionFragment      = 4,
+        StorageUniformConst    = 0,
+        StorageInput           = 1,
+        StorageUniform         = 2,
+        StoragePushConstant    = 9,
+        Dim2D                  = 1,
+        DecorationBlock        = 2,
+        DecorationMatrixStride = 7,
+        DecorationBuiltIn      = 11,
+        DecorationLocation     = 30,
+        DecorationBinding      = 33,
+        DecorationSet          = 34,
+        DecorationOffset       = 35,
+        BuiltInVertexIndex     = 42
+    };
+
+    // Emits instruction words; strings are nul-terminated and padded to whole words
+    struct SpirvWriter
+    {
+        std::vector<uint32_t> words = {0x07230203, 0x00010000, 0, 64, 0};
+
+        void op(uint32_t opcode, std::initializer_list<uint32_t> operands, const std::string& text = {},
+                std::initializer_list<uint32_t> trailing = {})
+        {
+            std::vector<uint32_t> body(operands);
+            if (!text.empty())
+            {
+                std::vector<uint32_t> packed((text.size() + 4) / 4, 0);
+                for (size_t i = 0; i < text.size(); ++i)
+                {
+                    packed[i / 4] |= static_cast<uint32_t>(static_cast<uint8_t>(text[i])) << (8 * (i % 4));
+                }
+                body.insert(body.end(), packed.begin(), packed.end());
+            }
+            body.insert(body.end(), trailing);
+
+            words.push_back(static_cast<uint32_t>(body.size() + 1) << 16 | opcode);
+            words.insert(words.end(), body.begin(), body.end());
+        }
+    };
+
+    // The interface of this vertex shader:
+    //
+    //     layout(set = 0, binding = 0) uniform Camera { mat4 view_proj; vec3 position; float exposure; } camera;
+    //     layout(set = 1, binding = 0) uniform texture2D albedo_texture;
+    //     layout(set = 1, binding = 1) uniform sampler albedo_sampler;
+    //     layout(push_constant) uniform Push { mat4 model; uint material; } push;
+    //     layout(location = 0) in vec3 in_position;
+    //     layout(location = 1) in vec2 in_uv;
+    //     gl_VertexIndex
+    //
+    // Only declarations are emitted; the parser does not look at function bodies.
+    std::vector<uint32_t> vertex_module()
+    {
+        enum : uint32_t
+        {
+            Main = 1, Float, Vec4, Mat4, Vec3, Vec2, Uint, Int,
+            Camera, CameraPtr, CameraVar,
+            Image, ImagePtr, TextureVar,
+            Sampler, SamplerPtr, SamplerVar,
+            Push, PushPtr, PushVar,
+            Vec3InPtr, PositionVar, Vec2InPtr, UvVar, IntInPtr, VertexIndexVar
+        };
+
+        SpirvWriter spirv;
+        spirv.op(OpEntryPoint, {ExecutionVertex, Main}, "main", {PositionVar, UvVar, VertexIndexVar});
+
+        spirv.op(OpName, {Camera}, "Camera");
+        spirv.op(OpMemberName, {Camera, 0}, "view_proj");
+        spirv.op(OpMemberName, {Camera, 1}, "position");
+        spirv.op(OpMemberName, {Camera, 2}, "exposure");
+        spirv.op(OpName, {CameraVar}, "camera");
+        spirv.op(OpName, {TextureVar}, "albedo_texture");
+        spirv.op(OpName, {SamplerVar}, "albedo_sampler");
+        spirv.op(OpMemberName, {Push, 0}, "model");
+        spirv.op(OpMemberName, {Push, 1}, "material");
+        spirv.op(OpName, {PushVar}, "push");
+        spirv.op(OpName, {PositionVar}, "in_position");
+        spirv.op(OpName, {UvVar}, "in_uv");
+        spirv.op(OpName, {VertexIndexVar}, "gl_VertexIndex");
+
+        spirv.op(OpDecorate, {Camera, DecorationBlock});
+        spirv.op(OpMemberDecorate, {Camera, 0, DecorationOffset, 0});
+        spirv.op(OpMemberDecorate, {Camera, 0, DecorationMatrixStride, 16});
+        spirv.op(OpMemberDecorate, {Camera, 1, DecorationOffset, 64});
+        spirv.op(OpMemberDecorate, {Camera, 2, DecorationOffset, 76});
+        spirv.op(OpDecorate, {CameraVar, DecorationSet, 0});
+        spirv.op(OpDecorate, {CameraVar, DecorationBinding, 0});
+        spirv.op(OpDecorate, {TextureVar, DecorationSet, 1});
+        spirv.op(OpDecorate, {TextureVar, DecorationBinding, 0});
+        spirv.op(OpDecorate, {SamplerVar, DecorationSet, 1});
+        spirv.op(OpDecorate, {SamplerVar, DecorationBinding, 1});
+        spirv.op(OpDecorate, {Push, DecorationBlock});
+        spirv.op(OpMemberDecorate, {Push, 0, DecorationOffset, 0});
+        spirv.op(OpMemberDecorate, {Push, 0, DecorationMatrixStride, 16});
+        spirv.op(OpMemberDecorate, {Push, 1, DecorationOffset, 64});
+        spirv.op(OpDecorate, {PositionVar, DecorationLocation, 0});
+        spirv.op(OpDecorate, {UvVar, DecorationLocation, 1});
+        spirv.op(OpDecorate, {VertexIndexVar, DecorationBuiltIn, BuiltInVertexIndex});
+
+        spirv.op(OpTypeFloat, {Float, 32});
+        spirv.op(OpTypeVector, {Vec4, Float, 4});
+        spirv.op(OpTypeMatrix, {Mat4, Vec4, 4});
+        spirv.op(OpTypeVector, {Vec3, Float, 3});
+        spirv.op(OpTypeVector, {Vec2, Float, 2});
+        spirv.op(OpTypeInt, {Uint, 32, 0});
+        spirv.op(OpTypeInt, {Int, 32, 1});
+
+        spirv.op(OpTypeStruct, {Camera, Mat4, Vec3, Float});
+        spirv.op(OpTypePointer, {CameraPtr, StorageUniform, Camera});
+        spirv.op(OpVariable, {CameraPtr, CameraVar, StorageUniform});
+
+        spirv.op(OpTypeImage, {Image, Float, Dim2D, 0, 0, 0, 1, 0});
+        spirv.op(OpTypePointer, {ImagePtr, StorageUniformConst, Image});
+        spirv.op(OpVariable, {ImagePtr, TextureVar, StorageUniformConst});
+
+        spirv.op(OpTypeSampler, {Sampler});
+        spirv.op(OpTypePointer, {SamplerPtr, StorageUniformConst, Sampler});
+        spirv.op(OpVariable, {SamplerPtr, SamplerVar, StorageUniformConst});
+
+        spirv.op(OpTypeStruct, {Push, Mat4, Uint});
+        spirv.op(OpTypePointer, {PushPtr, StoragePushConstant, Push});
+        spirv.op(OpVariable, {PushPtr, PushVar, StoragePushConstant});
+
+        spirv.op(OpTypePointer, {Vec3InPtr, StorageInput, Vec3});
+        spirv.op(OpVariable, {Vec3InPtr, PositionVar, StorageInput});
+        spirv.op(OpTypePointer, {Vec2InPtr, StorageInput, Vec2});
+        spirv.op(OpVariable, {Vec2InPtr, UvVar, StorageInput});
+        spirv.op(OpTypePointer, {IntInPtr, StorageInput, Int});
+        spirv.op(OpVariable, {IntInPtr, VertexIndexVar, StorageInput});
+
+        return spirv.words;
+    }
+
+    // Fragment stage declaring one resource at set 0 / binding 0: a sampler, or
+    // a uniform block matching the vertex stage's camera
+    std::vector<uint32_t> fragment_module(bool sampler_at_camera_binding)
+    {
+        enum : uint32_t
+        {
+            Main = 1, Float, Vec4, Mat4, Vec3, Camera, CameraPtr, CameraVar, Sampler, SamplerPtr, SamplerVar
+        };
+
+        SpirvWriter spirv;
+        spirv.op(OpEntryPoint, {ExecutionFragment, Main}, "main");
+
+        const uint32_t var = sampler_at_camera_binding ? SamplerVar : CameraVar;
+        spirv.op(OpDecorate, {var, DecorationSet, 0});
+        spirv.op(OpDecorate, {var, DecorationBinding, 0});
+        spirv.op(OpDecorate, {Camera, DecorationBlock});
+        spirv.op(OpMemberDecorate, {Camera, 0, DecorationOffset, 0});
+        spirv.op(OpMemberDecorate, {Camera, 0, DecorationMatrixStride, 16});
+        spirv.op(OpMemberDecorate, {Camera, 1, DecorationOffset, 64});
+
+        spirv.op(OpTypeFloat, {Float, 32});
+        spirv.op(OpTypeVector, {Vec4, Float, 4});
+        spirv.op(OpTypeMatrix, {Mat4, Vec4, 4});
+        spirv.op(OpTypeVector, {Vec3, Float, 3});
+
+        if (sampler_at_camera_binding)
+        {
+            spirv.op(OpTypeSampler, {Sampler});
+            spirv.op(OpTypePointer, {SamplerPtr, StorageUniformConst, Sampler});
+            spirv.op(OpVariable, {SamplerPtr, SamplerVar, StorageUniformConst});
+        }
+        else
+        {
+            spirv.op(OpTypeStruct, {Camera, Mat4, Vec3});
+            spirv.op(OpTypePointer, {CameraPtr, StorageUniform, Camera});
+            spirv.op(OpVariable, {CameraPtr, CameraVar, StorageUniform});
+        }
+
+        return spirv.words;
+    }
+} // namespace
+
+// ==================== Reflection ====================
+
+TEST(ShaderReflectionTest, EntryPointAndStage)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+
+    EXPECT_EQ(reflection.entry_point, "main");
+    EXPECT_EQ(reflection.stages, static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT));
+    EXPECT_EQ(reflection.set_count(), 2u);
+}
+
+TEST(ShaderReflectionTest, UniformBlockMemberOffsets)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+
+    const ShaderResourceBinding* camera = reflection.find_binding(0, 0);
+    ASSERT_NE(camera, nullptr);
+    EXPECT_EQ(camera->name, "camera");
+    EXPECT_EQ(camera->descriptor_type, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    EXPECT_EQ(camera->count, 1u);
+    EXPECT_EQ(camera->block_size, 80u);
+
+    ASSERT_EQ(camera->members.size(), 3u);
+    EXPECT_EQ(camera->members[0].name, "view_proj");
+    EXPECT_EQ(camera->members[0].offset, 0u);
+    EXPECT_EQ(camera->members[0].size, 64u);
+    EXPECT_EQ(camera->members[1].name, "position");
+    EXPECT_EQ(camera->members[1].offset, 64u);
+    EXPECT_EQ(camera->members[1].size, 12u);
+    EXPECT_EQ(camera->members[2].name, "exposure");
+    EXPECT_EQ(camera->members[2].offset, 76u);
+    EXPECT_EQ(camera->members[2].size, 4u);
+}
+
+TEST(ShaderReflectionTest, SeparateTextureAndSampler)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+
+    const ShaderResourceBinding* texture = reflection.find_binding("albedo_texture");
+    ASSERT_NE(texture, nullptr);
+    EXPECT_EQ(texture->set, 1u);
+    EXPECT_EQ(texture->binding, 0u);
+    EXPECT_EQ(texture->descriptor_type, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+
+    const ShaderResourceBinding* sampler = reflection.find_binding("albedo_sampler");
+    ASSERT_NE(sampler, nullptr);
+    EXPECT_EQ(sampler->set, 1u);
+    EXPECT_EQ(sampler->binding, 1u);
+    EXPECT_EQ(sampler->descriptor_type, VK_DESCRIPTOR_TYPE_SAMPLER);
+
+    auto layout = reflection.set_layout_bindings(1);
+    ASSERT_EQ(layout.size(), 2u);
+    EXPECT_EQ(layout[0].binding, 0u);
+    EXPECT_EQ(layout[0].descriptorType, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+    EXPECT_EQ(layout[1].binding, 1u);
+    EXPECT_EQ(layout[1].descriptorType, VK_DESCRIPTOR_TYPE_SAMPLER);
+    EXPECT_EQ(layout[1].stageFlags, static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT));
+}
+
+TEST(ShaderReflectionTest, PushConstantRange)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+
+    ASSERT_EQ(reflection.push_constants.size(), 1u);
+    const ShaderPushConstantBlock& push = reflection.push_constants[0];
+    EXPECT_EQ(push.name, "push");
+    EXPECT_EQ(push.range.offset, 0u);
+    EXPECT_EQ(push.range.size, 68u);
+    EXPECT_EQ(push.range.stageFlags, static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT));
+
+    ASSERT_EQ(push.members.size(), 2u);
+    EXPECT_EQ(push.members[1].name, "material");
+    EXPECT_EQ(push.members[1].offset, 64u);
+    EXPECT_EQ(push.members[1].size, 4u);
+}
+
+TEST(ShaderReflectionTest, VertexInputsExcludeBuiltins)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+
+    ASSERT_EQ(reflection.vertex_inputs.size(), 2u);
+    EXPECT_EQ(reflection.vertex_inputs[0].name, "in_position");
+    EXPECT_EQ(reflection.vertex_inputs[0].location, 0u);
+    EXPECT_EQ(reflection.vertex_inputs[0].format, VK_FORMAT_R32G32B32_SFLOAT);
+    EXPECT_EQ(reflection.vertex_inputs[1].name, "in_uv");
+    EXPECT_EQ(reflection.vertex_inputs[1].location, 1u);
+    EXPECT_EQ(reflection.vertex_inputs[1].format, VK_FORMAT_R32G32_SFLOAT);
+}
+
+TEST(ShaderReflectionTest, MergeCombinesStages)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+    reflection.merge(ShaderReflection::reflect(fragment_module(false)));
+
+    EXPECT_EQ(reflection.stages, static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+
+    const ShaderResourceBinding* camera = reflection.find_binding(0, 0);
+    ASSERT_NE(camera, nullptr);
+    EXPECT_EQ(camera->stages, static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+    EXPECT_EQ(camera->block_size, 80u); // The larger declaration wins
+    EXPECT_EQ(reflection.vertex_inputs.size(), 2u);
+}
+
+TEST(ShaderReflectionTest, MergeRejectsConflictingTypes)
+{
+    auto reflection = ShaderReflection::reflect(vertex_module());
+    EXPECT_THROW(reflection.merge(ShaderReflection::reflect(fragment_module(true))), std::runtime_error);
+}
+
+TEST(ShaderReflectionTest, RejectsMalformedModules)
+{
+    EXPECT_THROW(ShaderReflection::reflect({}), std::runtime_error);
+    EXPECT_THROW(ShaderReflection::reflect({0xdeadbeef, 0x00010000, 0, 1, 0}), std::runtime_error);
+
+    // Instruction claiming more words than the module holds
+    auto truncated = vertex_module();
+    truncated.push_back(10u << 16 | OpName);
+    EXPECT_THROW(ShaderReflection::reflect(truncated), std::runtime_error);
+}